@@ -8,11 +8,13 @@ set(BASE_UNIX_AND_DARWIN_SRC
     src/unix/dir.cpp
     src/unix/dlunix.cpp
     src/unix/epolldispatcher.cpp
+    src/unix/iouringdispatcher.cpp
     src/unix/evtloopunix.cpp
     src/unix/fdiounix.cpp
     src/unix/snglinst.cpp
     src/unix/stackwalk.cpp
     src/unix/timerunx.cpp
+    src/unix/tzinfo.cpp
     src/unix/threadpsx.cpp
     src/unix/utilsunx.cpp
     src/unix/wakeuppipe.cpp
@@ -671,6 +673,7 @@ set(BASE_CMN_HDR
 set(NET_UNIX_SRC
     src/common/socketiohandler.cpp
     src/unix/sockunix.cpp
+    src/unix/sckreactor.cpp
 )
 
 set(NET_OSX_SRC
@@ -708,6 +711,7 @@ set(NET_CMN_HDR
     wx/protocol/protocol.h
     wx/sckaddr.h
     wx/sckipc.h
+    wx/sckreactor.h
     wx/sckstrm.h
     wx/socket.h
     wx/url.h
@@ -576,12 +576,17 @@ else()
         set(wxUSE_SELECT_DISPATCHER ON)
     endif()
     check_include_file(sys/epoll.h wxUSE_EPOLL_DISPATCHER)
+    if(wxUSE_EPOLL_DISPATCHER)
+        check_include_file(linux/io_uring.h wxHAS_IO_URING)
+    endif()
 endif()
 check_include_file(sys/select.h HAVE_SYS_SELECT_H)
 
 if(wxUSE_FSWATCHER)
     check_include_file(sys/inotify.h wxHAS_INOTIFY)
-    if(NOT wxHAS_INOTIFY)
+    if(wxHAS_INOTIFY)
+        check_include_file(sys/fanotify.h wxHAS_FANOTIFY)
+    else()
         check_include_file(sys/event.h wxHAS_KQUEUE)
     endif()
 endif()
@@ -65,6 +65,19 @@ for ( auto c : s )
     modify the string even when @e not using references, i.e. with just @c
     auto, as in the example above.
 
+In UTF-8 build, accessing the characters by index requires finding their
+position in the UTF-8 representation of the string. This is fast for sequential
+accesses, but accessing long strings at random positions, e.g. using
+operator[], Mid() or the positions returned by find(), takes time proportional
+to the string length. If @c wxUSE_STRING_POS_INDEX is predefined as 1 when
+building both wxWidgets and the application, such accesses create an index of
+the positions of the characters in the string, which makes them take constant
+time, but uses some extra memory and is destroyed whenever the string is
+modified, so it's still better to avoid interleaving changes to the string
+with accesses to its characters by index. This option is disabled by default
+because it changes the size of wxString object and so breaks the ABI
+compatibility.
+
 
 @section overview_string_internal wxString Internal Representation
 
@@ -98,6 +98,15 @@ public:
     // On MacOS, name must be a file with an extension "svg" placed in the
     // "Resources" subdirectory of the application bundle.
     wxNODISCARD static wxBitmapBundle FromSVGResource(const wxString& name, const wxSize& sizeDef);
+
+    // Set the maximal total size, in bytes, of the bitmaps cached by all the
+    // bundles created from SVG.
+    static void SetSVGCacheLimit(size_t bytes);
+
+    // Rasterize the bundles created from SVG in the given size (or their
+    // default size) in advance, using multiple threads to do it faster.
+    static void PrerenderSVG(const wxVector<wxBitmapBundle>& bundles,
+                             const wxSize& size = wxDefaultSize);
 #endif // wxHAS_SVG
 
     // Create from the resources: all existing versions of the bitmap of the
@@ -1559,6 +1559,107 @@ private:
 
 using wxDateTimeArray = wxBaseArray<wxDateTime>;
 
+// ----------------------------------------------------------------------------
+// wxDateTimeFormatter: analyses the format string only once and can then be
+// used to format or parse many dates using it, producing the same results as
+// wxDateTime::Format() and ParseFormat() but much faster.
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxDateTimeFormatter
+{
+public:
+    explicit
+    wxDateTimeFormatter(const wxString& format = wxASCII_STR(wxDefaultDateTimeFormat));
+
+    const wxString& GetFormat() const { return m_format; }
+
+    // append the date formatted as wxDateTime::Format() would do it to the
+    // given string
+    void FormatTo(wxString& str,
+                  const wxDateTime& dt,
+                  const wxDateTime::TimeZone& tz = wxDateTime::Local) const;
+
+    wxString Format(const wxDateTime& dt,
+                    const wxDateTime::TimeZone& tz = wxDateTime::Local) const
+    {
+        wxString str;
+        FormatTo(str, dt, tz);
+        return str;
+    }
+
+    // parse the date as wxDateTime::ParseFormat() would do it, if end is null
+    // the entire string must be matched
+    bool Parse(const wxString& date,
+               wxDateTime* dt,
+               const wxDateTime& dateDef = wxDefaultDateTime,
+               wxString::const_iterator* end = nullptr) const;
+
+    // parse all the strings, which must be matched entirely, and return the
+    // number of successfully parsed ones, the dates corresponding to the
+    // strings which couldn't be parsed are set to wxInvalidDateTime
+    size_t ParseAll(const std::vector<wxString>& strings,
+                    std::vector<wxDateTime>& dates,
+                    const wxDateTime& dateDef = wxDefaultDateTime) const;
+
+private:
+    // the kinds of the items the format is decomposed into
+    enum ItemType
+    {
+        Item_Literal,       // the text itself
+        Item_Space,         // zero or more spaces (only used for parsing)
+        Item_Number,        // numeric field spec with the given width
+        Item_Strftime,      // the text is passed to strftime()
+        Item_WeekDayName,   // %a or %A
+        Item_MonthName,     // %b or %B
+        Item_AmPm,          // %p (only used for parsing)
+        Item_TimeZone,      // %z (only used for parsing)
+        Item_TimeZoneName   // %Z (only used for parsing)
+    };
+
+    struct Item
+    {
+        ItemType type;
+        wxChar spec;
+        int width;
+        wxString text;
+    };
+
+    // the ways FormatTo() can work
+    enum FormatMode
+    {
+        Format_Strftime,    // use the fields of struct tm from the CRT
+        Format_Generic,     // use wxDateTime::GetTm()
+        Format_Fallback     // just call wxDateTime::Format()
+    };
+
+    void CompileForFormatting();
+    void CompileForParsing();
+
+    // add the literal text, if any, and clear it
+    static void AddLiteral(std::vector<Item>& items, wxString& text);
+    static void AddItem(std::vector<Item>& items,
+                        ItemType type, wxChar spec, int width = 0);
+
+    // parse the date starting at the given position, tmDef, if non-null, is
+    // used instead of the default date determined from dateDef and dt
+    bool DoParse(const wxString& date,
+                 wxString::const_iterator& input,
+                 wxDateTime& dt,
+                 const wxDateTime& dateDef,
+                 const wxDateTime::Tm* tmDef) const;
+
+    wxString m_format;
+
+    std::vector<Item> m_formatItems,
+                      m_parseItems;
+
+    FormatMode m_formatMode;
+
+    // false if the format uses the specifiers only supported by
+    // wxDateTime::ParseFormat() itself
+    bool m_canParse;
+};
+
 // ----------------------------------------------------------------------------
 // wxDateTimeHolidayAuthority: an object of this class will decide whether a
 // given date is a holiday and is used by all functions working with "work
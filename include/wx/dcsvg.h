@@ -260,6 +260,19 @@ private:
     void write(const wxString& s);
 
 private:
+    // Must be called before appending to m_buffer directly: closes the
+    // pending path, if any, and returns false if there is no valid output.
+    bool BeginWrite();
+
+    // Must be called after appending to m_buffer to flush it if it's full.
+    void EndWrite();
+
+    // Write the contents of the output buffer to the file.
+    void FlushBuffer();
+
+    // Terminate the <path> element started by DoDrawLine(), if any.
+    void ClosePendingPath();
+
     // If m_graphics_changed is true, close the current <g> element and start a
     // new one for the last pen/brush change.
     void NewGraphicsIfNeeded();
@@ -275,6 +288,16 @@ private:
     double              m_dpi;
     std::unique_ptr<wxFileOutputStream> m_outfile;
     std::unique_ptr<wxSVGBitmapHandler> m_bmp_handler; // class to handle bitmaps
+
+    // The output is accumulated in this buffer before being written to the
+    // file in big chunks.
+    std::string         m_buffer;
+
+    // Number of segments in the <path> element opened by DoDrawLine() and
+    // not closed yet: consecutive lines drawn with the same opaque pen are
+    // combined into a single element.
+    int                 m_pathSegments;
+
     wxSVGShapeRenderingMode m_renderingMode;
 
     // The clipping nesting level is incremented by every call to
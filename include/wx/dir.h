@@ -23,7 +23,8 @@ class WXDLLIMPEXP_FWD_BASE wxArrayString;
 // These flags affect the behaviour of GetFirst/GetNext() and Traverse().
 // They define what types are included in the list of items they produce.
 // Note that wxDIR_NO_FOLLOW is relevant only on Unix and ignored under systems
-// not supporting symbolic links.
+// not supporting symbolic links and that wxDIR_PARALLEL and wxDIR_UNORDERED
+// only affect Traverse().
 enum wxDirFlags
 {
     wxDIR_FILES     = 0x0001,       // include files
@@ -31,6 +32,8 @@ enum wxDirFlags
     wxDIR_HIDDEN    = 0x0004,       // include hidden files
     wxDIR_DOTDOT    = 0x0008,       // include '.' and '..'
     wxDIR_NO_FOLLOW = 0x0010,       // don't dereference any symlink
+    wxDIR_PARALLEL  = 0x0020,       // read subdirectories in parallel
+    wxDIR_UNORDERED = 0x0040,       // with wxDIR_PARALLEL: in any order
 
     // by default, enumerate everything except '.' and '..'
     wxDIR_DEFAULT   = wxDIR_FILES | wxDIR_DIRS | wxDIR_HIDDEN
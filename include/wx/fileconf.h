@@ -19,6 +19,9 @@
 #include "wx/string.h"
 #include "wx/confbase.h"
 #include "wx/filename.h"
+#include "wx/hashmap.h"
+
+#include <unordered_map>
 
 // ----------------------------------------------------------------------------
 // wxFileConfig
@@ -91,6 +94,7 @@
 class WXDLLIMPEXP_FWD_BASE wxFileConfigGroup;
 class WXDLLIMPEXP_FWD_BASE wxFileConfigEntry;
 class WXDLLIMPEXP_FWD_BASE wxFileConfigLineList;
+class wxFileConfigWriter;
 
 #if wxUSE_STREAMS
 class WXDLLIMPEXP_FWD_BASE wxInputStream;
@@ -202,6 +206,17 @@ public:
   void EnableAutoSave() { m_autosave = true; }
   void DisableAutoSave() { m_autosave = false; }
 
+  // in write-behind mode Flush() only takes a snapshot of the file contents
+  // and the file is written by a background thread after the given delay
+  // (in milliseconds), combining all the changes flushed during this time
+  void EnableWriteBehind(int delay = 1000);
+  void DisableWriteBehind();
+  bool IsWriteBehindEnabled() const { return m_writeBehindDelay >= 0; }
+
+  // wait until all the changes flushed in write-behind mode are written to
+  // the file, return false if writing any of them failed
+  bool WaitForPendingWrites();
+
 public:
   // functions to work with this list
   wxFileConfigLineList *LineListAppend(const wxString& str);
@@ -235,12 +250,27 @@ private:
   // common part of from dtor and DeleteAll
   void CleanUp();
 
-  // parse the whole file
+  // parse the whole file, the entries of the local file are only parsed
+  // when their group is accessed
   void Parse(const wxTextBuffer& buffer, bool bLocal);
 
+  // parse a line with an entry of the given group, pLine is null for the
+  // global file
+  void ParseEntryLine(wxFileConfigGroup *pGroup,
+                      const wxString& strLine,
+                      size_t n,
+                      wxFileConfigLineList *pLine,
+                      const wxString& bufferName);
+
   // the same as SetPath("/")
   void SetRootPath();
 
+  // return the full text of the local file
+  wxString GetLocalFileText() const;
+
+  // stop the write-behind thread after writing any pending changes
+  bool StopWriter();
+
   // real SetPath() implementation, returns true if path could be set or false
   // if path doesn't exist and createMissingComponents == false
   bool DoSetPath(const wxString& strPath, bool createMissingComponents);
@@ -263,6 +293,14 @@ private:
   wxFileConfigGroup *m_pRootGroup,      // the top (unnamed) group
                     *m_pCurrentGroup;   // the current group
 
+  // the groups corresponding to the full paths used with DoSetPath()
+  struct CachedPath
+  {
+      wxFileConfigGroup *pGroup;        // the group for this path
+      wxString           strPath;       // its normalized path
+  };
+  std::unordered_map<wxString, CachedPath, wxStringHash> m_pathCache;
+
   wxMBConv    *m_conv;
 
 #ifdef __UNIX__
@@ -272,6 +310,12 @@ private:
   bool m_isDirty;                       // if true, we have unsaved changes
   bool m_autosave;                      // if true, save changes on destruction
 
+  int m_writeBehindDelay = -1;          // -1 if write-behind is disabled
+  wxFileConfigWriter *m_writer = nullptr; // the write-behind thread or null
+
+  // for ParseEntryLine()
+  friend class wxFileConfigGroup;
+
   wxDECLARE_NO_COPY_CLASS(wxFileConfig);
   wxDECLARE_ABSTRACT_CLASS(wxFileConfig);
 };
@@ -346,6 +346,14 @@ public:
      */
     int GetWatchedPaths(wxArrayString* paths) const;
 
+    /**
+     * Collect the events during the given interval before sending them,
+     * merging the repeated events of the same type for the same path.
+     * Coalescing is disabled by default and can be disabled again by
+     * passing 0. Returns false if it's not supported by this implementation.
+     */
+    bool SetCoalescingInterval(int milliseconds);
+
     wxEvtHandler* GetOwner() const
     {
         return m_owner;
@@ -374,6 +382,9 @@ protected:
         return path.GetAbsolutePath();
     }
 
+    // Same as AddAny() but takes the already canonicalized path.
+    bool AddCanonical(const wxString& canonical, int events,
+                      wxFSWPathType type, const wxString& filespec);
 
     wxFSWatchInfoMap m_watches;        // path=>wxFSWatchInfo map
     wxFSWatcherImpl* m_service;     // file system events service
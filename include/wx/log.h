@@ -602,6 +602,20 @@ protected:
     // this one as the default implementation of it simply asserts
     virtual void DoLogText(const wxString& msg);
 
+#if wxUSE_THREADS
+    // this method is called by OnLog() for the messages logged from the
+    // threads other than the main one if they don't have their own log target
+    // and can be overridden by MT-safe log targets to handle the message
+    // immediately and return true, by default it returns false and the message
+    // is buffered until FlushActive() is called from the main thread
+    virtual bool DoLogThreadRecord(wxLogLevel WXUNUSED(level),
+                                   const wxString& WXUNUSED(msg),
+                                   const wxLogRecordInfo& WXUNUSED(info))
+    {
+        return false;
+    }
+#endif // wxUSE_THREADS
+
     // log a message indicating the number of times the previous message was
     // repeated if previous repetition counter is strictly positive, does
     // nothing otherwise; return the old value of repetition counter
@@ -877,6 +891,60 @@ private:
     wxDECLARE_NO_COPY_CLASS(wxLogInterposerTemp);
 };
 
+#if wxUSE_THREADS
+
+// ----------------------------------------------------------------------------
+// asynchronous log target: the messages logged from any thread are stored in
+// a bounded buffer specific to this thread, without locking, and passed to
+// the real log target by a separate worker thread
+// ----------------------------------------------------------------------------
+
+class wxLogAsyncImpl;
+
+class WXDLLIMPEXP_BASE wxLogAsync : public wxLog
+{
+public:
+    // what to do with the new messages when the buffer is full
+    enum OverflowPolicy
+    {
+        Overflow_Drop,      // discard them
+        Overflow_Block      // wait until the worker thread catches up
+    };
+
+    // the target is only used from the worker thread (and from Flush()) and
+    // will be deleted by this object
+    explicit wxLogAsync(wxLog *target,
+                        size_t bufferSize = 1024,
+                        OverflowPolicy policy = Overflow_Drop);
+    virtual ~wxLogAsync();
+
+    // return the log target the messages are passed to
+    wxLog *GetTarget() const;
+
+    // return the number of messages discarded because of buffer overflow
+    unsigned long GetDroppedCount() const;
+
+    // wait until all the messages logged so far are passed to the target and
+    // flush it
+    virtual void Flush() override;
+
+protected:
+    virtual void DoLogRecord(wxLogLevel level,
+                             const wxString& msg,
+                             const wxLogRecordInfo& info) override;
+
+    virtual bool DoLogThreadRecord(wxLogLevel level,
+                                   const wxString& msg,
+                                   const wxLogRecordInfo& info) override;
+
+private:
+    wxLogAsyncImpl *m_impl;
+
+    wxDECLARE_NO_COPY_CLASS(wxLogAsync);
+};
+
+#endif // wxUSE_THREADS
+
 #if wxUSE_GUI
     // include GUI log targets:
     #include "wx/generic/logg.h"
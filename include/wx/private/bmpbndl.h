@@ -12,6 +12,14 @@
 
 #include "wx/bmpbndl.h"
 
+#ifdef wxHAS_SVG
+
+// Return the number of bitmaps currently cached by all the bundles created
+// from SVG, this is only used by the tests.
+size_t WXDLLIMPEXP_CORE wxGetSVGCachedBitmapsCount();
+
+#endif // wxHAS_SVG
+
 #ifdef __WXOSX__
 
 // this methods are wx-private, may change in the future
@@ -36,6 +36,13 @@ public:
     // don't delete the returned pointer
     static wxFDIODispatcher *Get();
 
+    // create a new dispatcher of the best kind available on this system,
+    // this can be used by the code which needs to dispatch the events for its
+    // descriptors in its own thread; returns null if creating it failed
+    //
+    // the caller is responsible for deleting the returned pointer
+    static wxFDIODispatcher *Create();
+
     // if we have any registered handlers, check for any pending events to them
     // and dispatch them -- this is used from wxX11 and wxDFB event loops
     // implementation
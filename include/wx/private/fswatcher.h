@@ -98,6 +98,14 @@ public:
         return ret;
     }
 
+    // Enable or disable events coalescing, see
+    // wxFileSystemWatcherBase::SetCoalescingInterval(). Not supported by
+    // default, so only disabling it succeeds.
+    virtual bool SetCoalescingInterval(int milliseconds)
+    {
+        return milliseconds == 0;
+    }
+
     // Check whether any filespec matches the file's ext (if present)
     bool MatchesFilespec(const wxFileName& fn, const wxString& filespec) const
     {
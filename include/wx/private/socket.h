@@ -93,6 +93,53 @@
 
 typedef int wxSocketEventFlags;
 
+// native buffer descriptor used for scatter/gather IO, wxHAS_SOCKET_IOV is
+// defined if the system supports it, otherwise only the first buffer is used
+// by each IO operation
+#ifdef __WINDOWS__
+    #if wxUSE_WINSOCK2
+        #define wxHAS_SOCKET_IOV
+        typedef WSABUF wxSocketIOBuf;
+    #else
+        struct wxSocketIOBuf
+        {
+            u_long len;
+            char *buf;
+        };
+    #endif
+
+    inline void wxSetSocketIOBuf(wxSocketIOBuf& iob, void *data, wxUint32 size)
+    {
+        iob.buf = static_cast<char *>(data);
+        iob.len = size;
+    }
+
+    inline char *wxGetSocketIOBufData(const wxSocketIOBuf& iob) { return iob.buf; }
+    inline wxUint32 wxGetSocketIOBufSize(const wxSocketIOBuf& iob) { return iob.len; }
+#else // !__WINDOWS__
+    #include <sys/socket.h>
+    #include <sys/uio.h>
+
+    #define wxHAS_SOCKET_IOV
+    typedef iovec wxSocketIOBuf;
+
+    inline void wxSetSocketIOBuf(wxSocketIOBuf& iob, void *data, wxUint32 size)
+    {
+        iob.iov_base = data;
+        iob.iov_len = size;
+    }
+
+    inline char *wxGetSocketIOBufData(const wxSocketIOBuf& iob)
+        { return static_cast<char *>(iob.iov_base); }
+    inline wxUint32 wxGetSocketIOBufSize(const wxSocketIOBuf& iob)
+        { return static_cast<wxUint32>(iob.iov_len); }
+#endif // __WINDOWS__/!__WINDOWS__
+
+// MSG_ZEROCOPY is only supported by Linux 4.14 or later
+#if defined(__LINUX__) && defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+    #define wxHAS_MSG_ZEROCOPY
+#endif
+
 class wxSocketImpl;
 
 /*
@@ -204,6 +251,17 @@ public:
     wxSocketError GetError() const { return m_error; }
     bool IsOk() const { return m_error == wxSOCKET_NOERROR; }
 
+    // get the manager used for monitoring this socket, this is the global one
+    // unless SetManager() was called
+    wxSocketManager *GetManager() const
+    {
+        return m_manager ? m_manager : wxSocketManager::Get();
+    }
+
+    // use a different manager for this socket, this can only be done while
+    // no events are enabled for it, e.g. when it's in the blocking mode
+    void SetManager(wxSocketManager *manager) { m_manager = manager; }
+
     // creating/closing the socket
     // --------------------------
 
@@ -252,6 +310,20 @@ public:
     int Read(void *buffer, int size);
     int Write(const void *buffer, int size);
 
+    // scatter/gather versions of the functions above, they may use only some
+    // of the given buffers (but always at least one)
+    int ReadV(wxSocketIOBuf *bufs, int count);
+    int WriteV(wxSocketIOBuf *bufs, int count);
+
+    // send up to size bytes from the given file descriptor starting at the
+    // given offset, which is updated, or at the current position if offset is
+    // null, without copying them to user space
+    //
+    // return the number of bytes sent (0 at the end of the file) or -1 on
+    // error, which is wxSOCKET_INVOP if this is not supported for this file
+    // or on this platform and the data needs to be sent using Write() instead
+    int SendFile(int fd, wxFileOffset *offset, int size);
+
     // basically a wrapper for select(): returns the condition of the socket,
     // blocking for not longer than timeout if it is specified (otherwise just
     // poll without blocking at all)
@@ -324,6 +396,9 @@ protected:
     // true if we're a listening stream socket
     bool m_server;
 
+    // the manager to use instead of the global one, may be null
+    wxSocketManager *m_manager;
+
 private:
     // get the error code corresponding to the last operation
     //
@@ -367,6 +442,34 @@ private:
     int RecvDgram(void *buffer, int size);
     int SendStream(const void *buffer, int size);
     int SendDgram(const void *buffer, int size);
+    int RecvV(wxSocketIOBuf *bufs, int count);
+    int SendV(wxSocketIOBuf *bufs, int count);
+
+    // handle 0 returned when reading from the stream socket
+    void OnStreamClosed();
+
+#ifdef wxHAS_MSG_ZEROCOPY
+    // send the data using MSG_ZEROCOPY and wait until the kernel doesn't use
+    // it any more, return -2 if this couldn't be done and the data must be
+    // sent normally; if the kernel still used the data after the socket
+    // timeout expired, the number of bytes sent is returned anyhow and
+    // timedOut is set to true
+    int SendZeroCopy(wxSocketIOBuf *bufs, int count, bool *timedOut);
+
+    // state of SO_ZEROCOPY option for this socket: we only enable it when
+    // it's used for the first time
+    enum
+    {
+        ZeroCopy_Unknown,
+        ZeroCopy_Enabled,
+        ZeroCopy_Unsupported
+    } m_zeroCopyState;
+
+    // number of MSG_ZEROCOPY send calls, which is also the identifier of the
+    // next one, and of the ones the kernel notified us about completing
+    wxUint32 m_zeroCopySent;
+    wxUint32 m_zeroCopyDone;
+#endif // wxHAS_MSG_ZEROCOPY
 
 
     // set in ctor and never changed except that it's reset to nullptr when the
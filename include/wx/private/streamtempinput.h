@@ -13,6 +13,8 @@
 #ifndef _WX_PRIVATE_STREAMTEMPINPUT_H
 #define _WX_PRIVATE_STREAMTEMPINPUT_H
 
+#include "wx/convauto.h"
+#include "wx/process.h"
 #include "wx/private/pipestream.h"
 
 // ----------------------------------------------------------------------------
@@ -36,10 +38,18 @@
    the number of times we copy the data around) and so a better API is badly
    needed! However it's not easy to devise a way to do this keeping backwards
    compatibility with the existing wxExecute(wxEXEC_SYNC)...
+
+   Because of this, the "line mode" can also be used, see InitLines(), in
+   which the data is not kept at all but passed to the wxProcess line by line
+   as soon as it is read, so only the last incomplete line is buffered.
 */
 class wxStreamTempInputBuffer
 {
 public:
+    // the type of wxProcess methods called for each line of the output in the
+    // line mode, see InitLines()
+    using LineHandler = void (wxProcess::*)(const wxString& line);
+
     wxStreamTempInputBuffer() = default;
 
     // call to associate a stream with this buffer, otherwise nothing happens
@@ -51,6 +61,19 @@ public:
         m_stream = stream;
     }
 
+    // call instead of Init() to pass the data read from the stream to the
+    // given process handler line by line as soon as it is available instead
+    // of keeping all of it until this object is destroyed
+    void InitLines(wxPipeInputStream *stream,
+                   wxProcess *process,
+                   LineHandler handler)
+    {
+        Init(stream);
+
+        m_process = process;
+        m_handler = handler;
+    }
+
     // check for input on our stream and cache it in our buffer if any
     //
     // return true if anything was done
@@ -59,20 +82,11 @@ public:
         if ( !m_stream || !m_stream->CanRead() )
             return false;
 
-        // realloc in blocks of 4Kb: this is the default (and minimal) buffer
-        // size of the Unix pipes so it should be the optimal step
-        //
-        // NB: don't use "static int" in this inline function, some compilers
-        //     (e.g. IBM xlC) don't like it
-        enum { incSize = 4096 };
-
-        void *buf = realloc(m_buffer, m_size + incSize);
-        if ( !buf )
+        if ( !ReadChunk() )
             return false;
 
-        m_buffer = buf;
-        m_stream->Read((char *)m_buffer + m_size, incSize);
-        m_size += m_stream->LastRead();
+        if ( m_handler && m_stream->LastRead() )
+            ProcessLines();
 
         return true;
     }
@@ -99,14 +113,25 @@ public:
     }
 
     // dtor puts the data buffered during this object lifetime into the
-    // associated stream
+    // associated stream or, in line mode, passes all the remaining data,
+    // including the last incomplete line, to the handler
     ~wxStreamTempInputBuffer()
     {
-        if ( m_buffer )
+        if ( m_handler )
+        {
+            // block until the EOF, exactly as reading from the stream would
+            while ( !Eof() && ReadChunk() && m_stream->LastRead() )
+                ProcessLines();
+
+            if ( m_size )
+                SendLine(0, m_size);
+        }
+        else if ( m_size )
         {
             m_stream->Ungetch(m_buffer, m_size);
-            free(m_buffer);
         }
+
+        free(m_buffer);
     }
 
     const void *GetBuffer() const { return m_buffer; }
@@ -114,15 +139,120 @@ public:
     size_t GetSize() const { return m_size; }
 
 private:
+    // read all the data currently available (and block until at least some
+    // is if there is none) appending it to the buffer, return false only if
+    // we failed to allocate memory for it
+    bool ReadChunk()
+    {
+        // read at least as much as the default pipe buffer size under Linux
+        // (64KB) at once: this allows to get everything the child has written
+        // with a single call and growing the buffer geometrically avoids
+        // copying the data around too many times when there is a lot of it
+        //
+        // NB: don't use "static int" in this inline function, some compilers
+        //     (e.g. IBM xlC) don't like it
+        enum { minReadSize = 65536 };
+
+        if ( m_capacity - m_size < minReadSize )
+        {
+            size_t capacity = 2*m_capacity;
+            if ( capacity < m_size + minReadSize )
+                capacity = m_size + minReadSize;
+
+            void *buf = realloc(m_buffer, capacity);
+            if ( !buf )
+                return false;
+
+            m_buffer = buf;
+            m_capacity = capacity;
+        }
+
+        m_stream->Read(static_cast<char *>(m_buffer) + m_size,
+                       m_capacity - m_size);
+        m_size += m_stream->LastRead();
+
+        return true;
+    }
+
+    // pass all complete lines in the buffer to the handler and keep just the
+    // last incomplete one, if any
+    //
+    // just as wxTextInputStream, consider any of "\n", "\r\n" or "\r" as the
+    // end of line
+    void ProcessLines()
+    {
+        const char* const buf = static_cast<const char *>(m_buffer);
+
+        size_t start = 0;
+        if ( m_afterCR && m_size )
+        {
+            if ( buf[0] == '\n' )
+                start = 1;
+
+            m_afterCR = false;
+        }
+
+        for ( size_t n = start; n < m_size; n++ )
+        {
+            const char ch = buf[n];
+            if ( ch != '\n' && ch != '\r' )
+                continue;
+
+            SendLine(start, n);
+
+            if ( ch == '\r' )
+            {
+                if ( n + 1 == m_size )
+                    m_afterCR = true;
+                else if ( buf[n + 1] == '\n' )
+                    n++;
+            }
+
+            start = n + 1;
+        }
+
+        if ( start )
+        {
+            m_size -= start;
+            memmove(m_buffer, buf + start, m_size);
+        }
+    }
+
+    void SendLine(size_t start, size_t end)
+    {
+        (m_process->*m_handler)
+        (
+            wxString(static_cast<const char *>(m_buffer) + start,
+                     m_conv, end - start)
+        );
+    }
+
+
     // the stream we're buffering, if nullptr we don't do anything at all
     wxPipeInputStream *m_stream = nullptr;
 
-    // the buffer of size m_size (nullptr if m_size == 0)
+    // the buffer of size m_size (nullptr if m_capacity == 0)
     void *m_buffer = nullptr;
 
-    // the size of the buffer
+    // the size of the data in the buffer
     size_t m_size = 0;
 
+    // the size of the allocated buffer
+    size_t m_capacity = 0;
+
+    // the process and its method to call in line mode, both are nullptr if
+    // we're not using it
+    wxProcess *m_process = nullptr;
+    LineHandler m_handler = nullptr;
+
+    // the conversion used for the lines, the same as used by default by
+    // wxTextInputStream
+    wxConvAuto m_conv;
+
+    // true if the last line ended with "\r" which may be followed by "\n"
+    // at the beginning of the next chunk of data
+    bool m_afterCR = false;
+
     wxDECLARE_NO_COPY_CLASS(wxStreamTempInputBuffer);
 };
 
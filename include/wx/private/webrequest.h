@@ -11,9 +11,12 @@
 #define _WX_PRIVATE_WEBREQUEST_H_
 
 #include "wx/ffile.h"
+#include "wx/stream.h"
+#include "wx/thread.h"
 
 #include "wx/private/refcountermt.h"
 
+#include <deque>
 #include <memory>
 #include <unordered_map>
 
@@ -209,6 +212,68 @@ private:
     wxDECLARE_NO_COPY_CLASS(wxWebRequestImpl);
 };
 
+// ----------------------------------------------------------------------------
+// wxWebResponseStream
+// ----------------------------------------------------------------------------
+
+// Stream used with wxWebRequest::Storage_Stream: the data is appended to it by
+// the response as soon as it's received and can be read from it concurrently
+// from another thread, with reading blocking until more data is available.
+class wxWebResponseStream : public wxInputStream
+{
+public:
+    explicit wxWebResponseStream(wxWebResponseImpl& response);
+
+    // Maximal amount of data buffered before pausing the transfer.
+    static constexpr size_t MAX_BUFFERED = 1024*1024;
+
+    // All the functions below are called by the response and not by the
+    // thread reading from the stream.
+
+    // Check if the buffer is full and remember that the transfer is paused if
+    // it is, in which case wxWebResponseImpl::ResumeStream() will be called
+    // as soon as enough data is read from it.
+    bool PauseIfFull();
+
+    // Take ownership of the data in the given buffer, which is reset.
+    void Append(wxMemoryBuffer& buf);
+
+    // Indicate that no more data will be appended, either because the
+    // transfer has completed successfully or because it failed.
+    void Finish(bool success);
+
+    bool IsSeekable() const override { return false; }
+
+protected:
+    size_t OnSysRead(void* buffer, size_t size) override;
+
+private:
+    wxWebResponseImpl& m_response;
+
+    // This mutex protects all the fields below.
+    wxMutex m_mutex;
+    wxCondition m_dataAvailable;
+
+    // Chunks of data received but not read yet and the offset of the first
+    // unread byte in the first of them.
+    std::deque<wxMemoryBuffer> m_chunks;
+    size_t m_offset = 0;
+
+    // Total amount of unread data in all chunks.
+    size_t m_buffered = 0;
+
+    bool m_paused = false;
+
+    enum class State
+    {
+        Open,
+        Finished,
+        Failed
+    } m_state = State::Open;
+
+    wxDECLARE_NO_COPY_CLASS(wxWebResponseStream);
+};
+
 // ----------------------------------------------------------------------------
 // wxWebResponseImpl
 // ----------------------------------------------------------------------------
@@ -242,7 +307,8 @@ public:
 
     virtual wxString GetDataFile() const;
 
-    // Open data file if necessary, i.e. if using wxWebRequest::Storage_File.
+    // Open data file if necessary, i.e. if using wxWebRequest::Storage_File,
+    // or create the stream if using wxWebRequest::Storage_Stream.
     //
     // Returns result with State_Failed if the file is needed but couldn't be
     // opened.
@@ -250,6 +316,18 @@ public:
 
     void ReportDataReceived(size_t sizeReceived);
 
+    // Called from the thread reading from wxWebResponseStream when the
+    // transfer paused by a previous call to PauseStreamIfFull() can be
+    // resumed.
+    //
+    // This function is called with the stream lock held and so must not
+    // block and must not call any other stream functions.
+    virtual void ResumeStream() { }
+
+    // Indicate that no more data will be received when using
+    // wxWebRequest::Storage_Stream, does nothing otherwise.
+    void FinishStream(bool success);
+
 protected:
     wxWebRequestImpl& m_request;
 
@@ -261,10 +339,18 @@ protected:
     // if the total amount of data to be downloaded is known in advance.
     void PreAllocBuffer(size_t sizeNeeded);
 
+    // When using wxWebRequest::Storage_Stream with async requests, returns
+    // true if the application doesn't read the data fast enough and the
+    // transfer should be paused until ResumeStream() is called.
+    //
+    // Backends not supporting pausing the transfer may just never call this
+    // function, in which case the data is buffered without limit.
+    bool PauseStreamIfFull();
+
 private:
     // Called by wxWebRequestImpl only.
     friend class wxWebRequestImpl;
-    void Finalize();
+    void Finalize(wxWebRequest::State state);
 
     wxMemoryBuffer m_readBuffer;
     mutable wxFFile m_file;
@@ -336,6 +422,13 @@ public:
         { m_proxy = proxy; return true; }
     const wxWebProxy& GetProxy() const { return m_proxy; }
 
+    // Connection options are only supported by some backends.
+    virtual bool SetConnectionOptions(const wxWebConnectionOptions& WXUNUSED(options))
+        { return false; }
+
+    virtual wxWebConnectionStats GetConnectionStats() const
+        { return wxWebConnectionStats(); }
+
     const wxWebRequestHeaderMap& GetHeaders() const { return m_headers; }
 
     virtual wxWebSessionHandle GetNativeHandle() const = 0;
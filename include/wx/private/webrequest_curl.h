@@ -20,11 +20,13 @@
 
 #include "curl/curl.h"
 
+#include <atomic>
 #include <unordered_map>
 #include <vector>
 
 class wxWebRequestCURL;
 class wxWebResponseCURL;
+class wxWebSessionBaseCURL;
 class wxWebSessionCURL;
 class wxWebSessionSyncCURL;
 class SocketPoller;
@@ -46,7 +48,8 @@ private:
 class wxWebRequestCURL : public wxWebRequestImpl
 {
 public:
-    // Ctor for async requests: creates a new libcurl handle and owns it.
+    // Ctor for async requests: gets a libcurl handle from the session and
+    // returns it to it when it's destroyed.
     wxWebRequestCURL(wxWebSession& session,
                      wxWebSessionCURL& sessionImpl,
                      wxEvtHandler* handler,
@@ -87,6 +90,10 @@ public:
 
     wxString GetError() const;
 
+    // Resume the transfer paused because the response stream was full. This
+    // function can be called from any thread.
+    void ResumeTransfer();
+
     // Method called from libcurl callback
     size_t CURLOnRead(char* buffer, size_t size);
 
@@ -105,12 +112,17 @@ private:
     // if necessary, initialize m_authChallenge.
     wxWebRequest::Result DoHandleCompletion();
 
+    // Get the session implementation, which is used for both sync and async
+    // requests.
+    wxWebSessionBaseCURL& GetSessionCURL() const;
+
     void DoCancel() override;
 
     // This is only used for async requests.
     wxWebSessionCURL* const m_sessionCURL;
 
-    // This pointer is only owned by this object when using async requests.
+    // This pointer is only used by this object until it's destroyed when
+    // using async requests.
     CURL* const m_handle;
     char m_errorBuffer[CURL_ERROR_SIZE];
     struct curl_slist *m_headerList = nullptr;
@@ -138,6 +150,7 @@ public:
 
     wxString GetStatusText() const override { return m_statusText; }
 
+    void ResumeStream() override;
 
     // Methods called from libcurl callbacks
     size_t CURLOnWrite(void *buffer, size_t size);
@@ -169,12 +182,35 @@ public:
 
     wxVersionInfo GetLibraryVersionInfo() const override;
 
+    bool SetConnectionOptions(const wxWebConnectionOptions& options) override;
+
+    wxWebConnectionStats GetConnectionStats() const override;
+
     static bool CurlRuntimeAtLeastVersion(unsigned int, unsigned int,
                                           unsigned int);
 
+    // Set the options applying to the individual requests.
+    void ApplyConnectionOptions(CURL* handle) const;
+
+    // Update the statistics after completing the transfer using this handle.
+    void UpdateConnectionStats(CURL* handle);
+
 protected:
+    // Called when the connection options change.
+    virtual void OnConnectionOptionsChanged() { }
+
+    wxWebConnectionOptions m_connectionOptions;
+
     static int ms_activeSessions;
     static unsigned int ms_runtimeVersion;
+
+private:
+    // These counters can be updated from a worker thread using a sync session
+    // while being read from another one.
+    std::atomic<wxUint64> m_requestCount{0};
+    std::atomic<wxUint64> m_newConnectionCount{0};
+    std::atomic<wxUint64> m_reusedConnectionCount{0};
+    std::atomic<wxUint64> m_multiplexedRequestCount{0};
 };
 
 // Sync session implementation uses libcurl "easy" API.
@@ -243,8 +279,22 @@ public:
 
     void CancelRequest(wxWebRequestCURL* request);
 
+    // Resume the transfer previously paused by returning CURL_WRITEFUNC_PAUSE
+    // from the write callback.
+    void ResumeRequest(wxWebRequestCURL& request);
+
     void RequestHasTerminated(wxWebRequestCURL* request);
 
+    // Get an easy handle for a new request, reusing one of the handles of the
+    // previously destroyed requests if possible.
+    CURL* AcquireHandle();
+
+    // Return the handle to the pool when the request is destroyed.
+    void ReleaseHandle(CURL* handle);
+
+protected:
+    void OnConnectionOptionsChanged() override;
+
 private:
     static int TimerCallback(CURLM*, long, void*);
     static int SocketCallback(CURL*, curl_socket_t, int, void*, void*);
@@ -258,6 +308,7 @@ private:
     void FailRequest(CURL*, const wxString&);
     void StopActiveTransfer(CURL*);
     void RemoveActiveSocket(CURL*);
+    void ApplyMultiOptions();
 
     using TransferSet = std::unordered_map<CURL*, wxWebRequestCURL*>;
     using CurlSocketMap = std::unordered_map<CURL*, curl_socket_t>;
@@ -265,6 +316,10 @@ private:
     TransferSet m_activeTransfers;
     CurlSocketMap m_activeSockets;
 
+    // Easy handles not used by any request: reusing them is cheaper than
+    // creating new ones and preserves their caches, e.g. of TLS sessions.
+    std::vector<CURL*> m_freeHandles;
+
     SocketPoller* m_socketPoller = nullptr;
     wxTimer m_timeoutTimer;
     CURLM* m_handle = nullptr;
@@ -73,6 +73,18 @@ public:
     void Redirect() { m_redirect = true; }
     bool IsRedirected() const { return m_redirect; }
 
+    // call this instead of Redirect() to get the output of the process
+    // launched with wxEXEC_SYNC line by line, as soon as it becomes available,
+    // in OnOutputLine() and OnErrorLine() instead of reading it from the
+    // streams after wxExecute() returns
+    void RedirectLines() { m_redirect = m_redirectLines = true; }
+    bool IsRedirectingLines() const { return m_redirectLines; }
+
+    // may be overridden to handle the lines of the child process stdout and
+    // stderr respectively when using RedirectLines()
+    virtual void OnOutputLine(const wxString& line);
+    virtual void OnErrorLine(const wxString& line);
+
     // detach from the parent - should be called by the parent if it's deleted
     // before the process it started terminates
     void Detach();
@@ -141,7 +153,8 @@ protected:
     wxOutputStream *m_outputStream;
 #endif // wxUSE_STREAMS
 
-    bool m_redirect;
+    bool m_redirect,
+         m_redirectLines;
 
     wxDECLARE_DYNAMIC_CLASS(wxProcess);
     wxDECLARE_NO_COPY_CLASS(wxProcess);
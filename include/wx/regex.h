@@ -149,6 +149,10 @@ public:
     // return the extended RE corresponding to the given basic RE
     static wxString ConvertFromBasic(const wxString& bre);
 
+    // set the maximal number of recently compiled expressions reused by
+    // Compile() for all wxRegEx objects, 0 disables the cache
+    static void SetCacheSize(size_t size);
+
     // return version information for the underlying regex library
     static wxVersionInfo GetLibraryVersionInfo();
 
@@ -73,8 +73,8 @@ public:
     virtual bool StopAdvise(const wxString& item) override;
     virtual bool Disconnect() override;
 
-    // Will be used in the future to enable the compression but does nothing
-    // for now.
+    // Enable or disable compressing the data sent over this connection, this
+    // only has effect if the peer supports it too.
     void Compress(bool on);
 
 
@@ -100,6 +100,9 @@ protected:
     // the topic of this connection
     wxString m_topic;
 
+    // true if Compress(true) was called
+    bool m_compress;
+
 private:
     // common part of both ctors
     void Init();
@@ -0,0 +1,122 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        wx/sckreactor.h
+// Purpose:     wxSocketReactor serving connections from a pool of threads
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_SCKREACTOR_H_
+#define _WX_SCKREACTOR_H_
+
+#include "wx/defs.h"
+
+// The reactor relies on the file descriptors based sockets implementation and
+// so is not available under MSW nor macOS.
+#if wxUSE_SOCKETS && wxUSE_THREADS && defined(__UNIX__) && !defined(__DARWIN__)
+
+#define wxHAS_SOCKET_REACTOR
+
+#include "wx/socket.h"
+
+#include <vector>
+
+class wxSocketReactorLoop;
+
+// ----------------------------------------------------------------------------
+// wxSocketReactorHandler: callbacks called by wxSocketReactor
+// ----------------------------------------------------------------------------
+
+// All the functions of this class are called from the reactor threads and
+// only the socket passed to them may be used in them without locking.
+class WXDLLIMPEXP_NET wxSocketReactorHandler
+{
+public:
+    wxSocketReactorHandler() = default;
+
+    // Called when a new connection is accepted, the socket remains valid
+    // until OnLost() is called for it.
+    virtual void OnConnection(wxSocketBase& WXUNUSED(socket)) { }
+
+    // Called when the data is available for reading from the socket: it
+    // must be read by calling Read() which won't block as long as it's not
+    // called with wxSOCKET_WAITALL flag, otherwise this function will not be
+    // called again.
+    virtual void OnInput(wxSocketBase& socket) = 0;
+
+    // Called when the connection is closed by the peer or by calling Close()
+    // on the socket, which is deleted by the reactor after this function
+    // returns.
+    virtual void OnLost(wxSocketBase& WXUNUSED(socket)) { }
+
+    virtual ~wxSocketReactorHandler() = default;
+
+    wxDECLARE_NO_COPY_CLASS(wxSocketReactorHandler);
+};
+
+// ----------------------------------------------------------------------------
+// wxSocketReactor: accept connections and dispatch their events in threads
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_NET wxSocketReactor
+{
+public:
+    // The handler must remain alive until Stop() is called.
+    explicit wxSocketReactor(wxSocketReactorHandler& handler);
+
+    // Stops the reactor if it's still running.
+    ~wxSocketReactor();
+
+    // Start listening on the given address and dispatching the events for
+    // the accepted connections using the given number of threads, or one
+    // thread per CPU if it is 0.
+    //
+    // Returns false if the reactor couldn't be started.
+    bool Start(const wxSockAddress& addr, unsigned numThreads = 0);
+
+    // Close all the connections and stop all threads.
+    void Stop();
+
+    bool IsRunning() const { return !m_loops.empty(); }
+
+    // Get the number of threads used by the reactor.
+    unsigned GetThreadCount() const { return m_loops.size(); }
+
+    // Get the address the reactor listens on, this is useful to find the port
+    // if it was 0 in the address passed to Start().
+    bool GetLocal(wxSockAddress& addr) const;
+
+    // Get the number of the connections currently handled by the reactor.
+    size_t GetConnectionCount() const;
+
+private:
+    // Accept all pending connections, called from the first thread.
+    void AcceptConnections();
+
+    // Get the implementation of the given socket.
+    static wxSocketImpl *GetImpl(wxSocketBase& socket)
+    {
+        return socket.m_impl;
+    }
+
+
+    wxSocketReactorHandler& m_handler;
+
+    // The listening socket, only used from the first thread.
+    wxSocketServer *m_server;
+
+    // All the threads used by the reactor.
+    std::vector<wxSocketReactorLoop *> m_loops;
+
+    // The index of the thread to use for the next accepted connection.
+    unsigned m_nextLoop;
+
+    friend class wxSocketReactorLoop;
+
+    wxDECLARE_NO_COPY_CLASS(wxSocketReactor);
+};
+
+#endif // wxUSE_SOCKETS && wxUSE_THREADS && __UNIX__ && !__DARWIN__
+
+#endif // _WX_SCKREACTOR_H_
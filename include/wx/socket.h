@@ -21,8 +21,10 @@
 #include "wx/event.h"
 #include "wx/sckaddr.h"
 #include "wx/list.h"
+#include "wx/filefn.h"
 
 class wxSocketImpl;
+class WXDLLIMPEXP_FWD_BASE wxFile;
 
 // ------------------------------------------------------------------------
 // Types and constants
@@ -89,7 +91,8 @@ enum
     wxSOCKET_BLOCK          = 0x0010,
     wxSOCKET_REUSEADDR      = 0x0020,
     wxSOCKET_BROADCAST      = 0x0040,
-    wxSOCKET_NOBIND         = 0x0080
+    wxSOCKET_NOBIND         = 0x0080,
+    wxSOCKET_ZEROCOPY       = 0x0100
 };
 
 typedef int wxSocketFlags;
@@ -105,6 +108,19 @@ enum wxSocketType
 };
 
 
+// buffer used by wxSocketBase::ReadV() and WriteV()
+struct wxSocketIOVec
+{
+    wxSocketIOVec() : data(nullptr), size(0) { }
+    wxSocketIOVec(void *data_, wxUint32 size_) : data(data_), size(size_) { }
+    wxSocketIOVec(const void *data_, wxUint32 size_)
+        : data(const_cast<void *>(data_)), size(size_) { }
+
+    void *data;
+    wxUint32 size;
+};
+
+
 // event
 class WXDLLIMPEXP_FWD_NET wxSocketEvent;
 wxDECLARE_EXPORTED_EVENT(WXDLLIMPEXP_NET, wxEVT_SOCKET, wxSocketEvent);
@@ -157,6 +173,17 @@ public:
     wxSocketBase& Write(const void *buffer, wxUint32 nbytes);
     wxSocketBase& WriteMsg(const void *buffer, wxUint32 nbytes);
 
+    // scatter/gather IO using several buffers at once
+    wxSocketBase& ReadV(const wxSocketIOVec *vecs, size_t count);
+    wxSocketBase& WriteV(const wxSocketIOVec *vecs, size_t count);
+
+#if wxUSE_FILE
+    // send the data from the file, starting at the given offset or at the
+    // current position if it is wxInvalidOffset, without copying it to the
+    // user space if possible
+    wxSocketBase& SendFile(wxFile& file, wxFileOffset offset, wxUint32 nbytes);
+#endif // wxUSE_FILE
+
     // all Wait() functions wait until their condition is satisfied or the
     // timeout expires; if seconds == -1 (default) then m_timeout value is used
     //
@@ -238,10 +265,18 @@ private:
     friend class wxSocketClient;
     friend class wxSocketServer;
     friend class wxDatagramSocket;
+    friend class wxSocketReactor;
 
     // low level IO
     wxUint32 DoRead(void* buffer, wxUint32 nbytes);
     wxUint32 DoWrite(const void *buffer, wxUint32 nbytes);
+    wxUint32 DoReadV(const wxSocketIOVec *vecs, size_t count);
+    wxUint32 DoWriteV(const wxSocketIOVec *vecs, size_t count);
+#if wxUSE_FILE
+    wxUint32 DoSendFile(wxFile& file, wxFileOffset offset, wxUint32 nbytes);
+    wxUint32 DoSendFileByCopying(wxFile& file, wxFileOffset offset,
+                                 wxUint32 nbytes);
+#endif // wxUSE_FILE
 
     // wait until the given flags are set for this socket or the given timeout
     // (or m_timeout) expires
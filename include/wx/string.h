@@ -64,6 +64,24 @@
     #define wxUSE_STRING_POS_CACHE 0
 #endif
 
+// the cache above only helps with accessing the positions close to the last
+// used one, so long strings accessed at random positions can also get an index
+// of the byte offsets of every few characters, created on demand and destroyed
+// when the string changes
+//
+// this is disabled by default because it adds a field to wxString and so
+// changes sizeof(wxString) and the ABI, predefine this symbol as 1 when
+// building both the library and the applications using it to enable it
+#ifndef wxUSE_STRING_POS_INDEX
+    #define wxUSE_STRING_POS_INDEX 0
+#endif
+
+#if wxUSE_STRING_POS_INDEX && !wxUSE_STRING_POS_CACHE
+    // the index is only used together with the cache
+    #undef wxUSE_STRING_POS_INDEX
+    #define wxUSE_STRING_POS_INDEX 0
+#endif
+
 #if wxUSE_STRING_POS_CACHE
     #include "wx/tls.h"
 
@@ -76,6 +94,10 @@
     #endif
 #endif // wxUSE_STRING_POS_CACHE
 
+#if wxUSE_STRING_POS_INDEX
+    #include <atomic>
+#endif // wxUSE_STRING_POS_INDEX
+
 class WXDLLIMPEXP_FWD_BASE wxString;
 
 // unless this symbol is predefined to disable the compatibility functions, do
@@ -451,8 +473,10 @@ private:
   // translates position index in wxString to/from index in underlying
   // wxStringImpl:
   static size_t PosToImpl(size_t pos) { return pos; }
+  static size_t IndexedPosToImpl(size_t pos) { return pos; }
   static void PosLenToImpl(size_t pos, size_t len,
-                           size_t *implPos, size_t *implLen)
+                           size_t *implPos, size_t *implLen,
+                           bool WXUNUSED(canCreateIndex) = false)
     { *implPos = pos; *implLen = len; }
   static size_t LenToImpl(size_t len) { return len; }
   static size_t PosFromImpl(size_t pos) { return pos; }
@@ -539,7 +563,9 @@ private:
                sumofs,  // sum of all offsets after using the cache, used to
                         // compute the average after dividing by hits
                lentot,  // number of total calls to length()
-               lenhits; // number of cache hits in length()
+               lenhits, // number of cache hits in length()
+               idxtot,  // number of position indices created
+               idxhits; // positions found using the index
   } ms_cacheStats;
 
   friend struct wxStrCacheStatsDumper;
@@ -551,6 +577,74 @@ private:
   #define wxCACHE_PROFILE_FIELD_ADD(field, val)
 #endif // wxPROFILE_STRING_CACHE/!wxPROFILE_STRING_CACHE
 
+#if wxUSE_STRING_POS_INDEX
+  // the cache can't help with accessing long strings at random positions and
+  // with accessing more than Cache::SIZE strings at once, so such strings get
+  // an index containing the offset of every STEP-th character in m_impl
+  //
+  // the index is created by IndexedPosToImpl() and PosFromImpl() and, after
+  // being created, is never modified until it is destroyed by any function
+  // modifying the string, which is why it's safe to access it from several
+  // threads in parallel
+  struct PosIndex
+  {
+      enum
+      {
+          STEP = 64,            // distance between the indexed characters
+          MIN_LENGTH = 4096,    // don't index the strings shorter than this
+          MIN_DISTANCE = 512    // nor when walking over less than this
+      };
+
+      PosIndex(size_t len_, size_t *offsets_) : len(len_), offsets(offsets_) { }
+      ~PosIndex() { delete [] offsets; }
+
+      size_t len;       // the length of the string in characters
+      size_t *offsets;  // offsets of 0, STEP, 2*STEP, ... characters up to
+                        // len, or nullptr if the string is ASCII-only
+
+      wxDECLARE_NO_COPY_CLASS(PosIndex);
+  };
+
+  // this is only used to initialize the pointer in all ctors, notably the
+  // copy ctor, which must not copy it
+  struct PosIndexHolder
+  {
+      PosIndexHolder() : ptr(nullptr) { }
+
+      std::atomic<PosIndex *> ptr;
+
+      wxDECLARE_NO_COPY_CLASS(PosIndexHolder);
+  };
+
+  const PosIndex *GetPosIndex() const
+      { return m_posIndex.ptr.load(std::memory_order_acquire); }
+
+  // create the index if it doesn't exist yet and return it
+  const PosIndex *CreatePosIndex() const;
+
+  // destroy the index if we have it, this must be called before or after
+  // (but not during) any change to m_impl
+  void ResetPosIndex()
+  {
+      if ( m_posIndex.ptr.load(std::memory_order_relaxed) )
+          DoResetPosIndex();
+  }
+
+  void DoResetPosIndex();
+
+  // check if it's worth creating the index to find the given position if we
+  // need to walk over the given number of characters otherwise
+  bool ShouldCreatePosIndex(size_t distance) const
+  {
+      return distance >= PosIndex::MIN_DISTANCE &&
+                m_impl.length() >= PosIndex::MIN_LENGTH;
+  }
+
+  size_t DoPosFromImpl(size_t pos) const;
+#else // !wxUSE_STRING_POS_INDEX
+  void ResetPosIndex() { }
+#endif // wxUSE_STRING_POS_INDEX/!wxUSE_STRING_POS_INDEX
+
   // note: it could seem that the functions below shouldn't be inline because
   // they are big, contain loops and so the compiler shouldn't be able to
   // inline them anyhow, however moving them into string.cpp does decrease the
@@ -629,7 +723,7 @@ private:
 #endif
   }
 
-  size_t DoPosToImpl(size_t pos) const
+  size_t DoPosToImpl(size_t pos, bool canCreateIndex = false) const
   {
       wxCACHE_PROFILE_FIELD_INC(postot);
 
@@ -663,6 +757,35 @@ private:
           cache->ResetPos();
       }
 
+#if wxUSE_STRING_POS_INDEX
+      // use the index, creating it if allowed and necessary, if it allows us
+      // to start closer to the requested position
+      if ( pos - cache->pos >= PosIndex::STEP )
+      {
+          const PosIndex *index = GetPosIndex();
+          if ( !index && canCreateIndex && ShouldCreatePosIndex(pos - cache->pos) )
+              index = CreatePosIndex();
+
+          if ( index && pos <= index->len )
+          {
+              wxCACHE_PROFILE_FIELD_INC(idxhits);
+
+              if ( index->offsets )
+              {
+                  cache->pos = pos - pos % PosIndex::STEP;
+                  cache->impl = index->offsets[pos / PosIndex::STEP];
+              }
+              else // ASCII string, positions are the same as offsets
+              {
+                  cache->pos =
+                  cache->impl = pos;
+              }
+          }
+      }
+#else // !wxUSE_STRING_POS_INDEX
+      wxUnusedVar(canCreateIndex);
+#endif // wxUSE_STRING_POS_INDEX/!wxUSE_STRING_POS_INDEX
+
       wxCACHE_PROFILE_FIELD_ADD(sumofs, pos - cache->pos);
 
 
@@ -679,8 +802,13 @@ private:
       return cache->impl;
   }
 
+  // all the functions below are called whenever the string is modified, so
+  // they also destroy the position index which is never updated
+
   void InvalidateCache()
   {
+      ResetPosIndex();
+
       Cache::Element * const cache = FindCacheElement();
       if ( cache )
           cache->Reset();
@@ -688,6 +816,8 @@ private:
 
   void InvalidateCachedLength()
   {
+      ResetPosIndex();
+
       Cache::Element * const cache = FindCacheElement();
       if ( cache )
           cache->len = npos;
@@ -695,6 +825,8 @@ private:
 
   void SetCachedLength(size_t len)
   {
+      ResetPosIndex();
+
       // we optimistically cache the length here even if the string wasn't
       // present in the cache before, this seems to do no harm and the
       // potential for avoiding length recomputation for long strings looks
@@ -704,6 +836,8 @@ private:
 
   void UpdateCachedLength(ptrdiff_t delta)
   {
+      ResetPosIndex();
+
       Cache::Element * const cache = FindCacheElement();
       if ( cache && cache->len != npos )
       {
@@ -718,7 +852,7 @@ private:
   #define wxSTRING_UPDATE_CACHED_LENGTH(n) UpdateCachedLength(n)
   #define wxSTRING_SET_CACHED_LENGTH(n) SetCachedLength(n)
 #else // !wxUSE_STRING_POS_CACHE
-  size_t DoPosToImpl(size_t pos) const
+  size_t DoPosToImpl(size_t pos, bool WXUNUSED(canCreateIndex) = false) const
   {
       return (begin() + pos).impl() - m_impl.begin();
   }
@@ -734,7 +868,17 @@ private:
       return pos == 0 || pos == npos ? pos : DoPosToImpl(pos);
   }
 
-  void PosLenToImpl(size_t pos, size_t len, size_t *implPos, size_t *implLen) const;
+  // same as PosToImpl() but may also create the position index, so it must
+  // not be used by the functions modifying the string as the index could be
+  // created for its old contents and not destroyed after changing them
+  size_t IndexedPosToImpl(size_t pos) const
+  {
+      return pos == 0 || pos == npos ? pos : DoPosToImpl(pos, true);
+  }
+
+  // canCreateIndex has the same meaning as for IndexedPosToImpl()
+  void PosLenToImpl(size_t pos, size_t len, size_t *implPos, size_t *implLen,
+                    bool canCreateIndex = false) const;
 
   size_t LenToImpl(size_t len) const
   {
@@ -747,6 +891,10 @@ private:
   {
       if ( pos == 0 || pos == npos )
           return pos;
+#if wxUSE_STRING_POS_INDEX
+      else if ( GetPosIndex() || ShouldCreatePosIndex(pos) )
+          return DoPosFromImpl(pos);
+#endif // wxUSE_STRING_POS_INDEX
       else
           return const_iterator(this, m_impl.begin() + pos) - begin();
   }
@@ -966,6 +1114,10 @@ public:
     { return iterator(this, m_impl.begin() + PosToImpl(n)); }
   const_iterator GetIterForNthChar(size_t n) const
     { return const_iterator(this, m_impl.begin() + PosToImpl(n)); }
+
+  // see IndexedPosToImpl() for when this can be used
+  iterator GetIndexedIterForNthChar(size_t n)
+    { return iterator(this, m_impl.begin() + IndexedPosToImpl(n)); }
 #else // wxUSE_UNICODE_WCHAR
 
   class WXDLLIMPEXP_BASE iterator
@@ -1038,6 +1190,7 @@ public:
 
   iterator GetIterForNthChar(size_t n) { return begin() + n; }
   const_iterator GetIterForNthChar(size_t n) const { return begin() + n; }
+  iterator GetIndexedIterForNthChar(size_t n) { return begin() + n; }
 #endif // wxUSE_UNICODE_UTF8/wxUSE_UNICODE_WCHAR
 
   size_t IterToImplPos(wxString::iterator i) const
@@ -1423,6 +1576,11 @@ public:
 #if wxUSE_STRING_POS_CACHE
       wxCACHE_PROFILE_FIELD_INC(lentot);
 
+#if wxUSE_STRING_POS_INDEX
+      if ( const PosIndex * const index = GetPosIndex() )
+          return index->len;
+#endif // wxUSE_STRING_POS_INDEX
+
       Cache::Element * const cache = GetCacheElement();
 
       if ( cache->len == npos )
@@ -1494,7 +1652,7 @@ public:
   wxString substr(size_t nStart = 0, size_t nLen = npos) const
   {
     size_t pos, len;
-    PosLenToImpl(nStart, nLen, &pos, &len);
+    PosLenToImpl(nStart, nLen, &pos, &len, true);
     return FromImpl(m_impl.substr(pos, len));
   }
 
@@ -1523,12 +1681,12 @@ public:
   // data access (all indexes are 0 based)
     // read access
     wxUniChar at(size_t n) const
-      { return wxStringOperations::DecodeChar(m_impl.begin() + PosToImpl(n)); }
+      { return wxStringOperations::DecodeChar(m_impl.begin() + IndexedPosToImpl(n)); }
     wxUniChar GetChar(size_t n) const
       { return at(n); }
     // read/write access
     wxUniCharRef at(size_t n)
-      { return *GetIterForNthChar(n); }
+      { return *GetIndexedIterForNthChar(n); }
     wxUniCharRef GetWritableChar(size_t n)
       { return at(n); }
     // write access
@@ -2421,20 +2579,23 @@ public:
 
   // formatted input/output
     // as sprintf(), returns the number of characters written or < 0 on error
+    //
+    // note that the arguments are taken by reference to avoid copying them,
+    // but are handled as if they were passed by value, as with printf()
   template <typename... Targs>
-  int Printf(const wxFormatString& format, Targs... args)
+  int Printf(const wxFormatString& format, const Targs&... args)
   {
-    format.Validate({wxFormatStringSpecifier<Targs>::value...});
+    format.Validate({wxFormatStringSpecifier<wxVarArgType<Targs>>::value...});
 
 #if wxUSE_UNICODE_UTF8
     #if !wxUSE_UTF8_LOCALE_ONLY
       if ( wxLocaleIsUtf8 )
     #endif
-        return DoPrintfUtf8(format, wxArgNormalizerUtf8<Targs>{args, nullptr, 0}.get()...);
+        return DoPrintfUtf8(format, wxArgNormalizerUtf8<wxVarArgType<Targs>>{args, nullptr, 0}.get()...);
 #endif // wxUSE_UNICODE_UTF8
 
 #if !wxUSE_UTF8_LOCALE_ONLY
-      return DoPrintfWchar(format, wxArgNormalizerWchar<Targs>{args, nullptr, 0}.get()...);
+      return DoPrintfWchar(format, wxArgNormalizerWchar<wxVarArgType<Targs>>{args, nullptr, 0}.get()...);
 #endif // !wxUSE_UTF8_LOCALE_ONLY
   }
 
@@ -2443,7 +2604,7 @@ public:
 
     // returns the string containing the result of Printf() to it
   template <typename... Targs>
-  static wxString Format(const wxFormatString& format, Targs... args)
+  static wxString Format(const wxFormatString& format, const Targs&... args)
   {
       wxString s;
       s.Printf(format, args...);
@@ -2471,7 +2632,7 @@ public:
 
   // use Printf()
   template <typename... Targs>
-  int sprintf(const wxFormatString& format, Targs... args)
+  int sprintf(const wxFormatString& format, const Targs&... args)
   {
       return Printf(format, args...);
   }
@@ -2720,8 +2881,10 @@ public:
     // same as ` = str[pos..pos + n]
   wxString& assign(const wxString& str, size_t pos, size_t n)
   {
+      // the index may be created here even if str is the same string as this
+      // one because it's going to be destroyed below
       size_t from, len;
-      str.PosLenToImpl(pos, n, &from, &len);
+      str.PosLenToImpl(pos, n, &from, &len, true);
       m_impl.assign(str.m_impl, from, len);
 
       // it's important to call this after PosLenToImpl() above in case str is
@@ -3778,6 +3941,11 @@ private:
 
   wxStringIteratorNodeHead m_iterators;
 
+#if wxUSE_STRING_POS_INDEX
+  // this is mutable because the index is created on demand by const methods
+  mutable PosIndexHolder m_posIndex;
+#endif // wxUSE_STRING_POS_INDEX
+
   friend class WXDLLIMPEXP_FWD_BASE wxStringIteratorNode;
   friend class WXDLLIMPEXP_FWD_BASE wxUniCharRef;
   friend class wxUTF8StringBuffer;
@@ -4031,6 +4199,10 @@ public:
     wxUTF8StringBuffer(wxString& str, size_t size)
         : wxPrivate::wxUTF8StringBufferBase{str.m_impl, size}
     {
+#if wxUSE_STRING_POS_CACHE
+        // the string contents is going to be changed directly
+        str.InvalidateCache();
+#endif // wxUSE_STRING_POS_CACHE
     }
 
     ~wxUTF8StringBuffer()
@@ -4050,6 +4222,10 @@ public:
     wxUTF8StringBufferLength(wxString& str, size_t size)
         : wxPrivate::wxUTF8StringBufferBase{str.m_impl, size}
     {
+#if wxUSE_STRING_POS_CACHE
+        // the string contents is going to be changed directly
+        str.InvalidateCache();
+#endif // wxUSE_STRING_POS_CACHE
     }
 
     ~wxUTF8StringBufferLength()
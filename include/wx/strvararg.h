@@ -29,6 +29,7 @@
 #include "wx/buffer.h"
 #include "wx/unichar.h"
 
+#include <initializer_list>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -147,10 +148,10 @@ class WXDLLIMPEXP_BASE wxFormatString
 public:
 #ifndef wxNO_IMPLICIT_WXSTRING_ENCODING
     wxFormatString(const char *str)
-        : m_char(wxScopedCharBuffer::CreateNonOwned(str)), m_str(nullptr), m_cstr(nullptr) {}
+        : m_rawChar(str), m_str(nullptr), m_cstr(nullptr) {}
 #endif
     wxFormatString(const wchar_t *str)
-        : m_wchar(wxScopedWCharBuffer::CreateNonOwned(str)), m_str(nullptr), m_cstr(nullptr) {}
+        : m_rawWChar(str), m_str(nullptr), m_cstr(nullptr) {}
     wxFormatString(const wxString& str)
         : m_str(&str), m_cstr(nullptr) {}
     wxFormatString(const wxCStrData& str)
@@ -207,8 +208,11 @@ public:
         Arg_Unknown     = 0x8000     // unrecognized specifier (likely error)
     };
 
-    // Validate all format string parameters at once: the vector contains the
+    // Validate all format string parameters at once: the list contains the
     // format specifiers corresponding to the actually given arguments.
+    void Validate(std::initializer_list<int> argTypes) const;
+
+    // Overload taking a vector, for compatibility only.
     void Validate(const std::vector<int>& argTypes) const;
 
     // returns the type of format specifier for n-th variadic argument (this is
@@ -245,9 +249,24 @@ private:
 #endif // !wxUSE_UTF8_LOCALE_ONLY
 
 private:
+    // common part of both Validate() overloads
+    void DoValidate(const int* argTypes, size_t count) const;
+
+    // return the char or wchar_t string passed to the ctor, if any
+    const char* GetInputChar() const
+        { return m_rawChar ? m_rawChar : m_char.data(); }
+    const wchar_t* GetInputWChar() const
+        { return m_rawWChar ? m_rawWChar : m_wchar.data(); }
+
     wxScopedCharBuffer  m_char;
     wxScopedWCharBuffer m_wchar;
 
+    // the raw pointers passed to the ctor are stored separately as wrapping
+    // them in a (non-owned) buffer would allocate memory, which is better
+    // avoided for this, by far the most common, case
+    const char * const m_rawChar = nullptr;
+    const wchar_t * const m_rawWChar = nullptr;
+
     // NB: we can use a pointer here, because wxFormatString is only used
     //     as function argument, so it has shorter life than the string
     //     passed to the ctor
@@ -354,6 +373,11 @@ struct wxFormatStringArgumentFinder<wxWCharBuffer>
 
     // Also provide a trivial implementation of Validate() doing nothing in
     // this case.
+    inline void
+    wxFormatString::Validate(std::initializer_list<int> WXUNUSED(argTypes)) const
+    {
+    }
+
     inline void
     wxFormatString::Validate(const std::vector<int>& WXUNUSED(argTypes)) const
     {
@@ -393,6 +417,12 @@ struct wxFormatStringSpecifier<const T*>
 };
 
 
+// Type of the argument of type T passed to a variadic function by reference:
+// this is the same type as would be used if the argument was passed by value,
+// i.e. arrays are replaced with pointers and const is removed.
+template<typename T>
+using wxVarArgType = typename std::decay<const T>::type;
+
 #define wxFORMAT_STRING_SPECIFIER(T, arg)                                   \
     template<> struct wxFormatStringSpecifier<T>                            \
     {                                                                       \
@@ -16,6 +16,7 @@
 #include "wx/archive.h"
 
 #include <unordered_map>
+#include <vector>
 
 /////////////////////////////////////////////////////////////////////////////
 // Constants
@@ -89,6 +90,7 @@ public:
     // is accessors
     bool IsDir() const override;
     bool IsReadOnly() const override                     { return !(m_Mode & 0222); }
+    bool IsSparse() const                       { return !m_SparseMap.empty(); }
 
     // set accessors
     void SetName(const wxString& name, wxPathFormat format = wxPATH_NATIVE) override;
@@ -119,6 +121,10 @@ public:
     void SetNotifier(wxTarNotifier& WXUNUSED(notifier)) { }
 
 private:
+    // offset and size of the data regions of a sparse file, the rest of the
+    // file consists of holes
+    using wxTarSparseMap = std::vector<std::pair<wxFileOffset, wxFileOffset>>;
+
     void SetOffset(wxFileOffset offset) override         { m_Offset = offset; }
 
     virtual wxArchiveEntry* DoClone() const override     { return Clone(); }
@@ -139,6 +145,7 @@ private:
     wxString     m_GroupName;
     int          m_DevMajor;
     int          m_DevMinor;
+    wxTarSparseMap m_SparseMap;
 
     friend class wxTarInputStream;
 
@@ -163,6 +170,8 @@ public:
 
     wxTarEntry *GetNextEntry();
 
+    bool CopyEntryData(wxOutputStream& stream);
+
     wxFileOffset GetLength() const override      { return m_size; }
     bool IsSeekable() const override { return m_parent_i_stream->IsSeekable(); }
 
@@ -182,6 +191,15 @@ private:
 
     wxStreamError ReadHeaders();
     bool ReadExtendedHeader(wxTarHeaderRecords*& recs);
+    bool ReadSparseMap(wxTarEntry& entry);
+    bool ReadGnuSparseMap(wxTarEntry::wxTarSparseMap& map);
+    bool ReadPaxSparseMap(wxTarEntry::wxTarSparseMap& map,
+                          wxFileOffset& dataSize);
+
+    void SetDataSize(const wxTarEntry& entry);
+    wxFileOffset GetStoredPos(wxFileOffset pos) const;
+    size_t ReadStored(void *buffer, size_t size);
+    size_t ReadSparse(void *buffer, size_t size);
 
     wxString GetExtendedHeader(const wxString& key) const;
     wxString GetHeaderPath() const;
@@ -193,6 +211,12 @@ private:
     wxFileOffset m_offset;  // offset to the start of the entry's data
     wxFileOffset m_size;    // size of the current entry's data
 
+    // for sparse entries, the data stored in the archive is smaller than the
+    // entry itself, these give the position and size of the stored data
+    wxFileOffset m_storedPos;
+    wxFileOffset m_storedSize;
+    wxTarEntry::wxTarSparseMap m_sparseMap;
+
     int m_sumType;
     int m_tarType;
     class wxTarHeaderBlock *m_hdr;
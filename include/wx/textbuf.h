@@ -44,6 +44,8 @@ WX_DEFINE_USER_EXPORTED_ARRAY_INT(wxTextFileType,
                                   wxArrayLinesType,
                                   class WXDLLIMPEXP_BASE);
 
+class wxTextBufferLazyLines;
+
 #endif // wxUSE_TEXTBUFFER
 
 class WXDLLIMPEXP_BASE wxTextBuffer
@@ -96,37 +98,48 @@ public:
     // ---------
 
     // get the number of lines in the buffer
-    size_t GetLineCount() const { return m_aLines.size(); }
+    size_t GetLineCount() const
+        { return m_lazyLines ? DoGetLazyLineCount() : m_aLines.size(); }
 
     // the returned line may be modified (but don't add CR/LF at the end!)
-          wxString& GetLine(size_t n)          { return m_aLines[n]; }
-    const wxString& GetLine(size_t n)    const { return m_aLines[n]; }
-          wxString& operator[](size_t n)       { return m_aLines[n]; }
-    const wxString& operator[](size_t n) const { return m_aLines[n]; }
+    //
+    // notice that if the lines are decoded lazily, i.e. IsLazy() returns
+    // true, the returned reference is only valid until a few other lines are
+    // accessed and modifying it doesn't modify the buffer
+          wxString& GetLine(size_t n)
+        { return m_lazyLines ? DoGetLazyLine(n) : m_aLines[n]; }
+    const wxString& GetLine(size_t n) const
+        { return m_lazyLines ? DoGetLazyLine(n) : m_aLines[n]; }
+          wxString& operator[](size_t n)       { return GetLine(n); }
+    const wxString& operator[](size_t n) const { return GetLine(n); }
+
+    // return true if the lines are decoded only when they are accessed
+    bool IsLazy() const { return m_lazyLines != nullptr; }
 
     // the current line has meaning only when you're using
     // GetFirstLine()/GetNextLine() functions, it doesn't get updated when
     // you're using "direct access" i.e. GetLine()
     size_t GetCurrentLine() const { return m_nCurLine; }
     void GoToLine(size_t n) { m_nCurLine = n; }
-    bool Eof() const { return m_nCurLine == m_aLines.size(); }
+    bool Eof() const { return m_nCurLine == GetLineCount(); }
 
     // these methods allow more "iterator-like" traversal of the list of
     // lines, i.e. you may write something like:
     //  for ( str = GetFirstLine(); !Eof(); str = GetNextLine() ) { ... }
 
     wxString& GetFirstLine()
-        { return m_aLines.empty() ? ms_eof : m_aLines[m_nCurLine = 0]; }
+        { return GetLineCount() == 0 ? ms_eof : GetLine(m_nCurLine = 0); }
     wxString& GetNextLine()
-        { return ++m_nCurLine == m_aLines.size() ? ms_eof
-                                                 : m_aLines[m_nCurLine]; }
+        { return ++m_nCurLine == GetLineCount() ? ms_eof
+                                                : GetLine(m_nCurLine); }
     wxString& GetPrevLine()
-        { wxASSERT(m_nCurLine > 0); return m_aLines[--m_nCurLine]; }
+        { wxASSERT(m_nCurLine > 0); return GetLine(--m_nCurLine); }
     wxString& GetLastLine()
-        { return m_aLines.empty() ? ms_eof : m_aLines[m_nCurLine = m_aLines.size() - 1]; }
+        { return GetLineCount() == 0 ? ms_eof : GetLine(m_nCurLine = GetLineCount() - 1); }
 
     // get the type of the line (see also GetEOL)
-    wxTextFileType GetLineType(size_t n) const { return m_aTypes[n]; }
+    wxTextFileType GetLineType(size_t n) const
+        { return m_lazyLines ? DoGetLazyLineType(n) : m_aTypes[n]; }
 
     // guess the type of buffer
     wxTextFileType GuessType() const;
@@ -137,14 +150,26 @@ public:
     // add/remove lines
     // ----------------
 
+    // all these functions decode all the lines first if they were decoded
+    // lazily before
+
     // add a line to the end
     void AddLine(const wxString& str, wxTextFileType type = typeDefault)
-        { m_aLines.push_back(str); m_aTypes.push_back(type); }
+    {
+        if ( m_lazyLines )
+            LoadLazyLines();
+
+        m_aLines.push_back(str);
+        m_aTypes.push_back(type);
+    }
     // insert a line before the line number n
     void InsertLine(const wxString& str,
                   size_t n,
                   wxTextFileType type = typeDefault)
     {
+        if ( m_lazyLines )
+            LoadLazyLines();
+
         m_aLines.insert(m_aLines.begin() + n, str);
         m_aTypes.insert(m_aTypes.begin()+n, type);
     }
@@ -152,12 +177,15 @@ public:
     // delete one line
     void RemoveLine(size_t n)
     {
+        if ( m_lazyLines )
+            LoadLazyLines();
+
         m_aLines.erase(m_aLines.begin() + n);
         m_aTypes.erase(m_aTypes.begin() + n);
     }
 
     // remove all lines
-    void Clear() { m_aLines.clear(); m_aTypes.clear(); m_nCurLine = 0; }
+    void Clear();
 
     // change the buffer (default argument means "don't change type")
     // possibly in another format
@@ -172,7 +200,7 @@ protected:
     // -----
 
     // default ctor, use Open(string)
-    wxTextBuffer() { m_nCurLine = 0; m_isOpened = false; }
+    wxTextBuffer() { m_lazyLines = nullptr; m_nCurLine = 0; m_isOpened = false; }
 
     // ctor from filename
     wxTextBuffer(const wxString& strBufferName);
@@ -187,13 +215,40 @@ protected:
     virtual bool OnRead(const wxMBConv& conv) = 0;
     virtual bool OnWrite(wxTextFileType typeNew, const wxMBConv& conv) = 0;
 
+    // May be called from OnRead() to use the given data as the buffer
+    // contents, splitting it in lines immediately but only decoding the
+    // individual lines when they're accessed. The data must remain valid
+    // until OnReleaseData() is called.
+    //
+    // Returns false if the data can't be used like this, e.g. because the
+    // conversion isn't ASCII-compatible, and should be read normally.
+    bool SetLazyData(const char* data, size_t len, const wxMBConv& conv);
+
+    // Called when the data passed to SetLazyData() is not needed any more.
+    virtual void OnReleaseData() { }
+
     static wxString ms_eof;     // dummy string returned at EOF
     wxString m_strBufferName;   // name of the buffer
 
 private:
+    // implementation of the public functions for the lazy mode
+    size_t DoGetLazyLineCount() const;
+    wxString& DoGetLazyLine(size_t n) const;
+    wxTextFileType DoGetLazyLineType(size_t n) const;
+
+    // decode all lines and store them in m_aLines, leaving the lazy mode
+    void LoadLazyLines();
+
+    // free m_lazyLines and call OnReleaseData()
+    void FreeLazyLines();
+
     wxArrayLinesType m_aTypes;   // type of each line
     wxArrayString    m_aLines;   // lines of file
 
+    // non-null only if the lines are decoded lazily, m_aTypes and m_aLines
+    // are empty then
+    wxTextBufferLazyLines *m_lazyLines;
+
     size_t        m_nCurLine; // number of current line in the buffer
 
     bool          m_isOpened; // was the buffer successfully opened the last time?
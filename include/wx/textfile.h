@@ -31,6 +31,16 @@ public:
     wxTextFile() = default;
     wxTextFile(const wxString& strFileName);
 
+    virtual ~wxTextFile();
+
+    // open the file by mapping it in memory and decoding its lines only when
+    // they are accessed, falling back to Open() if this is not possible
+    bool OpenMapped(const wxString& strFileName,
+                    const wxMBConv& conv = wxConvAuto());
+
+    // return true if the file contents is currently mapped in memory
+    bool IsMapped() const { return m_mapData != nullptr; }
+
 protected:
     // implement the base class pure virtuals
     virtual bool OnExists() const override;
@@ -39,11 +49,21 @@ protected:
     virtual bool OnClose() override;
     virtual bool OnRead(const wxMBConv& conv) override;
     virtual bool OnWrite(wxTextFileType typeNew, const wxMBConv& conv) override;
+    virtual void OnReleaseData() override;
 
 private:
+    // map the file contents and use it as lazy data, called from OnRead()
+    bool DoMapFile(const wxMBConv& conv);
 
     wxFile m_file;
 
+    // the file contents if it is mapped in memory and its size
+    void* m_mapData = nullptr;
+    size_t m_mapLen = 0;
+
+    // true only while opening the file from OpenMapped()
+    bool m_mapOnRead = false;
+
     wxDECLARE_NO_COPY_CLASS(wxTextFile);
 };
 
@@ -25,10 +25,22 @@ public:
 
     virtual ~wxInotifyFileSystemWatcher();
 
+    // Override the base class functions to watch the entire tree using a
+    // single fanotify mark if possible, which is much more efficient than
+    // adding an inotify watch for every subdirectory.
+    virtual bool AddTree(const wxFileName& path, int events = wxFSW_EVENT_ALL,
+                         const wxString& filespec = wxEmptyString) override;
+
+    virtual bool RemoveTree(const wxFileName& path) override;
+
     void OnDirDeleted(const wxString& path);
 
 protected:
     bool Init();
+
+    friend bool
+    wxFSWatcherIsUsingFanotify(const wxInotifyFileSystemWatcher& watcher,
+                               const wxFileName& path);
 };
 
 #endif
@@ -12,15 +12,31 @@
 
 #include "wx/private/fdiomanager.h"
 
+class WXDLLIMPEXP_FWD_BASE wxFDIODispatcher;
+
 // ----------------------------------------------------------------------------
 // wxFDIOManagerUnix: implement wxFDIOManager interface using wxFDIODispatcher
 // ----------------------------------------------------------------------------
 
-class wxFDIOManagerUnix : public wxFDIOManager
+class WXDLLIMPEXP_BASE wxFDIOManagerUnix : public wxFDIOManager
 {
 public:
+    // use the global dispatcher by default or the given one, which must
+    // outlive this object, if it's not null
+    explicit wxFDIOManagerUnix(wxFDIODispatcher *dispatcher = nullptr)
+        : m_dispatcher(dispatcher)
+    {
+    }
+
     virtual int AddInput(wxFDIOHandler *handler, int fd, Direction d) override;
     virtual void RemoveInput(wxFDIOHandler *handler, int fd, Direction d) override;
+
+private:
+    wxFDIODispatcher *GetDispatcher() const;
+
+    wxFDIODispatcher * const m_dispatcher;
+
+    wxDECLARE_NO_COPY_CLASS(wxFDIOManagerUnix);
 };
 
 #endif // _UNIX_PRIVATE_FDIOUNIX_H_
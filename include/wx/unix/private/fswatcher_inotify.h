@@ -68,4 +68,10 @@ protected:
     wxFSWatcherImplUnix* m_service;
 };
 
+// Return true if the given tree is watched using fanotify rather than inotify
+// watches for all its subdirectories, only used by the tests.
+WXDLLIMPEXP_BASE bool
+wxFSWatcherIsUsingFanotify(const wxInotifyFileSystemWatcher& watcher,
+                           const wxFileName& path);
+
 #endif /* WX_UNIX_PRIVATE_FSWATCHER_INOTIFY_H_ */
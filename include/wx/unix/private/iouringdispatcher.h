@@ -0,0 +1,168 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        wx/unix/private/iouringdispatcher.h
+// Purpose:     wxIoUringDispatcher class
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_PRIVATE_IOURINGDISPATCHER_H_
+#define _WX_PRIVATE_IOURINGDISPATCHER_H_
+
+#include "wx/defs.h"
+
+#if wxUSE_EPOLL_DISPATCHER && defined(wxHAS_IO_URING)
+
+#include "wx/private/fdiodispatcher.h"
+#include "wx/thread.h"
+
+#include <unordered_map>
+#include <vector>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+struct io_uring_params;
+
+// Dispatcher using Linux io_uring multishot poll requests instead of
+// epoll_ctl() and epoll_wait() calls.
+//
+// The changes to the registered descriptors are only queued in the
+// submission ring and are submitted to the kernel all at once, together with
+// waiting for the events, in the next call to Dispatch(), and all the
+// available completions are processed by each call to it.
+class WXDLLIMPEXP_BASE wxIoUringDispatcher : public wxFDIODispatcher
+{
+public:
+    // create a new instance of this class, returns nullptr if io_uring is not
+    // supported by the running kernel or is disabled, in which case
+    // wxEpollDispatcher should be used instead
+    //
+    // the caller should delete the returned pointer
+    static wxIoUringDispatcher *Create();
+
+    virtual ~wxIoUringDispatcher();
+
+    // implement base class pure virtual methods
+    virtual bool RegisterFD(int fd, wxFDIOHandler* handler, int flags = wxFDIO_ALL) override;
+    virtual bool ModifyFD(int fd, wxFDIOHandler* handler, int flags = wxFDIO_ALL) override;
+    virtual bool UnregisterFD(int fd) override;
+    virtual bool HasPending() const override;
+    virtual int Dispatch(int timeout = TIMEOUT_INFINITE) override;
+
+private:
+    // information about a registered descriptor
+    struct Entry
+    {
+        wxFDIOHandler *handler;
+        int flags;
+
+        // identifier of the last poll request for this descriptor, used to
+        // recognize the completions of the requests which were cancelled
+        wxUint32 id;
+
+        // true if the poll request is active in the kernel
+        bool armed;
+
+        // true if an event for this descriptor is waiting to be dispatched
+        bool pending;
+    };
+
+    // an event harvested from the completion ring
+    struct Event
+    {
+        int fd;
+        wxUint32 id;
+        int events;
+    };
+
+    // ctor is private, use Create()
+    wxIoUringDispatcher() = default;
+
+    // map the rings of the just created io_uring with the given descriptor
+    bool Init(int ringFD, const io_uring_params& params);
+
+    // queue the poll request for the given descriptor
+    bool Arm(int fd, Entry& entry);
+
+    // queue the removal of the pending poll request for the descriptor, if
+    // there is one
+    bool Disarm(int fd, Entry& entry);
+
+    // get a new zeroed submission queue entry, submitting the already queued
+    // ones first if the ring is full; returns nullptr only if this failed
+    io_uring_sqe *GetSQE();
+
+    // submit all the queued entries to the kernel without waiting
+    bool Submit();
+
+    // submit the queued entries only if another thread is currently waiting
+    // in Dispatch(), as it wouldn't take them into account otherwise
+    void SubmitIfWaiting();
+
+    // submit the queued entries and wait for at most the given timeout for
+    // at least one completion, returns -1 on error
+    int Wait(int timeout);
+
+    // move all available completions to the given vector
+    void Harvest(std::vector<Event>& events);
+
+    // add the events for the descriptors which are still ready to m_pending,
+    // the events field of the elements of the vector must contain the
+    // POLLxxx mask to check for; this function locks m_cs itself
+    void CheckStillReady(const std::vector<Event>& events);
+
+    // the number of entries queued but not consumed by the kernel yet
+    unsigned GetQueuedCount() const;
+
+    // all the functions above must be called with m_cs locked, unless
+    // specified otherwise, except for Init() and Wait() which lock it
+    // themselves
+
+
+    // the ring descriptor and the memory mapped from it
+    int m_ringFD = -1;
+    void *m_ringPtr = nullptr;
+    size_t m_ringSize = 0;
+    io_uring_sqe *m_sqes = nullptr;
+    size_t m_sqesSize = 0;
+
+    // submission ring
+    unsigned *m_sqHead = nullptr;
+    unsigned *m_sqTail = nullptr;
+    unsigned *m_sqFlags = nullptr;
+    unsigned m_sqMask = 0;
+    unsigned m_sqEntries = 0;
+
+    // the tail of the submission ring including the entries not published
+    // to the kernel yet
+    unsigned m_sqTailLocal = 0;
+
+    // completion ring
+    unsigned *m_cqHead = nullptr;
+    unsigned *m_cqTail = nullptr;
+    unsigned m_cqMask = 0;
+    io_uring_cqe *m_cqes = nullptr;
+
+    // all registered descriptors
+    std::unordered_map<int, Entry> m_entries;
+
+    // the last used poll request identifier
+    wxUint32 m_lastId = 0;
+
+    // number of threads currently blocked inside Dispatch()
+    int m_waiting = 0;
+
+    // the events found by CheckStillReady() to be dispatched by the next
+    // Dispatch() call
+    std::vector<Event> m_pending;
+
+    // protects all the fields above
+    wxCRIT_SECT_DECLARE_MEMBER(m_cs);
+
+    wxDECLARE_NO_COPY_CLASS(wxIoUringDispatcher);
+};
+
+#endif // wxUSE_EPOLL_DISPATCHER && wxHAS_IO_URING
+
+#endif // _WX_PRIVATE_IOURINGDISPATCHER_H_
@@ -121,6 +121,13 @@ public:
         m_fdioManager = nullptr;
     }
 
+    // ctor for a manager using the given FD IO manager, OnInit() doesn't need
+    // to be called for the objects created using it
+    explicit wxSocketFDBasedManager(wxFDIOManager *fdioManager)
+    {
+        m_fdioManager = fdioManager;
+    }
+
     virtual bool OnInit() override;
     virtual void OnExit() override { }
 
@@ -0,0 +1,151 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/unix/private/tzinfo.h
+// Purpose:     wxTimeZoneInfo class using the zoneinfo database
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_UNIX_PRIVATE_TZINFO_H_
+#define _WX_UNIX_PRIVATE_TZINFO_H_
+
+#ifndef WX_GMTOFF_IN_TM
+    // Define it for some systems which don't (always) use configure but are
+    // known to have tm_gmtoff field.
+    #if defined(__DARWIN__)
+        #define WX_GMTOFF_IN_TM
+    #endif
+#endif
+
+// We need to be able to fill tm_gmtoff and tm_zone fields of struct tm to
+// return the same results as the CRT functions, so only use our own code if
+// they're available.
+#ifdef WX_GMTOFF_IN_TM
+    #define wxHAS_TIMEZONEINFO
+#endif
+
+#ifdef wxHAS_TIMEZONEINFO
+
+#include <time.h>
+
+#include <string>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// wxTimeZoneInfo: time zone transition rules read from zoneinfo files
+// ----------------------------------------------------------------------------
+
+// This class allows to convert between UTC and local time without calling
+// tzset(), localtime_r() or mktime() which all need to lock the global time
+// zone state of the CRT. The zones are loaded once and never modified, so
+// the objects of this class can be used from any thread.
+class WXDLLIMPEXP_BASE wxTimeZoneInfo
+{
+public:
+    // Return the local time zone, as defined by the current value of TZ
+    // environment variable or by /etc/localtime if it is not set.
+    //
+    // Returns nullptr if the local time zone can't be loaded, in which case
+    // the CRT functions should be used instead.
+    static const wxTimeZoneInfo* GetLocal();
+
+    // Return the zone with the given name which can be either the name of a
+    // file in the zoneinfo directory, e.g. "Europe/Paris", optionally
+    // prefixed by a colon, an absolute path or a POSIX TZ string, e.g.
+    // "CET-1CEST,M3.5.0,M10.5.0/3".
+    //
+    // The returned pointer remains valid until the end of the program.
+    // Returns nullptr if the zone couldn't be loaded.
+    static const wxTimeZoneInfo* Get(const char* name);
+
+    // Convert UTC time to the broken down local time, like localtime_r().
+    void ToLocal(wxInt64 t, struct tm& tm) const;
+
+    // Convert the broken down local time to UTC, like mktime(), normalizing
+    // the fields of tm. Nonexistent times, i.e. those inside a DST gap, are
+    // interpreted using the offset in effect before the gap and ambiguous
+    // ones use the standard time unless tm_isdst is positive.
+    wxInt64 FromLocal(struct tm& tm) const;
+
+    // Fill tm with the broken down time for the given UTC time, like
+    // gmtime_r(), but with the specified offset (in seconds east of UTC)
+    // added to it. tm_zone is set to "GMT".
+    static void BreakDown(wxInt64 t, long offset, struct tm& tm);
+
+private:
+    // Time type, i.e. an offset from UTC with its abbreviation.
+    struct TimeType
+    {
+        long offset;        // In seconds east of UTC.
+        bool isDST;
+        size_t abbr;        // Index into m_abbrs.
+    };
+
+    // Rule for the start or end of DST in POSIX TZ string.
+    struct Rule
+    {
+        enum Kind
+        {
+            Julian1,        // Jn: 1-based day of year, Feb 29 is not counted.
+            Julian0,        // n: 0-based day of year, Feb 29 is counted.
+            MonthWeekDay    // Mm.w.d: day d of week w of month m.
+        };
+
+        Kind kind;
+        int day;
+        int week;
+        int month;
+        long time;          // Local time of the change, in seconds.
+    };
+
+    wxTimeZoneInfo() = default;
+
+    bool LoadFile(const char* path);
+    bool ParsePosixTZ(const char* s);
+
+    // Return the time type used at the given UTC time.
+    const TimeType& GetTypeAt(wxInt64 t) const;
+
+    // Return the next time after t when the time type changes or false if
+    // there are no more changes.
+    bool GetNextChange(wxInt64 t, wxInt64* next) const;
+
+    // Get the UTC times of the DST start and end from the POSIX TZ rule in
+    // the given year.
+    void GetRuleChanges(wxInt64 year, wxInt64* start, wxInt64* end) const;
+
+    const char* GetAbbr(const TimeType& type) const
+    {
+        return m_abbrs.c_str() + type.abbr;
+    }
+
+
+    // Transition times from the file and the indices of the types used
+    // after each of them.
+    std::vector<wxInt64> m_transitions;
+    std::vector<unsigned char> m_transitionTypes;
+
+    // All the time types used by the transitions.
+    std::vector<TimeType> m_types;
+
+    // The type used before the first transition.
+    size_t m_firstType = 0;
+
+    // NUL-separated abbreviations of all time types.
+    std::string m_abbrs;
+
+    // The rule from the POSIX TZ string used after the last transition.
+    bool m_hasRule = false;
+    TimeType m_std = TimeType();
+    TimeType m_dst = TimeType();
+    bool m_hasDST = false;
+    Rule m_start = Rule();
+    Rule m_end = Rule();
+
+    wxDECLARE_NO_COPY_CLASS(wxTimeZoneInfo);
+};
+
+#endif // wxHAS_TIMEZONEINFO
+
+#endif // _WX_UNIX_PRIVATE_TZINFO_H_
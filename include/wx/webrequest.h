@@ -150,7 +150,8 @@ public:
     {
         Storage_Memory,
         Storage_File,
-        Storage_None
+        Storage_None,
+        Storage_Stream
     };
 
     struct Result
@@ -346,6 +347,86 @@ private:
     wxString m_url;
 };
 
+// Options controlling the connections used by the web session.
+class wxWebConnectionOptions
+{
+public:
+    wxWebConnectionOptions() = default;
+
+    // Limit the number of simultaneous connections to the same host, 0 means
+    // to use the backend default.
+    wxWebConnectionOptions& SetMaxConnectionsPerHost(unsigned n)
+        { m_maxConnectionsPerHost = n; return *this; }
+    unsigned GetMaxConnectionsPerHost() const { return m_maxConnectionsPerHost; }
+
+    // Limit the total number of connections, including the idle ones kept
+    // open for reuse, 0 means to use the backend default.
+    wxWebConnectionOptions& SetMaxConnections(unsigned n)
+        { m_maxConnections = n; return *this; }
+    unsigned GetMaxConnections() const { return m_maxConnections; }
+
+    // Use HTTP/2 and send several requests over the same connection when
+    // possible.
+    wxWebConnectionOptions& EnableMultiplexing(bool enable = true)
+        { m_multiplexing = enable; return *this; }
+    bool IsMultiplexingEnabled() const { return m_multiplexing; }
+
+    // Wait for an existing connection supporting multiplexing instead of
+    // opening a new one for the requests to the same host.
+    wxWebConnectionOptions& SetWaitForMultiplexing(bool wait = true)
+        { m_waitForMultiplexing = wait; return *this; }
+    bool ShouldWaitForMultiplexing() const { return m_waitForMultiplexing; }
+
+    // Keep the resolved host names for the given number of seconds, 0 to
+    // disable caching them or -1 to cache them forever.
+    wxWebConnectionOptions& SetDNSCacheTimeout(int seconds)
+        { m_dnsCacheTimeout = seconds; return *this; }
+    int GetDNSCacheTimeout() const { return m_dnsCacheTimeout; }
+
+private:
+    unsigned m_maxConnectionsPerHost = 0;
+    unsigned m_maxConnections = 0;
+    bool m_multiplexing = true;
+    bool m_waitForMultiplexing = false;
+    int m_dnsCacheTimeout = 60;
+};
+
+// Statistics about the connections used by the web session.
+class wxWebConnectionStats
+{
+public:
+    wxWebConnectionStats() = default;
+
+    wxWebConnectionStats(wxUint64 requests,
+                         wxUint64 newConnections,
+                         wxUint64 reusedConnections,
+                         wxUint64 multiplexedRequests)
+        : m_requests(requests),
+          m_newConnections(newConnections),
+          m_reusedConnections(reusedConnections),
+          m_multiplexedRequests(multiplexedRequests)
+    {
+    }
+
+    // Number of requests which got a response from the server.
+    wxUint64 GetRequestCount() const { return m_requests; }
+
+    // Number of connections opened for these requests.
+    wxUint64 GetNewConnectionCount() const { return m_newConnections; }
+
+    // Number of requests which reused an already opened connection.
+    wxUint64 GetReusedConnectionCount() const { return m_reusedConnections; }
+
+    // Number of requests using a protocol allowing multiplexing (HTTP/2+).
+    wxUint64 GetMultiplexedRequestCount() const { return m_multiplexedRequests; }
+
+private:
+    wxUint64 m_requests = 0;
+    wxUint64 m_newConnections = 0;
+    wxUint64 m_reusedConnections = 0;
+    wxUint64 m_multiplexedRequests = 0;
+};
+
 extern WXDLLIMPEXP_DATA_NET(const char) wxWebSessionBackendWinHTTP[];
 extern WXDLLIMPEXP_DATA_NET(const char) wxWebSessionBackendURLSession[];
 extern WXDLLIMPEXP_DATA_NET(const char) wxWebSessionBackendCURL[];
@@ -377,6 +458,10 @@ public:
 
     bool SetProxy(const wxWebProxy& proxy);
 
+    bool SetConnectionOptions(const wxWebConnectionOptions& options);
+
+    wxWebConnectionStats GetConnectionStats() const;
+
     bool IsOpened() const;
 
     void Close();
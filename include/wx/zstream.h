@@ -30,9 +30,12 @@ enum wxZLibFlags {
     wxZLIB_NO_HEADER = 0,    // raw deflate stream, no header or checksum
     wxZLIB_ZLIB = 1,         // zlib header and checksum
     wxZLIB_GZIP = 2,         // gzip header and checksum, requires zlib 1.2.1+
-    wxZLIB_AUTO = 3          // autodetect header zlib or gzip
+    wxZLIB_AUTO = 3,         // autodetect header zlib or gzip
+    wxZLIB_GZIP_MULTI = 4    // all members of a multi-member gzip
 };
 
+class wxZlibParallelInflater;
+
 class WXDLLIMPEXP_BASE wxZlibInputStream: public wxFilterInputStream {
  public:
   wxZlibInputStream(wxInputStream& stream, int flags = wxZLIB_AUTO);
@@ -47,12 +50,21 @@ class WXDLLIMPEXP_BASE wxZlibInputStream: public wxFilterInputStream {
   bool SetDictionary(const char *data, size_t datalen);
   bool SetDictionary(const wxMemoryBuffer &buf);
 
+  void SetThreadCount(unsigned count);
+
  protected:
   size_t OnSysRead(void *buffer, size_t size) override;
   wxFileOffset OnSysTell() const override { return m_pos; }
 
  private:
   void Init(int flags);
+  size_t DoInflate(void *buffer, size_t size);
+  bool StartNextMember();
+
+  bool m_multiMember;
+  bool m_firstMember;
+  bool m_inMember;
+  wxZlibParallelInflater *m_parallel;
 
  protected:
   size_t m_z_size;
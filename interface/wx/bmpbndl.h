@@ -323,6 +323,60 @@ public:
      */
     static wxBitmapBundle FromSVGResource(const wxString& name, const wxSize& sizeDef);
 
+    /**
+        Set the maximal amount of memory used for caching the bitmaps of the
+        bundles created from SVG.
+
+        Each bundle created by FromSVG() or the related functions keeps the
+        bitmaps of the last few sizes requested from it, so that GetBitmap()
+        doesn't need to rasterize the image again when switching between
+        them, e.g. when the window is moved to a monitor with a different DPI.
+        All these bitmaps are kept in a single cache shared by all bundles and
+        the least recently used of them are discarded when the total size of
+        the bitmaps exceeds the limit set by this function, which is 32MB by
+        default. Notice that the last used bitmap is always kept, even if it
+        is bigger than the limit.
+
+        This function is only available if @c wxHAS_SVG is defined.
+
+        @param bytes The memory limit, in bytes, assuming that each pixel of
+            a bitmap uses 4 bytes.
+
+        @since 3.3.2
+     */
+    static void SetSVGCacheLimit(size_t bytes);
+
+    /**
+        Rasterize the images of the bundles created from SVG in advance.
+
+        This function creates the bitmaps of the given size for all the
+        bundles created from SVG in the provided vector, so that the
+        subsequent calls to GetBitmap() for this size return immediately. The
+        bundles not created from SVG are ignored.
+
+        Rasterizing is done using multiple threads if possible, which makes
+        this function much faster than calling GetBitmap() for each of the
+        bundles when there are many of them, e.g. for a toolbar with many SVG
+        icons after a DPI change. This function must still be called from the
+        main thread only.
+
+        The bitmaps created by this function are subject to the limit set by
+        SetSVGCacheLimit() and some of them can be discarded if it is too
+        small for all of them.
+
+        This function is only available if @c wxHAS_SVG is defined and does
+        nothing if wxWidgets was built without RTTI support (i.e. with @c
+        wxNO_RTTI defined).
+
+        @param bundles The bundles to rasterize.
+        @param size The size of the bitmaps to create. If it is
+            ::wxDefaultSize, the default size of each bundle is used.
+
+        @since 3.3.2
+     */
+    static void PrerenderSVG(const wxVector<wxBitmapBundle>& bundles,
+                             const wxSize& size = wxDefaultSize);
+
     /**
         Clear the existing bundle contents.
 
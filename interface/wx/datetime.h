@@ -932,7 +932,7 @@ public:
         and the format specification @c "%l" can be used to get the number of
         milliseconds.
 
-        @see ParseFormat()
+        @see ParseFormat(), wxDateTimeFormatter
     */
     wxString Format(const wxString& format = wxDefaultDateTimeFormat,
                     const TimeZone& tz = Local) const;
@@ -1048,7 +1048,7 @@ public:
             @true if at least part of the string was parsed successfully,
             @false otherwise.
 
-        @see Format()
+        @see Format(), wxDateTimeFormatter
     */
     bool ParseFormat(const wxString& date,
                      const wxString& format,
@@ -1674,6 +1674,130 @@ const wxDateTime wxDefaultDateTime;
 #define wxInvalidDateTime wxDefaultDateTime
 
 
+/**
+    @class wxDateTimeFormatter
+
+    Object formatting and parsing dates using the given format.
+
+    This class produces exactly the same results as wxDateTime::Format() and
+    wxDateTime::ParseFormat() but analyses the format string only once, when
+    it is created, instead of doing it every time, which makes it much faster
+    when many dates need to be formatted or parsed using the same format, e.g.
+    when showing a column of dates in a table or reading them from a file.
+
+    Example of using it:
+    @code
+    const wxDateTimeFormatter formatter("%Y-%m-%d %H:%M:%S");
+
+    wxString text;
+    for ( const wxDateTime& dt : dates )
+    {
+        formatter.FormatTo(text, dt);
+        text += '\n';
+    }
+    @endcode
+
+    As the object is not modified by any of its methods after its creation,
+    it can be used by several threads simultaneously.
+
+    @library{wxbase}
+    @category{data}
+
+    @since 3.3.2
+*/
+class wxDateTimeFormatter
+{
+public:
+    /**
+        Create the formatter using the given format.
+
+        See wxDateTime::Format() for the description of the format string. It
+        must not be empty.
+    */
+    explicit wxDateTimeFormatter(const wxString& format = wxDefaultDateTimeFormat);
+
+    /**
+        Return the format used by this object.
+    */
+    const wxString& GetFormat() const;
+
+    /**
+        Append the string representation of the date to the given string.
+
+        The appended text is the same as returned by wxDateTime::Format(), but
+        this function doesn't need to allocate a new string if @a str already
+        has enough space for it, so it's even more efficient to reuse the same
+        string for formatting many dates.
+    */
+    void FormatTo(wxString& str,
+                  const wxDateTime& dt,
+                  const wxDateTime::TimeZone& tz = wxDateTime::Local) const;
+
+    /**
+        Return the string representation of the date.
+
+        This is the same as wxDateTime::Format() with the format of this
+        object.
+    */
+    wxString Format(const wxDateTime& dt,
+                    const wxDateTime::TimeZone& tz = wxDateTime::Local) const;
+
+    /**
+        Parse the string containing the date in the format of this object.
+
+        This works in the same way as wxDateTime::ParseFormat(), including the
+        use of @a dateDef, or the current value of @a dt if @a dateDef is
+        invalid, or today's date if both of them are, for the date components
+        not specified in the string.
+
+        @param date
+            The string to parse.
+        @param dt
+            Non-null pointer to the date which is only modified if the string
+            was parsed successfully.
+        @param dateDef
+            Used to fill in the date components not specified in the @a date
+            string.
+        @param end
+            If non-null, filled with the iterator pointing to the location
+            where the parsing stopped if the function returns @true. If it is
+            null, the entire string must be parsed for this function to
+            succeed.
+        @return
+            @true if the string was parsed successfully, @false otherwise.
+    */
+    bool Parse(const wxString& date,
+               wxDateTime* dt,
+               const wxDateTime& dateDef = wxDefaultDateTime,
+               wxString::const_iterator* end = nullptr) const;
+
+    /**
+        Parse all the given strings.
+
+        This is similar to calling Parse() for all strings, but more efficient
+        as the date used for the components not specified in the strings is
+        determined only once: it is @a dateDef if it is valid or today's date
+        otherwise.
+
+        Each string must be parsed entirely to be considered valid.
+
+        @param strings
+            The strings to parse.
+        @param dates
+            Filled with the dates corresponding to the strings on return, the
+            elements corresponding to the strings which couldn't be parsed are
+            set to ::wxInvalidDateTime.
+        @param dateDef
+            Used to fill in the date components not specified in the strings.
+        @return
+            The number of successfully parsed strings.
+    */
+    size_t ParseAll(const std::vector<wxString>& strings,
+                    std::vector<wxDateTime>& dates,
+                    const wxDateTime& dateDef = wxDefaultDateTime) const;
+};
+
+
 /**
     @class wxDateTimeWorkDays
 
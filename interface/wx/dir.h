@@ -122,6 +122,32 @@ enum wxDirFlags
      */
     wxDIR_NO_FOLLOW = 0x0010,
 
+    /**
+        Read the subdirectories in parallel when using wxDir::Traverse().
+
+        This can make traversing big directory trees, especially located on
+        network file systems, significantly faster, but uses more memory, as
+        the contents of the subdirectories is read ahead of the calls to
+        wxDirTraverser methods for them. This flag is ignored by the other
+        functions and when threads are not available.
+
+        @since 3.3.2
+     */
+    wxDIR_PARALLEL  = 0x0020,
+
+    /**
+        Allow calling wxDirTraverser methods in any order.
+
+        This flag is only used together with ::wxDIR_PARALLEL and allows
+        wxDir::Traverse() to process the directories in the order in which
+        they are read instead of the usual depth-first one. Only the
+        directories for which wxDirTraverser::OnDir() returns ::wxDIR_CONTINUE
+        are read in this case and so less memory is used.
+
+        @since 3.3.2
+     */
+    wxDIR_UNORDERED = 0x0040,
+
     /**
         Default directory traversal flags include both files and directories,
         even hidden.
@@ -368,6 +394,15 @@ public:
         The function returns the total number of files found or @c "(size_t)-1"
         on error.
 
+        If @a flags contains ::wxDIR_PARALLEL, the directories are read by
+        several worker threads, but the @a sink methods are still called from
+        the thread calling this function only, so it doesn't need to be
+        thread-safe. By default they are also called in exactly the same
+        order as without this flag, which requires reading the subdirectories
+        before calling OnDir() for them, but ::wxDIR_UNORDERED can be used to
+        relax this requirement. Notice that returning ::wxDIR_STOP from any of
+        the callbacks stops the traversal completely in the parallel mode.
+
         See ::wxDirFlags for the full list of the possible flags.
 
         @see GetAllFiles()
@@ -203,6 +203,76 @@ public:
     */
     void DisableAutoSave();
 
+    /**
+        Enable writing the file in the background.
+
+        In write-behind mode, Flush() doesn't write the file itself but only
+        takes a snapshot of its contents and returns immediately. The file is
+        written by a background thread once no more changes were flushed
+        during the given @a delay, so that flushing the changes frequently,
+        e.g. after each change of the window layout, doesn't block the calling
+        thread and the file is written only once for all of them. As long as
+        the changes keep being flushed, the file is still written at least
+        every few delays.
+
+        The file is replaced atomically, so that it always contains either
+        the old or the new data, even if the program is terminated while it
+        is being written.
+
+        Flush() always returns @true in this mode as the errors only happen
+        later, call WaitForPendingWrites() to wait until all the changes are
+        written and check whether this succeeded. The destructor also waits
+        until all the flushed changes are written, even if DisableAutoSave()
+        had been called.
+
+        If wxUSE_THREADS is 0 or if the thread can't be created, Flush() keeps
+        writing the file synchronously.
+
+        @param delay The time, in milliseconds, to wait for more changes
+            before writing the file. Can be 0 to write it as soon as possible.
+
+        @see DisableWriteBehind()
+
+        @since 3.3.2
+    */
+    void EnableWriteBehind(int delay = 1000);
+
+    /**
+        Disable writing the file in the background.
+
+        Waits until all the changes already flushed are written to the file
+        and makes Flush() write the file synchronously again.
+
+        @see EnableWriteBehind()
+
+        @since 3.3.2
+    */
+    void DisableWriteBehind();
+
+    /**
+        Return @true if EnableWriteBehind() had been called.
+
+        @since 3.3.2
+    */
+    bool IsWriteBehindEnabled() const;
+
+    /**
+        Wait until all the changes flushed in write-behind mode are written.
+
+        The changes are written immediately, without waiting for the delay
+        specified in EnableWriteBehind(), and this function blocks until they
+        are written, which makes it suitable for calling when the application
+        is shutting down.
+
+        Does nothing if write-behind mode is not used.
+
+        @return @false if writing the file failed for any of the changes
+            flushed since the last call to this function.
+
+        @since 3.3.2
+    */
+    bool WaitForPendingWrites();
+
     /**
         Allows setting the mode to be used for the config file creation. For example, to
         create a config file which is not readable by other users (useful if it stores
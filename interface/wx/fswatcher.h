@@ -91,6 +91,17 @@ public:
         subdirectory, potentially creating a lot of watches and taking a long
         time to execute.
 
+        Under Linux, fanotify is used instead of inotify when possible, which
+        allows to watch the entire tree using a single watch. This requires
+        Linux 5.9 or later and sufficient privileges (@c CAP_SYS_ADMIN and
+        @c CAP_DAC_READ_SEARCH, i.e. typically running as root), otherwise
+        the function falls back to adding a watch for each subdirectory. Note
+        that only the file system containing @a path is watched when using
+        fanotify, i.e. the changes in the file systems mounted inside the tree
+        are not reported, and that renames are only reported with both the
+        old and the new paths since Linux 5.17. This is available since
+        wxWidgets 3.3.2.
+
         Note that on platforms that use symbolic links, you will probably want
         to have called wxFileName::DontFollowLink on @a path. This is especially
         important if the symlink targets may themselves be watched.
@@ -134,6 +145,29 @@ public:
      */
     int GetWatchedPaths(wxArrayString* paths) const;
 
+    /**
+        Enables coalescing of the events generated during the given interval.
+
+        When coalescing is enabled, the events are not sent immediately but
+        collected for up to @a milliseconds and repeated events of the same
+        type for the same path, e.g. multiple wxFSW_EVENT_MODIFY resulting
+        from writing to the same file several times, are merged into a single
+        one. The relative order of the events for different paths and of the
+        events of different types for the same path is preserved.
+
+        Coalescing is disabled by default and can be disabled again by passing
+        0, in which case all the currently pending events are sent immediately.
+
+        Currently coalescing is only implemented by the inotify-based watcher
+        used under Linux.
+
+        @return @true if coalescing is supported or if @a milliseconds is 0,
+            @false otherwise.
+
+        @since 3.3.2
+     */
+    bool SetCoalescingInterval(int milliseconds);
+
     /**
         Associates the file system watcher with the given @a handler object.
 
@@ -688,6 +688,29 @@ protected:
     */
     virtual void DoLogText(const wxString& msg);
 
+    /**
+        Called to log a record from a thread other than the main one.
+
+        This function is called for the messages logged from the threads
+        which don't have their own log target set with
+        SetThreadActiveTarget(). By default it returns @false and the message
+        is buffered until the next call to FlushActive() from the main thread,
+        which then passes it to DoLogRecord().
+
+        Log targets which can be safely used from multiple threads at once,
+        such as wxLogAsync, may override it to handle the message immediately
+        and return @true.
+
+        Notice that, unlike for the messages passed to DoLogRecord(), @a msg
+        doesn't include any extra information, such as the system error
+        message for wxLogSysError(), and repeated messages are not counted.
+
+        @since 3.3.2
+    */
+    virtual bool DoLogThreadRecord(wxLogLevel level,
+                                   const wxString& msg,
+                                   const wxLogRecordInfo& info);
+
     ///@}
 };
 
@@ -822,6 +845,108 @@ public:
 };
 
 
+/**
+    @class wxLogAsync
+
+    Log target passing the messages to another log target from a separate
+    worker thread.
+
+    This class is useful for programs logging many messages, especially from
+    multiple threads: logging a message only stores it in a buffer specific
+    to the current thread, without any locking, and the messages are passed
+    to the real log target, which may be slow, e.g. because it writes them to
+    a file, by the worker thread. The messages from different threads are
+    passed to it in the order of their time stamps and the messages logged
+    by the same thread are always passed to it in the order they were logged.
+
+    The memory used by this class is bounded: each thread logging messages
+    uses a buffer of the fixed size and, when it is full, the new messages are
+    either dropped or the thread waits until the worker thread processes the
+    existing ones, depending on the policy specified when creating the
+    object. When messages are dropped, a warning indicating how many of them
+    were lost is passed to the target.
+
+    Example of usage:
+    @code
+    delete wxLog::SetActiveTarget(new wxLogAsync(new wxLogStderr));
+    @endcode
+
+    Notice that the log target used by this class must be safe to use from
+    the worker thread, so log targets showing the messages to the user
+    directly can't be used with it, but wxLogStderr and wxLogStream are fine.
+    The target is only used by a single thread at any time, but, if
+    necessary, it is flushed from the thread calling Flush().
+
+    This class is only available if @c wxUSE_THREADS is 1.
+
+    @library{wxbase}
+    @category{logging}
+
+    @since 3.3.2
+*/
+class wxLogAsync : public wxLog
+{
+public:
+    /**
+        Possible values for the overflow policy of wxLogAsync.
+    */
+    enum OverflowPolicy
+    {
+        /// Discard the new messages if the buffer is full.
+        Overflow_Drop,
+
+        /**
+            Wait until there is space in the buffer.
+
+            Note that the messages logged by the log target itself are still
+            dropped when the buffer is full to avoid deadlocks.
+         */
+        Overflow_Block
+    };
+
+    /**
+        Creates the object passing the messages to the given target.
+
+        Notice that this object doesn't install itself as the active log
+        target, use wxLog::SetActiveTarget() to do it.
+
+        @param target The log target to pass the messages to, must be
+            non-@NULL. It is deleted by this object.
+        @param bufferSize The maximal number of messages that can be buffered
+            for each thread, rounded up to a power of two.
+        @param policy Determines what happens when the buffer is full.
+    */
+    explicit wxLogAsync(wxLog *target,
+                        size_t bufferSize = 1024,
+                        OverflowPolicy policy = Overflow_Drop);
+
+    /**
+        Destructor passes all the pending messages to the target and deletes
+        it.
+
+        Notice that it must not be called while other threads may still be
+        logging messages to this object.
+    */
+    virtual ~wxLogAsync();
+
+    /**
+        Returns the log target the messages are passed to.
+    */
+    wxLog *GetTarget() const;
+
+    /**
+        Returns the number of messages dropped because the buffer was full.
+    */
+    unsigned long GetDroppedCount() const;
+
+    /**
+        Waits until all the messages logged so far are passed to the target
+        and flushes it.
+    */
+    virtual void Flush();
+};
+
+
 /**
     @class wxLogStream
 
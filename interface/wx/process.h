@@ -188,6 +188,13 @@ public:
     */
     bool IsInputOpened() const;
 
+    /**
+        Returns @true if RedirectLines() had been called.
+
+        @since 3.3.2
+    */
+    bool IsRedirectingLines() const;
+
     /**
         Send the specified signal to the given process. Possible signal values
         can be one of the ::wxSignal enumeration values.
@@ -208,6 +215,36 @@ public:
     static wxKillError Kill(int pid, wxSignal sig = wxSIGTERM,
                             int flags = wxKILL_NOCHILDREN);
 
+    /**
+        Called for each line of the child process standard error output when
+        using RedirectLines().
+
+        The default implementation does nothing.
+
+        @param line
+            The line without the trailing end of line characters.
+
+        @since 3.3.2
+    */
+    virtual void OnErrorLine(const wxString& line);
+
+    /**
+        Called for each line of the child process standard output when using
+        RedirectLines().
+
+        Any of @c "\n", @c "\r\n" or @c "\r" is considered to be the end of
+        line. The output is decoded using wxConvAuto, exactly as when reading it
+        using wxTextInputStream.
+
+        The default implementation does nothing.
+
+        @param line
+            The line without the trailing end of line characters.
+
+        @since 3.3.2
+    */
+    virtual void OnOutputLine(const wxString& line);
+
     /**
         It is called when the process with the pid @a pid finishes.
         It raises a wxWidgets event when it isn't overridden.
@@ -257,6 +294,29 @@ public:
     */
     void Redirect();
 
+    /**
+        Turns on redirection with line by line output processing.
+
+        This function can be called instead of Redirect() when the process is
+        executed synchronously, i.e. with @c wxEXEC_SYNC flag, to have
+        OnOutputLine() and OnErrorLine() called for each line of the child
+        process standard output and error output as soon as it becomes
+        available. Unlike when using Redirect(), the entire output is never
+        kept in memory, so this is the most efficient way of processing big
+        amounts of output.
+
+        Note that ::wxExecute() only returns after receiving the last line of
+        the output, i.e. after the end of the output stream is reached, which
+        may happen later than the child process termination if it launched
+        other processes inheriting its output.
+
+        For the asynchronous execution this function is the same as
+        Redirect().
+
+        @since 3.3.2
+    */
+    void RedirectLines();
+
     /**
         Sets the priority of the process, between 0 (lowest) and 100 (highest).
         It can only be set before the process is created.
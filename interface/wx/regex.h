@@ -374,6 +374,22 @@ public:
      */
     static wxString ConvertFromBasic(const wxString& bre);
 
+    /**
+        Set the number of recently compiled expressions to keep.
+
+        Compile() reuses the result of compiling the same expression with the
+        same flags before, as long as it is still in the cache shared by all
+        wxRegEx objects in all threads, instead of compiling it again. By
+        default, up to 64 most recently used expressions are kept.
+
+        @param size The maximal number of expressions in the cache, 0 disables
+            caching and frees all the currently cached expressions not used by
+            any wxRegEx object.
+
+        @since 3.3.2
+     */
+    static void SetCacheSize(size_t size);
+
     /**
         Return the version of PCRE used.
 
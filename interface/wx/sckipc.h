@@ -157,6 +157,17 @@ public:
 
     A wxTCPConnection object can be created by making a connection using a
     wxTCPClient object, or by the acceptance of a connection by a wxTCPServer object.
+
+    When both sides of the connection use wxWidgets 3.3.2 or later, a more
+    efficient version of the protocol is used automatically: in particular,
+    under Linux, if the client and the server run on the same machine and as
+    the same user, the data blocks of at least 1KiB are passed through a
+    shared memory segment instead of being copied through the socket, unless
+    @c ipc.no-shared-memory system option is set on either side (see
+    wxSystemOptions). The data passed to OnExecute(), OnPoke() and OnAdvise()
+    may then point directly to this shared memory and so must not be used
+    after these functions return. The data can also be compressed, see
+    Compress().
     The bulk of a conversation is controlled by calling members in a
     @b wxTCPConnection object or by overriding its members.
 
@@ -222,6 +233,25 @@ public:
     */
     virtual bool Disconnect();
 
+    /**
+        Enable or disable compressing the data sent over this connection.
+
+        If compression is enabled, the data blocks passed to Execute(),
+        Poke(), Advise() or returned from OnRequest() are compressed using
+        zlib before being sent, if this makes them smaller. This can be
+        useful for the connections over slow networks, but is usually
+        counterproductive for the local ones, so compression is disabled by
+        default.
+
+        Compression is only used if the other side of the connection
+        supports it, which requires it to use wxWidgets 3.3.2 or later built
+        with @c wxUSE_ZLIB, but it doesn't need to enable it itself.
+        The data passed via shared memory is never compressed.
+
+        @since 3.3.2
+    */
+    void Compress(bool on);
+
     ///@{
     /**
         Called by the client application to execute a command on the server.
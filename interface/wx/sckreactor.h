@@ -0,0 +1,181 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        sckreactor.h
+// Purpose:     interface of wxSocketReactor and wxSocketReactorHandler
+// Author:      wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+    @class wxSocketReactorHandler
+
+    Base class for the objects handling the connections accepted by
+    wxSocketReactor.
+
+    All functions of this class are called from one of the reactor threads,
+    and not from the main one, so they must not use any GUI functions and
+    must protect any data shared with the other threads. However all calls
+    for the same connection are always done from the same thread, so no
+    locking is needed for accessing the state associated with the socket,
+    e.g. using wxSocketBase::SetClientData().
+
+    The socket passed to these functions is in non-blocking mode and the
+    functions should not block for a long time as this would delay handling
+    all the other connections served by the same thread.
+
+    @library{wxnet}
+    @category{net}
+
+    @since 3.3.2
+*/
+class wxSocketReactorHandler
+{
+public:
+    /**
+        Called when a new connection is accepted.
+
+        The socket remains valid until OnLost() is called for it.
+
+        The default implementation does nothing.
+    */
+    virtual void OnConnection(wxSocketBase& socket);
+
+    /**
+        Called when there is data available for reading from the socket.
+
+        This function must read the data using wxSocketBase::Read() or
+        wxSocketBase::ReadV(), as it won't be called again for this socket
+        until this is done. It can also write to the socket or close it by
+        calling wxSocketBase::Close().
+    */
+    virtual void OnInput(wxSocketBase& socket) = 0;
+
+    /**
+        Called when the connection is closed.
+
+        This happens when the connection is closed by the peer, when Close()
+        is called on the socket by the handler itself and when the reactor is
+        stopped. The socket is deleted by the reactor after this function
+        returns and must not be used any more.
+
+        The default implementation does nothing.
+    */
+    virtual void OnLost(wxSocketBase& socket);
+
+    /// Trivial but virtual destructor.
+    virtual ~wxSocketReactorHandler();
+};
+
+/**
+    @class wxSocketReactor
+
+    Server accepting TCP connections and handling them using a pool of
+    threads.
+
+    Each of the reactor threads runs its own event loop monitoring the
+    sockets assigned to it, so that the connections can be handled in
+    parallel without any contention between the threads. The accepted
+    connections are distributed among the threads in round robin order and
+    each of them is then handled by the same thread until it is closed, with
+    all the events for it being forwarded to wxSocketReactorHandler.
+
+    Here is a minimal example of an echo server:
+    @code
+        class EchoHandler : public wxSocketReactorHandler
+        {
+        public:
+            void OnInput(wxSocketBase& socket) override
+            {
+                char buf[4096];
+                socket.Read(buf, sizeof(buf));
+                socket.Write(buf, socket.LastReadCount());
+            }
+        };
+
+        EchoHandler handler;
+        wxSocketReactor reactor(handler);
+
+        wxIPV4address addr;
+        addr.Service(3000);
+        if ( !reactor.Start(addr) )
+            ... handle error ...
+    @endcode
+
+    This class is only available under Unix systems other than macOS, as
+    indicated by @c wxHAS_SOCKET_REACTOR being defined, and requires both
+    @c wxUSE_SOCKETS and @c wxUSE_THREADS to be set to 1.
+
+    @library{wxnet}
+    @category{net}
+
+    @since 3.3.2
+*/
+class wxSocketReactor
+{
+public:
+    /**
+        Create the reactor using the given handler.
+
+        The handler must remain valid until the reactor is stopped.
+
+        Note that the reactor doesn't do anything until Start() is called.
+    */
+    explicit wxSocketReactor(wxSocketReactorHandler& handler);
+
+    /**
+        Destructor stops the reactor if it's still running.
+    */
+    ~wxSocketReactor();
+
+    /**
+        Start listening for the connections and handling them.
+
+        This function must be called from the main thread.
+
+        @param addr The address to listen on. If its port is 0, a free port
+            is chosen by the system and can be retrieved using GetLocal().
+        @param numThreads The number of threads to use, if 0, which is the
+            default, one thread per CPU is used.
+        @return @true if the reactor was started or @false if listening on
+            the given address or creating the threads failed.
+    */
+    bool Start(const wxSockAddress& addr, unsigned numThreads = 0);
+
+    /**
+        Stop the reactor.
+
+        This function closes all the connections, calling
+        wxSocketReactorHandler::OnLost() for each of them, waits until all
+        the reactor threads terminate and closes the listening socket.
+
+        It does nothing if the reactor is not running.
+    */
+    void Stop();
+
+    /**
+        Return @true if the reactor was successfully started and not stopped
+        yet.
+    */
+    bool IsRunning() const;
+
+    /**
+        Return the number of threads used by the reactor.
+
+        Returns 0 if the reactor is not running.
+    */
+    unsigned GetThreadCount() const;
+
+    /**
+        Get the address the reactor listens on.
+
+        Returns @false if the reactor is not running.
+    */
+    bool GetLocal(wxSockAddress& addr) const;
+
+    /**
+        Return the number of currently open connections.
+
+        This function can be called from any thread, but the returned value
+        may be already out of date when it returns.
+    */
+    size_t GetConnectionCount() const;
+};
@@ -702,7 +702,32 @@ enum
     wxSOCKET_NOWAIT_READ = 64,    ///< Read as much data as possible and return immediately
     wxSOCKET_WAITALL_READ = 128,  ///< Wait for all required data to be read unless an error occurs.
     wxSOCKET_NOWAIT_WRITE = 256,   ///< Write as much data as possible and return immediately
-    wxSOCKET_WAITALL_WRITE = 512   ///< Wait for all required data to be written unless an error occurs.
+    wxSOCKET_WAITALL_WRITE = 512,  ///< Wait for all required data to be written unless an error occurs.
+    wxSOCKET_ZEROCOPY = 1024       ///< Avoid copying big buffers when writing if possible (since 3.3.2).
+};
+
+
+/**
+    Buffer descriptor used with wxSocketBase::ReadV() and WriteV().
+
+    @since 3.3.2
+*/
+struct wxSocketIOVec
+{
+    /// Default constructor creates an empty buffer.
+    wxSocketIOVec();
+
+    /// Constructor for a buffer to read into.
+    wxSocketIOVec(void* data, wxUint32 size);
+
+    /// Constructor for a buffer to write from.
+    wxSocketIOVec(const void* data, wxUint32 size);
+
+    /// Pointer to the buffer data.
+    void* data;
+
+    /// Size of the buffer in bytes.
+    wxUint32 size;
 };
 
 
@@ -1131,6 +1156,23 @@ public:
         @flag{wxSOCKET_NOBIND}
             Stops the socket from being bound to a specific adapter (normally
             used in conjunction with @b wxSOCKET_BROADCAST).
+        @flag{wxSOCKET_ZEROCOPY}
+            Let the kernel send big buffers written to a stream socket directly
+            from the application memory instead of copying them. As the buffer
+            can be reused as soon as Write() returns, it waits until the peer
+            acknowledges receiving the data, so this flag is only useful for
+            sockets used to send big amounts of data from worker threads. The
+            wait is limited by the socket timeout (see SetTimeout()) and if the
+            data is still not acknowledged when it expires, Write() or WriteV()
+            stop with wxSOCKET_TIMEDOUT error. In this case LastWriteCount()
+            still includes the data which was already passed to the kernel, as
+            it will be sent anyhow and must not be written again, and the
+            subsequent calls copy the data as usual. Notice that the kernel may
+            still use the memory containing this data, so modifying it could
+            change the data received by the peer. This flag is ignored when
+            wxSOCKET_NOWAIT_WRITE is used. It is currently only supported under
+            Linux and is ignored elsewhere (this flag is new since wxWidgets
+            3.3.2).
         @endFlagTable
 
         For more information on socket events see @ref wxSocketFlags .
@@ -1337,6 +1379,86 @@ public:
     */
     wxSocketBase& WriteMsg(const void* buffer, wxUint32 nbytes);
 
+    /**
+        Read data into several buffers at once.
+
+        This function behaves as Read() called for all the buffers in turn,
+        i.e. it fills the first buffer before storing the data in the second
+        one and so on, but uses as few system calls as possible.
+
+        Use LastReadCount() to verify the total number of bytes actually read.
+
+        @param vecs
+            Array of buffers to read the data into, empty buffers are ignored.
+        @param count
+            Number of elements in @a vecs.
+
+        @return Returns a reference to the current object.
+
+        @since 3.3.2
+
+        @see Read(), WriteV()
+    */
+    wxSocketBase& ReadV(const wxSocketIOVec* vecs, size_t count);
+
+    /**
+        Write data from several buffers at once.
+
+        This function behaves as Write() called for all the buffers in turn,
+        but sends them using as few system calls as possible, which is more
+        efficient than copying all the data into a single buffer or calling
+        Write() several times. For datagram sockets, all the buffers are sent
+        in a single datagram.
+
+        Use LastWriteCount() to verify the total number of bytes actually
+        written.
+
+        @param vecs
+            Array of buffers with the data to be sent, empty buffers are
+            ignored.
+        @param count
+            Number of elements in @a vecs.
+
+        @return Returns a reference to the current object.
+
+        @since 3.3.2
+
+        @see Write(), ReadV()
+    */
+    wxSocketBase& WriteV(const wxSocketIOVec* vecs, size_t count);
+
+    /**
+        Send data from the file to the socket.
+
+        If possible, i.e. under Linux and if the socket is a stream socket, the
+        data is sent directly by the kernel, without reading it into a buffer
+        first. Otherwise it is read from the file and written to the socket in
+        the usual way. In either case, this function behaves as Write() with
+        respect to the socket flags.
+
+        Use LastWriteCount() to verify the number of bytes actually sent.
+        Notice that reaching the end of the file before sending @a nbytes
+        bytes is considered to be an error if @c wxSOCKET_WAITALL_WRITE is
+        used or if nothing at all was sent.
+
+        @param file
+            The file to read the data from, it must be opened for reading.
+        @param offset
+            The position in the file to start sending the data from, in which
+            case the current file position is not changed, or ::wxInvalidOffset
+            to use the current position, which is then advanced past the sent
+            data.
+        @param nbytes
+            Number of bytes to send.
+
+        @return Returns a reference to the current object.
+
+        @since 3.3.2
+
+        @see Write()
+    */
+    wxSocketBase& SendFile(wxFile& file, wxFileOffset offset, wxUint32 nbytes);
+
     ///@}
 
 
@@ -47,6 +47,19 @@
         This flag should be set very early during program startup, within
         the constructor of the wxApp derivative. This option has been added in
         wxWidgets 3.3.0.
+    @flag{linux.io-uring}
+        If set to 1, io_uring is used instead of epoll for monitoring the file
+        descriptors, e.g. sockets and pipes, in the console applications under
+        Linux. This requires Linux 5.13 or later and epoll is still used if
+        io_uring is not available. Default: 0. This option must be set before
+        the first use of the sockets or wxExecute() and has been added in
+        wxWidgets 3.3.2.
+    @flag{ipc.no-shared-memory}
+        If set to 1, the shared memory is never used for passing the data
+        between wxTCPClient and wxTCPServer running on the same machine and
+        the data is always sent through the socket instead. This option is
+        checked when the connection is established and has been added in
+        wxWidgets 3.3.2.
     @endFlagTable
 
     @section sysopt_win Windows
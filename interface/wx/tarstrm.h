@@ -41,6 +41,10 @@ enum wxTarFormat
     When there are no more entries, wxTarInputStream::GetNextEntry() returns @NULL
     and sets wxTarInputStream::Eof().
 
+    Sparse entries created by GNU tar, using either the old GNU format or one
+    of the pax formats, are supported and are transparently expanded, i.e.
+    reading them returns zeros for the holes in the file.
+
     Tar entries are seekable if the parent stream is seekable. In practice this
     usually means they are only seekable if the tar is stored as a local file and
     is not compressed.
@@ -76,6 +80,21 @@ public:
     */
     bool CloseEntry();
 
+    /**
+        Copies all the remaining data of the current entry to the given
+        output @a stream.
+
+        This is equivalent to reading the entry data and writing it to
+        @a stream, but uses large blocks, which is significantly faster than
+        the generic wxOutputStream::Write() overload taking wxInputStream.
+        Holes in sparse entries are written out as zeros.
+
+        Returns @true if all the data was copied successfully.
+
+        @since 3.3.2
+    */
+    bool CopyEntryData(wxOutputStream& stream);
+
     /**
         Closes the current entry if one is open, then reads the meta-data for
         the next entry and returns it in a wxTarEntry object, giving away ownership.
@@ -364,6 +383,16 @@ public:
     wxFileOffset GetSize() const;
     ///@}
 
+    /**
+        Returns @true if this entry was read from a GNU sparse file entry.
+
+        For sparse entries GetSize() returns the size of the expanded file,
+        which can be much bigger than the amount of data stored in the tar.
+
+        @since 3.3.2
+    */
+    bool IsSparse() const;
+
     ///@{
     /**
         Returns/Sets the type of the entry as a ::wxTarType value.
@@ -36,6 +36,10 @@ enum wxTextFileType
     limitation for small files like configuration files or program sources
     which are well handled by wxTextFile.
 
+    If you only need to read a big file, use OpenMapped() instead of Open():
+    it maps the file in memory and only finds the line boundaries when opening
+    it, while the lines themselves are decoded only when they are accessed.
+
     The typical things you may do with wxTextFile in order are:
 
     - Create and open it: this is done with either wxTextFile::Create or wxTextFile::Open
@@ -192,6 +196,11 @@ public:
         The returned line may be modified when non-const method is used but you
         shouldn't add line terminator at the end -- this will be done by
         wxTextFile itself.
+
+        If IsLazy() returns @true, the returned reference remains valid only
+        until a few other lines are accessed, so the line must be copied if it
+        needs to be kept for longer, and modifying it doesn't change the file
+        contents.
     */
     ///@{
     wxString& GetLine(size_t n);
@@ -244,6 +253,25 @@ public:
     void InsertLine(const wxString& str, size_t n,
                     wxTextFileType type = typeDefault);
 
+    /**
+        Returns @true if the lines of the file are decoded only when accessed.
+
+        This is the case after a successful call to OpenMapped() until the
+        buffer is modified or closed.
+
+        @since 3.3.2
+    */
+    bool IsLazy() const;
+
+    /**
+        Returns @true if the file contents is currently mapped in memory.
+
+        @see OpenMapped()
+
+        @since 3.3.2
+    */
+    bool IsMapped() const;
+
     /**
         Returns @true if the file is currently opened.
     */
@@ -270,6 +298,37 @@ public:
     */
     bool Open(const wxString& strFile, const wxMBConv& conv = wxConvAuto());
 
+    /**
+        Opens the file with the given name for reading without loading it in
+        memory.
+
+        This function maps the file in memory and only determines where its
+        lines start when it is called, while decoding each line only when it is
+        accessed, which is much faster and uses much less memory than Open()
+        for big files. The file must not be modified by other programs while it
+        is mapped.
+
+        Note that the strings returned by GetLine() and the other functions
+        returning lines are only valid until a few other lines are accessed in
+        this mode, see IsLazy(). Calling any function modifying the file
+        contents, such as AddLine(), RemoveLine() or Write(), loads all the
+        lines in memory, as Open() would have done.
+
+        The file is loaded normally, as with Open(), if it can't be mapped in
+        memory, e.g. because it's a special file, or if its encoding is not
+        compatible with ASCII, e.g. UTF-16, and also always if wxWidgets was
+        built without RTTI support (i.e. with @c wxNO_RTTI defined), as it's
+        needed to handle wxConvAuto specially. When using wxConvAuto, the entire
+        file is still checked for validity when opening it, but with the other
+        conversions the lines that can't be decoded are simply returned as
+        empty strings.
+
+        @see IsMapped()
+
+        @since 3.3.2
+    */
+    bool OpenMapped(const wxString& strFile, const wxMBConv& conv = wxConvAuto());
+
     /**
         Delete line number @a n from the file.
     */
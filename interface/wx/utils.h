@@ -1335,6 +1335,10 @@ long wxExecute(const wchar_t* const* argv, int flags = wxEXEC_ASYNC,
     contents of @a flags is or'd with @c wxEXEC_SYNC) and capture its output in
     the array @e output.
 
+    If the output doesn't need to be stored but just processed, it is more
+    efficient to use a wxProcess overriding wxProcess::OnOutputLine() and
+    calling wxProcess::RedirectLines() instead.
+
     @param command
         The command to execute and any parameters to pass to it as a single
         string.
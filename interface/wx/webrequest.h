@@ -224,7 +224,34 @@ public:
             wxWebRequestEvent::GetDataSize() methods from wxEVT_WEBREQUEST_DATA
             handler.
         */
-        Storage_None
+        Storage_None,
+
+        /**
+            The data is made available as a stream as soon as it is received.
+
+            The stream returned by wxWebResponse::GetStream() can be read
+            while the request is still in progress, typically from a worker
+            thread, as reading from it blocks until more data is received.
+            Only a limited amount of data is buffered, so the entire response
+            is never kept in memory nor written to disk and, when using the
+            CURL backend, the transfer is paused if the application doesn't
+            read the data quickly enough and resumed when it does.
+
+            Reading from the stream results in ::wxSTREAM_EOF error once all
+            the data has been read and the request has completed successfully
+            or ::wxSTREAM_READ_ERROR if it failed or was cancelled.
+
+            The stream is owned by the response, so the thread reading from
+            it must keep a copy of the wxWebResponse object for as long as it
+            uses the stream: it becomes invalid as soon as the last copy of
+            the response is destroyed, which may happen in the main thread
+            when the request completes if no other copies exist.
+
+            See SetStorage() for an example of using this storage method.
+
+            @since 3.3.2
+        */
+        Storage_Stream
     };
 
     /**
@@ -419,6 +446,31 @@ public:
         With this storage method the data is only available during the
         @c wxEVT_WEBREQUEST_DATA event calls as soon as it's received from the
         server.
+
+        Finally, @c Storage_Stream allows to process the data in a worker
+        thread, without blocking the main one and without storing all of it.
+        The stream can be retrieved as soon as the request is started and
+        must only be read by a single thread, which has to keep a copy of the
+        wxWebResponse object to ensure that the stream remains valid:
+        @code
+        request.SetStorage(wxWebRequest::Storage_Stream);
+        request.Start();
+
+        wxWebResponse response = request.GetResponse();
+        std::thread([response]() {
+            wxInputStream& stream = *response.GetStream();
+            char buf[65536];
+            while ( stream.Read(buf, sizeof(buf)).LastRead() )
+                ... process the data ...
+
+            if ( stream.GetLastError() != wxSTREAM_EOF )
+                ... the request failed or was cancelled ...
+        }).detach();
+        @endcode
+
+        Note that if the request requires authentication, reading from the
+        stream blocks until the credentials are provided or the request is
+        cancelled.
     */
     void SetStorage(Storage storage);
 
@@ -680,7 +732,20 @@ public:
             data is simply lost when it is used, however it is still supported
             just in case the received data is really not needed.
         */
-        Storage_None
+        Storage_None,
+
+        /**
+            The data is made available as a stream.
+
+            As there is no way to read the data while a synchronous request
+            is being executed, this storage method is equivalent to
+            @c Storage_Memory for the synchronous requests, except that
+            wxWebResponse::AsString() can't be used with it and the data can
+            only be read once from wxWebResponse::GetStream().
+
+            @since 3.3.2
+        */
+        Storage_Stream
     };
 
     /**
@@ -1086,6 +1151,12 @@ public:
 
     /**
         Returns a stream which represents the response data sent by the server.
+
+        The returned pointer is owned by the response and remains valid only
+        as long as this wxWebResponse object or any of its copies exist. In
+        particular, when using wxWebRequest::Storage_Stream, the worker thread
+        reading from the stream must keep its own copy of the response object
+        until it stops using the stream.
     */
     wxInputStream* GetStream();
 
@@ -1172,6 +1243,154 @@ public:
     static wxWebProxy Default();
 };
 
+/**
+    @class wxWebConnectionOptions
+
+    Options controlling the network connections used by the session.
+
+    An object of this type can be passed to wxWebSession::SetConnectionOptions()
+    or wxWebSessionSync::SetConnectionOptions() to tune how the connections are
+    reused, which can significantly improve performance of the applications
+    making many requests to the same server.
+
+    All setters return the object itself, allowing to chain them:
+    @code
+    auto& session = wxWebSession::GetDefault();
+    session.SetConnectionOptions(wxWebConnectionOptions()
+                                    .SetMaxConnectionsPerHost(4)
+                                    .SetWaitForMultiplexing());
+    @endcode
+
+    @note Connection options are currently only supported by the CURL
+        backend.
+
+    @since 3.3.2
+
+    @library{wxnet}
+    @category{net}
+
+    @see wxWebConnectionStats
+ */
+class wxWebConnectionOptions
+{
+public:
+    /**
+        Default constructor uses the default options.
+
+        By default, the number of connections is not limited, multiplexing is
+        enabled and the resolved host names are cached for 60 seconds.
+     */
+    wxWebConnectionOptions();
+
+    /**
+        Limit the number of simultaneous connections to the same host.
+
+        If more requests to the same host are started, they are queued until
+        one of the existing connections becomes free.
+
+        @param n Maximal number of connections or 0 for no limit.
+     */
+    wxWebConnectionOptions& SetMaxConnectionsPerHost(unsigned n);
+
+    /// Returns the value set by SetMaxConnectionsPerHost().
+    unsigned GetMaxConnectionsPerHost() const;
+
+    /**
+        Limit the total number of the connections.
+
+        This limits both the number of simultaneously active connections and
+        the number of idle connections kept open for reuse by the subsequent
+        requests.
+
+        @param n Maximal number of connections or 0 for the backend default.
+     */
+    wxWebConnectionOptions& SetMaxConnections(unsigned n);
+
+    /// Returns the value set by SetMaxConnections().
+    unsigned GetMaxConnections() const;
+
+    /**
+        Enable or disable use of HTTP/2 multiplexing.
+
+        When multiplexing is enabled, which is the default, HTTP/2 is used for
+        HTTPS connections if the server supports it and several requests to
+        the same host can be performed simultaneously over the same
+        connection. Disabling it forces use of HTTP/1.1.
+     */
+    wxWebConnectionOptions& EnableMultiplexing(bool enable = true);
+
+    /// Returns @true if multiplexing is enabled.
+    bool IsMultiplexingEnabled() const;
+
+    /**
+        Prefer waiting for an existing connection to opening a new one.
+
+        If this option is set, the requests to a host with a connection still
+        being established wait for it to check if it supports multiplexing
+        instead of opening new connections immediately. This results in using
+        fewer connections when many requests are started at once, but may
+        delay them if the server turns out to not support HTTP/2.
+
+        This option doesn't have any effect if multiplexing is disabled.
+     */
+    wxWebConnectionOptions& SetWaitForMultiplexing(bool wait = true);
+
+    /// Returns @true if SetWaitForMultiplexing() was called.
+    bool ShouldWaitForMultiplexing() const;
+
+    /**
+        Set the time during which the resolved host names are cached.
+
+        @param seconds The time to keep the results of DNS lookups for,
+            0 to disable caching them or -1 to keep them forever.
+     */
+    wxWebConnectionOptions& SetDNSCacheTimeout(int seconds);
+
+    /// Returns the value set by SetDNSCacheTimeout().
+    int GetDNSCacheTimeout() const;
+};
+
+/**
+    @class wxWebConnectionStats
+
+    Statistics about the connections used by the session.
+
+    Objects of this class are returned by wxWebSession::GetConnectionStats()
+    and wxWebSessionSync::GetConnectionStats() and can be used to check how
+    efficiently the connections are reused.
+
+    @since 3.3.2
+
+    @library{wxnet}
+    @category{net}
+
+    @see wxWebConnectionOptions
+ */
+class wxWebConnectionStats
+{
+public:
+    /**
+        Returns the number of requests which got a response from the server.
+
+        Only such requests are taken into account by the other functions.
+     */
+    wxUint64 GetRequestCount() const;
+
+    /// Returns the number of connections opened by the requests.
+    wxUint64 GetNewConnectionCount() const;
+
+    /// Returns the number of requests which reused an existing connection.
+    wxUint64 GetReusedConnectionCount() const;
+
+    /**
+        Returns the number of requests using HTTP/2 or later.
+
+        Such requests could be multiplexed over the same connection with the
+        other requests to the same host.
+     */
+    wxUint64 GetMultiplexedRequestCount() const;
+};
+
 /**
     @class wxWebSession
 
@@ -1298,6 +1517,30 @@ public:
      */
     bool SetProxy(const wxWebProxy& proxy);
 
+    /**
+        Set the options for the connections used by this session.
+
+        This function can be called at any time, but the new options only
+        affect the requests created after calling it.
+
+        @return @true if the options were set or @false if they are not
+            supported by the backend used, which is currently the case for
+            all backends except CURL.
+
+        @since 3.3.2
+     */
+    bool SetConnectionOptions(const wxWebConnectionOptions& options);
+
+    /**
+        Returns the statistics about the connections used by this session.
+
+        The returned object is empty if the backend doesn't support collecting
+        them, see SetConnectionOptions().
+
+        @since 3.3.2
+     */
+    wxWebConnectionStats GetConnectionStats() const;
+
     /**
         Returns the default session
     */
@@ -1491,6 +1734,30 @@ public:
      */
     void SetProxy(const wxWebProxy& proxy);
 
+    /**
+        Set the options for the connections used by this session.
+
+        This function can be called at any time, but the new options only
+        affect the requests created after calling it.
+
+        @return @true if the options were set or @false if they are not
+            supported by the backend used, which is currently the case for
+            all backends except CURL.
+
+        @since 3.3.2
+     */
+    bool SetConnectionOptions(const wxWebConnectionOptions& options);
+
+    /**
+        Returns the statistics about the connections used by this session.
+
+        The returned object is empty if the backend doesn't support collecting
+        them, see SetConnectionOptions().
+
+        @since 3.3.2
+     */
+    wxWebConnectionStats GetConnectionStats() const;
+
     /**
         Returns the default session
     */
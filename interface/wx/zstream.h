@@ -19,7 +19,15 @@ enum wxZLibFlags {
     wxZLIB_NO_HEADER = 0,    //!< raw deflate stream, no header or checksum
     wxZLIB_ZLIB = 1,         //!< zlib header and checksum
     wxZLIB_GZIP = 2,         //!< gzip header and checksum, requires zlib 1.2.1+
-    wxZLIB_AUTO = 3          //!< autodetect header zlib or gzip
+    wxZLIB_AUTO = 3,         //!< autodetect header zlib or gzip
+
+    /**
+        gzip stream possibly consisting of several members, only for
+        wxZlibInputStream.
+
+        @since 3.3.2
+    */
+    wxZLIB_GZIP_MULTI = 4
 };
 
 
@@ -124,6 +132,14 @@ public:
         mode, which is not usually used directly. It can be used to read a raw
         deflate stream embedded in a higher level protocol.
 
+        Normally the stream ends after the end of the compressed data and
+        anything following it is left in the parent stream. If @a flags is
+        wxZLIB_GZIP_MULTI, then the input is a gzip stream which can consist
+        of several concatenated members, as created by e.g. @c bgzip or by
+        appending to a gzip file, and the decompressed data of all of them is
+        returned. Multiple members are decompressed in parallel using several
+        threads when possible, see SetThreadCount().
+
         The values of the ::wxZLibFlags enumeration can be used.
     */
     wxZlibInputStream(wxInputStream& stream, int flags = wxZLIB_AUTO);
@@ -147,5 +163,23 @@ public:
     bool SetDictionary(const char *data, size_t datalen);
     bool SetDictionary(const wxMemoryBuffer &buf);
     ///@}
+
+    /**
+        Sets the number of threads used for decompressing wxZLIB_GZIP_MULTI
+        streams.
+
+        By default, or if @a count is 0, as many threads as there are CPUs
+        are used. Using a single thread disables parallel decompression.
+
+        The data is always returned in order and in case of an error the
+        stream behaves exactly as when decompressing it using a single
+        thread. Notice that parallel decompression reads ahead a few
+        megabytes of the input for each thread.
+
+        This function must be called before reading from the stream.
+
+        @since 3.3.2
+    */
+    void SetThreadCount(unsigned count);
 };
 
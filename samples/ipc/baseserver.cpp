@@ -360,6 +360,18 @@ bool BenchConnection::OnPoke(const wxString& topic,
     if ( !IsSupportedTopicAndItem("OnPoke", topic, item) )
         return false;
 
+    // binary data is just sent back unchanged, this is used by the bulk data
+    // transfer benchmark
+    if ( format == wxIPC_PRIVATE )
+    {
+        if ( m_advise && !Advise(item, data, size, format) )
+        {
+            wxLogMessage("Failed to advise client about the change.");
+        }
+
+        return true;
+    }
+
     if ( !IsTextFormat(format) )
     {
         wxLogMessage("Unexpected format %d in OnPoke().", format);
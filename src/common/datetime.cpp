@@ -85,6 +85,10 @@
 #include "wx/datetime.h"
 #include "wx/uilocale.h"
 
+#ifdef __UNIX__
+    #include "wx/unix/private/tzinfo.h"
+#endif
+
 // ----------------------------------------------------------------------------
 // wxXTI
 // ----------------------------------------------------------------------------
@@ -340,6 +344,42 @@ void wxInitTm(struct tm& tm)
     tm.tm_isdst = -1; // auto determine
 }
 
+// Thread-safe replacements for localtime_r() and mktime() using the time zone
+// data cached by wxTimeZoneInfo if possible: this is much faster than using
+// the CRT functions which lock the global time zone state and may even check
+// whether the time zone file changed every time they're called.
+static struct tm *wxLocalTimeFromTicks(time_t t, struct tm *tm)
+{
+#ifdef wxHAS_TIMEZONEINFO
+    if ( const wxTimeZoneInfo* const info = wxTimeZoneInfo::GetLocal() )
+    {
+        info->ToLocal(t, *tm);
+        return tm;
+    }
+#endif // wxHAS_TIMEZONEINFO
+
+    return wxLocaltime_r(&t, tm);
+}
+
+static time_t wxTicksFromLocalTime(struct tm *tm)
+{
+#ifdef wxHAS_TIMEZONEINFO
+    if ( const wxTimeZoneInfo* const info = wxTimeZoneInfo::GetLocal() )
+    {
+        struct tm tmCopy(*tm);
+        const wxInt64 t = info->FromLocal(tmCopy);
+        if ( static_cast<time_t>(t) == t )
+        {
+            *tm = tmCopy;
+            return static_cast<time_t>(t);
+        }
+        //else: let mktime() handle it
+    }
+#endif // wxHAS_TIMEZONEINFO
+
+    return mktime(tm);
+}
+
 // Internal helper function called only for times outside of standard time_t
 // range.
 //
@@ -542,8 +582,7 @@ long wxDateTime::TimeZone::GetOffset() const
 /* static */
 struct tm *wxDateTime::GetTmNow(struct tm *tmstruct)
 {
-    time_t t = GetTimeNow();
-    return wxLocaltime_r(&t, tmstruct);
+    return wxLocalTimeFromTicks(GetTimeNow(), tmstruct);
 }
 
 /* static */
@@ -869,7 +908,7 @@ wxDateTime::Country wxDateTime::GetCountry()
         // try to guess from the time zone name
         time_t t = time(nullptr);
         struct tm tmstruct;
-        struct tm *tm = wxLocaltime_r(&t, &tmstruct);
+        struct tm *tm = wxLocalTimeFromTicks(t, &tmstruct);
 
         wxString tz = wxCallStrftime(wxS("%Z"), tm);
         ms_country = USA;
@@ -1157,7 +1196,7 @@ wxDateTime wxDateTime::GetEndDST(int year, Country country)
 wxDateTime& wxDateTime::Set(const struct tm& tm)
 {
     struct tm tm2(tm);
-    time_t timet = mktime(&tm2);
+    time_t timet = wxTicksFromLocalTime(&tm2);
 
     if ( timet == (time_t)-1 )
     {
@@ -1205,7 +1244,7 @@ wxDateTime& wxDateTime::Set(const struct tm& tm)
             tm2.tm_mday++;
         }
 
-        timet = mktime(&tm2);
+        timet = wxTicksFromLocalTime(&tm2);
     }
 
     return Set(timet);
@@ -1240,7 +1279,7 @@ wxDateTime& wxDateTime::Set(wxDateTime_t hour,
 
     // and the DST in case it changes on this date
     struct tm tm2(tm1);
-    mktime(&tm2);
+    wxTicksFromLocalTime(&tm2);
     if ( tm2.tm_isdst != tm1.tm_isdst )
         tm1.tm_isdst = tm2.tm_isdst;
 
@@ -1409,7 +1448,7 @@ wxDateTime& wxDateTime::SetFromDOS(unsigned long ddt)
     long second = ddt & 0x1F;
     tm.tm_sec = second * 2;
 
-    return Set(mktime(&tm));
+    return Set(wxTicksFromLocalTime(&tm));
 }
 
 unsigned long wxDateTime::GetAsDOS() const
@@ -1417,7 +1456,7 @@ unsigned long wxDateTime::GetAsDOS() const
     unsigned long ddt;
     time_t ticks = GetTicks();
     struct tm tmstruct;
-    struct tm *tm = wxLocaltime_r(&ticks, &tmstruct);
+    struct tm *tm = wxLocalTimeFromTicks(ticks, &tmstruct);
     wxCHECK_MSG( tm, ULONG_MAX, wxT("time can't be represented in DOS format") );
 
     long year = tm->tm_year;
@@ -1453,7 +1492,7 @@ const tm* wxTryGetTm(tm& tmstruct, time_t t, const wxDateTime::TimeZone& tz)
     if ( tz.IsLocal() )
     {
         // we are working with local time
-        return wxLocaltime_r(&t, &tmstruct);
+        return wxLocalTimeFromTicks(t, &tmstruct);
     }
     else
     {
@@ -1462,14 +1501,83 @@ const tm* wxTryGetTm(tm& tmstruct, time_t t, const wxDateTime::TimeZone& tz)
         if ( t < 0 )
             return nullptr;
 #endif
+#ifdef wxHAS_TIMEZONEINFO
+        wxTimeZoneInfo::BreakDown(t, 0, tmstruct);
+        return &tmstruct;
+#else
         return wxGmtime_r(&t, &tmstruct);
+#endif
     }
 }
 
+namespace
+{
+
+// GetTm() is often called several times in a row for the same date, e.g. by
+// GetYear(), GetMonth() and GetDay(), so remember its last result.
+class TmCache
+{
+public:
+    bool Get(wxLongLong time, const wxDateTime::TimeZone& tz,
+             wxDateTime::Tm& tm) const
+    {
+        if ( !m_valid || time != m_time || GetKey(tz) != m_tz )
+            return false;
+
+#ifdef wxHAS_TIMEZONEINFO
+        // The local time zone could have changed since the last call.
+        if ( tz.IsLocal() && wxTimeZoneInfo::GetLocal() != m_zone )
+            return false;
+#endif // wxHAS_TIMEZONEINFO
+
+        tm = m_tm;
+        return true;
+    }
+
+    const wxDateTime::Tm&
+    Store(wxLongLong time, const wxDateTime::TimeZone& tz,
+          const wxDateTime::Tm& tm)
+    {
+        m_valid = true;
+        m_time = time;
+        m_tz = GetKey(tz);
+#ifdef wxHAS_TIMEZONEINFO
+        m_zone = tz.IsLocal() ? wxTimeZoneInfo::GetLocal() : nullptr;
+#endif // wxHAS_TIMEZONEINFO
+        m_tm = tm;
+
+        return m_tm;
+    }
+
+private:
+    static long GetKey(const wxDateTime::TimeZone& tz)
+    {
+        return tz.IsLocal() ? LONG_MIN : tz.GetOffset();
+    }
+
+    bool m_valid = false;
+    wxLongLong m_time;
+    long m_tz = 0;
+#ifdef wxHAS_TIMEZONEINFO
+    const wxTimeZoneInfo* m_zone = nullptr;
+#endif // wxHAS_TIMEZONEINFO
+    wxDateTime::Tm m_tm;
+};
+
+thread_local TmCache gs_tmCache;
+
+} // anonymous namespace
+
 wxDateTime::Tm wxDateTime::GetTm(const TimeZone& tz) const
 {
     wxASSERT_MSG( IsValid(), wxT("invalid wxDateTime") );
 
+    TmCache& cache = gs_tmCache;
+
+    Tm tmCached;
+    if ( cache.Get(m_time, tz, tmCached) )
+        return tmCached;
+
     time_t time = GetTicks();
     if ( time != (time_t)-1 )
     {
@@ -1481,7 +1589,7 @@ wxDateTime::Tm wxDateTime::GetTm(const TimeZone& tz) const
             Tm tm2(*tm, tz);
             long timeOnly = (m_time % MILLISECONDS_PER_DAY).ToLong();
             tm2.msec = (wxDateTime_t)(timeOnly % 1000);
-            return tm2;
+            return cache.Store(m_time, tz, tm2);
         }
         //else: use generic code below
     }
@@ -1573,7 +1681,7 @@ wxDateTime::Tm wxDateTime::GetTm(const TimeZone& tz) const
 
     tm.hour = (wxDateTime_t)(timeOnly / MIN_PER_HOUR);
 
-    return tm;
+    return cache.Store(m_time, tz, tm);
 }
 
 wxDateTime& wxDateTime::SetYear(int year)
@@ -2092,7 +2200,7 @@ int wxDateTime::IsDST(wxDateTime::Country country) const
     if ( timet != (time_t)-1 )
     {
         struct tm tmstruct;
-        tm *tm = wxLocaltime_r(&timet, &tmstruct);
+        tm *tm = wxLocalTimeFromTicks(timet, &tmstruct);
 
         wxCHECK_MSG( tm, -1, wxT("wxLocaltime_r() failed") );
 
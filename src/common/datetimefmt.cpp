@@ -1414,7 +1414,7 @@ wxDateTime::ParseFormat(const wxString& date,
 
             case wxT('w'):       // weekday as a number (0-6), Sunday = 0
                 if ( !GetNumericToken(width, input, end, &num) ||
-                        (wday > 6) )
+                        (num > 6) )
                 {
                     // no match
                     return false;
@@ -2318,6 +2318,996 @@ bool wxDateTime::IsWorkDay(Country WXUNUSED(country)) const
     return !wxDateTimeHolidayAuthority::IsHoliday(*this);
 }
 
+// ============================================================================
+// wxDateTimeFormatter
+// ============================================================================
+
+namespace
+{
+
+// Same as GetNumericToken() but doesn't build a temporary string.
+bool ScanNumber(size_t len,
+                wxString::const_iterator& p,
+                const wxString::const_iterator& end,
+                unsigned long *number,
+                size_t *numScannedDigits = nullptr)
+{
+    unsigned long n = 0;
+    size_t count = 0;
+    bool ok = true;
+    while ( p != end && wxIsdigit(*p) )
+    {
+        const wxUniChar::value_type ch = (*p++).GetValue();
+        if ( ch < '0' || ch > '9' )
+        {
+            // non-ASCII digits are not accepted by ToULong() neither
+            ok = false;
+        }
+        else
+        {
+            const unsigned long digit = ch - '0';
+            if ( n > (ULONG_MAX - digit) / 10 )
+                ok = false;
+            else
+                n = n*10 + digit;
+        }
+
+        if ( ++count == len )
+            break;
+    }
+
+    if ( numScannedDigits )
+        *numScannedDigits = count;
+
+    if ( !count || !ok )
+        return false;
+
+    *number = n;
+    return true;
+}
+
+// Appends the number formatted as "%0Nd" with N == width would do it.
+void AppendNumber(wxString& str, int value, int width)
+{
+    char buf[16];
+    char* const end = buf + WXSIZEOF(buf);
+    char* p = end;
+
+    unsigned n = value < 0 ? 0u - static_cast<unsigned>(value)
+                           : static_cast<unsigned>(value);
+    do
+    {
+        *--p = static_cast<char>('0' + n % 10);
+        n /= 10;
+    }
+    while ( n );
+
+    if ( value < 0 )
+    {
+        str += '-';
+        width--;
+    }
+
+    for ( int len = static_cast<int>(end - p); len < width; len++ )
+        str += '0';
+
+    for ( ; p != end; ++p )
+        str += *p;
+}
+
+// The fields of the date being formatted.
+struct DateFields
+{
+    int year,
+        mon,
+        mday,
+        yday,   // 1-based, 0 if not computed yet
+        wday,
+        hour,
+        min,
+        sec,
+        msec;
+};
+
+} // anonymous namespace
+
+wxDateTimeFormatter::wxDateTimeFormatter(const wxString& format)
+    : m_format(format)
+{
+    CompileForFormatting();
+    CompileForParsing();
+}
+
+/* static */
+void
+wxDateTimeFormatter::AddLiteral(std::vector<Item>& items, wxString& text)
+{
+    if ( text.empty() )
+        return;
+
+    AddItem(items, Item_Literal, 0);
+    items.back().text.swap(text);
+}
+
+/* static */
+void
+wxDateTimeFormatter::AddItem(std::vector<Item>& items,
+                             ItemType type, wxChar spec, int width)
+{
+    Item item;
+    item.type = type;
+    item.spec = spec;
+    item.width = width;
+    if ( type == Item_Strftime )
+    {
+        item.text = '%';
+        item.text += spec;
+    }
+
+    items.push_back(item);
+}
+
+void wxDateTimeFormatter::CompileForFormatting()
+{
+    // Fall back to wxDateTime::Format() if we don't support this format.
+    m_formatMode = Format_Fallback;
+
+    wxString format = m_format;
+#ifdef __WXOSX__
+#if wxUSE_INTL
+    // This must be done in the same way as in wxDateTime::Format().
+    if ( format.Contains("%c") )
+        format.Replace("%c", wxUILocale::GetCurrent().GetInfo(wxLOCALE_DATE_TIME_FMT));
+    if ( format.Contains("%x") )
+        format.Replace("%x", wxUILocale::GetCurrent().GetInfo(wxLOCALE_SHORT_DATE_FMT));
+    if ( format.Contains("%X") )
+        format.Replace("%X", wxUILocale::GetCurrent().GetInfo(wxLOCALE_TIME_FMT));
+#endif // wxUSE_INTL
+#endif // __WXOSX__
+
+    if ( format.empty() )
+        return;
+
+    // We use the fields of struct tm filled by the CRT functions when
+    // wxDateTime::Format() would use strftime(), see the checks there.
+    bool useStrftime = false;
+#ifdef wxHAS_STRFTIME
+    useStrftime = true;
+    for ( wxString::const_iterator p = format.begin(); p != format.end(); ++p )
+    {
+        if ( *p != '%' )
+            continue;
+
+        if ( ++p == format.end() )
+            break;
+
+        switch ( (*p).GetValue() )
+        {
+            case 'l':
+#ifdef __MINGW32__
+            case 'F':
+            case 'g':
+            case 'G':
+            case 'V':
+            case 'z':
+#endif // __MINGW32__
+                useStrftime = false;
+                break;
+        }
+    }
+#endif // wxHAS_STRFTIME
+
+    std::vector<Item> items;
+    wxString literal;
+    for ( wxString::const_iterator p = format.begin(); p != format.end(); ++p )
+    {
+        if ( *p != '%' )
+        {
+            literal += *p;
+            continue;
+        }
+
+        // Let wxDateTime::Format() deal with the invalid formats.
+        if ( ++p == format.end() )
+            return;
+
+        const wxChar spec = static_cast<wxChar>((*p).GetValue());
+
+        int width = 2;
+        ItemType type = Item_Number;
+        switch ( spec )
+        {
+            case '%':
+                literal += '%';
+                continue;
+
+            case 'Y':
+                width = 4;
+                break;
+
+            case 'j':
+            case 'l':
+                width = 3;
+                break;
+
+            case 'w':
+                width = 1;
+                break;
+
+            case 'd':
+            case 'H':
+            case 'I':
+            case 'm':
+            case 'M':
+            case 'S':
+            case 'y':
+                break;
+
+            case 'F':
+                AddLiteral(items, literal);
+                AddItem(items, Item_Number, 'Y', 4);
+                literal = '-';
+                AddLiteral(items, literal);
+                AddItem(items, Item_Number, 'm', 2);
+                literal = '-';
+                AddLiteral(items, literal);
+                AddItem(items, Item_Number, 'd', 2);
+                continue;
+
+            case 'a':
+            case 'A':
+                type = useStrftime ? Item_Strftime : Item_WeekDayName;
+                break;
+
+            case 'b':
+            case 'B':
+                type = useStrftime ? Item_Strftime : Item_MonthName;
+                break;
+
+            default:
+                // All the other specifiers are left to strftime() if it's
+                // used or to wxDateTime::Format() otherwise, which also takes
+                // care of the width and modifiers which we don't support.
+                if ( !useStrftime ||
+                        !((spec >= 'a' && spec <= 'z') ||
+                          (spec >= 'A' && spec <= 'Z')) ||
+                            spec == 'E' || spec == 'O' )
+                    return;
+
+                type = Item_Strftime;
+        }
+
+        AddLiteral(items, literal);
+        AddItem(items, type, spec, width);
+    }
+
+    AddLiteral(items, literal);
+
+    m_formatItems.swap(items);
+    m_formatMode = useStrftime ? Format_Strftime : Format_Generic;
+}
+
+void wxDateTimeFormatter::CompileForParsing()
+{
+    // Use wxDateTime::ParseFormat() for the formats we don't support.
+    m_canParse = false;
+
+    if ( m_format.empty() )
+        return;
+
+    std::vector<Item> items;
+    wxString literal;
+    const wxString::const_iterator end = m_format.end();
+    for ( wxString::const_iterator p = m_format.begin(); p != end; ++p )
+    {
+        if ( *p != '%' )
+        {
+            if ( wxIsspace(*p) )
+            {
+                // Consecutive spaces are the same as a single one as each of
+                // them matches 0 or more spaces.
+                AddLiteral(items, literal);
+                if ( items.empty() || items.back().type != Item_Space )
+                    AddItem(items, Item_Space, 0);
+            }
+            else
+            {
+                literal += *p;
+            }
+
+            continue;
+        }
+
+        // This is done in the same way as in wxDateTime::ParseFormat().
+        if ( ++p == end )
+            return;
+
+        if ( *p == '-' || *p == '_' || *p == '0' )
+        {
+            if ( ++p == end )
+                return;
+        }
+
+        int width = 0;
+        while ( wxIsdigit(*p) )
+        {
+            width *= 10;
+            width += (*p).GetValue() - '0';
+
+            if ( ++p == end )
+                return;
+        }
+
+        const wxChar spec = static_cast<wxChar>((*p).GetValue());
+
+        if ( !width )
+        {
+            switch ( spec )
+            {
+                case 'Y':
+                    width = 4;
+                    break;
+
+                case 'j':
+                case 'l':
+                    width = 3;
+                    break;
+
+                case 'w':
+                    width = 1;
+                    break;
+
+                default:
+                    width = 2;
+            }
+        }
+
+        ItemType type = Item_Number;
+        switch ( spec )
+        {
+            case 'd':
+            case 'e':
+            case 'H':
+            case 'I':
+            case 'j':
+            case 'l':
+            case 'm':
+            case 'M':
+            case 'S':
+            case 'w':
+            case 'y':
+            case 'Y':
+                break;
+
+            case 'a':
+            case 'A':
+                type = Item_WeekDayName;
+                break;
+
+            case 'b':
+            case 'B':
+                type = Item_MonthName;
+                break;
+
+            case 'p':
+                type = Item_AmPm;
+                break;
+
+            case 'z':
+                type = Item_TimeZone;
+                break;
+
+            case 'Z':
+                type = Item_TimeZoneName;
+                break;
+
+            case '%':
+                literal += '%';
+                continue;
+
+            // The specifiers corresponding to fixed formats are expanded
+            // as this results in the same fields being parsed.
+            case 'F':
+                AddLiteral(items, literal);
+                AddItem(items, Item_Number, 'Y', 4);
+                literal = '-';
+                AddLiteral(items, literal);
+                AddItem(items, Item_Number, 'm', 2);
+                literal = '-';
+                AddLiteral(items, literal);
+                AddItem(items, Item_Number, 'd', 2);
+                continue;
+
+            case 'T':
+            case 'R':
+                AddLiteral(items, literal);
+                AddItem(items, Item_Number, 'H', 2);
+                literal = ':';
+                AddLiteral(items, literal);
+                AddItem(items, Item_Number, 'M', 2);
+                if ( spec == 'T' )
+                {
+                    literal = ':';
+                    AddLiteral(items, literal);
+                    AddItem(items, Item_Number, 'S', 2);
+                }
+                continue;
+
+            default:
+                // The locale-dependent formats are only handled by
+                // ParseFormat() itself.
+                return;
+        }
+
+        AddLiteral(items, literal);
+        AddItem(items, type, spec, width);
+    }
+
+    AddLiteral(items, literal);
+
+    m_parseItems.swap(items);
+    m_canParse = true;
+}
+
+void
+wxDateTimeFormatter::FormatTo(wxString& str,
+                              const wxDateTime& dt,
+                              const wxDateTime::TimeZone& tz) const
+{
+    DateFields fields = DateFields();
+
+#ifdef wxHAS_STRFTIME
+    struct tm tmstruct;
+    const tm* tm = nullptr;
+#endif // wxHAS_STRFTIME
+
+    switch ( m_formatMode )
+    {
+        case Format_Strftime:
+#ifdef wxHAS_STRFTIME
+            {
+                const time_t t = dt.GetTicks();
+                if ( t != (time_t)-1 )
+                    tm = wxTryGetTm(tmstruct, t, tz);
+            }
+
+            if ( tm )
+            {
+                fields.year = tm->tm_year + 1900;
+                fields.mon = tm->tm_mon;
+                fields.mday = tm->tm_mday;
+                fields.yday = tm->tm_yday + 1;
+                fields.wday = tm->tm_wday;
+                fields.hour = tm->tm_hour;
+                fields.min = tm->tm_min;
+                fields.sec = tm->tm_sec;
+                fields.msec = 0;
+                break;
+            }
+#endif // wxHAS_STRFTIME
+
+            // The date is out of the range supported by the CRT, so Format()
+            // will use its generic code for it.
+            wxFALLTHROUGH;
+
+        case Format_Fallback:
+            str += dt.Format(m_format, tz);
+            return;
+
+        case Format_Generic:
+            {
+                wxDateTime::Tm tmDT = dt.GetTm(tz);
+                fields.year = tmDT.year;
+                fields.mon = tmDT.mon;
+                fields.mday = tmDT.mday;
+                fields.yday = 0;
+                fields.wday = tmDT.GetWeekDay();
+                fields.hour = tmDT.hour;
+                fields.min = tmDT.min;
+                fields.sec = tmDT.sec;
+                fields.msec = tmDT.msec;
+            }
+            break;
+    }
+
+    for ( const Item& item : m_formatItems )
+    {
+        switch ( item.type )
+        {
+            case Item_Literal:
+                str += item.text;
+                break;
+
+            case Item_Number:
+                {
+                    int value = 0;
+                    switch ( item.spec )
+                    {
+                        case 'Y': value = fields.year; break;
+                        case 'y': value = fields.year % 100; break;
+                        case 'm': value = fields.mon + 1; break;
+                        case 'd': value = fields.mday; break;
+                        case 'H': value = fields.hour; break;
+                        case 'M': value = fields.min; break;
+                        case 'S': value = fields.sec; break;
+                        case 'l': value = fields.msec; break;
+                        case 'w': value = fields.wday; break;
+
+                        case 'I':
+                            // 24h -> 12h, 0h -> 12h too
+                            value = fields.hour > 12 ? fields.hour - 12
+                                                     : fields.hour ? fields.hour
+                                                                   : 12;
+                            break;
+
+                        case 'j':
+                            if ( !fields.yday )
+                                fields.yday = dt.GetDayOfYear(tz);
+                            value = fields.yday;
+                            break;
+                    }
+
+                    AppendNumber(str, value, item.width);
+                }
+                break;
+
+            case Item_Strftime:
+#ifdef wxHAS_STRFTIME
+                str += wxCallStrftime(item.text, tm);
+#endif // wxHAS_STRFTIME
+                break;
+
+            case Item_WeekDayName:
+                str += wxDateTime::GetWeekDayName
+                       (
+                        static_cast<wxDateTime::WeekDay>(fields.wday),
+                        item.spec == 'a' ? wxDateTime::Name_Abbr
+                                         : wxDateTime::Name_Full
+                       );
+                break;
+
+            case Item_MonthName:
+                str += wxDateTime::GetMonthName
+                       (
+                        static_cast<wxDateTime::Month>(fields.mon),
+                        item.spec == 'b' ? wxDateTime::Name_Abbr
+                                         : wxDateTime::Name_Full
+                       );
+                break;
+
+            case Item_Space:
+            case Item_AmPm:
+            case Item_TimeZone:
+            case Item_TimeZoneName:
+                wxFAIL_MSG( "unexpected format item" );
+                break;
+        }
+    }
+}
+
+bool
+wxDateTimeFormatter::DoParse(const wxString& date,
+                             wxString::const_iterator& input,
+                             wxDateTime& dt,
+                             const wxDateTime& dateDef,
+                             const wxDateTime::Tm* tmDef) const
+{
+    // The code here mirrors wxDateTime::ParseFormat(), see the comments there.
+    bool haveWDay = false,
+         haveYDay = false,
+         haveDay = false,
+         haveMon = false,
+         haveYear = false,
+         haveHour = false,
+         haveMin = false,
+         haveSec = false,
+         haveMsec = false;
+
+    bool hourIsIn12hFormat = false,
+         isPM = false;
+
+    bool haveTimeZone = false;
+
+    wxDateTime::wxDateTime_t msec = 0,
+                             sec = 0,
+                             min = 0,
+                             hour = 0;
+    wxDateTime::WeekDay wday = wxDateTime::Inv_WeekDay;
+    wxDateTime::wxDateTime_t yday = 0,
+                             mday = 0;
+    wxDateTime::Month mon = wxDateTime::Inv_Month;
+    int year = 0;
+    long timeZone = 0;
+
+    const wxString::const_iterator end = date.end();
+    for ( const Item& item : m_parseItems )
+    {
+        switch ( item.type )
+        {
+            case Item_Literal:
+                for ( wxString::const_iterator p = item.text.begin();
+                      p != item.text.end();
+                      ++p )
+                {
+                    if ( input == end || *input++ != *p )
+                        return false;
+                }
+                break;
+
+            case Item_Space:
+                while ( input != end && wxIsspace(*input) )
+                {
+                    ++input;
+                }
+                break;
+
+            case Item_Number:
+                {
+                    unsigned long num;
+                    if ( !ScanNumber(item.width, input, end, &num) )
+                        return false;
+
+                    switch ( item.spec )
+                    {
+                        case 'd':
+                        case 'e':
+                            if ( num > 31 || num < 1 )
+                                return false;
+
+                            haveDay = true;
+                            mday = (wxDateTime::wxDateTime_t)num;
+                            break;
+
+                        case 'H':
+                            if ( num > 23 )
+                                return false;
+
+                            haveHour = true;
+                            hour = (wxDateTime::wxDateTime_t)num;
+                            break;
+
+                        case 'I':
+                            if ( !num || num > 12 )
+                                return false;
+
+                            haveHour = true;
+                            hourIsIn12hFormat = true;
+                            hour = (wxDateTime::wxDateTime_t)(num % 12);
+                            break;
+
+                        case 'j':
+                            if ( !num || num > 366 )
+                                return false;
+
+                            haveYDay = true;
+                            yday = (wxDateTime::wxDateTime_t)num;
+                            break;
+
+                        case 'l':
+                            haveMsec = true;
+                            msec = (wxDateTime::wxDateTime_t)num;
+                            break;
+
+                        case 'm':
+                            if ( !num || num > 12 )
+                                return false;
+
+                            haveMon = true;
+                            mon = (wxDateTime::Month)(num - 1);
+                            break;
+
+                        case 'M':
+                            if ( num > 59 )
+                                return false;
+
+                            haveMin = true;
+                            min = (wxDateTime::wxDateTime_t)num;
+                            break;
+
+                        case 'S':
+                            if ( num > 61 )
+                                return false;
+
+                            haveSec = true;
+                            sec = (wxDateTime::wxDateTime_t)num;
+                            break;
+
+                        case 'w':
+                            if ( num > 6 )
+                                return false;
+
+                            haveWDay = true;
+                            wday = (wxDateTime::WeekDay)num;
+                            break;
+
+                        case 'y':
+                            if ( num > 99 )
+                                return false;
+
+                            haveYear = true;
+                            year = (num > 30 ? 1900 : 2000) +
+                                        (wxDateTime::wxDateTime_t)num;
+                            break;
+
+                        case 'Y':
+                            haveYear = true;
+                            year = (wxDateTime::wxDateTime_t)num;
+                            break;
+                    }
+                }
+                break;
+
+            case Item_WeekDayName:
+                wday = GetWeekDayFromName
+                       (
+                        input, end,
+                        item.spec == 'a' ? wxDateTime::Name_Abbr
+                                         : wxDateTime::Name_Full,
+                        DateLang_Local
+                       );
+                if ( wday == wxDateTime::Inv_WeekDay )
+                    return false;
+
+                haveWDay = true;
+                break;
+
+            case Item_MonthName:
+                mon = GetMonthFromName
+                      (
+                        input, end,
+                        item.spec == 'b' ? wxDateTime::Name_Abbr
+                                         : wxDateTime::Name_Full,
+                        DateLang_Local
+                      );
+                if ( mon == wxDateTime::Inv_Month )
+                    return false;
+
+                haveMon = true;
+                break;
+
+            case Item_AmPm:
+                {
+                    wxString am, pm;
+                    wxDateTime::GetAmPmStrings(&am, &pm);
+
+                    if ( am.empty() || pm.empty() )
+                        return false;
+
+                    const size_t pos = input - date.begin();
+                    if ( date.compare(pos, pm.length(), pm) == 0 )
+                    {
+                        isPM = true;
+                        input += pm.length();
+                    }
+                    else if ( date.compare(pos, am.length(), am) == 0 )
+                    {
+                        input += am.length();
+                    }
+                    else
+                    {
+                        return false;
+                    }
+                }
+                break;
+
+            case Item_TimeZone:
+                {
+                    if ( input == end )
+                        return false;
+
+                    if ( *input == wxS('Z') )
+                    {
+                        ++input;
+                        haveTimeZone = true;
+                        break;
+                    }
+
+                    bool minusFound;
+                    if ( *input == wxS('+') )
+                        minusFound = false;
+                    else if ( *input == wxS('-') ||
+                                *input == wxUniChar(0x2212) ) // MINUS SIGN
+                        minusFound = true;
+                    else
+                        return false;
+
+                    ++input;
+
+                    const size_t numRequiredDigits = 2;
+                    size_t numScannedDigits;
+
+                    unsigned long hours;
+                    if ( !ScanNumber(numRequiredDigits, input, end,
+                                     &hours, &numScannedDigits)
+                         || numScannedDigits != numRequiredDigits)
+                    {
+                        return false;
+                    }
+
+                    bool mustHaveMinutes = false;
+                    if ( input != end && *input == wxS(':') )
+                    {
+                        mustHaveMinutes = true;
+                        ++input;
+                    }
+
+                    unsigned long minutes = 0;
+                    if ( !ScanNumber(numRequiredDigits, input, end,
+                                     &minutes, &numScannedDigits)
+                         || numScannedDigits != numRequiredDigits)
+                    {
+                        if (mustHaveMinutes || numScannedDigits)
+                            return false;
+                    }
+
+                    if ( hours > 15 || minutes > 59 )
+                        return false;
+
+                    timeZone = 3600*hours + 60*minutes;
+                    if ( minusFound )
+                        timeZone = -timeZone;
+
+                    haveTimeZone = true;
+                }
+                break;
+
+            case Item_TimeZoneName:
+                GetAlphaToken(input, end);
+                break;
+
+            case Item_Strftime:
+                wxFAIL_MSG( "unexpected parse item" );
+                return false;
+        }
+    }
+
+    wxDateTime::Tm tm;
+    if ( tmDef )
+    {
+        tm = *tmDef;
+    }
+    else if ( dateDef.IsValid() )
+    {
+        tm = dateDef.GetTm();
+    }
+    else if ( dt.IsValid() )
+    {
+        tm = dt.GetTm();
+    }
+    else if ( haveYear && (haveDay ? haveMon : haveYDay) )
+    {
+        // All the date fields of Today() would be overwritten below and its
+        // time is midnight, which is what default Tm already contains, so
+        // don't waste time on calling it.
+    }
+    else
+    {
+        tm = wxDateTime::Today().GetTm();
+    }
+
+    if ( haveMon )
+    {
+        tm.mon = mon;
+    }
+
+    if ( haveYear )
+    {
+        tm.year = year;
+    }
+
+    if ( haveDay )
+    {
+        if ( mday > wxDateTime::GetNumberOfDays(tm.mon, tm.year) )
+            return false;
+
+        tm.mday = mday;
+    }
+    else if ( haveYDay )
+    {
+        if ( yday > wxDateTime::GetNumberOfDays(tm.year) )
+            return false;
+
+        const wxDateTime::Tm
+            tm2 = wxDateTime(1, wxDateTime::Jan, tm.year).SetToYearDay(yday).GetTm();
+
+        tm.mon = tm2.mon;
+        tm.mday = tm2.mday;
+    }
+
+    if ( haveHour && hourIsIn12hFormat && isPM )
+    {
+        hour += 12;
+    }
+
+    if ( haveHour )
+    {
+        tm.hour = hour;
+    }
+
+    if ( haveMin )
+    {
+        tm.min = min;
+    }
+
+    if ( haveSec )
+    {
+        tm.sec = sec;
+    }
+
+    if ( haveMsec )
+        tm.msec = msec;
+
+    wxDateTime result(tm);
+
+    if ( haveTimeZone )
+        result.MakeFromTimezone(timeZone);
+
+    if ( haveWDay && result.GetWeekDay() != wday )
+        return false;
+
+    dt = result;
+
+    return true;
+}
+
+bool
+wxDateTimeFormatter::Parse(const wxString& date,
+                           wxDateTime* dt,
+                           const wxDateTime& dateDef,
+                           wxString::const_iterator* end) const
+{
+    wxCHECK_MSG( dt, false, "date pointer must be specified" );
+
+    wxDateTime result = *dt;
+    wxString::const_iterator endParse = date.begin();
+    const bool ok = m_canParse
+                        ? DoParse(date, endParse, result, dateDef, nullptr)
+                        : result.ParseFormat(date, m_format, dateDef, &endParse);
+    if ( !ok )
+        return false;
+
+    if ( end )
+        *end = endParse;
+    else if ( endParse != date.end() )
+        return false;
+
+    *dt = result;
+
+    return true;
+}
+
+size_t
+wxDateTimeFormatter::ParseAll(const std::vector<wxString>& strings,
+                              std::vector<wxDateTime>& dates,
+                              const wxDateTime& dateDef) const
+{
+    dates.assign(strings.size(), wxInvalidDateTime);
+
+    // Determine the default date only once instead of doing it for every
+    // string.
+    wxDateTime::Tm tmDef;
+    if ( m_canParse && !strings.empty() )
+        tmDef = (dateDef.IsValid() ? dateDef : wxDateTime::Today()).GetTm();
+
+    size_t numParsed = 0;
+    for ( size_t n = 0; n < strings.size(); n++ )
+    {
+        const wxString& str = strings[n];
+        wxDateTime& dt = dates[n];
+
+        wxString::const_iterator end = str.begin();
+        const bool ok = m_canParse
+                            ? DoParse(str, end, dt, dateDef, &tmDef)
+                            : dt.ParseFormat(str, m_format, dateDef, &end);
+        if ( ok && end == str.end() )
+            numParsed++;
+        else
+            dt = wxInvalidDateTime;
+    }
+
+    return numParsed;
+}
+
 // ============================================================================
 // wxDateSpan
 // ============================================================================
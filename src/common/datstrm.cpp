@@ -36,6 +36,122 @@ union Float64Data
     wxUint32 i[2];
 };
 
+// Size of the intermediate buffer used by the functions reading or writing
+// arrays of values: they are converted in chunks of this size, so that the
+// stream is accessed only once per chunk instead of once per value.
+const size_t CHUNK_SIZE = 4096;
+
+// Return true if the data in the given order must be byte-swapped.
+inline bool NeedsSwap(bool be_order)
+{
+    return be_order != (wxBYTE_ORDER == wxBIG_ENDIAN);
+}
+
+inline wxUint16 SwapValue(wxUint16 v) { return wxUINT16_SWAP_ALWAYS(v); }
+inline wxUint32 SwapValue(wxUint32 v) { return wxUINT32_SWAP_ALWAYS(v); }
+inline wxUint64 SwapValue(wxUint64 v) { return wxUINT64_SWAP_ALWAYS(v); }
+
+// Swap the bytes of all values of type T stored in the given buffer in place.
+//
+// Notice that the buffer is accessed via memcpy() to avoid aliasing problems
+// as it may contain floating point values too. This loop is simple enough for
+// the compiler to both inline memcpy() and vectorize it.
+template <typename T>
+void SwapArray(void *data, size_t count)
+{
+    unsigned char *p = static_cast<unsigned char *>(data);
+    for ( size_t n = 0; n < count; n++, p += sizeof(T) )
+    {
+        T v;
+        memcpy(&v, p, sizeof(T));
+        v = SwapValue(v);
+        memcpy(p, &v, sizeof(T));
+    }
+}
+
+// Read an array of values directly into the output buffer and then convert
+// them to the native byte order, if necessary.
+template <typename T>
+void DoReadArray(void *buffer, size_t count, wxInputStream *input, bool be_order)
+{
+    input->Read(buffer, count * sizeof(T));
+
+    if ( NeedsSwap(be_order) )
+        SwapArray<T>(buffer, count);
+}
+
+// Write an array of values in the given byte order.
+template <typename T>
+void DoWriteArray(const void *buffer, size_t count, wxOutputStream *output, bool be_order)
+{
+    if ( !NeedsSwap(be_order) )
+    {
+        output->Write(buffer, count * sizeof(T));
+        return;
+    }
+
+    // We can't modify the caller data, so swap it in a temporary buffer.
+    const unsigned char *p = static_cast<const unsigned char *>(buffer);
+    unsigned char chunk[CHUNK_SIZE];
+    while ( count )
+    {
+        const size_t n = wxMin(count, CHUNK_SIZE / sizeof(T));
+        const size_t len = n * sizeof(T);
+
+        memcpy(chunk, p, len);
+        SwapArray<T>(chunk, n);
+        output->Write(chunk, len);
+
+        p += len;
+        count -= n;
+    }
+}
+
+#if wxUSE_APPLE_IEEE
+
+// Size of a number in the extended precision format.
+const size_t EXTENDED_SIZE = 10;
+
+// Read an array of values stored in the extended precision format.
+template <typename T>
+void DoReadExtendedArray(T *buffer, size_t count, wxInputStream *input)
+{
+    wxInt8 chunk[(CHUNK_SIZE / EXTENDED_SIZE) * EXTENDED_SIZE];
+    while ( count )
+    {
+        const size_t n = wxMin(count, CHUNK_SIZE / EXTENDED_SIZE);
+
+        input->Read(chunk, n * EXTENDED_SIZE);
+        for ( size_t i = 0; i < n; i++ )
+        {
+            *buffer++ = static_cast<T>(
+                            wxConvertFromIeeeExtended(chunk + i*EXTENDED_SIZE));
+        }
+
+        count -= n;
+    }
+}
+
+// Write an array of values using the extended precision format.
+template <typename T>
+void DoWriteExtendedArray(const T *buffer, size_t count, wxOutputStream *output)
+{
+    wxInt8 chunk[(CHUNK_SIZE / EXTENDED_SIZE) * EXTENDED_SIZE];
+    while ( count )
+    {
+        const size_t n = wxMin(count, CHUNK_SIZE / EXTENDED_SIZE);
+
+        for ( size_t i = 0; i < n; i++ )
+            wxConvertToIeeeExtended(*buffer++, chunk + i*EXTENDED_SIZE);
+
+        output->Write(chunk, n * EXTENDED_SIZE);
+
+        count -= n;
+    }
+}
+
+#endif // wxUSE_APPLE_IEEE
+
 } // anonymous namespace
 
 // ----------------------------------------------------------------------------
@@ -264,66 +380,14 @@ static void DoWriteLL(const T *buffer, size_t size, wxOutputStream *output, bool
     delete[] pchBuffer;
 }
 
-template <class T>
-static
-void DoReadI64(T *buffer, size_t size, wxInputStream *input, bool be_order)
-{
-    typedef T DataType;
-    unsigned char *pchBuffer = (unsigned char*) buffer;
-    // TODO: Check for overflow when size is of type uint and is > than 512m
-    input->Read(pchBuffer, size * 8);
-    if ( be_order )
-    {
-        for ( wxUint32 i = 0; i < size; i++ )
-        {
-            DataType v = wxUINT64_SWAP_ON_LE(*buffer);
-            *(buffer++) = v;
-        }
-    }
-    else // little endian
-    {
-        for ( wxUint32 i=0; i<size; i++ )
-        {
-            DataType v = wxUINT64_SWAP_ON_BE(*buffer);
-            *(buffer++) = v;
-        }
-    }
-}
-
-template <class T>
-static
-void DoWriteI64(const T *buffer, size_t size, wxOutputStream *output, bool be_order)
-{
-  typedef T DataType;
-  if ( be_order )
-  {
-    for ( size_t i = 0; i < size; i++ )
-    {
-      DataType i64 = wxUINT64_SWAP_ON_LE(*buffer);
-      buffer++;
-      output->Write(&i64, 8);
-    }
-  }
-  else // little endian
-  {
-    for ( size_t i=0; i < size; i++ )
-    {
-      DataType i64 = wxUINT64_SWAP_ON_BE(*buffer);
-      buffer++;
-      output->Write(&i64, 8);
-    }
-  }
-}
-
-
 void wxDataInputStream::Read64(wxUint64 *buffer, size_t size)
 {
-    DoReadI64(buffer, size, m_input, m_be_order);
+    DoReadArray<wxUint64>(buffer, size, m_input, m_be_order);
 }
 
 void wxDataInputStream::Read64(wxInt64 *buffer, size_t size)
 {
-    DoReadI64(buffer, size, m_input, m_be_order);
+    DoReadArray<wxUint64>(buffer, size, m_input, m_be_order);
 }
 
 void wxDataInputStream::Read64(wxULongLong *buffer, size_t size)
@@ -355,46 +419,12 @@ wxLongLong wxDataInputStream::ReadLL(void)
 
 void wxDataInputStream::Read32(wxUint32 *buffer, size_t size)
 {
-    m_input->Read(buffer, size * 4);
-
-    if (m_be_order)
-    {
-        for (wxUint32 i=0; i<size; i++)
-        {
-            wxUint32 v = wxUINT32_SWAP_ON_LE(*buffer);
-            *(buffer++) = v;
-        }
-    }
-    else
-    {
-        for (wxUint32 i=0; i<size; i++)
-        {
-            wxUint32 v = wxUINT32_SWAP_ON_BE(*buffer);
-            *(buffer++) = v;
-        }
-    }
+    DoReadArray<wxUint32>(buffer, size, m_input, m_be_order);
 }
 
 void wxDataInputStream::Read16(wxUint16 *buffer, size_t size)
 {
-  m_input->Read(buffer, size * 2);
-
-  if (m_be_order)
-  {
-    for (wxUint32 i=0; i<size; i++)
-    {
-      wxUint16 v = wxUINT16_SWAP_ON_LE(*buffer);
-      *(buffer++) = v;
-    }
-  }
-  else
-  {
-    for (wxUint32 i=0; i<size; i++)
-    {
-      wxUint16 v = wxUINT16_SWAP_ON_BE(*buffer);
-      *(buffer++) = v;
-    }
-  }
+    DoReadArray<wxUint16>(buffer, size, m_input, m_be_order);
 }
 
 void wxDataInputStream::Read8(wxUint8 *buffer, size_t size)
@@ -404,18 +434,28 @@ void wxDataInputStream::Read8(wxUint8 *buffer, size_t size)
 
 void wxDataInputStream::ReadDouble(double *buffer, size_t size)
 {
-  for (wxUint32 i=0; i<size; i++)
-  {
-    *(buffer++) = ReadDouble();
-  }
+#if wxUSE_APPLE_IEEE
+    if ( m_useExtendedPrecision )
+    {
+        DoReadExtendedArray(buffer, size, m_input);
+        return;
+    }
+#endif // wxUSE_APPLE_IEEE
+
+    DoReadArray<wxUint64>(buffer, size, m_input, m_be_order);
 }
 
 void wxDataInputStream::ReadFloat(float *buffer, size_t size)
 {
-  for (wxUint32 i=0; i<size; i++)
-  {
-    *(buffer++) = ReadFloat();
-  }
+#if wxUSE_APPLE_IEEE
+    if ( m_useExtendedPrecision )
+    {
+        DoReadExtendedArray(buffer, size, m_input);
+        return;
+    }
+#endif // wxUSE_APPLE_IEEE
+
+    DoReadArray<wxUint32>(buffer, size, m_input, m_be_order);
 }
 
 wxDataInputStream& wxDataInputStream::operator>>(wxString& s)
@@ -602,12 +642,12 @@ void wxDataOutputStream::WriteFloat(float f)
 
 void wxDataOutputStream::Write64(const wxUint64 *buffer, size_t size)
 {
-    DoWriteI64(buffer, size, m_output, m_be_order);
+    DoWriteArray<wxUint64>(buffer, size, m_output, m_be_order);
 }
 
 void wxDataOutputStream::Write64(const wxInt64 *buffer, size_t size)
 {
-    DoWriteI64(buffer, size, m_output, m_be_order);
+    DoWriteArray<wxUint64>(buffer, size, m_output, m_be_order);
 }
 
 void wxDataOutputStream::Write64(const wxULongLong *buffer, size_t size)
@@ -642,46 +682,12 @@ void wxDataOutputStream::WriteLL(const wxULongLong &ll)
 
 void wxDataOutputStream::Write32(const wxUint32 *buffer, size_t size)
 {
-  if (m_be_order)
-  {
-    for (wxUint32 i=0; i<size ;i++)
-    {
-      wxUint32 i32 = wxUINT32_SWAP_ON_LE(*buffer);
-      buffer++;
-      m_output->Write(&i32, 4);
-    }
-  }
-  else
-  {
-    for (wxUint32 i=0; i<size ;i++)
-    {
-      wxUint32 i32 = wxUINT32_SWAP_ON_BE(*buffer);
-      buffer++;
-      m_output->Write(&i32, 4);
-    }
-  }
+    DoWriteArray<wxUint32>(buffer, size, m_output, m_be_order);
 }
 
 void wxDataOutputStream::Write16(const wxUint16 *buffer, size_t size)
 {
-  if (m_be_order)
-  {
-    for (wxUint32 i=0; i<size ;i++)
-    {
-      wxUint16 i16 = wxUINT16_SWAP_ON_LE(*buffer);
-      buffer++;
-      m_output->Write(&i16, 2);
-    }
-  }
-  else
-  {
-    for (wxUint32 i=0; i<size ;i++)
-    {
-      wxUint16 i16 = wxUINT16_SWAP_ON_BE(*buffer);
-      buffer++;
-      m_output->Write(&i16, 2);
-    }
-  }
+    DoWriteArray<wxUint16>(buffer, size, m_output, m_be_order);
 }
 
 void wxDataOutputStream::Write8(const wxUint8 *buffer, size_t size)
@@ -691,18 +697,28 @@ void wxDataOutputStream::Write8(const wxUint8 *buffer, size_t size)
 
 void wxDataOutputStream::WriteDouble(const double *buffer, size_t size)
 {
-  for (wxUint32 i=0; i<size; i++)
-  {
-    WriteDouble(*(buffer++));
-  }
+#if wxUSE_APPLE_IEEE
+    if ( m_useExtendedPrecision )
+    {
+        DoWriteExtendedArray(buffer, size, m_output);
+        return;
+    }
+#endif // wxUSE_APPLE_IEEE
+
+    DoWriteArray<wxUint64>(buffer, size, m_output, m_be_order);
 }
 
 void wxDataOutputStream::WriteFloat(const float *buffer, size_t size)
 {
-  for (wxUint32 i=0; i<size; i++)
-  {
-    WriteFloat(*(buffer++));
-  }
+#if wxUSE_APPLE_IEEE
+    if ( m_useExtendedPrecision )
+    {
+        DoWriteExtendedArray(buffer, size, m_output);
+        return;
+    }
+#endif // wxUSE_APPLE_IEEE
+
+    DoWriteArray<wxUint32>(buffer, size, m_output, m_be_order);
 }
 
 wxDataOutputStream& wxDataOutputStream::operator<<(const wxString& string)
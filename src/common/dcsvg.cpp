@@ -61,6 +61,52 @@ inline wxString NumStr(float f)
     return NumStr(double(f));
 }
 
+// Size of the buffer accumulating the output before writing it to the file.
+const size_t SVG_BUFFER_SIZE = 64*1024;
+
+// Maximal number of lines combined into a single <path> element: there is no
+// limit in SVG itself, but some viewers handle huge paths poorly.
+const int SVG_MAX_PATH_SEGMENTS = 1000;
+
+// Append the decimal representation of the given number to the string. This
+// is much faster than wxString::Format(), doesn't allocate any memory (unless
+// the string needs to grow) and doesn't depend on the current locale.
+void AppendNum(std::string& s, int n)
+{
+    char buf[16];
+    char* const end = buf + sizeof(buf);
+    char* p = end;
+
+    unsigned u = n < 0 ? 0u - static_cast<unsigned>(n)
+                       : static_cast<unsigned>(n);
+    do
+    {
+        *--p = static_cast<char>('0' + u % 10);
+        u /= 10;
+    }
+    while ( u );
+
+    if ( n < 0 )
+        *--p = '-';
+
+    s.append(p, end - p);
+}
+
+// Append "x y" to the string.
+inline void AppendPoint(std::string& s, int x, int y)
+{
+    AppendNum(s, x);
+    s += ' ';
+    AppendNum(s, y);
+}
+
+// Append the given string converted to UTF-8.
+inline void AppendStr(std::string& s, const wxString& str)
+{
+    const wxScopedCharBuffer buf = str.utf8_str();
+    s.append(buf.data(), buf.length());
+}
+
 // Return the colour representation as HTML-like "#rrggbb" string and also
 // returns its alpha as opacity number in 0..1 range.
 wxString Col2SVG(wxColour c, float* opacity = nullptr)
@@ -554,10 +600,18 @@ void wxSVGFileDCImpl::Init(const wxString& filename, int width, int height,
 
     m_bmp_handler.reset();
 
+    m_buffer.clear();
+    m_pathSegments = 0;
+
     if ( m_filename.empty() )
+    {
         m_outfile.reset();
+    }
     else
+    {
         m_outfile.reset(new wxFileOutputStream(m_filename));
+        m_buffer.reserve(SVG_BUFFER_SIZE);
+    }
 
     const wxSize dpiSize = FromDIP(wxSize(m_width, m_height));
 
@@ -583,6 +637,8 @@ wxSVGFileDCImpl::~wxSVGFileDCImpl()
 
     s += wxS("</g>\n</svg>\n");
     write(s);
+
+    FlushBuffer();
 }
 
 void wxSVGFileDCImpl::DoGetSizeMM(int* width, int* height) const
@@ -627,13 +683,36 @@ void wxSVGFileDCImpl::DoDrawLine(wxCoord x1, wxCoord y1, wxCoord x2, wxCoord y2)
 {
     NewGraphicsIfNeeded();
 
-    wxString s;
-    s = wxString::Format(wxS("  <path d=\"M%d %d L%d %d\" %s %s/>\n"),
-        x1, y1, x2, y2, GetRenderMode(m_renderingMode), GetPenPattern(m_pen));
+    CalcBoundingBox(x1, y1, x2, y2);
 
-    write(s);
+    // Consecutive lines drawn with the same pen are combined into a single
+    // <path> element, which is closed as soon as anything else is output or
+    // the pen changes.
+    if ( m_pathSegments == 0 || m_pathSegments == SVG_MAX_PATH_SEGMENTS )
+    {
+        if ( !BeginWrite() )
+            return;
 
-    CalcBoundingBox(x1, y1, x2, y2);
+        m_buffer += "  <path d=\"M";
+    }
+    else
+    {
+        m_buffer += " M";
+    }
+
+    AppendPoint(m_buffer, x1, y1);
+    m_buffer += " L";
+    AppendPoint(m_buffer, x2, y2);
+
+    m_pathSegments++;
+
+    // The overlapping parts of the lines in the same path are only drawn
+    // once, which makes a difference for semi-transparent pens, so don't
+    // combine the lines drawn with them to keep their appearance unchanged.
+    if ( m_pen.IsOk() && m_pen.GetColour().Alpha() != wxALPHA_OPAQUE )
+        ClosePendingPath();
+
+    EndWrite();
 }
 
 void wxSVGFileDCImpl::DoDrawLines(int n, const wxPoint points[], wxCoord xoffset, wxCoord yoffset)
@@ -641,23 +720,32 @@ void wxSVGFileDCImpl::DoDrawLines(int n, const wxPoint points[], wxCoord xoffset
     if (n > 1)
     {
         NewGraphicsIfNeeded();
-        wxString s;
 
-        s = wxString::Format(wxS("  <path d=\"M%d %d"),
-            (points[0].x + xoffset), (points[0].y + yoffset));
+        for (int i = 0; i < n; ++i)
+            CalcBoundingBox(points[i].x + xoffset, points[i].y + yoffset);
+
+        if ( !BeginWrite() )
+            return;
 
-        CalcBoundingBox(points[0].x + xoffset, points[0].y + yoffset);
+        m_buffer += "  <path d=\"M";
+        AppendPoint(m_buffer, points[0].x + xoffset, points[0].y + yoffset);
 
         for (int i = 1; i < n; ++i)
         {
-            s += wxString::Format(wxS(" L%d %d"), (points[i].x + xoffset), (points[i].y + yoffset));
-            CalcBoundingBox(points[i].x + xoffset, points[i].y + yoffset);
+            m_buffer += " L";
+            AppendPoint(m_buffer, points[i].x + xoffset, points[i].y + yoffset);
+
+            // Don't let the buffer grow indefinitely for huge polylines.
+            EndWrite();
         }
 
-        s += wxString::Format(wxS("\" style=\"fill:none\" %s %s/>\n"),
-            GetRenderMode(m_renderingMode), GetPenPattern(m_pen));
+        m_buffer += "\" style=\"fill:none\" ";
+        AppendStr(m_buffer, GetRenderMode(m_renderingMode));
+        m_buffer += ' ';
+        AppendStr(m_buffer, GetPenPattern(m_pen));
+        m_buffer += "/>\n";
 
-        write(s);
+        EndWrite();
     }
 }
 
@@ -872,21 +960,33 @@ void wxSVGFileDCImpl::DoDrawPolygon(int n, const wxPoint points[],
 {
     NewGraphicsIfNeeded();
 
-    wxString s;
+    for (int i = 0; i < n; i++)
+        CalcBoundingBox(points[i].x + xoffset, points[i].y + yoffset);
 
-    s = wxS("  <polygon points=\"");
+    if ( !BeginWrite() )
+        return;
+
+    m_buffer += "  <polygon points=\"";
 
     for (int i = 0; i < n; i++)
     {
-        s += wxString::Format(wxS("%d %d "), points[i].x + xoffset, points[i].y + yoffset);
-        CalcBoundingBox(points[i].x + xoffset, points[i].y + yoffset);
-    }
+        AppendPoint(m_buffer, points[i].x + xoffset, points[i].y + yoffset);
+        m_buffer += ' ';
 
-    s += wxString::Format(wxS("\" %s %s %s style=\"fill-rule:%s;\"/>\n"),
-        GetRenderMode(m_renderingMode), GetPenPattern(m_pen), GetBrushPattern(m_brush),
-        fillStyle == wxODDEVEN_RULE ? wxS("evenodd") : wxS("nonzero"));
+        EndWrite();
+    }
 
-    write(s);
+    m_buffer += "\" ";
+    AppendStr(m_buffer, GetRenderMode(m_renderingMode));
+    m_buffer += ' ';
+    AppendStr(m_buffer, GetPenPattern(m_pen));
+    m_buffer += ' ';
+    AppendStr(m_buffer, GetBrushPattern(m_brush));
+    m_buffer += " style=\"fill-rule:";
+    m_buffer += fillStyle == wxODDEVEN_RULE ? "evenodd" : "nonzero";
+    m_buffer += ";\"/>\n";
+
+    EndWrite();
 }
 
 void wxSVGFileDCImpl::DoDrawPolyPolygon(int n, const int count[], const wxPoint points[],
@@ -1325,6 +1425,9 @@ void wxSVGFileDCImpl::SetBitmapHandler(wxSVGBitmapHandler* handler)
 
 void wxSVGFileDCImpl::SetShapeRenderingMode(wxSVGShapeRenderingMode renderingMode)
 {
+    // The pending path must use the old mode.
+    ClosePendingPath();
+
     m_renderingMode = renderingMode;
 }
 
@@ -1345,6 +1448,9 @@ void wxSVGFileDCImpl::SetBrush(const wxBrush& brush)
 
 void wxSVGFileDCImpl::SetPen(const wxPen& pen)
 {
+    // The pending path must use the old pen.
+    ClosePendingPath();
+
     m_pen = pen;
 
     m_graphics_changed = true;
@@ -1429,23 +1535,67 @@ void wxSVGFileDCImpl::DoDrawBitmap(const wxBitmap& bmp, wxCoord x, wxCoord y,
     if ( !m_bmp_handler )
         m_bmp_handler.reset(new wxSVGBitmapFileHandler(m_filename));
 
-    m_OK = m_outfile && m_outfile->IsOk();
-    if (!m_OK)
+    if ( !BeginWrite() )
         return;
 
+    // The handler writes directly to the file, so flush everything before.
+    FlushBuffer();
+
     m_bmp_handler->ProcessBitmap(bmp, x, y, *m_outfile);
     m_OK = m_outfile->IsOk();
 }
 
 void wxSVGFileDCImpl::write(const wxString& s)
 {
+    if ( !BeginWrite() )
+        return;
+
+    AppendStr(m_buffer, s);
+
+    EndWrite();
+}
+
+bool wxSVGFileDCImpl::BeginWrite()
+{
+    ClosePendingPath();
+
     m_OK = m_outfile && m_outfile->IsOk();
-    if (!m_OK)
+
+    return m_OK;
+}
+
+void wxSVGFileDCImpl::EndWrite()
+{
+    if ( m_buffer.size() >= SVG_BUFFER_SIZE )
+        FlushBuffer();
+}
+
+void wxSVGFileDCImpl::FlushBuffer()
+{
+    if ( m_buffer.empty() )
         return;
 
-    const wxCharBuffer buf = s.utf8_str();
-    m_outfile->Write(buf, strlen((const char*)buf));
-    m_OK = m_outfile->IsOk();
+    if ( m_outfile )
+    {
+        m_outfile->Write(m_buffer.data(), m_buffer.size());
+        m_OK = m_outfile->IsOk();
+    }
+
+    m_buffer.clear();
+}
+
+void wxSVGFileDCImpl::ClosePendingPath()
+{
+    if ( !m_pathSegments )
+        return;
+
+    m_pathSegments = 0;
+
+    m_buffer += "\" ";
+    AppendStr(m_buffer, GetRenderMode(m_renderingMode));
+    m_buffer += ' ';
+    AppendStr(m_buffer, GetPenPattern(m_pen));
+    m_buffer += "/>\n";
 }
 
 #endif // wxUSE_SVG
@@ -30,6 +30,14 @@
 #include "wx/dir.h"
 #include "wx/filename.h"
 
+#if wxUSE_THREADS
+    #include "wx/thread.h"
+
+    #include <deque>
+    #include <memory>
+    #include <vector>
+#endif // wxUSE_THREADS
+
 // ============================================================================
 // implementation
 // ============================================================================
@@ -89,6 +97,649 @@ wxString wxDir::GetNameWithSep() const
     return name;
 }
 
+// ----------------------------------------------------------------------------
+// wxDirParallelTraverser: implementation of Traverse() with wxDIR_PARALLEL
+// ----------------------------------------------------------------------------
+
+#if wxUSE_THREADS
+
+namespace
+{
+
+// Maximal number of entries read by the worker threads but not passed to the
+// user-defined wxDirTraverser yet: this limits the memory used if it is
+// slower than the threads reading the directories.
+const size_t DIR_MAX_PENDING_ENTRIES = 256*1024;
+
+// Maximal number of threads used for reading the directories.
+const int DIR_MAX_THREADS = 32;
+
+// A directory read by wxDirParallelTraverser.
+struct wxDirScanNode
+{
+    enum State
+    {
+        Queued,     // waiting to be read
+        Scanning,   // being read by some thread
+        Done,       // read successfully
+        Failed      // couldn't be opened
+    };
+
+    explicit wxDirScanNode(const wxString& path_) : path(path_) { }
+
+    const wxString path;
+
+    // All the fields below are protected by wxDirParallelTraverser mutex.
+    State state = Queued;
+
+    // Set if the directory contents is not needed any more.
+    bool cancelled = false;
+
+    // Index of the queue of the thread which read this directory.
+    size_t queue = 0;
+
+    // The full paths of the subdirectories and files of this directory.
+    std::vector<wxString> dirs,
+                          files;
+
+    // The number of entries accounted in wxDirParallelTraverser pending
+    // entries count.
+    size_t pending = 0;
+
+    // The nodes for all subdirectories, in the same order as dirs. This is
+    // only used in the ordered mode, in which the subdirectories are read
+    // speculatively, i.e. before OnDir() is called for them.
+    std::vector< std::shared_ptr<wxDirScanNode> > children;
+};
+
+typedef std::shared_ptr<wxDirScanNode> wxDirScanNodePtr;
+
+// Queue of the directories to read associated with each thread: the thread
+// itself takes the most recently added directories from it, as this results
+// in a depth-first traversal, while the other threads steal the oldest ones,
+// which are close to the root and so have the biggest subtrees.
+class wxDirScanQueue
+{
+public:
+    wxDirScanQueue() { }
+
+    void Push(const wxDirScanNodePtr& node)
+    {
+        wxMutexLocker lock(m_mutex);
+        m_nodes.push_back(node);
+    }
+
+    wxDirScanNodePtr Pop()
+    {
+        wxMutexLocker lock(m_mutex);
+        wxDirScanNodePtr node;
+        if ( !m_nodes.empty() )
+        {
+            node = std::move(m_nodes.back());
+            m_nodes.pop_back();
+        }
+        return node;
+    }
+
+    wxDirScanNodePtr Steal()
+    {
+        wxMutexLocker lock(m_mutex);
+        wxDirScanNodePtr node;
+        if ( !m_nodes.empty() )
+        {
+            node = std::move(m_nodes.front());
+            m_nodes.pop_front();
+        }
+        return node;
+    }
+
+private:
+    wxMutex m_mutex;
+    std::deque<wxDirScanNodePtr> m_nodes;
+
+    wxDECLARE_NO_COPY_CLASS(wxDirScanQueue);
+};
+
+class wxDirParallelTraverser
+{
+public:
+    // The flags here must not include wxDIR_PARALLEL nor wxDIR_UNORDERED.
+    wxDirParallelTraverser(wxDirTraverser& sink,
+                           const wxString& filespec,
+                           int flags,
+                           bool ordered)
+        : m_sink(sink),
+          m_filespec(filespec),
+          m_flags(flags),
+          m_ordered(ordered),
+          m_workCond(m_mutex),
+          m_doneCond(m_mutex)
+    {
+    }
+
+    ~wxDirParallelTraverser();
+
+    // Start the worker threads, return false if none could be started.
+    bool Start();
+
+    // Traverse the given directory, return the number of files found.
+    size_t Traverse(const wxString& dirname);
+
+    // Called from the worker thread with the given index.
+    void WorkerMain(size_t index);
+
+private:
+    // Read the directory, can be called from any thread.
+    void Scan(const wxDirScanNodePtr& node, size_t queue);
+
+    // Add the node to the given queue, m_mutex must be locked.
+    void SubmitLocked(const wxDirScanNodePtr& node, size_t queue);
+
+    // Take a node from the given queue or steal it from another one.
+    wxDirScanNodePtr TakeNode(size_t queue);
+
+    // Wait until the directory is read, possibly reading it in this thread,
+    // return true if it was successfully opened.
+    bool WaitForNode(const wxDirScanNodePtr& node);
+
+    // Free the directory contents, m_mutex must be locked.
+    void ReleaseLocked(wxDirScanNode& node);
+
+    // Mark the directory and all its subdirectories as not needed any more,
+    // m_mutex must be locked.
+    void CancelLocked(wxDirScanNode& node);
+
+    // Helper for Traverse() in the ordered mode: process all the directory
+    // contents recursively, return false if the traversal should stop.
+    bool WalkOrdered(const wxDirScanNodePtr& node);
+
+    // Helper for Traverse() in the unordered mode.
+    void WalkUnordered(const wxDirScanNodePtr& root);
+
+    // Call OnOpenError() and return true if we need to retry opening it,
+    // set the output parameter to false if the traversal should stop.
+    bool OnOpenError(const wxDirScanNode& node, bool* cont);
+
+    // Call OnFile() for all files of the given directory, return false if
+    // the traversal should stop.
+    bool SendFiles(const wxDirScanNode& node);
+
+
+    wxDirTraverser& m_sink;
+    const wxString m_filespec;
+    const int m_flags;
+    const bool m_ordered;
+
+    std::vector< std::unique_ptr<wxDirScanQueue> > m_queues;
+    std::vector<wxThread*> m_threads;
+
+    // The number of files passed to the sink.
+    size_t m_nFiles = 0;
+
+    // Index of the queue to use for the directories read by the main thread.
+    size_t m_nextQueue = 0;
+
+    // This mutex protects all the fields below and the state of the nodes.
+    wxMutex m_mutex;
+
+    // Signalled when there are new directories to read or we need to stop.
+    wxCondition m_workCond;
+
+    // Signalled when a directory has been read.
+    wxCondition m_doneCond;
+
+    // The total number of nodes in all queues.
+    int m_queued = 0;
+
+    // The number of entries read but not processed yet.
+    size_t m_pending = 0;
+
+    // Set to tell the worker threads to exit.
+    bool m_stop = false;
+
+    // The directories read so far, only used in the unordered mode.
+    std::deque<wxDirScanNodePtr> m_completed;
+
+    wxDECLARE_NO_COPY_CLASS(wxDirParallelTraverser);
+};
+
+class wxDirScanThread : public wxThread
+{
+public:
+    wxDirScanThread(wxDirParallelTraverser& owner, size_t index)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_owner(owner),
+          m_index(index)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        m_owner.WorkerMain(m_index);
+        return nullptr;
+    }
+
+private:
+    wxDirParallelTraverser& m_owner;
+    const size_t m_index;
+};
+
+} // anonymous namespace
+
+wxDirParallelTraverser::~wxDirParallelTraverser()
+{
+    {
+        wxMutexLocker lock(m_mutex);
+        m_stop = true;
+        m_workCond.Broadcast();
+    }
+
+    for ( size_t n = 0; n < m_threads.size(); n++ )
+    {
+        m_threads[n]->Wait();
+        delete m_threads[n];
+    }
+}
+
+bool wxDirParallelTraverser::Start()
+{
+    // Reading directories is mostly IO bound, especially for the network
+    // file systems, so use more threads than there are CPUs.
+    const int cpus = wxThread::GetCPUCount();
+    const int count = wxMin(wxMax(2*cpus, 4), DIR_MAX_THREADS);
+
+    for ( int n = 0; n < count; n++ )
+        m_queues.emplace_back(new wxDirScanQueue());
+
+    for ( int n = 0; n < count; n++ )
+    {
+        wxDirScanThread* const thread = new wxDirScanThread(*this, n);
+        if ( thread->Run() != wxTHREAD_NO_ERROR )
+        {
+            delete thread;
+            break;
+        }
+
+        m_threads.push_back(thread);
+    }
+
+    // If we couldn't create all the threads, the directories put into the
+    // queues of the missing ones will be stolen by the existing threads.
+    return !m_threads.empty();
+}
+
+void wxDirParallelTraverser::WorkerMain(size_t index)
+{
+    for ( ;; )
+    {
+        {
+            wxMutexLocker lock(m_mutex);
+            while ( !m_stop &&
+                        (m_queued <= 0 || m_pending > DIR_MAX_PENDING_ENTRIES) )
+                m_workCond.Wait();
+
+            if ( m_stop )
+                return;
+        }
+
+        wxDirScanNodePtr node = TakeNode(index);
+        if ( !node )
+        {
+            // Another thread took it before us.
+            continue;
+        }
+
+        {
+            wxMutexLocker lock(m_mutex);
+            m_queued--;
+
+            // The main thread may have already read this directory itself
+            // or it could have been cancelled.
+            if ( node->state != wxDirScanNode::Queued || node->cancelled )
+                continue;
+
+            node->state = wxDirScanNode::Scanning;
+        }
+
+        Scan(node, index);
+    }
+}
+
+wxDirScanNodePtr wxDirParallelTraverser::TakeNode(size_t queue)
+{
+    wxDirScanNodePtr node = m_queues[queue]->Pop();
+
+    for ( size_t n = 1; !node && n < m_queues.size(); n++ )
+        node = m_queues[(queue + n) % m_queues.size()]->Steal();
+
+    return node;
+}
+
+void wxDirParallelTraverser::SubmitLocked(const wxDirScanNodePtr& node,
+                                          size_t queue)
+{
+    m_queues[queue]->Push(node);
+    m_queued++;
+    m_workCond.Signal();
+}
+
+void wxDirParallelTraverser::Scan(const wxDirScanNodePtr& node, size_t queue)
+{
+    std::vector<wxString> dirs,
+                          files;
+
+    wxDir dir;
+    bool ok;
+    {
+        // Just as in the serial version, the errors are reported to the
+        // sink instead of being logged.
+        wxLogNull noLog;
+        ok = dir.Open(node->path);
+    }
+
+    if ( ok )
+    {
+        const wxString prefix = dir.GetNameWithSep();
+
+        wxString name;
+        for ( bool cont = dir.GetFirst(&name, wxEmptyString,
+                                       (m_flags & ~(wxDIR_FILES | wxDIR_DOTDOT))
+                                       | wxDIR_DIRS);
+              cont;
+              cont = dir.GetNext(&name) )
+        {
+            dirs.push_back(prefix + name);
+        }
+
+        if ( m_flags & wxDIR_FILES )
+        {
+            for ( bool cont = dir.GetFirst(&name, m_filespec,
+                                           m_flags & ~wxDIR_DIRS);
+                  cont;
+                  cont = dir.GetNext(&name) )
+            {
+                files.push_back(prefix + name);
+            }
+        }
+    }
+
+    std::vector<wxDirScanNodePtr> children;
+    if ( m_ordered )
+    {
+        children.reserve(dirs.size());
+        for ( size_t n = 0; n < dirs.size(); n++ )
+            children.push_back(std::make_shared<wxDirScanNode>(dirs[n]));
+    }
+
+    wxMutexLocker lock(m_mutex);
+
+    node->state = ok ? wxDirScanNode::Done : wxDirScanNode::Failed;
+    node->queue = queue;
+
+    if ( !node->cancelled )
+    {
+        node->pending = dirs.size() + files.size();
+        m_pending += node->pending;
+
+        node->dirs.swap(dirs);
+        node->files.swap(files);
+
+        if ( m_ordered )
+        {
+            // Add them in the reverse order to read the first one first.
+            for ( size_t n = children.size(); n > 0; n-- )
+                SubmitLocked(children[n - 1], queue);
+
+            node->children.swap(children);
+        }
+        else
+        {
+            m_completed.push_back(node);
+        }
+    }
+
+    m_doneCond.Broadcast();
+}
+
+bool wxDirParallelTraverser::WaitForNode(const wxDirScanNodePtr& node)
+{
+    bool claimed;
+    {
+        wxMutexLocker lock(m_mutex);
+        claimed = node->state == wxDirScanNode::Queued;
+        if ( claimed )
+            node->state = wxDirScanNode::Scanning;
+    }
+
+    // Don't wait for the worker threads if they haven't started reading this
+    // directory yet, this also ensures that we never deadlock if they're
+    // waiting for us to process the pending entries.
+    if ( claimed )
+    {
+        Scan(node, m_nextQueue);
+        m_nextQueue = (m_nextQueue + 1) % m_queues.size();
+    }
+
+    wxMutexLocker lock(m_mutex);
+    while ( node->state == wxDirScanNode::Scanning )
+        m_doneCond.Wait();
+
+    return node->state == wxDirScanNode::Done;
+}
+
+void wxDirParallelTraverser::ReleaseLocked(wxDirScanNode& node)
+{
+    const bool wasFull = m_pending > DIR_MAX_PENDING_ENTRIES;
+
+    m_pending -= node.pending;
+    node.pending = 0;
+
+    if ( wasFull && m_pending <= DIR_MAX_PENDING_ENTRIES )
+        m_workCond.Broadcast();
+
+    std::vector<wxString>().swap(node.dirs);
+    std::vector<wxString>().swap(node.files);
+}
+
+void wxDirParallelTraverser::CancelLocked(wxDirScanNode& node)
+{
+    node.cancelled = true;
+
+    ReleaseLocked(node);
+
+    for ( size_t n = 0; n < node.children.size(); n++ )
+    {
+        if ( node.children[n] )
+            CancelLocked(*node.children[n]);
+    }
+
+    node.children.clear();
+}
+
+bool wxDirParallelTraverser::OnOpenError(const wxDirScanNode& node, bool* cont)
+{
+    switch ( m_sink.OnOpenError(node.path) )
+    {
+        default:
+            wxFAIL_MSG(wxT("unexpected OnOpenError() return value") );
+            wxFALLTHROUGH;
+
+        case wxDIR_STOP:
+            *cont = false;
+            return false;
+
+        case wxDIR_IGNORE:
+            return false;
+
+        case wxDIR_CONTINUE:
+            return true;
+    }
+}
+
+bool wxDirParallelTraverser::SendFiles(const wxDirScanNode& node)
+{
+    for ( size_t n = 0; n < node.files.size(); n++ )
+    {
+        wxDirTraverseResult res = m_sink.OnFile(node.files[n]);
+        if ( res == wxDIR_STOP )
+            return false;
+
+        wxASSERT_MSG( res == wxDIR_CONTINUE,
+                      wxT("unexpected OnFile() return value") );
+
+        m_nFiles++;
+    }
+
+    return true;
+}
+
+bool wxDirParallelTraverser::WalkOrdered(const wxDirScanNodePtr& node)
+{
+    while ( !WaitForNode(node) )
+    {
+        bool cont = true;
+        if ( !OnOpenError(*node, &cont) )
+            return cont;
+
+        // Retry reading it.
+        wxMutexLocker lock(m_mutex);
+        node->state = wxDirScanNode::Queued;
+    }
+
+    // Notice that the node contents can't change any more now, so it can be
+    // accessed without locking, except for the children pointers which can
+    // be reset by CancelLocked().
+    for ( size_t n = 0; n < node->dirs.size(); n++ )
+    {
+        wxDirScanNodePtr child;
+        {
+            wxMutexLocker lock(m_mutex);
+            child = std::move(node->children[n]);
+        }
+
+        switch ( m_sink.OnDir(node->dirs[n]) )
+        {
+            default:
+                wxFAIL_MSG(wxT("unexpected OnDir() return value") );
+                wxFALLTHROUGH;
+
+            case wxDIR_STOP:
+                return false;
+
+            case wxDIR_CONTINUE:
+                if ( !WalkOrdered(child) )
+                    return false;
+                break;
+
+            case wxDIR_IGNORE:
+                {
+                    wxMutexLocker lock(m_mutex);
+                    CancelLocked(*child);
+                }
+                break;
+        }
+    }
+
+    if ( !SendFiles(*node) )
+        return false;
+
+    wxMutexLocker lock(m_mutex);
+    ReleaseLocked(*node);
+
+    return true;
+}
+
+void wxDirParallelTraverser::WalkUnordered(const wxDirScanNodePtr& root)
+{
+    // The number of directories submitted but not processed yet.
+    size_t outstanding = 1;
+    {
+        wxMutexLocker lock(m_mutex);
+        SubmitLocked(root, 0);
+    }
+
+    while ( outstanding )
+    {
+        wxDirScanNodePtr node;
+        {
+            wxMutexLocker lock(m_mutex);
+            while ( m_completed.empty() )
+                m_doneCond.Wait();
+
+            node = std::move(m_completed.front());
+            m_completed.pop_front();
+        }
+
+        outstanding--;
+
+        if ( node->state == wxDirScanNode::Failed )
+        {
+            bool cont = true;
+            if ( OnOpenError(*node, &cont) )
+            {
+                wxMutexLocker lock(m_mutex);
+                node->state = wxDirScanNode::Queued;
+                SubmitLocked(node, node->queue);
+                outstanding++;
+            }
+
+            if ( !cont )
+                return;
+
+            continue;
+        }
+
+        for ( size_t n = 0; n < node->dirs.size(); n++ )
+        {
+            switch ( m_sink.OnDir(node->dirs[n]) )
+            {
+                default:
+                    wxFAIL_MSG(wxT("unexpected OnDir() return value") );
+                    wxFALLTHROUGH;
+
+                case wxDIR_STOP:
+                    return;
+
+                case wxDIR_CONTINUE:
+                    {
+                        // Put the subdirectory into the queue of the thread
+                        // which read its parent, the other threads will
+                        // steal it from there if they're idle.
+                        wxMutexLocker lock(m_mutex);
+                        SubmitLocked(std::make_shared<wxDirScanNode>(
+                                        node->dirs[n]), node->queue);
+                    }
+                    outstanding++;
+                    break;
+
+                case wxDIR_IGNORE:
+                    break;
+            }
+        }
+
+        if ( !SendFiles(*node) )
+            return;
+
+        wxMutexLocker lock(m_mutex);
+        ReleaseLocked(*node);
+    }
+}
+
+size_t wxDirParallelTraverser::Traverse(const wxString& dirname)
+{
+    const wxDirScanNodePtr root = std::make_shared<wxDirScanNode>(dirname);
+
+    if ( m_ordered )
+        WalkOrdered(root);
+    else
+        WalkUnordered(root);
+
+    return m_nFiles;
+}
+
+#endif // wxUSE_THREADS
+
 // ----------------------------------------------------------------------------
 // wxDir::Traverse()
 // ----------------------------------------------------------------------------
@@ -100,6 +751,25 @@ size_t wxDir::Traverse(wxDirTraverser& sink,
     wxCHECK_MSG( IsOpened(), (size_t)-1,
                  wxT("dir must be opened before traversing it") );
 
+    const int parallelFlags = flags & (wxDIR_PARALLEL | wxDIR_UNORDERED);
+    flags &= ~(wxDIR_PARALLEL | wxDIR_UNORDERED);
+
+#if wxUSE_THREADS
+    // there is nothing to parallelize if we don't recurse into subdirectories
+    if ( (parallelFlags & wxDIR_PARALLEL) && (flags & wxDIR_DIRS) )
+    {
+        wxDirParallelTraverser traverser(sink, filespec, flags,
+                                         !(parallelFlags & wxDIR_UNORDERED));
+        if ( traverser.Start() )
+            return traverser.Traverse(GetName());
+
+        // fall back to the serial traversal below if we couldn't create any
+        // threads
+    }
+#else // !wxUSE_THREADS
+    wxUnusedVar(parallelFlags);
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+
     // the total number of files found
     size_t nFiles = 0;
 
@@ -23,11 +23,14 @@
     #include "wx/module.h"
 #endif //WX_PRECOMP
 
+#include "wx/sysopt.h"
+
 #include "wx/private/fdiodispatcher.h"
 
 #include "wx/private/selectdispatcher.h"
 #ifdef __UNIX__
     #include "wx/unix/private/epolldispatcher.h"
+    #include "wx/unix/private/iouringdispatcher.h"
 #endif
 
 static
@@ -42,18 +45,33 @@ wxFDIODispatcher *gs_dispatcher = nullptr;
 // ----------------------------------------------------------------------------
 
 /* static */
-wxFDIODispatcher *wxFDIODispatcher::Get()
+wxFDIODispatcher *wxFDIODispatcher::Create()
 {
-    if ( !gs_dispatcher )
-    {
+    wxFDIODispatcher *dispatcher = nullptr;
+
 #if wxUSE_EPOLL_DISPATCHER
-        gs_dispatcher = wxEpollDispatcher::Create();
-        if ( !gs_dispatcher )
+#if defined(wxHAS_IO_URING) && wxUSE_SYSTEM_OPTIONS
+    // io_uring dispatcher is only used if explicitly requested, epoll one
+    // remains the default
+    if ( wxSystemOptions::GetOptionInt("linux.io-uring") )
+        dispatcher = wxIoUringDispatcher::Create();
+    if ( !dispatcher )
+#endif // wxHAS_IO_URING && wxUSE_SYSTEM_OPTIONS
+        dispatcher = wxEpollDispatcher::Create();
+    if ( !dispatcher )
 #endif // wxUSE_EPOLL_DISPATCHER
 #if wxUSE_SELECT_DISPATCHER
-            gs_dispatcher = new wxSelectDispatcher();
+        dispatcher = new wxSelectDispatcher();
 #endif // wxUSE_SELECT_DISPATCHER
-    }
+
+    return dispatcher;
+}
+
+/* static */
+wxFDIODispatcher *wxFDIODispatcher::Get()
+{
+    if ( !gs_dispatcher )
+        gs_dispatcher = Create();
 
     wxASSERT_MSG( gs_dispatcher, "failed to create any IO dispatchers" );
 
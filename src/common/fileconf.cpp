@@ -41,6 +41,10 @@
 
 #include  "wx/stdpaths.h"
 
+#if wxUSE_THREADS
+    #include "wx/thread.h"
+#endif // wxUSE_THREADS
+
 #if defined(__WINDOWS__)
     #include "wx/msw/private.h"
 #endif  //windows.h
@@ -48,6 +52,16 @@
 #include  <stdlib.h>
 #include  <ctype.h>
 
+#ifdef __UNIX__
+  #include <sys/stat.h>
+  #include <fcntl.h>
+  #include <errno.h>
+#endif
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
 // ----------------------------------------------------------------------------
 // constants
 // ----------------------------------------------------------------------------
@@ -59,8 +73,8 @@
 // ----------------------------------------------------------------------------
 
 // compare functions for sorting the arrays
-static int LINKAGEMODE CompareEntries(wxFileConfigEntry *p1, wxFileConfigEntry *p2);
-static int LINKAGEMODE CompareGroups(wxFileConfigGroup *p1, wxFileConfigGroup *p2);
+static bool CompareEntries(wxFileConfigEntry *p1, wxFileConfigEntry *p2);
+static bool CompareGroups(wxFileConfigGroup *p1, wxFileConfigGroup *p2);
 
 // filter strings
 static wxString FilterInValue(const wxString& str);
@@ -69,23 +83,105 @@ static wxString FilterOutValue(const wxString& str);
 static wxString FilterInEntryName(const wxString& str);
 static wxString FilterOutEntryName(const wxString& str);
 
+// write the text to the local file, replacing it atomically
+static bool WriteLocalFile(const wxString& path,
+                           const wxString& text,
+                           const wxMBConv& conv,
+                           int umask);
+
+#if wxUSE_THREADS
+
+// return the permissions to use for the local file if it's created or -1 to
+// use the default permissions with the process umask applied to them
+static int GetNewLocalFileMode(int umask);
+
+// same as WriteLocalFile() but never changes the process umask and so can be
+// used from the worker threads, mode is the value returned by the function
+// above
+static bool WriteLocalFileFromThread(const wxString& path,
+                                     const wxString& text,
+                                     const wxMBConv& conv,
+                                     int mode);
+
+#endif // wxUSE_THREADS
+
 // ============================================================================
 // private classes
 // ============================================================================
 
 // ----------------------------------------------------------------------------
-// "template" array types
+// container types
 // ----------------------------------------------------------------------------
 
-#ifdef WXMAKINGDLL_BASE
-    WX_DEFINE_SORTED_USER_EXPORTED_ARRAY(wxFileConfigEntry *, ArrayEntries,
-                                         WXDLLIMPEXP_BASE);
-    WX_DEFINE_SORTED_USER_EXPORTED_ARRAY(wxFileConfigGroup *, ArrayGroups,
-                                         WXDLLIMPEXP_BASE);
+// arrays of entries and groups, sorted by name only when they're enumerated
+typedef std::vector<wxFileConfigEntry *> ArrayEntries;
+typedef std::vector<wxFileConfigGroup *> ArrayGroups;
+
+// hash and comparison functions for the names of entries and groups, which
+// take into account wxCONFIG_CASE_SENSITIVE
+struct wxFileConfigNameHash
+{
+    size_t operator()(const wxString& name) const
+    {
+        return (*this)(&name);
+    }
+
+    size_t operator()(const wxString *name) const
+    {
+#if wxCONFIG_CASE_SENSITIVE
+        return wxStringHash()(*name);
 #else
-    WX_DEFINE_SORTED_ARRAY(wxFileConfigEntry *, ArrayEntries);
-    WX_DEFINE_SORTED_ARRAY(wxFileConfigGroup *, ArrayGroups);
+        // FNV-1a hash of the lower case characters
+        size_t hash = 2166136261u;
+        for ( wxUniChar ch : *name )
+        {
+            hash ^= static_cast<wxUint32>(wxTolower(ch));
+            hash *= 16777619u;
+        }
+
+        return hash;
 #endif
+    }
+};
+
+struct wxFileConfigNameEqual
+{
+    bool operator()(const wxString& name1, const wxString& name2) const
+    {
+        return (*this)(&name1, &name2);
+    }
+
+    bool operator()(const wxString *name1, const wxString *name2) const
+    {
+#if wxCONFIG_CASE_SENSITIVE
+        return *name1 == *name2;
+#else
+        return name1->CmpNoCase(*name2) == 0;
+#endif
+    }
+};
+
+// map used to find entries or groups by name, using the pointers to the
+// names stored in the objects themselves as keys to avoid copying them
+template <typename T>
+using wxFileConfigNameMap = std::unordered_map<const wxString *, T *,
+                                               wxFileConfigNameHash,
+                                               wxFileConfigNameEqual>;
+
+// map of the names of the entries of a group in the local file to the number
+// of the line where they were found first, only used while loading it
+using wxFileConfigKeyLines = std::unordered_map<wxString, size_t,
+                                                wxFileConfigNameHash,
+                                                wxFileConfigNameEqual>;
+
+// check the line with an entry of the given group in the local file for
+// errors without parsing it, keyLines contains the keys of this group found
+// so far and pStart points to the first non-space character of the line
+static void CheckLocalEntryLine(wxFileConfigGroup *pGroup,
+                                const wxChar *pStart,
+                                size_t n,
+                                wxFileConfigKeyLines& keyLines,
+                                const wxString& bufferName);
 
 // ----------------------------------------------------------------------------
 // wxFileConfigLineList
@@ -167,10 +263,27 @@ public:
 class wxFileConfigGroup
 {
 private:
+  // range of lines of the local file containing entries of this group which
+  // were not parsed yet
+  struct PendingLines
+  {
+    wxFileConfigLineList *pFirst,   // first line of the range
+                         *pLast;    // last line of the range (inclusive)
+    size_t                nLine;    // number of the first line in the file
+  };
+
   wxFileConfig *m_pConfig;          // config object we belong to
   wxFileConfigGroup  *m_pParent;    // parent group (nullptr for root group)
   ArrayEntries  m_aEntries;         // entries in this group
   ArrayGroups   m_aSubgroups;       // subgroups
+  wxFileConfigNameMap<wxFileConfigEntry>
+                m_entriesByName;    // index of m_aEntries by name
+  wxFileConfigNameMap<wxFileConfigGroup>
+                m_subgroupsByName;  // index of m_aSubgroups by name
+  bool          m_entriesSorted,    // true if m_aEntries is sorted by name
+                m_subgroupsSorted;  // true if m_aSubgroups is sorted by name
+  std::vector<PendingLines>
+                m_pendingLines;     // lines with our entries to parse
   wxString      m_strName;          // group's name
   wxFileConfigLineList *m_pLine;    // pointer to our line in the linked list
   wxFileConfigEntry *m_pLastEntry;  // last entry/subgroup of this group in the
@@ -182,6 +295,16 @@ private:
   // used by Rename()
   void UpdateGroupAndSubgroupsLines();
 
+  // parse the lines in m_pendingLines, if any: this must be done before
+  // accessing m_aEntries or m_pLastEntry
+  void ParsePendingLines()
+  {
+    if ( !m_pendingLines.empty() )
+      DoParsePendingLines();
+  }
+
+  void DoParsePendingLines();
+
 public:
   // ctor
   wxFileConfigGroup(wxFileConfigGroup *pParent, const wxString& strName, wxFileConfig *);
@@ -194,13 +317,19 @@ public:
   wxFileConfigGroup    *Parent()  const { return m_pParent; }
   wxFileConfig   *Config()  const { return m_pConfig; }
 
-  const ArrayEntries& Entries() const { return m_aEntries;   }
-  const ArrayGroups&  Groups()  const { return m_aSubgroups; }
-  bool  IsEmpty() const { return Entries().IsEmpty() && Groups().IsEmpty(); }
+  // entries and subgroups sorted by name
+  const ArrayEntries& Entries();
+  const ArrayGroups&  Groups();
+  bool  IsEmpty()
+    { ParsePendingLines(); return m_aEntries.empty() && m_aSubgroups.empty(); }
 
   // find entry/subgroup (nullptr if not found)
   wxFileConfigGroup *FindSubgroup(const wxString& name) const;
-  wxFileConfigEntry *FindEntry   (const wxString& name) const;
+  wxFileConfigEntry *FindEntry   (const wxString& name);
+
+  // find entry among the already parsed ones only, i.e. without parsing the
+  // entries of the local file which are still pending
+  wxFileConfigEntry *FindParsedEntry(const wxString& name) const;
 
   // delete entry/subgroup, return false if doesn't exist
   bool DeleteSubgroupByName(const wxString& name);
@@ -212,6 +341,16 @@ public:
 
   void SetLine(wxFileConfigLineList *pLine);
 
+  // remember that the given lines of the local file contain our entries
+  // which will be parsed only when they're needed
+  void AddPendingLines(wxFileConfigLineList *pFirst,
+                       wxFileConfigLineList *pLast,
+                       size_t nLine)
+  {
+    PendingLines lines = { pFirst, pLast, nLine };
+    m_pendingLines.push_back(lines);
+  }
+
   // rename: no checks are done to ensure that the name is unique!
   void Rename(const wxString& newName);
 
@@ -232,6 +371,65 @@ public:
   wxDECLARE_NO_COPY_CLASS(wxFileConfigGroup);
 };
 
+#if wxUSE_THREADS
+
+// ----------------------------------------------------------------------------
+// wxFileConfigWriter: thread writing the local file in write-behind mode
+// ----------------------------------------------------------------------------
+
+class wxFileConfigWriter : public wxThread
+{
+public:
+  wxFileConfigWriter(const wxString& path,
+                     const wxMBConv& conv,
+                     int delay);
+  virtual ~wxFileConfigWriter();
+
+  void SetDelay(int delay);
+
+  // schedule writing the given text, replacing the text not written yet,
+  // mode is used only if the file doesn't exist yet
+  void Post(const wxString& text, int mode);
+
+  // write the pending text immediately and wait until it's done, return
+  // false if any write failed since the last call to this function
+  bool WaitUntilWritten();
+
+  // forget the pending text and wait until the current write, if any, ends
+  void Discard();
+
+  // ask the thread to terminate after writing the pending text, it must be
+  // waited for after calling this
+  void RequestExit();
+
+protected:
+  virtual ExitCode Entry() override;
+
+private:
+  const wxString  m_path;
+  wxMBConv *const m_conv;
+
+  // protects all the fields below
+  wxMutex     m_mutex;
+
+  // signalled whenever any of the fields below changes
+  wxCondition m_cond;
+
+  int      m_delay;     // time to wait for more changes before writing
+  wxString m_text;      // the text to write if m_hasText
+  int      m_mode;      // the permissions of the file if it's created
+  unsigned m_posted;    // incremented by each Post()
+  bool     m_hasText,   // if true, m_text must be written
+           m_busy,      // if true, the file is being written
+           m_urgent,    // if true, don't wait before writing m_text
+           m_exit,      // if true, exit after writing m_text
+           m_ok;        // false if a write failed
+
+  wxDECLARE_NO_COPY_CLASS(wxFileConfigWriter);
+};
+
+#endif // wxUSE_THREADS
+
 // ============================================================================
 // implementation
 // ============================================================================
@@ -631,6 +829,8 @@ wxFileConfig::wxFileConfig(wxInputStream &inStream, const wxMBConv& conv)
 
 void wxFileConfig::CleanUp()
 {
+    m_pathCache.clear();
+
     delete m_pRootGroup;
 
     wxFileConfigLineList *pCur = m_linesHead;
@@ -646,6 +846,9 @@ wxFileConfig::~wxFileConfig()
     if ( m_autosave )
         Flush();
 
+    // the changes flushed before must be written even if autosave is off
+    StopWriter();
+
     CleanUp();
 
     delete m_conv;
@@ -657,22 +860,34 @@ wxFileConfig::~wxFileConfig()
 
 void wxFileConfig::Parse(const wxTextBuffer& buffer, bool bLocal)
 {
+  // the lines with the entries of the current group which are only parsed
+  // when this group is accessed for the local file
+  wxFileConfigLineList *pPendingFirst = nullptr,
+                       *pPendingLast = nullptr;
+  size_t nPendingLine = 0;
+
+  // the keys of the local file found so far in each group, used to report
+  // any problems with them immediately even if they're not parsed yet
+  std::unordered_map<wxFileConfigGroup *, wxFileConfigKeyLines> keyLines;
 
   size_t nLineCount = buffer.GetLineCount();
 
   for ( size_t n = 0; n < nLineCount; n++ )
   {
-    wxString strLine = buffer[n];
+    // add the line to linked list and use the copy stored in it
+    wxString strLineGlobal;
+    if ( bLocal )
+      LineListAppend(buffer[n]);
+    else
+      strLineGlobal = buffer[n];
+
+    const wxString& strLine = bLocal ? m_linesTail->Text() : strLineGlobal;
+
     // FIXME-UTF8: rewrite using iterators
-    wxWCharBuffer buf(strLine.c_str());
+    const wxWX2WCbuf buf(strLine.wc_str());
     const wxChar *pStart;
     const wxChar *pEnd;
 
-    // add the line to linked list
-    if ( bLocal )
-      LineListAppend(strLine);
-
-
     // skip leading spaces
     for ( pStart = buf; wxIsspace(*pStart); pStart++ )
       ;
@@ -702,6 +917,14 @@ void wxFileConfig::Parse(const wxTextBuffer& buffer, bool bLocal)
         continue; // skip this line
       }
 
+      // the entries of the previous group end here
+      if ( pPendingFirst )
+      {
+        m_pCurrentGroup->AddPendingLines(pPendingFirst, pPendingLast,
+                                         nPendingLine);
+        pPendingFirst = nullptr;
+      }
+
       // group name here is always considered as abs path
       wxString strGroup;
       pStart++;
@@ -739,72 +962,162 @@ void wxFileConfig::Parse(const wxTextBuffer& buffer, bool bLocal)
         }
       }
     }
-    else {                        // a key
-      pEnd = pStart;
-      while ( *pEnd && *pEnd != wxT('=') /* && !wxIsspace(*pEnd)*/ ) {
-        if ( *pEnd == wxT('\\') ) {
-          // next character may be space or not - still take it because it's
-          // quoted (unless there is nothing)
-          pEnd++;
-          if ( !*pEnd ) {
-            // the error message will be given below anyhow
-            break;
-          }
-        }
-
-        pEnd++;
+    else if ( bLocal ) {          // a key in the local file
+      // don't parse it yet, there can be a lot of them and most of them are
+      // typically never used, so just check it for errors and remember
+      // where it is
+      CheckLocalEntryLine(m_pCurrentGroup, pStart, n,
+                          keyLines[m_pCurrentGroup], buffer.GetName());
+
+      if ( !pPendingFirst )
+      {
+        pPendingFirst = m_linesTail;
+        nPendingLine = n;
       }
 
-      wxString strKey(FilterInEntryName(wxString(pStart, pEnd).Trim()));
+      pPendingLast = m_linesTail;
+    }
+    else {                        // a key in the global file
+      ParseEntryLine(m_pCurrentGroup, strLine, n, nullptr, buffer.GetName());
+    }
+  }
 
-      // skip whitespace
-      while ( wxIsspace(*pEnd) )
-        pEnd++;
+  if ( pPendingFirst )
+    m_pCurrentGroup->AddPendingLines(pPendingFirst, pPendingLast, nPendingLine);
+}
 
-      if ( *pEnd++ != wxT('=') ) {
-        wxLogError(_("file '%s', line %zu: '=' expected."),
-                   buffer.GetName(), n + 1);
+// extract the key from the entry line starting at pStart, which must be
+// neither blank nor a comment, and return the pointer to the character after
+// it and any following whitespace in ppEnd
+static wxString ExtractEntryKey(const wxChar *pStart, const wxChar **ppEnd)
+{
+  const wxChar *pEnd = pStart;
+  while ( *pEnd && *pEnd != wxT('=') /* && !wxIsspace(*pEnd)*/ ) {
+    if ( *pEnd == wxT('\\') ) {
+      // next character may be space or not - still take it because it's
+      // quoted (unless there is nothing)
+      pEnd++;
+      if ( !*pEnd ) {
+        // the error message will be given by the caller anyhow
+        break;
       }
-      else {
-        wxFileConfigEntry *pEntry = m_pCurrentGroup->FindEntry(strKey);
+    }
 
-        if ( pEntry == nullptr ) {
-          // new entry
-          pEntry = m_pCurrentGroup->AddEntry(strKey, n);
-        }
-        else {
-          if ( bLocal && pEntry->IsImmutable() ) {
-            // immutable keys can't be changed by user
-            wxLogWarning(_("file '%s', line %zu: value for immutable key '%s' ignored."),
-                         buffer.GetName(), n + 1, strKey);
-            continue;
-          }
-          // the condition below catches the cases (a) and (b) but not (c):
-          //  (a) global key found second time in global file
-          //  (b) key found second (or more) time in local file
-          //  (c) key from global file now found in local one
-          // which is exactly what we want.
-          else if ( !bLocal || pEntry->IsLocal() ) {
-            wxLogWarning(_("file '%s', line %zu: key '%s' was first found at line %d."),
-                         buffer.GetName(), n + 1, strKey, pEntry->Line());
-
-          }
-        }
+    pEnd++;
+  }
+
+  wxString strKey(FilterInEntryName(wxString(pStart, pEnd).Trim()));
 
-        if ( bLocal )
-          pEntry->SetLine(m_linesTail);
+  // skip whitespace
+  while ( wxIsspace(*pEnd) )
+    pEnd++;
 
-        // skip whitespace
-        while ( wxIsspace(*pEnd) )
-          pEnd++;
+  *ppEnd = pEnd;
 
-        wxString value = pEnd;
-        if ( !(GetStyle() & wxCONFIG_USE_NO_ESCAPE_CHARACTERS) )
-            value = FilterInValue(value);
+  return strKey;
+}
+
+static void CheckLocalEntryLine(wxFileConfigGroup *pGroup,
+                                const wxChar *pStart,
+                                size_t n,
+                                wxFileConfigKeyLines& keyLines,
+                                const wxString& bufferName)
+{
+  const wxChar *pEnd;
+  const wxString strKey = ExtractEntryKey(pStart, &pEnd);
+
+  if ( *pEnd != wxT('=') ) {
+    wxLogError(_("file '%s', line %zu: '=' expected."),
+               bufferName, n + 1);
+    return;
+  }
+
+  // the global file is parsed before the local one, so its entries are
+  // already known
+  const wxFileConfigEntry * const pEntry = pGroup->FindParsedEntry(strKey);
+  if ( pEntry && pEntry->IsImmutable() ) {
+    // immutable keys can't be changed by user
+    wxLogWarning(_("file '%s', line %zu: value for immutable key '%s' ignored."),
+                 bufferName, n + 1, strKey);
+    return;
+  }
+
+  // only warn about the key found more than once in the local file and not
+  // about the key from the global file overridden in the local one
+  const auto ins = keyLines.insert(std::make_pair(strKey, n));
+  if ( !ins.second ) {
+    wxLogWarning(_("file '%s', line %zu: key '%s' was first found at line %d."),
+                 bufferName, n + 1, strKey, static_cast<int>(ins.first->second));
+    wxLogWarning(_("entry '%s' appears more than once in group '%s'"),
+                 strKey, pGroup->GetFullName());
+  }
+}
+
+void wxFileConfig::ParseEntryLine(wxFileConfigGroup *pGroup,
+                                  const wxString& strLine,
+                                  size_t n,
+                                  wxFileConfigLineList *pLine,
+                                  const wxString& bufferName)
+{
+  // the lines of the local file were already checked for errors when
+  // loading it by CheckLocalEntryLine(), so don't report them again
+  const bool bLocal = pLine != nullptr;
+
+  // FIXME-UTF8: rewrite using iterators
+  const wxWX2WCbuf buf(strLine.wc_str());
+  const wxChar *pStart;
+  const wxChar *pEnd;
+
+  // skip leading spaces
+  for ( pStart = buf; wxIsspace(*pStart); pStart++ )
+    ;
+
+  // skip blank/comment lines
+  if ( *pStart == wxT('\0')|| *pStart == wxT(';') || *pStart == wxT('#') )
+    return;
+
+  const wxString strKey = ExtractEntryKey(pStart, &pEnd);
+
+  if ( *pEnd++ != wxT('=') ) {
+    if ( !bLocal ) {
+      wxLogError(_("file '%s', line %zu: '=' expected."),
+                 bufferName, n + 1);
+    }
+  }
+  else {
+    wxFileConfigEntry *pEntry = pGroup->FindEntry(strKey);
+
+    if ( pEntry == nullptr ) {
+      // new entry
+      pEntry = pGroup->AddEntry(strKey, n);
+    }
+    else {
+      if ( bLocal && pEntry->IsImmutable() ) {
+        // immutable keys can't be changed by user
+        return;
+      }
+      // the condition below catches the case of the global key found second
+      // time in the global file, the keys of the local file are checked by
+      // CheckLocalEntryLine()
+      else if ( !bLocal ) {
+        wxLogWarning(_("file '%s', line %zu: key '%s' was first found at line %d."),
+                     bufferName, n + 1, strKey, pEntry->Line());
 
-        pEntry->SetValue(value, false);
       }
     }
+
+    if ( bLocal )
+      pEntry->SetLine(pLine);
+
+    // skip whitespace
+    while ( wxIsspace(*pEnd) )
+      pEnd++;
+
+    wxString value = pEnd;
+    if ( !(GetStyle() & wxCONFIG_USE_NO_ESCAPE_CHARACTERS) )
+        value = FilterInValue(value);
+
+    pEntry->SetValue(value, false);
   }
 }
 
@@ -828,17 +1141,27 @@ wxFileConfig::DoSetPath(const wxString& strPath, bool createMissingComponents)
         return true;
     }
 
-    if ( strPath[0] == wxCONFIG_PATH_SEPARATOR ) {
-        // absolute path
-        wxSplitPath(aParts, strPath);
+    // relative path must be combined with the current one
+    wxString strFullPathRel;
+    if ( strPath[0] != wxCONFIG_PATH_SEPARATOR ) {
+        strFullPathRel = m_strPath;
+        strFullPathRel << wxCONFIG_PATH_SEPARATOR << strPath;
     }
-    else {
-        // relative path, combine with current one
-        wxString strFullPath = m_strPath;
-        strFullPath << wxCONFIG_PATH_SEPARATOR << strPath;
-        wxSplitPath(aParts, strFullPath);
+
+    const wxString& strFullPath = strFullPathRel.empty() ? strPath
+                                                         : strFullPathRel;
+
+    // the same paths are typically used many times, so check if we had
+    // already resolved this one
+    const auto it = m_pathCache.find(strFullPath);
+    if ( it != m_pathCache.end() ) {
+        m_pCurrentGroup = it->second.pGroup;
+        m_strPath = it->second.strPath;
+        return true;
     }
 
+    wxSplitPath(aParts, strFullPath);
+
     // change current group
     size_t n;
     m_pCurrentGroup = m_pRootGroup;
@@ -861,6 +1184,14 @@ wxFileConfig::DoSetPath(const wxString& strPath, bool createMissingComponents)
         m_strPath << wxCONFIG_PATH_SEPARATOR << aParts[n];
     }
 
+    // don't let the cache grow indefinitely if many different paths are used
+    if ( m_pathCache.size() >= 1024 )
+        m_pathCache.clear();
+
+    CachedPath& cached = m_pathCache[strFullPath];
+    cached.pGroup = m_pCurrentGroup;
+    cached.strPath = m_strPath;
+
     return true;
 }
 
@@ -886,7 +1217,7 @@ bool wxFileConfig::GetFirstGroup(wxString& str, long& lIndex) const
 
 bool wxFileConfig::GetNextGroup (wxString& str, long& lIndex) const
 {
-    if ( size_t(lIndex) < m_pCurrentGroup->Groups().GetCount() ) {
+    if ( size_t(lIndex) < m_pCurrentGroup->Groups().size() ) {
         str = m_pCurrentGroup->Groups()[(size_t)lIndex++]->Name();
         return true;
     }
@@ -902,7 +1233,7 @@ bool wxFileConfig::GetFirstEntry(wxString& str, long& lIndex) const
 
 bool wxFileConfig::GetNextEntry (wxString& str, long& lIndex) const
 {
-    if ( size_t(lIndex) < m_pCurrentGroup->Entries().GetCount() ) {
+    if ( size_t(lIndex) < m_pCurrentGroup->Entries().size() ) {
         str = m_pCurrentGroup->Entries()[(size_t)lIndex++]->Name();
         return true;
     }
@@ -912,12 +1243,12 @@ bool wxFileConfig::GetNextEntry (wxString& str, long& lIndex) const
 
 size_t wxFileConfig::GetNumberOfEntries(bool bRecursive) const
 {
-    size_t n = m_pCurrentGroup->Entries().GetCount();
+    size_t n = m_pCurrentGroup->Entries().size();
     if ( bRecursive ) {
         wxFileConfig * const self = const_cast<wxFileConfig *>(this);
 
         wxFileConfigGroup *pOldCurrentGroup = m_pCurrentGroup;
-        size_t nSubgroups = m_pCurrentGroup->Groups().GetCount();
+        size_t nSubgroups = m_pCurrentGroup->Groups().size();
         for ( size_t nGroup = 0; nGroup < nSubgroups; nGroup++ ) {
             self->m_pCurrentGroup = m_pCurrentGroup->Groups()[nGroup];
             n += GetNumberOfEntries(true);
@@ -930,12 +1261,12 @@ size_t wxFileConfig::GetNumberOfEntries(bool bRecursive) const
 
 size_t wxFileConfig::GetNumberOfGroups(bool bRecursive) const
 {
-    size_t n = m_pCurrentGroup->Groups().GetCount();
+    size_t n = m_pCurrentGroup->Groups().size();
     if ( bRecursive ) {
         wxFileConfig * const self = const_cast<wxFileConfig *>(this);
 
         wxFileConfigGroup *pOldCurrentGroup = m_pCurrentGroup;
-        size_t nSubgroups = m_pCurrentGroup->Groups().GetCount();
+        size_t nSubgroups = m_pCurrentGroup->Groups().size();
         for ( size_t nGroup = 0; nGroup < nSubgroups; nGroup++ ) {
             self->m_pCurrentGroup = m_pCurrentGroup->Groups()[nGroup];
             n += GetNumberOfGroups(true);
@@ -1133,33 +1464,49 @@ bool wxFileConfig::Flush(bool /* bCurrentOnly */)
   if ( !IsDirty() || m_fnLocalFile.GetFullPath().empty() )
     return true;
 
-  // Create the directory containing the file if it doesn't exist. Although we
-  // don't always use XDG, it seems sensible to follow the XDG specification
-  // and create it with permissions 700 if it doesn't exist.
-  const wxString& outPath = m_fnLocalFile.GetPath();
-  if ( !wxFileName::DirExists(outPath) )
+#ifdef __UNIX__
+  const int umask = m_umask;
+#else // !__UNIX__
+  const int umask = -1;
+#endif // __UNIX__/!__UNIX__
+
+  const wxString filetext = GetLocalFileText();
+
+#if wxUSE_THREADS
+  if ( IsWriteBehindEnabled() )
   {
-      if ( !wxFileName::Mkdir(outPath,
-                              wxS_IRUSR | wxS_IWUSR | wxS_IXUSR,
-                              wxPATH_MKDIR_FULL) )
-      {
-          wxLogWarning(_("Failed to create configuration file directory."));
-          return false;
-      }
-  }
+    if ( !m_writer )
+    {
+      wxFileConfigWriter * const writer =
+        new wxFileConfigWriter(m_fnLocalFile.GetFullPath(), *m_conv,
+                               m_writeBehindDelay);
+      if ( writer->Run() == wxTHREAD_NO_ERROR )
+        m_writer = writer;
+      else // fall back to writing the file from this thread
+        delete writer;
+    }
 
-  // set the umask if needed
-  wxCHANGE_UMASK(m_umask);
+    if ( m_writer )
+    {
+      m_writer->Post(filetext, GetNewLocalFileMode(umask));
 
-  wxTempFile file(m_fnLocalFile.GetFullPath());
+      ResetDirty();
 
-  if ( !file.IsOpened() )
-  {
-    wxLogError(_("can't open user configuration file."));
-    return false;
+      return true;
+    }
   }
+#endif // wxUSE_THREADS
+
+  if ( !WriteLocalFile(m_fnLocalFile.GetFullPath(), filetext, *m_conv, umask) )
+    return false;
+
+  ResetDirty();
+
+  return true;
+}
 
-  // write all strings to file
+wxString wxFileConfig::GetLocalFileText() const
+{
   wxString filetext;
   filetext.reserve(4096);
   for ( wxFileConfigLineList *p = m_linesHead; p != nullptr; p = p->Next() )
@@ -1167,24 +1514,62 @@ bool wxFileConfig::Flush(bool /* bCurrentOnly */)
     filetext << p->Text() << wxTextFile::GetEOL();
   }
 
-  if ( !file.Write(filetext, *m_conv) )
-  {
-    wxLogError(_("can't write user configuration file."));
-    return false;
-  }
+  return filetext;
+}
 
-  if ( !file.Commit() )
-  {
-      wxLogError(_("Failed to update user configuration file."));
+// ----------------------------------------------------------------------------
+// write-behind mode
+// ----------------------------------------------------------------------------
 
-      return false;
-  }
+void wxFileConfig::EnableWriteBehind(int delay)
+{
+  wxCHECK_RET( delay >= 0, wxT("invalid write-behind delay") );
 
-  ResetDirty();
+  m_writeBehindDelay = delay;
+
+#if wxUSE_THREADS
+  if ( m_writer )
+    m_writer->SetDelay(delay);
+#endif // wxUSE_THREADS
+}
+
+void wxFileConfig::DisableWriteBehind()
+{
+  StopWriter();
+
+  m_writeBehindDelay = -1;
+}
+
+bool wxFileConfig::WaitForPendingWrites()
+{
+#if wxUSE_THREADS
+  if ( m_writer )
+    return m_writer->WaitUntilWritten();
+#endif // wxUSE_THREADS
 
   return true;
 }
 
+bool wxFileConfig::StopWriter()
+{
+  bool ok = true;
+
+#if wxUSE_THREADS
+  if ( m_writer )
+  {
+    ok = m_writer->WaitUntilWritten();
+
+    m_writer->RequestExit();
+    m_writer->Wait();
+
+    delete m_writer;
+    m_writer = nullptr;
+  }
+#endif // wxUSE_THREADS
+
+  return ok;
+}
+
 #if wxUSE_STREAMS
 
 bool wxFileConfig::Save(wxOutputStream& os, const wxMBConv& conv)
@@ -1257,6 +1642,9 @@ bool wxFileConfig::RenameGroup(const wxString& oldName,
 
     group->Rename(newName);
 
+    // the cached paths may refer to the old name
+    m_pathCache.clear();
+
     SetDirty();
 
     return true;
@@ -1280,6 +1668,7 @@ bool wxFileConfig::DeleteEntry(const wxString& key, bool bGroupIfEmptyAlso)
       wxFileConfigGroup *pGroup = m_pCurrentGroup;
       SetPath(wxT(".."));  // changes m_pCurrentGroup!
       m_pCurrentGroup->DeleteSubgroupByName(pGroup->Name());
+      m_pathCache.clear();
     }
     //else: never delete the root group
   }
@@ -1294,6 +1683,8 @@ bool wxFileConfig::DeleteGroup(const wxString& key)
   if ( !m_pCurrentGroup->DeleteSubgroupByName(path.Name()) )
       return false;
 
+  m_pathCache.clear();
+
   path.UpdateIfDeleted();
 
   SetDirty();
@@ -1303,6 +1694,12 @@ bool wxFileConfig::DeleteGroup(const wxString& key)
 
 bool wxFileConfig::DeleteAll()
 {
+#if wxUSE_THREADS
+  // don't recreate the file after deleting it below
+  if ( m_writer )
+    m_writer->Discard();
+#endif // wxUSE_THREADS
+
   CleanUp();
 
   if ( m_fnLocalFile.IsOk() )
@@ -1480,14 +1877,15 @@ bool wxFileConfig::LineListIsEmpty()
 wxFileConfigGroup::wxFileConfigGroup(wxFileConfigGroup *pParent,
                                        const wxString& strName,
                                        wxFileConfig *pConfig)
-                         : m_aEntries(CompareEntries),
-                           m_aSubgroups(CompareGroups),
-                           m_strName(strName)
+                         : m_strName(strName)
 {
   m_pConfig = pConfig;
   m_pParent = pParent;
   m_pLine   = nullptr;
 
+  m_entriesSorted =
+  m_subgroupsSorted = true;
+
   m_pLastEntry = nullptr;
   m_pLastGroup = nullptr;
 }
@@ -1496,14 +1894,64 @@ wxFileConfigGroup::wxFileConfigGroup(wxFileConfigGroup *pParent,
 wxFileConfigGroup::~wxFileConfigGroup()
 {
   // entries
-  size_t n, nCount = m_aEntries.GetCount();
-  for ( n = 0; n < nCount; n++ )
-    delete m_aEntries[n];
+  for ( wxFileConfigEntry *pEntry : m_aEntries )
+    delete pEntry;
 
   // subgroups
-  nCount = m_aSubgroups.GetCount();
-  for ( n = 0; n < nCount; n++ )
-    delete m_aSubgroups[n];
+  for ( wxFileConfigGroup *pGroup : m_aSubgroups )
+    delete pGroup;
+}
+
+// ----------------------------------------------------------------------------
+// deferred parsing
+// ----------------------------------------------------------------------------
+
+void wxFileConfigGroup::DoParsePendingLines()
+{
+  // take the lines first as parsing them uses FindEntry() which calls us
+  std::vector<PendingLines> pendingLines;
+  pendingLines.swap(m_pendingLines);
+
+  const wxString& bufferName = m_pConfig->m_fnLocalFile.GetFullPath();
+  for ( const PendingLines& lines : pendingLines )
+  {
+    size_t n = lines.nLine;
+    for ( wxFileConfigLineList *pLine = lines.pFirst; ; pLine = pLine->Next() )
+    {
+      m_pConfig->ParseEntryLine(this, pLine->Text(), n++, pLine, bufferName);
+
+      if ( pLine == lines.pLast )
+        break;
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+// accessors
+// ----------------------------------------------------------------------------
+
+const ArrayEntries& wxFileConfigGroup::Entries()
+{
+  ParsePendingLines();
+
+  if ( !m_entriesSorted )
+  {
+    std::sort(m_aEntries.begin(), m_aEntries.end(), CompareEntries);
+    m_entriesSorted = true;
+  }
+
+  return m_aEntries;
+}
+
+const ArrayGroups& wxFileConfigGroup::Groups()
+{
+  if ( !m_subgroupsSorted )
+  {
+    std::sort(m_aSubgroups.begin(), m_aSubgroups.end(), CompareGroups);
+    m_subgroupsSorted = true;
+  }
+
+  return m_aSubgroups;
 }
 
 // ----------------------------------------------------------------------------
@@ -1620,6 +2068,9 @@ wxFileConfigLineList *wxFileConfigGroup::GetLastEntryLine()
                 wxT("  GetLastEntryLine() for Group '%s'"),
                 Name() );
 
+    // m_pLastEntry is only set when the entries are parsed
+    ParsePendingLines();
+
     if ( m_pLastEntry )
     {
         wxFileConfigLineList    *pLine = m_pLastEntry->GetLine();
@@ -1664,10 +2115,9 @@ void wxFileConfigGroup::UpdateGroupAndSubgroupsLines()
 
 
     // also update all subgroups as they have this groups name in their lines
-    const size_t nCount = m_aSubgroups.GetCount();
-    for ( size_t n = 0; n < nCount; n++ )
+    for ( wxFileConfigGroup *pGroup : m_aSubgroups )
     {
-        m_aSubgroups[n]->UpdateGroupAndSubgroupsLines();
+        pGroup->UpdateGroupAndSubgroupsLines();
     }
 }
 
@@ -1678,13 +2128,15 @@ void wxFileConfigGroup::Rename(const wxString& newName)
     if ( newName == m_strName )
         return;
 
-    // we need to remove the group from the parent and it back under the new
-    // name to keep the parents array of subgroups alphabetically sorted
-    m_pParent->m_aSubgroups.Remove(this);
+    // we need to remove the group from the parent index and add it back
+    // under the new name, and the parent array of subgroups is not sorted
+    // alphabetically any more
+    m_pParent->m_subgroupsByName.erase(&m_strName);
 
     m_strName = newName;
 
-    m_pParent->m_aSubgroups.Add(this);
+    m_pParent->m_subgroupsByName[&m_strName] = this;
+    m_pParent->m_subgroupsSorted = false;
 
     // update the group lines recursively
     UpdateGroupAndSubgroupsLines();
@@ -1703,67 +2155,26 @@ wxString wxFileConfigGroup::GetFullName() const
 // find an item
 // ----------------------------------------------------------------------------
 
-// use binary search because the array is sorted
 wxFileConfigEntry *
-wxFileConfigGroup::FindEntry(const wxString& name) const
-{
-  size_t
-       lo = 0,
-       hi = m_aEntries.GetCount();
-  wxFileConfigEntry *pEntry;
-
-  while ( lo < hi ) {
-    size_t i;
-    i = (lo + hi)/2;
-    pEntry = m_aEntries[i];
-
-    int res;
-    #if wxCONFIG_CASE_SENSITIVE
-      res = pEntry->Name().compare(name);
-    #else
-      res = pEntry->Name().CmpNoCase(name);
-    #endif
-
-    if ( res > 0 )
-      hi = i;
-    else if ( res < 0 )
-      lo = i + 1;
-    else
-      return pEntry;
-  }
+wxFileConfigGroup::FindEntry(const wxString& name)
+{
+  ParsePendingLines();
 
-  return nullptr;
+  return FindParsedEntry(name);
+}
+
+wxFileConfigEntry *
+wxFileConfigGroup::FindParsedEntry(const wxString& name) const
+{
+  const auto it = m_entriesByName.find(&name);
+  return it == m_entriesByName.end() ? nullptr : it->second;
 }
 
 wxFileConfigGroup *
 wxFileConfigGroup::FindSubgroup(const wxString& name) const
 {
-  size_t
-       lo = 0,
-       hi = m_aSubgroups.GetCount();
-  wxFileConfigGroup *pGroup;
-
-  while ( lo < hi ) {
-    size_t i;
-    i = (lo + hi)/2;
-    pGroup = m_aSubgroups[i];
-
-    int res;
-    #if wxCONFIG_CASE_SENSITIVE
-      res = pGroup->Name().compare(name);
-    #else
-      res = pGroup->Name().CmpNoCase(name);
-    #endif
-
-    if ( res > 0 )
-      hi = i;
-    else if ( res < 0 )
-      lo = i + 1;
-    else
-      return pGroup;
-  }
-
-  return nullptr;
+  const auto it = m_subgroupsByName.find(&name);
+  return it == m_subgroupsByName.end() ? nullptr : it->second;
 }
 
 // ----------------------------------------------------------------------------
@@ -1777,7 +2188,9 @@ wxFileConfigEntry *wxFileConfigGroup::AddEntry(const wxString& strName, int nLin
 
     wxFileConfigEntry   *pEntry = new wxFileConfigEntry(this, strName, nLine);
 
-    m_aEntries.Add(pEntry);
+    m_aEntries.push_back(pEntry);
+    m_entriesByName[&pEntry->Name()] = pEntry;
+    m_entriesSorted = false;
     return pEntry;
 }
 
@@ -1788,7 +2201,9 @@ wxFileConfigGroup *wxFileConfigGroup::AddSubgroup(const wxString& strName)
 
     wxFileConfigGroup   *pGroup = new wxFileConfigGroup(this, strName, m_pConfig);
 
-    m_aSubgroups.Add(pGroup);
+    m_aSubgroups.push_back(pGroup);
+    m_subgroupsByName[&pGroup->Name()] = pGroup;
+    m_subgroupsSorted = false;
     return pGroup;
 }
 
@@ -1831,8 +2246,12 @@ bool wxFileConfigGroup::DeleteSubgroup(wxFileConfigGroup *pGroup)
                 m_pLine ? m_pLine->Text()
                         : wxString() );
 
+    // the lines of the entries of this group must be removed too, so we need
+    // to know which of them they are
+    pGroup->ParsePendingLines();
+
     // delete all entries...
-    size_t nCount = pGroup->m_aEntries.GetCount();
+    size_t nCount = pGroup->m_aEntries.size();
 
     wxLogTrace(FILECONF_TRACE_MASK,
                wxT("Removing %lu entries"), (unsigned long)nCount );
@@ -1851,7 +2270,7 @@ bool wxFileConfigGroup::DeleteSubgroup(wxFileConfigGroup *pGroup)
     }
 
     // ...and subgroups of this subgroup
-    nCount = pGroup->m_aSubgroups.GetCount();
+    nCount = pGroup->m_aSubgroups.size();
 
     wxLogTrace( FILECONF_TRACE_MASK,
                 wxT("Removing %lu subgroups"), (unsigned long)nCount );
@@ -1885,7 +2304,7 @@ bool wxFileConfigGroup::DeleteSubgroup(wxFileConfigGroup *pGroup)
             // our last entry is being deleted, so find the last one which
             // stays by going back until we find a subgroup or reach the
             // group line
-            const size_t nSubgroups = m_aSubgroups.GetCount();
+            const size_t nSubgroups = m_aSubgroups.size();
 
             m_pLastGroup = nullptr;
             for ( wxFileConfigLineList *pl = pLine->Prev();
@@ -1918,7 +2337,9 @@ bool wxFileConfigGroup::DeleteSubgroup(wxFileConfigGroup *pGroup)
                     pGroup->Name() );
     }
 
-    m_aSubgroups.Remove(pGroup);
+    m_subgroupsByName.erase(&pGroup->m_strName);
+    m_aSubgroups.erase(std::find(m_aSubgroups.begin(), m_aSubgroups.end(),
+                                 pGroup));
     delete pGroup;
 
     return true;
@@ -1945,7 +2366,7 @@ bool wxFileConfigGroup::DeleteEntry(const wxString& name)
       wxFileConfigEntry *pNewLast = nullptr;
       const wxFileConfigLineList * const
         pNewLastLine = m_pLastEntry->GetLine()->Prev();
-      const size_t nEntries = m_aEntries.GetCount();
+      const size_t nEntries = m_aEntries.size();
       for ( size_t n = 0; n < nEntries; n++ ) {
         if ( m_aEntries[n]->GetLine() == pNewLastLine ) {
           pNewLast = m_aEntries[n];
@@ -1966,7 +2387,8 @@ bool wxFileConfigGroup::DeleteEntry(const wxString& name)
     m_pConfig->LineListRemove(pLine);
   }
 
-  m_aEntries.Remove(pEntry);
+  m_entriesByName.erase(&pEntry->Name());
+  m_aEntries.erase(std::find(m_aEntries.begin(), m_aEntries.end(), pEntry));
   delete pEntry;
 
   return true;
@@ -2003,11 +2425,8 @@ wxFileConfigEntry::wxFileConfigEntry(wxFileConfigGroup *pParent,
 
 void wxFileConfigEntry::SetLine(wxFileConfigLineList *pLine)
 {
-  if ( m_pLine != nullptr ) {
-    wxLogWarning(_("entry '%s' appears more than once in group '%s'"),
-                 Name(), m_pParent->GetFullName());
-  }
-
+  // the entries appearing more than once in the local file were already
+  // reported when loading it by CheckLocalEntryLine()
   m_pLine = pLine;
   Group()->SetLastEntry(this);
 }
@@ -2065,6 +2484,148 @@ void wxFileConfigEntry::SetValue(const wxString& strValue, bool bUser)
     }
 }
 
+#if wxUSE_THREADS
+
+// ============================================================================
+// wxFileConfigWriter
+// ============================================================================
+
+// the maximal number of delays to wait for if the changes keep coming, so
+// that they're still written in a reasonable time
+static const int MAX_WRITE_DELAYS = 4;
+
+wxFileConfigWriter::wxFileConfigWriter(const wxString& path,
+                                       const wxMBConv& conv,
+                                       int delay)
+                  : wxThread(wxTHREAD_JOINABLE),
+                    m_path(path),
+                    m_conv(conv.Clone()),
+                    m_cond(m_mutex),
+                    m_delay(delay)
+{
+  m_mode = -1;
+  m_posted = 0;
+  m_hasText =
+  m_busy =
+  m_urgent =
+  m_exit = false;
+  m_ok = true;
+}
+
+wxFileConfigWriter::~wxFileConfigWriter()
+{
+  delete m_conv;
+}
+
+void wxFileConfigWriter::SetDelay(int delay)
+{
+  wxMutexLocker lock(m_mutex);
+
+  m_delay = delay;
+}
+
+void wxFileConfigWriter::Post(const wxString& text, int mode)
+{
+  wxMutexLocker lock(m_mutex);
+
+  m_text = text;
+  m_mode = mode;
+  m_hasText = true;
+  m_posted++;
+
+  m_cond.Broadcast();
+}
+
+bool wxFileConfigWriter::WaitUntilWritten()
+{
+  wxMutexLocker lock(m_mutex);
+
+  m_urgent = true;
+  m_cond.Broadcast();
+
+  while ( m_hasText || m_busy )
+    m_cond.Wait();
+
+  m_urgent = false;
+
+  const bool ok = m_ok;
+  m_ok = true;
+
+  return ok;
+}
+
+void wxFileConfigWriter::Discard()
+{
+  wxMutexLocker lock(m_mutex);
+
+  m_text.clear();
+  m_hasText = false;
+  m_cond.Broadcast();
+
+  while ( m_busy )
+    m_cond.Wait();
+}
+
+void wxFileConfigWriter::RequestExit()
+{
+  wxMutexLocker lock(m_mutex);
+
+  m_exit = true;
+  m_cond.Broadcast();
+}
+
+wxThread::ExitCode wxFileConfigWriter::Entry()
+{
+  wxMutexLocker lock(m_mutex);
+
+  for ( ;; )
+  {
+    if ( !m_hasText )
+    {
+      if ( m_exit )
+        break;
+
+      m_cond.Wait();
+      continue;
+    }
+
+    // wait until no more changes are posted during the delay, as we are
+    // woken up by each of them
+    for ( int n = 0; n < MAX_WRITE_DELAYS && !m_urgent && !m_exit; n++ )
+    {
+      const unsigned posted = m_posted;
+      m_cond.WaitTimeout(m_delay);
+      if ( m_posted == posted )
+        break;
+    }
+
+    // the text could have been discarded while we waited
+    if ( !m_hasText )
+      continue;
+
+    wxString text;
+    text.swap(m_text);
+    m_hasText = false;
+    m_busy = true;
+
+    const int mode = m_mode;
+
+    m_mutex.Unlock();
+    const bool ok = WriteLocalFileFromThread(m_path, text, *m_conv, mode);
+    m_mutex.Lock();
+
+    if ( !ok )
+      m_ok = false;
+    m_busy = false;
+
+    m_cond.Broadcast();
+  }
+
+  return nullptr;
+}
+
+#endif // wxUSE_THREADS
+
 // ============================================================================
 // global functions
 // ============================================================================
@@ -2073,21 +2634,21 @@ void wxFileConfigEntry::SetValue(const wxString& strValue, bool bUser)
 // compare functions for array sorting
 // ----------------------------------------------------------------------------
 
-int CompareEntries(wxFileConfigEntry *p1, wxFileConfigEntry *p2)
+bool CompareEntries(wxFileConfigEntry *p1, wxFileConfigEntry *p2)
 {
 #if wxCONFIG_CASE_SENSITIVE
-    return p1->Name().compare(p2->Name());
+    return p1->Name().compare(p2->Name()) < 0;
 #else
-    return p1->Name().CmpNoCase(p2->Name());
+    return p1->Name().CmpNoCase(p2->Name()) < 0;
 #endif
 }
 
-int CompareGroups(wxFileConfigGroup *p1, wxFileConfigGroup *p2)
+bool CompareGroups(wxFileConfigGroup *p1, wxFileConfigGroup *p2)
 {
 #if wxCONFIG_CASE_SENSITIVE
-    return p1->Name().compare(p2->Name());
+    return p1->Name().compare(p2->Name()) < 0;
 #else
-    return p1->Name().CmpNoCase(p2->Name());
+    return p1->Name().CmpNoCase(p2->Name()) < 0;
 #endif
 }
 
@@ -2255,4 +2816,173 @@ static wxString FilterOutEntryName(const wxString& str)
   return strResult;
 }
 
+// ----------------------------------------------------------------------------
+// writing the local file
+// ----------------------------------------------------------------------------
+
+// create the directory containing the local file if it doesn't exist
+static bool CreateLocalFileDir(const wxString& path)
+{
+  // Although we don't always use XDG, it seems sensible to follow the XDG
+  // specification and create it with permissions 700 if it doesn't exist.
+  const wxString outPath = wxFileName(path).GetPath();
+  if ( !wxFileName::DirExists(outPath) )
+  {
+      if ( !wxFileName::Mkdir(outPath,
+                              wxS_IRUSR | wxS_IWUSR | wxS_IXUSR,
+                              wxPATH_MKDIR_FULL) )
+      {
+          wxLogWarning(_("Failed to create configuration file directory."));
+          return false;
+      }
+  }
+
+  return true;
+}
+
+static bool WriteLocalFile(const wxString& path,
+                           const wxString& text,
+                           const wxMBConv& conv,
+                           int umask)
+{
+  if ( !CreateLocalFileDir(path) )
+    return false;
+
+  // set the umask if needed
+#ifdef __UNIX__
+  wxCHANGE_UMASK(umask);
+#else // !__UNIX__
+  wxUnusedVar(umask);
+#endif // __UNIX__/!__UNIX__
+
+  wxTempFile file(path);
+
+  if ( !file.IsOpened() )
+  {
+    wxLogError(_("can't open user configuration file."));
+    return false;
+  }
+
+  if ( !file.Write(text, conv) )
+  {
+    wxLogError(_("can't write user configuration file."));
+    return false;
+  }
+
+  if ( !file.Commit() )
+  {
+      wxLogError(_("Failed to update user configuration file."));
+
+      return false;
+  }
+
+  return true;
+}
+
+#if wxUSE_THREADS
+
+static int GetNewLocalFileMode(int umask)
+{
+#ifdef __UNIX__
+  // don't query the process umask here, as this can only be done by changing
+  // it, which would affect the files created by the other threads, but let
+  // the system apply it when creating the file instead
+  if ( umask == -1 )
+    return -1;
+
+  return 0666 & ~umask;
+#else // !__UNIX__
+  wxUnusedVar(umask);
+
+  return -1;
+#endif // __UNIX__/!__UNIX__
+}
+
+#ifdef __UNIX__
+
+// create a new temporary file in the same directory as the given one with the
+// given permissions, modified by the process umask
+static wxString CreateLocalTempFile(const wxString& path, int perms, wxFile& file)
+{
+  for ( unsigned n = 0; n < 1000; n++ )
+  {
+    const wxString
+      pathTemp = wxString::Format("%s.%lu.%u.tmp", path, wxGetProcessId(), n);
+
+    const int fd = wxOpen(pathTemp, O_WRONLY | O_CREAT | O_EXCL, perms);
+    if ( fd != -1 )
+    {
+      file.Attach(fd);
+      return pathTemp;
+    }
+
+    // try another name if the file already exists, this can only happen if
+    // another thread is writing the same file right now
+    if ( errno != EEXIST )
+      break;
+  }
+
+  return wxString();
+}
+
+#endif // __UNIX__
+
+static bool WriteLocalFileFromThread(const wxString& path,
+                                     const wxString& text,
+                                     const wxMBConv& conv,
+                                     int mode)
+{
+  if ( !CreateLocalFileDir(path) )
+    return false;
+
+  // we can't use wxTempFile here as it changes the umask, which affects all
+  // threads, if the file doesn't exist yet, so do the same thing manually
+  wxFile file;
+#ifdef __UNIX__
+  // preserve the permissions of the existing file
+  wxStructStat st;
+  if ( wxStat(path, &st) == 0 )
+    mode = st.st_mode & 07777;
+
+  // if we don't need any specific permissions, just create the file with the
+  // default ones, to which the system applies the process umask, otherwise
+  // only allow the owner to access it until we change them below
+  const wxString
+    pathTemp = CreateLocalTempFile(path, mode == -1 ? 0666 : 0600, file);
+#else // !__UNIX__
+  wxUnusedVar(mode);
+
+  const wxString pathTemp = wxFileName::CreateTempFileName(path, &file);
+#endif // __UNIX__/!__UNIX__
+
+  if ( pathTemp.empty() )
+  {
+    wxLogError(_("can't open user configuration file."));
+    return false;
+  }
+
+#ifdef __UNIX__
+  if ( mode != -1 && fchmod(file.fd(), mode) == -1 )
+    wxLogSysError(_("Failed to set temporary file permissions"));
+#endif // __UNIX__
+
+  if ( !file.Write(text, conv) || !file.Close() )
+  {
+    wxLogError(_("can't write user configuration file."));
+    wxRemoveFile(pathTemp);
+    return false;
+  }
+
+  if ( !wxRenameFile(pathTemp, path) )
+  {
+    wxLogError(_("Failed to update user configuration file."));
+    wxRemoveFile(pathTemp);
+    return false;
+  }
+
+  return true;
+}
+
+#endif // wxUSE_THREADS
+
 #endif // wxUSE_CONFIG
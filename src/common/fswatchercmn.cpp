@@ -121,6 +121,15 @@ wxFileSystemWatcherBase::AddAny(const wxFileName& path,
     if (canonical.IsEmpty())
         return false;
 
+    return AddCanonical(canonical, events, type, filespec);
+}
+
+bool
+wxFileSystemWatcherBase::AddCanonical(const wxString& canonical,
+                                      int events,
+                                      wxFSWPathType type,
+                                      const wxString& filespec)
+{
     // Check if the patch isn't already being watched.
     wxFSWatchInfoMap::iterator it = m_watches.find(canonical);
     if ( it == m_watches.end() )
@@ -196,8 +205,11 @@ bool wxFileSystemWatcherBase::AddTree(const wxFileName& path, int events,
 
         virtual wxDirTraverseResult OnDir(const wxString& dirname) override
         {
-            if ( m_watcher->AddAny(wxFileName::DirName(dirname),
-                                   m_events, wxFSWPath_Tree, m_filespec) )
+            // As we traverse the canonical path of the tree root, the paths
+            // of its subdirectories are canonical too, so avoid the expensive
+            // (compared to the rest of what we do here) canonicalization.
+            if ( m_watcher->AddCanonical(dirname + wxFILE_SEP_PATH,
+                                         m_events, wxFSWPath_Tree, m_filespec) )
             {
                 wxLogTrace(wxTRACE_FSWATCHER,
                    "--- AddTree adding directory '%s' ---", dirname);
@@ -211,7 +223,11 @@ bool wxFileSystemWatcherBase::AddTree(const wxFileName& path, int events,
         wxString m_filespec;
     };
 
-    wxDir dir(path.GetFullPath());
+    const wxString canonical = GetCanonicalPath(path);
+    if (canonical.IsEmpty())
+        return false;
+
+    wxDir dir(canonical);
     // Prevent asserts or infinite loops in trees containing symlinks
     int flags = wxDIR_DIRS | wxDIR_HIDDEN;
     if ( !path.ShouldFollowLink() )
@@ -222,7 +238,7 @@ bool wxFileSystemWatcherBase::AddTree(const wxFileName& path, int events,
     dir.Traverse(traverser, filespec, flags);
 
     // Add the path itself explicitly as Traverse() doesn't return it.
-    AddAny(path.GetPathWithSep(), events, wxFSWPath_Tree, filespec);
+    AddCanonical(canonical, events, wxFSWPath_Tree, filespec);
 
     return true;
 }
@@ -298,6 +314,13 @@ bool wxFileSystemWatcherBase::RemoveTree(const wxFileName& path)
     return true;
 }
 
+bool wxFileSystemWatcherBase::SetCoalescingInterval(int milliseconds)
+{
+    wxCHECK_MSG( milliseconds >= 0, false, "invalid coalescing interval" );
+
+    return m_service && m_service->SetCoalescingInterval(milliseconds);
+}
+
 bool wxFileSystemWatcherBase::RemoveAll()
 {
     const bool ret = m_service->RemoveAll();
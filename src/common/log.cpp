@@ -42,6 +42,14 @@
 
 #include "wx/private/log.h"
 
+#if wxUSE_THREADS
+    #include "wx/sharedptr.h"
+
+    #include <algorithm>
+    #include <atomic>
+    #include <vector>
+#endif // wxUSE_THREADS
+
 // other standard headers
 #include <errno.h>
 
@@ -373,8 +381,12 @@ wxLog::OnLog(wxLogLevel level,
         {
             if ( ms_pLogger )
             {
-                // buffer the messages until they can be shown from the main
-                // thread
+                // MT-safe log targets can handle the message directly
+                if ( ms_pLogger->DoLogThreadRecord(level, msg, info) )
+                    return;
+
+                // otherwise buffer the messages until they can be shown from
+                // the main thread
                 wxCriticalSectionLocker lock(GetBackgroundLogCS());
 
                 gs_bufferedLogRecords.push_back(wxLogRecord(level, msg, info));
@@ -401,6 +413,45 @@ wxLog::OnLog(wxLogLevel level,
     logger->CallDoLogNow(level, msg, info);
 }
 
+namespace
+{
+
+// add the extra information passed by wxLogXXX() functions to the message,
+// return false, without changing the output parameter, if there is none
+bool DecorateLogMessage(wxLogLevel level,
+                        const wxString& msg,
+                        const wxLogRecordInfo& info,
+                        wxString* decorated)
+{
+    wxString prefix, suffix;
+    wxUIntPtr num = 0;
+    if ( info.GetNumValue(wxLOG_KEY_SYS_ERROR_CODE, &num) )
+    {
+        const long err = static_cast<long>(num);
+
+        suffix.Printf(_(" (error %ld: %s)"), err, wxSysErrorMsgStr(err));
+    }
+
+#if wxUSE_LOG_TRACE
+    wxString str;
+    if ( level == wxLOG_Trace && info.GetStrValue(wxLOG_KEY_TRACE_MASK, &str) )
+    {
+        prefix = "(" + str + ") ";
+    }
+#else // !wxUSE_LOG_TRACE
+    wxUnusedVar(level);
+#endif // wxUSE_LOG_TRACE
+
+    if ( prefix.empty() && suffix.empty() )
+        return false;
+
+    *decorated = prefix + msg + suffix;
+
+    return true;
+}
+
+} // anonymous namespace
+
 void
 wxLog::CallDoLogNow(wxLogLevel level,
                     const wxString& msg,
@@ -426,24 +477,11 @@ wxLog::CallDoLogNow(wxLogLevel level,
     }
 
     // handle extra data which may be passed to us by wxLogXXX()
-    wxString prefix, suffix;
-    wxUIntPtr num = 0;
-    if ( info.GetNumValue(wxLOG_KEY_SYS_ERROR_CODE, &num) )
-    {
-        const long err = static_cast<long>(num);
-
-        suffix.Printf(_(" (error %ld: %s)"), err, wxSysErrorMsgStr(err));
-    }
-
-#if wxUSE_LOG_TRACE
-    wxString str;
-    if ( level == wxLOG_Trace && info.GetStrValue(wxLOG_KEY_TRACE_MASK, &str) )
-    {
-        prefix = "(" + str + ") ";
-    }
-#endif // wxUSE_LOG_TRACE
-
-    DoLogRecord(level, prefix + msg + suffix, info);
+    wxString decorated;
+    if ( DecorateLogMessage(level, msg, info, &decorated) )
+        DoLogRecord(level, decorated, info);
+    else
+        DoLogRecord(level, msg, info);
 }
 
 void wxLog::DoLogRecord(wxLogLevel level,
@@ -985,6 +1023,589 @@ wxLogInterposerTemp::wxLogInterposerTemp()
     #pragma warning(default:4355)
 #endif // VC++
 
+#if wxUSE_THREADS
+
+// ----------------------------------------------------------------------------
+// wxLogAsync
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Fixed size circular buffer of the messages logged by a single thread: as
+// messages are only added to it by this thread and only removed from it by
+// the worker thread, it doesn't need any locking.
+class wxLogAsyncBuffer
+{
+public:
+    struct Record
+    {
+        wxLogLevel level = wxLOG_Info;
+        wxString msg;
+        wxLogRecordInfo info;
+    };
+
+    explicit wxLogAsyncBuffer(size_t size)
+    {
+        // Use power of 2 size to allow using masking instead of modulo.
+        size_t capacity = 1;
+        while ( capacity < size )
+            capacity <<= 1;
+
+        m_records.resize(capacity);
+        m_mask = capacity - 1;
+    }
+
+    size_t GetCapacity() const { return m_mask + 1; }
+
+    // Called by the owning thread only, returns the number of records in the
+    // buffer after adding this one or 0 if the buffer is full.
+    size_t Push(wxLogLevel level, const wxString& msg, const wxLogRecordInfo& info)
+    {
+        const size_t head = m_head.value.load(std::memory_order_relaxed);
+        const size_t used = head - m_tail.value.load(std::memory_order_acquire);
+        if ( used > m_mask )
+            return 0;
+
+        // Note that assigning to the existing record reuses the memory
+        // already allocated for its message if possible.
+        Record& rec = m_records[head & m_mask];
+        rec.level = level;
+        rec.msg = msg;
+        rec.info = info;
+
+        m_head.value.store(head + 1, std::memory_order_release);
+
+        return used + 1;
+    }
+
+    // Called when the owning thread won't use this buffer any more.
+    void Abandon() { m_abandoned.store(true, std::memory_order_release); }
+
+
+    // All the other functions are called by the worker thread only.
+    bool IsAbandoned() const
+    {
+        return m_abandoned.load(std::memory_order_acquire);
+    }
+
+    size_t GetHead() const { return m_head.value.load(std::memory_order_acquire); }
+    size_t GetTail() const { return m_tail.value.load(std::memory_order_relaxed); }
+
+    const Record& Get(size_t pos) const { return m_records[pos & m_mask]; }
+
+    // Make all records before the given position available for reuse.
+    void Release(size_t pos) { m_tail.value.store(pos, std::memory_order_release); }
+
+private:
+    std::vector<Record> m_records;
+    size_t m_mask;
+
+    // The positions of the next record to write and to read are modified by
+    // different threads, so put them into different cache lines to avoid
+    // false sharing.
+    struct Position
+    {
+        std::atomic<size_t> value{0};
+        char padding[64 - sizeof(std::atomic<size_t>)];
+    };
+
+    Position m_head;
+    Position m_tail;
+
+    std::atomic<bool> m_abandoned{false};
+
+    wxDECLARE_NO_COPY_CLASS(wxLogAsyncBuffer);
+};
+
+// The buffer used by the current thread and the serial number of the
+// wxLogAsyncImpl it is used with.
+struct wxLogAsyncThreadBuffer
+{
+    ~wxLogAsyncThreadBuffer()
+    {
+        // The worker thread will free the buffer once it's empty.
+        if ( buffer )
+            buffer->Abandon();
+    }
+
+    unsigned long owner = 0;
+    wxSharedPtr<wxLogAsyncBuffer> buffer;
+
+    // Same as buffer.get(), but cheaper to access.
+    wxLogAsyncBuffer* ptr = nullptr;
+};
+
+thread_local wxLogAsyncThreadBuffer wxPerThreadAsyncLogBuffer;
+
+// Serial numbers are used instead of pointers to identify wxLogAsyncImpl
+// objects as a new object could be allocated at the address of a deleted one.
+std::atomic<unsigned long> gs_lastAsyncLogSerial{0};
+
+} // anonymous namespace
+
+class wxLogAsyncImpl : public wxThread
+{
+public:
+    wxLogAsyncImpl(wxLog *target,
+                   size_t bufferSize,
+                   wxLogAsync::OverflowPolicy policy)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_target(target),
+          m_bufferSize(bufferSize ? bufferSize : 1),
+          m_policy(policy),
+          m_serial(++gs_lastAsyncLogSerial),
+          m_condWork(m_mutex),
+          m_condSpace(m_mutex),
+          m_condFlushed(m_mutex)
+    {
+    }
+
+    virtual ~wxLogAsyncImpl()
+    {
+        delete m_target;
+    }
+
+    void Start()
+    {
+        // If the thread can't be created, we just pass all messages to the
+        // target synchronously.
+        m_running = Run() == wxTHREAD_NO_ERROR;
+    }
+
+    void Stop()
+    {
+        if ( m_running )
+        {
+            {
+                wxMutexLocker lock(m_mutex);
+                m_exit = true;
+                m_condWork.Signal();
+                m_condSpace.Broadcast();
+                m_condFlushed.Broadcast();
+            }
+
+            Wait();
+
+            m_running = false;
+        }
+
+        // Process the messages logged while the thread was exiting, if any.
+        ProcessPending();
+    }
+
+    wxLog *GetTarget() const { return m_target; }
+
+    unsigned long GetDroppedCount() const
+    {
+        return m_numDropped.load(std::memory_order_relaxed);
+    }
+
+    void Log(wxLogLevel level, const wxString& msg, const wxLogRecordInfo& info)
+    {
+        if ( !m_running )
+        {
+            wxCriticalSectionLocker lock(m_targetCS);
+            m_target->LogRecord(level, msg, info);
+            return;
+        }
+
+        wxLogAsyncBuffer* const buffer = GetThreadBuffer();
+        const size_t used = buffer->Push(level, msg, info);
+        if ( !used )
+        {
+            if ( m_policy != wxLogAsync::Overflow_Block ||
+                    !WaitForSpace(buffer, level, msg, info) )
+            {
+                m_numDropped.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        // Don't let the worker thread wait for more messages if the buffer
+        // is getting full.
+        WakeUp(used == buffer->GetCapacity() / 2 + 1);
+    }
+
+    void Flush()
+    {
+        // Don't wait if all the messages have been already processed, as this
+        // function is called often, e.g. on every idle event in GUI programs.
+        if ( m_running && GetCurrentId() != GetId() && HasPending() )
+        {
+            wxMutexLocker lock(m_mutex);
+
+            const unsigned long flushRequested = ++m_flushRequested;
+
+            m_urgent = true;
+            m_signalled.store(true);
+            m_condWork.Signal();
+
+            while ( m_flushDone != flushRequested && !m_exit )
+                m_condFlushed.Wait();
+        }
+
+        wxCriticalSectionLocker lock(m_targetCS);
+        m_target->Flush();
+    }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        for ( ;; )
+        {
+            // Wait a little before processing the messages to process more of
+            // them at once instead of waking up for every one of them.
+            {
+                wxMutexLocker lock(m_mutex);
+                if ( !m_urgent && !m_exit && m_flushRequested == m_flushDone )
+                    m_condWork.WaitTimeout(BATCH_DELAY);
+
+                m_urgent = false;
+            }
+
+            // This must be done before checking for the new messages, see
+            // WakeUp().
+            m_signalled.store(false, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            unsigned long flushRequested;
+            bool exit;
+            {
+                wxMutexLocker lock(m_mutex);
+                flushRequested = m_flushRequested;
+                exit = m_exit;
+            }
+
+            ProcessPending();
+
+            wxMutexLocker lock(m_mutex);
+            if ( m_flushDone != flushRequested )
+            {
+                m_flushDone = flushRequested;
+                m_condFlushed.Broadcast();
+            }
+
+            if ( exit )
+                break;
+
+            if ( !m_signalled.load() && !m_exit &&
+                    m_flushRequested == m_flushDone )
+                m_condWork.Wait();
+        }
+
+        return nullptr;
+    }
+
+private:
+    wxLogAsyncBuffer* GetThreadBuffer()
+    {
+        wxLogAsyncThreadBuffer& threadBuffer = wxPerThreadAsyncLogBuffer;
+        if ( threadBuffer.owner != m_serial )
+        {
+            // This thread used a different wxLogAsync object before.
+            if ( threadBuffer.buffer )
+                threadBuffer.buffer->Abandon();
+
+            threadBuffer.ptr = new wxLogAsyncBuffer(m_bufferSize);
+            threadBuffer.buffer = wxSharedPtr<wxLogAsyncBuffer>(threadBuffer.ptr);
+            threadBuffer.owner = m_serial;
+
+            wxCriticalSectionLocker lock(m_buffersCS);
+            m_buffers.push_back(threadBuffer.buffer);
+        }
+
+        return threadBuffer.ptr;
+    }
+
+    // Wake up the worker thread if it's sleeping, this is cheap if it had
+    // already been woken up and didn't process the messages yet, unless
+    // urgent is true, in which case it also stops waiting for more messages.
+    void WakeUp(bool urgent)
+    {
+        if ( urgent )
+        {
+            wxMutexLocker lock(m_mutex);
+            m_urgent = true;
+            m_signalled.store(true);
+            m_condWork.Signal();
+            return;
+        }
+
+        // Together with the fence in Entry() this ensures that either the
+        // worker thread sees the message we've just added or we see that
+        // it may be about to sleep and signal it.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if ( !m_signalled.load(std::memory_order_relaxed) &&
+                !m_signalled.exchange(true) )
+        {
+            wxMutexLocker lock(m_mutex);
+            m_condWork.Signal();
+        }
+    }
+
+    // Wait until the message can be added to the buffer, returns false if it
+    // couldn't be done.
+    bool WaitForSpace(wxLogAsyncBuffer* buffer,
+                      wxLogLevel level,
+                      const wxString& msg,
+                      const wxLogRecordInfo& info)
+    {
+        // The worker thread can't wait for itself.
+        if ( GetCurrentId() == GetId() )
+            return false;
+
+        wxMutexLocker lock(m_mutex);
+
+        m_numBlocked++;
+
+        bool ok;
+        while ( !(ok = buffer->Push(level, msg, info) != 0) && !m_exit )
+        {
+            m_urgent = true;
+            m_signalled.store(true);
+            m_condWork.Signal();
+
+            m_condSpace.Wait();
+        }
+
+        m_numBlocked--;
+
+        return ok;
+    }
+
+    bool HasPending()
+    {
+        wxCriticalSectionLocker lock(m_buffersCS);
+        for ( const auto& buffer : m_buffers )
+        {
+            if ( buffer->GetHead() != buffer->GetTail() )
+                return true;
+        }
+
+        return false;
+    }
+
+    // Pass all the messages logged so far to the target, this is called by
+    // the worker thread only (or after it terminated).
+    void ProcessPending()
+    {
+        // Find the messages in all the buffers, forgetting about the buffers
+        // of the threads which don't exist any more.
+        m_ranges.clear();
+        {
+            wxCriticalSectionLocker lock(m_buffersCS);
+            for ( auto it = m_buffers.begin(); it != m_buffers.end(); )
+            {
+                wxLogAsyncBuffer* const buffer = it->get();
+
+                // Check this before the head, as the buffer can't become
+                // non-empty after being abandoned.
+                const bool abandoned = buffer->IsAbandoned();
+
+                const Range range = { buffer, buffer->GetTail(), buffer->GetHead() };
+                if ( range.pos != range.end )
+                {
+                    m_ranges.push_back(range);
+                }
+                else if ( abandoned )
+                {
+                    it = m_buffers.erase(it);
+                    continue;
+                }
+
+                ++it;
+            }
+        }
+
+        const unsigned long numDropped = GetDroppedCount();
+        if ( m_ranges.empty() && numDropped == m_numDroppedReported )
+            return;
+
+        {
+            wxCriticalSectionLocker lock(m_targetCS);
+
+            if ( m_ranges.size() == 1 )
+            {
+                Range& range = m_ranges[0];
+                for ( ; range.pos != range.end; ++range.pos )
+                    LogRecord(range.buffer->Get(range.pos));
+            }
+            else if ( !m_ranges.empty() )
+            {
+                // Merge the messages from different threads in the order of
+                // their time stamps while preserving the order of messages
+                // from the same thread.
+                std::vector<Range> heap(m_ranges);
+                std::make_heap(heap.begin(), heap.end(), RangeLater);
+                while ( !heap.empty() )
+                {
+                    std::pop_heap(heap.begin(), heap.end(), RangeLater);
+
+                    Range& range = heap.back();
+                    LogRecord(range.buffer->Get(range.pos));
+                    if ( ++range.pos == range.end )
+                        heap.pop_back();
+                    else
+                        std::push_heap(heap.begin(), heap.end(), RangeLater);
+                }
+            }
+
+            if ( numDropped != m_numDroppedReported )
+            {
+                LogDropped(numDropped - m_numDroppedReported);
+                m_numDroppedReported = numDropped;
+            }
+        }
+
+        for ( const auto& range : m_ranges )
+            range.buffer->Release(range.end);
+
+        wxMutexLocker lock(m_mutex);
+        if ( m_numBlocked )
+            m_condSpace.Broadcast();
+    }
+
+    void LogRecord(const wxLogAsyncBuffer::Record& rec)
+    {
+        m_target->LogRecord(rec.level, rec.msg, rec.info);
+    }
+
+    void LogDropped(unsigned long count)
+    {
+        wxString msg;
+#if wxUSE_INTL
+        msg.Printf(wxPLURAL("%lu log message was dropped because the buffer was full.",
+                            "%lu log messages were dropped because the buffer was full.",
+                            count),
+                   count);
+#else
+        msg.Printf(wxS("%lu log message(s) were dropped because the buffer was full."),
+                   count);
+#endif
+
+        wxLogRecordInfo info;
+        info.timestampMS = wxGetUTCTimeMillis().GetValue();
+        info.threadId = GetCurrentId();
+
+        m_target->LogRecord(wxLOG_Warning, msg, info);
+    }
+
+
+    // The still unprocessed messages of a single buffer.
+    struct Range
+    {
+        wxLogAsyncBuffer* buffer;
+        size_t pos;
+        size_t end;
+    };
+
+    static bool RangeLater(const Range& r1, const Range& r2)
+    {
+        return r1.buffer->Get(r1.pos).info.timestampMS >
+                r2.buffer->Get(r2.pos).info.timestampMS;
+    }
+
+
+    // Time in milliseconds to wait for more messages before processing them.
+    static const unsigned long BATCH_DELAY = 2;
+
+    wxLog* const m_target;
+    const size_t m_bufferSize;
+    const wxLogAsync::OverflowPolicy m_policy;
+    const unsigned long m_serial;
+
+    // True if the worker thread is running.
+    bool m_running = false;
+
+    // Protects m_target which is used by the worker thread and Flush().
+    wxCriticalSection m_targetCS;
+
+    // All the buffers used with this object, protected by m_buffersCS.
+    wxCriticalSection m_buffersCS;
+    std::vector< wxSharedPtr<wxLogAsyncBuffer> > m_buffers;
+
+    // Used by the worker thread only.
+    std::vector<Range> m_ranges;
+    unsigned long m_numDroppedReported = 0;
+
+    std::atomic<unsigned long> m_numDropped{0};
+
+    // Set when the worker thread was woken up to process the new messages.
+    std::atomic<bool> m_signalled{false};
+
+    // All the remaining fields are protected by this mutex.
+    wxMutex m_mutex;
+    wxCondition m_condWork;
+    wxCondition m_condSpace;
+    wxCondition m_condFlushed;
+
+    unsigned long m_flushRequested = 0;
+    unsigned long m_flushDone = 0;
+    unsigned m_numBlocked = 0;
+    bool m_urgent = false;
+    bool m_exit = false;
+
+    wxDECLARE_NO_COPY_CLASS(wxLogAsyncImpl);
+};
+
+wxLogAsync::wxLogAsync(wxLog *target,
+                       size_t bufferSize,
+                       OverflowPolicy policy)
+    : m_impl(new wxLogAsyncImpl(target, bufferSize, policy))
+{
+    wxASSERT_MSG( target, "log target can't be null" );
+
+    m_impl->Start();
+}
+
+wxLogAsync::~wxLogAsync()
+{
+    m_impl->Stop();
+    delete m_impl;
+}
+
+wxLog *wxLogAsync::GetTarget() const
+{
+    return m_impl->GetTarget();
+}
+
+unsigned long wxLogAsync::GetDroppedCount() const
+{
+    return m_impl->GetDroppedCount();
+}
+
+void wxLogAsync::Flush()
+{
+    wxLog::Flush();
+
+    m_impl->Flush();
+}
+
+void wxLogAsync::DoLogRecord(wxLogLevel level,
+                             const wxString& msg,
+                             const wxLogRecordInfo& info)
+{
+    m_impl->Log(level, msg, info);
+}
+
+bool wxLogAsync::DoLogThreadRecord(wxLogLevel level,
+                                   const wxString& msg,
+                                   const wxLogRecordInfo& info)
+{
+    // Unlike for the messages logged from the main thread, this is not done
+    // by wxLog itself before calling us.
+    wxString decorated;
+    if ( DecorateLogMessage(level, msg, info, &decorated) )
+        m_impl->Log(level, decorated, info);
+    else
+        m_impl->Log(level, msg, info);
+
+    return true;
+}
+
+#endif // wxUSE_THREADS
+
 // ============================================================================
 // Global functions/variables
 // ============================================================================
@@ -48,6 +48,7 @@ void wxProcess::Init(wxEvtHandler *parent, int id, int flags)
     m_pid        = 0;
     m_priority   = wxPRIORITY_DEFAULT;
     m_redirect   = (flags & wxPROCESS_REDIRECT) != 0;
+    m_redirectLines = false;
 
 #if wxUSE_STREAMS
     m_inputStream  = nullptr;
@@ -97,6 +98,14 @@ void wxProcess::OnTerminate(int pid, int status)
     //      us!
 }
 
+void wxProcess::OnOutputLine(const wxString& WXUNUSED(line))
+{
+}
+
+void wxProcess::OnErrorLine(const wxString& WXUNUSED(line))
+{
+}
+
 void wxProcess::Detach()
 {
     // we just detach from the next handler of the chain (i.e. our "parent" -- see ctor)
@@ -31,6 +31,14 @@
     #include "wx/crt.h"
 #endif //WX_PRECOMP
 
+#include "wx/hashmap.h"
+#include "wx/sharedptr.h"
+#include "wx/thread.h"
+
+#include <list>
+#include <string>
+#include <unordered_map>
+
 // At least FreeBSD requires this.
 #if defined(__UNIX__)
 #   include <sys/types.h>
@@ -71,7 +79,7 @@ typedef wxRegChar wxRegErrorChar;
 //
 //  0. The plan is to stop using POSIX API soon anyhow.
 //  1. It's yet another system library to depend on.
-//  2. We can add non-standard "len" parameter to regexec().
+//  2. We can add non-standard "len" and "start" parameters to regexec().
 //  3. We want to use PCRE2_ALT_BSUX for compatibility, but we can't
 //     set it using just the POSIX API.
 //
@@ -164,9 +172,17 @@ int wx_regcomp(regex_t* preg, const wxRegChar* pattern, int cflags)
     return REG_NOERROR;
 }
 
+// Non-standard function initializing regex_t to use an already compiled code,
+// which can be shared by several regex_t objects.
+void wx_reguse(regex_t* preg, pcre2_code* code)
+{
+    preg->code = code;
+    preg->match_data = pcre2_match_data_create_from_pattern(code, nullptr);
+}
+
 int
 wx_regexec(const regex_t* preg, const wxRegChar* string, size_t len,
-           size_t nmatch, regmatch_t* pmatch, int eflags)
+           size_t start, size_t nmatch, regmatch_t* pmatch, int eflags)
 {
     int options = 0;
 
@@ -182,7 +198,7 @@ wx_regexec(const regex_t* preg, const wxRegChar* string, size_t len,
                         preg->code,
                         (PCRE2_SPTR)string,
                         len,
-                        0,                      // start offset
+                        start,
                         options,
                         preg->match_data,
                         nullptr                    // use default context
@@ -242,10 +258,10 @@ wx_regerror(int errcode, const regex_t* preg, wxRegErrorChar* errbuf, size_t err
     return len;
 }
 
+// Note that this doesn't free the code, which is owned by wxRegExCode.
 void wx_regfree(regex_t* preg)
 {
     pcre2_match_data_free(preg->match_data);
-    pcre2_code_free(preg->code);
 }
 
 } // anonymous namespace
@@ -283,6 +299,99 @@ private:
     regmatch_t *m_matches;
 };
 
+// the compiled code of a regular expression, which is immutable and so can be
+// shared by all wxRegEx objects using the same expression, even in different
+// threads
+class wxRegExCode
+{
+public:
+    typedef std::basic_string<wxRegChar> RegString;
+
+    // takes ownership of the code
+    wxRegExCode(pcre2_code* code, const wxString& literal, bool isPrefix);
+    ~wxRegExCode() { pcre2_code_free(m_code); }
+
+    pcre2_code* Get() const { return m_code; }
+
+    // return false if the expression can't match the string because it
+    // doesn't contain the literal required by it, otherwise return true and
+    // the position from which the search for the match can start
+    bool CanMatch(const wxRegChar* str, size_t len, size_t* start) const;
+
+private:
+    pcre2_code* const m_code;
+
+    // the literal string which must occur in any match or empty
+    RegString m_literal;
+
+    // if true, any match starts with m_literal
+    const bool m_isPrefix;
+
+    wxDECLARE_NO_COPY_CLASS(wxRegExCode);
+};
+
+typedef wxSharedPtr<wxRegExCode> wxRegExCodePtr;
+
+// the cache of the recently compiled expressions shared by all threads
+class wxRegExCache
+{
+public:
+    wxRegExCache() : m_maxSize(DEFAULT_SIZE) { }
+
+    // return the code of the given expression or null if it's not cached
+    wxRegExCodePtr Get(const wxString& expr, int flags);
+
+    // add the code of the given expression to the cache
+    void Add(const wxString& expr, int flags, const wxRegExCodePtr& code);
+
+    void SetMaxSize(size_t size);
+
+private:
+    // default maximal number of cached expressions
+    static const size_t DEFAULT_SIZE = 64;
+
+    struct Key
+    {
+        Key(const wxString& expr_, int flags_) : expr(expr_), flags(flags_) { }
+
+        bool operator==(const Key& other) const
+        {
+            return flags == other.flags && expr == other.expr;
+        }
+
+        wxString expr;
+        int flags;
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const
+        {
+            return wxStringHash()(key.expr) ^ static_cast<size_t>(key.flags);
+        }
+    };
+
+    // the list of the cached expressions, most recently used first
+    typedef std::list< std::pair<Key, wxRegExCodePtr> > List;
+    List m_list;
+
+    // index of the elements of m_list
+    std::unordered_map<Key, List::iterator, KeyHash> m_index;
+
+    size_t m_maxSize;
+
+#if wxUSE_THREADS
+    wxCriticalSection m_cs;
+#endif // wxUSE_THREADS
+};
+
+static wxRegExCache& GetRegExCache()
+{
+    static wxRegExCache s_cache;
+
+    return s_cache;
+}
+
 // the real implementation of wxRegEx
 class wxRegExImpl
 {
@@ -306,6 +415,9 @@ private:
     // return the string containing the error message for the given err code
     wxString GetErrorMsg(int errorcode) const;
 
+    // really compile the RE, return null on error
+    wxRegExCodePtr DoCompile(wxString expr, int flags);
+
     // init the members
     void Init()
     {
@@ -322,6 +434,8 @@ private:
             wx_regfree(&m_RegEx);
         }
 
+        m_code.reset();
+
         delete m_Matches;
     }
 
@@ -335,6 +449,9 @@ private:
     // compiled RE
     regex_t         m_RegEx;
 
+    // its compiled code, shared with the other objects using the same RE
+    wxRegExCodePtr  m_code;
+
     // the subexpressions data
     wxRegExMatches *m_Matches;
     size_t          m_nMatches;
@@ -348,6 +465,118 @@ private:
 // implementation
 // ============================================================================
 
+// ----------------------------------------------------------------------------
+// wxRegExCode
+// ----------------------------------------------------------------------------
+
+wxRegExCode::wxRegExCode(pcre2_code* code, const wxString& literal, bool isPrefix)
+    : m_code(code),
+      m_isPrefix(isPrefix)
+{
+#ifndef WXREGEX_CONVERT_TO_MB
+    m_literal.assign(literal.wc_str(), literal.length());
+#else
+    const wxScopedCharBuffer buf = literal.utf8_str();
+    m_literal.assign(buf.data(), buf.length());
+#endif
+}
+
+bool
+wxRegExCode::CanMatch(const wxRegChar* str, size_t len, size_t* start) const
+{
+    *start = 0;
+
+    const size_t litlen = m_literal.length();
+    if ( !litlen )
+        return true;
+
+    typedef std::char_traits<wxRegChar> Traits;
+
+    // Look for the first character using memchr() or wmemchr() and then
+    // check if the rest of the literal follows it.
+    const wxRegChar first = m_literal[0];
+    for ( size_t pos = 0; len - pos >= litlen; )
+    {
+        const wxRegChar* const
+            p = Traits::find(str + pos, len - pos - litlen + 1, first);
+        if ( !p )
+            break;
+
+        pos = p - str;
+        if ( Traits::compare(p + 1, m_literal.data() + 1, litlen - 1) == 0 )
+        {
+            if ( m_isPrefix )
+                *start = pos;
+
+            return true;
+        }
+
+        pos++;
+    }
+
+    return false;
+}
+
+// ----------------------------------------------------------------------------
+// wxRegExCache
+// ----------------------------------------------------------------------------
+
+wxRegExCodePtr wxRegExCache::Get(const wxString& expr, int flags)
+{
+#if wxUSE_THREADS
+    wxCriticalSectionLocker lock(m_cs);
+#endif // wxUSE_THREADS
+
+    const auto it = m_index.find(Key(expr, flags));
+    if ( it == m_index.end() )
+        return wxRegExCodePtr();
+
+    // make it the most recently used one
+    m_list.splice(m_list.begin(), m_list, it->second);
+
+    return it->second->second;
+}
+
+void
+wxRegExCache::Add(const wxString& expr, int flags, const wxRegExCodePtr& code)
+{
+#if wxUSE_THREADS
+    wxCriticalSectionLocker lock(m_cs);
+#endif // wxUSE_THREADS
+
+    if ( !m_maxSize )
+        return;
+
+    // another thread could have compiled the same expression in the meanwhile
+    const Key key(expr, flags);
+    if ( m_index.count(key) )
+        return;
+
+    if ( m_list.size() == m_maxSize )
+    {
+        m_index.erase(m_list.back().first);
+        m_list.pop_back();
+    }
+
+    m_list.push_front(std::make_pair(key, code));
+    m_index.insert(std::make_pair(key, m_list.begin()));
+}
+
+void wxRegExCache::SetMaxSize(size_t size)
+{
+#if wxUSE_THREADS
+    wxCriticalSectionLocker lock(m_cs);
+#endif // wxUSE_THREADS
+
+    m_maxSize = size;
+
+    while ( m_list.size() > m_maxSize )
+    {
+        m_index.erase(m_list.back().first);
+        m_list.pop_back();
+    }
+}
+
 // ----------------------------------------------------------------------------
 // wxRegExImpl
 // ----------------------------------------------------------------------------
@@ -947,6 +1176,294 @@ static wxString ConvertWordBoundaries(const wxString& expr)
     return out;
 }
 
+// Similar to SkipBracketExpression(), but for the PCRE syntax in which
+// backslashes are special inside the bracket expressions too.
+//
+// Return end if the expression is not terminated or uses "\Q".
+static
+wxString::const_iterator
+SkipPCREBracketExpression(wxString::const_iterator it,
+                          wxString::const_iterator end)
+{
+    ++it;
+    if ( it != end && *it == '^' )
+        ++it;
+    if ( it != end && *it == ']' )
+        ++it;
+
+    for ( ; it != end; ++it )
+    {
+        const wxUniChar c = *it;
+
+        if ( c == ']' )
+            break;
+
+        if ( c == '\\' )
+        {
+            if ( ++it == end || *it == 'Q' )
+                return end;
+        }
+        else if ( c == '[' && it + 1 != end )
+        {
+            // Skip POSIX character classes such as "[:alpha:]".
+            const wxUniChar c2 = it[1];
+            if ( c2 == ':' || c2 == '.' || c2 == '=' )
+            {
+                for ( it += 2; it != end; ++it )
+                {
+                    if ( *it == c2 && it + 1 != end && it[1] == ']' )
+                        break;
+                }
+
+                if ( it == end )
+                    return end;
+
+                ++it;
+            }
+        }
+    }
+
+    return it;
+}
+
+// Find the longest literal string which must occur in any match of the given
+// PCRE expression.
+//
+// This is conservative, i.e. it's fine to miss some literals, but any literal
+// found must really be required, so give up if the expression uses anything
+// we don't understand. Also return true in isPrefix if all matches start with
+// the literal.
+static wxString FindRequiredLiteral(const wxString& expr, bool* isPrefix)
+{
+    *isPrefix = false;
+
+    wxString best,
+             run;
+    bool bestIsPrefix = false,
+         runIsPrefix = true,
+         lastIsLiteral = false;
+
+    // Called when the current run of literal characters ends.
+    const auto endRun = [&]()
+    {
+        if ( run.length() > best.length() )
+        {
+            best = run;
+            bestIsPrefix = runIsPrefix;
+        }
+
+        run.clear();
+        runIsPrefix =
+        lastIsLiteral = false;
+    };
+
+    // Only the literals outside of any groups are considered, the groups
+    // themselves are just skipped.
+    int depth = 0;
+    bool inQuote = false;
+
+    const wxString::const_iterator end = expr.end();
+    for ( wxString::const_iterator it = expr.begin(); it != end; ++it )
+    {
+        const wxUniChar c = *it;
+
+        if ( c == '\\' )
+        {
+            if ( ++it == end )
+                return wxString();
+
+            const wxUniChar e = *it;
+            if ( inQuote )
+            {
+                if ( e == 'E' )
+                {
+                    inQuote = false;
+                    continue;
+                }
+
+                // Backslash is not special inside "\Q...\E".
+                --it;
+            }
+            else if ( e == 'Q' )
+            {
+                inQuote = true;
+                continue;
+            }
+            else if ( e.IsAscii() && wxIsalnum(e) )
+            {
+                // This is a special escape: character class, assertion,
+                // back reference or a character code. Skip its arguments, if
+                // any, ensuring that they're not taken as literals.
+                if ( depth == 0 )
+                    endRun();
+
+                const wxString::const_iterator next = it + 1;
+                if ( next == end )
+                    continue;
+
+                const wxUniChar n = *next;
+                if ( n == '{' && wxStrchr("xopPNgk", (char)e) )
+                {
+                    while ( ++it != end && *it != '}' )
+                        ;
+
+                    if ( it == end )
+                        return wxString();
+                }
+                else if ( (n == '<' || n == '\'') && (e == 'g' || e == 'k') )
+                {
+                    const wxUniChar close = n == '<' ? '>' : '\'';
+                    for ( ++it; ++it != end && *it != close; )
+                        ;
+
+                    if ( it == end )
+                        return wxString();
+                }
+                else if ( e == 'c' || e == 'p' || e == 'P' )
+                {
+                    ++it;
+                }
+                else if ( e == 'g' || e == 'x' || e == 'u' ||
+                          (e >= '0' && e <= '9') )
+                {
+                    while ( it + 1 != end && (it[1] == '-' || it[1] == '+' ||
+                                (it[1].IsAscii() && wxIsxdigit(it[1]))) )
+                        ++it;
+                }
+
+                continue;
+            }
+            //else: escaped literal character
+        }
+        else if ( !inQuote )
+        {
+            if ( depth > 0 )
+            {
+                switch ( c.GetValue() )
+                {
+                    case '(':
+                        depth++;
+                        break;
+
+                    case ')':
+                        depth--;
+                        break;
+
+                    case '[':
+                        it = SkipPCREBracketExpression(it, end);
+                        if ( it == end )
+                            return wxString();
+                        break;
+                }
+
+                continue;
+            }
+
+            switch ( c.GetValue() )
+            {
+                case '|':
+                    // Nothing is required if there are alternatives.
+                    return wxString();
+
+                case ')':
+                    return wxString();
+
+                case '(':
+                    endRun();
+
+                    // Top level option settings would affect the literals
+                    // following them and verbs can affect everything, so
+                    // don't try to interpret them, but just skip over all the
+                    // groups, including the lookaround assertions.
+                    if ( it + 1 != end && it[1] == '*' )
+                        return wxString();
+
+                    if ( it + 1 != end && it[1] == '?' )
+                    {
+                        if ( it + 2 == end )
+                            return wxString();
+
+                        const wxUniChar kind = it[2];
+                        if ( kind != ':' && kind != '=' && kind != '!' &&
+                                kind != '<' && kind != '>' && kind != '#' )
+                            return wxString();
+
+                        if ( kind == '<' &&
+                                (it + 3 == end || (it[3] != '=' && it[3] != '!')) )
+                            return wxString();
+                    }
+
+                    depth++;
+                    continue;
+
+                case '[':
+                    endRun();
+
+                    it = SkipPCREBracketExpression(it, end);
+                    if ( it == end )
+                        return wxString();
+                    continue;
+
+                case '.':
+                case '^':
+                case '$':
+                    endRun();
+                    continue;
+
+                case '*':
+                case '?':
+                case '{':
+                    // The preceding character may be optional, so remove it.
+                    // Notice that we don't check if '{' really starts a
+                    // quantifier, if it doesn't, we lose it and the previous
+                    // character, but this is harmless.
+                    if ( lastIsLiteral )
+                        run.RemoveLast();
+                    endRun();
+
+                    if ( c == '{' )
+                    {
+                        // Skip the quantifier contents, if it is one.
+                        wxString::const_iterator q = it + 1;
+                        while ( q != end && ((*q >= '0' && *q <= '9') ||
+                                                *q == ',' || *q == ' ') )
+                            ++q;
+
+                        if ( q != end && *q == '}' )
+                            it = q;
+                    }
+                    continue;
+
+                case '+':
+                    // The preceding character is still required, but the
+                    // next one doesn't necessarily follow it.
+                    endRun();
+                    continue;
+            }
+        }
+
+        // If we get here, we have a literal character.
+        if ( depth == 0 )
+        {
+            run += *it;
+            lastIsLiteral = true;
+        }
+    }
+
+    if ( depth != 0 || inQuote )
+    {
+        // Unterminated group is an error and "\Q" without "\E" is fine, but
+        // it's simpler to not handle it specially, as it's so rare.
+        return wxString();
+    }
+
+    endRun();
+
+    *isPrefix = bestIsPrefix;
+
+    return best;
+}
+
 bool wxRegExImpl::Compile(wxString expr, int flags)
 {
     Reinit();
@@ -954,6 +1471,43 @@ bool wxRegExImpl::Compile(wxString expr, int flags)
     wxASSERT_MSG( !(flags & ~(wxRE_ADVANCED | wxRE_BASIC | wxRE_ICASE | wxRE_NOSUB | wxRE_NEWLINE)),
                   wxT("unrecognized flags in wxRegEx::Compile") );
 
+    // Compiling the same expression many times is common, so reuse the
+    // previously compiled code if possible.
+    wxRegExCache& cache = GetRegExCache();
+    m_code = cache.Get(expr, flags);
+    if ( m_code )
+    {
+        wx_reguse(&m_RegEx, m_code->Get());
+    }
+    else
+    {
+        m_code = DoCompile(expr, flags);
+        if ( !m_code )
+            return false;
+
+        cache.Add(expr, flags, m_code);
+    }
+
+    // don't allocate the matches array now, but do it later if necessary
+    if ( flags & wxRE_NOSUB )
+    {
+        // we don't need it at all
+        m_nMatches = 0;
+    }
+    else
+    {
+        // we will alloc the array later (only if really needed) but count
+        // the number of sub-expressions in the regex right now
+        m_nMatches = pcre2_get_ovector_count(m_RegEx.match_data);
+    }
+
+    m_isCompiled = true;
+
+    return true;
+}
+
+wxRegExCodePtr wxRegExImpl::DoCompile(wxString expr, int flags)
+{
     // Deal with the directors and embedded options first (this can modify
     // flags).
     expr = ConvertMetasyntax(expr, flags);
@@ -995,27 +1549,17 @@ bool wxRegExImpl::Compile(wxString expr, int flags)
         wxLogError(_("Invalid regular expression '%s': %s"),
                    expr, GetErrorMsg(errorcode));
 
-        m_isCompiled = false;
+        return wxRegExCodePtr();
     }
-    else // ok
-    {
-        // don't allocate the matches array now, but do it later if necessary
-        if ( flags & wxRE_NOSUB )
-        {
-            // we don't need it at all
-            m_nMatches = 0;
-        }
-        else
-        {
-            // we will alloc the array later (only if really needed) but count
-            // the number of sub-expressions in the regex right now
-            m_nMatches = pcre2_get_ovector_count(m_RegEx.match_data);
-        }
 
-        m_isCompiled = true;
-    }
+    // find the literal allowing to quickly reject the strings which can't
+    // match, this is not done for case-insensitive REs for simplicity
+    bool isPrefix = false;
+    wxString literal;
+    if ( !(flags & wxRE_ICASE) )
+        literal = FindRequiredLiteral(expr, &isPrefix);
 
-    return IsValid();
+    return wxRegExCodePtr(new wxRegExCode(m_RegEx.code, literal, isPrefix));
 }
 
 bool wxRegExImpl::Matches(const wxRegChar *str,
@@ -1045,8 +1589,14 @@ bool wxRegExImpl::Matches(const wxRegChar *str,
 
     wxRegExMatches::match_type matches = m_Matches ? m_Matches->get() : nullptr;
 
+    // check if the string can match at all before using the real RE engine
+    size_t start;
+    if ( !m_code->CanMatch(str, len, &start) )
+        return false;
+
     // do match it
-    int rc = wx_regexec(&self->m_RegEx, str, len, m_nMatches, matches, flagsRE);
+    int rc = wx_regexec(&self->m_RegEx, str, len, start,
+                        m_nMatches, matches, flagsRE);
 
     switch ( rc )
     {
@@ -1328,6 +1878,12 @@ wxString wxRegEx::QuoteMeta(const wxString& str)
     return strEscaped;
 }
 
+/* static */
+void wxRegEx::SetCacheSize(size_t size)
+{
+    GetRegExCache().SetMaxSize(size);
+}
+
 /* static */
 wxVersionInfo wxRegEx::GetLibraryVersionInfo()
 {
@@ -41,6 +41,30 @@
 #include <errno.h>
 
 #include "wx/socket.h"
+#include "wx/sysopt.h"
+#include "wx/utils.h"
+
+#if wxUSE_ZLIB
+    #include "wx/mstream.h"
+    #include "wx/zstream.h"
+#endif // wxUSE_ZLIB
+
+#include <memory>
+#include <vector>
+
+// Passing the data via shared memory is only implemented for Unix systems
+// having /dev/shm, which is used instead of shm_open() to avoid depending on
+// librt.
+#if defined(__LINUX__) && !defined(__WINE__)
+    #define wxHAS_IPC_SHARED_MEMORY
+
+    #include <atomic>
+    #include <random>
+
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif // __LINUX__
 
 // --------------------------------------------------------------------------
 // macros and constants
@@ -64,6 +88,8 @@ enum IPCCode
     IPC_FAIL            = 9,
     IPC_CONNECT         = 10,
     IPC_DISCONNECT      = 11,
+    IPC_CAPABILITIES    = 12,
+    IPC_SHM_ATTACH      = 13,
     IPC_MAX
 };
 
@@ -167,10 +193,400 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxTCPEventHandlerModule, wxModule);
 wxTCPEventHandler *wxTCPEventHandlerModule::ms_handler = nullptr;
 
 // --------------------------------------------------------------------------
-// wxIPCSocketStreams
+// Extended protocol support
 // --------------------------------------------------------------------------
 
-#define USE_BUFFER
+// The extended protocol is negotiated by the client sending IPC_CAPABILITIES
+// without any parameters right after connecting: old servers reply to it with
+// IPC_FAIL and the legacy protocol continues to be used in this case, while
+// the new ones reply with IPC_CAPABILITIES followed by the mask of IPC_CAP_XXX
+// flags they support. After this both sides switch to the extended protocol
+// and the client starts by sending IPC_CAPABILITIES with its own flags, which
+// doesn't get any reply.
+//
+// The extended protocol differs from the legacy one in that:
+//
+//  - every message is prefixed with the 32 bit size of its frame, which is
+//    everything except the data blocks not stored in the frame itself, so
+//    that the message can be read at once;
+//  - the data blocks are prefixed with IPCDataEncoding byte.
+//
+// If both sides support it, the client then creates a shared memory segment
+// and sends its name in IPC_SHM_ATTACH message. The server replies with
+// IPC_SHM_ATTACH if it could map it (which is only possible if it runs on the
+// same host and as the same user) or IPC_FAIL otherwise and the client
+// removes the segment name in any case.
+
+namespace
+{
+
+// Optional features, combined in the mask sent with IPC_CAPABILITIES.
+enum
+{
+    IPC_CAP_SHARED_MEMORY = 1,
+    IPC_CAP_ZLIB          = 2
+};
+
+// Encoding of the data blocks in the extended protocol.
+enum IPCDataEncoding
+{
+    // data size and the data itself follow
+    IPC_DATA_INLINE = 0,
+
+    // data size, compressed data size and the compressed data follow
+    IPC_DATA_ZLIB = 1,
+
+    // data size and its position in the shared memory ring follow
+    IPC_DATA_SHARED = 2
+};
+
+// Data blocks at least this big are not copied into the message frame but
+// sent directly from the caller buffer.
+const size_t IPC_DIRECT_MIN_SIZE = 1024;
+
+// Data blocks at least this big are passed via shared memory if possible.
+const size_t IPC_SHARED_MIN_SIZE = 1024;
+
+// Data blocks at least this big are compressed if compression is enabled.
+const size_t IPC_COMPRESS_MIN_SIZE = 256;
+
+// Output stream appending to a memory buffer, used to build message frames.
+class IPCBufferOutputStream : public wxOutputStream
+{
+public:
+    IPCBufferOutputStream() = default;
+
+    void Clear() { m_data.clear(); }
+
+    bool IsEmpty() const { return m_data.empty(); }
+    const char *GetData() const { return m_data.data(); }
+    size_t GetDataLen() const { return m_data.size(); }
+
+protected:
+    virtual size_t OnSysWrite(const void *buffer, size_t size) override
+    {
+        const char * const p = static_cast<const char *>(buffer);
+        m_data.insert(m_data.end(), p, p + size);
+        return size;
+    }
+
+private:
+    std::vector<char> m_data;
+
+    wxDECLARE_NO_COPY_CLASS(IPCBufferOutputStream);
+};
+
+// Input stream reading from the frame of the last received message.
+class IPCFrameInputStream : public wxInputStream
+{
+public:
+    IPCFrameInputStream() = default;
+
+    // return the buffer to read the new frame of the given size into
+    char *Prepare(size_t size)
+    {
+        m_data.resize(size);
+        m_pos = 0;
+        Reset();
+
+        return m_data.data();
+    }
+
+    // read as much of the given data as is available in the frame
+    size_t ReadFromFrame(void *buffer, size_t size)
+    {
+        size = wxMin(size, m_data.size() - m_pos);
+        memcpy(buffer, m_data.data() + m_pos, size);
+        m_pos += size;
+
+        return size;
+    }
+
+protected:
+    virtual size_t OnSysRead(void *buffer, size_t size) override
+    {
+        const size_t count = ReadFromFrame(buffer, size);
+        if ( !count )
+            m_lasterror = wxSTREAM_EOF;
+
+        return count;
+    }
+
+private:
+    std::vector<char> m_data;
+    size_t m_pos = 0;
+
+    wxDECLARE_NO_COPY_CLASS(IPCFrameInputStream);
+};
+
+#ifdef wxHAS_IPC_SHARED_MEMORY
+
+// Shared memory segment containing two rings used for passing the data
+// blocks, one for each direction.
+//
+// Each ring is written by one side and read by the other one. The writer
+// copies the data into the ring and sends its position in the message, the
+// reader passes the pointer to the data in the ring to the callbacks and
+// advances the head of the ring, which is the only shared state, once it's
+// done with it. Notice that the data written to the ring is always seen by
+// the reader as the message is sent using a system call after writing it.
+class IPCSharedMemory
+{
+public:
+    IPCSharedMemory() = default;
+
+    ~IPCSharedMemory()
+    {
+        Unlink();
+
+        if ( m_base )
+            munmap(m_base, SEGMENT_SIZE);
+    }
+
+    // create a new segment, called by the client
+    bool Create();
+
+    // map the segment created by the peer, called by the server
+    bool Attach(const wxString& name);
+
+    // remove the segment name, it remains valid for the sides which mapped it
+    void Unlink()
+    {
+        if ( m_created )
+        {
+            unlink(GetPath(m_name).fn_str());
+            m_created = false;
+        }
+    }
+
+    const wxString& GetName() const { return m_name; }
+
+    // return the pointer to the buffer in the output ring to copy the data
+    // into or nullptr if there is not enough free space in it
+    void *Allocate(size_t size, wxUint32 *start);
+
+    // return the pointer to the data in the input ring or nullptr if the
+    // data is invalid
+    const void *GetData(wxUint32 start, size_t size) const
+    {
+        const wxUint32 pos = start & (RING_SIZE - 1);
+        if ( size > RING_SIZE - pos )
+            return nullptr;
+
+        return GetRing(1 - m_outRing) + pos;
+    }
+
+    // mark all the data in the input ring up to the given position as read
+    void Release(wxUint32 end)
+    {
+        GetHead(1 - m_outRing).store(end, std::memory_order_release);
+    }
+
+    bool Contains(const void *p) const
+    {
+        const char * const c = static_cast<const char *>(p);
+        return c >= m_base && c < m_base + SEGMENT_SIZE;
+    }
+
+private:
+    enum
+    {
+        MAGIC = 0x77784950, // "wxIP"
+        VERSION = 1,
+
+        // the size of each ring, must be a power of 2
+        RING_SIZE = 8*1024*1024,
+
+        // the offset of the ring heads and the data
+        HEADS_OFFSET = 64,
+        DATA_OFFSET = 4096,
+
+        SEGMENT_SIZE = DATA_OFFSET + 2*RING_SIZE
+    };
+
+    struct Header
+    {
+        wxUint32 magic;
+        wxUint32 version;
+        wxUint32 ringSize;
+    };
+
+    static wxString GetPath(const wxString& name)
+    {
+        return "/dev/shm/" + name;
+    }
+
+    bool Map(int fd);
+
+    Header& GetHeader() const
+    {
+        return *reinterpret_cast<Header *>(m_base);
+    }
+
+    // the heads are in different cache lines to avoid false sharing
+    std::atomic<wxUint32>& GetHead(int ring) const
+    {
+        return *reinterpret_cast<std::atomic<wxUint32> *>
+               (m_base + HEADS_OFFSET + 64*ring);
+    }
+
+    char *GetRing(int ring) const
+    {
+        return m_base + DATA_OFFSET + ring*RING_SIZE;
+    }
+
+
+    wxString m_name;
+    char *m_base = nullptr;
+
+    // true if we created the segment and haven't unlinked it yet
+    bool m_created = false;
+
+    // the ring we write to: 0 for the client and 1 for the server
+    int m_outRing = 0;
+
+    // the position of the end of the last block written to our output ring
+    wxUint32 m_tail = 0;
+
+    wxDECLARE_NO_COPY_CLASS(IPCSharedMemory);
+};
+
+bool IPCSharedMemory::Map(int fd)
+{
+    void * const p = mmap(nullptr, SEGMENT_SIZE, PROT_READ | PROT_WRITE,
+                          MAP_SHARED, fd, 0);
+    if ( p == MAP_FAILED )
+        return false;
+
+    m_base = static_cast<char *>(p);
+
+    return true;
+}
+
+bool IPCSharedMemory::Create()
+{
+    static std::random_device s_random;
+    static unsigned s_counter = 0;
+
+    for ( int attempt = 0; attempt < 10; attempt++ )
+    {
+        const wxString name = wxString::Format("wxipc-%lu-%u-%u",
+                                               wxGetProcessId(),
+                                               s_counter++,
+                                               s_random());
+
+        const int fd = open(GetPath(name).fn_str(),
+                            O_RDWR | O_CREAT | O_EXCL | O_NOFOLLOW | O_CLOEXEC,
+                            0600);
+        if ( fd == -1 )
+        {
+            if ( errno == EEXIST )
+                continue;
+
+            return false;
+        }
+
+        m_name = name;
+        m_created = true;
+
+        const bool ok = ftruncate(fd, SEGMENT_SIZE) == 0 && Map(fd);
+        close(fd);
+
+        if ( !ok )
+        {
+            Unlink();
+            return false;
+        }
+
+        Header& header = GetHeader();
+        header.magic = MAGIC;
+        header.version = VERSION;
+        header.ringSize = RING_SIZE;
+
+        for ( int ring = 0; ring < 2; ring++ )
+            new (&GetHead(ring)) std::atomic<wxUint32>(0);
+
+        m_outRing = 0;
+
+        return true;
+    }
+
+    return false;
+}
+
+bool IPCSharedMemory::Attach(const wxString& name)
+{
+    // don't allow the peer to make us map arbitrary files
+    if ( !name.StartsWith("wxipc-") )
+        return false;
+
+    for ( wxString::const_iterator it = name.begin(); it != name.end(); ++it )
+    {
+        const wxUniChar ch = *it;
+        if ( !(ch == '-' || (ch >= 'a' && ch <= 'z') || (ch >= '0' && ch <= '9')) )
+            return false;
+    }
+
+    const int fd = open(GetPath(name).fn_str(), O_RDWR | O_NOFOLLOW | O_CLOEXEC);
+    if ( fd == -1 )
+        return false;
+
+    struct stat st;
+    const bool ok = fstat(fd, &st) == 0 &&
+                        S_ISREG(st.st_mode) &&
+                            st.st_uid == geteuid() &&
+                                st.st_size == SEGMENT_SIZE &&
+                                    Map(fd);
+    close(fd);
+
+    if ( !ok )
+        return false;
+
+    const Header& header = GetHeader();
+    if ( header.magic != MAGIC ||
+            header.version != VERSION ||
+                header.ringSize != RING_SIZE )
+    {
+        return false;
+    }
+
+    m_name = name;
+    m_outRing = 1;
+
+    return true;
+}
+
+void *IPCSharedMemory::Allocate(size_t size, wxUint32 *start)
+{
+    if ( size > RING_SIZE )
+        return nullptr;
+
+    const wxUint32 used = m_tail - GetHead(m_outRing).load(std::memory_order_acquire);
+
+    // this can only happen if the peer corrupted the head
+    if ( used > RING_SIZE )
+        return nullptr;
+
+    // the blocks are always contiguous, so skip the end of the ring if the
+    // block doesn't fit into it
+    const wxUint32 pos = m_tail & (RING_SIZE - 1);
+    const wxUint32 padding = pos + size > RING_SIZE ? RING_SIZE - pos : 0;
+    if ( padding + size > RING_SIZE - used )
+        return nullptr;
+
+    *start = m_tail + padding;
+    m_tail = *start + size;
+
+    return GetRing(m_outRing) + (*start & (RING_SIZE - 1));
+}
+
+#endif // wxHAS_IPC_SHARED_MEMORY
+
+} // anonymous namespace
+
+// --------------------------------------------------------------------------
+// wxIPCSocketStreams
+// --------------------------------------------------------------------------
 
 // this class contains the various (related) streams used by wxTCPConnection
 // and also provides a way to read from the socket stream directly
@@ -180,71 +596,63 @@ class wxIPCSocketStreams
 {
 public:
     // ctor initializes all the streams on top of the given socket
-    //
-    // note that we use a bigger than default buffer size which matches the
-    // typical Ethernet MTU (minus TCP header overhead)
     wxIPCSocketStreams(wxSocketBase& sock)
-        : m_socketStream(sock),
-#ifdef USE_BUFFER
-          m_bufferedOut(m_socketStream, 1448),
-#else
-          m_bufferedOut(m_socketStream),
-#endif
+        : m_sock(sock),
+          m_socketStream(sock),
           m_dataIn(m_socketStream),
-          m_dataOut(m_bufferedOut)
+          m_frameDataIn(m_frameIn),
+          m_dataOut(m_frameOut)
     {
+        m_extended = false;
+        m_peerCapabilities = 0;
+        m_compress = false;
+
+        m_directData = nullptr;
+        m_directSize = 0;
+
+#ifdef wxHAS_IPC_SHARED_MEMORY
+        m_sharedReads = 0;
+        m_sharedEnd = 0;
+#endif // wxHAS_IPC_SHARED_MEMORY
     }
 
     // expose the IO methods needed by IPC code (notice that writing is only
     // done via IPCOutput)
 
-    // flush output
-    void Flush()
-    {
-#ifdef USE_BUFFER
-        m_bufferedOut.Sync();
-#endif
-    }
+    // send the message built by IPCOutput, if any
+    void Flush();
+
+    // read the code of the next message: this must be used instead of Read8()
+    // for the first byte of each message
+    wxUint8 ReadCode();
 
     // simple wrappers around the functions with the same name in
     // wxDataInputStream
     wxUint8 Read8()
     {
         Flush();
-        return m_dataIn.Read8();
+        return GetDataIn().Read8();
     }
 
     wxUint32 Read32()
     {
         Flush();
-        return m_dataIn.Read32();
+        return GetDataIn().Read32();
     }
 
     wxString ReadString()
     {
         Flush();
-        return m_dataIn.ReadString();
+        return GetDataIn().ReadString();
     }
 
     // read arbitrary (size-prepended) data
     //
     // connection parameter is needed to call its GetBufferAtLeast() method
-    void *ReadData(wxConnectionBase *conn, size_t *size)
-    {
-        Flush();
-
-        wxCHECK_MSG( conn, nullptr, "null connection parameter" );
-        wxCHECK_MSG( size, nullptr, "null size parameter" );
-
-        *size = Read32();
-
-        void * const data = conn->GetBufferAtLeast(*size);
-        wxCHECK_MSG( data, nullptr, "IPC buffer allocation failed" );
-
-        m_socketStream.Read(data, *size);
-
-        return data;
-    }
+    //
+    // the returned pointer may point to the shared memory, in which case it
+    // remains valid only until ReleaseData() is called
+    void *ReadData(wxConnectionBase *conn, size_t *size);
 
     // same as above but for data preceded by the format
     void *
@@ -257,29 +665,111 @@ public:
         return ReadData(conn, size);
     }
 
+    // same as ReadData() but always returns the data in the connection buffer
+    void *ReadDataToBuffer(wxConnectionBase *conn, size_t *size);
+
+    // must be called when the data returned by ReadData() is not needed any
+    // longer
+    void ReleaseData(const void *data);
+
+
+    // negotiate the use of the extended protocol with the server, this is
+    // called by the client right after connecting
+    void NegotiateExtensions();
+
+    // handle IPC_CAPABILITIES received by the server
+    void OnCapabilities();
+
+    // handle IPC_SHM_ATTACH received by the server
+    void OnAttachSharedMemory();
+
+    // enable or disable compressing the data sent to the peer, this only has
+    // effect if it supports it
+    void EnableCompression(bool enable) { m_compress = enable; }
+
 
     // these methods are only used by IPCOutput and not directly
     wxDataOutputStream& GetDataOut() { return m_dataOut; }
-    wxOutputStream& GetUnformattedOut() { return m_bufferedOut; }
+
+    // write the data block in the format appropriate for the current protocol
+    void WriteData(const void *data, size_t size);
 
 private:
+    // get the mask of the supported IPC_CAP_XXX flags
+    static wxUint32 GetCapabilities();
+
+    // get the stream to read the data from
+    wxDataInputStream& GetDataIn()
+    {
+        return m_extended ? m_frameDataIn : m_dataIn;
+    }
+
+    // read the raw data from the current frame and/or the socket
+    bool ReadRaw(void *data, size_t size);
+
+    // append the data block to the message being built, possibly without
+    // copying it
+    void AppendData(const void *data, size_t size);
+
+#if wxUSE_ZLIB
+    // compress the data into m_compressedOut, return false if it's not worth
+    // sending it compressed
+    bool Compress(const void *data, size_t size);
+
+    // decompress the data of the given size from m_compressedIn
+    bool Decompress(void *data, size_t size);
+#endif // wxUSE_ZLIB
+
+
+    wxSocketBase& m_sock;
+
     // this is the low-level underlying stream using the connection socket
     wxSocketStream m_socketStream;
 
-    // the buffered stream is used to avoid writing all pieces of an IPC
-    // request to the socket one by one but to instead do it all at once when
-    // we're done with it
-#ifdef USE_BUFFER
-    wxBufferedOutputStream m_bufferedOut;
-#else
-    wxOutputStream& m_bufferedOut;
-#endif
+    // the frame of the last message received when using extended protocol
+    IPCFrameInputStream m_frameIn;
 
-    // finally the data streams are used to be able to write typed data into
-    // the above streams easily
+    // the data streams are used to be able to read typed data easily either
+    // directly from the socket or from the current frame
     wxDataInputStream  m_dataIn;
+    wxDataInputStream  m_frameDataIn;
+
+    // the message being built, it is sent all at once when we're done with it
+    // to avoid writing all its pieces to the socket one by one
+    IPCBufferOutputStream m_frameOut;
     wxDataOutputStream m_dataOut;
 
+    // the data block following the frame, which is not copied into it
+    const void *m_directData;
+    size_t m_directSize;
+
+    // true if the extended protocol is used
+    bool m_extended;
+
+    // the capabilities of the peer
+    wxUint32 m_peerCapabilities;
+
+    // true if the data should be compressed
+    bool m_compress;
+
+#if wxUSE_ZLIB
+    // buffers used for the compressed data
+    IPCBufferOutputStream m_compressedOut;
+    std::vector<char> m_compressedIn;
+#endif // wxUSE_ZLIB
+
+#ifdef wxHAS_IPC_SHARED_MEMORY
+    // the shared memory used for passing the data blocks if available
+    std::unique_ptr<IPCSharedMemory> m_shm;
+
+    // the number of data blocks in the shared memory which are still in use
+    // and the end of the last of them: notice that the blocks may be read
+    // recursively, e.g. if a nested event loop is run from a callback, so we
+    // can only release them once all of them are not used any more
+    int m_sharedReads;
+    wxUint32 m_sharedEnd;
+#endif // wxHAS_IPC_SHARED_MEMORY
+
     wxDECLARE_NO_COPY_CLASS(wxIPCSocketStreams);
 };
 
@@ -312,6 +802,12 @@ public:
         m_streams.GetDataOut().Write8(i);
     }
 
+    // write a 32 bit number
+    void Write32(wxUint32 i)
+    {
+        m_streams.GetDataOut().Write32(i);
+    }
+
     // write the reply code and a string
     void Write(IPCCode code, const wxString& str)
     {
@@ -326,11 +822,10 @@ public:
         Write8(format);
     }
 
-    // write arbitrary data
+    // write arbitrary data, this must be the last thing written
     void WriteData(const void *data, size_t size)
     {
-        m_streams.GetDataOut().Write32(size);
-        m_streams.GetUnformattedOut().Write(data, size);
+        m_streams.WriteData(data, size);
     }
 
 
@@ -342,6 +837,367 @@ private:
 
 } // anonymous namespace
 
+void wxIPCSocketStreams::Flush()
+{
+    if ( m_frameOut.IsEmpty() )
+        return;
+
+    wxSocketIOVec vecs[3];
+    size_t count = 0;
+
+    // the extended protocol uses the frame size prefix
+    wxUint32 frameSize;
+    if ( m_extended )
+    {
+        frameSize = wxUINT32_SWAP_ON_BE(m_frameOut.GetDataLen());
+        vecs[count++] = wxSocketIOVec(&frameSize, sizeof(frameSize));
+    }
+
+    vecs[count++] = wxSocketIOVec(m_frameOut.GetData(), m_frameOut.GetDataLen());
+
+    if ( m_directSize )
+        vecs[count++] = wxSocketIOVec(m_directData, m_directSize);
+
+    m_sock.WriteV(vecs, count);
+
+    m_frameOut.Clear();
+    m_directData = nullptr;
+    m_directSize = 0;
+}
+
+wxUint8 wxIPCSocketStreams::ReadCode()
+{
+    Flush();
+
+    if ( !m_extended )
+        return m_dataIn.Read8();
+
+    // read the entire frame of the next message, discarding anything left
+    // from the previous one
+    wxUint32 frameSize;
+    if ( m_socketStream.Read(&frameSize, sizeof(frameSize)).LastRead()
+            != sizeof(frameSize) )
+        return 0;
+
+    frameSize = wxUINT32_SWAP_ON_BE(frameSize);
+
+    char * const frame = m_frameIn.Prepare(frameSize);
+    if ( m_socketStream.Read(frame, frameSize).LastRead() != frameSize )
+    {
+        m_frameIn.Prepare(0);
+        return 0;
+    }
+
+    return m_frameDataIn.Read8();
+}
+
+bool wxIPCSocketStreams::ReadRaw(void *data, size_t size)
+{
+    // start with the data remaining in the current frame, if any
+    size_t count = 0;
+    if ( m_extended )
+        count = m_frameIn.ReadFromFrame(data, size);
+
+    if ( count < size )
+    {
+        const size_t rest = size - count;
+        count += m_socketStream.Read(static_cast<char *>(data) + count,
+                                     rest).LastRead();
+    }
+
+    return count == size;
+}
+
+void *wxIPCSocketStreams::ReadData(wxConnectionBase *conn, size_t *size)
+{
+    Flush();
+
+    wxCHECK_MSG( conn, nullptr, "null connection parameter" );
+    wxCHECK_MSG( size, nullptr, "null size parameter" );
+
+    const int encoding = m_extended ? GetDataIn().Read8()
+                                    : static_cast<int>(IPC_DATA_INLINE);
+
+    *size = GetDataIn().Read32();
+
+    switch ( encoding )
+    {
+        case IPC_DATA_INLINE:
+            {
+                void * const data = conn->GetBufferAtLeast(*size);
+                wxCHECK_MSG( data, nullptr, "IPC buffer allocation failed" );
+
+                if ( !ReadRaw(data, *size) )
+                    return nullptr;
+
+                return data;
+            }
+
+#if wxUSE_ZLIB
+        case IPC_DATA_ZLIB:
+            {
+                m_compressedIn.resize(GetDataIn().Read32());
+                if ( !ReadRaw(m_compressedIn.data(), m_compressedIn.size()) )
+                    return nullptr;
+
+                void * const data = conn->GetBufferAtLeast(*size);
+                wxCHECK_MSG( data, nullptr, "IPC buffer allocation failed" );
+
+                if ( !Decompress(data, *size) )
+                {
+                    wxLogDebug("Failed to decompress IPC data.");
+                    return nullptr;
+                }
+
+                return data;
+            }
+#endif // wxUSE_ZLIB
+
+#ifdef wxHAS_IPC_SHARED_MEMORY
+        case IPC_DATA_SHARED:
+            {
+                const wxUint32 start = GetDataIn().Read32();
+                if ( !m_shm )
+                    break;
+
+                const void * const data = m_shm->GetData(start, *size);
+                if ( !data )
+                    break;
+
+                m_sharedReads++;
+                m_sharedEnd = start + *size;
+
+                return const_cast<void *>(data);
+            }
+#endif // wxHAS_IPC_SHARED_MEMORY
+    }
+
+    wxLogDebug("Invalid IPC data encoding %d.", encoding);
+
+    return nullptr;
+}
+
+void *wxIPCSocketStreams::ReadDataToBuffer(wxConnectionBase *conn, size_t *size)
+{
+    void * const data = ReadData(conn, size);
+
+#ifdef wxHAS_IPC_SHARED_MEMORY
+    if ( data && m_shm && m_shm->Contains(data) )
+    {
+        void * const buf = conn->GetBufferAtLeast(*size);
+        if ( buf )
+            memcpy(buf, data, *size);
+
+        ReleaseData(data);
+
+        return buf;
+    }
+#endif // wxHAS_IPC_SHARED_MEMORY
+
+    return data;
+}
+
+void wxIPCSocketStreams::ReleaseData(const void *data)
+{
+#ifdef wxHAS_IPC_SHARED_MEMORY
+    if ( data && m_shm && m_shm->Contains(data) )
+    {
+        wxCHECK_RET( m_sharedReads > 0, "releasing data not read" );
+
+        if ( !--m_sharedReads )
+            m_shm->Release(m_sharedEnd);
+    }
+#else // !wxHAS_IPC_SHARED_MEMORY
+    wxUnusedVar(data);
+#endif // wxHAS_IPC_SHARED_MEMORY/!wxHAS_IPC_SHARED_MEMORY
+}
+
+void wxIPCSocketStreams::AppendData(const void *data, size_t size)
+{
+    if ( size >= IPC_DIRECT_MIN_SIZE )
+    {
+        wxASSERT_MSG( !m_directSize, "data must be written last" );
+
+        m_directData = data;
+        m_directSize = size;
+    }
+    else
+    {
+        m_frameOut.Write(data, size);
+    }
+}
+
+void wxIPCSocketStreams::WriteData(const void *data, size_t size)
+{
+    if ( !m_extended )
+    {
+        m_dataOut.Write32(size);
+        AppendData(data, size);
+        return;
+    }
+
+#ifdef wxHAS_IPC_SHARED_MEMORY
+    if ( m_shm && size >= IPC_SHARED_MIN_SIZE )
+    {
+        wxUint32 start;
+        void * const buf = m_shm->Allocate(size, &start);
+
+        // if there is not enough space in the ring because the peer didn't
+        // read the previous data yet, just send this block inline
+        if ( buf )
+        {
+            memcpy(buf, data, size);
+
+            m_dataOut.Write8(IPC_DATA_SHARED);
+            m_dataOut.Write32(size);
+            m_dataOut.Write32(start);
+            return;
+        }
+    }
+#endif // wxHAS_IPC_SHARED_MEMORY
+
+#if wxUSE_ZLIB
+    if ( m_compress &&
+            (m_peerCapabilities & IPC_CAP_ZLIB) &&
+                size >= IPC_COMPRESS_MIN_SIZE &&
+                    Compress(data, size) )
+    {
+        m_dataOut.Write8(IPC_DATA_ZLIB);
+        m_dataOut.Write32(size);
+        m_dataOut.Write32(m_compressedOut.GetDataLen());
+        AppendData(m_compressedOut.GetData(), m_compressedOut.GetDataLen());
+        return;
+    }
+#endif // wxUSE_ZLIB
+
+    m_dataOut.Write8(IPC_DATA_INLINE);
+    m_dataOut.Write32(size);
+    AppendData(data, size);
+}
+
+#if wxUSE_ZLIB
+
+bool wxIPCSocketStreams::Compress(const void *data, size_t size)
+{
+    m_compressedOut.Clear();
+
+    // favour speed over the compression ratio as the data is typically sent
+    // over a fast network
+    wxZlibOutputStream zstream(m_compressedOut, wxZ_BEST_SPEED);
+    if ( !zstream.WriteAll(data, size) || !zstream.Close() )
+        return false;
+
+    return m_compressedOut.GetDataLen() < size;
+}
+
+bool wxIPCSocketStreams::Decompress(void *data, size_t size)
+{
+    wxMemoryInputStream mstream(m_compressedIn.data(), m_compressedIn.size());
+    wxZlibInputStream zstream(mstream, wxZLIB_ZLIB);
+
+    return zstream.ReadAll(data, size);
+}
+
+#endif // wxUSE_ZLIB
+
+/* static */
+wxUint32 wxIPCSocketStreams::GetCapabilities()
+{
+    wxUint32 caps = 0;
+
+#ifdef wxHAS_IPC_SHARED_MEMORY
+#if wxUSE_SYSTEM_OPTIONS
+    if ( !wxSystemOptions::GetOptionInt("ipc.no-shared-memory") )
+#endif // wxUSE_SYSTEM_OPTIONS
+        caps |= IPC_CAP_SHARED_MEMORY;
+#endif // wxHAS_IPC_SHARED_MEMORY
+
+#if wxUSE_ZLIB
+    caps |= IPC_CAP_ZLIB;
+#endif // wxUSE_ZLIB
+
+    return caps;
+}
+
+void wxIPCSocketStreams::NegotiateExtensions()
+{
+    IPCOutput(this).Write8(IPC_CAPABILITIES);
+
+    // old servers don't support the extended protocol at all
+    if ( ReadCode() != IPC_CAPABILITIES )
+        return;
+
+    m_peerCapabilities = Read32();
+    m_extended = true;
+
+    {
+        IPCOutput out(this);
+        out.Write8(IPC_CAPABILITIES);
+        out.Write32(GetCapabilities());
+    }
+
+#ifdef wxHAS_IPC_SHARED_MEMORY
+    if ( m_peerCapabilities & GetCapabilities() & IPC_CAP_SHARED_MEMORY )
+    {
+        std::unique_ptr<IPCSharedMemory> shm(new IPCSharedMemory);
+        if ( shm->Create() )
+        {
+            IPCOutput(this).Write(IPC_SHM_ATTACH, shm->GetName());
+
+            const bool attached = ReadCode() == IPC_SHM_ATTACH;
+
+            // the name is not needed any more once the server mapped it and
+            // removing it ensures that it's not left over if we crash
+            shm->Unlink();
+
+            if ( attached )
+                m_shm = std::move(shm);
+        }
+    }
+#endif // wxHAS_IPC_SHARED_MEMORY
+}
+
+void wxIPCSocketStreams::OnCapabilities()
+{
+    if ( m_extended )
+    {
+        // this is the client telling us about its capabilities
+        m_peerCapabilities = Read32();
+        return;
+    }
+
+    // this is the client asking about our capabilities, notice that the reply
+    // still uses the legacy protocol
+    {
+        IPCOutput out(this);
+        out.Write8(IPC_CAPABILITIES);
+        out.Write32(GetCapabilities());
+    }
+
+    m_extended = true;
+}
+
+void wxIPCSocketStreams::OnAttachSharedMemory()
+{
+    const wxString name = ReadString();
+
+    bool ok = false;
+
+#ifdef wxHAS_IPC_SHARED_MEMORY
+    if ( !m_shm && (GetCapabilities() & IPC_CAP_SHARED_MEMORY) )
+    {
+        std::unique_ptr<IPCSharedMemory> shm(new IPCSharedMemory);
+        if ( shm->Attach(name) )
+        {
+            m_shm = std::move(shm);
+            ok = true;
+        }
+    }
+#endif // wxHAS_IPC_SHARED_MEMORY
+
+    IPCOutput(this).Write8(ok ? IPC_SHM_ATTACH : IPC_FAIL);
+}
+
 // ==========================================================================
 // implementation
 // ==========================================================================
@@ -385,7 +1241,7 @@ wxConnectionBase *wxTCPClient::MakeConnection(const wxString& host,
         // Send topic name, and enquire whether this has succeeded
         IPCOutput(streams).Write(IPC_CONNECT, topic);
 
-        unsigned char msg = streams->Read8();
+        unsigned char msg = streams->ReadCode();
 
         // OK! Confirmation.
         if (msg == IPC_CONNECT)
@@ -397,6 +1253,10 @@ wxConnectionBase *wxTCPClient::MakeConnection(const wxString& host,
             {
                 if (wxDynamicCast(connection, wxTCPConnection))
                 {
+                    // Use the extended protocol if the server supports it
+                    streams->NegotiateExtensions();
+                    streams->EnableCompression(connection->m_compress);
+
                     connection->m_topic = topic;
                     connection->m_sock  = client;
                     connection->m_streams = streams;
@@ -544,6 +1404,7 @@ void wxTCPConnection::Init()
 {
     m_sock = nullptr;
     m_streams = nullptr;
+    m_compress = false;
 }
 
 wxTCPConnection::~wxTCPConnection()
@@ -559,9 +1420,12 @@ wxTCPConnection::~wxTCPConnection()
     delete m_streams;
 }
 
-void wxTCPConnection::Compress(bool WXUNUSED(on))
+void wxTCPConnection::Compress(bool on)
 {
-    // TODO
+    m_compress = on;
+
+    if ( m_streams )
+        m_streams->EnableCompression(on);
 }
 
 // Calls that CLIENT can make.
@@ -610,15 +1474,18 @@ const void *wxTCPConnection::Request(const wxString& item,
 
     IPCOutput(m_streams).Write(IPC_REQUEST, item, format);
 
-    const int ret = m_streams->Read8();
+    const int ret = m_streams->ReadCode();
     if ( ret != IPC_REQUEST_REPLY )
         return nullptr;
 
     // ReadData() needs a non-null size pointer but the client code can call us
     // with null pointer (this makes sense if it knows that it always works
     // with NUL-terminated strings)
+    //
+    // notice that the data must be copied to our buffer as it must remain
+    // valid after returning
     size_t sizeFallback;
-    return m_streams->ReadData(this, size ? size : &sizeFallback);
+    return m_streams->ReadDataToBuffer(this, size ? size : &sizeFallback);
 }
 
 bool wxTCPConnection::DoPoke(const wxString& item,
@@ -643,7 +1510,7 @@ bool wxTCPConnection::StartAdvise(const wxString& item)
 
     IPCOutput(m_streams).Write(IPC_ADVISE_START, item);
 
-    const int ret = m_streams->Read8();
+    const int ret = m_streams->ReadCode();
 
     return ret == IPC_ADVISE_START;
 }
@@ -655,7 +1522,7 @@ bool wxTCPConnection::StopAdvise (const wxString& item)
 
     IPCOutput(m_streams).Write(IPC_ADVISE_STOP, item);
 
-    const int ret = m_streams->Read8();
+    const int ret = m_streams->ReadCode();
 
     return ret == IPC_ADVISE_STOP;
 }
@@ -728,7 +1595,7 @@ void wxTCPEventHandler::Client_OnRequest(wxSocketEvent &event)
 
     bool error = false;
 
-    const int msg = streams->Read8();
+    const int msg = streams->ReadCode();
     switch ( msg )
     {
         case IPC_EXECUTE:
@@ -738,9 +1605,14 @@ void wxTCPEventHandler::Client_OnRequest(wxSocketEvent &event)
                 void * const
                     data = streams->ReadFormatData(connection, &format, &size);
                 if ( data )
+                {
                     connection->OnExecute(topic, data, size, format);
+                    streams->ReleaseData(data);
+                }
                 else
+                {
                     error = true;
+                }
             }
             break;
 
@@ -754,9 +1626,14 @@ void wxTCPEventHandler::Client_OnRequest(wxSocketEvent &event)
                     data = streams->ReadFormatData(connection, &format, &size);
 
                 if ( data )
+                {
                     connection->OnAdvise(topic, item, data, size, format);
+                    streams->ReleaseData(data);
+                }
                 else
+                {
                     error = true;
+                }
             }
             break;
 
@@ -789,9 +1666,14 @@ void wxTCPEventHandler::Client_OnRequest(wxSocketEvent &event)
                 void * const data = streams->ReadData(connection, &size);
 
                 if ( data )
+                {
                     connection->OnPoke(topic, item, data, size, format);
+                    streams->ReleaseData(data);
+                }
                 else
+                {
                     error = true;
+                }
             }
             break;
 
@@ -836,6 +1718,14 @@ void wxTCPEventHandler::Client_OnRequest(wxSocketEvent &event)
             }
             break;
 
+        case IPC_CAPABILITIES:
+            streams->OnCapabilities();
+            break;
+
+        case IPC_SHM_ATTACH:
+            streams->OnAttachSharedMemory();
+            break;
+
         case IPC_DISCONNECT:
             HandleDisconnect(connection);
             break;
@@ -884,7 +1774,7 @@ void wxTCPEventHandler::Server_OnRequest(wxSocketEvent &event)
     {
         IPCOutput out(streams);
 
-        const int msg = streams->Read8();
+        const int msg = streams->ReadCode();
         if ( msg == IPC_CONNECT )
         {
             const wxString topic = streams->ReadString();
@@ -899,6 +1789,8 @@ void wxTCPEventHandler::Server_OnRequest(wxSocketEvent &event)
                     // Acknowledge success
                     out.Write8(IPC_CONNECT);
 
+                    streams->EnableCompression(new_connection->m_compress);
+
                     new_connection->m_sock = sock;
                     new_connection->m_streams = streams;
                     new_connection->m_topic = topic;
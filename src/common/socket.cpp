@@ -34,6 +34,8 @@
     #include "wx/filefn.h"
 #endif
 
+#include "wx/file.h"
+
 #include "wx/apptrait.h"
 #include "wx/sckaddr.h"
 #include "wx/scopeguard.h"
@@ -47,6 +49,26 @@
 
 #ifdef __UNIX__
     #include <errno.h>
+    #include <limits.h>
+#endif
+
+#ifdef __LINUX__
+    #include <fcntl.h>
+    #include <pthread.h>
+    #include <signal.h>
+    #include <sys/sendfile.h>
+
+    #ifdef wxHAS_MSG_ZEROCOPY
+        #include <poll.h>
+        #include <linux/errqueue.h>
+    #endif
+#endif // __LINUX__
+
+// maximal number of buffers passed to a single scatter/gather IO call
+#ifdef IOV_MAX
+    #define wxSOCKET_IOV_MAX IOV_MAX
+#else
+    #define wxSOCKET_IOV_MAX 16
 #endif
 
 // we use MSG_NOSIGNAL to avoid getting SIGPIPE when sending data to a remote
@@ -113,6 +135,13 @@ wxDEFINE_EVENT(wxEVT_SOCKET, wxSocketEvent);
 // discard buffer
 #define MAX_DISCARD_SIZE (10 * 1024)
 
+// size of the buffer used for sending files when this can't be done directly
+#define SENDFILE_BUFFER_SIZE (64 * 1024)
+
+// minimal size of the data sent using MSG_ZEROCOPY: for smaller writes setting
+// up the page pinning and waiting for the completion costs more than copying
+#define MIN_ZEROCOPY_SIZE (16 * 1024)
+
 #define wxTRACE_Socket wxT("wxSocket")
 
 // --------------------------------------------------------------------------
@@ -138,6 +167,123 @@ void SetTimeValFromMS(wxTimeVal_t& tv, unsigned long ms)
     tv.tv_usec = (ms % 1000) * 1000;
 }
 
+// Native buffers corresponding to the non-empty wxSocketIOVec ones and
+// allowing to skip over the already processed part of them.
+class SocketIOBufs
+{
+public:
+    SocketIOBufs(const wxSocketIOVec *vecs, size_t count)
+    {
+        m_bufs = m_static;
+        if ( count > WXSIZEOF(m_static) )
+        {
+            m_dynamic.resize(count);
+            m_bufs = &m_dynamic[0];
+        }
+
+        m_count = 0;
+        m_total = 0;
+        for ( size_t n = 0; n < count; n++ )
+        {
+            if ( !vecs[n].size )
+                continue;
+
+            wxCHECK_RET( vecs[n].data, "null buffer" );
+
+            wxSetSocketIOBuf(m_bufs[m_count++], vecs[n].data, vecs[n].size);
+            m_total += vecs[n].size;
+        }
+    }
+
+    bool IsEmpty() const { return m_count == 0; }
+
+    // total size of all the remaining buffers
+    wxUint64 GetTotal() const { return m_total; }
+
+    wxSocketIOBuf *Get() const { return m_bufs; }
+
+    int GetCount() const
+    {
+        return m_count > wxSOCKET_IOV_MAX ? wxSOCKET_IOV_MAX
+                                          : static_cast<int>(m_count);
+    }
+
+    // skip the given number of bytes which must not be greater than the
+    // total size of the remaining buffers
+    void Advance(wxUint32 n)
+    {
+        m_total -= n;
+
+        while ( n )
+        {
+            const wxUint32 size = wxGetSocketIOBufSize(*m_bufs);
+            if ( n < size )
+            {
+                wxSetSocketIOBuf(*m_bufs, wxGetSocketIOBufData(*m_bufs) + n,
+                                 size - n);
+                break;
+            }
+
+            n -= size;
+            m_bufs++;
+            m_count--;
+        }
+    }
+
+private:
+    wxSocketIOBuf m_static[8];
+    std::vector<wxSocketIOBuf> m_dynamic;
+
+    wxSocketIOBuf *m_bufs;
+    size_t m_count;
+    wxUint64 m_total;
+
+    wxDECLARE_NO_COPY_CLASS(SocketIOBufs);
+};
+
+#ifdef __LINUX__
+
+// There is no MSG_NOSIGNAL equivalent for sendfile() and splice(), so block
+// SIGPIPE in the current thread while using them instead and discard the
+// signal if it was generated.
+class BlockSigPipe
+{
+public:
+    BlockSigPipe()
+    {
+        sigemptyset(&m_set);
+        sigaddset(&m_set, SIGPIPE);
+
+        pthread_sigmask(SIG_BLOCK, &m_set, &m_old);
+    }
+
+    // must be called if EPIPE was returned, before the dtor
+    void DiscardSignal()
+    {
+        // don't discard the signal if it had been already blocked before, it
+        // might have been generated by something else then
+        if ( sigismember(&m_old, SIGPIPE) )
+            return;
+
+        const timespec ts = { 0, 0 };
+        while ( sigtimedwait(&m_set, nullptr, &ts) == -1 && errno == EINTR )
+            ;
+    }
+
+    ~BlockSigPipe()
+    {
+        pthread_sigmask(SIG_SETMASK, &m_old, nullptr);
+    }
+
+private:
+    sigset_t m_set,
+             m_old;
+
+    wxDECLARE_NO_COPY_CLASS(BlockSigPipe);
+};
+
+#endif // __LINUX__
+
 } // anonymous namespace
 
 // --------------------------------------------------------------------------
@@ -316,6 +462,14 @@ wxSocketImpl::wxSocketImpl(wxSocketBase& wxsocket)
     m_dobind          = true;
     m_initialRecvBufferSize = -1;
     m_initialSendBufferSize = -1;
+
+    m_manager = nullptr;
+
+#ifdef wxHAS_MSG_ZEROCOPY
+    m_zeroCopyState = ZeroCopy_Unknown;
+    m_zeroCopySent =
+    m_zeroCopyDone = 0;
+#endif // wxHAS_MSG_ZEROCOPY
 }
 
 wxSocketImpl::~wxSocketImpl()
@@ -535,7 +689,8 @@ wxSocketImpl *wxSocketImpl::Accept(wxSocketBase& wxsocket)
 
     wxScopeGuard closeSocket = wxMakeGuard(wxCloseSocket, fd);
 
-    wxSocketManager * const manager = wxSocketManager::Get();
+    // accepted sockets use the same manager as the listening one by default
+    wxSocketManager * const manager = GetManager();
     if ( !manager )
     {
         UpdateLastError();
@@ -657,19 +812,22 @@ int wxSocketImpl::RecvStream(void *buffer, int size)
     DO_WHILE_EINTR( ret, recv(m_fd, static_cast<char *>(buffer), size, 0) );
 
     if ( !ret )
-    {
-        // receiving 0 bytes for a TCP socket indicates that the connection was
-        // closed by peer so shut down our end as well (for UDP sockets empty
-        // datagrams are also possible)
-        m_establishing = false;
-        NotifyOnStateChange(wxSOCKET_LOST);
+        OnStreamClosed();
 
-        Shutdown();
+    return ret;
+}
 
-        // do not return an error in this case however
-    }
+void wxSocketImpl::OnStreamClosed()
+{
+    // receiving 0 bytes for a TCP socket indicates that the connection was
+    // closed by peer so shut down our end as well (for UDP sockets empty
+    // datagrams are also possible)
+    m_establishing = false;
+    NotifyOnStateChange(wxSOCKET_LOST);
 
-    return ret;
+    Shutdown();
+
+    // do not return an error in this case however
 }
 
 int wxSocketImpl::SendStream(const void *buffer, int size)
@@ -727,7 +885,248 @@ int wxSocketImpl::SendDgram(const void *buffer, int size)
     return ret;
 }
 
+int wxSocketImpl::RecvV(wxSocketIOBuf *bufs, int count)
+{
+#ifdef __WINDOWS__
+    #if wxUSE_WINSOCK2
+        DWORD received = 0,
+              flags = 0;
+
+        wxSockAddressStorage from;
+        WX_SOCKLEN_T fromlen = sizeof(from);
+
+        int rc;
+        if ( m_stream )
+            rc = WSARecv(m_fd, bufs, count, &received, &flags, nullptr, nullptr);
+        else
+            rc = WSARecvFrom(m_fd, bufs, count, &received, &flags,
+                             &from.addr, &fromlen, nullptr, nullptr);
+
+        if ( rc == SOCKET_ERROR )
+        {
+            if ( m_stream || WSAGetLastError() != WSAEMSGSIZE )
+                return SOCKET_ERROR;
+
+            // the datagram was truncated, as with RecvDgram(), don't consider
+            // it as an error
+            received = 0;
+            for ( int n = 0; n < count; n++ )
+                received += bufs[n].len;
+        }
+
+        const int ret = static_cast<int>(received);
+    #else // !wxUSE_WINSOCK2
+        // we can only use the first buffer without Winsock 2
+        return m_stream ? RecvStream(bufs[0].buf, bufs[0].len)
+                        : RecvDgram(bufs[0].buf, bufs[0].len);
+    #endif // wxUSE_WINSOCK2/!wxUSE_WINSOCK2
+#else // !__WINDOWS__
+    wxSockAddressStorage from;
+
+    msghdr msg = msghdr();
+    msg.msg_iov = bufs;
+    msg.msg_iovlen = count;
+    if ( !m_stream )
+    {
+        msg.msg_name = &from.addr;
+        msg.msg_namelen = sizeof(from);
+    }
+
+    int ret;
+    DO_WHILE_EINTR( ret, recvmsg(m_fd, &msg, 0) );
+
+    if ( ret == SOCKET_ERROR )
+        return SOCKET_ERROR;
+
+    const WX_SOCKLEN_T fromlen = msg.msg_namelen;
+#endif // __WINDOWS__/!__WINDOWS__
+
+#if !defined(__WINDOWS__) || wxUSE_WINSOCK2
+    if ( m_stream )
+    {
+        if ( !ret )
+            OnStreamClosed();
+    }
+    else
+    {
+        m_peer = wxSockAddressImpl(from.addr, fromlen);
+        if ( !m_peer.IsOk() )
+            return -1;
+    }
+
+    return ret;
+#endif
+}
+
+int wxSocketImpl::SendV(wxSocketIOBuf *bufs, int count)
+{
+    if ( !m_stream && !m_peer.IsOk() )
+    {
+        m_error = wxSOCKET_INVADDR;
+        return -1;
+    }
+
+#ifdef __WINDOWS__
+    #if wxUSE_WINSOCK2
+        DWORD sent = 0;
+
+        int rc;
+        if ( m_stream )
+            rc = WSASend(m_fd, bufs, count, &sent, 0, nullptr, nullptr);
+        else
+            rc = WSASendTo(m_fd, bufs, count, &sent, 0,
+                           m_peer.GetAddr(), m_peer.GetLen(), nullptr, nullptr);
+
+        return rc == SOCKET_ERROR ? SOCKET_ERROR : static_cast<int>(sent);
+    #else // !wxUSE_WINSOCK2
+        return m_stream ? SendStream(bufs[0].buf, bufs[0].len)
+                        : SendDgram(bufs[0].buf, bufs[0].len);
+    #endif // wxUSE_WINSOCK2/!wxUSE_WINSOCK2
+#else // !__WINDOWS__
+    msghdr msg = msghdr();
+    msg.msg_iov = bufs;
+    msg.msg_iovlen = count;
+    if ( !m_stream )
+    {
+        msg.msg_name = const_cast<sockaddr *>(m_peer.GetAddr());
+        msg.msg_namelen = m_peer.GetLen();
+    }
+
+#ifdef wxNEEDS_IGNORE_SIGPIPE
+    IgnoreSignal ignore(SIGPIPE);
+#endif
+
+    int ret;
+    DO_WHILE_EINTR( ret, sendmsg(m_fd, &msg, wxSOCKET_MSG_NOSIGNAL) );
+
+    return ret;
+#endif // __WINDOWS__/!__WINDOWS__
+}
+
+#ifdef wxHAS_MSG_ZEROCOPY
+
+int wxSocketImpl::SendZeroCopy(wxSocketIOBuf *bufs, int count, bool *timedOut)
+{
+    *timedOut = false;
+
+    if ( m_zeroCopyState == ZeroCopy_Unknown )
+    {
+        m_zeroCopyState = EnableSocketOption(SO_ZEROCOPY) == 0
+                            ? ZeroCopy_Enabled
+                            : ZeroCopy_Unsupported;
+    }
+
+    if ( m_zeroCopyState != ZeroCopy_Enabled )
+        return -2;
+
+    msghdr msg = msghdr();
+    msg.msg_iov = bufs;
+    msg.msg_iovlen = count;
+
+    int ret;
+    DO_WHILE_EINTR( ret, sendmsg(m_fd, &msg, MSG_ZEROCOPY | MSG_NOSIGNAL) );
+
+    if ( ret == -1 )
+    {
+        // ENOBUFS is returned if the pages can't be pinned because the
+        // socket option memory limit is exceeded, just copy the data then
+        return errno == ENOBUFS ? -2 : -1;
+    }
+
+    // every successful send generates a completion notification, even if
+    // the kernel decided to copy the data after all
+    m_zeroCopySent++;
+
+    // the caller is free to reuse the buffer as soon as we return, so we
+    // must wait until the kernel doesn't reference it any longer, which
+    // happens when the data is acknowledged by the peer or when the
+    // connection is reset, but not for longer than the socket timeout
+    const wxMilliClock_t timeEnd = wxGetLocalTimeMillis() +
+                                    m_timeout.tv_sec*1000 +
+                                    m_timeout.tv_usec/1000;
+
+    const int errnoOrig = errno;
+    while ( static_cast<wxInt32>(m_zeroCopySent - m_zeroCopyDone) > 0 )
+    {
+        const long timeLeft = wxMilliClockToLong(timeEnd - wxGetLocalTimeMillis());
+
+        // the notifications are signalled as errors on the socket
+        pollfd pfd = { m_fd, 0, 0 };
+        int rc = 0;
+        if ( timeLeft > 0 )
+            DO_WHILE_EINTR( rc, poll(&pfd, 1, timeLeft) );
+
+        if ( rc == 0 )
+        {
+            // the peer doesn't acknowledge the data, but it has been already
+            // queued and will be sent, so we must still return its size to
+            // avoid sending it again; the kernel may still need the buffer, so
+            // don't use zero copy for this socket any more to ensure that the
+            // rest of the data is copied and that we don't wait for the same
+            // notifications again
+            m_zeroCopyState = ZeroCopy_Unsupported;
+
+            *timedOut = true;
+            break;
+        }
+
+        if ( rc == -1 )
+            break;
+
+        char control[256];
+        msghdr msgErr = msghdr();
+        msgErr.msg_control = control;
+        msgErr.msg_controllen = sizeof(control);
+
+        // if this fails, the socket has a pending error or was closed but
+        // there are no notifications for us, which means that it's broken
+        // and we'll never get them, so there is no point in waiting longer
+        DO_WHILE_EINTR( rc, recvmsg(m_fd, &msgErr, MSG_ERRQUEUE) );
+        if ( rc == -1 )
+            break;
+
+        for ( cmsghdr *cm = CMSG_FIRSTHDR(&msgErr);
+              cm;
+              cm = CMSG_NXTHDR(&msgErr, cm) )
+        {
+            if ( !(cm->cmsg_level == SOL_IP && cm->cmsg_type == IP_RECVERR) &&
+                    !(cm->cmsg_level == SOL_IPV6 && cm->cmsg_type == IPV6_RECVERR) )
+                continue;
+
+            sock_extended_err err;
+            memcpy(&err, CMSG_DATA(cm), sizeof(err));
+            if ( err.ee_errno != 0 || err.ee_origin != SO_EE_ORIGIN_ZEROCOPY )
+                continue;
+
+            // each notification covers an inclusive range of send calls
+            m_zeroCopyDone += err.ee_data - err.ee_info + 1;
+        }
+    }
+
+    errno = errnoOrig;
+
+    return ret;
+}
+
+#endif // wxHAS_MSG_ZEROCOPY
+
 int wxSocketImpl::Read(void *buffer, int size)
+{
+    wxSocketIOBuf buf;
+    wxSetSocketIOBuf(buf, buffer, size);
+
+    return ReadV(&buf, 1);
+}
+
+int wxSocketImpl::Write(const void *buffer, int size)
+{
+    wxSocketIOBuf buf;
+    wxSetSocketIOBuf(buf, const_cast<void *>(buffer), size);
+
+    return WriteV(&buf, 1);
+}
+
+int wxSocketImpl::ReadV(wxSocketIOBuf *bufs, int count)
 {
     // server sockets can't be used for IO, only to accept new connections
     if ( m_fd == INVALID_SOCKET || m_server )
@@ -736,7 +1135,14 @@ int wxSocketImpl::Read(void *buffer, int size)
         return -1;
     }
 
-    int ret = m_stream ? RecvStream(buffer, size)
+    char * const buffer = wxGetSocketIOBufData(bufs[0]);
+    const int size = wxGetSocketIOBufSize(bufs[0]);
+
+    int ret;
+    if ( count > 1 )
+        ret = RecvV(bufs, count);
+    else
+        ret = m_stream ? RecvStream(buffer, size)
                        : RecvDgram(buffer, size);
 
     if ( ret == SOCKET_ERROR )
@@ -747,7 +1153,7 @@ int wxSocketImpl::Read(void *buffer, int size)
     return ret;
 }
 
-int wxSocketImpl::Write(const void *buffer, int size)
+int wxSocketImpl::WriteV(wxSocketIOBuf *bufs, int count)
 {
     if ( m_fd == INVALID_SOCKET || m_server )
     {
@@ -755,8 +1161,45 @@ int wxSocketImpl::Write(const void *buffer, int size)
         return -1;
     }
 
-    int ret = m_stream ? SendStream(buffer, size)
-                       : SendDgram(buffer, size);
+    int ret = -2;
+
+#ifdef wxHAS_MSG_ZEROCOPY
+    // zero copy requires waiting until the data is acknowledged by the peer,
+    // so it can't be used if we must not block
+    const wxSocketFlags flags = GetSocketFlags();
+    if ( m_stream &&
+            (flags & wxSOCKET_ZEROCOPY) && !(flags & wxSOCKET_NOWAIT_WRITE) )
+    {
+        size_t total = 0;
+        for ( int n = 0; n < count; n++ )
+            total += wxGetSocketIOBufSize(bufs[n]);
+
+        if ( total >= MIN_ZEROCOPY_SIZE )
+        {
+            bool timedOut;
+            ret = SendZeroCopy(bufs, count, &timedOut);
+            if ( timedOut )
+            {
+                // the data was sent but waiting for its acknowledgement timed
+                // out, let the caller know about it
+                m_error = wxSOCKET_TIMEDOUT;
+                return ret;
+            }
+        }
+    }
+#endif // wxHAS_MSG_ZEROCOPY
+
+    if ( ret == -2 )
+    {
+        const char * const buffer = wxGetSocketIOBufData(bufs[0]);
+        const int size = wxGetSocketIOBufSize(bufs[0]);
+
+        if ( count > 1 )
+            ret = SendV(bufs, count);
+        else
+            ret = m_stream ? SendStream(buffer, size)
+                           : SendDgram(buffer, size);
+    }
 
     if ( ret == SOCKET_ERROR )
         UpdateLastError();
@@ -766,6 +1209,69 @@ int wxSocketImpl::Write(const void *buffer, int size)
     return ret;
 }
 
+int wxSocketImpl::SendFile(int fd, wxFileOffset *offset, int size)
+{
+    if ( m_fd == INVALID_SOCKET || m_server )
+    {
+        m_error = wxSOCKET_INVSOCK;
+        return -1;
+    }
+
+#ifdef __LINUX__
+    if ( m_stream )
+    {
+        BlockSigPipe blockSigPipe;
+
+        off_t off = offset ? static_cast<off_t>(*offset) : 0;
+
+        int ret;
+        DO_WHILE_EINTR( ret, sendfile(m_fd, fd, offset ? &off : nullptr, size) );
+
+        // sendfile() doesn't support reading from pipes, but splice() does
+        // (and it only supports reading from the current position of a pipe)
+        if ( ret == -1 && errno == EINVAL && !offset )
+        {
+            DO_WHILE_EINTR( ret, splice(fd, nullptr, m_fd, nullptr, size,
+                                        SPLICE_F_MOVE) );
+
+            // this is returned if the input is not a pipe neither
+            if ( ret == -1 && errno == EINVAL )
+            {
+                m_error = wxSOCKET_INVOP;
+                return -1;
+            }
+        }
+        else if ( ret == -1 && (errno == EINVAL || errno == ENOSYS) )
+        {
+            m_error = wxSOCKET_INVOP;
+            return -1;
+        }
+
+        if ( ret == -1 )
+        {
+            if ( errno == EPIPE )
+                blockSigPipe.DiscardSignal();
+
+            UpdateLastError();
+            return -1;
+        }
+
+        if ( offset )
+            *offset = off;
+
+        m_error = wxSOCKET_NOERROR;
+        return ret;
+    }
+#else // !__LINUX__
+    wxUnusedVar(fd);
+    wxUnusedVar(offset);
+    wxUnusedVar(size);
+#endif // __LINUX__/!__LINUX__
+
+    m_error = wxSOCKET_INVOP;
+    return -1;
+}
+
 // ==========================================================================
 // wxSocketBase
 // ==========================================================================
@@ -987,22 +1493,50 @@ wxSocketBase& wxSocketBase::Read(void* buffer, wxUint32 nbytes)
     return *this;
 }
 
-wxUint32 wxSocketBase::DoRead(void* buffer_, wxUint32 nbytes)
+wxUint32 wxSocketBase::DoRead(void* buffer, wxUint32 nbytes)
+{
+    wxCHECK_MSG( buffer, 0, "null buffer" );
+
+    const wxSocketIOVec vec(buffer, nbytes);
+    return DoReadV(&vec, 1);
+}
+
+wxSocketBase& wxSocketBase::ReadV(const wxSocketIOVec *vecs, size_t count)
+{
+    wxSocketReadGuard read(this);
+
+    m_lcount_read = DoReadV(vecs, count);
+    m_lcount = m_lcount_read;
+
+    return *this;
+}
+
+wxUint32 wxSocketBase::DoReadV(const wxSocketIOVec *vecs, size_t count)
 {
     wxCHECK_MSG( m_impl, 0, "socket must be valid" );
+    wxCHECK_MSG( vecs || !count, 0, "null buffers" );
 
-    // We use pointer arithmetic here which doesn't work with void pointers.
-    char *buffer = static_cast<char *>(buffer_);
-    wxCHECK_MSG( buffer, 0, "null buffer" );
+    SocketIOBufs bufs(vecs, count);
+    wxCHECK_MSG( bufs.GetTotal() <= 0xffffffff, 0, "too much data to read" );
 
     // Try the push back buffer first, even before checking whether the socket
     // is valid to allow reading previously pushed back data from an already
     // closed socket.
-    wxUint32 total = GetPushback(buffer, nbytes, false);
-    nbytes -= total;
-    buffer += total;
+    wxUint32 total = 0;
+    while ( !bufs.IsEmpty() )
+    {
+        const wxSocketIOBuf& buf = *bufs.Get();
+        const wxUint32 size = wxGetSocketIOBufSize(buf);
+        const wxUint32 ret = GetPushback(wxGetSocketIOBufData(buf), size, false);
 
-    while ( nbytes )
+        total += ret;
+        bufs.Advance(ret);
+
+        if ( ret < size )
+            break;
+    }
+
+    while ( !bufs.IsEmpty() )
     {
         // our socket is non-blocking so Read() will return immediately if
         // there is nothing to read yet and it's more efficient to try it first
@@ -1011,7 +1545,7 @@ wxUint32 wxSocketBase::DoRead(void* buffer_, wxUint32 nbytes)
         // where we're not going to get notifications about socket being ready
         // for reading before we read all the existing data from it
         const int ret = !m_impl->m_stream || m_connected
-                            ? m_impl->Read(buffer, nbytes)
+                            ? m_impl->ReadV(bufs.Get(), bufs.GetCount())
                             : 0;
         if ( ret == -1 )
         {
@@ -1066,8 +1600,7 @@ wxUint32 wxSocketBase::DoRead(void* buffer_, wxUint32 nbytes)
         if ( !(m_flags & wxSOCKET_WAITALL_READ) )
             break;
 
-        nbytes -= ret;
-        buffer += ret;
+        bufs.Advance(ret);
     }
 
     return total;
@@ -1207,15 +1740,106 @@ wxSocketBase& wxSocketBase::Write(const void *buffer, wxUint32 nbytes)
     return *this;
 }
 
-// This function is a mirror image of DoRead() except that it doesn't use the
+wxUint32 wxSocketBase::DoWrite(const void *buffer, wxUint32 nbytes)
+{
+    wxCHECK_MSG( buffer, 0, "null buffer" );
+
+    const wxSocketIOVec vec(buffer, nbytes);
+    return DoWriteV(&vec, 1);
+}
+
+wxSocketBase& wxSocketBase::WriteV(const wxSocketIOVec *vecs, size_t count)
+{
+    wxSocketWriteGuard write(this);
+
+    m_lcount_write = DoWriteV(vecs, count);
+    m_lcount = m_lcount_write;
+
+    return *this;
+}
+
+// This function is a mirror image of DoReadV() except that it doesn't use the
 // push back buffer and doesn't treat 0 return value specially (normally this
 // shouldn't happen at all here), so please see comments there for explanations
-wxUint32 wxSocketBase::DoWrite(const void *buffer_, wxUint32 nbytes)
+wxUint32 wxSocketBase::DoWriteV(const wxSocketIOVec *vecs, size_t count)
 {
     wxCHECK_MSG( m_impl, 0, "socket must be valid" );
+    wxCHECK_MSG( vecs || !count, 0, "null buffers" );
 
-    const char *buffer = static_cast<const char *>(buffer_);
-    wxCHECK_MSG( buffer, 0, "null buffer" );
+    SocketIOBufs bufs(vecs, count);
+    wxCHECK_MSG( bufs.GetTotal() <= 0xffffffff, 0, "too much data to write" );
+
+    wxUint32 total = 0;
+    while ( !bufs.IsEmpty() )
+    {
+        if ( m_impl->m_stream && !m_connected )
+        {
+            if ( (m_flags & wxSOCKET_WAITALL_WRITE) || !total )
+                SetError(wxSOCKET_IOERR);
+            break;
+        }
+
+        const int ret = m_impl->WriteV(bufs.Get(), bufs.GetCount());
+        if ( ret == -1 )
+        {
+            if ( m_impl->GetError() == wxSOCKET_WOULDBLOCK )
+            {
+                if ( m_flags & wxSOCKET_NOWAIT_WRITE )
+                    break;
+
+                if ( !DoWaitWithTimeout(wxSOCKET_OUTPUT_FLAG) )
+                {
+                    SetError(wxSOCKET_TIMEDOUT);
+                    break;
+                }
+
+                continue;
+            }
+            else // "real" error
+            {
+                SetError(wxSOCKET_IOERR);
+                break;
+            }
+        }
+
+        total += ret;
+
+        // the data was sent using wxSOCKET_ZEROCOPY but the peer didn't
+        // acknowledge it in time
+        if ( m_impl->GetError() == wxSOCKET_TIMEDOUT )
+        {
+            SetError(wxSOCKET_TIMEDOUT);
+            break;
+        }
+
+        if ( !(m_flags & wxSOCKET_WAITALL_WRITE) )
+            break;
+
+        bufs.Advance(ret);
+    }
+
+    return total;
+}
+
+#if wxUSE_FILE
+
+wxSocketBase&
+wxSocketBase::SendFile(wxFile& file, wxFileOffset offset, wxUint32 nbytes)
+{
+    wxSocketWriteGuard write(this);
+
+    m_lcount_write = DoSendFile(file, offset, nbytes);
+    m_lcount = m_lcount_write;
+
+    return *this;
+}
+
+// This function works like DoWrite() but uses the file as the data source.
+wxUint32
+wxSocketBase::DoSendFile(wxFile& file, wxFileOffset offset, wxUint32 nbytes)
+{
+    wxCHECK_MSG( m_impl, 0, "socket must be valid" );
+    wxCHECK_MSG( file.IsOpened(), 0, "file must be opened" );
 
     wxUint32 total = 0;
     while ( nbytes )
@@ -1227,7 +1851,10 @@ wxUint32 wxSocketBase::DoWrite(const void *buffer_, wxUint32 nbytes)
             break;
         }
 
-        const int ret = m_impl->Write(buffer, nbytes);
+        const int ret = m_impl->SendFile(file.fd(),
+                                         offset == wxInvalidOffset ? nullptr
+                                                                   : &offset,
+                                         nbytes > INT_MAX ? INT_MAX : nbytes);
         if ( ret == -1 )
         {
             if ( m_impl->GetError() == wxSOCKET_WOULDBLOCK )
@@ -1243,12 +1870,26 @@ wxUint32 wxSocketBase::DoWrite(const void *buffer_, wxUint32 nbytes)
 
                 continue;
             }
+            else if ( m_impl->GetError() == wxSOCKET_INVOP )
+            {
+                // this file or socket can't be used with sendfile(), but we
+                // can still send the data in the usual way
+                total += DoSendFileByCopying(file, offset, nbytes);
+                break;
+            }
             else // "real" error
             {
                 SetError(wxSOCKET_IOERR);
                 break;
             }
         }
+        else if ( ret == 0 )
+        {
+            // we reached the end of the file before sending everything
+            if ( (m_flags & wxSOCKET_WAITALL_WRITE) || !total )
+                SetError(wxSOCKET_IOERR);
+            break;
+        }
 
         total += ret;
 
@@ -1256,19 +1897,72 @@ wxUint32 wxSocketBase::DoWrite(const void *buffer_, wxUint32 nbytes)
             break;
 
         nbytes -= ret;
-        buffer += ret;
     }
 
     return total;
 }
 
+wxUint32
+wxSocketBase::DoSendFileByCopying(wxFile& file,
+                                  wxFileOffset offset,
+                                  wxUint32 nbytes)
+{
+    // as with sendfile(), the current position is only changed if we don't
+    // send the data from the given offset
+    const wxFileOffset posOld = file.Tell();
+    if ( offset != wxInvalidOffset && file.Seek(offset) == wxInvalidOffset )
+    {
+        SetError(wxSOCKET_IOERR);
+        return 0;
+    }
+
+    std::vector<char> buffer(wxMin(nbytes, SENDFILE_BUFFER_SIZE));
+
+    wxUint32 total = 0;
+    while ( nbytes )
+    {
+        const ssize_t len = file.Read(&buffer[0],
+                                      wxMin(nbytes, buffer.size()));
+        if ( len == wxInvalidOffset )
+        {
+            SetError(wxSOCKET_IOERR);
+            break;
+        }
+
+        if ( !len )
+        {
+            if ( (m_flags & wxSOCKET_WAITALL_WRITE) || !total )
+                SetError(wxSOCKET_IOERR);
+            break;
+        }
+
+        const wxUint32 written = DoWrite(&buffer[0], len);
+        total += written;
+        nbytes -= written;
+
+        if ( written != static_cast<wxUint32>(len) )
+            break;
+
+        if ( !(m_flags & wxSOCKET_WAITALL_WRITE) )
+            break;
+    }
+
+    // don't leave the position after the data which we didn't send and
+    // restore it if we used an explicit offset
+    file.Seek(offset == wxInvalidOffset ? posOld + total : posOld);
+
+    return total;
+}
+
+#endif // wxUSE_FILE
+
 wxSocketBase& wxSocketBase::WriteMsg(const void *buffer, wxUint32 nbytes)
 {
     struct
     {
         unsigned char sig[4];
         unsigned char len[4];
-    } msg;
+    } msg, trailer;
 
     wxSocketWriteGuard write(this);
 
@@ -1284,28 +1978,48 @@ wxSocketBase& wxSocketBase::WriteMsg(const void *buffer, wxUint32 nbytes)
     msg.len[2] = (unsigned char) ((nbytes >> 16) & 0xff);
     msg.len[3] = (unsigned char) ((nbytes >> 24) & 0xff);
 
-    bool ok = false;
-    if ( DoWrite(&msg, sizeof(msg)) == sizeof(msg) )
+    trailer.sig[0] = (unsigned char) 0xed;
+    trailer.sig[1] = (unsigned char) 0xfe;
+    trailer.sig[2] = (unsigned char) 0xad;
+    trailer.sig[3] = (unsigned char) 0xde;
+    trailer.len[0] =
+    trailer.len[1] =
+    trailer.len[2] =
+    trailer.len[3] = (char) 0;
+
+    const wxSocketIOVec vecs[] =
     {
-        m_lcount_write = DoWrite(buffer, nbytes);
-        m_lcount = m_lcount_write;
-        if ( m_lcount_write == nbytes )
+        wxSocketIOVec(&msg, sizeof(msg)),
+        wxSocketIOVec(buffer, nbytes),
+        wxSocketIOVec(&trailer, sizeof(trailer)),
+    };
+
+    wxUint32 written = 0;
+    if ( m_impl->m_stream )
+    {
+        // send everything using as few system calls as possible
+        written = DoWriteV(vecs, WXSIZEOF(vecs));
+    }
+    else
+    {
+        // but each part must be sent in its own datagram for datagram sockets
+        for ( size_t n = 0; n < WXSIZEOF(vecs); n++ )
         {
-            msg.sig[0] = (unsigned char) 0xed;
-            msg.sig[1] = (unsigned char) 0xfe;
-            msg.sig[2] = (unsigned char) 0xad;
-            msg.sig[3] = (unsigned char) 0xde;
-            msg.len[0] =
-            msg.len[1] =
-            msg.len[2] =
-            msg.len[3] = (char) 0;
-
-            if ( DoWrite(&msg, sizeof(msg)) == sizeof(msg))
-                ok = true;
+            const wxUint32 ret = DoWriteV(&vecs[n], 1);
+            written += ret;
+            if ( ret != vecs[n].size )
+                break;
         }
     }
 
-    if ( !ok )
+    // only the message itself is counted, not the header and the trailer
+    if ( written > sizeof(msg) )
+    {
+        m_lcount_write = wxMin(written - sizeof(msg), nbytes);
+        m_lcount = m_lcount_write;
+    }
+
+    if ( written != sizeof(msg) + nbytes + sizeof(trailer) )
         SetError(wxSOCKET_IOERR);
 
     return *this;
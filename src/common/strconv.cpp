@@ -57,6 +57,18 @@
     #define WC_UTF16
 #endif
 
+// SIMD instructions used for handling ASCII text faster in UTF-8 conversions,
+// only use those always available for the target architecture to avoid the
+// need for checking for their availability at run-time
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define wxHAS_SSE2_ASCII
+    #include <emmintrin.h>
+#elif (defined(__aarch64__) && defined(__ARM_NEON)) || defined(_M_ARM64)
+    #define wxHAS_NEON_ASCII
+    #include <arm_neon.h>
+#endif
+
 
 // ============================================================================
 // implementation
@@ -943,119 +955,296 @@ extern const unsigned char tableUtf8Lengths[256] = {
                    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0   // F5..FF
 };
 
-size_t
-wxMBConvStrictUTF8::ToWChar(wchar_t *dst, size_t dstLen,
-                            const char *src, size_t srcLen) const
+namespace
 {
-    wchar_t *out = dstLen ? dst : nullptr;
-    size_t written = 0;
 
-    if ( srcLen == wxNO_LEN )
-        srcLen = strlen(src) + 1;
+// Bulk conversion is only worth it for runs of several ASCII characters,
+// while in non-Latin text they are typically short, so it is only used if
+// there are at least this many of them.
+const size_t ASCII_RUN_MIN = 4;
 
-    for ( const char *p = src; ; p++ )
+// Converts the longest prefix of src, of at most len bytes, consisting of
+// ASCII characters only to wchar_t and returns its length. If dst is null,
+// just returns the length.
+size_t ConvertASCIIToWChar(wchar_t *dst, const char *src, size_t len)
+{
+    size_t n = 0;
+
+#if defined(wxHAS_SSE2_ASCII)
+    const __m128i zero = _mm_setzero_si128();
+    for ( ; n + 16 <= len; n += 16 )
     {
-        if ( (srcLen == wxNO_LEN ? !*p : !srcLen) )
-        {
-            // all done successfully, just add the trailing NUL if we are not
-            // using explicit length
-            if ( srcLen == wxNO_LEN )
-            {
-                if ( out )
-                {
-                    if ( !dstLen )
-                        break;
+        const __m128i v = _mm_loadu_si128((const __m128i*)(src + n));
+        if ( _mm_movemask_epi8(v) )
+            break;
 
-                    *out = L'\0';
-                }
+        if ( dst )
+        {
+            const __m128i lo = _mm_unpacklo_epi8(v, zero);
+            const __m128i hi = _mm_unpackhi_epi8(v, zero);
+#ifdef WC_UTF16
+            _mm_storeu_si128((__m128i*)(dst + n), lo);
+            _mm_storeu_si128((__m128i*)(dst + n + 8), hi);
+#else
+            _mm_storeu_si128((__m128i*)(dst + n), _mm_unpacklo_epi16(lo, zero));
+            _mm_storeu_si128((__m128i*)(dst + n + 4), _mm_unpackhi_epi16(lo, zero));
+            _mm_storeu_si128((__m128i*)(dst + n + 8), _mm_unpacklo_epi16(hi, zero));
+            _mm_storeu_si128((__m128i*)(dst + n + 12), _mm_unpackhi_epi16(hi, zero));
+#endif
+        }
+    }
+#elif defined(wxHAS_NEON_ASCII)
+    for ( ; n + 16 <= len; n += 16 )
+    {
+        const uint8x16_t v = vld1q_u8((const uint8_t*)(src + n));
+        if ( vmaxvq_u8(v) & 0x80 )
+            break;
 
-                written++;
-            }
+        if ( dst )
+        {
+            const uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+            const uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+#ifdef WC_UTF16
+            vst1q_u16((uint16_t*)(dst + n), lo);
+            vst1q_u16((uint16_t*)(dst + n + 8), hi);
+#else
+            vst1q_u32((uint32_t*)(dst + n), vmovl_u16(vget_low_u16(lo)));
+            vst1q_u32((uint32_t*)(dst + n + 4), vmovl_u16(vget_high_u16(lo)));
+            vst1q_u32((uint32_t*)(dst + n + 8), vmovl_u16(vget_low_u16(hi)));
+            vst1q_u32((uint32_t*)(dst + n + 12), vmovl_u16(vget_high_u16(hi)));
+#endif
+        }
+    }
+#else // no SIMD, check 8 bytes at once
+    for ( ; n + 8 <= len; n += 8 )
+    {
+        wxUint64 word;
+        memcpy(&word, src + n, sizeof(word));
+        if ( word & wxULL(0x8080808080808080) )
+            break;
 
-            return written;
+        if ( dst )
+        {
+            for ( size_t i = n; i < n + 8; i++ )
+                dst[i] = (unsigned char)src[i];
         }
+    }
+#endif
 
-        if ( out && !dstLen-- )
+    for ( ; n < len; n++ )
+    {
+        const unsigned char c = src[n];
+        if ( c & 0x80 )
             break;
 
-        wxUint32 code;
-        unsigned char c = *p;
+        if ( dst )
+            dst[n] = c;
+    }
 
-        if ( c < 0x80 )
-        {
-            if ( srcLen == 0 ) // the test works for wxNO_LEN too
-                break;
+    return n;
+}
 
-            if ( srcLen != wxNO_LEN )
-                srcLen--;
+// Converts the longest prefix of src, of at most len characters, consisting
+// of ASCII characters only to char and returns its length. If dst is null,
+// just returns the length.
+size_t ConvertWCharToASCII(char *dst, const wchar_t *src, size_t len)
+{
+    size_t n = 0;
+
+#if defined(wxHAS_SSE2_ASCII)
+    const __m128i zero = _mm_setzero_si128();
+#ifdef WC_UTF16
+    const __m128i nonASCII = _mm_set1_epi16(-0x80);
+#else
+    const __m128i nonASCII = _mm_set1_epi32(-0x80);
+#endif
+    for ( ; n + 16 <= len; n += 16 )
+    {
+        const __m128i* const p = (const __m128i*)(src + n);
+#ifdef WC_UTF16
+        const __m128i v0 = _mm_loadu_si128(p);
+        const __m128i v1 = _mm_loadu_si128(p + 1);
+        const __m128i all = _mm_or_si128(v0, v1);
+        if ( _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(all, nonASCII),
+                                               zero)) != 0xffff )
+            break;
+
+        if ( dst )
+            _mm_storeu_si128((__m128i*)(dst + n), _mm_packus_epi16(v0, v1));
+#else
+        const __m128i v0 = _mm_loadu_si128(p);
+        const __m128i v1 = _mm_loadu_si128(p + 1);
+        const __m128i v2 = _mm_loadu_si128(p + 2);
+        const __m128i v3 = _mm_loadu_si128(p + 3);
+        const __m128i all = _mm_or_si128(_mm_or_si128(v0, v1),
+                                         _mm_or_si128(v2, v3));
+        if ( _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(all, nonASCII),
+                                               zero)) != 0xffff )
+            break;
 
-            code = c;
+        if ( dst )
+        {
+            _mm_storeu_si128((__m128i*)(dst + n),
+                             _mm_packus_epi16(_mm_packs_epi32(v0, v1),
+                                              _mm_packs_epi32(v2, v3)));
         }
-        else
+#endif
+    }
+#elif defined(wxHAS_NEON_ASCII)
+    for ( ; n + 16 <= len; n += 16 )
+    {
+#ifdef WC_UTF16
+        const uint16_t* const p = (const uint16_t*)(src + n);
+        const uint16x8_t v0 = vld1q_u16(p);
+        const uint16x8_t v1 = vld1q_u16(p + 8);
+        if ( vmaxvq_u16(vorrq_u16(v0, v1)) >= 0x80 )
+            break;
+
+        if ( dst )
+            vst1q_u8((uint8_t*)(dst + n),
+                     vcombine_u8(vmovn_u16(v0), vmovn_u16(v1)));
+#else
+        const uint32_t* const p = (const uint32_t*)(src + n);
+        const uint32x4_t v0 = vld1q_u32(p);
+        const uint32x4_t v1 = vld1q_u32(p + 4);
+        const uint32x4_t v2 = vld1q_u32(p + 8);
+        const uint32x4_t v3 = vld1q_u32(p + 12);
+        if ( vmaxvq_u32(vorrq_u32(vorrq_u32(v0, v1),
+                                  vorrq_u32(v2, v3))) >= 0x80 )
+            break;
+
+        if ( dst )
         {
-            unsigned len = tableUtf8Lengths[c];
-            if ( !len )
-                break;
+            const uint16x8_t lo = vcombine_u16(vmovn_u32(v0), vmovn_u32(v1));
+            const uint16x8_t hi = vcombine_u16(vmovn_u32(v2), vmovn_u32(v3));
+            vst1q_u8((uint8_t*)(dst + n),
+                     vcombine_u8(vmovn_u16(lo), vmovn_u16(hi)));
+        }
+#endif
+    }
+#endif
 
-            if ( srcLen < len ) // the test works for wxNO_LEN too
-                break;
+    for ( ; n < len; n++ )
+    {
+        const wxUint32 c = src[n];
+        if ( c >= 0x80 )
+            break;
+
+        if ( dst )
+            dst[n] = (char)c;
+    }
 
-            if ( srcLen != wxNO_LEN )
-                srcLen -= len;
+    return n;
+}
 
-            //   Char. number range   |        UTF-8 octet sequence
-            //      (hexadecimal)     |              (binary)
-            //  ----------------------+----------------------------------------
-            //  0000 0000 - 0000 007F | 0xxxxxxx
-            //  0000 0080 - 0000 07FF | 110xxxxx 10xxxxxx
-            //  0000 0800 - 0000 FFFF | 1110xxxx 10xxxxxx 10xxxxxx
-            //  0001 0000 - 0010 FFFF | 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx
-            //
-            //  Code point value is stored in bits marked with 'x',
-            //  lowest-order bit of the value on the right side in the diagram
-            //  above.                                         (from RFC 3629)
+} // anonymous namespace
+
+size_t
+wxMBConvStrictUTF8::ToWChar(wchar_t *dst, size_t dstLen,
+                            const char *src, size_t srcLen) const
+{
+    wchar_t *out = dstLen ? dst : nullptr;
+    size_t written = 0;
 
-            // mask to extract lead byte's value ('x' bits above), by sequence
-            // length:
-            static const unsigned char leadValueMask[] = { 0x7F, 0x1F, 0x0F, 0x07 };
+    if ( srcLen == wxNO_LEN )
+        srcLen = strlen(src) + 1;
 
-            len--; // it's more convenient to work with 0-based length here
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(src);
+    const unsigned char * const end = p + srcLen;
 
-            code = c & leadValueMask[len];
+    while ( p != end )
+    {
+        if ( *p < 0x80 &&
+                static_cast<size_t>(end - p) >= ASCII_RUN_MIN &&
+                    (p[1] | p[2] | p[3]) < 0x80 &&
+                        (!out || dstLen >= ASCII_RUN_MIN) )
+        {
+            // Convert all the consecutive ASCII characters at once, this is
+            // much faster than doing it one by one.
+            size_t len = end - p;
+            if ( out )
+                len = wxMin(len, dstLen);
 
-            // all remaining bytes, if any, are handled in the same way
-            // regardless of sequence's length:
-            for ( ; len; --len )
-            {
-                c = *++p;
-                if ( (c & 0xC0) != 0x80 )
-                    return wxCONV_FAILED;
+            len = ConvertASCIIToWChar(out, reinterpret_cast<const char *>(p), len);
+            p += len;
+            written += len;
 
-                code <<= 6;
-                code |= c & 0x3F;
+            if ( out )
+            {
+                out += len;
+                dstLen -= len;
             }
+
+            continue;
+        }
+
+        const unsigned len = tableUtf8Lengths[*p];
+        if ( !len || static_cast<size_t>(end - p) < len )
+            return wxCONV_FAILED;
+
+        //   Char. number range   |        UTF-8 octet sequence
+        //      (hexadecimal)     |              (binary)
+        //  ----------------------+----------------------------------------
+        //  0000 0000 - 0000 007F | 0xxxxxxx
+        //  0000 0080 - 0000 07FF | 110xxxxx 10xxxxxx
+        //  0000 0800 - 0000 FFFF | 1110xxxx 10xxxxxx 10xxxxxx
+        //  0001 0000 - 0010 FFFF | 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx
+        //
+        //  Code point value is stored in bits marked with 'x',
+        //  lowest-order bit of the value on the right side in the diagram
+        //  above.                                         (from RFC 3629)
+
+        // mask to extract lead byte's value ('x' bits above), by sequence
+        // length:
+        static const unsigned char leadValueMask[] = { 0x7F, 0x1F, 0x0F, 0x07 };
+
+        wxUint32 code = *p++ & leadValueMask[len - 1];
+
+        // all remaining bytes are handled in the same way regardless of
+        // sequence's length:
+        for ( unsigned n = 1; n < len; n++ )
+        {
+            const unsigned char c = *p++;
+            if ( (c & 0xC0) != 0x80 )
+                return wxCONV_FAILED;
+
+            code <<= 6;
+            code |= c & 0x3F;
         }
 
 #ifdef WC_UTF16
-        // cast is ok because wchar_t == wxUint16 if WC_UTF16
-        if ( encode_utf16(code, (wxUint16 *)out) == 2 )
+        wxUint16 units[2];
+        const size_t numUnits = encode_utf16(code, units);
+        if ( numUnits == wxCONV_FAILED )
+            return wxCONV_FAILED;
+
+        if ( out )
         {
-            if ( out )
-                out++;
-            written++;
+            if ( dstLen < numUnits )
+                return wxCONV_FAILED;
+
+            // cast is ok because wchar_t == wxUint16 if WC_UTF16
+            memcpy(out, units, numUnits*sizeof(wxUint16));
+            out += numUnits;
+            dstLen -= numUnits;
         }
+
+        written += numUnits;
 #else // !WC_UTF16
         if ( out )
-            *out = code;
-#endif // WC_UTF16/!WC_UTF16
+        {
+            if ( !dstLen )
+                return wxCONV_FAILED;
 
-        if ( out )
-            out++;
+            *out++ = code;
+            dstLen--;
+        }
 
         written++;
+#endif // WC_UTF16/!WC_UTF16
     }
 
-    return wxCONV_FAILED;
+    return written;
 }
 
 size_t
@@ -1065,10 +1254,11 @@ wxMBConvStrictUTF8::FromWChar(char *dst, size_t dstLen,
     char *out = dstLen ? dst : nullptr;
     size_t written = 0;
 
-    const wchar_t* const end = srcLen == wxNO_LEN ? nullptr : src + srcLen;
+    const wchar_t* const end = src + (srcLen == wxNO_LEN ? wxWcslen(src)
+                                                         : srcLen);
     for ( const wchar_t *wp = src; ; )
     {
-        if ( end ? wp == end : !*wp )
+        if ( wp == end )
         {
             // all done successfully, just add the trailing NUL if we are not
             // using explicit length
@@ -1088,6 +1278,28 @@ wxMBConvStrictUTF8::FromWChar(char *dst, size_t dstLen,
             return written;
         }
 
+        if ( static_cast<wxUint32>(*wp) < 0x80 &&
+                static_cast<size_t>(end - wp) >= ASCII_RUN_MIN &&
+                    static_cast<wxUint32>(wp[1] | wp[2] | wp[3]) < 0x80 &&
+                        (!out || dstLen >= ASCII_RUN_MIN) )
+        {
+            // Convert all the consecutive ASCII characters at once.
+            const size_t len = ConvertWCharToASCII(out, wp,
+                                                   out ? wxMin(size_t(end - wp), dstLen)
+                                                       : size_t(end - wp));
+
+            wp += len;
+            written += len;
+
+            if ( out )
+            {
+                out += len;
+                dstLen -= len;
+            }
+
+            continue;
+        }
+
         wxUint32 code;
 #ifdef WC_UTF16
         code = *wp++;
@@ -1095,7 +1307,7 @@ wxMBConvStrictUTF8::FromWChar(char *dst, size_t dstLen,
         if ( IsSurrogate(code) )
         {
             // Check that we have the second part of the surrogate pair.
-            if ( end ? wp == end : !*wp )
+            if ( wp == end )
                 return wxCONV_FAILED;
 
             code = EncodeSurrogate(code, *wp++);
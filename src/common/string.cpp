@@ -110,13 +110,13 @@ void wxDumpStrCache() { wxStrCacheDumper::ShowAll(); }
 
 #ifdef wxPROFILE_STRING_CACHE
 
-wxString::CacheStats wxString::ms_cacheStats;
+wxString::PosToImplCacheStats wxString::ms_cacheStats;
 
 struct wxStrCacheStatsDumper
 {
     ~wxStrCacheStatsDumper()
     {
-        const wxString::CacheStats& stats = wxString::ms_cacheStats;
+        const wxString::PosToImplCacheStats& stats = wxString::ms_cacheStats;
 
         if ( stats.postot )
         {
@@ -138,6 +138,12 @@ struct wxStrCacheStatsDumper
             printf("\tNumber of calls to length(): %u, hits=%.2f%%\n",
                    stats.lentot, 100.*float(stats.lenhits)/stats.lentot);
         }
+
+        if ( stats.idxtot )
+        {
+            printf("\tNumber of position indices created: %u, used %u times\n",
+                   stats.idxtot, stats.idxhits);
+        }
     }
 };
 
@@ -229,7 +235,8 @@ std::wostream& operator<<(std::wostream& wos, const wxWCharBuffer& str)
 #if wxUSE_UNICODE_UTF8
 
 void wxString::PosLenToImpl(size_t pos, size_t len,
-                            size_t *implPos, size_t *implLen) const
+                            size_t *implPos, size_t *implLen,
+                            bool canCreateIndex) const
 {
     if ( pos == npos )
     {
@@ -237,14 +244,27 @@ void wxString::PosLenToImpl(size_t pos, size_t len,
     }
     else // have valid start position
     {
-        const const_iterator b = GetIterForNthChar(pos);
-        *implPos = wxStringImpl::const_iterator(b.impl()) - m_impl.begin();
+        *implPos = canCreateIndex ? IndexedPosToImpl(pos) : PosToImpl(pos);
         if ( len == npos )
         {
             *implLen = npos;
         }
         else // have valid length too
         {
+#if wxUSE_STRING_POS_INDEX
+            // if we have the index, use it to find the end of the substring
+            // instead of iterating over all of it
+            const PosIndex * const index = GetPosIndex();
+            if ( index && pos <= index->len )
+            {
+                const size_t end = len < index->len - pos ? pos + len
+                                                          : index->len;
+                *implLen = PosToImpl(end) - *implPos;
+                return;
+            }
+#endif // wxUSE_STRING_POS_INDEX
+
+            const const_iterator b(this, m_impl.begin() + *implPos);
             // we need to handle the case of length specifying a substring
             // going beyond the end of the string, just as std::string does
             const const_iterator e(end());
@@ -260,6 +280,112 @@ void wxString::PosLenToImpl(size_t pos, size_t len,
     }
 }
 
+#if wxUSE_STRING_POS_INDEX
+
+namespace
+{
+
+// check if the byte is the first one of an UTF-8 sequence
+inline bool IsUtf8LeadByte(char c)
+{
+    return (static_cast<unsigned char>(c) & 0xc0) != 0x80;
+}
+
+} // anonymous namespace
+
+const wxString::PosIndex *wxString::CreatePosIndex() const
+{
+    const char * const start = m_impl.data();
+    const size_t lenImpl = m_impl.length();
+
+    size_t len = 0;
+    for ( size_t n = 0; n < lenImpl; n++ )
+    {
+        if ( IsUtf8LeadByte(start[n]) )
+            len++;
+    }
+
+    // we don't need to store anything for ASCII strings
+    size_t *offsets = nullptr;
+    if ( len != lenImpl )
+    {
+        offsets = new size_t[len / PosIndex::STEP + 1];
+
+        size_t pos = 0;
+        for ( size_t n = 0; n < lenImpl; n++ )
+        {
+            if ( IsUtf8LeadByte(start[n]) )
+            {
+                if ( pos % PosIndex::STEP == 0 )
+                    offsets[pos / PosIndex::STEP] = n;
+
+                pos++;
+            }
+        }
+
+        if ( len % PosIndex::STEP == 0 )
+            offsets[len / PosIndex::STEP] = lenImpl;
+    }
+
+    PosIndex *index = new PosIndex(len, offsets);
+
+    // another thread could have created the index while we were doing it, in
+    // which case just use the existing one
+    PosIndex *existing = nullptr;
+    if ( !m_posIndex.ptr.compare_exchange_strong(existing, index,
+                                                 std::memory_order_acq_rel) )
+    {
+        delete index;
+        return existing;
+    }
+
+    wxCACHE_PROFILE_FIELD_INC(idxtot);
+
+    return index;
+}
+
+void wxString::DoResetPosIndex()
+{
+    delete m_posIndex.ptr.exchange(nullptr, std::memory_order_relaxed);
+}
+
+size_t wxString::DoPosFromImpl(size_t pos) const
+{
+    const PosIndex *index = GetPosIndex();
+    if ( !index )
+        index = CreatePosIndex();
+
+    wxCACHE_PROFILE_FIELD_INC(idxhits);
+
+    if ( !index->offsets )
+        return pos;
+
+    // find the last indexed character before the given offset
+    size_t lo = 0,
+           hi = index->len / PosIndex::STEP + 1;
+    while ( hi - lo > 1 )
+    {
+        const size_t mid = (lo + hi) / 2;
+        if ( index->offsets[mid] <= pos )
+            lo = mid;
+        else
+            hi = mid;
+    }
+
+    // and count the characters from it
+    size_t n = lo * PosIndex::STEP;
+    const char * const start = m_impl.data();
+    for ( size_t i = index->offsets[lo]; i < pos; i++ )
+    {
+        if ( IsUtf8LeadByte(start[i]) )
+            n++;
+    }
+
+    return n;
+}
+
+#endif // wxUSE_STRING_POS_INDEX
+
 #endif // wxUSE_UNICODE_UTF8
 
 // ----------------------------------------------------------------------------
@@ -1909,34 +2035,64 @@ wxString wxString::FormatV(const wxString& format, va_list argptr)
     return s;
 }
 
-#if !wxUSE_UTF8_LOCALE_ONLY
-int wxString::DoPrintfWchar(const wxChar *format, ...)
+namespace
 {
-    va_list argptr;
-    va_start(argptr, format);
 
-    int iLen = PrintfV(format, argptr);
+// Overloads of wxVsnprintf() taking the format string as a raw pointer: they
+// are used when the format has been already converted by wxFormatString to
+// the form expected by the standard function and avoid creating a temporary
+// wxString from it.
+#if !wxUSE_UTF8_LOCALE_ONLY
+int DoVsnprintf(wchar_t *buf, size_t size, const wchar_t *format, va_list argptr)
+{
+    const int rv = wxCRT_VsnprintfW(buf, size, format, argptr);
 
-    va_end(argptr);
+    // As in wxVsnprintf(), ensure that the result is always NUL-terminated.
+    if ( size )
+        buf[size - 1] = 0;
 
-    return iLen;
+    return rv;
 }
 #endif // !wxUSE_UTF8_LOCALE_ONLY
 
 #if wxUSE_UNICODE_UTF8
-int wxString::DoPrintfUtf8(const char *format, ...)
+int DoVsnprintf(char *buf, size_t size, const char *format, va_list argptr)
 {
-    va_list argptr;
-    va_start(argptr, format);
+    const int rv = wxCRT_VsnprintfA(buf, size, format, argptr);
 
-    int iLen = PrintfV(wxString::FromUTF8(format), argptr);
+    if ( size )
+        buf[size - 1] = 0;
 
-    va_end(argptr);
+    return rv;
+}
+#endif // wxUSE_UNICODE_UTF8
 
-    return iLen;
+template <typename CharType>
+int DoVsnprintf(CharType *buf, size_t size, const wxString& format, va_list argptr)
+{
+    return wxVsnprintf(buf, size, format, argptr);
+}
+
+// Set the string to the formatted result of the given length.
+inline void AssignFormatted(wxString& str, const wchar_t *buf, size_t len)
+{
+    str.assign(buf, len);
+}
+
+#if wxUSE_UNICODE_UTF8
+inline void AssignFormatted(wxString& str, const char *buf, size_t len)
+{
+    // Just as wxUTF8StringBuffer used below, don't put invalid UTF-8, which
+    // could have been written by vsnprintf(), into the string.
+    if ( wxStringOperations::IsValidUtf8String(buf, len) )
+        str = wxString::FromUTF8Unchecked(buf, len);
+    else
+        str.clear();
 }
 #endif // wxUSE_UNICODE_UTF8
 
+} // anonymous namespace
+
 /*
     Uses wxVsnprintf and places the result into the this string.
 
@@ -1970,28 +2126,52 @@ int wxString::DoPrintfUtf8(const char *format, ...)
     later result in out of memory error and crashing, so we also have to impose
     some arbitrary limit on it.
 */
-#if wxUSE_UNICODE_UTF8
-template<typename BufferType>
-#else
-// we only need one version in non-UTF8 builds and at least two Windows
-// compilers have problems with this function template, so use just one
-// normal function here
-#endif
+template<typename BufferType, typename FormatType>
 static int DoStringPrintfV(wxString& str,
-                           const wxString& format, va_list argptr)
+                           const FormatType& format, va_list argptr)
 {
-    size_t size = 1024;
+    typedef typename BufferType::CharType CharType;
+
+    size_t size;
     PreserveErrno preserveErrno;
 
+    // Most of the formatted strings are short, so start by formatting into a
+    // buffer on the stack: if it's big enough, this allows to allocate memory
+    // for the string only once, instead of allocating a big buffer in it and
+    // then shrinking it.
+    {
+        CharType buf[1024];
+
+        va_list argptrcopy;
+        wxVaCopy(argptrcopy, argptr);
+
+        errno = 0;
+        const int len = DoVsnprintf(buf, WXSIZEOF(buf), format, argptrcopy);
+        va_end(argptrcopy);
+
+        if ( len >= 0 )
+        {
+            if ( static_cast<size_t>(len) < WXSIZEOF(buf) )
+            {
+                AssignFormatted(str, buf, len);
+                return str.length();
+            }
+
+            // We know how much space we need, so use it in the loop below.
+            size = len + 1;
+        }
+        else
+        {
+            // The buffer is too small or an error occurred, we can't know
+            // which one, see the comment above, so let the loop handle it.
+            size = 2*WXSIZEOF(buf);
+        }
+    }
+
     for ( ;; )
     {
-#if wxUSE_UNICODE_UTF8
         BufferType tmp(str, size + 1);
-        typename BufferType::CharType *buf = tmp;
-#else
-        wxStringBuffer tmp(str, size + 1);
-        wxChar *buf = tmp;
-#endif
+        CharType *buf = tmp;
 
         if ( !buf )
         {
@@ -2006,7 +2186,7 @@ static int DoStringPrintfV(wxString& str,
 
         // Set errno to 0 to make it determinate if wxVsnprintf fails to set it.
         errno = 0;
-        int len = wxVsnprintf(buf, size, format, argptrcopy);
+        int len = DoVsnprintf(buf, size, format, argptrcopy);
         va_end(argptrcopy);
 
         // some implementations of vsnprintf() don't NUL terminate
@@ -2085,11 +2265,43 @@ int wxString::PrintfV(const wxString& format, va_list argptr)
         // wxChar* version
         return DoStringPrintfV<wxStringBuffer>(*this, format, argptr);
     #else
-        return DoStringPrintfV(*this, format, argptr);
+        return DoStringPrintfV<wxStringBuffer>(*this, format, argptr);
     #endif // UTF8/WCHAR
 #endif
 }
 
+// The functions below are called with the format string already converted by
+// wxFormatString, so they pass it to DoStringPrintfV() directly instead of
+// calling PrintfV() which would create a temporary wxString from it.
+
+#if !wxUSE_UTF8_LOCALE_ONLY
+int wxString::DoPrintfWchar(const wxChar *format, ...)
+{
+    va_list argptr;
+    va_start(argptr, format);
+
+    int iLen = DoStringPrintfV<wxStringBuffer>(*this, format, argptr);
+
+    va_end(argptr);
+
+    return iLen;
+}
+#endif // !wxUSE_UTF8_LOCALE_ONLY
+
+#if wxUSE_UNICODE_UTF8
+int wxString::DoPrintfUtf8(const char *format, ...)
+{
+    va_list argptr;
+    va_start(argptr, format);
+
+    int iLen = DoStringPrintfV<wxUTF8StringBuffer>(*this, format, argptr);
+
+    va_end(argptr);
+
+    return iLen;
+}
+#endif // wxUSE_UNICODE_UTF8
+
 // ----------------------------------------------------------------------------
 // misc other operations
 // ----------------------------------------------------------------------------
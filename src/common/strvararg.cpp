@@ -552,6 +552,242 @@ const wxScopedWCharBuffer wxScanfConvertFormatW(const wchar_t *format)
 #endif // !__WINDOWS__
 
 
+// ----------------------------------------------------------------------------
+// wxFormatString cache
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Format strings are almost always string literals and the same ones are used
+// again and again, so we cache the results of parsing and converting them to
+// avoid redoing it every time. The pointer to the format string is used as the
+// key, but as the same pointer could be reused for a different string (e.g. if
+// it points to a buffer on the stack), the string contents is checked too.
+template <typename CharType>
+struct FormatCacheEntry
+{
+    using OtherCharType = typename std::conditional<
+                            std::is_same<CharType, char>::value, wchar_t, char
+                          >::type;
+
+    // Return true if this entry corresponds to the given format string.
+    bool Matches(const CharType* format) const
+    {
+        return format == key && text.compare(format) == 0;
+    }
+
+    // Make this entry correspond to the given format string.
+    void Reset(const CharType* format)
+    {
+        key = format;
+        text.assign(format);
+
+        isAscii = true;
+        for ( const CharType* p = format; *p; ++p )
+        {
+            if ( static_cast<wxUint32>(*p) >= 0x80 )
+            {
+                isAscii = false;
+                break;
+            }
+        }
+
+        parsed = false;
+        argTypes.clear();
+
+        converted = false;
+        convertedSame.reset();
+        convertedOther.reset();
+    }
+
+    // The pointer used as the key and the copy of the string it pointed to.
+    const CharType* key = nullptr;
+    std::basic_string<CharType> text;
+
+    // True if the string contains only ASCII characters, so that converting
+    // it to the other character type doesn't depend on the current locale and
+    // the result of this conversion can be cached too.
+    bool isAscii = false;
+
+    // The types of all the arguments, with wxPAT_INVALID for the arguments
+    // without any format specifiers, only valid if "parsed" is true.
+    bool parsed = false;
+    std::vector<wxPrintfArgType> argTypes;
+
+    // The format string converted by wxFormatString::AsChar() or AsWChar() to
+    // the same character type, only valid if "converted" is true and null if
+    // the conversion didn't change the string.
+    bool converted = false;
+    wxScopedCharTypeBuffer<CharType> convertedSame;
+
+    // The format string converted to the other character type, only used for
+    // ASCII strings and null if not computed yet.
+    wxScopedCharTypeBuffer<OtherCharType> convertedOther;
+};
+
+// Per-thread cache of FormatCacheEntry objects.
+template <typename CharType>
+class FormatCache
+{
+public:
+    // Return the entry for the given format string, creating it if necessary,
+    // or null if the cache can't be used (any more).
+    static FormatCacheEntry<CharType>* Get(const CharType* format)
+    {
+        if ( !format || ms_destroyed )
+            return nullptr;
+
+        thread_local FormatCache<CharType> s_cache;
+
+        // Use high bits of the pointer too as string literals are typically
+        // stored next to each other.
+        const wxUIntPtr p = wxPtrToUInt(format);
+        FormatCacheEntry<CharType>& entry = s_cache.m_entries[(p ^ (p >> 7)) % SIZE];
+        if ( !entry.Matches(format) )
+            entry.Reset(format);
+
+        return &entry;
+    }
+
+    FormatCache() = default;
+
+    ~FormatCache()
+    {
+        // Format strings may still be used after the thread-specific objects
+        // are destroyed, e.g. for logging from global objects dtors, so
+        // remember not to use the cache after this.
+        ms_destroyed = true;
+    }
+
+private:
+    static const size_t SIZE = 64;
+
+    FormatCacheEntry<CharType> m_entries[SIZE];
+
+    static thread_local bool ms_destroyed;
+
+    wxDECLARE_NO_COPY_CLASS(FormatCache);
+};
+
+template <typename CharType>
+thread_local bool FormatCache<CharType>::ms_destroyed = false;
+
+// Return the format string converted by the given function to the format
+// string of the same character type, using the cache if possible.
+template <typename CharType, typename Converter>
+const CharType*
+ConvertFormatSameType(const CharType* format,
+                      wxScopedCharTypeBuffer<CharType>& buf,
+                      Converter convert)
+{
+    FormatCacheEntry<CharType>* entry = FormatCache<CharType>::Get(format);
+    if ( !entry )
+    {
+        buf = convert(format);
+        return buf.data();
+    }
+
+    if ( !entry->converted )
+    {
+        const wxScopedCharTypeBuffer<CharType> converted = convert(format);
+
+        // Don't keep the result if it's the same string as this would just
+        // be a non-owned buffer pointing to the original format string.
+        entry = FormatCache<CharType>::Get(format);
+        if ( converted.data() != format )
+            entry->convertedSame = converted;
+        entry->converted = true;
+    }
+
+    if ( !entry->convertedSame )
+        return format;
+
+    // Note that this doesn't allocate as the buffer is reference-counted.
+    buf = entry->convertedSame;
+    return buf.data();
+}
+
+// Return the format string converted by the given function to the other
+// character type, using the cache if possible.
+//
+// Notice that "convert" must return an owned buffer here.
+template <typename CharType, typename Converter>
+const typename FormatCacheEntry<CharType>::OtherCharType*
+ConvertFormatOtherType(const CharType* format,
+                       wxScopedCharTypeBuffer<
+                        typename FormatCacheEntry<CharType>::OtherCharType
+                       >& buf,
+                       Converter convert)
+{
+    FormatCacheEntry<CharType>* entry = FormatCache<CharType>::Get(format);
+    if ( !entry || !entry->isAscii )
+    {
+        buf = convert();
+        return buf.data();
+    }
+
+    if ( !entry->convertedOther )
+    {
+        buf = convert();
+
+        entry = FormatCache<CharType>::Get(format);
+        entry->convertedOther = buf;
+    }
+    else
+    {
+        buf = entry->convertedOther;
+    }
+
+    return buf.data();
+}
+
+// Types of all the arguments used by a format string.
+struct FormatArgTypes
+{
+    unsigned count = 0;
+    wxPrintfArgType types[wxMAX_SVNPRINTF_ARGUMENTS];
+};
+
+// Get the types of the arguments of the given format string, parsing it only
+// if it's not in the cache yet.
+//
+// This returns a copy of the types to allow the caller to use them even if
+// the cache entry is reused, e.g. because of formatting an assert message.
+template<typename CharType>
+void GetFormatArgTypes(const CharType* format, FormatArgTypes& argTypes)
+{
+    FormatCacheEntry<CharType>* entry = FormatCache<CharType>::Get(format);
+    if ( !entry || !entry->parsed )
+    {
+        wxPrintfConvSpecParser<CharType> parser(format);
+
+        argTypes.count = parser.nargs;
+        for ( unsigned n = 0; n < parser.nargs; ++n )
+        {
+            auto const pspec = parser.pspec[n];
+            argTypes.types[n] = pspec ? pspec->m_type : wxPAT_INVALID;
+        }
+
+        // Parsing the string could have used the cache, so check it again.
+        entry = FormatCache<CharType>::Get(format);
+        if ( entry )
+        {
+            entry->argTypes.assign(argTypes.types,
+                                   argTypes.types + argTypes.count);
+            entry->parsed = true;
+        }
+
+        return;
+    }
+
+    argTypes.count = entry->argTypes.size();
+    for ( unsigned n = 0; n < argTypes.count; ++n )
+        argTypes.types[n] = entry->argTypes[n];
+}
+
+} // anonymous namespace
+
 // ----------------------------------------------------------------------------
 // wxFormatString
 // ----------------------------------------------------------------------------
@@ -559,8 +795,8 @@ const wxScopedWCharBuffer wxScanfConvertFormatW(const wchar_t *format)
 #if !wxUSE_UNICODE_WCHAR
 const char* wxFormatString::InputAsChar()
 {
-    if ( m_char )
-        return m_char.data();
+    if ( const char* const input = GetInputChar() )
+        return input;
 
     // in this build, wx_str() returns UTF-8-encoded string and this function
     // is only called under UTF-8 locales, so we can just return it directly
@@ -573,27 +809,55 @@ const char* wxFormatString::InputAsChar()
 
     // the last case is that wide string was passed in: in that case, we need
     // to convert it:
-    wxASSERT( m_wchar );
+    wxASSERT( GetInputWChar() );
 
-    m_char = wxConvLibc.cWC2MB(m_wchar.data());
+    m_char = wxConvLibc.cWC2MB(GetInputWChar());
 
     return m_char.data();
 }
 
 const char* wxFormatString::AsChar()
 {
-    if ( !m_convertedChar )
-        m_convertedChar = wxPrintfFormatConverterUtf8().Convert(InputAsChar());
+    if ( m_convertedChar )
+        return m_convertedChar.data();
 
-    return m_convertedChar.data();
+    const char* input = GetInputChar();
+    if ( !input )
+    {
+        if ( m_str )
+            input = m_str->wx_str();
+        else if ( m_cstr )
+            input = m_cstr->AsInternal();
+    }
+
+    if ( input )
+    {
+        return ConvertFormatSameType(input, m_convertedChar,
+            [](const char* format)
+            {
+                return wxPrintfFormatConverterUtf8().Convert(format);
+            });
+    }
+
+    return ConvertFormatOtherType(GetInputWChar(), m_convertedChar,
+        [this]() -> wxScopedCharBuffer
+        {
+            const char* const format = InputAsChar();
+            const wxScopedCharBuffer
+                converted = wxPrintfFormatConverterUtf8().Convert(format);
+
+            // InputAsChar() result is owned by m_char, use it if the format
+            // didn't need to be changed.
+            return converted.data() == format ? m_char : converted;
+        });
 }
 #endif // !wxUSE_UNICODE_WCHAR
 
 #if !wxUSE_UTF8_LOCALE_ONLY
 const wchar_t* wxFormatString::InputAsWChar()
 {
-    if ( m_wchar )
-        return m_wchar.data();
+    if ( const wchar_t* const input = GetInputWChar() )
+        return input;
 
 #if wxUSE_UNICODE_WCHAR
     if ( m_str )
@@ -615,19 +879,59 @@ const wchar_t* wxFormatString::InputAsWChar()
 
     // the last case is that narrow string was passed in: in that case, we need
     // to convert it:
-    wxASSERT( m_char );
+    wxASSERT( GetInputChar() );
 
-    m_wchar = wxConvLibc.cMB2WC(m_char.data());
+    m_wchar = wxConvLibc.cMB2WC(GetInputChar());
 
     return m_wchar.data();
 }
 
 const wchar_t* wxFormatString::AsWChar()
 {
-    if ( !m_convertedWChar )
-        m_convertedWChar = wxPrintfFormatConverterWchar().Convert(InputAsWChar());
+    if ( m_convertedWChar )
+        return m_convertedWChar.data();
+
+    const wchar_t* input = GetInputWChar();
+#if wxUSE_UNICODE_WCHAR
+    if ( !input )
+    {
+        if ( m_str )
+            input = m_str->wc_str();
+        else if ( m_cstr )
+            input = m_cstr->AsInternal();
+    }
+#endif // wxUSE_UNICODE_WCHAR
+
+    if ( input )
+    {
+        return ConvertFormatSameType(input, m_convertedWChar,
+            [](const wchar_t* format)
+            {
+                return wxPrintfFormatConverterWchar().Convert(format);
+            });
+    }
+
+    const char* narrow = GetInputChar();
+#if wxUSE_UNICODE_UTF8
+    if ( !narrow )
+    {
+        if ( m_str )
+            narrow = m_str->wx_str();
+        else if ( m_cstr )
+            narrow = m_cstr->AsInternal();
+    }
+#endif // wxUSE_UNICODE_UTF8
 
-    return m_convertedWChar.data();
+    return ConvertFormatOtherType(narrow, m_convertedWChar,
+        [this]() -> wxScopedWCharBuffer
+        {
+            const wchar_t* const format = InputAsWChar();
+            const wxScopedWCharBuffer
+                converted = wxPrintfFormatConverterWchar().Convert(format);
+
+            // As in AsChar(), m_wchar owns InputAsWChar() result.
+            return converted.data() == format ? m_wchar : converted;
+        });
 }
 #endif // !wxUSE_UTF8_LOCALE_ONLY
 
@@ -637,10 +941,10 @@ wxString wxFormatString::InputAsString() const
         return *m_str;
     if ( m_cstr )
         return m_cstr->AsString();
-    if ( m_wchar )
-        return wxString(m_wchar);
-    if ( m_char )
-        return wxString(m_char);
+    if ( const wchar_t* const input = GetInputWChar() )
+        return wxString(input);
+    if ( const char* const input = GetInputChar() )
+        return wxString(input);
 
     wxFAIL_MSG( "invalid wxFormatString - not initialized?" );
     return wxString();
@@ -710,9 +1014,10 @@ wxFormatString::ArgumentType DoGetArgumentType(const CharType *format,
     wxCHECK_MSG( format, wxFormatString::Arg_Unknown,
                  "empty format string not allowed here" );
 
-    wxPrintfConvSpecParser<CharType> parser(format);
+    FormatArgTypes argTypes;
+    GetFormatArgTypes(format, argTypes);
 
-    if ( n > parser.nargs )
+    if ( n > argTypes.count )
     {
         // The n-th argument doesn't appear in the format string and is unused.
         // This can happen e.g. if a translation of the format string is used
@@ -724,33 +1029,35 @@ wxFormatString::ArgumentType DoGetArgumentType(const CharType *format,
         return wxFormatString::Arg_Unused;
     }
 
-    wxCHECK_MSG( parser.pspec[n-1] != nullptr, wxFormatString::Arg_Unknown,
+    wxCHECK_MSG( argTypes.types[n-1] != wxPAT_INVALID, wxFormatString::Arg_Unknown,
                  "requested argument not found - invalid format string?" );
 
-    return ArgTypeFromParamType(parser.pspec[n-1]->m_type);
+    return ArgTypeFromParamType(argTypes.types[n-1]);
 }
 
 #if wxDEBUG_LEVEL
 
 template<typename CharType>
-void DoValidateFormat(const CharType* format, const std::vector<int>& argTypes)
+void DoValidateFormat(const CharType* format,
+                      const int* givenTypes, size_t numGiven)
 {
-    wxPrintfConvSpecParser<CharType> parser(format);
+    FormatArgTypes argTypes;
+    GetFormatArgTypes(format, argTypes);
 
     // For the reasons mentioned in the comment in DoGetArgumentType() above,
     // we ignore any extraneous argument types, so we only check that the
     // format format specifiers we actually have match the types.
-    for ( unsigned n = 0; n < parser.nargs; ++n )
+    for ( unsigned n = 0; n < argTypes.count; ++n )
     {
-        if ( n == argTypes.size() )
+        if ( n == numGiven )
         {
             wxFAIL_MSG
             (
                 wxString::Format
                 (
                     "Not enough arguments, %zu given but at least %u needed",
-                    argTypes.size(),
-                    parser.nargs
+                    numGiven,
+                    argTypes.count
                 )
             );
 
@@ -758,8 +1065,7 @@ void DoValidateFormat(const CharType* format, const std::vector<int>& argTypes)
             return;
         }
 
-        auto const pspec = parser.pspec[n];
-        if ( !pspec )
+        if ( argTypes.types[n] == wxPAT_INVALID )
         {
             wxFAIL_MSG
             (
@@ -773,10 +1079,10 @@ void DoValidateFormat(const CharType* format, const std::vector<int>& argTypes)
             continue;
         }
 
-        auto const ptype = ArgTypeFromParamType(pspec->m_type);
+        auto const ptype = ArgTypeFromParamType(argTypes.types[n]);
         wxASSERT_MSG
         (
-            (ptype & argTypes[n]) == ptype,
+            (ptype & givenTypes[n]) == ptype,
             wxString::Format
             (
                 "Format specifier mismatch for argument %u of \"%s\"",
@@ -792,10 +1098,10 @@ void DoValidateFormat(const CharType* format, const std::vector<int>& argTypes)
 
 wxFormatString::ArgumentType wxFormatString::GetArgumentType(unsigned n) const
 {
-    if ( m_char )
-        return DoGetArgumentType(m_char.data(), n);
-    else if ( m_wchar )
-        return DoGetArgumentType(m_wchar.data(), n);
+    if ( const char* const input = GetInputChar() )
+        return DoGetArgumentType(input, n);
+    else if ( const wchar_t* const input = GetInputWChar() )
+        return DoGetArgumentType(input, n);
     else if ( m_str )
         return DoGetArgumentType(m_str->wx_str(), n);
     else if ( m_cstr )
@@ -807,16 +1113,26 @@ wxFormatString::ArgumentType wxFormatString::GetArgumentType(unsigned n) const
 
 #if wxDEBUG_LEVEL
 
-void wxFormatString::Validate(const std::vector<int>& argTypes) const
+void wxFormatString::DoValidate(const int* argTypes, size_t count) const
 {
-    if ( m_char )
-        DoValidateFormat(m_char.data(), argTypes);
-    else if ( m_wchar )
-        DoValidateFormat(m_wchar.data(), argTypes);
+    if ( const char* const input = GetInputChar() )
+        DoValidateFormat(input, argTypes, count);
+    else if ( const wchar_t* const input = GetInputWChar() )
+        DoValidateFormat(input, argTypes, count);
     else if ( m_str )
-        DoValidateFormat(m_str->wx_str(), argTypes);
+        DoValidateFormat(m_str->wx_str(), argTypes, count);
     else if ( m_cstr )
-        DoValidateFormat(m_cstr->AsInternal(), argTypes);
+        DoValidateFormat(m_cstr->AsInternal(), argTypes, count);
+}
+
+void wxFormatString::Validate(std::initializer_list<int> argTypes) const
+{
+    DoValidate(argTypes.begin(), argTypes.size());
+}
+
+void wxFormatString::Validate(const std::vector<int>& argTypes) const
+{
+    DoValidate(argTypes.data(), argTypes.size());
 }
 
 #endif // wxDEBUG_LEVEL
@@ -27,6 +27,8 @@
 
 #include <ctype.h>
 
+#include <algorithm>
+
 #ifdef __UNIX__
 #include <pwd.h>
 #include <grp.h>
@@ -74,6 +76,20 @@ enum {
     TYPE_USTAR      // all fields are valid
 };
 
+// old GNU format sparse file header, the fields below are stored in the space
+// used by the prefix field in the ustar format
+static const char GNU_SPARSE_TYPE       = 'S';
+static const size_t GNU_SPARSE_POS      = 386;  // 4 * (12 + 12)
+static const size_t GNU_SPARSE_NUM      = 4;
+static const size_t GNU_ISEXTENDED_POS  = 482;  // 1
+static const size_t GNU_REALSIZE_POS    = 483;  // 12
+
+// followed by extension blocks if isextended is set, each containing
+static const size_t GNU_EXT_SPARSE_NUM  = 21;   // 21 * (12 + 12)
+static const size_t GNU_EXT_ISEXTENDED_POS = 504;
+
+static const size_t GNU_NUMBER_LEN      = 12;
+
 // signatures
 static const char *USTAR_MAGIC   = "ustar";
 static const char *USTAR_VERSION = "00";
@@ -140,8 +156,12 @@ public:
     static const wxChar *Name(int id) { return fields[id].name; }
     static size_t Offset(int id) { return fields[id].pos; }
 
+    // access to the fields of the old GNU header not in the fields table
+    char *GetGnu(size_t pos) { return Get(TAR_PREFIX) + pos - Offset(TAR_PREFIX); }
+
     bool SetOctal(int id, wxTarNumber n);
     wxTarNumber GetOctal(int id);
+    static wxTarNumber GetNumber(const char *p, size_t len);
     bool SetPath(const wxString& name, wxMBConv& conv);
 
 private:
@@ -223,12 +243,17 @@ wxUint32 wxTarHeaderBlock::SumField(int id)
 
 bool wxTarHeaderBlock::Read(wxInputStream& in)
 {
-    bool ok = true;
+    // read the whole block at once, then copy the fields into their places
+    // in data, where each of them is followed by a nul
+    char block[TAR_BLOCKSIZE];
 
-    for (int id = 0; id < TAR_NUMFIELDS && ok; id++)
-        ok = in.Read(Get(id), Len(id)).LastRead() == Len(id);
+    if (!in.ReadAll(block, sizeof(block)))
+        return false;
 
-    return ok;
+    for (int id = 0; id < TAR_NUMFIELDS; id++)
+        memcpy(Get(id), block + Offset(id), Len(id));
+
+    return true;
 }
 
 bool wxTarHeaderBlock::Write(wxOutputStream& out)
@@ -248,11 +273,28 @@ inline bool wxTarHeaderBlock::WriteField(wxOutputStream& out, int id)
 
 wxTarNumber wxTarHeaderBlock::GetOctal(int id)
 {
+    return GetNumber(Get(id), Len(id));
+}
+
+// Static - parse a numeric field, these are normally octal, but GNU tar
+// uses base-256 for numbers that don't fit, e.g. the size of files > 8GB
+//
+wxTarNumber wxTarHeaderBlock::GetNumber(const char *p, size_t len)
+{
+    const char *end = p + len;
     wxTarNumber n = 0;
-    const char *p = Get(id);
-    while (*p == ' ')
+
+    if (len && (*p & 0x80)) {
+        // base-256, big endian, the first byte holds the flag bit
+        n = *p++ & 0x3f;
+        while (p < end)
+            n = (n << 8) | (unsigned char)*p++;
+        return n;
+    }
+
+    while (p < end && *p == ' ')
         p++;
-    while (*p >= '0' && *p < '8')
+    while (p < end && *p >= '0' && *p < '8')
         n = (n << 3) | (*p++ - '0');
     return n;
 }
@@ -484,7 +526,8 @@ wxTarEntry::wxTarEntry(const wxTarEntry& e)
     m_UserName(e.m_UserName),
     m_GroupName(e.m_GroupName),
     m_DevMajor(e.m_DevMajor),
-    m_DevMinor(e.m_DevMinor)
+    m_DevMinor(e.m_DevMinor),
+    m_SparseMap(e.m_SparseMap)
 {
 }
 
@@ -507,6 +550,7 @@ wxTarEntry& wxTarEntry::operator=(const wxTarEntry& e)
         m_GroupName = e.m_GroupName;
         m_DevMajor = e.m_DevMajor;
         m_DevMinor = e.m_DevMinor;
+        m_SparseMap = e.m_SparseMap;
     }
     return *this;
 }
@@ -641,6 +685,8 @@ void wxTarInputStream::Init()
     m_pos = wxInvalidOffset;
     m_offset = 0;
     m_size = wxInvalidOffset;
+    m_storedPos = 0;
+    m_storedSize = 0;
     m_sumType = SUM_UNKNOWN;
     m_tarType = TYPE_USTAR;
     m_hdr = new wxTarHeaderBlock;
@@ -670,8 +716,6 @@ wxTarEntry *wxTarInputStream::GetNextEntry()
     entry->SetGroupId(GetHeaderNumber(TAR_UID));
     entry->SetSize(GetHeaderNumber(TAR_SIZE));
 
-    entry->SetOffset(m_offset);
-
     entry->SetDateTime(GetHeaderDate(wxT("mtime")));
     entry->SetAccessTime(GetHeaderDate(wxT("atime")));
     entry->SetCreateTime(GetHeaderDate(wxT("ctime")));
@@ -693,15 +737,41 @@ wxTarEntry *wxTarInputStream::GetNextEntry()
     if (isDir)
         entry->SetIsDir();
 
+    // this may consume a part of the entry data, so must be done before
+    // setting the offset
+    if (!ReadSparseMap(*entry)) {
+        m_lasterror = wxSTREAM_READ_ERROR;
+        return nullptr;
+    }
+
+    entry->SetOffset(m_offset);
+
     if (m_HeaderRecs)
         m_HeaderRecs->clear();
 
-    m_size = GetDataSize(*entry);
+    SetDataSize(*entry);
     m_pos = 0;
 
     return entry.release();
 }
 
+// Set up the size of the data of the given entry, which is about to be read.
+//
+void wxTarInputStream::SetDataSize(const wxTarEntry& entry)
+{
+    m_size = GetDataSize(entry);
+    m_sparseMap = entry.m_SparseMap;
+    m_storedPos = 0;
+
+    if (m_sparseMap.empty()) {
+        m_storedSize = m_size;
+    } else {
+        m_storedSize = 0;
+        for (size_t i = 0; i < m_sparseMap.size(); i++)
+            m_storedSize += m_sparseMap[i].second;
+    }
+}
+
 bool wxTarInputStream::OpenEntry(wxTarEntry& entry)
 {
     wxFileOffset offset = entry.GetOffset();
@@ -711,7 +781,7 @@ bool wxTarInputStream::OpenEntry(wxTarEntry& entry)
             && m_parent_i_stream->SeekI(offset) == offset)
     {
         m_offset = offset;
-        m_size = GetDataSize(entry);
+        SetDataSize(entry);
         m_pos = 0;
         m_lasterror = wxSTREAM_NO_ERROR;
         return true;
@@ -734,8 +804,8 @@ bool wxTarInputStream::CloseEntry()
     if (!IsOpened())
         return true;
 
-    wxFileOffset size = RoundUpSize(m_size);
-    wxFileOffset remainder = size - m_pos;
+    wxFileOffset size = RoundUpSize(m_storedSize);
+    wxFileOffset remainder = size - m_storedPos;
 
     if (remainder && m_parent_i_stream->IsSeekable()) {
         wxLogNull nolog;
@@ -843,7 +913,14 @@ wxString wxTarInputStream::GetExtendedHeader(const wxString& key) const
 
 wxString wxTarInputStream::GetHeaderPath() const
 {
-    wxString path(GetExtendedHeader(wxS("path")));
+    // for sparse files the path is just a placeholder and the real name is
+    // stored in the GNU-specific record
+    wxString path(GetExtendedHeader(wxS("GNU.sparse.name")));
+
+    if (!path.empty())
+        return path;
+
+    path = GetExtendedHeader(wxS("path"));
 
     if (!path.empty())
         return path;
@@ -990,10 +1067,16 @@ wxFileOffset wxTarInputStream::OnSysSeek(wxFileOffset pos, wxSeekMode mode)
         case wxFromEnd:     pos += m_size; break;
     }
 
-    if (pos < 0 || m_parent_i_stream->SeekI(m_offset + pos) == wxInvalidOffset)
+    if (pos < 0)
+        return wxInvalidOffset;
+
+    wxFileOffset storedPos = GetStoredPos(pos);
+
+    if (m_parent_i_stream->SeekI(m_offset + storedPos) == wxInvalidOffset)
         return wxInvalidOffset;
 
     m_pos = pos;
+    m_storedPos = storedPos;
     return m_pos;
 }
 
@@ -1011,7 +1094,8 @@ size_t wxTarInputStream::OnSysRead(void *buffer, size_t size)
     else if (m_pos + size > m_size + (size_t)0)
         size = m_size - m_pos;
 
-    size_t lastread = m_parent_i_stream->Read(buffer, size).LastRead();
+    size_t lastread = m_sparseMap.empty() ? ReadStored(buffer, size)
+                                          : ReadSparse(buffer, size);
     m_pos += lastread;
 
     if (m_pos >= m_size) {
@@ -1029,6 +1113,241 @@ size_t wxTarInputStream::OnSysRead(void *buffer, size_t size)
 }
 
 
+// Read from the data stored in the archive for the current entry.
+//
+size_t wxTarInputStream::ReadStored(void *buffer, size_t size)
+{
+    size_t lastread = m_parent_i_stream->Read(buffer, size).LastRead();
+    m_storedPos += lastread;
+    return lastread;
+}
+
+// Read from a sparse entry, filling in the holes between the stored data
+// regions with zeros.
+//
+size_t wxTarInputStream::ReadSparse(void *buffer, size_t size)
+{
+    char *p = static_cast<char*>(buffer);
+    size_t done = 0;
+
+    while (done < size) {
+        wxFileOffset pos = m_pos + done;
+        size_t len = size - done;
+
+        // find the first region ending after the current position
+        wxTarEntry::wxTarSparseMap::const_iterator it = std::upper_bound(
+            m_sparseMap.begin(), m_sparseMap.end(), pos,
+            [](wxFileOffset off, const std::pair<wxFileOffset, wxFileOffset>& r)
+            {
+                return off < r.first + r.second;
+            });
+
+        if (it == m_sparseMap.end() || pos < it->first) {
+            // inside a hole, which extends up to the next region or the end
+            wxFileOffset holeEnd = it == m_sparseMap.end() ? m_size : it->first;
+            if (pos + wxFileOffset(len) > holeEnd)
+                len = holeEnd - pos;
+            memset(p + done, 0, len);
+            done += len;
+        } else {
+            wxFileOffset regionEnd = it->first + it->second;
+            if (pos + wxFileOffset(len) > regionEnd)
+                len = regionEnd - pos;
+            size_t lastread = ReadStored(p + done, len);
+            done += lastread;
+            if (lastread < len)
+                break;
+        }
+    }
+
+    return done;
+}
+
+// Translate a position within the current entry to the position within the
+// data stored in the archive.
+//
+wxFileOffset wxTarInputStream::GetStoredPos(wxFileOffset pos) const
+{
+    if (m_sparseMap.empty())
+        return pos;
+
+    wxFileOffset storedPos = 0;
+
+    for (size_t i = 0; i < m_sparseMap.size(); i++) {
+        const wxFileOffset offset = m_sparseMap[i].first;
+        if (pos <= offset)
+            break;
+        storedPos += wxMin(pos - offset, m_sparseMap[i].second);
+    }
+
+    return storedPos;
+}
+
+// Copy the remaining data of the current entry to the given stream.  This
+// avoids the small intermediate buffer used by wxOutputStream::Write().
+//
+bool wxTarInputStream::CopyEntryData(wxOutputStream& stream)
+{
+    const size_t BUFSIZE = 64 * 1024;
+    wxCharBuffer buf(size_t(wxMin(wxFileOffset(BUFSIZE),
+                                  RoundUpSize(m_size - m_pos + 1))));
+    size_t lastcount = 0;
+
+    while (IsOk()) {
+        size_t lastread = Read(buf.data(), buf.length()).LastRead();
+        if (!lastread)
+            break;
+        lastcount += lastread;
+        if (stream.Write(buf.data(), lastread).LastWrite() != lastread)
+            break;
+    }
+
+    m_lastcount = lastcount;
+
+    return m_lasterror == wxSTREAM_EOF && stream.IsOk();
+}
+
+// Read the map of the data regions of a sparse file, if the current entry
+// is one, and update the entry accordingly.
+//
+bool wxTarInputStream::ReadSparseMap(wxTarEntry& entry)
+{
+    wxTarEntry::wxTarSparseMap& map = entry.m_SparseMap;
+    wxFileOffset dataSize = entry.GetSize();
+    wxLongLong_t realSize = 0;
+    bool ok;
+
+    map.clear();
+
+    if (m_tarType == TYPE_GNUTAR && *m_hdr->Get(TAR_TYPEFLAG) == GNU_SPARSE_TYPE) {
+        ok = ReadGnuSparseMap(map);
+        realSize = wxTarHeaderBlock::GetNumber(m_hdr->GetGnu(GNU_REALSIZE_POS),
+                                               GNU_NUMBER_LEN);
+        entry.SetTypeFlag(wxTAR_REGTYPE);
+    } else if (GetExtendedHeader(wxS("GNU.sparse.major")) == wxS("1")) {
+        ok = ReadPaxSparseMap(map, dataSize) &&
+             GetExtendedHeader(wxS("GNU.sparse.realsize")).ToLongLong(&realSize);
+    } else if (!GetExtendedHeader(wxS("GNU.sparse.map")).empty()) {
+        // version 0.1, the map is stored as a comma separated list of numbers
+        wxArrayString parts = wxSplit(GetExtendedHeader(wxS("GNU.sparse.map")),
+                                      ',', '\0');
+        ok = parts.size() % 2 == 0;
+        for (size_t i = 0; ok && i < parts.size(); i += 2) {
+            wxLongLong_t offset, size;
+            ok = parts[i].ToLongLong(&offset) && parts[i + 1].ToLongLong(&size);
+            map.push_back(std::make_pair(offset, size));
+        }
+        ok = ok && GetExtendedHeader(wxS("GNU.sparse.size")).ToLongLong(&realSize);
+    } else {
+        return true;
+    }
+
+    // check that the regions are in order and fit inside the file
+    wxFileOffset storedSize = 0;
+    wxFileOffset end = 0;
+
+    for (size_t i = 0; ok && i < map.size(); i++) {
+        ok = map[i].first >= end && map[i].second >= 0;
+        end = map[i].first + map[i].second;
+        storedSize += map[i].second;
+    }
+
+    if (!ok || end > realSize || storedSize != dataSize) {
+        wxLogError(_("invalid sparse file map in tar entry"));
+        map.clear();
+        return false;
+    }
+
+    entry.SetSize(realSize);
+
+    return true;
+}
+
+// Read the old GNU format sparse map, stored in the header block and in
+// optional extension blocks following it.
+//
+bool wxTarInputStream::ReadGnuSparseMap(wxTarEntry::wxTarSparseMap& map)
+{
+    const char *p = m_hdr->GetGnu(GNU_SPARSE_POS);
+    size_t count = GNU_SPARSE_NUM;
+    bool extended = *m_hdr->GetGnu(GNU_ISEXTENDED_POS) != 0;
+    char block[TAR_BLOCKSIZE];
+
+    for (;;) {
+        for (size_t i = 0; i < count && *p; i++) {
+            const char *q = p + GNU_NUMBER_LEN;
+            wxFileOffset offset = wxTarHeaderBlock::GetNumber(p, GNU_NUMBER_LEN);
+            wxFileOffset size = wxTarHeaderBlock::GetNumber(q, GNU_NUMBER_LEN);
+            map.push_back(std::make_pair(offset, size));
+            p += 2 * GNU_NUMBER_LEN;
+        }
+
+        if (!extended)
+            return true;
+
+        if (!m_parent_i_stream->ReadAll(block, sizeof(block)))
+            return false;
+        m_offset += TAR_BLOCKSIZE;
+
+        p = block;
+        count = GNU_EXT_SPARSE_NUM;
+        extended = block[GNU_EXT_ISEXTENDED_POS] != 0;
+    }
+}
+
+// Read the PAX format version 1.0 sparse map, stored at the start of the
+// entry data as decimal numbers each followed by a newline: the number of
+// regions, then the offset and size of each of them.  On return dataSize is
+// reduced by the size of the map.
+//
+bool wxTarInputStream::ReadPaxSparseMap(wxTarEntry::wxTarSparseMap& map,
+                                        wxFileOffset& dataSize)
+{
+    wxFileOffset mapSize = 0;
+    std::vector<wxFileOffset> numbers;
+    wxFileOffset count = -1;
+    wxFileOffset n = 0;
+    bool digits = false;
+    char block[TAR_BLOCKSIZE];
+
+    while (count < 0 || wxFileOffset(numbers.size()) < 2 * count) {
+        if (mapSize >= dataSize || !m_parent_i_stream->ReadAll(block, sizeof(block)))
+            return false;
+        m_offset += TAR_BLOCKSIZE;
+        mapSize += TAR_BLOCKSIZE;
+
+        for (size_t i = 0; i < sizeof(block); i++) {
+            char c = block[i];
+
+            if (c >= '0' && c <= '9') {
+                n = n * 10 + c - '0';
+                digits = true;
+            } else if (c == '\n' && digits) {
+                if (count < 0)
+                    count = n;
+                else
+                    numbers.push_back(n);
+                n = 0;
+                digits = false;
+
+                if (wxFileOffset(numbers.size()) == 2 * count)
+                    break;
+            } else {
+                return false;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < numbers.size(); i += 2)
+        map.push_back(std::make_pair(numbers[i], numbers[i + 1]));
+
+    // the size of the stored data doesn't include the map itself
+    dataSize -= mapSize;
+
+    return true;
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 // Output stream
 
@@ -21,6 +21,22 @@
 
 #include "wx/textbuf.h"
 
+#if wxUSE_TEXTBUFFER
+
+#include "wx/math.h"
+
+#include <memory>
+#include <vector>
+
+// SSE2 is always available on x86-64 and is used for finding the line ends
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define wxHAS_SSE2_NEWLINES
+    #include <emmintrin.h>
+#endif
+
+#endif // wxUSE_TEXTBUFFER
+
 // ============================================================================
 // wxTextBuffer class implementation
 // ============================================================================
@@ -121,6 +137,173 @@ wxString wxTextBuffer::Translate(const wxString& text, wxTextFileType type)
 
 wxString wxTextBuffer::ms_eof;
 
+// ----------------------------------------------------------------------------
+// wxTextBufferLazyLines: lines decoded on demand
+// ----------------------------------------------------------------------------
+
+class wxTextBufferLazyLines
+{
+public:
+    // Takes ownership of the conversion object which must be ASCII-compatible.
+    wxTextBufferLazyLines(const char* data, size_t len, wxMBConv* conv)
+        : m_data(data),
+          m_len(len),
+          m_conv(conv)
+    {
+        for ( auto& cached : m_cache )
+            cached.n = NO_LINE;
+        m_cacheNext = 0;
+
+        IndexLines();
+    }
+
+    size_t GetCount() const { return m_types.size(); }
+
+    wxTextFileType GetType(size_t n) const
+    {
+        return static_cast<wxTextFileType>(m_types[n]);
+    }
+
+    // Return the reference to the decoded line which remains valid until
+    // CACHE_SIZE other lines are decoded.
+    wxString& GetLine(size_t n)
+    {
+        for ( auto& cached : m_cache )
+        {
+            if ( cached.n == n )
+                return cached.str;
+        }
+
+        CachedLine& cached = m_cache[m_cacheNext];
+        m_cacheNext = (m_cacheNext + 1) % CACHE_SIZE;
+
+        cached.n = n;
+        cached.str = DecodeLine(n);
+
+        return cached.str;
+    }
+
+private:
+    static const size_t NO_LINE = static_cast<size_t>(-1);
+    static const size_t CACHE_SIZE = 16;
+
+    wxString DecodeLine(size_t n) const
+    {
+        wxASSERT_MSG( n < GetCount(), "invalid line index" );
+
+        size_t end = m_starts[n + 1];
+        switch ( m_types[n] )
+        {
+            case wxTextFileType_Dos:
+                end -= 2;
+                break;
+
+            case wxTextFileType_Unix:
+            case wxTextFileType_Mac:
+                end -= 1;
+                break;
+        }
+
+        // Lines which can't be decoded are returned as empty strings, just as
+        // wxString ctor does.
+        return wxString(m_data + m_starts[n], *m_conv, end - m_starts[n]);
+    }
+
+    void AddLineEnd(size_t pos, size_t& lineStart)
+    {
+        wxTextFileType type;
+        if ( m_data[pos] == '\n' )
+        {
+            type = wxTextFileType_Unix;
+        }
+        else if ( pos + 1 < m_len && m_data[pos + 1] == '\n' )
+        {
+            type = wxTextFileType_Dos;
+            ++pos;
+        }
+        else
+        {
+            type = wxTextFileType_Mac;
+        }
+
+        m_starts.push_back(lineStart);
+        m_types.push_back(static_cast<unsigned char>(type));
+
+        lineStart = pos + 1;
+    }
+
+    // Fill m_starts and m_types using the same rules as wxTextFile::OnRead().
+    void IndexLines()
+    {
+        size_t lineStart = 0;
+        size_t pos = 0;
+
+#ifdef wxHAS_SSE2_NEWLINES
+        const __m128i cr = _mm_set1_epi8('\r');
+        const __m128i lf = _mm_set1_epi8('\n');
+        for ( ; pos + 16 <= m_len; pos += 16 )
+        {
+            const __m128i
+                v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_data + pos));
+            wxUint32 mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, cr),
+                                                           _mm_cmpeq_epi8(v, lf)));
+            while ( mask )
+            {
+                const size_t eol = pos + wxCTZ(mask);
+                mask &= mask - 1;
+
+                // Skip LF of a CR LF pair which was already handled.
+                if ( eol >= lineStart )
+                    AddLineEnd(eol, lineStart);
+            }
+        }
+#endif // wxHAS_SSE2_NEWLINES
+
+        for ( ; pos < m_len; ++pos )
+        {
+            if ( (m_data[pos] == '\r' || m_data[pos] == '\n') && pos >= lineStart )
+                AddLineEnd(pos, lineStart);
+        }
+
+        // The last line is not terminated by a new line.
+        if ( lineStart != m_len )
+        {
+            m_starts.push_back(lineStart);
+            m_types.push_back(wxTextFileType_None);
+        }
+
+        // Add the end of the data to allow computing the end of the last line
+        // in the same way as for all the other ones.
+        m_starts.push_back(m_len);
+
+        m_starts.shrink_to_fit();
+        m_types.shrink_to_fit();
+    }
+
+
+    const char* const m_data;
+    const size_t m_len;
+    const std::unique_ptr<wxMBConv> m_conv;
+
+    // Offsets of the start of all lines followed by m_len.
+    std::vector<size_t> m_starts;
+
+    // Types of all lines, stored as bytes to save memory.
+    std::vector<unsigned char> m_types;
+
+    // The most recently used decoded lines.
+    struct CachedLine
+    {
+        size_t n;
+        wxString str;
+    };
+
+    CachedLine m_cache[CACHE_SIZE];
+    size_t m_cacheNext;
+
+    wxDECLARE_NO_COPY_CLASS(wxTextBufferLazyLines);
+};
+
 // ----------------------------------------------------------------------------
 // ctors & dtor
 // ----------------------------------------------------------------------------
@@ -128,13 +311,113 @@ wxString wxTextBuffer::ms_eof;
 wxTextBuffer::wxTextBuffer(const wxString& strBufferName)
             : m_strBufferName(strBufferName)
 {
+    m_lazyLines = nullptr;
     m_nCurLine = 0;
     m_isOpened = false;
 }
 
 wxTextBuffer::~wxTextBuffer()
 {
-    // required here for Darwin
+    // don't use FreeLazyLines() as it's useless to call OnReleaseData() here
+    delete m_lazyLines;
+}
+
+// ----------------------------------------------------------------------------
+// lazy mode
+// ----------------------------------------------------------------------------
+
+bool wxTextBuffer::SetLazyData(const char* data, size_t len, const wxMBConv& conv)
+{
+    // keep the same behaviour as when reading the file normally if the buffer
+    // is not empty, i.e. append the lines to it
+    if ( m_lazyLines || !m_aLines.empty() )
+        return false;
+
+#ifdef wxNO_RTTI
+    // we need to know if wxConvAuto is used, as it must be handled specially,
+    // and we can't check for it without RTTI, so just load the data normally
+    wxUnusedVar(data);
+    wxUnusedVar(len);
+    wxUnusedVar(conv);
+
+    return false;
+#else // !wxNO_RTTI
+    std::unique_ptr<wxMBConv> convLines;
+
+    const wxConvAuto* const convAuto = dynamic_cast<const wxConvAuto*>(&conv);
+    if ( convAuto )
+    {
+        // we can't split UTF-16 or UTF-32 text in lines without decoding it
+        const wxBOM bom = wxConvAuto::DetectBOM(data, len);
+        if ( bom != wxBOM_None && bom != wxBOM_UTF8 )
+            return false;
+
+        // check that all the data can be decoded, as would be done when
+        // reading it normally, this also determines whether UTF-8 or the
+        // fall-back encoding is used if there is no BOM
+        convLines.reset(convAuto->Clone());
+        if ( convLines->ToWChar(nullptr, 0, data, len) == wxCONV_FAILED )
+            return false;
+
+        if ( bom == wxBOM_UTF8 )
+        {
+            size_t bomLen;
+            wxConvAuto::GetBOMChars(bom, &bomLen);
+            data += bomLen;
+            len -= bomLen;
+
+            convLines.reset(wxConvUTF8.Clone());
+        }
+    }
+    else
+    {
+        if ( conv.GetMBNulLen() != 1 )
+            return false;
+
+        convLines.reset(conv.Clone());
+    }
+
+    m_lazyLines = new wxTextBufferLazyLines(data, len, convLines.release());
+
+    return true;
+#endif // wxNO_RTTI/!wxNO_RTTI
+}
+
+size_t wxTextBuffer::DoGetLazyLineCount() const
+{
+    return m_lazyLines->GetCount();
+}
+
+wxString& wxTextBuffer::DoGetLazyLine(size_t n) const
+{
+    return m_lazyLines->GetLine(n);
+}
+
+wxTextFileType wxTextBuffer::DoGetLazyLineType(size_t n) const
+{
+    return m_lazyLines->GetType(n);
+}
+
+void wxTextBuffer::LoadLazyLines()
+{
+    const size_t count = m_lazyLines->GetCount();
+    m_aLines.reserve(count);
+    m_aTypes.reserve(count);
+    for ( size_t n = 0; n < count; n++ )
+    {
+        m_aLines.push_back(m_lazyLines->GetLine(n));
+        m_aTypes.push_back(m_lazyLines->GetType(n));
+    }
+
+    FreeLazyLines();
+}
+
+void wxTextBuffer::FreeLazyLines()
+{
+    delete m_lazyLines;
+    m_lazyLines = nullptr;
+
+    OnReleaseData();
 }
 
 // ----------------------------------------------------------------------------
@@ -205,11 +488,11 @@ wxTextFileType wxTextBuffer::GuessType() const
 
     // we take MAX_LINES_SCAN in the beginning, middle and the end of buffer
     #define MAX_LINES_SCAN    (10)
-    size_t nCount = m_aLines.GetCount() / 3,
+    size_t nCount = GetLineCount() / 3,
         nScan =  nCount > 3*MAX_LINES_SCAN ? MAX_LINES_SCAN : nCount / 3;
 
     #define   AnalyseLine(n)              \
-        switch ( m_aTypes[n] ) {            \
+        switch ( GetLineType(n) ) {         \
             case wxTextFileType_Unix: nUnix++; break;   \
             case wxTextFileType_Dos:  nDos++;  break;   \
             case wxTextFileType_Mac:  nMac++;  break;   \
@@ -253,6 +536,16 @@ wxTextFileType wxTextBuffer::GuessType() const
 }
 
 
+void wxTextBuffer::Clear()
+{
+    if ( m_lazyLines )
+        FreeLazyLines();
+
+    m_aLines.clear();
+    m_aTypes.clear();
+    m_nCurLine = 0;
+}
+
 bool wxTextBuffer::Close()
 {
     Clear();
@@ -263,6 +556,10 @@ bool wxTextBuffer::Close()
 
 bool wxTextBuffer::Write(wxTextFileType typeNew, const wxMBConv& conv)
 {
+    // the data may belong to the file being overwritten, so don't use it
+    if ( m_lazyLines )
+        LoadLazyLines();
+
     return OnWrite(typeNew, conv);
 }
 
@@ -32,6 +32,58 @@
 #include "wx/filename.h"
 #include "wx/buffer.h"
 
+#if defined(__UNIX__)
+    #include <sys/mman.h>
+#elif defined(__WINDOWS__)
+    #include "wx/msw/wrapwin.h"
+#endif
+
+namespace
+{
+
+// Map the given number of bytes of the file opened in read mode in memory,
+// return null on failure.
+void* MapFile(const wxFile& file, size_t len)
+{
+#if defined(__UNIX__)
+    void* const data = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, file.fd(), 0);
+    return data == MAP_FAILED ? nullptr : data;
+#elif defined(__WINDOWS__)
+    const HANDLE hFile = reinterpret_cast<HANDLE>(_get_osfhandle(file.fd()));
+    const HANDLE hMap = ::CreateFileMapping(hFile, nullptr, PAGE_READONLY,
+                                            0, 0, nullptr);
+    if ( !hMap )
+        return nullptr;
+
+    // the view keeps the mapping object alive
+    void* const data = ::MapViewOfFile(hMap, FILE_MAP_READ, 0, 0, len);
+    ::CloseHandle(hMap);
+
+    return data;
+#else
+    wxUnusedVar(file);
+    wxUnusedVar(len);
+
+    return nullptr;
+#endif
+}
+
+void UnmapFile(void* data, size_t len)
+{
+#if defined(__UNIX__)
+    munmap(data, len);
+#elif defined(__WINDOWS__)
+    wxUnusedVar(len);
+
+    ::UnmapViewOfFile(data);
+#else
+    wxUnusedVar(data);
+    wxUnusedVar(len);
+#endif
+}
+
+} // anonymous namespace
+
 // ============================================================================
 // wxTextFile class implementation
 // ============================================================================
@@ -41,6 +93,11 @@ wxTextFile::wxTextFile(const wxString& strFileName)
 {
 }
 
+wxTextFile::~wxTextFile()
+{
+    OnReleaseData();
+}
+
 
 // ----------------------------------------------------------------------------
 // file operations
@@ -84,11 +141,59 @@ bool wxTextFile::OnClose()
 }
 
 
+bool wxTextFile::OpenMapped(const wxString& strFileName, const wxMBConv& conv)
+{
+    m_mapOnRead = true;
+    const bool ok = Open(strFileName, conv);
+    m_mapOnRead = false;
+
+    return ok;
+}
+
+bool wxTextFile::DoMapFile(const wxMBConv& conv)
+{
+    // files with zero length can still have some contents if they're special
+    // files, so don't try to map them, and we can't map huge files in 32 bit
+    // builds
+    const wxFileOffset length = m_file.Length();
+    const size_t len = static_cast<size_t>(length);
+    if ( length <= 0 || static_cast<wxFileOffset>(len) != length )
+        return false;
+
+    void* const data = MapFile(m_file, len);
+    if ( !data )
+        return false;
+
+    if ( !SetLazyData(static_cast<const char*>(data), len, conv) )
+    {
+        UnmapFile(data, len);
+        return false;
+    }
+
+    m_mapData = data;
+    m_mapLen = len;
+
+    return true;
+}
+
+void wxTextFile::OnReleaseData()
+{
+    if ( m_mapData )
+    {
+        UnmapFile(m_mapData, m_mapLen);
+        m_mapData = nullptr;
+        m_mapLen = 0;
+    }
+}
+
 bool wxTextFile::OnRead(const wxMBConv& conv)
 {
     // file should be opened
     wxASSERT_MSG( m_file.IsOpened(), wxT("can't read closed file") );
 
+    if ( m_mapOnRead && DoMapFile(conv) )
+        return true;
+
     wxString str;
     if ( !m_file.ReadAll(&str, conv) )
     {
@@ -68,7 +68,6 @@
 #include "wx/apptrait.h"
 
 #include "wx/process.h"
-#include "wx/txtstrm.h"
 #include "wx/uri.h"
 #include "wx/mimetype.h"
 #include "wx/config.h"
@@ -588,44 +587,40 @@ bool wxGetEnvMap(wxEnvVariableHashMap *map)
 // wxExecute
 // ----------------------------------------------------------------------------
 
-// wxDoExecuteWithCapture() helper: reads an entire stream into one array if
-// the stream is non-null (it doesn't do anything if it's null).
-//
-// returns true if ok, false if error
-#if wxUSE_STREAMS
-static bool ReadAll(wxInputStream *is, wxArrayString& output)
+namespace
 {
-    if ( !is )
-        return true;
-
-    // the stream could be already at EOF or in wxSTREAM_BROKEN_PIPE state
-    is->Reset();
 
-    wxTextInputStream tis(*is);
+// wxDoExecuteWithCapture() helper: process collecting the lines of its output
+// in the provided arrays as soon as they become available.
+class wxCapturingProcess : public wxProcess
+{
+public:
+    wxCapturingProcess(wxArrayString& output, wxArrayString* error)
+        : m_output(output),
+          m_error(error)
+    {
+        RedirectLines();
+    }
 
-    for ( ;; )
+    virtual void OnOutputLine(const wxString& line) override
     {
-        wxString line = tis.ReadLine();
+        m_output.Add(line);
+    }
 
-        // check for EOF before other errors as it's not really an error
-        if ( is->Eof() )
-        {
-            // add the last, possibly incomplete, line
-            if ( !line.empty() )
-                output.Add(line);
-            break;
-        }
+    virtual void OnErrorLine(const wxString& line) override
+    {
+        if ( m_error )
+            m_error->Add(line);
+    }
 
-        // any other error is fatal
-        if ( !*is )
-            return false;
+private:
+    wxArrayString& m_output;
+    wxArrayString* const m_error;
 
-        output.Add(line);
-    }
+    wxDECLARE_NO_COPY_CLASS(wxCapturingProcess);
+};
 
-    return true;
-}
-#endif // wxUSE_STREAMS
+} // anonymous namespace
 
 // this is a private function because it hasn't a clean interface: the first
 // array is passed by reference, the second by pointer - instead we have 2
@@ -636,32 +631,12 @@ static long wxDoExecuteWithCapture(const wxString& command,
                                    int flags,
                                    const wxExecuteEnv *env)
 {
-    // create a wxProcess which will capture the output
-    wxProcess *process = new wxProcess;
-    process->Redirect();
-
-    long rc = wxExecute(command, wxEXEC_SYNC | flags, process, env);
-
-#if wxUSE_STREAMS
     // Notice that while -1 indicates an error exit code for us, a program
     // exiting with this code could still have written something to its stdout
-    // and, especially, stderr, so we still need to read from them.
-    if ( !ReadAll(process->GetInputStream(), output) )
-        rc = -1;
+    // and, especially, stderr, and all of it is still collected.
+    wxCapturingProcess process(output, error);
 
-    if ( error )
-    {
-        if ( !ReadAll(process->GetErrorStream(), *error) )
-            rc = -1;
-    }
-#else
-    wxUnusedVar(output);
-    wxUnusedVar(error);
-#endif // wxUSE_STREAMS/!wxUSE_STREAMS
-
-    delete process;
-
-    return rc;
+    return wxExecute(command, wxEXEC_SYNC | flags, &process, env);
 }
 
 long wxExecute(const wxString& command, wxArrayString& output, int flags,
@@ -393,7 +393,7 @@ void wxWebRequestImpl::ProcessStateEvent(wxWebRequest::State state, const wxStri
         case wxWebRequest::State_Failed:
         case wxWebRequest::State_Cancelled:
             if ( response )
-                response->Finalize();
+                response->Finalize(state);
 
             release = true;
             break;
@@ -481,7 +481,18 @@ wxWebRequestSync::Result wxWebRequestSync::Execute() const
 {
     wxCHECK_IMPL( wxWebRequestSync::Result::Error("Invalid session object") );
 
-    return m_impl->Execute();
+    const Result result = m_impl->Execute();
+
+    // Synchronous requests don't use state events, so we need to let the
+    // response know that it won't receive any more data here.
+    if ( m_impl->GetStorage() == Storage_Stream )
+    {
+        const wxWebResponseImplPtr response = m_impl->GetResponse();
+        if ( response )
+            response->FinishStream(result.state == State_Completed);
+    }
+
+    return result;
 }
 
 void wxWebRequest::Start()
@@ -672,6 +683,10 @@ wxWebRequest::Result wxWebResponseImpl::InitFileStorage()
                 );
         }
     }
+    else if ( m_request.GetStorage() == wxWebRequest::Storage_Stream )
+    {
+        m_stream.reset(new wxWebResponseStream(*this));
+    }
 
     return wxWebRequest::Result::Ok();
 }
@@ -703,6 +718,10 @@ wxInputStream * wxWebResponseImpl::GetStream() const
             case wxWebRequest::Storage_None:
                 // No stream available
                 break;
+            case wxWebRequest::Storage_Stream:
+                // The stream is created by InitFileStorage() and so must
+                // already exist if we're called after starting the request.
+                break;
         }
 
     }
@@ -762,6 +781,17 @@ void wxWebResponseImpl::PreAllocBuffer(size_t sizeNeeded)
     m_readBuffer.SetBufSize(sizeNeeded);
 }
 
+bool wxWebResponseImpl::PauseStreamIfFull()
+{
+    // There is no way to read the data of a synchronous request while it's
+    // being executed, so there is no point in pausing it.
+    if ( m_request.GetStorage() != wxWebRequest::Storage_Stream ||
+            !m_request.IsAsync() || !m_stream )
+        return false;
+
+    return static_cast<wxWebResponseStream*>(m_stream.get())->PauseIfFull();
+}
+
 void wxWebResponseImpl::ReportDataReceived(size_t sizeReceived)
 {
     m_readBuffer.UngetAppendBuf(sizeReceived);
@@ -778,6 +808,15 @@ void wxWebResponseImpl::ReportDataReceived(size_t sizeReceived)
             m_readBuffer.Clear();
             break;
 
+        case wxWebRequest::Storage_Stream:
+            // Pass the buffer to the stream without copying the data, this
+            // leaves us with an empty buffer for the next chunk.
+            if ( m_stream )
+                static_cast<wxWebResponseStream*>(m_stream.get())->Append(m_readBuffer);
+            else
+                m_readBuffer.Clear();
+            break;
+
         case wxWebRequest::Storage_None:
             // We don't use events for synchronous requests, so just throw the
             // data away. This is not very useful, but what else can we do.
@@ -815,10 +854,124 @@ wxString wxWebResponseImpl::GetDataFile() const
     return m_file.GetName();
 }
 
-void wxWebResponseImpl::Finalize()
+void wxWebResponseImpl::FinishStream(bool success)
 {
-    if ( m_request.GetStorage() == wxWebRequest::Storage_File )
-        m_file.Close();
+    // Wake up the thread reading from the stream, if any.
+    if ( m_stream && m_request.GetStorage() == wxWebRequest::Storage_Stream )
+        static_cast<wxWebResponseStream*>(m_stream.get())->Finish(success);
+}
+
+void wxWebResponseImpl::Finalize(wxWebRequest::State state)
+{
+    switch ( m_request.GetStorage() )
+    {
+        case wxWebRequest::Storage_File:
+            m_file.Close();
+            break;
+
+        case wxWebRequest::Storage_Stream:
+            FinishStream(state == wxWebRequest::State_Completed);
+            break;
+
+        case wxWebRequest::Storage_Memory:
+        case wxWebRequest::Storage_None:
+            break;
+    }
+}
+
+//
+// wxWebResponseStream
+//
+
+wxWebResponseStream::wxWebResponseStream(wxWebResponseImpl& response)
+    : m_response(response),
+      m_dataAvailable(m_mutex)
+{
+}
+
+bool wxWebResponseStream::PauseIfFull()
+{
+    wxMutexLocker lock(m_mutex);
+
+    if ( m_buffered < MAX_BUFFERED )
+        return false;
+
+    m_paused = true;
+
+    return true;
+}
+
+void wxWebResponseStream::Append(wxMemoryBuffer& buf)
+{
+    if ( !buf.GetDataLen() )
+        return;
+
+    wxMutexLocker lock(m_mutex);
+
+    m_buffered += buf.GetDataLen();
+
+    // Note that wxMemoryBuffer reference count is not atomic, so we must not
+    // let the caller keep a reference to the same data and also reset it
+    // while holding the lock.
+    m_chunks.push_back(buf);
+    buf = wxMemoryBuffer();
+
+    m_dataAvailable.Signal();
+}
+
+void wxWebResponseStream::Finish(bool success)
+{
+    wxMutexLocker lock(m_mutex);
+
+    m_state = success ? State::Finished : State::Failed;
+    m_paused = false;
+
+    m_dataAvailable.Broadcast();
+}
+
+size_t wxWebResponseStream::OnSysRead(void* buffer, size_t size)
+{
+    wxMutexLocker lock(m_mutex);
+
+    while ( m_chunks.empty() && m_state == State::Open )
+        m_dataAvailable.Wait();
+
+    if ( m_chunks.empty() )
+    {
+        m_lasterror = m_state == State::Finished ? wxSTREAM_EOF
+                                                 : wxSTREAM_READ_ERROR;
+        return 0;
+    }
+
+    char* p = static_cast<char*>(buffer);
+    size_t read = 0;
+    while ( read < size && !m_chunks.empty() )
+    {
+        const wxMemoryBuffer& chunk = m_chunks.front();
+        const size_t len = wxMin(size - read, chunk.GetDataLen() - m_offset);
+        memcpy(p + read, static_cast<const char*>(chunk.GetData()) + m_offset, len);
+
+        read += len;
+        m_offset += len;
+        if ( m_offset == chunk.GetDataLen() )
+        {
+            m_chunks.pop_front();
+            m_offset = 0;
+        }
+    }
+
+    m_buffered -= read;
+
+    // Don't resume the transfer as soon as there is any space in the buffer,
+    // but wait until it's at least half empty to avoid pausing and resuming
+    // it for every chunk.
+    if ( m_paused && m_buffered <= MAX_BUFFERED / 2 )
+    {
+        m_paused = false;
+        m_response.ResumeStream();
+    }
+
+    return read;
 }
 
 //
@@ -1182,6 +1335,20 @@ bool wxWebSessionBase::SetProxy(const wxWebProxy& proxy)
     return m_impl->SetProxy(proxy);
 }
 
+bool wxWebSessionBase::SetConnectionOptions(const wxWebConnectionOptions& options)
+{
+    wxCHECK_IMPL( false );
+
+    return m_impl->SetConnectionOptions(options);
+}
+
+wxWebConnectionStats wxWebSessionBase::GetConnectionStats() const
+{
+    wxCHECK_IMPL( wxWebConnectionStats() );
+
+    return m_impl->GetConnectionStats();
+}
+
 bool wxWebSessionBase::IsOpened() const
 {
     return m_impl.get() != nullptr;
@@ -159,16 +159,10 @@ void wxCURLSetOpt(CURL* handle, CURLoption option, const wxString& value)
     wxCURLSetOpt(handle, option, value.utf8_str().data());
 }
 
-// Define wrapper function for initializing CURL handles.
-CURL* wxCURLEasyInit()
+// Set the options which must be set for all handles, this needs to be done
+// when creating a new handle and after resetting it.
+void wxCURLSetDefaultOptions(CURL* handle)
 {
-    CURL* handle = curl_easy_init();
-    if ( !handle )
-    {
-        wxLogDebug("curl_easy_init() failed");
-        return nullptr;
-    }
-
     // Honour the same environment variables that curl tool itself uses for
     // customizing the certificates locations.
     wxString path;
@@ -184,10 +178,26 @@ CURL* wxCURLEasyInit()
         if ( wxGetEnv("SSL_CERT_FILE", &path) )
             wxCURLSetOpt(handle, CURLOPT_CAINFO, path);
     }
+}
+
+// Define wrapper function for initializing CURL handles.
+CURL* wxCURLEasyInit()
+{
+    CURL* handle = curl_easy_init();
+    if ( !handle )
+    {
+        wxLogDebug("curl_easy_init() failed");
+        return nullptr;
+    }
+
+    wxCURLSetDefaultOptions(handle);
 
     return handle;
 }
 
+// Maximal number of unused handles kept by the async session for reuse.
+constexpr size_t wxCURL_MAX_FREE_HANDLES = 16;
+
 } // anonymous namespace
 
 wxWebResponseCURL::wxWebResponseCURL(wxWebRequestCURL& request) :
@@ -224,6 +234,12 @@ wxWebResponseCURL::wxWebResponseCURL(wxWebRequestCURL& request) :
 
 size_t wxWebResponseCURL::CURLOnWrite(void* buffer, size_t size)
 {
+    // If the data is streamed and the application doesn't read it quickly
+    // enough, don't accept any more of it for now: libcurl will pass the
+    // same data to us again after the transfer is resumed by ResumeStream().
+    if ( PauseStreamIfFull() )
+        return CURL_WRITEFUNC_PAUSE;
+
     void* buf = GetDataBuffer(size);
     memcpy(buf, buffer, size);
     ReportDataReceived(size);
@@ -257,6 +273,11 @@ size_t wxWebResponseCURL::CURLOnHeader(const char * buffer, size_t size)
     return size;
 }
 
+void wxWebResponseCURL::ResumeStream()
+{
+    static_cast<wxWebRequestCURL&>(m_request).ResumeTransfer();
+}
+
 int wxWebResponseCURL::CURLOnProgress(curl_off_t total)
 {
     if ( m_knownDownloadSize != total )
@@ -339,7 +360,7 @@ wxWebRequestCURL::wxWebRequestCURL(wxWebSession & session,
                                    int id):
     wxWebRequestImpl(session, sessionImpl, handler, id),
     m_sessionCURL(&sessionImpl),
-    m_handle(wxCURLEasyInit())
+    m_handle(sessionImpl.AcquireHandle())
 {
 
     DoStartPrepare(url);
@@ -420,6 +441,8 @@ void wxWebRequestCURL::DoStartPrepare(const wxString& url)
     wxCURLSetOpt(m_handle, CURLOPT_HTTPAUTH, CURLAUTH_ANY);
     if ( usingProxy )
         wxCURLSetOpt(m_handle, CURLOPT_PROXYAUTH, CURLAUTH_ANY);
+
+    GetSessionCURL().ApplyConnectionOptions(m_handle);
 }
 
 wxWebRequestCURL::~wxWebRequestCURL()
@@ -431,7 +454,7 @@ wxWebRequestCURL::~wxWebRequestCURL()
     {
         m_sessionCURL->RequestHasTerminated(this);
 
-        curl_easy_cleanup(m_handle);
+        m_sessionCURL->ReleaseHandle(m_handle);
     }
 }
 
@@ -537,6 +560,24 @@ bool wxWebRequestCURL::StartRequest()
     return true;
 }
 
+void wxWebRequestCURL::ResumeTransfer()
+{
+    // This function is called from the thread reading the response stream,
+    // but libcurl multi handle can only be used from the main thread, so
+    // resume the transfer from there, while ensuring that we stay alive until
+    // this happens.
+    IncRef();
+    const wxWebRequestImplPtr self(this);
+
+    m_sessionCURL->CallAfter([self]()
+        {
+            wxWebRequestCURL* const request =
+                static_cast<wxWebRequestCURL*>(self.get());
+
+            request->m_sessionCURL->ResumeRequest(*request);
+        });
+}
+
 void wxWebRequestCURL::DoCancel()
 {
     m_sessionCURL->CancelRequest(this);
@@ -549,9 +590,16 @@ wxWebRequest::Result wxWebRequestCURL::DoHandleCompletion()
     if ( !m_response || m_response->GetStatus() == 0 )
         return Result::Error(GetError());
 
+    GetSessionCURL().UpdateConnectionStats(m_handle);
+
     return GetResultFromHTTPStatus(m_response);
 }
 
+wxWebSessionBaseCURL& wxWebRequestCURL::GetSessionCURL() const
+{
+    return static_cast<wxWebSessionBaseCURL&>(GetSessionImpl());
+}
+
 void wxWebRequestCURL::HandleCompletion()
 {
     HandleResult(DoHandleCompletion());
@@ -1153,6 +1201,7 @@ wxWebSessionSyncCURL::CreateRequestSync(wxWebSessionSync& WXUNUSED(session),
         // set options to prevent the settings from one request from applying
         // to the subsequent ones.
         curl_easy_reset(m_handle);
+        wxCURLSetDefaultOptions(m_handle);
     }
 
     return wxWebRequestImplPtr(new wxWebRequestCURL(*this, url));
@@ -1174,6 +1223,9 @@ wxWebSessionCURL::wxWebSessionCURL()
 
 wxWebSessionCURL::~wxWebSessionCURL()
 {
+    for ( CURL* handle : m_freeHandles )
+        curl_easy_cleanup(handle);
+
     if ( m_handle )
         curl_multi_cleanup(m_handle);
 
@@ -1203,12 +1255,73 @@ wxWebSessionCURL::CreateRequest(wxWebSession& session,
             curl_multi_setopt(m_handle, CURLMOPT_SOCKETFUNCTION, SocketCallback);
             curl_multi_setopt(m_handle, CURLMOPT_TIMERDATA, this);
             curl_multi_setopt(m_handle, CURLMOPT_TIMERFUNCTION, TimerCallback);
+
+            ApplyMultiOptions();
         }
     }
 
     return wxWebRequestImplPtr(new wxWebRequestCURL(session, *this, handler, url, id));
 }
 
+CURL* wxWebSessionCURL::AcquireHandle()
+{
+    if ( m_freeHandles.empty() )
+        return wxCURLEasyInit();
+
+    CURL* const handle = m_freeHandles.back();
+    m_freeHandles.pop_back();
+
+    return handle;
+}
+
+void wxWebSessionCURL::ReleaseHandle(CURL* handle)
+{
+    if ( !handle )
+        return;
+
+    if ( m_freeHandles.size() >= wxCURL_MAX_FREE_HANDLES )
+    {
+        curl_easy_cleanup(handle);
+        return;
+    }
+
+    // Reset the handle now, rather than when reusing it, to avoid keeping
+    // pointers to the objects of the request being destroyed in it.
+    curl_easy_reset(handle);
+    wxCURLSetDefaultOptions(handle);
+
+    m_freeHandles.push_back(handle);
+}
+
+void wxWebSessionCURL::OnConnectionOptionsChanged()
+{
+    // If we don't have the handle yet, the options will be applied when it's
+    // created.
+    if ( m_handle )
+        ApplyMultiOptions();
+}
+
+void wxWebSessionCURL::ApplyMultiOptions()
+{
+    const wxWebConnectionOptions& options = m_connectionOptions;
+
+    // For all these options 0 means to use the default value.
+#if CURL_AT_LEAST_VERSION(7, 30, 0)
+    curl_multi_setopt(m_handle, CURLMOPT_MAX_HOST_CONNECTIONS,
+                      static_cast<long>(options.GetMaxConnectionsPerHost()));
+    curl_multi_setopt(m_handle, CURLMOPT_MAX_TOTAL_CONNECTIONS,
+                      static_cast<long>(options.GetMaxConnections()));
+#endif // curl >= 7.30
+    curl_multi_setopt(m_handle, CURLMOPT_MAXCONNECTS,
+                      static_cast<long>(options.GetMaxConnections()));
+
+#if CURL_AT_LEAST_VERSION(7, 43, 0)
+    const long pipelining = options.IsMultiplexingEnabled() ? CURLPIPE_MULTIPLEX
+                                                            : CURLPIPE_NOTHING;
+    curl_multi_setopt(m_handle, CURLMOPT_PIPELINING, pipelining);
+#endif // curl >= 7.43
+}
+
 bool wxWebSessionCURL::StartRequest(wxWebRequestCURL & request)
 {
     // Add request easy handle to multi handle
@@ -1242,6 +1355,21 @@ void wxWebSessionCURL::CancelRequest(wxWebRequestCURL* request)
     request->SetState(wxWebRequest::State_Cancelled);
 }
 
+void wxWebSessionCURL::ResumeRequest(wxWebRequestCURL& request)
+{
+    // The transfer could have been cancelled since it was paused.
+    CURL* curl = request.GetHandle();
+    if ( m_activeTransfers.find(curl) == m_activeTransfers.end() )
+        return;
+
+    // Note that this may call the write callback, and even pause the transfer
+    // again, before returning and that libcurl takes care of scheduling the
+    // timeout necessary to continue the transfer using our TimerCallback().
+    const CURLcode code = curl_easy_pause(curl, CURLPAUSE_CONT);
+    if ( code != CURLE_OK )
+        FailRequest(curl, curl_easy_strerror(code));
+}
+
 void wxWebSessionCURL::RequestHasTerminated(wxWebRequestCURL* request)
 {
     // If this transfer is currently active, stop it.
@@ -1262,6 +1390,77 @@ wxVersionInfo wxWebSessionBaseCURL::GetLibraryVersionInfo() const
         desc);
 }
 
+bool
+wxWebSessionBaseCURL::SetConnectionOptions(const wxWebConnectionOptions& options)
+{
+    m_connectionOptions = options;
+
+    OnConnectionOptionsChanged();
+
+    return true;
+}
+
+wxWebConnectionStats wxWebSessionBaseCURL::GetConnectionStats() const
+{
+    return wxWebConnectionStats(m_requestCount,
+                                m_newConnectionCount,
+                                m_reusedConnectionCount,
+                                m_multiplexedRequestCount);
+}
+
+void wxWebSessionBaseCURL::ApplyConnectionOptions(CURL* handle) const
+{
+    const wxWebConnectionOptions& options = m_connectionOptions;
+
+    wxCURLSetOpt(handle, CURLOPT_DNS_CACHE_TIMEOUT,
+                 static_cast<long>(options.GetDNSCacheTimeout()));
+
+#if CURL_AT_LEAST_VERSION(7, 47, 0)
+    // Note that HTTP/2 is only used for HTTPS connections, as using it for
+    // plain HTTP would require the server to support the upgrade from
+    // HTTP/1.1, which is not the case for many of them.
+    wxCURLSetOpt(handle, CURLOPT_HTTP_VERSION,
+                 options.IsMultiplexingEnabled() ? CURL_HTTP_VERSION_2TLS
+                                                 : CURL_HTTP_VERSION_1_1);
+#endif // curl >= 7.47
+
+#if CURL_AT_LEAST_VERSION(7, 43, 0)
+    if ( options.IsMultiplexingEnabled() && options.ShouldWaitForMultiplexing() )
+        wxCURLSetOpt(handle, CURLOPT_PIPEWAIT, 1L);
+#endif // curl >= 7.43
+
+    // Sync sessions use the connection cache of their only handle, while the
+    // async ones use the cache of the multi handle configured separately.
+    if ( !IsAsync() && options.GetMaxConnections() )
+    {
+        wxCURLSetOpt(handle, CURLOPT_MAXCONNECTS,
+                     static_cast<long>(options.GetMaxConnections()));
+    }
+}
+
+void wxWebSessionBaseCURL::UpdateConnectionStats(CURL* handle)
+{
+    ++m_requestCount;
+
+    long numConnects = 0;
+    if ( curl_easy_getinfo(handle, CURLINFO_NUM_CONNECTS, &numConnects) == CURLE_OK )
+    {
+        if ( numConnects )
+            m_newConnectionCount += numConnects;
+        else
+            ++m_reusedConnectionCount;
+    }
+
+#if CURL_AT_LEAST_VERSION(7, 50, 0)
+    long httpVersion = 0;
+    if ( curl_easy_getinfo(handle, CURLINFO_HTTP_VERSION, &httpVersion) == CURLE_OK &&
+            httpVersion >= CURL_HTTP_VERSION_2_0 )
+    {
+        ++m_multiplexedRequestCount;
+    }
+#endif // curl >= 7.50
+}
+
 bool wxWebSessionBaseCURL::CurlRuntimeAtLeastVersion(unsigned int major,
                                                      unsigned int minor,
                                                      unsigned int patch)
@@ -1488,14 +1687,26 @@ void wxWebSessionCURL::StopActiveTransfer(CURL* curl)
         // Remove the CURL easy handle from the CURLM multi handle.
         curl_multi_remove_handle(m_handle, curl);
 
-        // If the transfer was active, close its socket.
+        // Clean up the maps.
+        RemoveActiveSocket(curl);
+
+        // If the transfer was active, close its socket, unless it's still
+        // used by another transfer multiplexed over the same connection.
         if ( activeSocket != CURL_SOCKET_BAD )
         {
-            wxCloseSocket(activeSocket);
-        }
+            bool socketInUse = false;
+            for ( const auto& kv : m_activeSockets )
+            {
+                if ( kv.second == activeSocket )
+                {
+                    socketInUse = true;
+                    break;
+                }
+            }
 
-        // Clean up the maps.
-        RemoveActiveSocket(curl);
+            if ( !socketInUse )
+                wxCloseSocket(activeSocket);
+        }
         m_activeTransfers.erase(it);
     }
 }
@@ -23,6 +23,11 @@
     #include "wx/utils.h"
 #endif
 
+#include "wx/thread.h"
+
+#include <algorithm>
+#include <vector>
+
 
 // normally, the compiler options should contain -I../zlib, but it is
 // apparently not the case for all MSW makefiles and so, unless we use
@@ -40,6 +45,14 @@ enum {
     ZSTREAM_AUTO        = 0x20      // auto detect between gzip and zlib
 };
 
+// the amount of compressed data read ahead per thread when decompressing
+// multi-member gzip streams in parallel, and the maximum it can grow to
+// if the members are bigger than this
+enum {
+    ZSTREAM_PARALLEL_CHUNK      = 512 * 1024,
+    ZSTREAM_PARALLEL_MAX_CHUNK  = 16 * 1024 * 1024
+};
+
 
 wxVersionInfo wxGetZlibVersionInfo()
 {
@@ -122,6 +135,318 @@ wxGzipClassFactory::GetProtocols(wxStreamProtocolType type) const
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+// Parallel decompression of multi-member gzip streams
+//
+// As gzip doesn't store the size of the compressed members, their boundaries
+// can't be found without decompressing them. So a chunk of the input is read
+// ahead and split between the threads, each of which decompresses the
+// members starting at all the possible gzip headers in its part. Then the
+// members starting at the real boundaries, i.e. at the start of the chunk and
+// at the end of each successfully decompressed member, are returned in order.
+//
+// Anything that can't be decompressed like this, i.e. a member bigger than
+// the chunk or corrupted data, is left to wxZlibInputStream to decompress
+// normally, which also ensures that the errors are reported as usual.
+
+namespace
+{
+
+struct wxZlibMember
+{
+    size_t start;               // offsets of the member in the chunk
+    size_t end;
+    std::vector<char> data;     // decompressed data
+};
+
+inline bool operator<(const wxZlibMember& member, size_t start)
+{
+    return member.start < start;
+}
+
+// Decompresses the members starting in the given part of the chunk.
+class wxZlibInflateWorker
+{
+public:
+    wxZlibInflateWorker(const std::vector<unsigned char>& input,
+                        size_t begin, size_t end)
+        : m_input(input), m_begin(begin), m_end(end)
+    {
+    }
+
+    void Run()
+    {
+        // the start of the chunk is known to be a member boundary
+        size_t pos = m_begin ? FindHeader(m_begin) : 0;
+
+        while (pos < m_end) {
+            wxZlibMember member;
+            if (Inflate(pos, member)) {
+                pos = member.end;
+                m_members.push_back(std::move(member));
+            } else {
+                pos = FindHeader(pos + 1);
+            }
+        }
+    }
+
+    std::vector<wxZlibMember> m_members;
+
+private:
+    // Returns the offset of the first possible gzip header at or after pos.
+    size_t FindHeader(size_t pos) const
+    {
+        const size_t size = m_input.size();
+
+        for ( ; pos + 4 <= size; pos++) {
+            const void *p = memchr(&m_input[pos], 0x1f, size - pos);
+            if (!p)
+                break;
+
+            pos = static_cast<const unsigned char*>(p) - &m_input[0];
+            if (pos + 4 <= size && m_input[pos + 1] == 0x8b &&
+                    m_input[pos + 2] == Z_DEFLATED &&
+                    (m_input[pos + 3] & 0xe0) == 0)
+                return pos;
+        }
+
+        return size;
+    }
+
+    bool Inflate(size_t start, wxZlibMember& member)
+    {
+        z_stream_s z;
+        memset(&z, 0, sizeof(z));
+        if (inflateInit2(&z, MAX_WBITS | ZSTREAM_GZIP) != Z_OK)
+            return false;
+
+        z.next_in = const_cast<unsigned char*>(&m_input[start]);
+        z.avail_in = m_input.size() - start;
+
+        if (m_buffer.empty())
+            m_buffer.resize(4 * ZSTREAM_BUFFER_SIZE);
+
+        z.next_out = reinterpret_cast<unsigned char*>(&m_buffer[0]);
+        z.avail_out = m_buffer.size();
+
+        int err;
+        for (;;) {
+            err = inflate(&z, Z_NO_FLUSH);
+            if (err != Z_OK)
+                break;
+
+            if (z.avail_out == 0) {
+                const size_t size = m_buffer.size();
+                m_buffer.resize(2 * size);
+                z.next_out = reinterpret_cast<unsigned char*>(&m_buffer[size]);
+                z.avail_out = size;
+            }
+        }
+
+        const bool ok = err == Z_STREAM_END;
+        if (ok) {
+            member.start = start;
+            member.end = m_input.size() - z.avail_in;
+            m_buffer.resize(z.total_out);
+            member.data.swap(m_buffer);
+        }
+
+        inflateEnd(&z);
+        return ok;
+    }
+
+    const std::vector<unsigned char>& m_input;
+    const size_t m_begin;
+    const size_t m_end;
+    std::vector<char> m_buffer;
+};
+
+#if wxUSE_THREADS
+
+class wxZlibInflateThread : public wxThread
+{
+public:
+    explicit wxZlibInflateThread(wxZlibInflateWorker& worker)
+        : wxThread(wxTHREAD_JOINABLE), m_worker(worker)
+    {
+    }
+
+protected:
+    ExitCode Entry() override
+    {
+        m_worker.Run();
+        return nullptr;
+    }
+
+private:
+    wxZlibInflateWorker& m_worker;
+};
+
+#endif // wxUSE_THREADS
+
+} // anonymous namespace
+
+class wxZlibParallelInflater
+{
+public:
+    explicit wxZlibParallelInflater(unsigned threads)
+        : m_threads(threads),
+          m_chunkSize(ZSTREAM_PARALLEL_CHUNK),
+          m_outIndex(0),
+          m_outPos(0)
+    {
+    }
+
+    // Copies the decompressed data to the buffer, decompressing the next
+    // chunk when needed. Returns 0 if the following data couldn't be
+    // decompressed in parallel.
+    size_t Read(wxInputStream& stream, char *buffer, size_t size);
+
+    // Returns the input following the member decompressed by the caller.
+    void PutBack(const unsigned char *data, size_t len)
+    {
+        m_input.insert(m_input.begin(), data, data + len);
+    }
+
+    // Gives back the read ahead input to the stream, so that the caller can
+    // decompress it.
+    void UngetInput(wxInputStream& stream)
+    {
+        if (!m_input.empty()) {
+            stream.Ungetch(&m_input[0], m_input.size());
+            m_input.clear();
+        }
+    }
+
+private:
+    bool InflateChunk(wxInputStream& stream);
+
+    const unsigned m_threads;
+    size_t m_chunkSize;
+
+    std::vector<unsigned char> m_input;
+
+    std::vector<wxZlibMember> m_output;
+    size_t m_outIndex;
+    size_t m_outPos;
+};
+
+size_t wxZlibParallelInflater::Read(wxInputStream& stream,
+                                    char *buffer,
+                                    size_t size)
+{
+    size_t total = 0;
+
+    while (total < size) {
+        if (m_outIndex == m_output.size() && !InflateChunk(stream))
+            break;
+
+        std::vector<char>& data = m_output[m_outIndex].data;
+        const size_t len = wxMin(size - total, data.size() - m_outPos);
+
+        memcpy(buffer + total, &data[m_outPos], len);
+        total += len;
+        m_outPos += len;
+
+        if (m_outPos == data.size()) {
+            std::vector<char>().swap(data);
+            m_outIndex++;
+            m_outPos = 0;
+        }
+    }
+
+    return total;
+}
+
+bool wxZlibParallelInflater::InflateChunk(wxInputStream& stream)
+{
+    m_output.clear();
+    m_outIndex = 0;
+    m_outPos = 0;
+
+    const size_t want = m_chunkSize * m_threads;
+    size_t size = m_input.size();
+
+    if (size < want) {
+        m_input.resize(want);
+        while (size < want && stream.IsOk())
+            size += stream.Read(&m_input[size], want - size).LastRead();
+        m_input.resize(size);
+    }
+
+    if (size < 4 || m_input[0] != 0x1f || m_input[1] != 0x8b)
+        return false;
+
+    std::vector<wxZlibInflateWorker> workers;
+    workers.reserve(m_threads);
+
+    const size_t part = (size + m_threads - 1) / m_threads;
+    for (size_t begin = 0; begin < size; begin += part)
+        workers.emplace_back(m_input, begin, wxMin(begin + part, size));
+
+#if wxUSE_THREADS
+    std::vector<wxZlibInflateThread*> threads;
+    for (size_t n = 1; n < workers.size(); n++) {
+        wxZlibInflateThread *thread = new wxZlibInflateThread(workers[n]);
+        if (thread->Run() == wxTHREAD_NO_ERROR) {
+            threads.push_back(thread);
+        } else {
+            delete thread;
+            workers[n].Run();
+        }
+    }
+
+    workers[0].Run();
+
+    for (size_t n = 0; n < threads.size(); n++) {
+        threads[n]->Wait();
+        delete threads[n];
+    }
+#else
+    for (size_t n = 0; n < workers.size(); n++)
+        workers[n].Run();
+#endif
+
+    std::vector<wxZlibMember> members;
+    for (size_t n = 0; n < workers.size(); n++) {
+        std::move(workers[n].m_members.begin(), workers[n].m_members.end(),
+                  std::back_inserter(members));
+    }
+
+    // the members found by each worker are already sorted, but they can
+    // overlap with the ones found by the next worker if it started inside
+    // a member
+    std::stable_sort(members.begin(), members.end(),
+        [](const wxZlibMember& a, const wxZlibMember& b)
+        {
+            return a.start < b.start;
+        });
+
+    size_t pos = 0;
+    for (;;) {
+        std::vector<wxZlibMember>::iterator it =
+            std::lower_bound(members.begin(), members.end(), pos);
+        if (it == members.end() || it->start != pos)
+            break;
+
+        pos = it->end;
+        m_output.push_back(std::move(*it));
+    }
+
+    m_input.erase(m_input.begin(), m_input.begin() + pos);
+
+    if (m_output.empty()) {
+        // the first member is either bigger than the chunk or corrupted,
+        // in the former case use bigger chunks from now on
+        if (size == want && m_chunkSize < ZSTREAM_PARALLEL_MAX_CHUNK)
+            m_chunkSize *= 2;
+        return false;
+    }
+
+    return true;
+}
+
+
 //////////////////////
 // wxZlibInputStream
 //////////////////////
@@ -144,9 +469,17 @@ void wxZlibInputStream::Init(int flags)
   m_z_buffer = new unsigned char[ZSTREAM_BUFFER_SIZE];
   m_z_size = ZSTREAM_BUFFER_SIZE;
   m_pos = 0;
+  m_multiMember = flags == wxZLIB_GZIP_MULTI;
+  m_firstMember = true;
+  m_inMember = false;
+  m_parallel = nullptr;
+
+  if (m_multiMember)
+    SetThreadCount(0);
 
   // if gzip is asked for but not supported...
-  if ((flags == wxZLIB_GZIP || flags == wxZLIB_AUTO) && !CanHandleGZip()) {
+  if ((flags == wxZLIB_GZIP || flags == wxZLIB_GZIP_MULTI ||
+       flags == wxZLIB_AUTO) && !CanHandleGZip()) {
     if (flags == wxZLIB_AUTO) {
       // an error will come later if the input turns out not to be a zlib
       flags = wxZLIB_ZLIB;
@@ -171,6 +504,7 @@ void wxZlibInputStream::Init(int flags)
         case wxZLIB_ZLIB:       windowBits = MAX_WBITS; break;
         case wxZLIB_GZIP:       windowBits = MAX_WBITS | ZSTREAM_GZIP; break;
         case wxZLIB_AUTO:       windowBits = MAX_WBITS | ZSTREAM_AUTO; break;
+        case wxZLIB_GZIP_MULTI: windowBits = MAX_WBITS | ZSTREAM_GZIP; break;
         default:                wxFAIL_MSG(wxT("Invalid zlib flag"));
       }
 
@@ -189,6 +523,25 @@ wxZlibInputStream::~wxZlibInputStream()
   delete m_inflate;
 
   delete [] m_z_buffer;
+  delete m_parallel;
+}
+
+void wxZlibInputStream::SetThreadCount(unsigned count)
+{
+  wxCHECK_RET(m_firstMember, wxT("Must be called before reading"));
+
+#if wxUSE_THREADS
+  if (!count) {
+    const int cpus = wxThread::GetCPUCount();
+    count = cpus > 0 ? cpus : 1;
+  }
+#else
+  count = 1;
+#endif
+
+  wxDELETE(m_parallel);
+  if (m_multiMember && count > 1)
+    m_parallel = new wxZlibParallelInflater(count);
 }
 
 size_t wxZlibInputStream::OnSysRead(void *buffer, size_t size)
@@ -200,6 +553,82 @@ size_t wxZlibInputStream::OnSysRead(void *buffer, size_t size)
   if (!IsOk() || !size)
     return 0;
 
+  if (!m_multiMember) {
+    size = DoInflate(buffer, size);
+    m_pos += size;
+    return size;
+  }
+
+  char *out = static_cast<char*>(buffer);
+  size_t total = 0;
+
+  while (total < size && IsOk()) {
+    if (!m_inMember) {
+      if (m_parallel) {
+        size_t len = m_parallel->Read(*m_parent_i_stream, out + total, size - total);
+        if (len) {
+          m_firstMember = false;
+          total += len;
+          continue;
+        }
+
+        // the next member couldn't be decompressed in parallel, so do it here
+        m_parallel->UngetInput(*m_parent_i_stream);
+      }
+
+      if (!StartNextMember())
+        break;
+    }
+
+    total += DoInflate(out + total, size - total);
+  }
+
+  m_pos += total;
+  return total;
+}
+
+// Prepares for decompressing the next member of a multi-member gzip stream,
+// returns false if there are no more members.
+bool wxZlibInputStream::StartNextMember()
+{
+  if (!m_firstMember) {
+    while (m_inflate->avail_in < 2 && m_parent_i_stream->IsOk()) {
+      if (m_inflate->avail_in)
+        m_z_buffer[0] = *m_inflate->next_in;
+      m_parent_i_stream->Read(m_z_buffer + m_inflate->avail_in,
+                              m_z_size - m_inflate->avail_in);
+      m_inflate->next_in = m_z_buffer;
+      m_inflate->avail_in += m_parent_i_stream->LastRead();
+    }
+
+    if (m_inflate->avail_in < 2 ||
+        m_inflate->next_in[0] != 0x1f || m_inflate->next_in[1] != 0x8b) {
+      // Not another member, so treat it like the data following a single
+      // member stream.
+      if (!m_inflate->avail_in && !m_parent_i_stream->Eof()) {
+        m_lasterror = wxSTREAM_READ_ERROR;
+        return false;
+      }
+
+      if (m_inflate->avail_in) {
+        m_parent_i_stream->Reset();
+        m_parent_i_stream->Ungetch(m_inflate->next_in, m_inflate->avail_in);
+        m_inflate->avail_in = 0;
+      }
+      m_lasterror = wxSTREAM_EOF;
+      return false;
+    }
+
+    inflateReset(m_inflate);
+  }
+
+  m_firstMember = false;
+  m_inMember = true;
+  return true;
+}
+
+size_t wxZlibInputStream::DoInflate(void *buffer, size_t size)
+{
   int err = Z_OK;
   m_inflate->next_out = (unsigned char *)buffer;
   m_inflate->avail_out = size;
@@ -218,7 +647,15 @@ size_t wxZlibInputStream::OnSysRead(void *buffer, size_t size)
         break;
 
     case Z_STREAM_END:
-      if (m_inflate->avail_out) {
+      if (m_multiMember) {
+        // continue with the next member, if any
+        m_inMember = false;
+        if (m_parallel && m_inflate->avail_in) {
+          m_parallel->PutBack(m_inflate->next_in, m_inflate->avail_in);
+          m_inflate->avail_in = 0;
+        }
+      }
+      else if (m_inflate->avail_out) {
         // Unread any data taken from past the end of the deflate stream, so that
         // any additional data can be read from the underlying stream (the crc
         // in a gzip for example)
@@ -250,9 +687,7 @@ size_t wxZlibInputStream::OnSysRead(void *buffer, size_t size)
       m_lasterror = wxSTREAM_READ_ERROR;
   }
 
-  size -= m_inflate->avail_out;
-  m_pos += size;
-  return size;
+  return size - m_inflate->avail_out;
 }
 
 /* static */ bool wxZlibInputStream::CanHandleGZip()
@@ -77,6 +77,7 @@ wxGCC_WARNING_RESTORE(cast-qual)
 
 #ifndef WX_PRECOMP
     #include "wx/utils.h"                   // Only for wxMin()
+    #include "wx/module.h"
 #endif // WX_PRECOMP
 
 #include "wx/bmpbndl.h"
@@ -89,8 +90,17 @@ wxGCC_WARNING_RESTORE(cast-qual)
 #endif
 #include "wx/rawbmp.h"
 
+#if wxUSE_THREADS
+    #include "wx/thread.h"
+
+    #include <atomic>
+#endif // wxUSE_THREADS
+
 #include "wx/private/bmpbndl.h"
 
+#include <list>
+#include <unordered_set>
+
 // ----------------------------------------------------------------------------
 // private helpers
 // ----------------------------------------------------------------------------
@@ -98,6 +108,115 @@ wxGCC_WARNING_RESTORE(cast-qual)
 namespace
 {
 
+class wxBitmapBundleImplSVG;
+
+// Default value for the maximal total size of the bitmaps cached by all SVG
+// bundles, see wxBitmapBundle::SetSVGCacheLimit().
+const size_t SVG_CACHE_DEFAULT_LIMIT = 32*1024*1024;
+
+// Maximal number of different sizes cached by a single bundle: we need more
+// than one of them for the multi-monitor setups using different DPIs and
+// when the same bundle is used in different sizes, e.g. in a toolbar and in
+// a menu, but there is no need to keep all the sizes ever used.
+const size_t SVG_CACHE_MAX_SIZES = 4;
+
+// Bitmaps cached by all SVG bundles.
+//
+// The bitmaps are kept in the order of their use, with the most recently used
+// one at the front, and the least recently used ones are removed when their
+// total size exceeds the limit, so that the memory used by the cache remains
+// bounded even if many bundles are used in many different sizes.
+//
+// Just as wxBitmapBundle itself, this class is only used from the main thread.
+class wxSVGBitmapCache
+{
+public:
+    struct Entry
+    {
+        Entry(wxBitmapBundleImplSVG* owner_, const wxBitmap& bitmap_)
+            : owner(owner_),
+              bitmap(bitmap_),
+              memory(static_cast<size_t>(bitmap_.GetWidth())*
+                        bitmap_.GetHeight()*4)
+        {
+        }
+
+        wxBitmapBundleImplSVG* const owner;
+        const wxBitmap bitmap;
+        const size_t memory;
+    };
+
+    typedef std::list<Entry>::iterator Iterator;
+
+    // Return the global cache, creating it if necessary.
+    static wxSVGBitmapCache& Get()
+    {
+        if ( !ms_cache )
+            ms_cache = new wxSVGBitmapCache();
+
+        return *ms_cache;
+    }
+
+    // Return the number of bitmaps in the global cache without creating it.
+    static size_t GetCount()
+    {
+        return ms_cache ? ms_cache->m_entries.size() : 0;
+    }
+
+    // Destroy the global cache, if it exists, freeing all bitmaps.
+    static void Destroy()
+    {
+        wxDELETE(ms_cache);
+    }
+
+    ~wxSVGBitmapCache();
+
+    void SetLimit(size_t limit)
+    {
+        m_limit = limit;
+
+        Trim();
+    }
+
+    // Add a new bitmap to the cache, this can result in removing some
+    // bitmaps from it, but never the one being added.
+    Iterator Add(wxBitmapBundleImplSVG* owner, const wxBitmap& bitmap);
+
+    // Mark the bitmap as the most recently used one.
+    void Touch(Iterator it)
+    {
+        m_entries.splice(m_entries.begin(), m_entries, it);
+    }
+
+    void Remove(Iterator it)
+    {
+        m_memory -= it->memory;
+        m_entries.erase(it);
+    }
+
+private:
+    wxSVGBitmapCache()
+    {
+        m_memory = 0;
+        m_limit = SVG_CACHE_DEFAULT_LIMIT;
+    }
+
+    // Remove the least recently used bitmaps until we fit into the limit.
+    void Trim();
+
+    static wxSVGBitmapCache* ms_cache;
+
+    std::list<Entry> m_entries;
+
+    // The total memory used by all the bitmaps in m_entries and its limit.
+    size_t m_memory,
+           m_limit;
+
+    wxDECLARE_NO_COPY_CLASS(wxSVGBitmapCache);
+};
+
+wxSVGBitmapCache* wxSVGBitmapCache::ms_cache = nullptr;
+
 class wxBitmapBundleImplSVG : public wxBitmapBundleImpl
 {
 public:
@@ -111,6 +230,8 @@ public:
 
     ~wxBitmapBundleImplSVG()
     {
+        ClearCache();
+
         nsvgDeleteRasterizer(m_svgRasterizer);
         nsvgDelete(m_svgImage);
     }
@@ -119,28 +240,99 @@ public:
     virtual wxSize GetPreferredBitmapSizeAtScale(double scale) const override;
     virtual wxBitmap GetBitmap(const wxSize& size) override;
 
-private:
-    wxBitmap DoRasterize(const wxSize& size);
+    // Return true if we already have the bitmap of this size.
+    bool IsCached(const wxSize& size) const;
+
+    // Add the bitmap to the cache and return it.
+    wxBitmap AddToCache(const wxBitmap& bitmap);
+
+    // Forget about the bitmap being removed from the global cache.
+    void OnRemovedFromCache(wxSVGBitmapCache::Iterator it);
+
+    // Remove all our bitmaps from the global cache.
+    void ClearCache();
 
+    // Rasterize the image in the given size into the buffer of size.x*size.y
+    // RGBA pixels using the provided rasterizer.
+    //
+    // This function doesn't modify anything in this object and can be called
+    // from any thread, as long as each of them uses its own rasterizer.
+    void Rasterize(NSVGrasterizer* rasterizer,
+                   const wxSize& size,
+                   unsigned char* buffer) const;
+
+    // Create the bitmap from the data returned by Rasterize().
+    static wxBitmap CreateBitmap(const wxSize& size, const unsigned char* src);
+
+private:
     NSVGimage* const m_svgImage;
     NSVGrasterizer* const m_svgRasterizer;
 
     const wxSize m_sizeDef;
 
-    // Cache the last used bitmap (may be invalid if not used yet).
+    // Our bitmaps in the global cache, with the most recently used first.
     //
-    // Note that we cache only the last bitmap and not all the bitmaps ever
-    // requested from GetBitmap() for the different sizes because there would
-    // be no way to clear such cache and its growth could be unbounded,
-    // resulting in too many bitmap objects being used in an application using
-    // SVG for all of its icons.
-    wxBitmap m_cachedBitmap;
+    // Note that we cache at most SVG_CACHE_MAX_SIZES bitmaps and not all the
+    // bitmaps ever requested from GetBitmap() for the different sizes because
+    // their number could grow unbounded, resulting in too many bitmap objects
+    // being used in an application using SVG for all of its icons.
+    wxVector<wxSVGBitmapCache::Iterator> m_cached;
 
     wxDECLARE_NO_COPY_CLASS(wxBitmapBundleImplSVG);
 };
 
 } // anonymous namespace
 
+// ============================================================================
+// wxSVGBitmapCache implementation
+// ============================================================================
+
+wxSVGBitmapCache::~wxSVGBitmapCache()
+{
+    for ( Iterator it = m_entries.begin(); it != m_entries.end(); ++it )
+        it->owner->OnRemovedFromCache(it);
+}
+
+wxSVGBitmapCache::Iterator
+wxSVGBitmapCache::Add(wxBitmapBundleImplSVG* owner, const wxBitmap& bitmap)
+{
+    m_entries.emplace_front(owner, bitmap);
+    m_memory += m_entries.front().memory;
+
+    Trim();
+
+    return m_entries.begin();
+}
+
+void wxSVGBitmapCache::Trim()
+{
+    // Always keep the most recently used bitmap, even if it's bigger than
+    // the limit on its own, as it is likely to be requested again soon.
+    while ( m_memory > m_limit && m_entries.size() > 1 )
+    {
+        Iterator it = m_entries.end();
+        --it;
+
+        it->owner->OnRemovedFromCache(it);
+        Remove(it);
+    }
+}
+
+// Module destroying the cache to free the bitmaps before the library cleanup.
+class wxSVGBitmapCacheModule : public wxModule
+{
+public:
+    wxSVGBitmapCacheModule() { }
+
+    virtual bool OnInit() override { return true; }
+    virtual void OnExit() override { wxSVGBitmapCache::Destroy(); }
+
+private:
+    wxDECLARE_DYNAMIC_CLASS(wxSVGBitmapCacheModule);
+};
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxSVGBitmapCacheModule, wxModule);
+
 // ============================================================================
 // wxBitmapBundleImplSVG implementation
 // ============================================================================
@@ -158,20 +350,89 @@ wxSize wxBitmapBundleImplSVG::GetPreferredBitmapSizeAtScale(double scale) const
 
 wxBitmap wxBitmapBundleImplSVG::GetBitmap(const wxSize& size)
 {
-    if ( !m_cachedBitmap.IsOk() || m_cachedBitmap.GetSize() != size )
+    for ( size_t n = 0; n < m_cached.size(); ++n )
     {
-        m_cachedBitmap = DoRasterize(size);
+        const wxSVGBitmapCache::Iterator it = m_cached[n];
+        if ( it->bitmap.GetSize() == size )
+        {
+            wxSVGBitmapCache::Get().Touch(it);
+
+            m_cached.erase(m_cached.begin() + n);
+            m_cached.insert(m_cached.begin(), it);
+
+            return it->bitmap;
+        }
     }
 
-    return m_cachedBitmap;
+    wxVector<unsigned char> buffer(size.x*size.y*4);
+    Rasterize(m_svgRasterizer, size, &buffer[0]);
+
+    return AddToCache(CreateBitmap(size, &buffer[0]));
 }
 
-wxBitmap wxBitmapBundleImplSVG::DoRasterize(const wxSize& size)
+bool wxBitmapBundleImplSVG::IsCached(const wxSize& size) const
+{
+    for ( size_t n = 0; n < m_cached.size(); ++n )
+    {
+        if ( m_cached[n]->bitmap.GetSize() == size )
+            return true;
+    }
+
+    return false;
+}
+
+wxBitmap wxBitmapBundleImplSVG::AddToCache(const wxBitmap& bitmap)
+{
+    wxSVGBitmapCache& cache = wxSVGBitmapCache::Get();
+
+    if ( m_cached.size() >= SVG_CACHE_MAX_SIZES )
+    {
+        cache.Remove(m_cached.back());
+        m_cached.pop_back();
+    }
+
+    // Note that adding the bitmap to the cache can remove our other bitmaps
+    // from it and so modify m_cached, so it must be done before inserting
+    // the new element into it.
+    const wxSVGBitmapCache::Iterator it = cache.Add(this, bitmap);
+    m_cached.insert(m_cached.begin(), it);
+
+    return bitmap;
+}
+
+void wxBitmapBundleImplSVG::OnRemovedFromCache(wxSVGBitmapCache::Iterator it)
+{
+    for ( size_t n = 0; n < m_cached.size(); ++n )
+    {
+        if ( m_cached[n] == it )
+        {
+            m_cached.erase(m_cached.begin() + n);
+            break;
+        }
+    }
+}
+
+void wxBitmapBundleImplSVG::ClearCache()
+{
+    // Don't create the cache if it had been already destroyed.
+    if ( m_cached.empty() )
+        return;
+
+    wxSVGBitmapCache& cache = wxSVGBitmapCache::Get();
+
+    for ( size_t n = 0; n < m_cached.size(); ++n )
+        cache.Remove(m_cached[n]);
+
+    m_cached.clear();
+}
+
+void wxBitmapBundleImplSVG::Rasterize(NSVGrasterizer* rasterizer,
+                                      const wxSize& size,
+                                      unsigned char* buffer) const
 {
-    wxVector<unsigned char> buffer(size.x*size.y*4);
     nsvgRasterize
     (
-        m_svgRasterizer,
+        rasterizer,
         m_svgImage,
         0.0, 0.0,           // no offset
         wxMin
@@ -179,16 +440,20 @@ wxBitmap wxBitmapBundleImplSVG::DoRasterize(const wxSize& size)
             size.x/m_svgImage->width,
             size.y/m_svgImage->height
         ),                  // scale
-        &buffer[0],
+        buffer,
         size.x, size.y,
         size.x*4            // stride -- we have no gaps between lines
     );
+}
 
+/* static */
+wxBitmap
+wxBitmapBundleImplSVG::CreateBitmap(const wxSize& size, const unsigned char* src)
+{
     wxBitmap bitmap(size, 32);
     wxAlphaPixelData bmpdata(bitmap);
     wxAlphaPixelData::Iterator dst(bmpdata);
 
-    const unsigned char* src = &buffer[0];
     for ( int y = 0; y < size.y; ++y )
     {
         dst.MoveTo(bmpdata, 0, y);
@@ -222,6 +487,192 @@ wxBitmap wxBitmapBundleImplSVG::DoRasterize(const wxSize& size)
     return bitmap;
 }
 
+// ============================================================================
+// wxBitmapBundle SVG-specific functions
+// ============================================================================
+
+namespace
+{
+
+// A single bitmap to create in wxBitmapBundle::PrerenderSVG().
+struct wxSVGPrerenderJob
+{
+    wxSVGPrerenderJob(wxBitmapBundleImplSVG* impl_, const wxSize& size_)
+        : impl(impl_),
+          size(size_),
+          buffer(size_.x*size_.y*4)
+    {
+    }
+
+    wxBitmapBundleImplSVG* impl;
+    wxSize size;
+    wxVector<unsigned char> buffer;
+};
+
+// Rasterize the images for all jobs not taken by the other workers yet.
+class wxSVGPrerenderWorker
+{
+public:
+    wxSVGPrerenderWorker(wxVector<wxSVGPrerenderJob>& jobs,
+#if wxUSE_THREADS
+                         std::atomic<size_t>& next
+#else
+                         size_t& next
+#endif
+                        )
+        : m_jobs(jobs),
+          m_next(next)
+    {
+    }
+
+    void Run()
+    {
+        // The parsed image can be shared between threads, but each of them
+        // needs its own rasterizer.
+        NSVGrasterizer* const rasterizer = nsvgCreateRasterizer();
+
+        for ( ;; )
+        {
+            const size_t n = m_next++;
+            if ( n >= m_jobs.size() )
+                break;
+
+            wxSVGPrerenderJob& job = m_jobs[n];
+            job.impl->Rasterize(rasterizer, job.size, &job.buffer[0]);
+        }
+
+        nsvgDeleteRasterizer(rasterizer);
+    }
+
+private:
+    wxVector<wxSVGPrerenderJob>& m_jobs;
+#if wxUSE_THREADS
+    std::atomic<size_t>& m_next;
+#else
+    size_t& m_next;
+#endif
+};
+
+#if wxUSE_THREADS
+
+class wxSVGPrerenderThread : public wxThread
+{
+public:
+    explicit wxSVGPrerenderThread(wxSVGPrerenderWorker& worker)
+        : wxThread(wxTHREAD_JOINABLE), m_worker(worker)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        m_worker.Run();
+        return nullptr;
+    }
+
+private:
+    wxSVGPrerenderWorker& m_worker;
+};
+
+#endif // wxUSE_THREADS
+
+} // anonymous namespace
+
+/* static */
+void wxBitmapBundle::SetSVGCacheLimit(size_t bytes)
+{
+    wxSVGBitmapCache::Get().SetLimit(bytes);
+}
+
+size_t wxGetSVGCachedBitmapsCount()
+{
+    return wxSVGBitmapCache::GetCount();
+}
+
+/* static */
+void
+wxBitmapBundle::PrerenderSVG(const wxVector<wxBitmapBundle>& bundles,
+                             const wxSize& size)
+{
+#ifdef wxNO_RTTI
+    // We can't find the bundles created from SVG without RTTI, so the bitmaps
+    // will be just rasterized on demand.
+    wxUnusedVar(bundles);
+    wxUnusedVar(size);
+#else // !wxNO_RTTI
+    wxVector<wxSVGPrerenderJob> jobs;
+    std::unordered_set<wxBitmapBundleImplSVG*> seen;
+
+    for ( size_t n = 0; n < bundles.size(); ++n )
+    {
+        // Just ignore the bundles not created from SVG, there is nothing to
+        // do in advance for them.
+        wxBitmapBundleImplSVG* const
+            impl = dynamic_cast<wxBitmapBundleImplSVG*>(bundles[n].GetImpl());
+        if ( !impl || !seen.insert(impl).second )
+            continue;
+
+        const wxSize sizeBitmap = size == wxDefaultSize
+                                    ? impl->GetDefaultSize()
+                                    : size;
+        if ( sizeBitmap.x <= 0 || sizeBitmap.y <= 0 )
+            continue;
+
+        if ( !impl->IsCached(sizeBitmap) )
+            jobs.push_back(wxSVGPrerenderJob(impl, sizeBitmap));
+    }
+
+    if ( jobs.empty() )
+        return;
+
+    // Rasterizing is done in parallel, as it doesn't involve any bitmaps,
+    // which can only be used from the main thread.
+#if wxUSE_THREADS
+    std::atomic<size_t> next(0);
+#else
+    size_t next = 0;
+#endif
+    wxSVGPrerenderWorker worker(jobs, next);
+
+#if wxUSE_THREADS
+    const int cpus = wxThread::GetCPUCount();
+    const size_t numThreads = wxMin(cpus > 1 ? static_cast<size_t>(cpus) : 1,
+                                    jobs.size());
+
+    wxVector<wxSVGPrerenderThread*> threads;
+    for ( size_t n = 1; n < numThreads; ++n )
+    {
+        wxSVGPrerenderThread* const thread = new wxSVGPrerenderThread(worker);
+        if ( thread->Run() != wxTHREAD_NO_ERROR )
+        {
+            delete thread;
+            break;
+        }
+
+        threads.push_back(thread);
+    }
+#endif // wxUSE_THREADS
+
+    // This thread takes part in rasterizing too.
+    worker.Run();
+
+#if wxUSE_THREADS
+    for ( size_t n = 0; n < threads.size(); ++n )
+    {
+        threads[n]->Wait();
+        delete threads[n];
+    }
+#endif // wxUSE_THREADS
+
+    for ( size_t n = 0; n < jobs.size(); ++n )
+    {
+        wxSVGPrerenderJob& job = jobs[n];
+        job.impl->AddToCache(wxBitmapBundleImplSVG::CreateBitmap(job.size,
+                                                                 &job.buffer[0]));
+    }
+#endif // wxNO_RTTI/!wxNO_RTTI
+}
+
 /* static */
 wxBitmapBundle wxBitmapBundle::FromSVG(char* data, const wxSize& sizeDef)
 {
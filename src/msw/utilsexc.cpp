@@ -890,8 +890,16 @@ long wxExecute(const wxString& cmd, int flags, wxProcess *handler,
 
         handler->SetPipeStreams(outStream, inStream, errStream);
 
-        bufOut.Init(outStream);
-        bufErr.Init(errStream);
+        if ( handler->IsRedirectingLines() && (flags & wxEXEC_SYNC) )
+        {
+            bufOut.InitLines(outStream, handler, &wxProcess::OnOutputLine);
+            bufErr.InitLines(errStream, handler, &wxProcess::OnErrorLine);
+        }
+        else
+        {
+            bufOut.Init(outStream);
+            bufErr.Init(errStream);
+        }
     }
 #endif // wxUSE_STREAMS
 
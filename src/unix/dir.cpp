@@ -62,6 +62,10 @@ public:
     const wxString& GetName() const { return m_dirname; }
 
 private:
+    // return true if the given entry is a directory, taking into account
+    // wxDIR_NO_FOLLOW flag
+    bool IsDir(const dirent *de, const wxString& fullname) const;
+
     DIR     *m_dir;
 
     wxString m_dirname;
@@ -109,6 +113,44 @@ wxDirData::~wxDirData()
     }
 }
 
+bool wxDirData::IsDir(const dirent *de, const wxString& fullname) const
+{
+#ifdef DT_UNKNOWN
+    // use the type returned by readdir() if the file system provides it to
+    // avoid calling stat() for each entry, which is very slow for the big
+    // directories, especially on network file systems
+    switch ( de->d_type )
+    {
+        case DT_DIR:
+            return true;
+
+        case DT_LNK:
+            // we need to check what the link points to, unless we don't
+            // follow the links at all
+            if ( m_flags & wxDIR_NO_FOLLOW )
+                return false;
+            break;
+
+        case DT_UNKNOWN:
+            // not all file systems support d_type, fall back to stat()
+            break;
+
+        default:
+            return false;
+    }
+#else // !DT_UNKNOWN
+    wxUnusedVar(de);
+#endif // DT_UNKNOWN/!DT_UNKNOWN
+
+    // notice that we may want to check the type of the path itself and not
+    // whatever it points to in case of a symlink
+    wxStructStat st;
+    const int rc = m_flags & wxDIR_NO_FOLLOW ? wxLstat(fullname, &st)
+                                             : wxStat(fullname, &st);
+
+    return rc == 0 && S_ISDIR(st.st_mode);
+}
+
 bool wxDirData::Read(wxString *filename)
 {
     dirent *de = nullptr;    // just to silence compiler warnings
@@ -127,8 +169,6 @@ bool wxDirData::Read(wxString *filename)
         if ( !de )
             return false;
 
-        de_d_name = wxString(de->d_name, *wxConvFileName);
-
         // don't return "." and ".." unless asked for
         if ( de->d_name[0] == '.' &&
              ((de->d_name[1] == '.' && de->d_name[2] == '\0') ||
@@ -138,32 +178,33 @@ bool wxDirData::Read(wxString *filename)
                 continue;
 
             // we found a valid match
+            de_d_name = wxString(de->d_name, *wxConvFileName);
             break;
         }
 
-        // check the type now: notice that we may want to check the type of
-        // the path itself and not whatever it points to in case of a symlink
-        wxFileName fn = wxFileName::DirName(path + de_d_name);
-        if ( m_flags & wxDIR_NO_FOLLOW )
-        {
-            fn.DontFollowLink();
-        }
-
-        if ( !(m_flags & wxDIR_FILES) && !fn.DirExists() )
-        {
-            // it's a file, but we don't want them
+        // skip the hidden files before doing anything else with them
+        if ( m_filespec.empty() &&
+                !(m_flags & wxDIR_HIDDEN) && de->d_name[0] == '.' )
             continue;
-        }
-        else if ( !(m_flags & wxDIR_DIRS) && fn.DirExists() )
+
+        de_d_name = wxString(de->d_name, *wxConvFileName);
+
+        // check the type now, unless we want both files and directories
+        if ( (m_flags & (wxDIR_FILES | wxDIR_DIRS)) !=
+                (wxDIR_FILES | wxDIR_DIRS) )
         {
-            // it's a dir, and we don't want it
-            continue;
+            const bool isDir = IsDir(de, path + de_d_name);
+            if ( !(m_flags & (isDir ? wxDIR_DIRS : wxDIR_FILES)) )
+            {
+                // it's a file or dir, but we don't want them
+                continue;
+            }
         }
 
         // finally, check the name
         if ( m_filespec.empty() )
         {
-            matches = m_flags & wxDIR_HIDDEN ? true : de->d_name[0] != '.';
+            matches = true;
         }
         else
         {
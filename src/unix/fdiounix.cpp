@@ -30,9 +30,14 @@
 // wxFDIOManagerUnix implementation
 // ============================================================================
 
+wxFDIODispatcher *wxFDIOManagerUnix::GetDispatcher() const
+{
+    return m_dispatcher ? m_dispatcher : wxFDIODispatcher::Get();
+}
+
 int wxFDIOManagerUnix::AddInput(wxFDIOHandler *handler, int fd, Direction d)
 {
-    wxFDIODispatcher * const dispatcher = wxFDIODispatcher::Get();
+    wxFDIODispatcher * const dispatcher = GetDispatcher();
     wxCHECK_MSG( dispatcher, -1, "can't monitor FDs without FD IO dispatcher" );
 
     // translate our direction to dispatcher flags
@@ -63,7 +68,7 @@ int wxFDIOManagerUnix::AddInput(wxFDIOHandler *handler, int fd, Direction d)
 
 void wxFDIOManagerUnix::RemoveInput(wxFDIOHandler *handler, int fd, Direction d)
 {
-    wxFDIODispatcher * const dispatcher = wxFDIODispatcher::Get();
+    wxFDIODispatcher * const dispatcher = GetDispatcher();
     if ( !dispatcher )
         return;
 
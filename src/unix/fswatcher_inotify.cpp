@@ -1,6 +1,6 @@
 /////////////////////////////////////////////////////////////////////////////
 // Name:        src/unix/fswatcher_inotify.cpp
-// Purpose:     inotify-based wxFileSystemWatcher implementation
+// Purpose:     inotify and fanotify-based wxFileSystemWatcher implementation
 // Author:      Bartosz Bekier
 // Created:     2009-05-26
 // Copyright:   (c) 2009 Bartosz Bekier <bartosz.bekier@gmail.com>
@@ -18,10 +18,37 @@
 #ifdef wxHAS_INOTIFY
 
 #include <sys/inotify.h>
+#include <errno.h>
+#include <fcntl.h>
 #include <unistd.h>
 #include "wx/private/fswatcher.h"
 
+#if wxUSE_TIMER
+    #include "wx/timer.h"
+#endif
+
+#ifdef wxHAS_FANOTIFY
+    #include <sys/fanotify.h>
+
+    // We need FAN_REPORT_DFID_NAME, only available since Linux 5.9, to know
+    // which files the events are about.
+    #ifdef FAN_REPORT_DFID_NAME
+        #include <limits.h>
+        #include <stdio.h>
+        #include <stdlib.h>
+        #include <string.h>
+        #include <sys/stat.h>
+        #include <sys/vfs.h>
+
+        #include <string>
+    #else
+        #undef wxHAS_FANOTIFY
+    #endif
+#endif // wxHAS_FANOTIFY
+
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 // ============================================================================
 // wxFSWatcherImpl implementation & helper wxFSWSourceHandler implementation
@@ -30,8 +57,19 @@
 // inotify watch descriptor => wxFSWatchEntry* map
 using wxFSWatchEntryDescriptors = std::unordered_map<int, wxFSWatchEntry*>;
 
-// inotify event cookie => inotify_event* map
-using wxInotifyCookies = std::unordered_map<int, inotify_event*>;
+// inotify event cookie => inotify_event* map, the events point into the
+// buffer used for reading them
+using wxInotifyCookies = std::unordered_map<int, const inotify_event*>;
+
+// Size of the buffer used for reading the events: this is big enough for a
+// couple of thousands of typical events, reading which in a single call is
+// much more efficient than reading them in smaller chunks. The same size is
+// used for fanotify events too.
+static const size_t wxINOTIFY_BUFFER_SIZE = 64*1024;
+
+// Maximal number of buffers read at once before returning to the event loop,
+// to avoid blocking it if the events keep arriving.
+static const int wxINOTIFY_MAX_READS = 16;
 
 /**
  * Helper class encapsulating inotify mechanism
@@ -45,6 +83,13 @@ public:
         m_ifd(-1)
     {
         m_handler = new wxFSWSourceHandler(this);
+
+#if wxUSE_TIMER
+        m_coalescingTimer.Bind(wxEVT_TIMER, [this](wxTimerEvent&)
+            {
+                SendPendingEvents();
+            });
+#endif // wxUSE_TIMER
     }
 
     ~wxFSWatcherImplUnix()
@@ -65,7 +110,15 @@ public:
         wxEventLoopBase *loop = wxEventLoopBase::GetActive();
         wxCHECK_MSG( loop, false, "File system watcher needs an event loop" );
 
+        // Use non-blocking descriptor to be able to read all the available
+        // events without blocking when there are no more of them.
+#ifdef IN_NONBLOCK
+        m_ifd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#else
         m_ifd = inotify_init();
+        if ( m_ifd != -1 )
+            fcntl(m_ifd, F_SETFL, fcntl(m_ifd, F_GETFL) | O_NONBLOCK);
+#endif
         if ( m_ifd == -1 )
         {
             wxLogSysError( _("Unable to create inotify instance") );
@@ -148,7 +201,7 @@ public:
                                           watch->GetPath()) );
         }
         // Cache the wd in case any events arrive late
-        m_staleDescriptors.Add(watch->GetWatchDescriptor());
+        m_staleDescriptors.insert(watch->GetWatchDescriptor());
 
         watch->SetWatchDescriptor(-1);
         return true;
@@ -170,36 +223,73 @@ public:
         wxCHECK_MSG( IsOk(), -1,
                     "Inotify not initialized or invalid inotify descriptor" );
 
-        // read events
-        // TODO differentiate depending on params
-        char buf[128 * sizeof(inotify_event)];
-        int left = ReadEventsToBuf(buf, sizeof(buf));
-        if (left == -1)
-            return -1;
+        // Take the buffer to allow this function to be reentered, as it may
+        // happen if an event handler runs a nested event loop: in this case
+        // the nested call just allocates a new buffer.
+        std::vector<char> buffer;
+        buffer.swap(m_buffer);
+        if ( buffer.empty() )
+            buffer.resize(wxINOTIFY_BUFFER_SIZE);
 
-        // left > 0, we have events
-        char* memory = buf;
+        // Read all the available events, as there are often many of them
+        // arriving at once, but don't do it indefinitely.
         int event_count = 0;
-        while (left > 0) // OPT checking 'memory' would suffice
+        for ( int n = 0; n < wxINOTIFY_MAX_READS; n++ )
         {
-            event_count++;
-            inotify_event* e = (inotify_event*)memory;
+            char* const buf = &buffer[0];
+            int left = ReadEventsToBuf(buf, buffer.size());
+            if (left == -1)
+            {
+                m_buffer.swap(buffer);
+                return -1;
+            }
 
-            // process one inotify_event
-            ProcessNativeEvent(*e);
+            if (left == 0)
+                break;
+
+            // left > 0, we have events
+            const char* memory = buf;
+            while (left > 0) // OPT checking 'memory' would suffice
+            {
+                event_count++;
+                const inotify_event* e = (const inotify_event*)memory;
+
+                // process one inotify_event
+                ProcessNativeEvent(*e);
+
+                int offset = sizeof(inotify_event) + e->len;
+                left -= offset;
+                memory += offset;
+            }
 
-            int offset = sizeof(inotify_event) + e->len;
-            left -= offset;
-            memory += offset;
+            // take care of unmatched renames before reusing the buffer, as
+            // m_cookies contains pointers into it
+            ProcessRenames();
         }
 
-        // take care of unmatched renames
-        ProcessRenames();
+        m_buffer.swap(buffer);
 
         wxLogTrace(wxTRACE_FSWATCHER, "We had %d native events", event_count);
         return event_count;
     }
 
+    virtual bool SetCoalescingInterval(int milliseconds) override
+    {
+#if wxUSE_TIMER
+        m_coalescingInterval = milliseconds;
+
+        if ( !m_coalescingInterval )
+        {
+            m_coalescingTimer.Stop();
+            SendPendingEvents();
+        }
+
+        return true;
+#else // !wxUSE_TIMER
+        return milliseconds == 0;
+#endif // wxUSE_TIMER/!wxUSE_TIMER
+    }
+
     bool IsOk() const
     {
         return m_source != nullptr;
@@ -222,7 +312,7 @@ protected:
 
     void ProcessNativeEvent(const inotify_event& inevt)
     {
-        wxLogTrace(wxTRACE_FSWATCHER, InotifyEventToString(inevt));
+        TraceEvent(inevt);
 
         // after removing inotify watch we get IN_IGNORED for it, but the watch
         // will be already removed from our list at that time
@@ -232,10 +322,8 @@ protected:
             // won't get any more events for it.
             // However if we're here because a dir that we're still watching
             // has just been deleted, its wd won't be on this list
-            const int pos = m_staleDescriptors.Index(inevt.wd);
-            if ( pos != wxNOT_FOUND )
+            if ( m_staleDescriptors.erase(inevt.wd) )
             {
-                m_staleDescriptors.RemoveAt(static_cast<size_t>(pos));
                 wxLogTrace(wxTRACE_FSWATCHER,
                        "Removed wd %i from the stale-wd cache", inevt.wd);
             }
@@ -251,7 +339,7 @@ protected:
             if (it == m_watchMap.end())
             {
                 // It's not in the map; check if was recently removed from it.
-                if (m_staleDescriptors.Index(inevt.wd) != wxNOT_FOUND)
+                if (m_staleDescriptors.count(inevt.wd))
                 {
                     wxLogTrace(wxTRACE_FSWATCHER,
                                "Got an event for stale wd %i", inevt.wd);
@@ -399,7 +487,7 @@ protected:
                 }
 
                 // Cache the wd in case any events arrive late
-                m_staleDescriptors.Add(inevt.wd);
+                m_staleDescriptors.insert(inevt.wd);
             }
 
             // Tell the owner, in case it's interested
@@ -428,16 +516,14 @@ protected:
             wxInotifyCookies::iterator it2 = m_cookies.find(inevt.cookie);
             if ( it2 == m_cookies.end() )
             {
-                int size = sizeof(inevt) + inevt.len;
-                inotify_event* e = (inotify_event*)new char[size];
-                memcpy(e, &inevt, size);
-
-                wxInotifyCookies::value_type val(e->cookie, e);
+                // No need to copy the event, it remains valid until all
+                // events in the buffer are processed.
+                wxInotifyCookies::value_type val(inevt.cookie, &inevt);
                 m_cookies.insert(val);
             }
             else
             {
-                inotify_event& oldinevt = *(it2->second);
+                const inotify_event& oldinevt = *(it2->second);
 
                 // Tell the owner, in case it's interested
                 // If there's a filespec, assume he's not
@@ -478,7 +564,6 @@ protected:
                 }
 
                 m_cookies.erase(it2);
-                delete[] (char*)&oldinevt;
             }
         }
         // every other kind of event
@@ -501,10 +586,10 @@ protected:
         wxInotifyCookies::iterator it = m_cookies.begin();
         while ( it != m_cookies.end() )
         {
-            inotify_event& inevt = *(it->second);
+            const inotify_event& inevt = *(it->second);
 
             wxLogTrace(wxTRACE_FSWATCHER, "Processing pending rename events");
-            wxLogTrace(wxTRACE_FSWATCHER, InotifyEventToString(inevt));
+            TraceEvent(inevt);
 
             // get watch entry for this event
             wxFSWatchEntryDescriptors::iterator wit = m_watchMap.find(inevt.wd);
@@ -530,26 +615,103 @@ protected:
             }
 
             m_cookies.erase(it);
-            delete[] (char*)&inevt;
             it = m_cookies.begin();
         }
     }
 
     void SendEvent(wxFileSystemWatcherEvent& evt)
     {
-        wxLogTrace(wxTRACE_FSWATCHER, evt.ToString());
+#if wxUSE_TIMER
+        if ( m_coalescingInterval )
+        {
+            QueueEvent(evt);
+            return;
+        }
+#endif // wxUSE_TIMER
+
+        DoSendEvent(evt);
+    }
+
+    void DoSendEvent(wxFileSystemWatcherEvent& evt)
+    {
+#if wxUSE_LOG_TRACE
+        // Don't format the event description unless it's really needed.
+        if ( wxLog::IsAllowedTraceMask(wxTRACE_FSWATCHER) )
+            wxLogTrace(wxTRACE_FSWATCHER, evt.ToString());
+#endif // wxUSE_LOG_TRACE
+
         m_watcher->GetOwner()->ProcessEvent(evt);
     }
 
+#if wxUSE_TIMER
+    // Add the event to the pending events unless the last pending event for
+    // the same path is the same as it, in which case it's just dropped.
+    void QueueEvent(const wxFileSystemWatcherEvent& evt)
+    {
+        const size_t index = m_pendingEvents.size();
+
+        if ( !evt.IsError() )
+        {
+            // Only renames have a different new path.
+            const bool isRename = evt.GetChangeType() == wxFSW_EVENT_RENAME;
+            const wxString path = evt.GetPath().GetFullPath();
+
+            const auto it = m_pendingPaths.find(path);
+            if ( it == m_pendingPaths.end() )
+            {
+                m_pendingPaths.emplace(path, index);
+            }
+            else
+            {
+                const wxFileSystemWatcherEvent& last = m_pendingEvents[it->second];
+                if ( last.GetChangeType() == evt.GetChangeType() &&
+                        (!isRename ||
+                         last.GetNewPath().GetFullPath() ==
+                            evt.GetNewPath().GetFullPath()) )
+                {
+                    return;
+                }
+
+                it->second = index;
+            }
+
+            // For renames, this is also the last event for the new path.
+            if ( isRename )
+                m_pendingPaths[evt.GetNewPath().GetFullPath()] = index;
+        }
+
+        m_pendingEvents.push_back(evt);
+
+        if ( !m_coalescingTimer.IsRunning() )
+            m_coalescingTimer.StartOnce(m_coalescingInterval);
+    }
+
+    void SendPendingEvents()
+    {
+        // Take the events out of m_pendingEvents first, as the event handlers
+        // could result in more events being added to it.
+        std::vector<wxFileSystemWatcherEvent> events;
+        events.swap(m_pendingEvents);
+        m_pendingPaths.clear();
+
+        for ( auto& evt : events )
+            DoSendEvent(evt);
+    }
+#endif // wxUSE_TIMER
+
+    // Returns the number of bytes read or 0 if there are no more events or
+    // -1 on error.
     int ReadEventsToBuf(char* buf, int size)
     {
         wxCHECK_MSG( IsOk(), false,
                     "Inotify not initialized or invalid inotify descriptor" );
 
-        memset(buf, 0, size);
         ssize_t left = read(m_ifd, buf, size);
         if (left == -1)
         {
+            if ( errno == EAGAIN || errno == EINTR )
+                return 0;
+
             wxLogSysError(_("Unable to read from inotify descriptor"));
             return -1;
         }
@@ -562,29 +724,32 @@ protected:
         return left;
     }
 
-    static wxString InotifyEventToString(const inotify_event& inevt)
+    static void TraceEvent(const inotify_event& inevt)
     {
-        wxString mask = (inevt.mask & IN_ISDIR) ?
-                        wxString::Format("IS_DIR | %u", inevt.mask & ~IN_ISDIR) :
-                        wxString::Format("%u", inevt.mask);
-        const char* name = "";
-        if (inevt.len)
-            name = inevt.name;
-        return wxString::Format("Event: wd=%d, mask=%s, cookie=%u, len=%u, "
-                                "name=%s", inevt.wd, mask, inevt.cookie,
-                                inevt.len, name);
+        // Pass the fields directly to wxLogTrace() instead of formatting them
+        // in a string first, this is only done if tracing is enabled.
+        wxLogTrace(wxTRACE_FSWATCHER,
+                   "Event: wd=%d, mask=%s%u, cookie=%u, len=%u, name=%s",
+                   inevt.wd,
+                   (inevt.mask & IN_ISDIR) ? "IS_DIR | " : "",
+                   inevt.mask & ~IN_ISDIR, inevt.cookie, inevt.len,
+                   inevt.len ? inevt.name : "");
     }
 
     static wxFileName GetEventPath(const wxFSWatchEntry& watch,
                                    const inotify_event& inevt)
     {
         // only when dir is watched, we have non-empty e.name
-        wxFileName path = watch.GetPath();
-        if (path.IsDir() && inevt.len)
+        //
+        // Note that the path of a watched dir always ends with a separator,
+        // so we can check for it without parsing the path first.
+        const wxString& watchPath = watch.GetPath();
+        if (inevt.len && !watchPath.empty() &&
+                watchPath.Last() == wxFILE_SEP_PATH)
         {
-            path = wxFileName(path.GetPath(), inevt.name);
+            return wxFileName(watchPath, inevt.name);
         }
-        return path;
+        return wxFileName(watchPath);
     }
 
     static int Watcher2NativeFlags(int flags)
@@ -653,15 +818,932 @@ protected:
 
     wxFSWSourceHandler* m_handler;        // handler for inotify event source
     wxFSWatchEntryDescriptors m_watchMap; // inotify wd=>wxFSWatchEntry* map
-    wxArrayInt m_staleDescriptors;        // stores recently-removed watches
+    std::unordered_set<int> m_staleDescriptors; // recently-removed watches
     wxInotifyCookies m_cookies;           // map to track renames
+    std::vector<char> m_buffer;           // buffer for reading the events
     wxEventLoopSource* m_source;          // our event loop source
 
+#if wxUSE_TIMER
+    // Events waiting to be sent when coalescing them, the index of the last
+    // of them for each path and the timer used to send them.
+    std::vector<wxFileSystemWatcherEvent> m_pendingEvents;
+    std::unordered_map<wxString, size_t> m_pendingPaths;
+    wxTimer m_coalescingTimer;
+    int m_coalescingInterval = 0;
+#endif // wxUSE_TIMER
+
     // file descriptor created by inotify_init()
     int m_ifd;
 };
 
 
+#ifdef wxHAS_FANOTIFY
+
+// ============================================================================
+// wxFSWatcherImplFanotify: fanotify-based implementation for the trees
+// ============================================================================
+
+class wxFSWatcherImplFanotify;
+
+/**
+ * Handler for handling i/o from fanotify descriptor
+ */
+class wxFanotifySourceHandler : public wxEventLoopSourceHandler
+{
+public:
+    explicit wxFanotifySourceHandler(wxFSWatcherImplFanotify* service) :
+        m_service(service)
+    {  }
+
+    virtual void OnReadWaiting() override;
+    virtual void OnWriteWaiting() override;
+    virtual void OnExceptionWaiting() override;
+
+private:
+    wxFSWatcherImplFanotify* const m_service;
+};
+
+// Maximal number of cached directory paths: the cache is simply cleared when
+// it becomes full.
+static const size_t wxFANOTIFY_MAX_CACHED_DIRS = 16*1024;
+
+/**
+ * Implementation using fanotify for watching the entire trees
+ *
+ * A single FAN_MARK_FILESYSTEM mark is used for all the trees on the same
+ * file system, so adding a tree takes the same time independently of its
+ * size, and the events for the paths outside of the watched trees are
+ * filtered out. As this mark covers the entire file system, it is only used
+ * for the relatively rare directory entry and attribute changes, while the
+ * much more frequent access and modification events use a FAN_MARK_MOUNT
+ * mark for the mount containing the tree (the mount marks can't be used for
+ * the former events). The events identify the parent directory by its handle
+ * only, so the paths of the directories are retrieved using
+ * open_by_handle_at() and cached.
+ *
+ * Both marking the file system and open_by_handle_at() require elevated
+ * privileges, so this is typically only used when running as root. inotify
+ * is used for the trees which can't be watched using fanotify, as well as
+ * for all individual files and directories.
+ */
+class wxFSWatcherImplFanotify : public wxFSWatcherImplUnix
+{
+public:
+    explicit wxFSWatcherImplFanotify(wxFileSystemWatcherBase* watcher) :
+        wxFSWatcherImplUnix(watcher),
+        m_fanHandler(this)
+    {
+    }
+
+    ~wxFSWatcherImplFanotify()
+    {
+        for ( const auto& fs : m_fileSystems )
+            close(fs.fd);
+
+        for ( const auto& mount : m_mounts )
+            close(mount.fd);
+
+        if ( m_fd != -1 )
+        {
+            delete m_fanSource;
+            close(m_fd);
+        }
+    }
+
+    // Start watching the tree using fanotify, return false if it can't be
+    // done and inotify must be used instead.
+    bool AddTree(const wxFSWatchInfo& winfo)
+    {
+        if ( !InitFanotify() )
+            return false;
+
+        char real[PATH_MAX];
+        if ( !realpath(winfo.GetPath().fn_str(), real) )
+            return false;
+
+        const int fd = open(real, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if ( fd == -1 )
+            return false;
+
+        Tree tree;
+        tree.realPath = real;
+        if ( tree.realPath.back() != '/' )
+            tree.realPath += '/';
+
+        struct stat st;
+        if ( fstat(fd, &st) != 0 || !GetMountId(fd, tree.mountId) )
+        {
+            close(fd);
+            return false;
+        }
+
+        tree.dev = st.st_dev;
+
+        // Insert the watch first, so that m_trees never refers to an entry
+        // which is not in m_watches.
+        wxSharedPtr<wxFSWatchEntry> watch(new wxFSWatchEntry(winfo));
+        watch->SetWatchDescriptor(-1);
+
+        wxFSWatchEntries::value_type val(watch->GetPath(), watch);
+        if ( !m_watches.insert(val).second )
+        {
+            close(fd);
+            return false;
+        }
+
+        tree.watch = watch.get();
+        m_trees.push_back(tree);
+
+        const bool ok = AddMarks(fd, tree);
+        close(fd);
+
+        if ( !ok )
+        {
+            m_trees.pop_back();
+            m_watches.erase(watch->GetPath());
+            RemoveMarks(tree);
+            return false;
+        }
+
+        wxLogTrace(wxTRACE_FSWATCHER,
+                   "Watching tree '%s' using fanotify", watch->GetPath());
+
+        return true;
+    }
+
+    // Check if the given path was added using AddTree().
+    bool IsWatchingTree(const wxString& path) const
+    {
+        for ( const auto& tree : m_trees )
+        {
+            if ( tree.watch->GetPath() == path )
+                return true;
+        }
+
+        return false;
+    }
+
+    virtual bool DoRemove(wxSharedPtr<wxFSWatchEntryUnix> watch) override
+    {
+        for ( auto it = m_trees.begin(); it != m_trees.end(); ++it )
+        {
+            if ( it->watch == watch.get() )
+            {
+                const Tree tree = *it;
+                m_trees.erase(it);
+                RemoveMarks(tree);
+                return true;
+            }
+        }
+
+        return wxFSWatcherImplUnix::DoRemove(watch);
+    }
+
+    void ReadFanotifyEvents()
+    {
+        // As in ReadEvents(), allow for reentrancy.
+        std::vector<char> buffer;
+        buffer.swap(m_fanBuffer);
+        if ( buffer.empty() )
+            buffer.resize(wxINOTIFY_BUFFER_SIZE);
+
+        for ( int n = 0; n < wxINOTIFY_MAX_READS; n++ )
+        {
+            ssize_t len = read(m_fd, &buffer[0], buffer.size());
+            if ( len == -1 )
+            {
+                if ( errno != EAGAIN && errno != EINTR )
+                    wxLogSysError(_("Unable to read from fanotify descriptor"));
+                break;
+            }
+
+            const fanotify_event_metadata*
+                meta = reinterpret_cast<fanotify_event_metadata*>(&buffer[0]);
+            for ( ; FAN_EVENT_OK(meta, len); meta = FAN_EVENT_NEXT(meta, len) )
+            {
+                ProcessFanotifyEvent(*meta);
+            }
+        }
+
+        m_fanBuffer.swap(buffer);
+    }
+
+private:
+    // All trees on the same file system share the mark for it.
+    struct FileSystem
+    {
+        dev_t dev;              // device of this file system
+        __kernel_fsid_t fsid;   // its ID used in the events
+        int fd;                 // descriptor of a directory on it
+        wxUint64 mask;          // events we're currently watching for
+    };
+
+    // Trees on the same mount share the mark for it too, if they need it.
+    struct Mount
+    {
+        int id;                 // mount ID
+        int fd;                 // descriptor of a directory on it
+        wxUint64 mask;          // events we're currently watching for
+    };
+
+    struct Tree
+    {
+        wxFSWatchEntry* watch;  // our entry in m_watches
+        std::string realPath;   // path as reported by the kernel, with '/'
+        dev_t dev;              // device of its file system
+        int mountId;            // ID of the mount containing it
+    };
+
+    // The events which are too frequent to watch for them on the entire file
+    // system and which are only used with the mount marks.
+    static const wxUint64 MOUNT_EVENTS = FAN_ACCESS | FAN_MODIFY;
+
+    bool InitFanotify()
+    {
+        if ( m_fd != -1 )
+            return true;
+
+        if ( m_unavailable )
+            return false;
+
+        m_fd = fanotify_init(FAN_CLASS_NOTIF | FAN_REPORT_DFID_NAME |
+                             FAN_NONBLOCK | FAN_CLOEXEC, O_RDONLY);
+        if ( m_fd == -1 )
+        {
+            // This is expected if we don't have the required privileges or
+            // if the kernel is too old, so don't complain about it.
+            wxLogTrace(wxTRACE_FSWATCHER,
+                       "fanotify can't be used: %s", wxSysErrorMsgStr());
+            m_unavailable = true;
+            return false;
+        }
+
+        m_fanSource = wxEventLoopBase::AddSourceForFD
+                         (
+                          m_fd,
+                          &m_fanHandler,
+                          wxEVENT_SOURCE_INPUT | wxEVENT_SOURCE_EXCEPTION
+                         );
+        if ( !m_fanSource )
+        {
+            close(m_fd);
+            m_fd = -1;
+            m_unavailable = true;
+            return false;
+        }
+
+        return true;
+    }
+
+    // Check that the file system can be used with fanotify.
+    bool InitFileSystem(FileSystem& fs)
+    {
+        struct statfs sfs;
+        if ( fstatfs(fs.fd, &sfs) != 0 )
+            return false;
+
+        wxCOMPILE_TIME_ASSERT( sizeof(fs.fsid) == sizeof(sfs.f_fsid),
+                               FsidSizeMismatch );
+        memcpy(&fs.fsid, &sfs.f_fsid, sizeof(fs.fsid));
+
+        // Check that the file system supports the file handles and that we
+        // can open them.
+        alignas(file_handle) char buf[sizeof(file_handle) + MAX_HANDLE_SZ];
+        file_handle* const handle = reinterpret_cast<file_handle*>(buf);
+        handle->handle_bytes = MAX_HANDLE_SZ;
+
+        int mountId;
+        if ( name_to_handle_at(fs.fd, "", handle, &mountId, AT_EMPTY_PATH) != 0 )
+            return false;
+
+        const int fd = open_by_handle_at(fs.fd, handle, O_PATH | O_CLOEXEC);
+        if ( fd == -1 )
+        {
+            // Don't bother trying again if we don't have the permissions.
+            if ( errno == EPERM )
+                m_unavailable = true;
+            return false;
+        }
+
+        close(fd);
+        return true;
+    }
+
+    FileSystem* FindFileSystem(dev_t dev)
+    {
+        for ( auto& fs : m_fileSystems )
+        {
+            if ( fs.dev == dev )
+                return &fs;
+        }
+
+        return nullptr;
+    }
+
+    const FileSystem* FindFileSystem(const __kernel_fsid_t& fsid) const
+    {
+        for ( const auto& fs : m_fileSystems )
+        {
+            if ( memcmp(&fs.fsid, &fsid, sizeof(fsid)) == 0 )
+                return &fs;
+        }
+
+        return nullptr;
+    }
+
+    Mount* FindMount(int id)
+    {
+        for ( auto& mount : m_mounts )
+        {
+            if ( mount.id == id )
+                return &mount;
+        }
+
+        return nullptr;
+    }
+
+    // Get the ID of the mount containing the given directory.
+    static bool GetMountId(int fd, int& mountId)
+    {
+        alignas(file_handle) char buf[sizeof(file_handle) + MAX_HANDLE_SZ];
+        file_handle* const handle = reinterpret_cast<file_handle*>(buf);
+        handle->handle_bytes = MAX_HANDLE_SZ;
+
+        return name_to_handle_at(fd, "", handle, &mountId, AT_EMPTY_PATH) == 0;
+    }
+
+    // Add the marks needed for the tree which was just added to m_trees, fd
+    // is the descriptor of its root directory.
+    bool AddMarks(int fd, const Tree& tree)
+    {
+        FileSystem* fs = FindFileSystem(tree.dev);
+        if ( !fs )
+        {
+            FileSystem fsNew;
+            fsNew.dev = tree.dev;
+            fsNew.fd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+            fsNew.mask = 0;
+            if ( fsNew.fd == -1 )
+                return false;
+
+            m_fileSystems.push_back(fsNew);
+            fs = &m_fileSystems.back();
+
+            // If this fails, RemoveMarks() called by our caller closes it.
+            if ( !InitFileSystem(*fs) )
+                return false;
+        }
+
+        if ( !UpdateMark(*fs) )
+            return false;
+
+        if ( !(Watcher2FanotifyFlags(tree.watch->GetFlags()) & MOUNT_EVENTS) )
+            return true;
+
+        Mount* mount = FindMount(tree.mountId);
+        if ( !mount )
+        {
+            Mount mountNew;
+            mountNew.id = tree.mountId;
+            mountNew.fd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+            mountNew.mask = 0;
+            if ( mountNew.fd == -1 )
+                return false;
+
+            m_mounts.push_back(mountNew);
+            mount = &m_mounts.back();
+        }
+
+        return UpdateMark(*mount);
+    }
+
+    // Update the marks used by the tree after removing it from m_trees (or
+    // failing to add it) and forget about its file system and mount if
+    // they're not used any longer.
+    void RemoveMarks(const Tree& tree)
+    {
+        for ( auto it = m_fileSystems.begin(); it != m_fileSystems.end(); ++it )
+        {
+            if ( it->dev != tree.dev )
+                continue;
+
+            UpdateMark(*it);
+            if ( !it->mask )
+            {
+                close(it->fd);
+                m_fileSystems.erase(it);
+
+                // The cache could contain the handles from this file system.
+                m_dirs.clear();
+            }
+            break;
+        }
+
+        for ( auto it = m_mounts.begin(); it != m_mounts.end(); ++it )
+        {
+            if ( it->id != tree.mountId )
+                continue;
+
+            UpdateMark(*it);
+            if ( !it->mask )
+            {
+                close(it->fd);
+                m_mounts.erase(it);
+            }
+            break;
+        }
+    }
+
+    bool UpdateMark(FileSystem& fs)
+    {
+        // We always need to know about the directories being deleted or
+        // renamed to keep the cached paths valid and to notice when the tree
+        // itself is deleted, even if no other events are watched for.
+        wxUint64 mask = 0;
+        for ( const auto& tree : m_trees )
+        {
+            if ( tree.dev == fs.dev )
+            {
+                mask |= FAN_ONDIR | FAN_DELETE | m_renameMask |
+                            (Watcher2FanotifyFlags(tree.watch->GetFlags()) &
+                                ~MOUNT_EVENTS);
+            }
+        }
+
+        if ( !DoUpdateMark(FAN_MARK_FILESYSTEM, fs.fd, fs.mask, mask) )
+        {
+#ifdef FAN_RENAME
+            // FAN_RENAME is only available since Linux 5.17, fall back to
+            // unpaired FAN_MOVED_FROM and FAN_MOVED_TO without it.
+            if ( errno == EINVAL && m_renameMask == FAN_RENAME )
+            {
+                m_renameMask = FAN_MOVE;
+                return UpdateMark(fs);
+            }
+#endif // FAN_RENAME
+
+            wxLogTrace(wxTRACE_FSWATCHER,
+                       "Adding fanotify file system mark failed: %s",
+                       wxSysErrorMsgStr());
+            return false;
+        }
+
+        return true;
+    }
+
+    bool UpdateMark(Mount& mount)
+    {
+        wxUint64 mask = 0;
+        for ( const auto& tree : m_trees )
+        {
+            if ( tree.mountId == mount.id )
+                mask |= Watcher2FanotifyFlags(tree.watch->GetFlags()) &
+                            MOUNT_EVENTS;
+        }
+
+        if ( mask )
+            mask |= FAN_ONDIR;
+
+        if ( !DoUpdateMark(FAN_MARK_MOUNT, mount.fd, mount.mask, mask) )
+        {
+            wxLogTrace(wxTRACE_FSWATCHER,
+                       "Adding fanotify mount mark failed: %s",
+                       wxSysErrorMsgStr());
+            return false;
+        }
+
+        return true;
+    }
+
+    // Change the events of the mark of the given type from mask to maskNew,
+    // mask is only updated if this succeeds.
+    bool DoUpdateMark(unsigned type, int fd, wxUint64& mask, wxUint64 maskNew)
+    {
+        if ( maskNew & ~mask )
+        {
+            if ( fanotify_mark(m_fd, FAN_MARK_ADD | type,
+                               maskNew, fd, nullptr) != 0 )
+            {
+                // Marking the entire file system or the mount requires
+                // CAP_SYS_ADMIN.
+                if ( errno == EPERM )
+                    m_unavailable = true;
+
+                return false;
+            }
+        }
+
+        const wxUint64 removed = mask & ~maskNew;
+        if ( removed )
+            fanotify_mark(m_fd, FAN_MARK_REMOVE | type, removed, fd, nullptr);
+
+        mask = maskNew;
+        return true;
+    }
+
+    // Get the path of the directory with the given handle.
+    const std::string* GetDirPath(const __kernel_fsid_t& fsid,
+                                  const file_handle& handle)
+    {
+        m_key.assign(reinterpret_cast<const char*>(&fsid), sizeof(fsid));
+        m_key.append(reinterpret_cast<const char*>(&handle.handle_type),
+                     sizeof(handle.handle_type));
+        m_key.append(reinterpret_cast<const char*>(handle.f_handle),
+                     handle.handle_bytes);
+
+        const auto it = m_dirs.find(m_key);
+        if ( it != m_dirs.end() )
+            return &it->second;
+
+        const FileSystem* const fs = FindFileSystem(fsid);
+        if ( !fs )
+            return nullptr;
+
+        // This fails if the directory doesn't exist any more.
+        const int fd = open_by_handle_at(fs->fd,
+                                         const_cast<file_handle*>(&handle),
+                                         O_PATH | O_CLOEXEC);
+        if ( fd == -1 )
+            return nullptr;
+
+        char link[32];
+        snprintf(link, sizeof(link), "/proc/self/fd/%d", fd);
+
+        char buf[PATH_MAX];
+        const ssize_t len = readlink(link, buf, sizeof(buf));
+        close(fd);
+
+        if ( len <= 0 || len == sizeof(buf) || buf[0] != '/' )
+            return nullptr;
+
+        std::string path(buf, len);
+        if ( path.back() != '/' )
+            path += '/';
+
+        if ( m_dirs.size() >= wxFANOTIFY_MAX_CACHED_DIRS )
+            m_dirs.clear();
+
+        return &m_dirs.emplace(m_key, std::move(path)).first->second;
+    }
+
+    // Get the full path of the object identified by the given record.
+    bool GetInfoPath(const fanotify_event_info_fid& info, std::string& path)
+    {
+        const file_handle&
+            handle = *reinterpret_cast<const file_handle*>(info.handle);
+
+        const std::string* const dir = GetDirPath(info.fsid, handle);
+        if ( !dir )
+            return false;
+
+        const char* const name =
+            reinterpret_cast<const char*>(handle.f_handle + handle.handle_bytes);
+
+        path = *dir;
+        if ( strcmp(name, ".") == 0 )
+        {
+            // Event for the directory itself.
+            if ( path.length() > 1 )
+                path.pop_back();
+        }
+        else
+        {
+            path += name;
+        }
+
+        return true;
+    }
+
+    // Find the innermost tree containing the given path and watching for the
+    // given events.
+    const Tree* FindTreeContaining(const std::string& path, int flags) const
+    {
+        const Tree* found = nullptr;
+        for ( const auto& tree : m_trees )
+        {
+            if ( !(tree.watch->GetFlags() & flags) )
+                continue;
+
+            const std::string& root = tree.realPath;
+            if ( path.compare(0, root.length(), root) != 0 &&
+                    !IsRootPath(tree, path) )
+                continue;
+
+            if ( !found || root.length() > found->realPath.length() )
+                found = &tree;
+        }
+
+        return found;
+    }
+
+    // Check if the path is the path of the tree root itself.
+    static bool IsRootPath(const Tree& tree, const std::string& path)
+    {
+        const std::string& root = tree.realPath;
+        return path.length() + 1 == root.length() &&
+                root.compare(0, path.length(), path) == 0;
+    }
+
+    // Get the path to report in the events for a path inside the tree.
+    static wxString GetTreePath(const Tree& tree, const std::string& path)
+    {
+        const wxString& root = tree.watch->GetPath();
+        if ( path.length() < tree.realPath.length() )
+            return root;
+
+        wxString full(root);
+        if ( !wxFileName::IsPathSeparator(full.Last()) )
+            full += wxFILE_SEP_PATH;
+
+        return full +
+                wxString(path.c_str() + tree.realPath.length(), *wxConvFileName);
+    }
+
+    void ProcessFanotifyEvent(const fanotify_event_metadata& meta)
+    {
+        wxLogTrace(wxTRACE_FSWATCHER, "Event: mask=%llx, len=%u",
+                   static_cast<unsigned long long>(meta.mask), meta.event_len);
+
+        if ( meta.vers != FANOTIFY_METADATA_VERSION )
+            return;
+
+        if ( meta.mask & FAN_Q_OVERFLOW )
+        {
+            // The queue is shared by all the marks, so we can't know which
+            // events were lost, but they can only be relevant if we still
+            // watch some trees: if all of them were removed since then, the
+            // overflow is due to the events which we would ignore anyhow.
+            if ( m_trees.empty() )
+            {
+                wxLogTrace(wxTRACE_FSWATCHER,
+                           "Ignoring fanotify overflow without any trees");
+                return;
+            }
+
+            wxFileSystemWatcherEvent
+                event(wxFSW_EVENT_WARNING, wxFSW_WARNING_OVERFLOW);
+            SendEvent(event);
+            return;
+        }
+
+        // The path of the object, or its old and new path for FAN_RENAME.
+        std::string paths[2];
+
+        const char* p = reinterpret_cast<const char*>(&meta) + meta.metadata_len;
+        const char* const end = reinterpret_cast<const char*>(&meta) + meta.event_len;
+        while ( p + sizeof(fanotify_event_info_header) <= end )
+        {
+            const fanotify_event_info_header&
+                header = *reinterpret_cast<const fanotify_event_info_header*>(p);
+            if ( !header.len )
+                break;
+
+            int n;
+            switch ( header.info_type )
+            {
+                case FAN_EVENT_INFO_TYPE_DFID_NAME:
+#ifdef FAN_RENAME
+                case FAN_EVENT_INFO_TYPE_OLD_DFID_NAME:
+#endif // FAN_RENAME
+                    n = 0;
+                    break;
+
+#ifdef FAN_RENAME
+                case FAN_EVENT_INFO_TYPE_NEW_DFID_NAME:
+                    n = 1;
+                    break;
+#endif // FAN_RENAME
+
+                default:
+                    n = -1;
+            }
+
+            if ( n != -1 )
+            {
+                GetInfoPath(*reinterpret_cast<const fanotify_event_info_fid*>(p),
+                            paths[n]);
+            }
+
+            p += header.len;
+        }
+
+        // Several events for the same object may be merged into one, so
+        // report them in the most likely order.
+        static const struct
+        {
+            wxUint64 mask;
+            int flags;
+        } fanotifyEvents[] =
+        {
+            { FAN_CREATE,       wxFSW_EVENT_CREATE },
+            { FAN_MOVED_TO,     wxFSW_EVENT_RENAME },
+            { FAN_MODIFY,       wxFSW_EVENT_MODIFY },
+            { FAN_ATTRIB,       wxFSW_EVENT_ATTRIB },
+            { FAN_ACCESS,       wxFSW_EVENT_ACCESS },
+            { FAN_MOVED_FROM,   wxFSW_EVENT_RENAME },
+#ifdef FAN_RENAME
+            { FAN_RENAME,       wxFSW_EVENT_RENAME },
+#endif // FAN_RENAME
+            { FAN_DELETE,       wxFSW_EVENT_DELETE },
+        };
+
+        const bool isDir = (meta.mask & FAN_ONDIR) != 0;
+        for ( const auto& e : fanotifyEvents )
+        {
+            if ( meta.mask & e.mask )
+                DispatchEvent(e.flags, isDir, paths[0], paths[1]);
+        }
+
+        // Check if any trees were renamed or deleted.
+        if ( isDir && (meta.mask & (FAN_DELETE | m_renameMask)) )
+        {
+            // Notice that the cached paths of the deleted directories are
+            // still needed for the events about their contents which may be
+            // still pending, but the renamed ones must be updated.
+            if ( meta.mask & m_renameMask )
+                OnDirRenamed(paths[0], paths[1]);
+
+            std::vector<wxString> deleted;
+            for ( const auto& tree : m_trees )
+            {
+                if ( IsRootPath(tree, paths[0]) )
+                    deleted.push_back(tree.watch->GetPath());
+            }
+
+            for ( const auto& path : deleted )
+                OnTreeDeleted(path);
+        }
+    }
+
+    // Update the cached paths of the subdirectories of the renamed directory.
+    void OnDirRenamed(const std::string& path, const std::string& newPath)
+    {
+        if ( path.empty() || newPath.empty() )
+        {
+            // We don't know where it was moved, so forget all the paths.
+            m_dirs.clear();
+            return;
+        }
+
+        const std::string prefix = path + '/';
+        for ( auto& dir : m_dirs )
+        {
+            std::string& dirPath = dir.second;
+            if ( dirPath.compare(0, prefix.length(), prefix) == 0 )
+                dirPath.replace(0, path.length(), newPath);
+        }
+    }
+
+    void DispatchEvent(int flags,
+                       bool isDir,
+                       const std::string& path,
+                       const std::string& newPath)
+    {
+        if ( flags == wxFSW_EVENT_RENAME )
+        {
+            // Only FAN_RENAME provides both paths, moves outside of the
+            // watched trees and FAN_MOVED_FROM and FAN_MOVED_TO are reported
+            // using the same path as unpaired moves with inotify.
+            const Tree* const tree = path.empty()
+                                        ? nullptr
+                                        : FindTreeContaining(path, flags);
+            const Tree* const newTree = newPath.empty()
+                                        ? nullptr
+                                        : FindTreeContaining(newPath, flags);
+            if ( !tree && !newTree )
+                return;
+
+            // If there's a filespec, assume the owner is not interested.
+            if ( !(tree ? tree : newTree)->watch->GetFilespec().empty() )
+                return;
+
+            wxFileName fn, fnNew;
+            if ( tree )
+                fn.Assign(GetTreePath(*tree, path));
+            if ( newTree )
+                fnNew.Assign(GetTreePath(*newTree, newPath));
+
+            wxFileSystemWatcherEvent event(flags,
+                                           tree ? fn : fnNew,
+                                           newTree ? fnNew : fn);
+            SendEvent(event);
+            return;
+        }
+
+        if ( path.empty() )
+            return;
+
+        const Tree* const tree = FindTreeContaining(path, flags);
+        if ( !tree )
+            return;
+
+        // As with inotify, only report the events for the files matching the
+        // filespec, if any.
+        const wxString& filespec = tree->watch->GetFilespec();
+        if ( isDir && !filespec.empty() )
+            return;
+
+        wxFileName fn(GetTreePath(*tree, path));
+        if ( isDir && flags == wxFSW_EVENT_CREATE )
+            fn.AssignDir(fn.GetFullPath());
+
+        if ( MatchesFilespec(fn, filespec) )
+        {
+            wxFileSystemWatcherEvent event(flags, fn, fn);
+            SendEvent(event);
+        }
+    }
+
+    void OnTreeDeleted(const wxString& path)
+    {
+        wxFSWatchEntries::iterator it = m_watches.find(path);
+        if ( it == m_watches.end() )
+            return;
+
+        DoRemove(it->second);
+        m_watches.erase(it);
+
+        wxDynamicCast(m_watcher, wxInotifyFileSystemWatcher)->OnDirDeleted(path);
+    }
+
+    wxUint64 Watcher2FanotifyFlags(int flags) const
+    {
+        static const struct
+        {
+            int flags;
+            wxUint64 mask;
+        } flag_mapping[] =
+        {
+            { wxFSW_EVENT_ACCESS, FAN_ACCESS },
+            { wxFSW_EVENT_MODIFY, FAN_MODIFY },
+            { wxFSW_EVENT_ATTRIB, FAN_ATTRIB },
+            { wxFSW_EVENT_CREATE, FAN_CREATE },
+            { wxFSW_EVENT_DELETE, FAN_DELETE },
+            // wxFSW_EVENT_RENAME is handled below, there is no fanotify
+            // equivalent for wxFSW_EVENT_UNMOUNT.
+        };
+
+        wxUint64 mask = 0;
+        for ( const auto& m : flag_mapping )
+        {
+            if ( flags & m.flags )
+                mask |= m.mask;
+        }
+
+        if ( flags & wxFSW_EVENT_RENAME )
+            mask |= m_renameMask;
+
+        return mask;
+    }
+
+    wxFanotifySourceHandler m_fanHandler;   // handler for fanotify source
+    wxEventLoopSource* m_fanSource = nullptr;
+    int m_fd = -1;                      // fanotify descriptor
+
+    // Set if fanotify can't be used at all.
+    bool m_unavailable = false;
+
+    // Mask used for the rename events, depending on the kernel version.
+#ifdef FAN_RENAME
+    wxUint64 m_renameMask = FAN_RENAME;
+#else
+    wxUint64 m_renameMask = FAN_MOVE;
+#endif
+
+    std::vector<FileSystem> m_fileSystems;
+    std::vector<Mount> m_mounts;
+    std::vector<Tree> m_trees;
+
+    // Cache of the directory paths indexed by their file system IDs and
+    // handles and the key used for looking them up.
+    std::unordered_map<std::string, std::string> m_dirs;
+    std::string m_key;
+
+    std::vector<char> m_fanBuffer;        // buffer for reading the events
+};
+
+// ============================================================================
+// wxFanotifySourceHandler implementation
+// ============================================================================
+
+void wxFanotifySourceHandler::OnReadWaiting()
+{
+    wxLogTrace(wxTRACE_FSWATCHER, "--- OnReadWaiting (fanotify) ---");
+    m_service->ReadFanotifyEvents();
+}
+
+void wxFanotifySourceHandler::OnWriteWaiting()
+{
+    wxFAIL_MSG("We never write to fanotify descriptor.");
+}
+
+void wxFanotifySourceHandler::OnExceptionWaiting()
+{
+    wxFAIL_MSG("We never receive exceptions on fanotify descriptor.");
+}
+
+#endif // wxHAS_FANOTIFY
+
 // ============================================================================
 // wxFSWSourceHandler implementation
 // ============================================================================
@@ -713,10 +1795,78 @@ wxInotifyFileSystemWatcher::~wxInotifyFileSystemWatcher()
 
 bool wxInotifyFileSystemWatcher::Init()
 {
+#ifdef wxHAS_FANOTIFY
+    m_service = new wxFSWatcherImplFanotify(this);
+#else
     m_service = new wxFSWatcherImplUnix(this);
+#endif
     return m_service->Init();
 }
 
+bool wxInotifyFileSystemWatcher::AddTree(const wxFileName& path,
+                                         int events,
+                                         const wxString& filespec)
+{
+#ifdef wxHAS_FANOTIFY
+    if ( path.DirExists() )
+    {
+        const wxString canonical = GetCanonicalPath(path);
+        wxFSWatcherImplFanotify* const
+            impl = static_cast<wxFSWatcherImplFanotify*>(m_service);
+
+        wxFSWatchInfoMap::iterator it = m_watches.find(canonical);
+        if ( it == m_watches.end() )
+        {
+            // Notice that there is no need to worry about symlinks here, as
+            // fanotify never follows them.
+            wxFSWatchInfo watch(canonical, events, wxFSWPath_Tree, filespec);
+            if ( impl->AddTree(watch) )
+            {
+                wxFSWatchInfoMap::value_type val(canonical, watch);
+                m_watches.insert(val);
+                return true;
+            }
+        }
+        else if ( impl->IsWatchingTree(canonical) )
+        {
+            // Just increment the reference count.
+            return AddCanonical(canonical, events, wxFSWPath_Tree, filespec);
+        }
+    }
+#endif // wxHAS_FANOTIFY
+
+    return wxFileSystemWatcherBase::AddTree(path, events, filespec);
+}
+
+bool wxInotifyFileSystemWatcher::RemoveTree(const wxFileName& path)
+{
+#ifdef wxHAS_FANOTIFY
+    // Trees watched using fanotify only have a single watch for their root.
+    wxFSWatcherImplFanotify* const
+        impl = static_cast<wxFSWatcherImplFanotify*>(m_service);
+    if ( impl->IsWatchingTree(GetCanonicalPath(path)) )
+        return Remove(path);
+#endif // wxHAS_FANOTIFY
+
+    return wxFileSystemWatcherBase::RemoveTree(path);
+}
+
+bool
+wxFSWatcherIsUsingFanotify(const wxInotifyFileSystemWatcher& watcher,
+                           const wxFileName& path)
+{
+#ifdef wxHAS_FANOTIFY
+    const wxFSWatcherImplFanotify* const
+        impl = static_cast<const wxFSWatcherImplFanotify*>(watcher.m_service);
+    return impl->IsWatchingTree(
+                wxInotifyFileSystemWatcher::GetCanonicalPath(path));
+#else // !wxHAS_FANOTIFY
+    wxUnusedVar(watcher);
+    wxUnusedVar(path);
+    return false;
+#endif // wxHAS_FANOTIFY/!wxHAS_FANOTIFY
+}
+
 void wxInotifyFileSystemWatcher::OnDirDeleted(const wxString& path)
 {
     if (!path.empty())
@@ -0,0 +1,779 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/unix/iouringdispatcher.cpp
+// Purpose:     implements dispatcher using io_uring poll requests
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+#if wxUSE_EPOLL_DISPATCHER && defined(wxHAS_IO_URING)
+
+#include "wx/unix/private/iouringdispatcher.h"
+#include "wx/stopwatch.h"
+
+#ifndef WX_PRECOMP
+    #include "wx/log.h"
+    #include "wx/intl.h"
+#endif
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <string.h>
+#include <unistd.h>
+
+#define wxIoUringDispatcher_Trace wxT("iouringdispatcher")
+
+namespace
+{
+
+// Size of the submission ring: this limits the number of changes which can be
+// queued before they have to be submitted to the kernel.
+const unsigned SQ_ENTRIES = 256;
+
+// Size of the completion ring: there is at most one poll request per
+// descriptor in flight, so this is the number of events which can be
+// harvested at once (more completions are not lost, but are kept by the
+// kernel until the next Dispatch() call).
+const unsigned CQ_ENTRIES = 4096;
+
+// user_data used for the poll removal requests, whose completions are
+// ignored.
+const __u64 REMOVE_USER_DATA = ~static_cast<__u64>(0);
+
+inline __u64 MakeUserData(int fd, wxUint32 id)
+{
+    return (static_cast<__u64>(id) << 32) | static_cast<wxUint32>(fd);
+}
+
+inline int wxIoUringSetup(unsigned entries, io_uring_params* params)
+{
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+inline int wxIoUringEnter(int ringFD,
+                          unsigned toSubmit,
+                          unsigned minComplete,
+                          unsigned flags,
+                          const io_uring_getevents_arg* arg)
+{
+    return static_cast<int>(syscall(__NR_io_uring_enter, ringFD,
+                                    toSubmit, minComplete, flags,
+                                    arg, arg ? sizeof(*arg) : 0));
+}
+
+// helper: return POLLxxx mask corresponding to the given flags
+short GetPollEvents(int flags)
+{
+    short events = 0;
+
+    if ( flags & wxFDIO_INPUT )
+        events |= POLLIN;
+
+    if ( flags & wxFDIO_OUTPUT )
+        events |= POLLOUT;
+
+    if ( flags & wxFDIO_EXCEPTION )
+        events |= POLLERR | POLLHUP;
+
+    return events;
+}
+
+// helper: return the mask for the poll request corresponding to the given
+// flags (and also log debugging messages about it)
+__u32 GetPollMask(int flags, int fd)
+{
+    wxUnusedVar(fd); // unused if wxLogTrace() disabled
+
+    wxLogTrace(wxIoUringDispatcher_Trace,
+               wxT("Registered fd %d for%s%s%s events"), fd,
+               flags & wxFDIO_INPUT ? wxT(" input") : wxT(""),
+               flags & wxFDIO_OUTPUT ? wxT(" output") : wxT(""),
+               flags & wxFDIO_EXCEPTION ? wxT(" exceptional") : wxT(""));
+
+    __u32 mask = static_cast<unsigned short>(GetPollEvents(flags));
+
+#if wxBYTE_ORDER == wxBIG_ENDIAN
+    // poll32_events is stored as two 16 bit halves in the kernel
+    mask = (mask << 16) | (mask >> 16);
+#endif
+
+    return mask;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// implementation
+// ============================================================================
+
+/* static */
+wxIoUringDispatcher *wxIoUringDispatcher::Create()
+{
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = CQ_ENTRIES;
+
+    const int ringFD = wxIoUringSetup(SQ_ENTRIES, &params);
+    if ( ringFD == -1 )
+    {
+        // this is not an error, io_uring may be not available in the kernel,
+        // disabled by the system administrator or forbidden by seccomp
+        wxLogTrace(wxIoUringDispatcher_Trace,
+                   wxT("io_uring can't be used: %s"), wxSysErrorMsgStr());
+        return nullptr;
+    }
+
+    wxIoUringDispatcher * const dispatcher = new wxIoUringDispatcher();
+    if ( !dispatcher->Init(ringFD, params) )
+    {
+        delete dispatcher;
+        return nullptr;
+    }
+
+    wxLogTrace(wxIoUringDispatcher_Trace,
+               wxT("io_uring fd %d created"), ringFD);
+
+    return dispatcher;
+}
+
+bool wxIoUringDispatcher::Init(int ringFD, const io_uring_params& params)
+{
+    m_ringFD = ringFD;
+
+    // We need the kernel to not drop the completions if the ring overflows,
+    // to support the timeout argument for io_uring_enter() and multishot poll
+    // requests, which are available since Linux 5.5, 5.11 and 5.13. There is
+    // no feature flag for the latter, so check for resource tags support
+    // added in the same version instead. Single mmap() is available since
+    // 5.4, so it is present if the other ones are.
+    const __u32 features = IORING_FEAT_SINGLE_MMAP |
+                           IORING_FEAT_NODROP |
+                           IORING_FEAT_EXT_ARG |
+                           IORING_FEAT_RSRC_TAGS;
+    if ( (params.features & features) != features )
+    {
+        wxLogTrace(wxIoUringDispatcher_Trace,
+                   wxT("io_uring features %x are insufficient"),
+                   params.features);
+        return false;
+    }
+
+    const size_t sqSize = params.sq_off.array +
+                            params.sq_entries * sizeof(__u32);
+    const size_t cqSize = params.cq_off.cqes +
+                            params.cq_entries * sizeof(io_uring_cqe);
+    m_ringSize = wxMax(sqSize, cqSize);
+
+    void * const ring = mmap(nullptr, m_ringSize,
+                             PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_POPULATE,
+                             ringFD, IORING_OFF_SQ_RING);
+    if ( ring == MAP_FAILED )
+    {
+        wxLogSysError(_("Failed to map io_uring descriptor %d"), ringFD);
+        return false;
+    }
+    m_ringPtr = ring;
+
+    m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void * const sqes = mmap(nullptr, m_sqesSize,
+                             PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_POPULATE,
+                             ringFD, IORING_OFF_SQES);
+    if ( sqes == MAP_FAILED )
+    {
+        wxLogSysError(_("Failed to map io_uring descriptor %d"), ringFD);
+        return false;
+    }
+    m_sqes = static_cast<io_uring_sqe*>(sqes);
+
+    char * const base = static_cast<char*>(ring);
+
+    m_sqHead = reinterpret_cast<unsigned*>(base + params.sq_off.head);
+    m_sqTail = reinterpret_cast<unsigned*>(base + params.sq_off.tail);
+    m_sqFlags = reinterpret_cast<unsigned*>(base + params.sq_off.flags);
+    m_sqMask = *reinterpret_cast<unsigned*>(base + params.sq_off.ring_mask);
+    m_sqEntries = params.sq_entries;
+    m_sqTailLocal = *m_sqTail;
+
+    // We always fill the entries in order, so the indirection array can be
+    // set up just once.
+    unsigned * const array = reinterpret_cast<unsigned*>(base + params.sq_off.array);
+    for ( unsigned n = 0; n < m_sqEntries; n++ )
+        array[n] = n;
+
+    m_cqHead = reinterpret_cast<unsigned*>(base + params.cq_off.head);
+    m_cqTail = reinterpret_cast<unsigned*>(base + params.cq_off.tail);
+    m_cqMask = *reinterpret_cast<unsigned*>(base + params.cq_off.ring_mask);
+    m_cqes = reinterpret_cast<io_uring_cqe*>(base + params.cq_off.cqes);
+
+    return true;
+}
+
+wxIoUringDispatcher::~wxIoUringDispatcher()
+{
+    if ( m_sqes )
+        munmap(m_sqes, m_sqesSize);
+    if ( m_ringPtr )
+        munmap(m_ringPtr, m_ringSize);
+
+    // closing the ring also cancels all the pending poll requests
+    if ( m_ringFD != -1 && close(m_ringFD) != 0 )
+    {
+        wxLogSysError(_("Error closing io_uring descriptor"));
+    }
+}
+
+// ----------------------------------------------------------------------------
+// submission ring
+// ----------------------------------------------------------------------------
+
+unsigned wxIoUringDispatcher::GetQueuedCount() const
+{
+    return m_sqTailLocal - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+}
+
+io_uring_sqe *wxIoUringDispatcher::GetSQE()
+{
+    if ( GetQueuedCount() == m_sqEntries )
+    {
+        if ( !Submit() || GetQueuedCount() == m_sqEntries )
+            return nullptr;
+    }
+
+    io_uring_sqe * const sqe = &m_sqes[m_sqTailLocal & m_sqMask];
+    memset(sqe, 0, sizeof(*sqe));
+
+    m_sqTailLocal++;
+
+    return sqe;
+}
+
+bool wxIoUringDispatcher::Submit()
+{
+    for ( ;; )
+    {
+        const unsigned toSubmit = GetQueuedCount();
+        if ( !toSubmit )
+            return true;
+
+        __atomic_store_n(m_sqTail, m_sqTailLocal, __ATOMIC_RELEASE);
+
+        if ( wxIoUringEnter(m_ringFD, toSubmit, 0, 0, nullptr) != -1 )
+            return true;
+
+        if ( errno != EINTR )
+        {
+            wxLogSysError(_("Failed to submit requests to io_uring descriptor %d"),
+                          m_ringFD);
+            return false;
+        }
+    }
+}
+
+void wxIoUringDispatcher::SubmitIfWaiting()
+{
+    if ( m_waiting )
+        Submit();
+}
+
+bool wxIoUringDispatcher::Arm(int fd, Entry& entry)
+{
+    io_uring_sqe * const sqe = GetSQE();
+    if ( !sqe )
+        return false;
+
+    entry.id = ++m_lastId;
+    entry.armed = true;
+
+    // any event already harvested for the previous request will be ignored
+    // because of the id mismatch, so it's not pending any longer
+    entry.pending = false;
+
+    // Use multishot request remaining active after generating an event, so
+    // that it doesn't need to be queued again for each of them.
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = fd;
+    sqe->len = IORING_POLL_ADD_MULTI;
+    sqe->poll32_events = GetPollMask(entry.flags, fd);
+    sqe->user_data = MakeUserData(fd, entry.id);
+
+    return true;
+}
+
+bool wxIoUringDispatcher::Disarm(int fd, Entry& entry)
+{
+    if ( !entry.armed )
+        return true;
+
+    io_uring_sqe * const sqe = GetSQE();
+    if ( !sqe )
+        return false;
+
+    entry.armed = false;
+
+    sqe->opcode = IORING_OP_POLL_REMOVE;
+    sqe->fd = -1;
+    sqe->addr = MakeUserData(fd, entry.id);
+    sqe->user_data = REMOVE_USER_DATA;
+
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// descriptors management
+// ----------------------------------------------------------------------------
+
+bool wxIoUringDispatcher::RegisterFD(int fd, wxFDIOHandler* handler, int flags)
+{
+    wxCRIT_SECT_LOCKER(lock, m_cs);
+
+    Entry entry;
+    entry.handler = handler;
+    entry.flags = flags;
+    entry.id = 0;
+    entry.armed = false;
+    entry.pending = false;
+
+    const auto res = m_entries.emplace(fd, entry);
+    if ( !res.second )
+    {
+        wxLogError(_("Failed to add descriptor %d to io_uring descriptor %d: already registered"),
+                   fd, m_ringFD);
+        return false;
+    }
+
+    if ( !Arm(fd, res.first->second) )
+    {
+        wxLogError(_("Failed to add descriptor %d to io_uring descriptor %d"),
+                   fd, m_ringFD);
+        m_entries.erase(res.first);
+        return false;
+    }
+
+    SubmitIfWaiting();
+
+    wxLogTrace(wxIoUringDispatcher_Trace,
+               wxT("Added fd %d (handler %p) to io_uring %d"), fd, handler, m_ringFD);
+
+    return true;
+}
+
+bool wxIoUringDispatcher::ModifyFD(int fd, wxFDIOHandler* handler, int flags)
+{
+    wxCRIT_SECT_LOCKER(lock, m_cs);
+
+    const auto it = m_entries.find(fd);
+    if ( it == m_entries.end() )
+    {
+        wxLogError(_("Failed to modify descriptor %d in io_uring descriptor %d: not registered"),
+                   fd, m_ringFD);
+        return false;
+    }
+
+    Entry& entry = it->second;
+    entry.handler = handler;
+
+    // There is no need to replace the pending poll request if it already
+    // waits for the right events.
+    if ( entry.flags != flags || !entry.armed )
+    {
+        entry.flags = flags;
+
+        if ( !Disarm(fd, entry) || !Arm(fd, entry) )
+        {
+            wxLogError(_("Failed to modify descriptor %d in io_uring descriptor %d"),
+                       fd, m_ringFD);
+            return false;
+        }
+
+        SubmitIfWaiting();
+    }
+
+    wxLogTrace(wxIoUringDispatcher_Trace,
+                wxT("Modified fd %d (handler: %p) on io_uring %d"), fd, handler, m_ringFD);
+    return true;
+}
+
+bool wxIoUringDispatcher::UnregisterFD(int fd)
+{
+    wxCRIT_SECT_LOCKER(lock, m_cs);
+
+    const auto it = m_entries.find(fd);
+    if ( it == m_entries.end() )
+    {
+        wxLogError(_("Failed to unregister descriptor %d from io_uring descriptor %d: not registered"),
+                   fd, m_ringFD);
+        return false;
+    }
+
+    if ( !Disarm(fd, it->second) )
+    {
+        wxLogError(_("Failed to unregister descriptor %d from io_uring descriptor %d"),
+                   fd, m_ringFD);
+    }
+
+    m_entries.erase(it);
+
+    SubmitIfWaiting();
+
+    wxLogTrace(wxIoUringDispatcher_Trace,
+                wxT("removed fd %d from %d"), fd, m_ringFD);
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// events dispatching
+// ----------------------------------------------------------------------------
+
+int wxIoUringDispatcher::Wait(int timeout)
+{
+    wxMilliClock_t timeEnd;
+    if ( timeout > 0 )
+        timeEnd = wxGetLocalTimeMillis() + timeout;
+
+    io_uring_getevents_arg arg;
+    memset(&arg, 0, sizeof(arg));
+    arg.sigmask_sz = _NSIG / 8;
+
+    __kernel_timespec ts;
+
+    for ( ;; )
+    {
+        unsigned toSubmit;
+        {
+            wxCRIT_SECT_LOCKER(lock, m_cs);
+
+            toSubmit = GetQueuedCount();
+
+            // Don't bother calling io_uring_enter() when we're not going to
+            // wait if there is nothing to submit and no completions kept by
+            // the kernel because the ring was full.
+            if ( !timeout && !toSubmit &&
+                    !(__atomic_load_n(m_sqFlags, __ATOMIC_RELAXED) &
+                        IORING_SQ_CQ_OVERFLOW) )
+                return 0;
+
+            __atomic_store_n(m_sqTail, m_sqTailLocal, __ATOMIC_RELEASE);
+
+            m_waiting++;
+        }
+
+        if ( timeout > 0 )
+        {
+            ts.tv_sec = timeout / 1000;
+            ts.tv_nsec = (timeout % 1000) * 1000000;
+            arg.ts = reinterpret_cast<__u64>(&ts);
+        }
+        else
+        {
+            // null timeout means waiting forever
+            arg.ts = 0;
+        }
+
+        const int rc = wxIoUringEnter(m_ringFD, toSubmit, timeout ? 1 : 0,
+                                      IORING_ENTER_GETEVENTS |
+                                      IORING_ENTER_EXT_ARG,
+                                      &arg);
+        const int err = errno;
+
+        {
+            wxCRIT_SECT_LOCKER(lock, m_cs);
+            m_waiting--;
+        }
+
+        if ( rc != -1 )
+            return rc;
+
+        switch ( err )
+        {
+            case ETIME:
+                return 0;
+
+            case EBUSY:
+            case EAGAIN:
+                // the completion ring is full and the kernel can't accept
+                // more requests until we harvest the completions
+                return 0;
+
+            case EINTR:
+                // we got interrupted, update the timeout and restart
+                if ( timeout > 0 )
+                {
+                    timeout = wxMilliClockToLong(timeEnd - wxGetLocalTimeMillis());
+                    if ( timeout <= 0 )
+                        return 0;
+                }
+                break;
+
+            default:
+                errno = err;
+                return -1;
+        }
+    }
+}
+
+void wxIoUringDispatcher::Harvest(std::vector<Event>& events)
+{
+    unsigned head = *m_cqHead;
+    const unsigned tail = __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE);
+
+    for ( ; head != tail; head++ )
+    {
+        const io_uring_cqe& cqe = m_cqes[head & m_cqMask];
+        if ( cqe.user_data == REMOVE_USER_DATA )
+            continue;
+
+        const int fd = static_cast<int>(cqe.user_data & 0xffffffff);
+        const wxUint32 id = static_cast<wxUint32>(cqe.user_data >> 32);
+
+        // ignore completions of the requests for the descriptors which were
+        // unregistered or modified since then
+        const auto it = m_entries.find(fd);
+        if ( it == m_entries.end() || it->second.id != id )
+            continue;
+
+        Entry& entry = it->second;
+
+        // the request may be terminated by the kernel, e.g. if the completion
+        // ring overflowed, in which case we need to queue it again
+        if ( !(cqe.flags & IORING_CQE_F_MORE) )
+            entry.armed = false;
+
+        if ( cqe.res < 0 )
+        {
+            // the requests are cancelled when the thread which submitted
+            // them exits, just submit them again from this one
+            if ( cqe.res == -ECANCELED )
+            {
+                Arm(fd, entry);
+                continue;
+            }
+
+            // otherwise this happens if the descriptor was closed without
+            // being unregistered, in which case epoll would stop reporting
+            // events for it too
+            wxLogTrace(wxIoUringDispatcher_Trace,
+                       wxT("Polling fd %d failed: %s"),
+                       fd, wxSysErrorMsgStr(-cqe.res));
+            continue;
+        }
+
+        // don't dispatch the same event twice if it's already pending
+        if ( entry.pending )
+            continue;
+
+        entry.pending = true;
+
+        Event ev;
+        ev.fd = fd;
+        ev.id = id;
+        ev.events = cqe.res;
+        events.push_back(ev);
+    }
+
+    __atomic_store_n(m_cqHead, head, __ATOMIC_RELEASE);
+}
+
+void wxIoUringDispatcher::CheckStillReady(const std::vector<Event>& events)
+{
+    std::vector<pollfd> fds;
+    fds.reserve(events.size());
+    for ( const Event& ev : events )
+    {
+        pollfd pfd;
+        pfd.fd = ev.fd;
+        pfd.events = static_cast<short>(ev.events);
+        pfd.revents = 0;
+        fds.push_back(pfd);
+    }
+
+    if ( poll(&fds[0], fds.size(), 0) <= 0 )
+        return;
+
+    wxCRIT_SECT_LOCKER(lock, m_cs);
+
+    for ( size_t n = 0; n < fds.size(); n++ )
+    {
+        if ( !fds[n].revents )
+            continue;
+
+        const auto it = m_entries.find(fds[n].fd);
+        if ( it == m_entries.end() ||
+                it->second.id != events[n].id ||
+                    it->second.pending )
+            continue;
+
+        it->second.pending = true;
+
+        Event ev = events[n];
+        ev.events = fds[n].revents;
+        m_pending.push_back(ev);
+    }
+}
+
+bool wxIoUringDispatcher::HasPending() const
+{
+    // submitting the queued requests may result in new completions if the
+    // descriptors are already ready, so we need to modify the object here
+    wxIoUringDispatcher * const self = const_cast<wxIoUringDispatcher *>(this);
+
+    wxCRIT_SECT_LOCKER(lock, self->m_cs);
+
+    if ( !m_pending.empty() )
+        return true;
+
+    self->Submit();
+
+    // don't just check if there are any completions as some of them, e.g.
+    // for the removed requests, don't result in any events and Dispatch()
+    // would block if we returned true because of them, so harvest them and
+    // remember the events to be dispatched by the next call to Dispatch()
+    self->Harvest(self->m_pending);
+
+    return !m_pending.empty();
+}
+
+int wxIoUringDispatcher::Dispatch(int timeout)
+{
+    wxMilliClock_t timeEnd;
+    if ( timeout > 0 )
+        timeEnd = wxGetLocalTimeMillis() + timeout;
+
+    std::vector<Event> events;
+    for ( ;; )
+    {
+        bool hasPending;
+        {
+            wxCRIT_SECT_LOCKER(lock, m_cs);
+            hasPending = !m_pending.empty();
+        }
+
+        if ( Wait(hasPending ? 0 : timeout) == -1 )
+        {
+            wxLogSysError(_("Waiting for IO on io_uring descriptor %d failed"),
+                          m_ringFD);
+            return -1;
+        }
+
+        {
+            wxCRIT_SECT_LOCKER(lock, m_cs);
+            events.swap(m_pending);
+            Harvest(events);
+        }
+
+        // we could have been woken up by the completions which don't result
+        // in any events, e.g. for the cancelled requests, continue waiting
+        // in this case
+        if ( !events.empty() || !timeout )
+            break;
+
+        if ( timeout > 0 )
+        {
+            timeout = wxMilliClockToLong(timeEnd - wxGetLocalTimeMillis());
+            if ( timeout <= 0 )
+                break;
+        }
+    }
+
+    // the descriptors for which we called the handlers and which need to be
+    // checked for still being ready after it
+    std::vector<Event> dispatched;
+
+    int numEvents = 0;
+    for ( const Event& ev : events )
+    {
+        // the handler may have been unregistered by another one called
+        // before it
+        wxFDIOHandler *handler;
+        {
+            wxCRIT_SECT_LOCKER(lock, m_cs);
+
+            const auto it = m_entries.find(ev.fd);
+            if ( it == m_entries.end() || it->second.id != ev.id )
+                continue;
+
+            it->second.pending = false;
+            handler = it->second.handler;
+        }
+
+        if ( !handler )
+        {
+            wxFAIL_MSG( wxT("null handler in io_uring entry?") );
+            continue;
+        }
+
+        // see wxEpollDispatcher::Dispatch() for why POLLHUP is handled as
+        // input
+        if ( ev.events & (POLLIN | POLLHUP) )
+            handler->OnReadWaiting();
+        else if ( ev.events & POLLOUT )
+            handler->OnWriteWaiting();
+        else if ( ev.events & POLLERR )
+            handler->OnExceptionWaiting();
+        else
+            continue;
+
+        numEvents++;
+
+        {
+            wxCRIT_SECT_LOCKER(lock, m_cs);
+
+            const auto it = m_entries.find(ev.fd);
+            if ( it == m_entries.end() || it->second.id != ev.id )
+            {
+                // the handler unregistered or modified the descriptor, so
+                // there is nothing else to do for it
+                continue;
+            }
+
+            Entry& entry = it->second;
+            if ( !entry.armed )
+            {
+                // the request was terminated, queue it again: it will be
+                // submitted during the next call to Dispatch() and will
+                // complete immediately if the descriptor is still ready
+                if ( Arm(ev.fd, entry) )
+                    SubmitIfWaiting();
+                else
+                    wxLogError(_("Failed to re-add descriptor %d to io_uring descriptor %d"),
+                               ev.fd, m_ringFD);
+                continue;
+            }
+
+            Event check = ev;
+            check.events = GetPollEvents(entry.flags);
+            dispatched.push_back(check);
+        }
+    }
+
+    // Multishot requests only generate events when the state of the
+    // descriptor changes, so if the handler didn't read all the available
+    // data, we wouldn't be notified about it again. To provide the same
+    // level-triggered semantics as epoll and select, check all the
+    // descriptors we dispatched the events for using a single poll() call
+    // and dispatch the events for those still ready during the next call.
+    if ( !dispatched.empty() )
+        CheckStillReady(dispatched);
+
+    return numEvents;
+}
+
+#endif // wxUSE_EPOLL_DISPATCHER && wxHAS_IO_URING
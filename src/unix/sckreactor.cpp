@@ -0,0 +1,534 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        src/unix/sckreactor.cpp
+// Purpose:     wxSocketReactor implementation
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+// For compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+#include "wx/sckreactor.h"
+
+#ifdef wxHAS_SOCKET_REACTOR
+
+#include "wx/atomic.h"
+#include "wx/thread.h"
+
+#include "wx/private/fdiodispatcher.h"
+#include "wx/private/socket.h"
+#include "wx/unix/pipe.h"
+#include "wx/unix/private/fdiounix.h"
+#include "wx/unix/private/sockunix.h"
+
+#include <sys/socket.h>
+
+#include <memory>
+#include <unordered_set>
+
+#define wxTRACE_SocketReactor wxT("sckreactor")
+
+namespace
+{
+
+// ----------------------------------------------------------------------------
+// ReactorWakeUp: pipe used to wake up a reactor thread from other threads
+// ----------------------------------------------------------------------------
+
+class ReactorWakeUp : public wxFDIOHandler
+{
+public:
+    ReactorWakeUp() = default;
+
+    bool Create()
+    {
+        return m_pipe.Create() &&
+                m_pipe.MakeNonBlocking(wxPipe::Read) &&
+                    m_pipe.MakeNonBlocking(wxPipe::Write);
+    }
+
+    int GetReadFd() const { return m_pipe[wxPipe::Read]; }
+
+    // can be called from any thread
+    void WakeUp()
+    {
+        // if the pipe is full, the thread is going to wake up anyhow, so
+        // ignore the errors here
+        const char ch = 0;
+        if ( write(m_pipe[wxPipe::Write], &ch, 1) != 1 )
+        {
+            wxLogTrace(wxTRACE_SocketReactor, "Failed to write to wake up pipe");
+        }
+    }
+
+    virtual void OnReadWaiting() override
+    {
+        char buf[64];
+        while ( read(m_pipe[wxPipe::Read], buf, sizeof(buf)) > 0 )
+            ;
+    }
+
+    virtual void OnWriteWaiting() override { }
+    virtual void OnExceptionWaiting() override { }
+
+private:
+    wxPipe m_pipe;
+
+    wxDECLARE_NO_COPY_CLASS(ReactorWakeUp);
+};
+
+// ----------------------------------------------------------------------------
+// ReactorSocketManager: monitors sockets using a reactor thread dispatcher
+// ----------------------------------------------------------------------------
+
+class ReactorSocketManager : public wxSocketFDBasedManager
+{
+public:
+    explicit ReactorSocketManager(wxFDIOManager *fdioManager)
+        : wxSocketFDBasedManager(fdioManager)
+    {
+    }
+
+    virtual wxSocketImpl *CreateSocket(wxSocketBase& wxsocket) override
+    {
+        wxSocketImpl * const impl = wxSocketFDBasedManager::CreateSocket(wxsocket);
+        impl->SetManager(this);
+
+        return impl;
+    }
+
+    virtual void Install_Callback(wxSocketImpl *socket,
+                                  wxSocketNotify event) override
+    {
+        // The sockets are only used from the reactor threads, so waiting for
+        // them to become writable never uses the events and we don't need to
+        // be woken up whenever a socket becomes writable again after writing
+        // to it, which would happen every time otherwise.
+        if ( event == wxSOCKET_OUTPUT )
+            return;
+
+        wxSocketFDBasedManager::Install_Callback(socket, event);
+    }
+};
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// wxSocketReactorLoop: one of the reactor threads
+// ----------------------------------------------------------------------------
+
+class wxSocketReactorLoop : public wxThread
+{
+public:
+    // takes ownership of the dispatcher
+    wxSocketReactorLoop(wxSocketReactor& reactor, wxFDIODispatcher *dispatcher)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_reactor(reactor),
+          m_dispatcher(dispatcher),
+          m_fdioManager(dispatcher),
+          m_socketManager(&m_fdioManager),
+          m_sink(*this)
+    {
+    }
+
+    virtual ~wxSocketReactorLoop()
+    {
+        if ( m_wakeUpRegistered )
+            m_dispatcher->UnregisterFD(m_wakeUp.GetReadFd());
+
+        // this can only be non-empty if the thread was never started
+        for ( wxSocketBase *socket : m_newSockets )
+            delete socket;
+    }
+
+    // must be called before starting the thread
+    bool Init()
+    {
+        if ( !m_dispatcher || !m_wakeUp.Create() )
+            return false;
+
+        m_wakeUpRegistered = m_dispatcher->RegisterFD(m_wakeUp.GetReadFd(),
+                                                      &m_wakeUp,
+                                                      wxFDIO_INPUT);
+        return m_wakeUpRegistered;
+    }
+
+    // make this thread monitor the listening socket, must be called before
+    // starting the thread
+    void AttachServer(wxSocketServer& server)
+    {
+        SetupSocket(server, wxSOCKET_CONNECTION_FLAG);
+    }
+
+    // pass a newly accepted socket to this thread, can be called from any
+    // thread
+    void AddSocket(wxSocketBase *socket)
+    {
+        {
+            wxCriticalSectionLocker lock(m_cs);
+            m_newSockets.push_back(socket);
+        }
+
+        m_wakeUp.WakeUp();
+    }
+
+    // ask the thread to close all sockets and exit, can be called from any
+    // thread
+    void RequestStop()
+    {
+        {
+            wxCriticalSectionLocker lock(m_cs);
+            m_stop = true;
+        }
+
+        m_wakeUp.WakeUp();
+    }
+
+    size_t GetConnectionCount() const
+    {
+        return static_cast<size_t>(static_cast<int>(m_numConnections));
+    }
+
+protected:
+    virtual ExitCode Entry() override;
+
+private:
+    // the only events we're interested in
+    struct Event
+    {
+        wxSocketBase *socket;
+        wxSocketNotify notify;
+    };
+
+    // event handler used for all sockets handled by this thread: it just
+    // collects the events to process after the dispatcher returns
+    class EventSink : public wxEvtHandler
+    {
+    public:
+        explicit EventSink(wxSocketReactorLoop& loop) : m_loop(loop) { }
+
+        virtual void QueueEvent(wxEvent *event) override
+        {
+            std::unique_ptr<wxEvent> ev(event);
+
+            wxSocketEvent * const sockEvent = wxDynamicCast(event, wxSocketEvent);
+            wxCHECK_RET( sockEvent, "unexpected event" );
+
+            const Event e = { sockEvent->GetSocket(), sockEvent->GetSocketEvent() };
+            m_loop.m_events.push_back(e);
+        }
+
+    private:
+        wxSocketReactorLoop& m_loop;
+    };
+
+    // make the socket use this thread for its events and switch it to the
+    // non-blocking mode
+    void SetupSocket(wxSocketBase& socket, wxSocketEventFlags flags);
+
+    // attach all sockets queued by AddSocket() to this thread, returns false
+    // if we should stop
+    bool ProcessNewSockets();
+
+    // process all collected socket events
+    void ProcessEvents();
+
+    // called after calling the user-defined handler for the socket to check if
+    // it was closed, in which case it's removed
+    void CheckIfClosed(wxSocketBase *socket)
+    {
+        if ( socket->GetSocket() == INVALID_SOCKET )
+            Remove(socket);
+    }
+
+    // notify about the socket being closed and schedule it for deletion
+    void Remove(wxSocketBase *socket);
+
+
+    wxSocketReactor& m_reactor;
+
+    // the dispatcher and the managers using it for the sockets
+    const std::unique_ptr<wxFDIODispatcher> m_dispatcher;
+    wxFDIOManagerUnix m_fdioManager;
+    ReactorSocketManager m_socketManager;
+
+    ReactorWakeUp m_wakeUp;
+    bool m_wakeUpRegistered = false;
+
+    EventSink m_sink;
+
+    // the events collected while dispatching
+    std::vector<Event> m_events;
+
+    // all sockets handled by this thread
+    std::unordered_set<wxSocketBase *> m_sockets;
+
+    // the sockets removed while processing the events, they're only deleted
+    // once all events are processed as there could be more events for them
+    std::vector<wxSocketBase *> m_removed;
+
+    // the number of the elements in m_sockets, which can be read from other
+    // threads
+    wxAtomicInt m_numConnections = 0;
+
+    // the sockets added by AddSocket() and the flag set by RequestStop(),
+    // both protected by m_cs
+    std::vector<wxSocketBase *> m_newSockets;
+    bool m_stop = false;
+    wxCriticalSection m_cs;
+
+    wxDECLARE_NO_COPY_CLASS(wxSocketReactorLoop);
+};
+
+void
+wxSocketReactorLoop::SetupSocket(wxSocketBase& socket, wxSocketEventFlags flags)
+{
+    // the socket must be still blocking and so not monitored by any manager
+    wxSocketReactor::GetImpl(socket)->SetManager(&m_socketManager);
+
+    socket.SetEventHandler(m_sink);
+    socket.SetNotify(flags);
+    socket.Notify(true);
+
+    // this starts monitoring the socket events using m_socketManager
+    socket.SetFlags(socket.GetFlags() & ~wxSOCKET_BLOCK);
+}
+
+bool wxSocketReactorLoop::ProcessNewSockets()
+{
+    std::vector<wxSocketBase *> sockets;
+    bool stop;
+    {
+        wxCriticalSectionLocker lock(m_cs);
+        sockets.swap(m_newSockets);
+        stop = m_stop;
+    }
+
+    for ( wxSocketBase *socket : sockets )
+    {
+        if ( stop )
+        {
+            delete socket;
+            continue;
+        }
+
+        SetupSocket(*socket, wxSOCKET_INPUT_FLAG | wxSOCKET_LOST_FLAG);
+
+        m_sockets.insert(socket);
+        wxAtomicInc(m_numConnections);
+
+        m_reactor.m_handler.OnConnection(*socket);
+        CheckIfClosed(socket);
+    }
+
+    return !stop;
+}
+
+void wxSocketReactorLoop::ProcessEvents()
+{
+    // notice that new events can be added while we iterate
+    for ( size_t n = 0; n < m_events.size(); n++ )
+    {
+        const Event e = m_events[n];
+
+        if ( e.socket == m_reactor.m_server )
+        {
+            if ( e.notify == wxSOCKET_CONNECTION )
+                m_reactor.AcceptConnections();
+            continue;
+        }
+
+        // ignore the events for the sockets which were already removed
+        if ( !m_sockets.count(e.socket) )
+            continue;
+
+        switch ( e.notify )
+        {
+            case wxSOCKET_INPUT:
+                m_reactor.m_handler.OnInput(*e.socket);
+                CheckIfClosed(e.socket);
+                break;
+
+            case wxSOCKET_LOST:
+                Remove(e.socket);
+                break;
+
+            default:
+                // we're not interested in the other events
+                break;
+        }
+    }
+
+    m_events.clear();
+
+    for ( wxSocketBase *socket : m_removed )
+        delete socket;
+
+    m_removed.clear();
+}
+
+void wxSocketReactorLoop::Remove(wxSocketBase *socket)
+{
+    m_sockets.erase(socket);
+    wxAtomicDec(m_numConnections);
+
+    m_reactor.m_handler.OnLost(*socket);
+
+    // close it if it's still open, this also unregisters it from our
+    // dispatcher
+    socket->Notify(false);
+    socket->Close();
+
+    m_removed.push_back(socket);
+}
+
+wxThread::ExitCode wxSocketReactorLoop::Entry()
+{
+    while ( ProcessNewSockets() )
+    {
+        ProcessEvents();
+
+        if ( m_dispatcher->Dispatch() == -1 )
+        {
+            wxLogTrace(wxTRACE_SocketReactor, "Dispatching events failed");
+        }
+    }
+
+    // close all remaining connections
+    const std::vector<wxSocketBase *> sockets(m_sockets.begin(), m_sockets.end());
+    for ( wxSocketBase *socket : sockets )
+        Remove(socket);
+
+    ProcessEvents();
+
+    return nullptr;
+}
+
+// ============================================================================
+// wxSocketReactor implementation
+// ============================================================================
+
+wxSocketReactor::wxSocketReactor(wxSocketReactorHandler& handler)
+    : m_handler(handler)
+{
+    m_server = nullptr;
+    m_nextLoop = 0;
+}
+
+wxSocketReactor::~wxSocketReactor()
+{
+    Stop();
+}
+
+bool wxSocketReactor::Start(const wxSockAddress& addr, unsigned numThreads)
+{
+    wxCHECK_MSG( !IsRunning(), false, "reactor is already running" );
+
+    if ( !numThreads )
+    {
+        const int numCPUs = wxThread::GetCPUCount();
+        numThreads = numCPUs > 0 ? numCPUs : 1;
+    }
+
+    // create the server in the blocking mode so that it's not registered
+    // with the global socket manager, we switch it to the non-blocking mode
+    // when attaching it to the first thread
+    m_server = new wxSocketServer(addr, wxSOCKET_BLOCK | wxSOCKET_REUSEADDR);
+    if ( !m_server->IsOk() )
+    {
+        wxDELETE(m_server);
+        return false;
+    }
+
+    // wxSocketServer uses a tiny backlog which is not enough when many clients
+    // connect at once, so increase it: calling listen() again for an already
+    // listening socket just updates it.
+    if ( listen(m_server->GetSocket(), SOMAXCONN) != 0 )
+    {
+        wxLogTrace(wxTRACE_SocketReactor, "Failed to increase listen backlog");
+    }
+
+    for ( unsigned n = 0; n < numThreads; n++ )
+    {
+        wxSocketReactorLoop * const
+            loop = new wxSocketReactorLoop(*this, wxFDIODispatcher::Create());
+        m_loops.push_back(loop);
+
+        if ( !loop->Init() )
+        {
+            Stop();
+            return false;
+        }
+    }
+
+    m_loops[0]->AttachServer(*m_server);
+
+    for ( wxSocketReactorLoop *loop : m_loops )
+    {
+        if ( loop->Run() != wxTHREAD_NO_ERROR )
+        {
+            Stop();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void wxSocketReactor::Stop()
+{
+    for ( wxSocketReactorLoop *loop : m_loops )
+        loop->RequestStop();
+
+    for ( wxSocketReactorLoop *loop : m_loops )
+    {
+        if ( loop->IsRunning() || loop->IsPaused() || loop->IsAlive() )
+            loop->Wait();
+    }
+
+    // delete the server before the threads as it's still registered with the
+    // dispatcher of the first one
+    wxDELETE(m_server);
+
+    for ( wxSocketReactorLoop *loop : m_loops )
+        delete loop;
+
+    m_loops.clear();
+    m_nextLoop = 0;
+}
+
+bool wxSocketReactor::GetLocal(wxSockAddress& addr) const
+{
+    return m_server && m_server->GetLocal(addr);
+}
+
+size_t wxSocketReactor::GetConnectionCount() const
+{
+    size_t count = 0;
+    for ( const wxSocketReactorLoop *loop : m_loops )
+        count += loop->GetConnectionCount();
+
+    return count;
+}
+
+void wxSocketReactor::AcceptConnections()
+{
+    for ( ;; )
+    {
+        // the new socket is blocking until it's attached to its thread
+        wxSocketBase * const socket = new wxSocketBase();
+        socket->SetFlags(wxSOCKET_BLOCK);
+
+        if ( !m_server->AcceptWith(*socket, false) )
+        {
+            delete socket;
+            break;
+        }
+
+        m_loops[m_nextLoop++ % m_loops.size()]->AddSocket(socket);
+    }
+}
+
+#endif // wxHAS_SOCKET_REACTOR
@@ -88,7 +88,7 @@ wxSocketError wxSocketImplUnix::GetLastError() const
 
 void wxSocketImplUnix::DoEnableEvents(int flags, bool enable)
 {
-    wxSocketManager * const manager = wxSocketManager::Get();
+    wxSocketManager * const manager = GetManager();
     if (!manager)
         return;
 
@@ -0,0 +1,918 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/unix/tzinfo.cpp
+// Purpose:     wxTimeZoneInfo implementation
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "wx/wxprec.h"
+
+#include "wx/unix/private/tzinfo.h"
+
+#ifdef wxHAS_TIMEZONEINFO
+
+#include "wx/thread.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+
+// ----------------------------------------------------------------------------
+// constants
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+const long SECONDS_PER_DAY = 86400;
+
+// The offsets used by all the real zones are less than this, so it's enough
+// to look for the local time this far away from it in UTC.
+const long MAX_OFFSET = 26*3600;
+
+// The default DST rules used for the POSIX TZ strings without them, as in
+// "EST5EDT", are the current US ones.
+const char* const DEFAULT_RULES = ",M3.2.0,M11.1.0";
+
+// Zone files are small, don't read anything bigger than this.
+const size_t MAX_FILE_SIZE = 1024*1024;
+
+// ----------------------------------------------------------------------------
+// calendar helpers
+// ----------------------------------------------------------------------------
+
+wxInt64 FloorDiv(wxInt64 a, wxInt64 b)
+{
+    wxInt64 q = a / b;
+    if ( (a % b != 0) && ((a < 0) != (b < 0)) )
+        q--;
+
+    return q;
+}
+
+bool IsLeapYear(wxInt64 year)
+{
+    return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+}
+
+// Return the number of days since the epoch for the given date in the
+// proleptic Gregorian calendar, month is 1-based here.
+wxInt64 DaysFromCivil(wxInt64 year, int month, int day)
+{
+    if ( month <= 2 )
+        year--;
+
+    const wxInt64 era = FloorDiv(year, 400);
+    const wxInt64 yoe = year - era * 400;
+    const wxInt64 doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5
+                            + day - 1;
+    const wxInt64 doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+    return era * 146097 + doe - 719468;
+}
+
+// Inverse of DaysFromCivil(), month is 1-based too.
+void CivilFromDays(wxInt64 days, wxInt64* year, int* month, int* day)
+{
+    days += 719468;
+
+    const wxInt64 era = FloorDiv(days, 146097);
+    const wxInt64 doe = days - era * 146097;
+    const wxInt64 yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const wxInt64 doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const wxInt64 mp = (5 * doy + 2) / 153;
+
+    *day = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+    *month = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+    *year = yoe + era * 400 + (*month <= 2 ? 1 : 0);
+}
+
+wxInt64 GetYearOf(wxInt64 t)
+{
+    wxInt64 year;
+    int month, day;
+    CivilFromDays(FloorDiv(t, SECONDS_PER_DAY), &year, &month, &day);
+
+    return year;
+}
+
+// ----------------------------------------------------------------------------
+// TZif file format helpers
+// ----------------------------------------------------------------------------
+
+wxInt64 ReadInt(const unsigned char* p, size_t size)
+{
+    wxUint64 value = 0;
+    for ( size_t n = 0; n < size; n++ )
+        value = (value << 8) | p[n];
+
+    // Sign extend the 32-bit values.
+    if ( size == 4 )
+        return static_cast<wxInt32>(value);
+
+    return static_cast<wxInt64>(value);
+}
+
+// Header of TZif file, see RFC 8536.
+struct TZifHeader
+{
+    enum { Size = 44 };
+
+    bool Read(const unsigned char* p, const unsigned char* end)
+    {
+        if ( end - p < Size || memcmp(p, "TZif", 4) != 0 )
+            return false;
+
+        version = p[4];
+
+        p += 20;
+        isutcnt = ReadInt(p, 4);
+        isstdcnt = ReadInt(p + 4, 4);
+        leapcnt = ReadInt(p + 8, 4);
+        timecnt = ReadInt(p + 12, 4);
+        typecnt = ReadInt(p + 16, 4);
+        charcnt = ReadInt(p + 20, 4);
+
+        return isutcnt >= 0 && isstdcnt >= 0 && leapcnt >= 0 &&
+                timecnt >= 0 && typecnt > 0 && charcnt > 0 &&
+                typecnt <= 256;
+    }
+
+    // Size of the data block following the header.
+    wxInt64 GetDataSize(size_t timeSize) const
+    {
+        return timecnt * static_cast<wxInt64>(timeSize) + timecnt +
+                typecnt * 6 + charcnt +
+                leapcnt * static_cast<wxInt64>(timeSize + 4) +
+                isstdcnt + isutcnt;
+    }
+
+    unsigned char version;
+    wxInt64 isutcnt,
+            isstdcnt,
+            leapcnt,
+            timecnt,
+            typecnt,
+            charcnt;
+};
+
+// ----------------------------------------------------------------------------
+// POSIX TZ string helpers
+// ----------------------------------------------------------------------------
+
+bool ParseName(const char*& s, std::string& name)
+{
+    const char* const start = s;
+    if ( *s == '<' )
+    {
+        for ( ++s; *s != '>'; ++s )
+        {
+            if ( !isalnum(static_cast<unsigned char>(*s)) &&
+                    *s != '+' && *s != '-' )
+                return false;
+        }
+
+        name.assign(start + 1, s++);
+    }
+    else
+    {
+        while ( isalpha(static_cast<unsigned char>(*s)) )
+            ++s;
+
+        name.assign(start, s);
+    }
+
+    return name.length() >= 3;
+}
+
+bool ParseNumber(const char*& s, int max, long* value)
+{
+    if ( !isdigit(static_cast<unsigned char>(*s)) )
+        return false;
+
+    long n = 0;
+    while ( isdigit(static_cast<unsigned char>(*s)) )
+    {
+        n = n * 10 + *s++ - '0';
+        if ( n > max )
+            return false;
+    }
+
+    *value = n;
+    return true;
+}
+
+// Parse "[+-]hh[:mm[:ss]]" and return the number of seconds.
+bool ParseTime(const char*& s, int maxHours, long* secs)
+{
+    long sign = 1;
+    if ( *s == '+' || *s == '-' )
+    {
+        if ( *s++ == '-' )
+            sign = -1;
+    }
+
+    long hours;
+    if ( !ParseNumber(s, maxHours, &hours) )
+        return false;
+
+    long value = hours * 3600;
+    for ( int mult = 60; mult && *s == ':'; mult /= 60 )
+    {
+        ++s;
+
+        long n;
+        if ( !ParseNumber(s, 59, &n) )
+            return false;
+
+        value += n * mult;
+    }
+
+    *secs = sign * value;
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// global zone table
+// ----------------------------------------------------------------------------
+
+// The local zone corresponding to the given value of TZ.
+struct LocalZone
+{
+    bool isSet;
+    std::string tz;
+    const wxTimeZoneInfo* info;
+};
+
+struct ZoneTable
+{
+    wxCRIT_SECT_DECLARE_MEMBER(cs);
+
+    // All the zones loaded so far, including the ones which couldn't be
+    // loaded which are null, indexed by their names.
+    std::unordered_map<std::string, std::unique_ptr<wxTimeZoneInfo>> zones;
+
+    // All the local zones used so far.
+    std::vector<std::unique_ptr<LocalZone>> locals;
+};
+
+// The table is never destroyed as it can still be used during the program
+// shutdown, e.g. by the destructors of the global objects.
+ZoneTable& GetZoneTable()
+{
+    static ZoneTable* const s_table = new ZoneTable;
+    return *s_table;
+}
+
+// The last used local zone, for checking whether it changed without locking.
+std::atomic<const LocalZone*> gs_lastLocal{nullptr};
+
+} // anonymous namespace
+
+// ============================================================================
+// wxTimeZoneInfo implementation
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// loading
+// ----------------------------------------------------------------------------
+
+/* static */
+const wxTimeZoneInfo* wxTimeZoneInfo::GetLocal()
+{
+    // Check if TZ changed since the last call: this is done by glibc too
+    // and is cheap compared to the conversion itself.
+    const char* const tz = getenv("TZ");
+
+    const LocalZone* local = gs_lastLocal.load(std::memory_order_acquire);
+    if ( local && local->isSet == (tz != nullptr) &&
+            (!tz || local->tz == tz) )
+        return local->info;
+
+    ZoneTable& table = GetZoneTable();
+
+    const wxTimeZoneInfo* info;
+    {
+        wxCRIT_SECT_LOCKER(lock, table.cs);
+
+        for ( const auto& l : table.locals )
+        {
+            if ( l->isSet == (tz != nullptr) && (!tz || l->tz == tz) )
+            {
+                gs_lastLocal.store(l.get(), std::memory_order_release);
+                return l->info;
+            }
+        }
+    }
+
+    // Empty TZ means UTC, while its absence means using the system default.
+    if ( !tz )
+        info = Get("/etc/localtime");
+    else
+        info = Get(*tz ? tz : "UTC0");
+
+    wxCRIT_SECT_LOCKER(lock, table.cs);
+
+    LocalZone* const newLocal = new LocalZone;
+    newLocal->isSet = tz != nullptr;
+    if ( tz )
+        newLocal->tz = tz;
+    newLocal->info = info;
+    table.locals.push_back(std::unique_ptr<LocalZone>(newLocal));
+
+    gs_lastLocal.store(newLocal, std::memory_order_release);
+
+    return info;
+}
+
+/* static */
+const wxTimeZoneInfo* wxTimeZoneInfo::Get(const char* name)
+{
+    if ( *name == ':' )
+        name++;
+
+    ZoneTable& table = GetZoneTable();
+
+    wxCRIT_SECT_LOCKER(lock, table.cs);
+
+    const auto it = table.zones.find(name);
+    if ( it != table.zones.end() )
+        return it->second.get();
+
+    std::unique_ptr<wxTimeZoneInfo> info(new wxTimeZoneInfo);
+
+    // Use the same logic as glibc: check for the file first and only
+    // interpret the name as POSIX TZ string if there is no such file.
+    bool ok;
+    if ( *name == '/' )
+    {
+        ok = info->LoadFile(name);
+    }
+    else
+    {
+        const char* dir = getenv("TZDIR");
+        std::string path = dir && *dir ? dir : "/usr/share/zoneinfo";
+        path += '/';
+        path += name;
+
+        // Don't allow escaping from the zoneinfo directory.
+        ok = !strstr(name, "..") && info->LoadFile(path.c_str());
+    }
+
+    if ( !ok )
+    {
+        info.reset(new wxTimeZoneInfo);
+        ok = info->ParsePosixTZ(name);
+    }
+
+    // Remember the zone even if we failed to load it to avoid trying to do
+    // it again.
+    std::unique_ptr<wxTimeZoneInfo>& zone = table.zones[name];
+    if ( ok )
+        zone = std::move(info);
+
+    return zone.get();
+}
+
+bool wxTimeZoneInfo::LoadFile(const char* path)
+{
+    FILE* const fp = fopen(path, "rb");
+    if ( !fp )
+        return false;
+
+    std::vector<unsigned char> data;
+    unsigned char buf[4096];
+    size_t count;
+    while ( (count = fread(buf, 1, sizeof(buf), fp)) > 0 )
+    {
+        data.insert(data.end(), buf, buf + count);
+        if ( data.size() > MAX_FILE_SIZE )
+            break;
+    }
+
+    fclose(fp);
+
+    if ( data.size() > MAX_FILE_SIZE )
+        return false;
+
+    const unsigned char* p = data.data();
+    const unsigned char* const end = p + data.size();
+
+    TZifHeader header;
+    if ( !header.Read(p, end) )
+        return false;
+
+    // Skip the data using 32-bit times if 64-bit ones are available.
+    size_t timeSize = 4;
+    if ( header.version >= '2' )
+    {
+        p += TZifHeader::Size + header.GetDataSize(4);
+        if ( !header.Read(p, end) )
+            return false;
+
+        timeSize = 8;
+    }
+
+    // Leap seconds are not supported by wxDateTime and such zones are
+    // almost never used anyhow, so let the CRT deal with them.
+    if ( header.leapcnt )
+        return false;
+
+    p += TZifHeader::Size;
+    if ( end - p < header.GetDataSize(timeSize) )
+        return false;
+
+    m_transitions.resize(header.timecnt);
+    for ( wxInt64& t : m_transitions )
+    {
+        t = ReadInt(p, timeSize);
+        p += timeSize;
+    }
+
+    if ( !std::is_sorted(m_transitions.begin(), m_transitions.end()) )
+        return false;
+
+    m_transitionTypes.assign(p, p + header.timecnt);
+    p += header.timecnt;
+
+    for ( unsigned char type : m_transitionTypes )
+    {
+        if ( type >= header.typecnt )
+            return false;
+    }
+
+    m_types.resize(header.typecnt);
+    for ( TimeType& type : m_types )
+    {
+        type.offset = static_cast<long>(ReadInt(p, 4));
+        type.isDST = p[4] != 0;
+        type.abbr = p[5];
+        p += 6;
+
+        if ( static_cast<wxInt64>(type.abbr) >= header.charcnt ||
+                type.offset <= -MAX_OFFSET || type.offset >= MAX_OFFSET )
+            return false;
+    }
+
+    m_abbrs.assign(reinterpret_cast<const char*>(p), header.charcnt);
+    if ( m_abbrs.back() != '\0' )
+        return false;
+
+    p += header.charcnt + header.isstdcnt + header.isutcnt;
+
+    // Before the first transition, the first standard time type is used.
+    m_firstType = 0;
+    for ( size_t n = 0; n < m_types.size(); n++ )
+    {
+        if ( !m_types[n].isDST )
+        {
+            m_firstType = n;
+            break;
+        }
+    }
+
+    // Version 2+ files have the rule to use after the last transition in
+    // the footer.
+    if ( timeSize == 8 && p < end && *p == '\n' )
+    {
+        const unsigned char* const footer = ++p;
+        while ( p < end && *p != '\n' )
+            ++p;
+
+        if ( p < end && p != footer )
+        {
+            const std::string rule(footer, p);
+
+            // If the rule is invalid, just ignore it and continue using the
+            // last time type.
+            ParsePosixTZ(rule.c_str());
+        }
+    }
+
+    return true;
+}
+
+bool wxTimeZoneInfo::ParsePosixTZ(const char* s)
+{
+    std::string name;
+    if ( !ParseName(s, name) )
+        return false;
+
+    m_std.abbr = m_abbrs.length();
+    m_abbrs.append(name.c_str(), name.length() + 1);
+
+    // Note that the offsets in TZ strings are positive to the west of UTC.
+    long offset;
+    if ( !ParseTime(s, 24, &offset) )
+        return false;
+
+    m_std.offset = -offset;
+    m_std.isDST = false;
+
+    m_hasDST = *s != '\0';
+    if ( m_hasDST )
+    {
+        if ( !ParseName(s, name) )
+            return false;
+
+        m_dst.abbr = m_abbrs.length();
+        m_abbrs.append(name.c_str(), name.length() + 1);
+
+        m_dst.offset = m_std.offset + 3600;
+        m_dst.isDST = true;
+        if ( *s != ',' && *s != '\0' )
+        {
+            if ( !ParseTime(s, 24, &offset) )
+                return false;
+
+            m_dst.offset = -offset;
+        }
+
+        if ( *s == '\0' || (s[0] == ',' && s[1] == '\0') )
+            s = DEFAULT_RULES;
+
+        for ( Rule* rule : { &m_start, &m_end } )
+        {
+            if ( *s++ != ',' )
+                return false;
+
+            long n;
+            if ( *s == 'J' )
+            {
+                ++s;
+                rule->kind = Rule::Julian1;
+                if ( !ParseNumber(s, 365, &n) || n < 1 )
+                    return false;
+
+                rule->day = n;
+            }
+            else if ( *s == 'M' )
+            {
+                ++s;
+                rule->kind = Rule::MonthWeekDay;
+                if ( !ParseNumber(s, 12, &n) || n < 1 || *s++ != '.' )
+                    return false;
+
+                rule->month = n;
+
+                if ( !ParseNumber(s, 5, &n) || n < 1 || *s++ != '.' )
+                    return false;
+
+                rule->week = n;
+
+                if ( !ParseNumber(s, 6, &n) )
+                    return false;
+
+                rule->day = n;
+            }
+            else
+            {
+                rule->kind = Rule::Julian0;
+                if ( !ParseNumber(s, 365, &n) )
+                    return false;
+
+                rule->day = n;
+            }
+
+            rule->time = 2*3600;
+            if ( *s == '/' )
+            {
+                ++s;
+
+                // POSIX only allows hours up to 24 here but RFC 8536 extends
+                // the range and this is used by the real zones.
+                if ( !ParseTime(s, 167, &rule->time) )
+                    return false;
+            }
+        }
+    }
+
+    if ( *s != '\0' )
+        return false;
+
+    m_hasRule = true;
+
+    // Add the types for a zone defined by the TZ string only.
+    if ( m_types.empty() )
+    {
+        m_types.push_back(m_std);
+        if ( m_hasDST )
+            m_types.push_back(m_dst);
+    }
+
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// time types computation
+// ----------------------------------------------------------------------------
+
+void
+wxTimeZoneInfo::GetRuleChanges(wxInt64 year,
+                               wxInt64* start,
+                               wxInt64* end) const
+{
+    const wxInt64 yearStart = DaysFromCivil(year, 1, 1);
+
+    for ( int n = 0; n < 2; n++ )
+    {
+        const Rule& rule = n == 0 ? m_start : m_end;
+
+        wxInt64 day = yearStart;
+        switch ( rule.kind )
+        {
+            case Rule::Julian1:
+                day += rule.day - 1;
+                if ( rule.day >= 60 && IsLeapYear(year) )
+                    day++;
+                break;
+
+            case Rule::Julian0:
+                day += rule.day;
+                break;
+
+            case Rule::MonthWeekDay:
+                {
+                    const wxInt64 first = DaysFromCivil(year, rule.month, 1);
+                    const wxInt64 next = rule.month == 12
+                                            ? DaysFromCivil(year + 1, 1, 1)
+                                            : DaysFromCivil(year, rule.month + 1, 1);
+
+                    // 1970-01-01 was a Thursday.
+                    const int dow = static_cast<int>(((first + 4) % 7 + 7) % 7);
+
+                    day = first + (rule.day - dow + 7) % 7;
+                    for ( int week = 1; week < rule.week; week++ )
+                    {
+                        if ( day + 7 >= next )
+                            break;
+
+                        day += 7;
+                    }
+                }
+                break;
+        }
+
+        // The start time is given in the standard time and the end one in
+        // the daylight saving time.
+        const long offset = n == 0 ? m_std.offset : m_dst.offset;
+        const wxInt64 change = day * SECONDS_PER_DAY + rule.time - offset;
+
+        *(n == 0 ? start : end) = change;
+    }
+}
+
+const wxTimeZoneInfo::TimeType& wxTimeZoneInfo::GetTypeAt(wxInt64 t) const
+{
+    if ( m_transitions.empty() || t >= m_transitions.back() )
+    {
+        if ( m_hasRule )
+        {
+            if ( !m_hasDST )
+                return m_std;
+
+            // The rules are applied to the UTC year, as glibc does.
+            wxInt64 start, end;
+            GetRuleChanges(GetYearOf(t), &start, &end);
+
+            bool isDST;
+            if ( start > end ) // Southern hemisphere.
+                isDST = t < end || t >= start;
+            else
+                isDST = t >= start && t < end;
+
+            return isDST ? m_dst : m_std;
+        }
+
+        if ( !m_transitions.empty() )
+            return m_types[m_transitionTypes.back()];
+    }
+
+    if ( m_transitions.empty() || t < m_transitions.front() )
+        return m_types[m_firstType];
+
+    const size_t n = std::upper_bound(m_transitions.begin(),
+                                      m_transitions.end(),
+                                      t) - m_transitions.begin();
+
+    return m_types[m_transitionTypes[n - 1]];
+}
+
+bool wxTimeZoneInfo::GetNextChange(wxInt64 t, wxInt64* next) const
+{
+    if ( !m_transitions.empty() && t < m_transitions.back() )
+    {
+        *next = *std::upper_bound(m_transitions.begin(),
+                                  m_transitions.end(),
+                                  t);
+        return true;
+    }
+
+    if ( !m_hasRule || !m_hasDST )
+        return false;
+
+    bool found = false;
+
+    const wxInt64 year = GetYearOf(t);
+    for ( wxInt64 y = year; y <= year + 1; y++ )
+    {
+        wxInt64 changes[2];
+        GetRuleChanges(y, &changes[0], &changes[1]);
+
+        for ( wxInt64 change : changes )
+        {
+            if ( change > t && (!found || change < *next) )
+            {
+                *next = change;
+                found = true;
+            }
+        }
+    }
+
+    return found;
+}
+
+// ----------------------------------------------------------------------------
+// conversions
+// ----------------------------------------------------------------------------
+
+/* static */
+void wxTimeZoneInfo::BreakDown(wxInt64 t, long offset, struct tm& tm)
+{
+    t += offset;
+
+    const wxInt64 days = FloorDiv(t, SECONDS_PER_DAY);
+    const long secs = static_cast<long>(t - days * SECONDS_PER_DAY);
+
+    wxInt64 year;
+    int month, day;
+    CivilFromDays(days, &year, &month, &day);
+
+    memset(&tm, 0, sizeof(tm));
+
+    tm.tm_year = static_cast<int>(year - 1900);
+    tm.tm_mon = month - 1;
+    tm.tm_mday = day;
+    tm.tm_hour = secs / 3600;
+    tm.tm_min = (secs / 60) % 60;
+    tm.tm_sec = secs % 60;
+    tm.tm_wday = static_cast<int>(((days + 4) % 7 + 7) % 7);
+    tm.tm_yday = static_cast<int>(days - DaysFromCivil(year, 1, 1));
+    tm.tm_isdst = 0;
+    tm.tm_gmtoff = offset;
+    tm.tm_zone = const_cast<char*>("GMT");
+}
+
+void wxTimeZoneInfo::ToLocal(wxInt64 t, struct tm& tm) const
+{
+    const TimeType& type = GetTypeAt(t);
+
+    BreakDown(t, type.offset, tm);
+
+    tm.tm_isdst = type.isDST;
+    tm.tm_zone = const_cast<char*>(GetAbbr(type));
+}
+
+wxInt64 wxTimeZoneInfo::FromLocal(struct tm& tm) const
+{
+    // Compute the local time as if it were UTC, normalizing the month first
+    // as DaysFromCivil() doesn't handle out of range values.
+    const wxInt64 year = tm.tm_year + 1900 + FloorDiv(tm.tm_mon, 12);
+    const int month = static_cast<int>(tm.tm_mon - FloorDiv(tm.tm_mon, 12) * 12);
+
+    const wxInt64 local = (DaysFromCivil(year, month + 1, 1) + tm.tm_mday - 1)
+                            * SECONDS_PER_DAY +
+                          tm.tm_hour * wxInt64(3600) +
+                          tm.tm_min * wxInt64(60) +
+                          tm.tm_sec;
+
+    // Find all the UTC times corresponding to this local time by checking
+    // every interval using the same time type near it: there can be none if
+    // the local time is in the DST gap or two of them if it's ambiguous.
+    wxInt64 candidates[2];
+    const TimeType* candidateTypes[2];
+    size_t numCandidates = 0;
+
+    // The types used before and after the gap containing this time, if any.
+    const TimeType* gapBefore = nullptr;
+    const TimeType* gapAfter = nullptr;
+
+    const wxInt64 last = local + MAX_OFFSET;
+    wxInt64 from = local - MAX_OFFSET;
+    for ( int n = 0; n < 16; n++ )
+    {
+        const TimeType& type = GetTypeAt(from);
+
+        wxInt64 to;
+        if ( !GetNextChange(from, &to) || to > last )
+            to = last + 1;
+
+        const wxInt64 utc = local - type.offset;
+        if ( utc >= from && utc < to )
+        {
+            if ( numCandidates < WXSIZEOF(candidates) )
+            {
+                candidates[numCandidates] = utc;
+                candidateTypes[numCandidates] = &type;
+                numCandidates++;
+            }
+        }
+        else if ( utc >= to )
+        {
+            gapBefore = &type;
+            gapAfter = nullptr;
+        }
+        else if ( gapBefore && !gapAfter )
+        {
+            gapAfter = &type;
+        }
+
+        if ( to > last )
+            break;
+
+        from = to;
+    }
+
+    wxInt64 utc;
+    const TimeType* type;
+    switch ( numCandidates )
+    {
+        case 0:
+            // Use the offset from before the gap, which moves the time
+            // forward, unless the DST value used after it was requested.
+            type = gapBefore ? gapBefore : &GetTypeAt(local);
+            if ( tm.tm_isdst >= 0 && gapAfter &&
+                    type->isDST != (tm.tm_isdst > 0) &&
+                        gapAfter->isDST == (tm.tm_isdst > 0) )
+                type = gapAfter;
+
+            utc = local - type->offset;
+            break;
+
+        case 1:
+            utc = candidates[0];
+            type = candidateTypes[0];
+            break;
+
+        default:
+            {
+                // Prefer the standard time for the ambiguous times, as glibc
+                // usually does, unless DST is explicitly requested.
+                const size_t n = candidateTypes[0]->isDST == (tm.tm_isdst > 0)
+                                    ? 0 : 1;
+                utc = candidates[n];
+                type = candidateTypes[n];
+            }
+            break;
+    }
+
+    const bool wantDST = tm.tm_isdst > 0;
+    if ( tm.tm_isdst >= 0 && type->isDST != wantDST )
+    {
+        // The time doesn't use the requested DST value, so, as mktime() does,
+        // find the nearest time using it and use its offset, using the same
+        // step and search range as glibc to give the same results.
+        const wxInt64 STEP = 601200;
+        const wxInt64 MAX_DELTA = 457243200 / 2 + STEP;
+
+        bool found = false;
+        for ( wxInt64 delta = STEP; !found && delta < MAX_DELTA; delta += STEP )
+        {
+            for ( int dir = -1; dir <= 1; dir += 2 )
+            {
+                const TimeType& other = GetTypeAt(utc + dir * delta);
+                if ( other.isDST == wantDST )
+                {
+                    utc = local - other.offset;
+                    found = true;
+                    break;
+                }
+            }
+        }
+
+        // If there is no such time nearby, assume that DST is one hour ahead.
+        if ( !found )
+            utc += wantDST ? -3600 : 3600;
+    }
+
+    ToLocal(utc, tm);
+
+    return utc;
+}
+
+#endif // wxHAS_TIMEZONEINFO
@@ -64,6 +64,8 @@
 #include "wx/filename.h"
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include <pwd.h>
 #include <sys/wait.h>       // waitpid()
@@ -132,6 +134,17 @@
 #include <ctype.h>          // isspace()
 #include <sys/time.h>       // needed for FD_SETSIZE
 
+// posix_spawn() can be used instead of fork() in wxExecute() only if we can
+// close all the inherited descriptors in the child, which is possible since
+// glibc 2.34 providing posix_spawn_file_actions_addclosefrom_np().
+#if wxCHECK_GLIBC_VERSION(2, 34)
+    #define wxHAS_POSIX_SPAWN
+
+    #include <spawn.h>
+
+    extern char **environ;
+#endif // glibc 2.34+
+
 #ifdef HAVE_UNAME
     #include <sys/utsname.h> // for uname()
 #endif // HAVE_UNAME
@@ -589,6 +602,113 @@ int BlockUntilChildExit(wxExecuteData& execData)
 #endif // wxUSE_SELECT_DISPATCHER/!wxUSE_SELECT_DISPATCHER
 }
 
+#ifdef wxHAS_POSIX_SPAWN
+
+// Helper function of wxExecute(): launch the child process using
+// posix_spawnp() which is much faster than fork() for the processes using a
+// lot of memory, as it doesn't need to copy their page tables.
+//
+// Returns the PID of the child or -1 if it couldn't be launched in this way,
+// in which case fork() should be used instead.
+pid_t SpawnChild(const char* const* argv,
+                 int flags,
+                 const wxExecuteEnv* env,
+                 const wxPipe& pipeIn,
+                 const wxPipe& pipeOut,
+                 const wxPipe& pipeErr)
+{
+    // Prepare the new environment for the child, if necessary.
+    std::vector<std::string> envStrings;
+    std::vector<char*> envp;
+    if ( env && !env->env.empty() )
+    {
+        // posix_spawnp() looks for the program in our PATH and not in the
+        // PATH from the new environment as execvp() called after changing it
+        // in the child does, so don't use it if this would make a difference.
+        if ( !strchr(argv[0], '/') )
+        {
+            wxString path;
+            const bool hasPath = wxGetEnv("PATH", &path);
+
+            const auto it = env->env.find("PATH");
+            if ( it == env->env.end() ? hasPath
+                                      : !hasPath || it->second != path )
+                return -1;
+        }
+
+        for ( const auto& kv : env->env )
+        {
+            const wxString var = kv.first + '=' + kv.second;
+            envStrings.push_back(var.mb_str(wxConvWhateverWorks).data());
+        }
+
+        for ( auto& str : envStrings )
+            envp.push_back(&str[0]);
+
+        envp.push_back(nullptr);
+    }
+
+    posix_spawn_file_actions_t actions;
+    if ( posix_spawn_file_actions_init(&actions) != 0 )
+        return -1;
+
+    posix_spawnattr_t attr;
+    if ( posix_spawnattr_init(&attr) != 0 )
+    {
+        posix_spawn_file_actions_destroy(&actions);
+        return -1;
+    }
+
+    // Do the same things as are done in the child after fork() below.
+    bool ok = true;
+    if ( flags & wxEXEC_MAKE_GROUP_LEADER )
+        ok = posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSID) == 0;
+
+    if ( ok && pipeIn.IsOk() )
+    {
+        ok = posix_spawn_file_actions_adddup2(&actions, pipeIn[wxPipe::Read],
+                                              STDIN_FILENO) == 0 &&
+             posix_spawn_file_actions_adddup2(&actions, pipeOut[wxPipe::Write],
+                                              STDOUT_FILENO) == 0 &&
+             posix_spawn_file_actions_adddup2(&actions, pipeErr[wxPipe::Write],
+                                              STDERR_FILENO) == 0;
+    }
+
+    if ( ok )
+    {
+        ok = posix_spawn_file_actions_addclosefrom_np(&actions,
+                                                      STDERR_FILENO + 1) == 0;
+    }
+
+    if ( ok && env && !env->cwd.empty() )
+    {
+        ok = posix_spawn_file_actions_addchdir_np(&actions,
+                                                  env->cwd.fn_str()) == 0;
+    }
+
+    pid_t pid = -1;
+    if ( ok )
+    {
+        const int rc = posix_spawnp(&pid, argv[0], &actions, &attr,
+                                    const_cast<char**>(argv),
+                                    envp.empty() ? environ : envp.data());
+        if ( rc != 0 )
+        {
+            // Let the code using fork() report the error in the usual way.
+            wxLogTrace("exec", "posix_spawnp(\"%s\") failed: %s",
+                       argv[0], wxSysErrorMsgStr(rc));
+            pid = -1;
+        }
+    }
+
+    posix_spawnattr_destroy(&attr);
+    posix_spawn_file_actions_destroy(&actions);
+
+    return pid;
+}
+
+#endif // wxHAS_POSIX_SPAWN
+
 } // anonymous namespace
 
 // wxExecute: the real worker function
@@ -662,17 +782,25 @@ long wxExecute(const char* const* argv, int flags, wxProcess* process,
     else
         prio = (2*prio)/5 - 21;
 
-    // fork the process
-    //
-    // NB: do *not* use vfork() here, it completely breaks this code for some
-    //     reason under Solaris (and maybe others, although not under Linux)
-    //     But on OpenVMS we do not have fork so we have to use vfork and
-    //     cross our fingers that it works.
+#ifdef wxHAS_POSIX_SPAWN
+    // use posix_spawn() if possible: it can do everything we need except for
+    // changing the priority
+    pid = prio ? -1 : SpawnChild(argv, flags, env, pipeIn, pipeOut, pipeErr);
+    if ( pid == -1 )
+#endif // wxHAS_POSIX_SPAWN
+    {
+        // fork the process
+        //
+        // NB: do *not* use vfork() here, it completely breaks this code for
+        //     some reason under Solaris (and maybe others, although not
+        //     under Linux) But on OpenVMS we do not have fork so we have to
+        //     use vfork and cross our fingers that it works.
 #ifdef __VMS
-   pid = vfork();
+        pid = vfork();
 #else
-   pid = fork();
+        pid = fork();
 #endif
+    }
    if ( pid == -1 )     // error?
     {
         wxLogSysError( _("Fork failed") );
@@ -833,8 +961,18 @@ long wxExecute(const char* const* argv, int flags, wxProcess* process,
 
             if ( flags & wxEXEC_SYNC )
             {
-                execData.m_bufOut.Init(outStream);
-                execData.m_bufErr.Init(errStream);
+                if ( process->IsRedirectingLines() )
+                {
+                    execData.m_bufOut.InitLines(outStream, process,
+                                                &wxProcess::OnOutputLine);
+                    execData.m_bufErr.InitLines(errStream, process,
+                                                &wxProcess::OnErrorLine);
+                }
+                else
+                {
+                    execData.m_bufOut.Init(outStream);
+                    execData.m_bufErr.Init(errStream);
+                }
 
                 execData.m_fdOut = fdOut;
                 execData.m_fdErr = fdErr;
@@ -15,8 +15,11 @@
 #if wxUSE_STREAMS
 
 #include "archivetest.h"
+#include "wx/mstream.h"
 #include "wx/tarstrm.h"
 
+#include <memory>
+
 using std::string;
 
 
@@ -69,4 +72,218 @@ CppUnit::Test *tartest::makeTest(
 CPPUNIT_TEST_SUITE_REGISTRATION(tartest);
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(tartest, "archive/tar");
 
+
+///////////////////////////////////////////////////////////////////////////////
+// Sparse files, which can't be created by wxTarOutputStream, so construct
+// the archives by hand
+
+namespace
+{
+
+void PutOctal(string& block, size_t pos, size_t len, wxFileOffset n)
+{
+    // leave the last byte of the field as nul
+    for (size_t i = len - 1; i > 0; i--) {
+        block[pos + i - 1] = char('0' + (n & 7));
+        n >>= 3;
+    }
+}
+
+string MakeHeader(const string& name, char type, wxFileOffset size, bool gnu)
+{
+    string block(512, '\0');
+    block.replace(0, name.length(), name);
+    PutOctal(block, 100, 8, 0644);
+    PutOctal(block, 124, 12, size);
+    block[156] = type;
+    if (gnu)
+        block.replace(257, 8, "ustar  \0", 8);
+    else
+        block.replace(257, 8, "ustar\0" "00", 8);
+    return block;
+}
+
+string FinishHeader(string block)
+{
+    block.replace(148, 8, 8, ' ');
+    wxUint32 sum = 0;
+    for (size_t i = 0; i < block.length(); i++)
+        sum += (unsigned char)block[i];
+    PutOctal(block, 148, 8, sum);
+    return block;
+}
+
+string PadToBlock(string data)
+{
+    data.resize((data.length() + 511) / 512 * 512, '\0');
+    return data;
+}
+
+string PaxRecord(const string& key, const string& value)
+{
+    // the length includes the length field itself
+    const size_t len = key.length() + value.length() + 3;
+    const string lenStr = std::to_string(len);
+    return std::to_string(len + lenStr.length()) + " " + key + "=" + value + "\n";
+}
+
+// The contents of the sparse file used in the tests: a few data regions and
+// holes between and after them. Notice that GNU tar expects all regions but
+// the last one to be multiples of the block size.
+const wxFileOffset SPARSE_SIZE = 10000;
+
+const struct
+{
+    wxFileOffset offset;
+    wxFileOffset size;
+    char ch;
+} sparseRegions[] =
+{
+    {    0,  512, 'A' },
+    { 2048,  512, 'B' },
+    { 4096, 1024, 'C' },
+    { 6144,  512, 'D' },
+    { 8192,  100, 'E' },
+};
+
+string GetSparseData()
+{
+    string data(SPARSE_SIZE, '\0');
+    for (size_t i = 0; i < WXSIZEOF(sparseRegions); i++) {
+        data.replace(sparseRegions[i].offset, sparseRegions[i].size,
+                     sparseRegions[i].size, sparseRegions[i].ch);
+    }
+    return data;
+}
+
+string GetStoredData()
+{
+    string data;
+    for (size_t i = 0; i < WXSIZEOF(sparseRegions); i++)
+        data.append(sparseRegions[i].size, sparseRegions[i].ch);
+    return data;
+}
+
+// Add a normal file after the sparse one and the end of archive marker.
+string FinishArchive(const string& tar)
+{
+    return tar
+        + FinishHeader(MakeHeader("after.txt", '0', 5, false))
+        + PadToBlock("hello")
+        + string(1024, '\0');
+}
+
+string MakePaxSparseTar()
+{
+    string recs = PaxRecord("GNU.sparse.major", "1")
+                + PaxRecord("GNU.sparse.minor", "0")
+                + PaxRecord("GNU.sparse.name", "sparse.dat")
+                + PaxRecord("GNU.sparse.realsize", std::to_string(SPARSE_SIZE));
+
+    // as GNU tar does, terminate the map with an empty region at the end
+    string map = std::to_string(WXSIZEOF(sparseRegions) + 1) + "\n";
+    for (size_t i = 0; i < WXSIZEOF(sparseRegions); i++) {
+        map += std::to_string(sparseRegions[i].offset) + "\n"
+             + std::to_string(sparseRegions[i].size) + "\n";
+    }
+    map += std::to_string(SPARSE_SIZE) + "\n0\n";
+    map = PadToBlock(map);
+
+    const string data = GetStoredData();
+
+    return FinishArchive(
+        FinishHeader(MakeHeader("PaxHeaders/sparse.dat", 'x', recs.length(), false))
+        + PadToBlock(recs)
+        + FinishHeader(MakeHeader("GNUSparseFile.0/sparse.dat", '0',
+                                  map.length() + data.length(), false))
+        + map
+        + PadToBlock(data));
+}
+
+string MakeGnuSparseTar()
+{
+    const string data = GetStoredData();
+
+    // the header has space for 4 regions, the rest go in an extension block
+    string hdr = MakeHeader("sparse.dat", 'S', data.length(), true);
+    string ext(512, '\0');
+    for (size_t i = 0; i < WXSIZEOF(sparseRegions); i++) {
+        string& block = i < 4 ? hdr : ext;
+        size_t pos = i < 4 ? 386 + 24 * i : 24 * (i - 4);
+        PutOctal(block, pos, 12, sparseRegions[i].offset);
+        PutOctal(block, pos + 12, 12, sparseRegions[i].size);
+    }
+    PutOctal(ext, 24 * (WXSIZEOF(sparseRegions) - 4), 12, SPARSE_SIZE);
+    PutOctal(ext, 24 * (WXSIZEOF(sparseRegions) - 4) + 12, 12, 0);
+    hdr[482] = 1;
+    PutOctal(hdr, 483, 12, SPARSE_SIZE);
+
+    return FinishArchive(FinishHeader(hdr) + ext + PadToBlock(data));
+}
+
+void CheckSparseTar(const string& tar)
+{
+    wxMemoryInputStream in(tar.data(), tar.length());
+    wxTarInputStream arc(in);
+
+    std::unique_ptr<wxTarEntry> entry(arc.GetNextEntry());
+    REQUIRE( entry );
+    CHECK( entry->GetInternalName() == "sparse.dat" );
+    CHECK( entry->GetSize() == SPARSE_SIZE );
+    CHECK( entry->GetTypeFlag() == wxTAR_REGTYPE );
+    CHECK( entry->IsSparse() );
+
+    const string expected = GetSparseData();
+
+    SECTION("Read")
+    {
+        string data(SPARSE_SIZE, '?');
+        CHECK( arc.Read(&data[0], data.length()).LastRead() == data.length() );
+        CHECK( data == expected );
+    }
+
+    SECTION("Copy")
+    {
+        wxMemoryOutputStream out;
+        CHECK( arc.CopyEntryData(out) );
+        CHECK( arc.LastRead() == size_t(SPARSE_SIZE) );
+
+        string data(out.GetLength(), '?');
+        out.CopyTo(&data[0], data.length());
+        CHECK( data == expected );
+    }
+
+    SECTION("Seek")
+    {
+        char buf[20];
+        CHECK( arc.SeekI(5110) == 5110 );
+        CHECK( arc.Read(buf, sizeof(buf)).LastRead() == sizeof(buf) );
+        CHECK( string(buf, sizeof(buf)) == expected.substr(5110, sizeof(buf)) );
+
+        CHECK( arc.SeekI(2040) == 2040 );
+        CHECK( arc.Read(buf, sizeof(buf)).LastRead() == sizeof(buf) );
+        CHECK( string(buf, sizeof(buf)) == expected.substr(2040, sizeof(buf)) );
+    }
+
+    // the following entry must be found correctly whatever was read above
+    entry.reset(arc.GetNextEntry());
+    REQUIRE( entry );
+    CHECK( entry->GetInternalName() == "after.txt" );
+    CHECK( !entry->IsSparse() );
+
+    char buf[5];
+    CHECK( arc.Read(buf, sizeof(buf)).LastRead() == sizeof(buf) );
+    CHECK( string(buf, sizeof(buf)) == "hello" );
+
+    CHECK( !arc.GetNextEntry() );
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxTarInputStream::Sparse", "[archive][tar]")
+{
+    SECTION("PAX") { CheckSparseTar(MakePaxSparseTar()); }
+    SECTION("GNU") { CheckSparseTar(MakeGnuSparseTar()); }
+}
+
 #endif // wxUSE_STREAMS
@@ -65,6 +65,13 @@ public:
     // accessors
     int GetNumericParameter() const { return m_numParam; }
     const wxString& GetStringParameter() const { return m_strParam; }
+    void SetBytesPerRun(wxUint64 bytes) { m_bytesPerRun = bytes; }
+    void SetCallsPerRun(wxUint64 calls) { m_callsPerRun = calls; }
+    void SetAllocsPerRun(wxUint64 allocs)
+    {
+        m_allocsPerRun = allocs;
+        m_hasAllocsPerRun = true;
+    }
 
 private:
     // output the results of a single benchmark if successful or just return
@@ -80,6 +87,14 @@ private:
          m_runTime, // minimum time to run a single benchmark if m_numRuns == 0
          m_numParam;
     wxString m_strParam;
+
+    // amount of data processed by the currently running benchmark, if known
+    wxUint64 m_bytesPerRun;
+
+    // number of calls and allocations done by each run, if known
+    wxUint64 m_callsPerRun,
+             m_allocsPerRun;
+    bool m_hasAllocsPerRun;
 };
 
 wxIMPLEMENT_APP_CONSOLE(BenchApp);
@@ -102,6 +117,21 @@ wxString Bench::GetStringParameter(const wxString& defVal)
     return !val.empty() ? val : defVal;
 }
 
+void Bench::SetBytesPerRun(wxUint64 bytes)
+{
+    wxGetApp().SetBytesPerRun(bytes);
+}
+
+void Bench::SetCallsPerRun(wxUint64 calls)
+{
+    wxGetApp().SetCallsPerRun(calls);
+}
+
+void Bench::SetAllocsPerRun(wxUint64 allocs)
+{
+    wxGetApp().SetAllocsPerRun(allocs);
+}
+
 // ============================================================================
 // BenchApp implementation
 // ============================================================================
@@ -111,6 +141,10 @@ BenchApp::BenchApp()
     m_numRuns = 0; // this means to use m_runTime
     m_runTime = 500; // default minimum
     m_numParam = 0;
+    m_bytesPerRun = 0;
+    m_callsPerRun = 0;
+    m_allocsPerRun = 0;
+    m_hasAllocsPerRun = false;
 }
 
 bool BenchApp::OnInit()
@@ -282,6 +316,11 @@ int BenchApp::OnRun()
 
 bool BenchApp::RunSingleBenchmark(Bench::Function* func)
 {
+    m_bytesPerRun = 0;
+    m_callsPerRun = 0;
+    m_allocsPerRun = 0;
+    m_hasAllocsPerRun = false;
+
     if ( !func->Init() )
         return false;
 
@@ -349,7 +388,7 @@ bool BenchApp::RunSingleBenchmark(Bench::Function* func)
     // much sense.
     if ( n == 1 )
     {
-        wxPrintf("single run took %.0fus\n", m);
+        wxPrintf("single run took %.0fus", m);
     }
     else
     {
@@ -357,11 +396,35 @@ bool BenchApp::RunSingleBenchmark(Bench::Function* func)
 
         wxPrintf
         (
-            "%12ld runs, %.0fus avg, %.0f std dev (%.0f/%.0f min/max)\n",
+            "%12ld runs, %.0fus avg, %.0f std dev (%.0f/%.0f min/max)",
             n, m, s, timeMin, timeMax
         );
     }
 
+    // Show the throughput if the benchmark told us how much data it handles.
+    if ( m_bytesPerRun && m > 0 )
+    {
+        // Bytes per microsecond is the same as MB/s, divide to get GB/s.
+        wxPrintf(", %.3f GB/s", static_cast<double>(m_bytesPerRun) / m / 1000);
+    }
+
+    // And the time of a single call if it told us how many calls it does.
+    if ( m_callsPerRun )
+    {
+        const double calls = static_cast<double>(m_callsPerRun);
+        wxPrintf(", %.1fns/call", m * 1000 / calls);
+
+        // Also show the number of calls per second, which is more readable
+        // for the benchmarks doing many cheap operations.
+        if ( m > 0 )
+            wxPrintf(" (%.0f/s)", calls * 1000000 / m);
+
+        if ( m_hasAllocsPerRun )
+            wxPrintf(", %.2f allocs/call", m_allocsPerRun / calls);
+    }
+
+    wxPrintf("\n");
+
     fflush(stdout);
 
     return true;
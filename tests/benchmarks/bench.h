@@ -93,6 +93,32 @@ long GetNumericParameter(long defValue = 1);
  */
 wxString GetStringParameter(const wxString& defValue = wxString());
 
+/**
+    Set the amount of data processed by a single run of the benchmark.
+
+    Benchmarks measuring throughput can call this function from their body to
+    make the benchmarking program show the processing speed in addition to the
+    time taken by each run.
+ */
+void SetBytesPerRun(wxUint64 bytes);
+
+/**
+    Set the number of calls done by a single run of the benchmark.
+
+    Benchmarks repeating the same operation many times during each run can
+    call this function to make the benchmarking program show the time taken
+    by a single call.
+ */
+void SetCallsPerRun(wxUint64 calls);
+
+/**
+    Set the number of memory allocations done by a single run.
+
+    This is only useful together with SetCallsPerRun() and makes the
+    benchmarking program show the number of allocations per call.
+ */
+void SetAllocsPerRun(wxUint64 allocs);
+
 } // namespace Bench
 
 /**
@@ -17,3 +17,148 @@ BENCHMARK_FUNC(ParseDate)
     return dt.ParseDate("May 23, 2011") && dt.GetMonth() == wxDateTime::May;
 }
 
+
+namespace
+{
+
+const char* const FORMAT_DATE_TIME = "%Y-%m-%d %H:%M:%S";
+
+// Number of dates formatted or parsed during each benchmark iteration.
+const unsigned NUM_DATES = 1000;
+
+wxDateTime GetTestDate(unsigned n)
+{
+    return wxDateTime(23, wxDateTime::May, 2011, 12, 34, 56) + wxTimeSpan::Minutes(n*97);
+}
+
+std::vector<wxString> GetTestStrings()
+{
+    std::vector<wxString> strings;
+    for ( unsigned n = 0; n < NUM_DATES; n++ )
+        strings.push_back(GetTestDate(n).Format(FORMAT_DATE_TIME));
+
+    return strings;
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(FormatDateTime)
+{
+    size_t len = 0;
+    for ( unsigned n = 0; n < NUM_DATES; n++ )
+        len += GetTestDate(n).Format(FORMAT_DATE_TIME).length();
+
+    return len == NUM_DATES*19;
+}
+
+BENCHMARK_FUNC(FormatDateTimeFormatter)
+{
+    static const wxDateTimeFormatter formatter(FORMAT_DATE_TIME);
+
+    wxString s;
+    size_t len = 0;
+    for ( unsigned n = 0; n < NUM_DATES; n++ )
+    {
+        s.clear();
+        formatter.FormatTo(s, GetTestDate(n));
+        len += s.length();
+    }
+
+    return len == NUM_DATES*19;
+}
+
+BENCHMARK_FUNC(FormatDateTimeMillis)
+{
+    size_t len = 0;
+    for ( unsigned n = 0; n < NUM_DATES; n++ )
+        len += GetTestDate(n).Format("%H:%M:%S.%l").length();
+
+    return len == NUM_DATES*12;
+}
+
+BENCHMARK_FUNC(FormatDateTimeMillisFormatter)
+{
+    static const wxDateTimeFormatter formatter("%H:%M:%S.%l");
+
+    wxString s;
+    size_t len = 0;
+    for ( unsigned n = 0; n < NUM_DATES; n++ )
+    {
+        s.clear();
+        formatter.FormatTo(s, GetTestDate(n));
+        len += s.length();
+    }
+
+    return len == NUM_DATES*12;
+}
+
+BENCHMARK_FUNC(ParseFormat)
+{
+    static const std::vector<wxString> strings = GetTestStrings();
+
+    bool ok = true;
+    for ( unsigned n = 0; n < NUM_DATES; n++ )
+    {
+        wxDateTime dt;
+        wxString::const_iterator end;
+        if ( !dt.ParseFormat(strings[n], FORMAT_DATE_TIME, &end) )
+            ok = false;
+    }
+
+    return ok;
+}
+
+BENCHMARK_FUNC(ParseFormatFormatter)
+{
+    static const std::vector<wxString> strings = GetTestStrings();
+    static const wxDateTimeFormatter formatter(FORMAT_DATE_TIME);
+
+    bool ok = true;
+    for ( unsigned n = 0; n < NUM_DATES; n++ )
+    {
+        wxDateTime dt;
+        if ( !formatter.Parse(strings[n], &dt) )
+            ok = false;
+    }
+
+    return ok;
+}
+
+BENCHMARK_FUNC(ParseFormatFormatterAll)
+{
+    static const std::vector<wxString> strings = GetTestStrings();
+    static const wxDateTimeFormatter formatter(FORMAT_DATE_TIME);
+
+    std::vector<wxDateTime> dates;
+    return formatter.ParseAll(strings, dates) == NUM_DATES;
+}
+
+// Typical use of the broken down date components.
+BENCHMARK_FUNC(GetDateFields)
+{
+    long sum = 0;
+    for ( unsigned n = 0; n < NUM_DATES; n++ )
+    {
+        const wxDateTime dt = GetTestDate(n);
+        sum += dt.GetYear() + dt.GetMonth() + dt.GetDay() +
+               dt.GetHour() + dt.GetMinute() + dt.GetSecond();
+    }
+
+    return sum > 0;
+}
+
+// Construct the dates from their components, which needs to convert local
+// time to UTC.
+BENCHMARK_FUNC(SetDateFields)
+{
+    bool ok = true;
+    for ( unsigned n = 0; n < NUM_DATES; n++ )
+    {
+        const wxDateTime dt(1 + n % 28, wxDateTime::Month(n % 12), 2000 + n % 30,
+                            n % 24, n % 60, n % 60);
+        if ( !dt.IsValid() )
+            ok = false;
+    }
+
+    return ok;
+}
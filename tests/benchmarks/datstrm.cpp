@@ -0,0 +1,156 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/datstrm.cpp
+// Purpose:     wxDataInputStream and wxDataOutputStream benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/datstrm.h"
+#include "wx/mstream.h"
+
+#include "bench.h"
+
+#include <vector>
+
+namespace
+{
+
+// Number of values processed by each benchmark, can be changed by using the
+// numeric parameter.
+size_t GetCount()
+{
+    return Bench::GetNumericParameter(1000000);
+}
+
+std::vector<double> gs_doubles;
+std::vector<wxUint32> gs_ints;
+
+// Serialized representation of the arrays above in both byte orders.
+wxMemoryOutputStream* gs_dataLE = nullptr;
+wxMemoryOutputStream* gs_dataBE = nullptr;
+
+// Serialize all the test data using the given byte order.
+wxMemoryOutputStream* CreateData(bool bigEndian)
+{
+    wxMemoryOutputStream* const mos = new wxMemoryOutputStream;
+
+    wxDataOutputStream ds(*mos);
+    ds.UseBasicPrecisions();
+    ds.BigEndianOrdered(bigEndian);
+    ds.WriteDouble(&gs_doubles[0], gs_doubles.size());
+    ds.Write32(&gs_ints[0], gs_ints.size());
+
+    return mos;
+}
+
+bool InitData()
+{
+    const size_t count = GetCount();
+
+    gs_doubles.resize(count);
+    gs_ints.resize(count);
+    for ( size_t n = 0; n < count; n++ )
+    {
+        gs_doubles[n] = static_cast<double>(n) / 3;
+        gs_ints[n] = static_cast<wxUint32>(n);
+    }
+
+    gs_dataLE = CreateData(false);
+    gs_dataBE = CreateData(true);
+
+    return true;
+}
+
+void DoneData()
+{
+    delete gs_dataLE;
+    gs_dataLE = nullptr;
+
+    delete gs_dataBE;
+    gs_dataBE = nullptr;
+
+    gs_doubles.clear();
+    gs_ints.clear();
+}
+
+bool WriteDoubles(bool bigEndian)
+{
+    Bench::SetBytesPerRun(gs_doubles.size() * sizeof(double));
+
+    wxMemoryOutputStream mos;
+    wxDataOutputStream ds(mos);
+    ds.UseBasicPrecisions();
+    ds.BigEndianOrdered(bigEndian);
+    ds.WriteDouble(&gs_doubles[0], gs_doubles.size());
+
+    return ds.IsOk();
+}
+
+bool ReadDoubles(const wxMemoryOutputStream& data, bool bigEndian)
+{
+    Bench::SetBytesPerRun(gs_doubles.size() * sizeof(double));
+
+    wxMemoryInputStream mis(data.GetOutputStreamBuffer()->GetBufferStart(),
+                            data.GetLength());
+    wxDataInputStream ds(mis);
+    ds.UseBasicPrecisions();
+    ds.BigEndianOrdered(bigEndian);
+
+    std::vector<double> values(gs_doubles.size());
+    ds.ReadDouble(&values[0], values.size());
+
+    return values.back() == gs_doubles.back();
+}
+
+bool ReadInts(const wxMemoryOutputStream& data, bool bigEndian)
+{
+    Bench::SetBytesPerRun(gs_ints.size() * sizeof(wxUint32));
+
+    wxMemoryInputStream mis(data.GetOutputStreamBuffer()->GetBufferStart(),
+                            data.GetLength());
+
+    // Skip the doubles stored before the integers.
+    mis.SeekI(gs_doubles.size() * sizeof(double));
+
+    wxDataInputStream ds(mis);
+    ds.BigEndianOrdered(bigEndian);
+
+    std::vector<wxUint32> values(gs_ints.size());
+    ds.Read32(&values[0], values.size());
+
+    return values.back() == gs_ints.back();
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC_WITH_INIT(DataStreamWriteDoubleLE, InitData, DoneData)
+{
+    return WriteDoubles(false);
+}
+
+BENCHMARK_FUNC_WITH_INIT(DataStreamWriteDoubleBE, InitData, DoneData)
+{
+    return WriteDoubles(true);
+}
+
+BENCHMARK_FUNC_WITH_INIT(DataStreamReadDoubleLE, InitData, DoneData)
+{
+    return ReadDoubles(*gs_dataLE, false);
+}
+
+BENCHMARK_FUNC_WITH_INIT(DataStreamReadDoubleBE, InitData, DoneData)
+{
+    return ReadDoubles(*gs_dataBE, true);
+}
+
+BENCHMARK_FUNC_WITH_INIT(DataStreamRead32LE, InitData, DoneData)
+{
+    return ReadInts(*gs_dataLE, false);
+}
+
+BENCHMARK_FUNC_WITH_INIT(DataStreamRead32BE, InitData, DoneData)
+{
+    return ReadInts(*gs_dataBE, true);
+}
@@ -0,0 +1,90 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/dcsvg.cpp
+// Purpose:     wxSVGFileDC benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/defs.h"
+
+#if wxUSE_SVG
+
+#include "wx/dcsvg.h"
+#include "wx/filename.h"
+#include "wx/math.h"
+#include "wx/pen.h"
+
+#include "bench.h"
+
+#include <vector>
+
+namespace
+{
+
+const int PLOT_WIDTH = 1000;
+const int PLOT_HEIGHT = 500;
+
+wxString gs_svgFile;
+
+// Points of the plot exported by the benchmarks.
+std::vector<wxPoint> gs_plot;
+
+bool InitPlot()
+{
+    gs_svgFile = wxFileName::CreateTempFileName("wxbench_svg");
+    if ( gs_svgFile.empty() )
+        return false;
+
+    const long numPoints = Bench::GetNumericParameter(1000000);
+    gs_plot.reserve(numPoints);
+    for ( long n = 0; n < numPoints; n++ )
+    {
+        const double x = static_cast<double>(n) / numPoints;
+        gs_plot.push_back(wxPoint(wxRound(x*PLOT_WIDTH*10),
+                                  wxRound((sin(x*1000) + 1)*PLOT_HEIGHT*5)));
+    }
+
+    return true;
+}
+
+void DonePlot()
+{
+    std::vector<wxPoint>().swap(gs_plot);
+
+    wxRemoveFile(gs_svgFile);
+}
+
+} // anonymous namespace
+
+// Export the plot as separate segments, as done by the code drawing the
+// segments in different colours or skipping some of them.
+BENCHMARK_FUNC_WITH_INIT(SVGExportLines, InitPlot, DonePlot)
+{
+    wxSVGFileDC dc(gs_svgFile, PLOT_WIDTH, PLOT_HEIGHT);
+    dc.SetUserScale(0.1, 0.1);
+    dc.SetPen(*wxBLUE_PEN);
+
+    for ( size_t n = 1; n < gs_plot.size(); n++ )
+        dc.DrawLine(gs_plot[n - 1], gs_plot[n]);
+
+    Bench::SetCallsPerRun(gs_plot.size() - 1);
+
+    return dc.IsOk();
+}
+
+BENCHMARK_FUNC_WITH_INIT(SVGExportPolyline, InitPlot, DonePlot)
+{
+    wxSVGFileDC dc(gs_svgFile, PLOT_WIDTH, PLOT_HEIGHT);
+    dc.SetUserScale(0.1, 0.1);
+    dc.SetPen(*wxBLUE_PEN);
+
+    dc.DrawLines(static_cast<int>(gs_plot.size()), &gs_plot[0]);
+
+    Bench::SetCallsPerRun(gs_plot.size());
+
+    return dc.IsOk();
+}
+
+#endif // wxUSE_SVG
@@ -0,0 +1,116 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/dir.cpp
+// Purpose:     wxDir traversal benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/arrstr.h"
+#include "wx/crt.h"
+#include "wx/dir.h"
+#include "wx/file.h"
+#include "wx/filename.h"
+#include "wx/utils.h"
+
+#include "bench.h"
+
+namespace
+{
+
+// Number of files in each directory of the test tree.
+const long FILES_PER_DIR = 100;
+
+// Number of subdirectories of each directory of the test tree.
+const long DIRS_PER_DIR = 10;
+
+wxString gs_root;
+
+long GetNumFiles()
+{
+    return Bench::GetNumericParameter(100000);
+}
+
+// Create a tree with the given number of files, FILES_PER_DIR in each
+// directory, with each directory having DIRS_PER_DIR subdirectories.
+bool InitTree()
+{
+    gs_root = wxFileName::GetTempDir() +
+                wxString::Format("/wxbench_dir_%lu", wxGetProcessId());
+
+    const long numDirs = (GetNumFiles() + FILES_PER_DIR - 1) / FILES_PER_DIR;
+
+    // The path of each directory is stored to create its subdirectories.
+    wxArrayString dirs;
+    dirs.reserve(numDirs);
+    dirs.push_back(gs_root);
+
+    for ( long n = 0; n < numDirs; n++ )
+    {
+        if ( n > 0 )
+        {
+            dirs.push_back(wxString::Format("%s/dir%ld",
+                                            dirs[(n - 1) / DIRS_PER_DIR], n));
+        }
+
+        if ( !wxFileName::Mkdir(dirs[n], wxS_DIR_DEFAULT) )
+        {
+            wxFprintf(stderr, "Failed to create directory \"%s\".\n", dirs[n]);
+            return false;
+        }
+
+        for ( long i = 0; i < FILES_PER_DIR; i++ )
+        {
+            wxFile file;
+            if ( !file.Create(wxString::Format("%s/file%ld.txt", dirs[n], i)) )
+                return false;
+        }
+    }
+
+    return true;
+}
+
+void DoneTree()
+{
+    wxFileName::Rmdir(gs_root, wxPATH_RMDIR_RECURSIVE);
+}
+
+bool GetAllFiles(int flags, const wxString& filespec = wxString())
+{
+    wxArrayString files;
+    const size_t numFiles = wxDir::GetAllFiles(gs_root, &files, filespec,
+                                               wxDIR_DEFAULT | flags);
+
+    Bench::SetCallsPerRun(numFiles);
+
+    return numFiles == static_cast<size_t>(GetNumFiles());
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC_WITH_INIT(DirGetAllFiles, InitTree, DoneTree)
+{
+    return GetAllFiles(0);
+}
+
+// Using the file specification requires checking the type of all entries.
+BENCHMARK_FUNC_WITH_INIT(DirGetAllFilesSpec, InitTree, DoneTree)
+{
+    return GetAllFiles(0, "*.txt");
+}
+
+BENCHMARK_FUNC_WITH_INIT(DirGetAllFilesNoFollow, InitTree, DoneTree)
+{
+    return GetAllFiles(wxDIR_NO_FOLLOW);
+}
+
+BENCHMARK_FUNC_WITH_INIT(DirGetAllFilesParallel, InitTree, DoneTree)
+{
+    return GetAllFiles(wxDIR_PARALLEL);
+}
+
+BENCHMARK_FUNC_WITH_INIT(DirGetAllFilesUnordered, InitTree, DoneTree)
+{
+    return GetAllFiles(wxDIR_PARALLEL | wxDIR_UNORDERED);
+}
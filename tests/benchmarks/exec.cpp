@@ -0,0 +1,138 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/exec.cpp
+// Purpose:     wxExecute() benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/defs.h"
+
+#ifdef __UNIX__
+
+#include "wx/process.h"
+#include "wx/utils.h"
+
+#include "bench.h"
+
+#include <vector>
+
+namespace
+{
+
+// Size of the memory used by the benchmarks emulating a big application.
+const size_t BIG_HEAP_SIZE = 512*1024*1024;
+
+const char* const TRUE_ARGV[] = { "true", nullptr };
+
+std::vector<char> gs_heap;
+
+bool InitBigHeap()
+{
+    // Fill the memory to ensure that it's really allocated.
+    gs_heap.assign(BIG_HEAP_SIZE, 'x');
+
+    return true;
+}
+
+void DoneBigHeap()
+{
+    std::vector<char>().swap(gs_heap);
+}
+
+// Execute the given number of short-lived processes.
+bool ExecuteMany(wxProcess* process = nullptr)
+{
+    const long numProcesses = Bench::GetNumericParameter(1000);
+    for ( long n = 0; n < numProcesses; n++ )
+    {
+        if ( wxExecute(TRUE_ARGV, wxEXEC_BLOCK, process) != 0 )
+            return false;
+    }
+
+    Bench::SetCallsPerRun(numProcesses);
+
+    return true;
+}
+
+// Same as ExecuteMany() but forces the use of fork(), as posix_spawn() can't
+// be used when the priority of the child process needs to be changed.
+bool ExecuteManyFork()
+{
+    wxProcess process;
+    process.SetPriority(wxPRIORITY_DEFAULT + 10);
+
+    return ExecuteMany(&process);
+}
+
+// Process just counting the lines of its output.
+class LineCounter : public wxProcess
+{
+public:
+    LineCounter()
+    {
+        RedirectLines();
+    }
+
+    virtual void OnOutputLine(const wxString& WXUNUSED(line)) override
+    {
+        m_numLines++;
+    }
+
+    long m_numLines = 0;
+};
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(ExecuteTrue)
+{
+    return ExecuteMany();
+}
+
+BENCHMARK_FUNC(ExecuteTrueFork)
+{
+    return ExecuteManyFork();
+}
+
+// The time taken by fork() grows with the size of the parent process memory,
+// unlike that taken by posix_spawn().
+BENCHMARK_FUNC_WITH_INIT(ExecuteTrueBigHeap, InitBigHeap, DoneBigHeap)
+{
+    return ExecuteMany();
+}
+
+BENCHMARK_FUNC_WITH_INIT(ExecuteTrueForkBigHeap, InitBigHeap, DoneBigHeap)
+{
+    return ExecuteManyFork();
+}
+
+BENCHMARK_FUNC(ExecuteLines)
+{
+    const long numLines = Bench::GetNumericParameter(100000);
+
+    LineCounter process;
+    if ( wxExecute(wxString::Format("seq %ld", numLines),
+                   wxEXEC_BLOCK, &process) != 0 )
+        return false;
+
+    Bench::SetCallsPerRun(numLines);
+
+    return process.m_numLines == numLines;
+}
+
+BENCHMARK_FUNC(ExecuteLinesArray)
+{
+    const long numLines = Bench::GetNumericParameter(100000);
+
+    wxArrayString output;
+    if ( wxExecute(wxString::Format("seq %ld", numLines),
+                   output, wxEXEC_NOEVENTS) != 0 )
+        return false;
+
+    Bench::SetCallsPerRun(numLines);
+
+    return output.size() == static_cast<size_t>(numLines);
+}
+
+#endif // __UNIX__
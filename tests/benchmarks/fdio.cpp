@@ -0,0 +1,237 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/fdio.cpp
+// Purpose:     wxFDIODispatcher benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/defs.h"
+
+#ifdef __UNIX__
+
+#include "wx/private/fdiohandler.h"
+#include "wx/private/selectdispatcher.h"
+#include "wx/unix/private/epolldispatcher.h"
+#include "wx/unix/private/iouringdispatcher.h"
+
+#include "bench.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+// Every run of the benchmarks writes to one of this many pipes.
+const unsigned PIPES_STEP = 4;
+
+// Handler reading the byte written into the pipe.
+class PipeHandler : public wxFDIOHandler
+{
+public:
+    explicit PipeHandler(int fd) : m_fd(fd) { }
+
+    virtual void OnReadWaiting() override
+    {
+        char ch;
+        if ( read(m_fd, &ch, 1) == 1 )
+            ms_numRead++;
+    }
+
+    virtual void OnWriteWaiting() override { }
+    virtual void OnExceptionWaiting() override { }
+
+    static unsigned ms_numRead;
+
+private:
+    const int m_fd;
+};
+
+unsigned PipeHandler::ms_numRead = 0;
+
+struct Pipe
+{
+    int fdRead;
+    int fdWrite;
+    std::unique_ptr<PipeHandler> handler;
+};
+
+std::vector<Pipe> gs_pipes;
+wxFDIODispatcher* gs_dispatcher = nullptr;
+unsigned gs_run = 0;
+
+void DonePipes()
+{
+    for ( Pipe& p : gs_pipes )
+    {
+        if ( gs_dispatcher )
+            gs_dispatcher->UnregisterFD(p.fdRead);
+
+        close(p.fdRead);
+        close(p.fdWrite);
+    }
+
+    gs_pipes.clear();
+
+    delete gs_dispatcher;
+    gs_dispatcher = nullptr;
+}
+
+bool InitPipes(wxFDIODispatcher* dispatcher)
+{
+    if ( !dispatcher )
+        return false;
+
+    gs_dispatcher = dispatcher;
+    gs_run = 0;
+
+    // The number of pipes can be changed using the numeric parameter, but
+    // notice that wxSelectDispatcher only supports descriptors smaller than
+    // FD_SETSIZE.
+    const long numPipes = Bench::GetNumericParameter(400);
+    for ( long n = 0; n < numPipes; n++ )
+    {
+        int fds[2];
+        if ( pipe(fds) != 0 )
+        {
+            perror("pipe");
+            DonePipes();
+            return false;
+        }
+
+        fcntl(fds[0], F_SETFL, O_NONBLOCK);
+
+        Pipe p;
+        p.fdRead = fds[0];
+        p.fdWrite = fds[1];
+        p.handler.reset(new PipeHandler(p.fdRead));
+        gs_pipes.push_back(std::move(p));
+
+        if ( !dispatcher->RegisterFD(fds[0], gs_pipes.back().handler.get(),
+                                     wxFDIO_INPUT) )
+        {
+            DonePipes();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Write a byte to every PIPES_STEP-th pipe, using different pipes during
+// subsequent runs, and dispatch the events until all of them are read.
+bool DispatchEvents()
+{
+    const unsigned start = gs_run++ % PIPES_STEP;
+
+    unsigned numWritten = 0;
+    for ( size_t n = start; n < gs_pipes.size(); n += PIPES_STEP )
+    {
+        if ( write(gs_pipes[n].fdWrite, "x", 1) != 1 )
+            return false;
+
+        numWritten++;
+    }
+
+    Bench::SetCallsPerRun(numWritten);
+
+    PipeHandler::ms_numRead = 0;
+    while ( PipeHandler::ms_numRead < numWritten )
+    {
+        if ( gs_dispatcher->Dispatch() <= 0 )
+            return false;
+    }
+
+    return PipeHandler::ms_numRead == numWritten;
+}
+
+// Change the events all pipes are registered for and dispatch the events once,
+// which is what happens when many sockets start and stop waiting for output.
+bool ModifyAll()
+{
+    const int flags = gs_run++ % 2 ? wxFDIO_INPUT : wxFDIO_INPUT | wxFDIO_OUTPUT;
+
+    for ( const Pipe& p : gs_pipes )
+    {
+        if ( !gs_dispatcher->ModifyFD(p.fdRead, p.handler.get(), flags) )
+            return false;
+    }
+
+    Bench::SetCallsPerRun(gs_pipes.size());
+
+    return gs_dispatcher->Dispatch(0) == 0;
+}
+
+#if wxUSE_SELECT_DISPATCHER
+bool InitSelect()
+{
+    return InitPipes(new wxSelectDispatcher());
+}
+#endif // wxUSE_SELECT_DISPATCHER
+
+#if wxUSE_EPOLL_DISPATCHER
+bool InitEpoll()
+{
+    return InitPipes(wxEpollDispatcher::Create());
+}
+
+#ifdef wxHAS_IO_URING
+bool InitIoUring()
+{
+    wxFDIODispatcher* const dispatcher = wxIoUringDispatcher::Create();
+    if ( !dispatcher )
+    {
+        fprintf(stderr, "io_uring is not available.\n");
+        return false;
+    }
+
+    return InitPipes(dispatcher);
+}
+#endif // wxHAS_IO_URING
+#endif // wxUSE_EPOLL_DISPATCHER
+
+} // anonymous namespace
+
+#if wxUSE_SELECT_DISPATCHER
+BENCHMARK_FUNC_WITH_INIT(FDIODispatchSelect, InitSelect, DonePipes)
+{
+    return DispatchEvents();
+}
+
+BENCHMARK_FUNC_WITH_INIT(FDIOModifySelect, InitSelect, DonePipes)
+{
+    return ModifyAll();
+}
+#endif // wxUSE_SELECT_DISPATCHER
+
+#if wxUSE_EPOLL_DISPATCHER
+BENCHMARK_FUNC_WITH_INIT(FDIODispatchEpoll, InitEpoll, DonePipes)
+{
+    return DispatchEvents();
+}
+
+BENCHMARK_FUNC_WITH_INIT(FDIOModifyEpoll, InitEpoll, DonePipes)
+{
+    return ModifyAll();
+}
+
+#ifdef wxHAS_IO_URING
+BENCHMARK_FUNC_WITH_INIT(FDIODispatchIoUring, InitIoUring, DonePipes)
+{
+    return DispatchEvents();
+}
+
+BENCHMARK_FUNC_WITH_INIT(FDIOModifyIoUring, InitIoUring, DonePipes)
+{
+    return ModifyAll();
+}
+#endif // wxHAS_IO_URING
+#endif // wxUSE_EPOLL_DISPATCHER
+
+#endif // __UNIX__
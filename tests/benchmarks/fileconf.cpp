@@ -0,0 +1,172 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/fileconf.cpp
+// Purpose:     wxFileConfig benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/fileconf.h"
+#include "wx/ffile.h"
+#include "wx/filename.h"
+
+#include "bench.h"
+
+namespace
+{
+
+// Number of entries in each group of the test file.
+const unsigned ENTRIES_PER_GROUP = 10;
+
+wxString gs_filename;
+unsigned gs_numGroups = 0;
+
+wxFileConfig* gs_config = nullptr;
+
+wxString GetKey(unsigned group, unsigned entry)
+{
+    return wxString::Format("/Group%u/Sub/Entry%u", group, entry);
+}
+
+bool InitFile()
+{
+    gs_filename = wxFileName::CreateTempFileName("benchfileconf");
+    if ( gs_filename.empty() )
+        return false;
+
+    // The total number of entries can be changed using the numeric parameter.
+    gs_numGroups = Bench::GetNumericParameter(50000) / ENTRIES_PER_GROUP;
+
+    wxString text;
+    for ( unsigned group = 0; group < gs_numGroups; group++ )
+    {
+        text += wxString::Format("[Group%u/Sub]\n", group);
+        for ( unsigned entry = 0; entry < ENTRIES_PER_GROUP; entry++ )
+        {
+            text += wxString::Format("Entry%u=Some value %u of the group %u\n",
+                                     entry, entry, group);
+        }
+    }
+
+    wxFFile f(gs_filename, "w");
+    return f.Write(text) && f.Close();
+}
+
+void DoneFile()
+{
+    wxRemoveFile(gs_filename);
+    gs_filename.clear();
+}
+
+wxFileConfig* OpenConfig()
+{
+    wxFileConfig* const
+        config = new wxFileConfig("", "", gs_filename, "", wxCONFIG_USE_LOCAL_FILE);
+    config->DisableAutoSave();
+
+    return config;
+}
+
+bool InitConfig()
+{
+    if ( !InitFile() )
+        return false;
+
+    gs_config = OpenConfig();
+    return true;
+}
+
+bool InitConfigWriteBehind()
+{
+    if ( !InitConfig() )
+        return false;
+
+    gs_config->EnableWriteBehind();
+    return true;
+}
+
+void DoneConfig()
+{
+    delete gs_config;
+    gs_config = nullptr;
+
+    DoneFile();
+}
+
+} // anonymous namespace
+
+// Typical application startup: load the file and read a few values from it.
+BENCHMARK_FUNC_WITH_INIT(FileConfigLoad, InitFile, DoneFile)
+{
+    wxFileConfig* const config = OpenConfig();
+
+    const unsigned step = gs_numGroups > 10 ? gs_numGroups / 10 : 1;
+
+    bool ok = true;
+    for ( unsigned group = 0; group < gs_numGroups; group += step )
+    {
+        if ( config->Read(GetKey(group, 1), "") != wxString::Format
+                ("Some value 1 of the group %u", group) )
+            ok = false;
+    }
+
+    delete config;
+
+    return ok;
+}
+
+BENCHMARK_FUNC_WITH_INIT(FileConfigLoadAndReadAll, InitFile, DoneFile)
+{
+    wxFileConfig* const config = OpenConfig();
+
+    bool ok = true;
+    for ( unsigned group = 0; group < gs_numGroups; group++ )
+    {
+        for ( unsigned entry = 0; entry < ENTRIES_PER_GROUP; entry++ )
+        {
+            if ( !config->HasEntry(GetKey(group, entry)) )
+                ok = false;
+        }
+    }
+
+    delete config;
+
+    return ok;
+}
+
+// Reading values using their full paths from an already loaded file.
+BENCHMARK_FUNC_WITH_INIT(FileConfigRead, InitConfig, DoneConfig)
+{
+    static unsigned s_group = 0;
+
+    bool ok = true;
+    for ( unsigned n = 0; n < 1000; n++ )
+    {
+        s_group = (s_group + 7919) % gs_numGroups;
+
+        wxString value;
+        if ( !gs_config->Read(GetKey(s_group, n % ENTRIES_PER_GROUP), &value) )
+            ok = false;
+    }
+
+    return ok;
+}
+
+// Changing a single value and flushing the changes, as done by the
+// applications saving their state after each change.
+BENCHMARK_FUNC_WITH_INIT(FileConfigFlush, InitConfig, DoneConfig)
+{
+    static long s_value = 0;
+
+    return gs_config->Write("/Group0/Sub/Entry0", ++s_value) &&
+            gs_config->Flush();
+}
+
+BENCHMARK_FUNC_WITH_INIT(FileConfigFlushWriteBehind, InitConfigWriteBehind, DoneConfig)
+{
+    static long s_value = 0;
+
+    return gs_config->Write("/Group0/Sub/Entry0", ++s_value) &&
+            gs_config->Flush();
+}
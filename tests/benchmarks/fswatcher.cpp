@@ -0,0 +1,197 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/fswatcher.cpp
+// Purpose:     wxFileSystemWatcher benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/defs.h"
+
+#if wxUSE_FSWATCHER
+
+#include "wx/crt.h"
+#include "wx/evtloop.h"
+#include "wx/file.h"
+#include "wx/filename.h"
+#include "wx/fswatcher.h"
+#include "wx/utils.h"
+
+#include "bench.h"
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+// Number of times each file is modified during a single run.
+const int MODIFICATIONS_PER_FILE = 10;
+
+wxString gs_root;
+wxEventLoop* gs_loop = nullptr;
+
+// Handler counting the events received from the watcher.
+class EventCounter : public wxEvtHandler
+{
+public:
+    EventCounter()
+    {
+        Bind(wxEVT_FSWATCHER, &EventCounter::OnEvent, this);
+    }
+
+    void OnEvent(wxFileSystemWatcherEvent& event)
+    {
+        if ( event.GetChangeType() & wxFSW_EVENT_MODIFY )
+            m_numModified++;
+        else if ( event.IsError() )
+            m_numErrors++;
+    }
+
+    int m_numModified = 0;
+    int m_numErrors = 0;
+};
+
+wxFileSystemWatcher* gs_watcher = nullptr;
+EventCounter* gs_counter = nullptr;
+
+// The files are kept open to make modifying them as cheap as possible.
+std::vector<std::unique_ptr<wxFile>> gs_files;
+
+bool CreateRoot()
+{
+    gs_root = wxFileName::GetTempDir() +
+                wxString::Format("/wxbench_fsw_%lu", wxGetProcessId());
+
+    if ( !wxFileName::Mkdir(gs_root, wxS_DIR_DEFAULT) )
+    {
+        wxFprintf(stderr, "Failed to create directory \"%s\".\n", gs_root);
+        return false;
+    }
+
+    gs_loop = new wxEventLoop();
+    wxEventLoopBase::SetActive(gs_loop);
+
+    return true;
+}
+
+void DoneRoot()
+{
+    gs_files.clear();
+
+    delete gs_watcher;
+    gs_watcher = nullptr;
+
+    delete gs_counter;
+    gs_counter = nullptr;
+
+    wxEventLoopBase::SetActive(nullptr);
+    wxDELETE(gs_loop);
+
+    wxFileName::Rmdir(gs_root, wxPATH_RMDIR_RECURSIVE);
+}
+
+// Create a tree with the given number of directories, 100 per parent.
+bool InitTree()
+{
+    if ( !CreateRoot() )
+        return false;
+
+    const long numDirs = Bench::GetNumericParameter(10000);
+    for ( long n = 0; n < numDirs; n++ )
+    {
+        const wxString parent = wxString::Format("%s/%ld", gs_root, n / 100);
+        if ( n % 100 == 0 && !wxFileName::Mkdir(parent, wxS_DIR_DEFAULT) )
+            return false;
+
+        if ( !wxFileName::Mkdir(wxString::Format("%s/%ld", parent, n),
+                                wxS_DIR_DEFAULT) )
+            return false;
+    }
+
+    return true;
+}
+
+// Create a directory with the given number of files and watch it.
+bool InitFiles()
+{
+    if ( !CreateRoot() )
+        return false;
+
+    const long numFiles = Bench::GetNumericParameter(100);
+    for ( long n = 0; n < numFiles; n++ )
+    {
+        std::unique_ptr<wxFile> file(new wxFile());
+        if ( !file->Create(wxString::Format("%s/%ld", gs_root, n)) )
+            return false;
+
+        gs_files.push_back(std::move(file));
+    }
+
+    gs_counter = new EventCounter();
+    gs_watcher = new wxFileSystemWatcher();
+    gs_watcher->SetOwner(gs_counter);
+
+    return gs_watcher->Add(wxFileName::DirName(gs_root), wxFSW_EVENT_MODIFY);
+}
+
+// Same as InitFiles() but also enable events coalescing.
+bool InitFilesCoalesced()
+{
+    return InitFiles() && gs_watcher->SetCoalescingInterval(1);
+}
+
+// Modify all files several times and wait until the expected number of
+// events is received.
+bool ModifyFiles(int numExpected)
+{
+    for ( int i = 0; i < MODIFICATIONS_PER_FILE; i++ )
+    {
+        for ( const auto& file : gs_files )
+        {
+            if ( file->Write("x", 1) != 1 )
+                return false;
+        }
+    }
+
+    Bench::SetCallsPerRun(gs_files.size()*MODIFICATIONS_PER_FILE);
+
+    gs_counter->m_numModified = 0;
+    while ( gs_counter->m_numModified < numExpected )
+    {
+        if ( gs_loop->DispatchTimeout(1000) <= 0 || gs_counter->m_numErrors )
+            return false;
+    }
+
+    return gs_counter->m_numModified == numExpected;
+}
+
+} // anonymous namespace
+
+// Notice that when fanotify can be used, a single watch is added for the
+// entire tree, so the time per directory becomes negligible.
+BENCHMARK_FUNC_WITH_INIT(FSWatcherAddTree, InitTree, DoneRoot)
+{
+    wxFileSystemWatcher watcher;
+    if ( !watcher.AddTree(wxFileName::DirName(gs_root)) )
+        return false;
+
+    Bench::SetCallsPerRun(Bench::GetNumericParameter(10000));
+
+    return watcher.GetWatchedPathsCount() > 0;
+}
+
+// Each modification results in a separate event.
+BENCHMARK_FUNC_WITH_INIT(FSWatcherModify, InitFiles, DoneRoot)
+{
+    return ModifyFiles(Bench::GetNumericParameter(100)*MODIFICATIONS_PER_FILE);
+}
+
+// All modifications of the same file are merged into a single event.
+BENCHMARK_FUNC_WITH_INIT(FSWatcherModifyCoalesced, InitFilesCoalesced, DoneRoot)
+{
+    return ModifyFiles(Bench::GetNumericParameter(100));
+}
+
+#endif // wxUSE_FSWATCHER
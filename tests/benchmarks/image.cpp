@@ -1,12 +1,13 @@
 /////////////////////////////////////////////////////////////////////////////
 // Name:        tests/benchmarks/image.cpp
-// Purpose:     wxImage benchmarks
+// Purpose:     wxImage and wxBitmapBundle benchmarks
 // Author:      Vadim Zeitlin
 // Created:     2013-06-30
 // Copyright:   (c) 2013 Vadim Zeitlin <vadim@wxwidgets.org>
 // Licence:     wxWindows licence
 /////////////////////////////////////////////////////////////////////////////
 
+#include "wx/bmpbndl.h"
 #include "wx/image.h"
 
 #include "bench.h"
@@ -118,3 +119,86 @@ BENCHMARK_FUNC(ShrinkHighQuality)
     return image.Scale(factor*image.GetWidth(), factor*image.GetHeight(),
                        wxIMAGE_QUALITY_HIGH).IsOk();
 }
+
+#ifdef wxHAS_SVG
+
+// Bundles emulating the icons of a big toolbar.
+static wxVector<wxBitmapBundle> gs_svgBundles;
+
+static bool InitSVGBundles()
+{
+    static const char svg_data[] =
+        "<svg viewBox=\"0 0 100 100\">"
+        "<circle cx=\"50\" cy=\"50\" r=\"45\" fill=\"#3f7fff\" stroke=\"black\" stroke-width=\"4\"/>"
+        "<path d=\"M20 50 Q50 5 80 50 T20 50 Z\" fill=\"yellow\" opacity=\"0.7\"/>"
+        "<rect x=\"30\" y=\"60\" width=\"40\" height=\"20\" rx=\"5\" fill=\"green\"/>"
+        "</svg>"
+        ;
+
+    const long numBundles = Bench::GetNumericParameter(300);
+    for ( long n = 0; n < numBundles; n++ )
+        gs_svgBundles.push_back(wxBitmapBundle::FromSVG(svg_data, wxSize(24, 24)));
+
+    return true;
+}
+
+static void DoneSVGBundles()
+{
+    gs_svgBundles.clear();
+}
+
+// Return a new size each time to ensure the bitmaps are never cached.
+static wxSize GetNextSVGSize()
+{
+    static int s_size = 0;
+    s_size = (s_size + 1) % 64;
+    return wxSize(24 + s_size, 24 + s_size);
+}
+
+// Switching between two sizes, as when moving a window between two monitors
+// using different DPIs, doesn't need to rasterize the images again.
+BENCHMARK_FUNC_WITH_INIT(SVGBundleSwitchSize, InitSVGBundles, DoneSVGBundles)
+{
+    for ( size_t n = 0; n < gs_svgBundles.size(); n++ )
+    {
+        if ( !gs_svgBundles[n].GetBitmap(wxSize(24, 24)).IsOk() ||
+                !gs_svgBundles[n].GetBitmap(wxSize(48, 48)).IsOk() )
+            return false;
+    }
+
+    Bench::SetCallsPerRun(2*gs_svgBundles.size());
+
+    return true;
+}
+
+BENCHMARK_FUNC_WITH_INIT(SVGBundleRasterize, InitSVGBundles, DoneSVGBundles)
+{
+    const wxSize size = GetNextSVGSize();
+    for ( size_t n = 0; n < gs_svgBundles.size(); n++ )
+    {
+        if ( !gs_svgBundles[n].GetBitmap(size).IsOk() )
+            return false;
+    }
+
+    Bench::SetCallsPerRun(gs_svgBundles.size());
+
+    return true;
+}
+
+BENCHMARK_FUNC_WITH_INIT(SVGBundlePrerender, InitSVGBundles, DoneSVGBundles)
+{
+    const wxSize size = GetNextSVGSize();
+    wxBitmapBundle::PrerenderSVG(gs_svgBundles, size);
+
+    for ( size_t n = 0; n < gs_svgBundles.size(); n++ )
+    {
+        if ( !gs_svgBundles[n].GetBitmap(size).IsOk() )
+            return false;
+    }
+
+    Bench::SetCallsPerRun(gs_svgBundles.size());
+
+    return true;
+}
+
+#endif // wxHAS_SVG
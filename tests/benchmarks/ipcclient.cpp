@@ -9,8 +9,11 @@
 
 #include "bench.h"
 
+#include "wx/app.h"
 #include "wx/evtloop.h"
 
+#include <vector>
+
 // do this before including wx/ipc.h under Windows to use TCP even there
 #define wxUSE_DDE_FOR_IPC 0
 #include "wx/ipc.h"
@@ -22,7 +25,7 @@ namespace
 class PokeAdviseConn : public wxConnection
 {
 public:
-    PokeAdviseConn() { m_gotAdvised = false; }
+    PokeAdviseConn() { m_gotAdvised = false; m_size = 0; }
 
     bool GotAdvised()
     {
@@ -36,6 +39,9 @@ public:
 
     const wxString& GetItem() const { return m_item; }
 
+    // the size of the last received binary data
+    size_t GetSize() const { return m_size; }
+
     virtual bool OnAdvise(const wxString& topic,
                           const wxString& item,
                           const void *data,
@@ -45,8 +51,22 @@ public:
         m_gotAdvised = true;
 
         if ( topic != IPC_BENCHMARK_TOPIC ||
-                item != IPC_BENCHMARK_ITEM ||
-                    !IsTextFormat(format) )
+                item != IPC_BENCHMARK_ITEM )
+        {
+            m_item = "ERROR";
+            return false;
+        }
+
+        if ( format == wxIPC_PRIVATE )
+        {
+            // don't bother converting binary data, notice that it can't be
+            // kept after returning anyhow
+            m_item.clear();
+            m_size = size;
+            return true;
+        }
+
+        if ( !IsTextFormat(format) )
         {
             m_item = "ERROR";
             return false;
@@ -59,6 +79,7 @@ public:
 
 private:
     wxString m_item;
+    size_t m_size;
     bool m_gotAdvised;
 
     wxDECLARE_NO_COPY_CLASS(PokeAdviseConn);
@@ -146,12 +167,24 @@ void ConnDone()
     delete theConnection;
 }
 
+// Wait until the server sends us the data back.
+void WaitForAdvise(PokeAdviseConn *conn)
+{
+    wxEventLoop loop;
+
+    // Socket events are queued and not processed immediately, so we need to
+    // process them explicitly as the main loop is not running.
+    while ( !conn->GotAdvised() )
+    {
+        loop.Dispatch();
+        wxTheApp->ProcessPendingEvents();
+    }
+}
+
 } // anonymous namespace
 
 BENCHMARK_FUNC_WITH_INIT(IPCPokeAdvise, ConnInit, ConnDone)
 {
-    wxEventLoop loop;
-
     PokeAdviseConn * const conn = theConnection->Get();
 
     const wxString s(1024, '@');
@@ -159,11 +192,35 @@ BENCHMARK_FUNC_WITH_INIT(IPCPokeAdvise, ConnInit, ConnDone)
     if ( !conn->Poke(IPC_BENCHMARK_ITEM, s) )
         return false;
 
-    while ( !conn->GotAdvised() )
-        loop.Dispatch();
+    WaitForAdvise(conn);
 
     if ( conn->GetItem() != s )
         return false;
 
+    // the data is sent to the server and then back
+    Bench::SetBytesPerRun(2*s.length());
+
+    return true;
+}
+
+// Same as above but for a bigger block of binary data, which is passed via
+// shared memory if the server runs on the same machine.
+BENCHMARK_FUNC_WITH_INIT(IPCPokeAdviseBulk, ConnInit, ConnDone)
+{
+    PokeAdviseConn * const conn = theConnection->Get();
+
+    static const std::vector<char> s_data(1024*1024, '@');
+
+    if ( !conn->Poke(IPC_BENCHMARK_ITEM, s_data.data(), s_data.size(),
+                     wxIPC_PRIVATE) )
+        return false;
+
+    WaitForAdvise(conn);
+
+    if ( conn->GetSize() != s_data.size() )
+        return false;
+
+    Bench::SetBytesPerRun(2*s_data.size());
+
     return true;
 }
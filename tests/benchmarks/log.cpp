@@ -106,3 +106,130 @@ BENCHMARK_FUNC(LogTraceInactive)
 
     return true;
 }
+
+#if wxUSE_THREADS
+
+#include "wx/thread.h"
+
+namespace
+{
+
+// Log target simply counting the messages passed to it.
+class CountingLog : public wxLog
+{
+public:
+    CountingLog() = default;
+
+    unsigned long GetCount() const { return m_count; }
+
+protected:
+    virtual void DoLogRecord(wxLogLevel,
+                             const wxString&,
+                             const wxLogRecordInfo&) override
+    {
+        m_count++;
+    }
+
+private:
+    unsigned long m_count = 0;
+
+    wxDECLARE_NO_COPY_CLASS(CountingLog);
+};
+
+const unsigned MESSAGES_PER_THREAD = 1000;
+
+class LoggingThread : public wxThread
+{
+public:
+    LoggingThread() : wxThread(wxTHREAD_JOINABLE) { }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        for ( unsigned n = 0; n < MESSAGES_PER_THREAD; n++ )
+            wxLogMessage("Message %u from a background thread", n);
+
+        return nullptr;
+    }
+};
+
+CountingLog* gs_countingLog = nullptr;
+wxLog* gs_threadsLog = nullptr;
+wxLog* gs_threadsLogOld = nullptr;
+
+bool InitThreadsLog()
+{
+    gs_countingLog = new CountingLog;
+    gs_threadsLog = gs_countingLog;
+    gs_threadsLogOld = wxLog::SetActiveTarget(gs_threadsLog);
+
+    return true;
+}
+
+bool InitThreadsLogAsync()
+{
+    gs_countingLog = new CountingLog;
+    gs_threadsLog = new wxLogAsync(gs_countingLog, 1024, wxLogAsync::Overflow_Block);
+    gs_threadsLogOld = wxLog::SetActiveTarget(gs_threadsLog);
+
+    return true;
+}
+
+void DoneThreadsLog()
+{
+    wxLog::SetActiveTarget(gs_threadsLogOld);
+
+    // This also deletes gs_countingLog if it's used by wxLogAsync.
+    delete gs_threadsLog;
+    gs_threadsLog = nullptr;
+    gs_countingLog = nullptr;
+}
+
+// Log messages from several threads (4 by default, can be changed using the
+// numeric parameter) and wait until all of them are passed to the target.
+bool LogFromThreads()
+{
+    const unsigned long countOld = gs_countingLog->GetCount();
+
+    const unsigned numThreads = Bench::GetNumericParameter(4);
+
+    wxVector<LoggingThread*> threads;
+    for ( unsigned n = 0; n < numThreads; n++ )
+    {
+        LoggingThread* const thread = new LoggingThread;
+        if ( thread->Run() != wxTHREAD_NO_ERROR )
+        {
+            delete thread;
+            break;
+        }
+
+        threads.push_back(thread);
+    }
+
+    for ( size_t n = 0; n < threads.size(); n++ )
+    {
+        threads[n]->Wait();
+        delete threads[n];
+    }
+
+    wxLog::FlushActive();
+
+    return gs_countingLog->GetCount() - countOld ==
+            threads.size()*MESSAGES_PER_THREAD;
+}
+
+} // anonymous namespace
+
+// Messages from the background threads are buffered and then logged by the
+// main thread when it flushes the log.
+BENCHMARK_FUNC_WITH_INIT(LogThreads, InitThreadsLog, DoneThreadsLog)
+{
+    return LogFromThreads();
+}
+
+BENCHMARK_FUNC_WITH_INIT(LogThreadsAsync, InitThreadsLogAsync, DoneThreadsLog)
+{
+    return LogFromThreads();
+}
+
+#endif // wxUSE_THREADS
@@ -12,6 +12,9 @@
 
 #include "bench.h"
 
+#include <string>
+#include <vector>
+
 namespace
 {
 
@@ -76,3 +79,144 @@ BENCHMARK_FUNC(UTF16Sys)
     return ConvertToMB(wxCSConv("UTF-16LE"));
 }
 
+
+// ----------------------------------------------------------------------------
+// UTF-8 conversions of big strings
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Each of the strings below is repeated to get a string of the given size in
+// KiB, which can be changed by using the numeric parameter.
+std::string MakeUTF8Text(const char* text)
+{
+    const size_t size = Bench::GetNumericParameter(1024)*1024;
+
+    std::string s;
+    s.reserve(size + strlen(text));
+    while ( s.length() < size )
+        s += text;
+
+    return s;
+}
+
+const char* const UTF8_ASCII_TEXT =
+    "Lorem ipsum dolor sit amet, consectetur adipisicing elit, sed do eiusmod "
+    "tempor incididunt ut labore et dolore magna aliqua.\n";
+
+// French text containing a non-ASCII character every few words.
+const char* const UTF8_LATIN1_TEXT =
+    "Le c\xc5\x93ur a ses raisons que la raison ne conna\xc3\xaet point. "
+    "\xc3\x80 la fen\xc3\xaatre, l'\xc3\xa9t\xc3\xa9 d\xc3\xa9j\xc3\xa0 fini, "
+    "il r\xc3\xaavait d'une for\xc3\xaat \xc3\xa9""clair\xc3\xa9""e.\n";
+
+// Chinese text with some ASCII punctuation.
+const char* const UTF8_CJK_TEXT =
+    "\xe6\x98\xa5\xe7\x9c\xa0\xe4\xb8\x8d\xe8\xa7\x89\xe6\x99\x93, "
+    "\xe5\xa4\x84\xe5\xa4\x84\xe9\x97\xbb\xe5\x95\xbc\xe9\xb8\x9f. "
+    "\xe5\xa4\x9c\xe6\x9d\xa5\xe9\xa3\x8e\xe9\x9b\xa8\xe5\xa3\xb0, "
+    "\xe8\x8a\xb1\xe8\x90\xbd\xe7\x9f\xa5\xe5\xa4\x9a\xe5\xb0\x91.\n";
+
+std::string gs_utf8;
+std::wstring gs_wide;
+
+// Output buffers for the conversions, allocated in advance to measure just
+// the conversion speed.
+std::vector<char> gs_utf8Buf;
+std::vector<wchar_t> gs_wideBuf;
+
+bool InitUTF8(const char* text)
+{
+    gs_utf8 = MakeUTF8Text(text);
+    gs_wide = wxString::FromUTF8(gs_utf8).ToStdWstring();
+
+    gs_utf8Buf.resize(gs_utf8.length());
+    gs_wideBuf.resize(gs_wide.length());
+
+    return !gs_wide.empty();
+}
+
+bool InitUTF8ASCII()
+{
+    return InitUTF8(UTF8_ASCII_TEXT);
+}
+
+bool InitUTF8Latin1()
+{
+    return InitUTF8(UTF8_LATIN1_TEXT);
+}
+
+bool InitUTF8CJK()
+{
+    return InitUTF8(UTF8_CJK_TEXT);
+}
+
+void DoneUTF8()
+{
+    gs_utf8.clear();
+    gs_utf8.shrink_to_fit();
+    gs_wide.clear();
+    gs_wide.shrink_to_fit();
+
+    gs_utf8Buf.clear();
+    gs_utf8Buf.shrink_to_fit();
+    gs_wideBuf.clear();
+    gs_wideBuf.shrink_to_fit();
+}
+
+// Both functions below first compute the length of the output, as
+// wxMBConv::cMB2WC() and cWC2MB() used by wxString do, and then convert.
+bool FromUTF8()
+{
+    Bench::SetBytesPerRun(gs_utf8.length());
+
+    const size_t len = wxConvUTF8.ToWChar(nullptr, 0,
+                                          gs_utf8.data(), gs_utf8.length());
+    return len == gs_wideBuf.size() &&
+            wxConvUTF8.ToWChar(&gs_wideBuf[0], len,
+                               gs_utf8.data(), gs_utf8.length()) == len;
+}
+
+bool ToUTF8()
+{
+    Bench::SetBytesPerRun(gs_utf8.length());
+
+    const size_t len = wxConvUTF8.FromWChar(nullptr, 0,
+                                            gs_wide.data(), gs_wide.length());
+    return len == gs_utf8Buf.size() &&
+            wxConvUTF8.FromWChar(&gs_utf8Buf[0], len,
+                                 gs_wide.data(), gs_wide.length()) == len;
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC_WITH_INIT(UTF8DecodeASCII, InitUTF8ASCII, DoneUTF8)
+{
+    return FromUTF8();
+}
+
+BENCHMARK_FUNC_WITH_INIT(UTF8DecodeLatin1, InitUTF8Latin1, DoneUTF8)
+{
+    return FromUTF8();
+}
+
+BENCHMARK_FUNC_WITH_INIT(UTF8DecodeCJK, InitUTF8CJK, DoneUTF8)
+{
+    return FromUTF8();
+}
+
+BENCHMARK_FUNC_WITH_INIT(UTF8EncodeASCII, InitUTF8ASCII, DoneUTF8)
+{
+    return ToUTF8();
+}
+
+BENCHMARK_FUNC_WITH_INIT(UTF8EncodeLatin1, InitUTF8Latin1, DoneUTF8)
+{
+    return ToUTF8();
+}
+
+BENCHMARK_FUNC_WITH_INIT(UTF8EncodeCJK, InitUTF8CJK, DoneUTF8)
+{
+    return ToUTF8();
+}
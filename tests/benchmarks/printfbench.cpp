@@ -132,3 +132,140 @@ BENCHMARK_FUNC(SystemSnprintf)
     return true;
 }
 
+
+// ----------------------------------------------------------------------------
+// wxString::Format() benchmarks
+// ----------------------------------------------------------------------------
+
+// Count the memory allocations done while formatting the strings by replacing
+// the standard allocation functions: this is only possible with glibc, which
+// provides the underlying implementation under different names.
+#if defined(__GLIBC__) && \
+    !defined(__SANITIZE_ADDRESS__) && !defined(__SANITIZE_THREAD__)
+
+#include <atomic>
+
+namespace
+{
+
+std::atomic<bool> gs_countAllocs(false);
+std::atomic<unsigned long> gs_numAllocs(0);
+
+inline void CountAlloc()
+{
+    if ( gs_countAllocs.load(std::memory_order_relaxed) )
+        gs_numAllocs.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // anonymous namespace
+
+extern "C"
+{
+
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t num, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+
+void* malloc(size_t size)
+{
+    CountAlloc();
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t num, size_t size)
+{
+    CountAlloc();
+    return __libc_calloc(num, size);
+}
+
+void* realloc(void* ptr, size_t size)
+{
+    CountAlloc();
+    return __libc_realloc(ptr, size);
+}
+
+} // extern "C"
+
+#define wxHAS_ALLOC_COUNT
+
+#endif // __GLIBC__
+
+namespace
+{
+
+// Call the given function the number of times specified by the numeric
+// parameter and report the time and the number of allocations per call.
+template <typename F>
+bool FormatMany(F func)
+{
+    const long count = Bench::GetNumericParameter(1000);
+
+#ifdef wxHAS_ALLOC_COUNT
+    gs_numAllocs = 0;
+    gs_countAllocs = true;
+#endif
+
+    size_t total = 0;
+    for ( long n = 0; n < count; n++ )
+        total += func(n).length();
+
+#ifdef wxHAS_ALLOC_COUNT
+    gs_countAllocs = false;
+    Bench::SetAllocsPerRun(gs_numAllocs);
+#endif
+
+    Bench::SetCallsPerRun(count);
+
+    return total != 0;
+}
+
+const wxString g_component("network");
+const wxString g_message("connection established");
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(FormatShort)
+{
+    return FormatMany([](long n)
+        {
+            return wxString::Format("Item %ld", n);
+        });
+}
+
+BENCHMARK_FUNC(FormatLogLine)
+{
+    return FormatMany([](long n)
+        {
+            return wxString::Format("%02d:%02d:%02d.%03d [%s] %s: %s (%ld bytes, %.2f ms)",
+                                    12, 34, 56, 789,
+                                    g_component, "info", g_message,
+                                    n, n / 7.);
+        });
+}
+
+BENCHMARK_FUNC(FormatWide)
+{
+    return FormatMany([](long n)
+        {
+            return wxString::Format(L"[%s] %s: item %ld of %d",
+                                    g_component, g_message, n, 1000);
+        });
+}
+
+BENCHMARK_FUNC(FormatLong)
+{
+    return FormatMany([](long n)
+        {
+            return wxString::Format("%ld: %s", n, g_verylongString);
+        });
+}
+
+BENCHMARK_FUNC(PrintfReuse)
+{
+    wxString s;
+    return FormatMany([&s](long n)
+        {
+            s.Printf("[%s] %s: item %ld", g_component, g_message, n);
+            return s;
+        });
+}
@@ -72,3 +72,106 @@ BENCHMARK_FUNC(REFindTD)
 
     return matches == 21; // result of "grep -c"
 }
+
+// ----------------------------------------------------------------------------
+// Benchmark scanning log files
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Return the lines of a synthetic log, only a few of which contain errors.
+const wxArrayString& GetLogLines()
+{
+    static wxArrayString lines;
+    if ( lines.empty() )
+    {
+        for ( unsigned n = 0; n < 10000; n++ )
+        {
+            lines.push_back(wxString::Format
+                            (
+                                "2026-10-19 12:%02u:%02u.%03u [%s] worker %u: "
+                                "processed request %u from 192.168.%u.%u in %u ms",
+                                n / 60000 % 60, n / 1000 % 60, n % 1000,
+                                n % 997 ? "info" : "ERROR",
+                                n % 16,
+                                n,
+                                n / 256 % 256, n % 256,
+                                n * 7 % 500
+                            ));
+        }
+    }
+
+    return lines;
+}
+
+const wxString& GetLogText()
+{
+    static wxString text;
+    if ( text.empty() )
+    {
+        for ( const auto& line : GetLogLines() )
+        {
+            text += line;
+            text += '\n';
+        }
+    }
+
+    return text;
+}
+
+} // anonymous namespace
+
+// Compiling the same expression again is common too.
+BENCHMARK_FUNC(RECompileLogPattern)
+{
+    Bench::SetCallsPerRun(100);
+
+    bool ok = true;
+    for ( int n = 0; n < 100; n++ )
+    {
+        if ( !wxRegEx("\\[(ERROR|WARN)\\] worker ([0-9]+): .* in ([0-9]+) ms").IsValid() )
+            ok = false;
+    }
+
+    return ok;
+}
+
+// Typical "grep" usage: check each line for a rarely occurring pattern.
+BENCHMARK_FUNC(REScanLogLines)
+{
+    static wxRegEx re("([0-9:.]+) \\[ERROR\\] worker ([0-9]+):");
+
+    const wxArrayString& lines = GetLogLines();
+    Bench::SetCallsPerRun(lines.size());
+
+    int matches = 0;
+    for ( const auto& line : lines )
+    {
+        if ( re.Matches(line) )
+            matches++;
+    }
+
+    return matches == 11;
+}
+
+// Find all occurrences of a pattern starting with a literal in a big text.
+BENCHMARK_FUNC(REScanLogText)
+{
+    static wxRegEx re("\\[ERROR\\] worker ([0-9]+):");
+
+    const wxString& text = GetLogText();
+    Bench::SetBytesPerRun(text.length());
+
+    int matches = 0;
+    for ( const wxChar* p = text.c_str(); re.Matches(p); ++matches )
+    {
+        size_t start, len;
+        if ( !re.GetMatch(&start, &len) )
+            return false;
+
+        p += start + len;
+    }
+
+    return matches == 11;
+}
@@ -0,0 +1,213 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/sckreactor.cpp
+// Purpose:     wxSocketReactor benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/sckreactor.h"
+
+#ifdef wxHAS_SOCKET_REACTOR
+
+#include "wx/crt.h"
+
+#include "bench.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+// The size of the messages sent by the clients.
+const size_t MESSAGE_SIZE = 64;
+
+// Handler sending back everything it receives.
+class EchoHandler : public wxSocketReactorHandler
+{
+public:
+    virtual void OnInput(wxSocketBase& socket) override
+    {
+        char buf[4096];
+        socket.Read(buf, sizeof(buf));
+
+        const wxUint32 count = socket.LastReadCount();
+        if ( count )
+            socket.Write(buf, count);
+    }
+};
+
+EchoHandler gs_handler;
+std::unique_ptr<wxSocketReactor> gs_reactor;
+
+// The port the reactor listens on.
+unsigned short gs_port = 0;
+
+// Clients used by the echo benchmark.
+std::vector<std::unique_ptr<wxSocketClient>> gs_clients;
+
+// Round trip times of all messages sent by the echo benchmark, in us.
+std::vector<double> gs_latencies;
+
+typedef std::chrono::steady_clock Clock;
+
+wxSocketClient* Connect()
+{
+    std::unique_ptr<wxSocketClient>
+        client(new wxSocketClient(wxSOCKET_BLOCK | wxSOCKET_WAITALL));
+    wxIPV4address addr;
+    addr.Hostname("127.0.0.1");
+    addr.Service(gs_port);
+
+    if ( !client->Connect(addr) )
+        return nullptr;
+
+    return client.release();
+}
+
+// Send a message using the given client and wait for the reply.
+bool SendAndReceive(wxSocketBase& client)
+{
+    char buf[MESSAGE_SIZE] = { 'x' };
+    if ( client.Write(buf, sizeof(buf)).LastWriteCount() != sizeof(buf) )
+        return false;
+
+    return client.Read(buf, sizeof(buf)).LastReadCount() == sizeof(buf);
+}
+
+void DoneReactor()
+{
+    gs_clients.clear();
+
+    if ( gs_reactor )
+    {
+        gs_reactor->Stop();
+        gs_reactor.reset();
+    }
+}
+
+bool InitReactor()
+{
+    // Let the system choose a free port.
+    wxIPV4address addr;
+    addr.Hostname("127.0.0.1");
+    addr.Service(0);
+
+    // The number of threads can be given by the string parameter, by default
+    // one thread per CPU is used.
+    unsigned long numThreads = 0;
+    if ( !Bench::GetStringParameter().ToULong(&numThreads) )
+        numThreads = 0;
+
+    gs_reactor.reset(new wxSocketReactor(gs_handler));
+    if ( !gs_reactor->Start(addr, numThreads) )
+    {
+        wxFprintf(stderr, "Failed to start the reactor.\n");
+        gs_reactor.reset();
+        return false;
+    }
+
+    if ( !gs_reactor->GetLocal(addr) )
+    {
+        DoneReactor();
+        return false;
+    }
+
+    gs_port = addr.Service();
+
+    return true;
+}
+
+bool InitEcho()
+{
+    if ( !InitReactor() )
+        return false;
+
+    gs_latencies.clear();
+
+    // The number of simultaneously connected clients can be changed using
+    // the numeric parameter.
+    const long numClients = Bench::GetNumericParameter(64);
+    for ( long n = 0; n < numClients; n++ )
+    {
+        wxSocketClient* const client = Connect();
+        if ( !client )
+        {
+            DoneReactor();
+            return false;
+        }
+
+        gs_clients.emplace_back(client);
+    }
+
+    return true;
+}
+
+double GetPercentile(double p)
+{
+    const size_t n = static_cast<size_t>(p*(gs_latencies.size() - 1) / 100);
+    return gs_latencies[n];
+}
+
+void DoneEcho()
+{
+    DoneReactor();
+
+    if ( gs_latencies.empty() )
+        return;
+
+    std::sort(gs_latencies.begin(), gs_latencies.end());
+
+    // This is output before the rest of the results for this benchmark.
+    wxPrintf("round trip p50/p90/p99/max: %.0f/%.0f/%.0f/%.0fus, ",
+             GetPercentile(50), GetPercentile(90), GetPercentile(99),
+             gs_latencies.back());
+}
+
+} // anonymous namespace
+
+// Connect to the reactor, exchange a single message with it and disconnect:
+// this measures the number of connections per second.
+BENCHMARK_FUNC_WITH_INIT(ReactorConnect, InitReactor, DoneReactor)
+{
+    std::unique_ptr<wxSocketClient> client(Connect());
+
+    return client && SendAndReceive(*client);
+}
+
+// Send a message from all connected clients at once and then wait for all the
+// replies, recording the time it took to get each of them.
+BENCHMARK_FUNC_WITH_INIT(ReactorEcho, InitEcho, DoneEcho)
+{
+    const char buf[MESSAGE_SIZE] = { 'x' };
+
+    std::vector<Clock::time_point> sent;
+    sent.reserve(gs_clients.size());
+
+    for ( const auto& client : gs_clients )
+    {
+        sent.push_back(Clock::now());
+        if ( client->Write(buf, sizeof(buf)).LastWriteCount() != sizeof(buf) )
+            return false;
+    }
+
+    for ( size_t n = 0; n < gs_clients.size(); n++ )
+    {
+        char reply[MESSAGE_SIZE];
+        if ( gs_clients[n]->Read(reply, sizeof(reply)).LastReadCount() != sizeof(reply) )
+            return false;
+
+        const std::chrono::duration<double, std::micro> rtt = Clock::now() - sent[n];
+        gs_latencies.push_back(rtt.count());
+    }
+
+    Bench::SetCallsPerRun(gs_clients.size());
+
+    return true;
+}
+
+#endif // wxHAS_SOCKET_REACTOR
@@ -245,6 +245,87 @@ BENCHMARK_FUNC(ForStringRIter)
     return true;
 }
 
+// ----------------------------------------------------------------------------
+// random access to long strings
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// More strings than the number of strings for which the last used position is
+// cached in UTF-8 build.
+const size_t NUM_LONG_STRINGS = 16;
+
+const wxString* GetLongUTF8Strings()
+{
+    static wxString s_strings[NUM_LONG_STRINGS];
+    if ( s_strings[0].empty() )
+    {
+        long num = Bench::GetNumericParameter();
+        if ( !num )
+            num = 1;
+
+        const wxString line = wxString::FromUTF8(utf8str);
+        for ( auto& s : s_strings )
+        {
+            for ( long n = 0; n < 100*num; n++ )
+                s += line;
+        }
+    }
+
+    return s_strings;
+}
+
+// Return the pseudo-random position in the string of the given length.
+size_t NextPos(unsigned& seed, size_t len)
+{
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 8) % len;
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(RandomStringIndex)
+{
+    const wxString* const strings = GetLongUTF8Strings();
+    const size_t len = strings[0].length();
+
+    unsigned seed = 1;
+    for ( size_t n = 0; n < 1000; n++ )
+    {
+        if ( strings[n % NUM_LONG_STRINGS][NextPos(seed, len)] == '~' )
+            return false;
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC(RandomStringMid)
+{
+    const wxString* const strings = GetLongUTF8Strings();
+    const size_t len = strings[0].length() - 10;
+
+    unsigned seed = 1;
+    for ( size_t n = 0; n < 1000; n++ )
+    {
+        if ( strings[n % NUM_LONG_STRINGS].Mid(NextPos(seed, len), 10).length() != 10 )
+            return false;
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC(StringFindAll)
+{
+    const wxString& s = GetLongUTF8Strings()[0];
+
+    size_t count = 0;
+    for ( size_t pos = s.find('9'); pos != wxString::npos; pos = s.find('9', pos + 1) )
+        count++;
+
+    return count == s.length() / 130;
+}
+
 // ----------------------------------------------------------------------------
 // wxString::Replace()
 // ----------------------------------------------------------------------------
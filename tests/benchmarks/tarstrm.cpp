@@ -0,0 +1,122 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/tarstrm.cpp
+// Purpose:     wxTarInputStream benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/tarstrm.h"
+#include "wx/filename.h"
+#include "wx/mstream.h"
+#include "wx/wfstream.h"
+
+#include "bench.h"
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+// Number of entries in the test archive.
+const int NUM_ENTRIES = 8;
+
+// Tar archive kept in memory and the total size of the data in it.
+wxMemoryOutputStream* gs_tar = nullptr;
+wxUint64 gs_dataSize = 0;
+
+// Temporary file the entries are extracted to.
+wxString gs_outFile;
+
+bool InitTar()
+{
+    // The total size of the data in the archive in MiB can be changed by
+    // using the numeric parameter.
+    const size_t entrySize = Bench::GetNumericParameter(64)*1024*1024
+                                / NUM_ENTRIES;
+
+    std::vector<char> data(entrySize);
+    for ( size_t n = 0; n < entrySize; n++ )
+        data[n] = static_cast<char>(n % 251);
+
+    gs_outFile = wxFileName::CreateTempFileName("benchtar");
+    if ( gs_outFile.empty() )
+        return false;
+
+    gs_tar = new wxMemoryOutputStream;
+    gs_dataSize = 0;
+
+    wxTarOutputStream tar(*gs_tar);
+    for ( int i = 0; i < NUM_ENTRIES; i++ )
+    {
+        if ( !tar.PutNextEntry(wxString::Format("file%d.bin", i), wxDateTime(),
+                               entrySize) )
+            return false;
+
+        if ( !tar.WriteAll(&data[0], data.size()) )
+            return false;
+
+        gs_dataSize += data.size();
+    }
+
+    return tar.Close();
+}
+
+void DoneTar()
+{
+    delete gs_tar;
+    gs_tar = nullptr;
+
+    if ( !gs_outFile.empty() )
+    {
+        wxRemoveFile(gs_outFile);
+        gs_outFile.clear();
+    }
+}
+
+// Extract all entries of the test archive to a file using the given function
+// and check that all the data was copied.
+template <typename F>
+bool ExtractAll(F copy)
+{
+    Bench::SetBytesPerRun(gs_dataSize);
+
+    wxMemoryInputStream mis(gs_tar->GetOutputStreamBuffer()->GetBufferStart(),
+                            gs_tar->GetLength());
+    wxTarInputStream tar(mis);
+    wxFileOutputStream out(gs_outFile);
+
+    for ( ;; )
+    {
+        std::unique_ptr<wxTarEntry> entry(tar.GetNextEntry());
+        if ( !entry )
+            break;
+
+        if ( !copy(tar, out) )
+            return false;
+    }
+
+    return out.TellO() == static_cast<wxFileOffset>(gs_dataSize);
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC_WITH_INIT(TarCopyEntryData, InitTar, DoneTar)
+{
+    return ExtractAll([](wxTarInputStream& tar, wxOutputStream& out)
+    {
+        return tar.CopyEntryData(out);
+    });
+}
+
+// This is what the code not using CopyEntryData() would typically do.
+BENCHMARK_FUNC_WITH_INIT(TarStreamCopy, InitTar, DoneTar)
+{
+    return ExtractAll([](wxTarInputStream& tar, wxOutputStream& out)
+    {
+        out.Write(tar);
+        return tar.Eof();
+    });
+}
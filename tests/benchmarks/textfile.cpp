@@ -0,0 +1,116 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/textfile.cpp
+// Purpose:     wxTextFile benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/ffile.h"
+#include "wx/filename.h"
+#include "wx/textfile.h"
+
+#include "bench.h"
+
+namespace
+{
+
+wxString gs_filename;
+wxUint64 gs_fileSize = 0;
+size_t gs_numLines = 0;
+
+bool InitTextFile()
+{
+    gs_filename = wxFileName::CreateTempFileName("benchtextfile");
+    if ( gs_filename.empty() )
+        return false;
+
+    wxFFile f(gs_filename, "wb");
+    if ( !f.IsOpened() )
+        return false;
+
+    // The size of the file in MiB can be changed by using the numeric
+    // parameter.
+    const wxUint64 size = Bench::GetNumericParameter(64)*1024*1024;
+
+    gs_fileSize = 0;
+    gs_numLines = 0;
+    for ( ; gs_fileSize < size; gs_numLines++ )
+    {
+        const wxCharBuffer
+            line = wxString::Format
+                   (
+                        "2026-10-19 12:%02u:%02u.%03u [info] worker %u: "
+                        "processed request %lu in %u ms\n",
+                        unsigned(gs_numLines / 60000 % 60),
+                        unsigned(gs_numLines / 1000 % 60),
+                        unsigned(gs_numLines % 1000),
+                        unsigned(gs_numLines % 16),
+                        (unsigned long)gs_numLines,
+                        unsigned(gs_numLines * 7 % 500)
+                   ).utf8_str();
+
+        if ( !f.Write(line.data(), line.length()) )
+            return false;
+
+        gs_fileSize += line.length();
+    }
+
+    return f.Close();
+}
+
+void DoneTextFile()
+{
+    wxRemoveFile(gs_filename);
+    gs_filename.clear();
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC_WITH_INIT(TextFileOpen, InitTextFile, DoneTextFile)
+{
+    Bench::SetBytesPerRun(gs_fileSize);
+
+    wxTextFile f;
+    return f.Open(gs_filename) && f.GetLineCount() == gs_numLines;
+}
+
+BENCHMARK_FUNC_WITH_INIT(TextFileOpenMapped, InitTextFile, DoneTextFile)
+{
+    Bench::SetBytesPerRun(gs_fileSize);
+
+    wxTextFile f;
+    return f.OpenMapped(gs_filename) && f.GetLineCount() == gs_numLines;
+}
+
+// Reading all lines sequentially after opening the file.
+BENCHMARK_FUNC_WITH_INIT(TextFileReadAll, InitTextFile, DoneTextFile)
+{
+    Bench::SetBytesPerRun(gs_fileSize);
+
+    wxTextFile f;
+    if ( !f.Open(gs_filename) )
+        return false;
+
+    size_t len = 0;
+    for ( size_t n = 0; n < f.GetLineCount(); n++ )
+        len += f.GetLine(n).length();
+
+    return len > 0;
+}
+
+BENCHMARK_FUNC_WITH_INIT(TextFileReadAllMapped, InitTextFile, DoneTextFile)
+{
+    Bench::SetBytesPerRun(gs_fileSize);
+
+    wxTextFile f;
+    if ( !f.OpenMapped(gs_filename) )
+        return false;
+
+    size_t len = 0;
+    for ( size_t n = 0; n < f.GetLineCount(); n++ )
+        len += f.GetLine(n).length();
+
+    return len > 0;
+}
@@ -0,0 +1,91 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/zstream.cpp
+// Purpose:     wxZlibInputStream benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/zstream.h"
+#include "wx/mstream.h"
+
+#include "bench.h"
+
+#include <vector>
+
+namespace
+{
+
+// Size of the uncompressed data of each member of the test gzip stream.
+const size_t MEMBER_SIZE = 256*1024;
+
+// Multi-member gzip stream kept in memory and the size of its data.
+wxMemoryOutputStream* gs_gzip = nullptr;
+wxUint64 gs_dataSize = 0;
+
+bool InitGzip()
+{
+    // The total size of the data in MiB can be changed by using the numeric
+    // parameter.
+    const size_t count = Bench::GetNumericParameter(64)*1024*1024 / MEMBER_SIZE;
+
+    // Use something looking vaguely like a log file.
+    std::vector<char> data(MEMBER_SIZE);
+    unsigned seed = 1;
+    for ( size_t n = 0; n < MEMBER_SIZE; n++ )
+    {
+        seed = seed * 1103515245 + 12345;
+        const unsigned r = (seed >> 16) % 64;
+        data[n] = r < 4 ? '\n' : r < 12 ? ' ' : static_cast<char>('a' + r % 26);
+    }
+
+    gs_gzip = new wxMemoryOutputStream;
+    gs_dataSize = 0;
+
+    for ( size_t n = 0; n < count; n++ )
+    {
+        wxZlibOutputStream zos(*gs_gzip, wxZ_DEFAULT_COMPRESSION, wxZLIB_GZIP);
+        if ( !zos.WriteAll(&data[0], data.size()) || !zos.Close() )
+            return false;
+
+        gs_dataSize += data.size();
+    }
+
+    return true;
+}
+
+void DoneGzip()
+{
+    delete gs_gzip;
+    gs_gzip = nullptr;
+}
+
+bool InflateAll(unsigned threads)
+{
+    Bench::SetBytesPerRun(gs_dataSize);
+
+    wxMemoryInputStream mis(gs_gzip->GetOutputStreamBuffer()->GetBufferStart(),
+                            gs_gzip->GetLength());
+    wxZlibInputStream zis(mis, wxZLIB_GZIP_MULTI);
+    zis.SetThreadCount(threads);
+
+    char buf[65536];
+    wxUint64 total = 0;
+    while ( zis.IsOk() )
+        total += zis.Read(buf, sizeof(buf)).LastRead();
+
+    return zis.Eof() && total == gs_dataSize;
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC_WITH_INIT(GzipMultiMember, InitGzip, DoneGzip)
+{
+    return InflateAll(1);
+}
+
+BENCHMARK_FUNC_WITH_INIT(GzipMultiMemberParallel, InitGzip, DoneGzip)
+{
+    return InflateAll(0);
+}
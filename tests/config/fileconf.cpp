@@ -19,9 +19,18 @@
 #endif // WX_PRECOMP
 
 #include "wx/fileconf.h"
+#include "wx/ffile.h"
 #include "wx/sstream.h"
 #include "wx/log.h"
 
+#include "testfile.h"
+
+#include <memory>
+
+#ifdef __UNIX__
+    #include <sys/stat.h>
+#endif
+
 static const char *testconfig =
 "[root]\n"
 "entry=value\n"
@@ -626,6 +635,317 @@ TEST_CASE("wxFileConfig::ReadFloat", "[fileconfig][config]")
     CHECK( f == -9876.5432f );
 }
 
+TEST_CASE("wxFileConfig::UntouchedGroups", "[fileconfig][config]")
+{
+    // The entries of the groups are only parsed when they're accessed, check
+    // that everything works in the same way whether they were or not.
+    static const char *confInitial =
+        "; comment\n"
+        "rootentry=1\n"
+        "[a]\n"
+        "x = 1\n"
+        "# comment in a\n"
+        "y=2\n"
+        "[a/sub]\n"
+        "w=4\n"
+        "[b]\n"
+        "z=3\n";
+
+    wxStringInputStream sis(confInitial);
+    wxFileConfig fc(sis);
+
+    wxVERIFY_FILECONFIG( confInitial, fc );
+
+    CHECK( fc.Read("/b/z", "") == "3" );
+    CHECK( fc.Read("/B/Z", "") == "3" );
+    CHECK( fc.Read("/a/sub/w", "") == "4" );
+    wxVERIFY_FILECONFIG( confInitial, fc );
+
+    SECTION("Write")
+    {
+        fc.Write("/a/new", "5");
+        wxVERIFY_FILECONFIG( "; comment\n"
+                             "rootentry=1\n"
+                             "[a]\n"
+                             "x = 1\n"
+                             "# comment in a\n"
+                             "y=2\n"
+                             "new=5\n"
+                             "[a/sub]\n"
+                             "w=4\n"
+                             "[b]\n"
+                             "z=3\n",
+                             fc );
+
+        CheckGroupEntries(fc, "/a", 3, "new", "x", "y");
+    }
+
+    SECTION("AddGroup")
+    {
+        fc.Write("/a/sub2/v", "6");
+        wxVERIFY_FILECONFIG( "; comment\n"
+                             "rootentry=1\n"
+                             "[a]\n"
+                             "x = 1\n"
+                             "# comment in a\n"
+                             "y=2\n"
+                             "[a/sub]\n"
+                             "w=4\n"
+                             "[a/sub2]\n"
+                             "v=6\n"
+                             "[b]\n"
+                             "z=3\n",
+                             fc );
+
+        CheckGroupSubgroups(fc, "/a", 2, "sub", "sub2");
+    }
+
+    SECTION("DeleteGroup")
+    {
+        CHECK( fc.DeleteGroup("/a") );
+        wxVERIFY_FILECONFIG( "; comment\n"
+                             "rootentry=1\n"
+                             "# comment in a\n"
+                             "[b]\n"
+                             "z=3\n",
+                             fc );
+
+        CHECK( !fc.HasGroup("/a") );
+        CHECK( !fc.HasGroup("/a/sub") );
+        CHECK( !fc.HasEntry("/a/sub/w") );
+    }
+
+    SECTION("RenameGroup")
+    {
+        CHECK( fc.HasGroup("/a/sub") );
+
+        fc.SetPath("/a");
+        CHECK( fc.RenameGroup("sub", "sub2") );
+        fc.SetPath("/");
+
+        CHECK( !fc.HasGroup("/a/sub") );
+        CHECK( fc.Read("/a/sub2/w", "") == "4" );
+        wxVERIFY_FILECONFIG( "; comment\n"
+                             "rootentry=1\n"
+                             "[a]\n"
+                             "x = 1\n"
+                             "# comment in a\n"
+                             "y=2\n"
+                             "[a/sub2]\n"
+                             "w=4\n"
+                             "[b]\n"
+                             "z=3\n",
+                             fc );
+    }
+
+    SECTION("DeleteEntry")
+    {
+        CHECK( fc.DeleteEntry("/b/z") );
+        CHECK( !fc.HasGroup("/b") );
+        wxVERIFY_FILECONFIG( "; comment\n"
+                             "rootentry=1\n"
+                             "[a]\n"
+                             "x = 1\n"
+                             "# comment in a\n"
+                             "y=2\n"
+                             "[a/sub]\n"
+                             "w=4\n",
+                             fc );
+    }
+}
+
+TEST_CASE("wxFileConfig::LoadErrors", "[fileconfig][config]")
+{
+    // Collect the messages logged while the log target is active.
+    class CollectingLog : public wxLog
+    {
+    public:
+        CollectingLog()
+            : m_logOld(wxLog::SetActiveTarget(this))
+        {
+        }
+
+        virtual ~CollectingLog()
+        {
+            wxLog::SetActiveTarget(m_logOld);
+        }
+
+        wxArrayString m_messages;
+
+    protected:
+        virtual void DoLogTextAtLevel(wxLogLevel, const wxString& msg) override
+        {
+            m_messages.push_back(msg);
+        }
+
+        wxLog* m_logOld;
+    };
+
+    CollectingLog log;
+
+    wxStringInputStream sis("[a]\n"
+                            "x=1\n"
+                            "bad line\n"
+                            "x=2\n");
+    wxFileConfig fc(sis);
+
+    // The errors in the file must be reported when loading it, even if the
+    // entries are only parsed later, when they're accessed.
+    REQUIRE( log.m_messages.size() == 3 );
+    CHECK( log.m_messages[0].Contains("line 3: '=' expected") );
+    CHECK( log.m_messages[1].Contains("line 4: key 'x' was first found") );
+    CHECK( log.m_messages[2].Contains("entry 'x' appears more than once") );
+
+    // And they must not be reported again.
+    CHECK( fc.Read("/a/x", "") == "2" );
+    CHECK( log.m_messages.size() == 3 );
+}
+
+#if wxUSE_THREADS
+
+// Read the contents of the file written by wxFileConfig.
+static wxString ReadConfigFile(const wxString& path)
+{
+    wxString text;
+    wxFFile f(path);
+    if ( f.IsOpened() )
+        f.ReadAll(&text);
+
+    return wxTextFile::Translate(text, wxTextFileType_Unix);
+}
+
+TEST_CASE("wxFileConfig::WriteBehind", "[fileconfig][config]")
+{
+    TempFile tf(wxFileName::CreateTempFileName("fcwb"));
+    const wxString path = tf.GetName();
+    REQUIRE( !path.empty() );
+
+    std::unique_ptr<wxFileConfig>
+        fc(new wxFileConfig("", "", path, "", wxCONFIG_USE_LOCAL_FILE));
+
+    // Use a long delay to be sure that nothing is written before we wait.
+    fc->EnableWriteBehind(60000);
+    CHECK( fc->IsWriteBehindEnabled() );
+
+    fc->Write("/a/x", 1);
+    CHECK( fc->Flush() );
+    fc->Write("/a/y", 2);
+    CHECK( fc->Flush() );
+    CHECK( ReadConfigFile(path) == "" );
+
+    CHECK( fc->WaitForPendingWrites() );
+    CHECK( ReadConfigFile(path) == "[a]\nx=1\ny=2\n" );
+
+    fc->Write("/b/z", 3);
+    CHECK( fc->Flush() );
+    CHECK( ReadConfigFile(path) == "[a]\nx=1\ny=2\n" );
+
+    SECTION("Destroy")
+    {
+        // Flushed changes must be written even when autosave is disabled.
+        fc->DisableAutoSave();
+        fc->Write("/b/w", 4);
+        fc.reset();
+
+        CHECK( ReadConfigFile(path) == "[a]\nx=1\ny=2\n[b]\nz=3\n" );
+    }
+
+    SECTION("Disable")
+    {
+        fc->DisableWriteBehind();
+        CHECK( !fc->IsWriteBehindEnabled() );
+        CHECK( ReadConfigFile(path) == "[a]\nx=1\ny=2\n[b]\nz=3\n" );
+
+        fc->Write("/b/w", 4);
+        CHECK( fc->Flush() );
+        CHECK( ReadConfigFile(path) == "[a]\nx=1\ny=2\n[b]\nz=3\nw=4\n" );
+    }
+
+    SECTION("DeleteAll")
+    {
+        CHECK( fc->DeleteAll() );
+        CHECK( !wxFileExists(path) );
+
+        fc.reset();
+        CHECK( !wxFileExists(path) );
+
+        // There is nothing to remove any more.
+        tf.Assign(wxString());
+    }
+}
+
+#ifdef __UNIX__
+
+// Return the permissions of the given file.
+static int GetFileMode(const wxString& path)
+{
+    wxStructStat st;
+    if ( wxStat(path, &st) != 0 )
+        return -1;
+
+    return st.st_mode & 0777;
+}
+
+TEST_CASE("wxFileConfig::WriteBehindPermissions", "[fileconfig][config]")
+{
+    TempFile tf(wxFileName::CreateTempFileName("fcwb"));
+    const wxString path = tf.GetName();
+    REQUIRE( !path.empty() );
+
+    SECTION("New")
+    {
+        REQUIRE( wxRemoveFile(path) );
+
+        wxFileConfig fc("", "", path, "", wxCONFIG_USE_LOCAL_FILE);
+        fc.SetUmask(0077);
+        fc.EnableWriteBehind(1);
+
+        fc.Write("/a/x", 1);
+        CHECK( fc.Flush() );
+        CHECK( fc.WaitForPendingWrites() );
+
+        CHECK( GetFileMode(path) == 0600 );
+    }
+
+    SECTION("Default")
+    {
+        REQUIRE( wxRemoveFile(path) );
+
+        // The process umask must be used if it's not set explicitly.
+        const mode_t umaskOrig = umask(0027);
+
+        wxFileConfig fc("", "", path, "", wxCONFIG_USE_LOCAL_FILE);
+        fc.EnableWriteBehind(1);
+
+        fc.Write("/a/x", 1);
+        CHECK( fc.Flush() );
+        CHECK( fc.WaitForPendingWrites() );
+
+        umask(umaskOrig);
+
+        CHECK( GetFileMode(path) == 0640 );
+    }
+
+    SECTION("Existing")
+    {
+        REQUIRE( chmod(path.fn_str(), 0640) == 0 );
+
+        wxFileConfig fc("", "", path, "", wxCONFIG_USE_LOCAL_FILE);
+        fc.SetUmask(0077);
+        fc.EnableWriteBehind(1);
+
+        fc.Write("/a/x", 1);
+        CHECK( fc.Flush() );
+        CHECK( fc.WaitForPendingWrites() );
+
+        CHECK( GetFileMode(path) == 0640 );
+    }
+}
+
+#endif // __UNIX__
+
+#endif // wxUSE_THREADS
+
 TEST_CASE("wxFileConfig::LongLong", "[fileconfig][config][longlong]")
 {
     wxFileConfig fc("", "", "", "", 0); // Don't use any files.
@@ -24,6 +24,10 @@
 
 #include "wx/private/localeset.h"
 
+#ifdef __UNIX__
+    #include "wx/unix/private/tzinfo.h"
+#endif
+
 // to test Today() meaningfully we must be able to change the system date which
 // is not usually the case, but if we're under Win32 we can try it -- define
 // the macro below to do it
@@ -823,6 +827,14 @@ TEST_CASE("wxDateTime::ParseFormat", "[datetime]")
         CHECK( dt.GetDay() == 23 );
     }
 
+    SECTION("%w")
+    {
+        REQUIRE( dt.ParseFormat("2024-05-17 5", "%Y-%m-%d %w") );
+        CHECK( dt.GetWeekDay() == wxDateTime::Fri );
+
+        CHECK( !dt.ParseFormat("2024-05-17 4", "%Y-%m-%d %w") );
+    }
+
     SECTION("%-")
     {
         REQUIRE( dt.ParseFormat("17.5.2024", "%-d.%-m.%Y") );
@@ -882,6 +894,207 @@ TEST_CASE("wxDateTime::ParseFormat", "[datetime]")
     }
 }
 
+// Return true if the format can only be used for the dates in the range
+// supported by strftime() as wxDateTime::Format() doesn't support it otherwise.
+static bool NeedsStrftime(const char* format)
+{
+    return strstr(format, "%e") || strstr(format, "%R") || strstr(format, "%T");
+}
+
+TEST_CASE("wxDateTimeFormatter", "[datetime][formatter]")
+{
+    static const char* const formats[] =
+    {
+        "%Y-%m-%d %H:%M:%S",
+        "%Y-%m-%dT%H:%M:%S.%l",
+        "%F %T",
+        "%d/%m/%y %I:%M %p",
+        "%A, %d %B %Y",
+        "%a %b %e %H:%M:%S %Y",
+        "Day %j of %Y, week day %w",
+        "%H:%M:%S %z",
+        "%c",
+        "%x %X",
+        "100%% at %R",
+        "%4Y.%2m.%2d",
+        "%-d.%-m.%Y",
+        "[%Y]  %H",
+    };
+
+    wxGCC_WARNING_SUPPRESS(missing-field-initializers)
+
+    static const Date dates[] =
+    {
+        { 29, wxDateTime::May, 1976, 18, 30, 00 },
+        {  1, wxDateTime::Jan, 2000,  0,  0,  0 },
+        { 31, wxDateTime::Dec, 1999, 23, 59, 59 },
+        { 15, wxDateTime::Jul, 2024, 12,  5,  9 },
+        {  6, wxDateTime::Feb, 1856,  2,  3,  4 },
+        { 29, wxDateTime::Feb, 2400,  4, 15, 25 },
+    };
+
+    wxGCC_WARNING_RESTORE(missing-field-initializers)
+
+    const wxDateTime::TimeZone timeZones[] =
+    {
+        wxDateTime::Local,
+        wxDateTime::UTC,
+        wxDateTime::TimeZone(-(3600 + 2*60)),
+    };
+
+    SECTION("Format")
+    {
+        for ( size_t n = 0; n < WXSIZEOF(formats); n++ )
+        {
+            const wxDateTimeFormatter formatter(formats[n]);
+            CHECK( formatter.GetFormat() == formats[n] );
+
+            for ( size_t d = 0; d < WXSIZEOF(dates); d++ )
+            {
+                wxDateTime dt = dates[d].DT();
+                dt.SetMillisecond(7*d);
+
+                for ( size_t t = 0; t < WXSIZEOF(timeZones); t++ )
+                {
+                    if ( dt.GetTicks() == -1 && NeedsStrftime(formats[n]) )
+                        continue;
+
+                    INFO("Format \"" << formats[n] << "\" for " << dt
+                         << " in time zone #" << t);
+                    CHECK( formatter.Format(dt, timeZones[t]) ==
+                                dt.Format(formats[n], timeZones[t]) );
+                }
+            }
+        }
+
+        // FormatTo() appends to the existing string.
+        const wxDateTimeFormatter formatter("%Y-%m-%d");
+        wxString s("Date: ");
+        formatter.FormatTo(s, wxDateTime(17, wxDateTime::May, 2024));
+        CHECK( s == "Date: 2024-05-17" );
+    }
+
+    SECTION("Parse")
+    {
+        const wxDateTime dtDef(26, wxDateTime::Sep, 2008, 10, 20, 30);
+
+        for ( size_t n = 0; n < WXSIZEOF(formats); n++ )
+        {
+            const wxDateTimeFormatter formatter(formats[n]);
+
+            for ( size_t d = 0; d < WXSIZEOF(dates); d++ )
+            {
+                wxDateTime dt = dates[d].DT();
+                if ( dt.GetTicks() == -1 && NeedsStrftime(formats[n]) )
+                    continue;
+
+                // Check that the formatted string, a prefix of it and the
+                // string with some extra text are parsed in the same way.
+                const wxString s = dt.Format(formats[n]);
+                const wxString strings[] =
+                {
+                    s,
+                    s.substr(0, s.length() / 2),
+                    s + " and more",
+                    "x" + s,
+                };
+
+                for ( size_t i = 0; i < WXSIZEOF(strings); i++ )
+                {
+                    INFO("Parsing \"" << strings[i] << "\" using \""
+                         << formats[n] << "\"");
+
+                    wxDateTime dt1, dt2;
+                    wxString::const_iterator end1, end2;
+                    const bool ok1 = dt1.ParseFormat(strings[i], formats[n],
+                                                     dtDef, &end1);
+                    const bool ok2 = formatter.Parse(strings[i], &dt2,
+                                                     dtDef, &end2);
+                    REQUIRE( ok1 == ok2 );
+                    if ( ok1 )
+                    {
+                        CHECK( dt1 == dt2 );
+                        CHECK( end1 == end2 );
+                    }
+
+                    // Without the end iterator the entire string must match.
+                    wxDateTime dt3;
+                    CHECK( formatter.Parse(strings[i], &dt3, dtDef) ==
+                                (ok1 && end1 == strings[i].end()) );
+                }
+            }
+        }
+
+        // Invalid inputs.
+        const wxDateTimeFormatter formatter("%Y-%m-%d %H:%M");
+        wxDateTime dt;
+        CHECK( !formatter.Parse("2024-02-30 12:00", &dt) );
+        CHECK( !formatter.Parse("2024-13-01 12:00", &dt) );
+        CHECK( !formatter.Parse("2024-01-01 24:00", &dt) );
+        CHECK( !formatter.Parse("", &dt) );
+        CHECK( !dt.IsValid() );
+
+        REQUIRE( formatter.Parse("2024-05-17   7:08", &dt) );
+        CHECK( dt == wxDateTime(17, wxDateTime::May, 2024, 7, 8) );
+
+        // Partially specified dates use the default date.
+        const wxDateTimeFormatter formatterTime("%H:%M");
+        REQUIRE( formatterTime.Parse("17:45", &dt, dtDef) );
+        CHECK( dt == wxDateTime(26, wxDateTime::Sep, 2008, 17, 45, 30) );
+
+        // Or the date itself if it's valid.
+        dt = wxDateTime(1, wxDateTime::Mar, 2012, 1, 2, 3);
+        REQUIRE( formatterTime.Parse("17:45", &dt) );
+        CHECK( dt == wxDateTime(1, wxDateTime::Mar, 2012, 17, 45, 3) );
+
+        // Or today.
+        dt = wxDateTime();
+        REQUIRE( formatterTime.Parse("17:45", &dt) );
+        CHECK( dt.IsSameDate(wxDateTime::Today()) );
+
+        // Check that the week day is verified.
+        const wxDateTimeFormatter formatterWDay("%Y-%m-%d %w");
+        CHECK( formatterWDay.Parse("2024-05-17 5", &dt) );
+        CHECK( !formatterWDay.Parse("2024-05-17 4", &dt) );
+        CHECK( !formatterWDay.Parse("2024-05-17 7", &dt) );
+    }
+
+    SECTION("ParseAll")
+    {
+        const wxDateTimeFormatter formatter("%Y-%m-%d %H:%M:%S");
+
+        std::vector<wxString> strings;
+        strings.push_back("2024-05-17 12:34:56");
+        strings.push_back("2024-05-17 12:34");
+        strings.push_back("1976-05-29 18:30:00");
+        strings.push_back("1976-05-29 18:30:00 and more");
+        strings.push_back("2400-02-29 04:15:25");
+
+        std::vector<wxDateTime> dates;
+        CHECK( formatter.ParseAll(strings, dates) == 3 );
+        REQUIRE( dates.size() == strings.size() );
+        CHECK( dates[0] == wxDateTime(17, wxDateTime::May, 2024, 12, 34, 56) );
+        CHECK( !dates[1].IsValid() );
+        CHECK( dates[2] == wxDateTime(29, wxDateTime::May, 1976, 18, 30) );
+        CHECK( !dates[3].IsValid() );
+        CHECK( dates[4] == wxDateTime(29, wxDateTime::Feb, 2400, 4, 15, 25) );
+
+        // The default date is used for the missing fields.
+        const wxDateTimeFormatter formatterTime("%H:%M");
+        strings.assign(1, "12:34");
+        CHECK( formatterTime.ParseAll(strings, dates,
+                    wxDateTime(1, wxDateTime::Mar, 2012)) == 1 );
+        CHECK( dates[0] == wxDateTime(1, wxDateTime::Mar, 2012, 12, 34) );
+
+        // This also works for the formats not handled by the formatter itself.
+        const wxDateTimeFormatter formatterLocale("%x");
+        const wxDateTime dt(17, wxDateTime::May, 2024);
+        strings.assign(1, dt.Format("%x"));
+        CHECK( formatterLocale.ParseAll(strings, dates) == 1 );
+        CHECK( dates[0].IsSameDate(dt) );
+    }
+}
+
 // Test parsing time in free format.
 TEST_CASE("wxDateTime::TimeParse", "[datetime]")
 {
@@ -2587,4 +2800,190 @@ TEST_CASE("Christian Holidays", "[datetime][holiday][christian]")
     }
 }
 
+#ifdef wxHAS_TIMEZONEINFO
+
+namespace
+{
+
+// Temporarily change TZ environment variable.
+class TZSetter
+{
+public:
+    explicit TZSetter(const char* tz)
+    {
+        m_wasSet = wxGetEnv("TZ", &m_tzOld);
+        wxSetEnv("TZ", tz);
+        tzset();
+    }
+
+    ~TZSetter()
+    {
+        if ( m_wasSet )
+            wxSetEnv("TZ", m_tzOld);
+        else
+            wxUnsetEnv("TZ");
+        tzset();
+    }
+
+private:
+    bool m_wasSet;
+    wxString m_tzOld;
+
+    wxDECLARE_NO_COPY_CLASS(TZSetter);
+};
+
+wxString TmToString(const struct tm& tm)
+{
+    return wxString::Format("%04d-%02d-%02d %02d:%02d:%02d (wday=%d yday=%d "
+                            "dst=%d offset=%ld %s)",
+                            tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday,
+                            tm.tm_hour, tm.tm_min, tm.tm_sec,
+                            tm.tm_wday, tm.tm_yday, tm.tm_isdst,
+                            static_cast<long>(tm.tm_gmtoff), tm.tm_zone);
+}
+
+} // anonymous namespace
+
+// Check that wxTimeZoneInfo gives the same results as the CRT functions.
+TEST_CASE("wxTimeZoneInfo::CRT", "[datetime][tz]")
+{
+    const char* const zones[] =
+    {
+        "Europe/Paris",
+        "Europe/London",
+        "America/New_York",
+        "America/Sao_Paulo",
+        "Australia/Sydney",
+        "Asia/Kolkata",
+        "Pacific/Chatham",
+        "EST5EDT",
+        "CET-1CEST,M3.5.0,M10.5.0/3",
+        "NZST-12NZDT,M9.5.0,M4.1.0/3",
+        "<+0330>-3:30",
+    };
+
+    for ( const char* zone : zones )
+    {
+        const wxTimeZoneInfo* const info = wxTimeZoneInfo::Get(zone);
+        if ( !info )
+        {
+            WARN("Skipping zone \"" << zone << "\" which is not available.");
+            continue;
+        }
+
+        TZSetter setTZ(zone);
+
+        // Use a small step for the last years to test the transitions and
+        // a big one for the rest.
+        for ( wxInt64 t = 0; t < 2000000000; )
+        {
+            const time_t ticks = static_cast<time_t>(t);
+            struct tm tmCRT;
+            REQUIRE( localtime_r(&ticks, &tmCRT) );
+
+            struct tm tm;
+            info->ToLocal(t, tm);
+
+            INFO("Zone \"" << zone << "\", time " << t);
+            CHECK( TmToString(tm) == TmToString(tmCRT) );
+
+            // As DST is specified, the conversion back is unambiguous.
+            struct tm tmBack(tm);
+            tmBack.tm_hour += 25;
+            tmBack.tm_min -= 61;
+            tmBack.tm_wday =
+            tmBack.tm_yday = 0;
+
+            struct tm tmBackCRT(tmBack);
+            const time_t ticksCRT = mktime(&tmBackCRT);
+            CHECK( info->FromLocal(tmBack) == ticksCRT );
+            CHECK( TmToString(tmBack) == TmToString(tmBackCRT) );
+
+            t += t < 1700000000 ? 987653 : 3607;
+        }
+    }
+}
+
+TEST_CASE("wxTimeZoneInfo::FromLocal", "[datetime][tz]")
+{
+    const wxTimeZoneInfo* const info = wxTimeZoneInfo::Get("Europe/Paris");
+    if ( !info )
+        return;
+
+    struct tm tm;
+    memset(&tm, 0, sizeof(tm));
+    tm.tm_year = 124;
+    tm.tm_isdst = -1;
+
+    SECTION("Gap")
+    {
+        // 2:30 doesn't exist on 2024-03-31 and becomes 3:30 CEST.
+        tm.tm_mon = 2;
+        tm.tm_mday = 31;
+        tm.tm_hour = 2;
+        tm.tm_min = 30;
+        CHECK( info->FromLocal(tm) == 1711848600 );
+        CHECK( tm.tm_hour == 3 );
+        CHECK( tm.tm_isdst == 1 );
+    }
+
+    SECTION("Overlap")
+    {
+        // 2:30 happens twice on 2024-10-27, standard time is used by default.
+        tm.tm_mon = 9;
+        tm.tm_mday = 27;
+        tm.tm_hour = 2;
+        tm.tm_min = 30;
+        CHECK( info->FromLocal(tm) == 1729992600 );
+        CHECK( tm.tm_hour == 2 );
+        CHECK( tm.tm_isdst == 0 );
+
+        tm.tm_isdst = 1;
+        CHECK( info->FromLocal(tm) == 1729989000 );
+        CHECK( tm.tm_hour == 2 );
+        CHECK( tm.tm_isdst == 1 );
+    }
+
+    SECTION("Normalize")
+    {
+        tm.tm_mon = 13;
+        tm.tm_mday = 0;
+        tm.tm_hour = -1;
+        CHECK( info->FromLocal(tm) == 1738274400 );
+        CHECK( TmToString(tm) == "2025-01-30 23:00:00 (wday=4 yday=29 "
+                                 "dst=0 offset=3600 CET)" );
+    }
+}
+
+TEST_CASE("wxTimeZoneInfo::Invalid", "[datetime][tz]")
+{
+    CHECK( !wxTimeZoneInfo::Get("No/Such/Zone") );
+    CHECK( !wxTimeZoneInfo::Get("ABC") );
+    CHECK( !wxTimeZoneInfo::Get("ABC-1DEF,M3") );
+    CHECK( !wxTimeZoneInfo::Get("../../etc/passwd") );
+}
+
+#endif // wxHAS_TIMEZONEINFO
+
+// Accessing the fields of the same date repeatedly uses the cached Tm, check
+// that the cache doesn't return stale results.
+TEST_CASE("wxDateTime::GetTmCache", "[datetime]")
+{
+    // 2020-07-15 12:34:56.789 UTC
+    wxDateTime dt(wxLongLong(wxLL(1594816496789)));
+    CHECK( dt.GetHour(wxDateTime::UTC) == 12 );
+    CHECK( dt.GetHour(wxDateTime::TimeZone(5*3600)) == 17 );
+    CHECK( dt.GetMinute(wxDateTime::TimeZone(5*3600)) == 34 );
+    CHECK( dt.GetHour(wxDateTime::TimeZone(-3*3600)) == 9 );
+    CHECK( dt.GetMillisecond(wxDateTime::UTC) == 789 );
+
+    const wxDateTime dt2 = dt + wxTimeSpan::Day();
+    CHECK( dt2.GetDay(wxDateTime::UTC) == 16 );
+    CHECK( dt.GetDay(wxDateTime::UTC) == 15 );
+
+    dt.SetDay(20);
+    CHECK( dt.GetDay() == 20 );
+    CHECK( dt.GetMonth() == wxDateTime::Jul );
+}
+
 #endif // wxUSE_DATETIME
@@ -0,0 +1,324 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/events/fdiodispatcher.cpp
+// Purpose:     Test the io_uring-based wxFDIODispatcher
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+#include "wx/unix/private/iouringdispatcher.h"
+
+#if wxUSE_EPOLL_DISPATCHER && defined(wxHAS_IO_URING)
+
+#include "wx/private/fdiohandler.h"
+#include "wx/thread.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <memory>
+
+namespace
+{
+
+// A pipe counting the events for both of its ends.
+class TestPipe
+{
+public:
+    TestPipe()
+        : m_reader(this, true),
+          m_writer(this, false)
+    {
+        if ( pipe(m_fds) == 0 )
+            fcntl(m_fds[0], F_SETFL, O_NONBLOCK);
+        else
+            m_fds[0] = m_fds[1] = -1;
+    }
+
+    ~TestPipe()
+    {
+        if ( IsOk() )
+        {
+            close(m_fds[0]);
+            close(m_fds[1]);
+        }
+    }
+
+    bool IsOk() const { return m_fds[0] != -1; }
+
+    int GetReadFD() const { return m_fds[0]; }
+    int GetWriteFD() const { return m_fds[1]; }
+
+    wxFDIOHandler* GetReader() { return &m_reader; }
+    wxFDIOHandler* GetWriter() { return &m_writer; }
+
+    bool Write(const char* data)
+    {
+        const ssize_t len = strlen(data);
+        return write(m_fds[1], data, len) == len;
+    }
+
+    // The number of times the handlers were called.
+    int m_numRead = 0;
+    int m_numWrite = 0;
+
+private:
+    // The handler reads a single byte each time it's called, so that the
+    // events for the remaining data must be reported too.
+    class Handler : public wxFDIOHandler
+    {
+    public:
+        Handler(TestPipe* pipe, bool reader)
+            : m_pipe(pipe),
+              m_reader(reader)
+        {
+        }
+
+        virtual void OnReadWaiting() override
+        {
+            if ( m_reader )
+            {
+                char ch;
+                if ( read(m_pipe->m_fds[0], &ch, 1) == 1 )
+                    m_pipe->m_numRead++;
+            }
+        }
+
+        virtual void OnWriteWaiting() override
+        {
+            m_pipe->m_numWrite++;
+        }
+
+        virtual void OnExceptionWaiting() override
+        {
+        }
+
+    private:
+        TestPipe* const m_pipe;
+        const bool m_reader;
+    };
+
+    int m_fds[2];
+    Handler m_reader,
+            m_writer;
+
+    wxDECLARE_NO_COPY_CLASS(TestPipe);
+};
+
+// Create the dispatcher, returns null if io_uring can't be used.
+wxIoUringDispatcher* CreateDispatcher()
+{
+    wxIoUringDispatcher* const dispatcher = wxIoUringDispatcher::Create();
+    if ( !dispatcher )
+        WARN("Skipping the test as io_uring is not available.");
+
+    return dispatcher;
+}
+
+#if wxUSE_THREADS
+
+// Thread registering the descriptor and exiting immediately after it, which
+// cancels all the io_uring requests submitted by it.
+class RegisterThread : public wxThread
+{
+public:
+    RegisterThread(wxFDIODispatcher& dispatcher, TestPipe& pipe)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_dispatcher(dispatcher),
+          m_pipe(pipe)
+    {
+    }
+
+    virtual void* Entry() override
+    {
+        // Give the main thread time to start waiting in Dispatch(), to make
+        // sure that the request is submitted by this thread.
+        wxMilliSleep(50);
+
+        m_ok = m_dispatcher.RegisterFD(m_pipe.GetReadFD(), m_pipe.GetReader(),
+                                       wxFDIO_INPUT);
+
+        return nullptr;
+    }
+
+    bool m_ok = false;
+
+private:
+    wxFDIODispatcher& m_dispatcher;
+    TestPipe& m_pipe;
+};
+
+#endif // wxUSE_THREADS
+
+} // anonymous namespace
+
+TEST_CASE("IoUringDispatcher::Register", "[fdio]")
+{
+    std::unique_ptr<wxIoUringDispatcher> dispatcher(CreateDispatcher());
+    if ( !dispatcher )
+        return;
+
+    TestPipe pipe;
+    REQUIRE( pipe.IsOk() );
+
+    REQUIRE( dispatcher->RegisterFD(pipe.GetReadFD(), pipe.GetReader(),
+                                    wxFDIO_INPUT) );
+
+    CHECK( dispatcher->Dispatch(0) == 0 );
+    CHECK( !dispatcher->HasPending() );
+
+    REQUIRE( pipe.Write("x") );
+    CHECK( dispatcher->Dispatch(1000) == 1 );
+    CHECK( pipe.m_numRead == 1 );
+
+    SECTION("Duplicate")
+    {
+        wxLogNull noLog;
+        CHECK( !dispatcher->RegisterFD(pipe.GetReadFD(), pipe.GetReader()) );
+    }
+
+    SECTION("Unregister")
+    {
+        CHECK( dispatcher->UnregisterFD(pipe.GetReadFD()) );
+
+        REQUIRE( pipe.Write("x") );
+        CHECK( dispatcher->Dispatch(100) == 0 );
+        CHECK( !dispatcher->HasPending() );
+        CHECK( pipe.m_numRead == 1 );
+
+        // Registering the descriptor again must work.
+        CHECK( dispatcher->RegisterFD(pipe.GetReadFD(), pipe.GetReader(),
+                                      wxFDIO_INPUT) );
+        CHECK( dispatcher->Dispatch(1000) == 1 );
+        CHECK( pipe.m_numRead == 2 );
+
+        CHECK( dispatcher->UnregisterFD(pipe.GetReadFD()) );
+
+        wxLogNull noLog;
+        CHECK( !dispatcher->UnregisterFD(pipe.GetReadFD()) );
+    }
+}
+
+TEST_CASE("IoUringDispatcher::Modify", "[fdio]")
+{
+    std::unique_ptr<wxIoUringDispatcher> dispatcher(CreateDispatcher());
+    if ( !dispatcher )
+        return;
+
+    TestPipe pipe;
+    REQUIRE( pipe.IsOk() );
+
+    SECTION("Flags")
+    {
+        // The write end of the pipe never becomes readable.
+        REQUIRE( dispatcher->RegisterFD(pipe.GetWriteFD(), pipe.GetWriter(),
+                                        wxFDIO_INPUT) );
+        CHECK( dispatcher->Dispatch(100) == 0 );
+        CHECK( pipe.m_numWrite == 0 );
+
+        CHECK( dispatcher->ModifyFD(pipe.GetWriteFD(), pipe.GetWriter(),
+                                    wxFDIO_OUTPUT) );
+        CHECK( dispatcher->Dispatch(1000) == 1 );
+        CHECK( pipe.m_numWrite == 1 );
+
+        CHECK( dispatcher->ModifyFD(pipe.GetWriteFD(), pipe.GetWriter(),
+                                    wxFDIO_INPUT) );
+        CHECK( dispatcher->Dispatch(100) == 0 );
+        CHECK( pipe.m_numWrite == 1 );
+    }
+
+    SECTION("Pending")
+    {
+        REQUIRE( dispatcher->RegisterFD(pipe.GetReadFD(), pipe.GetReader(),
+                                        wxFDIO_INPUT) );
+
+        // HasPending() harvests the event, which must not prevent the event
+        // from being reported by the new request after changing the flags.
+        REQUIRE( pipe.Write("x") );
+        for ( int n = 0; n < 100 && !dispatcher->HasPending(); n++ )
+            wxMilliSleep(10);
+        REQUIRE( dispatcher->HasPending() );
+
+        CHECK( dispatcher->ModifyFD(pipe.GetReadFD(), pipe.GetReader(),
+                                    wxFDIO_INPUT | wxFDIO_EXCEPTION) );
+        CHECK( dispatcher->Dispatch(1000) == 1 );
+        CHECK( pipe.m_numRead == 1 );
+
+        REQUIRE( pipe.Write("x") );
+        CHECK( dispatcher->Dispatch(1000) == 1 );
+        CHECK( pipe.m_numRead == 2 );
+    }
+}
+
+TEST_CASE("IoUringDispatcher::Rearm", "[fdio]")
+{
+    std::unique_ptr<wxIoUringDispatcher> dispatcher(CreateDispatcher());
+    if ( !dispatcher )
+        return;
+
+    TestPipe pipe;
+    REQUIRE( pipe.IsOk() );
+
+    SECTION("Multishot")
+    {
+        REQUIRE( dispatcher->RegisterFD(pipe.GetReadFD(), pipe.GetReader(),
+                                        wxFDIO_INPUT) );
+
+        // The same request must keep reporting the events.
+        for ( int n = 1; n <= 100; n++ )
+        {
+            REQUIRE( pipe.Write("x") );
+            REQUIRE( dispatcher->Dispatch(1000) == 1 );
+            REQUIRE( pipe.m_numRead == n );
+        }
+
+        CHECK( dispatcher->Dispatch(0) == 0 );
+    }
+
+    SECTION("LevelTriggered")
+    {
+        REQUIRE( dispatcher->RegisterFD(pipe.GetReadFD(), pipe.GetReader(),
+                                        wxFDIO_INPUT) );
+
+        // The handler only reads one byte at a time, so the descriptor
+        // remains readable after the first event and must be reported again
+        // even though its state didn't change.
+        REQUIRE( pipe.Write("xyz") );
+        CHECK( dispatcher->Dispatch(1000) == 1 );
+        CHECK( dispatcher->Dispatch(1000) == 1 );
+        CHECK( dispatcher->Dispatch(1000) == 1 );
+        CHECK( pipe.m_numRead == 3 );
+
+        CHECK( dispatcher->Dispatch(0) == 0 );
+        CHECK( !dispatcher->HasPending() );
+    }
+
+#if wxUSE_THREADS
+    SECTION("Cancelled")
+    {
+        RegisterThread thread(*dispatcher, pipe);
+        REQUIRE( thread.Run() == wxTHREAD_NO_ERROR );
+
+        // The request is submitted by the thread if we're waiting when it
+        // registers the descriptor and is cancelled when it exits.
+        CHECK( dispatcher->Dispatch(200) == 0 );
+        thread.Wait();
+        REQUIRE( thread.m_ok );
+
+        // The cancelled request must be submitted again.
+        REQUIRE( pipe.Write("x") );
+        CHECK( dispatcher->Dispatch(1000) == 1 );
+        CHECK( pipe.m_numRead == 1 );
+    }
+#endif // wxUSE_THREADS
+}
+
+#endif // wxUSE_EPOLL_DISPATCHER && wxHAS_IO_URING
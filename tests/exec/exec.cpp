@@ -372,6 +372,71 @@ TEST_CASE_METHOD(ExecTestCase, "wxExecute::AsyncRedirect", "[exec]")
     DoTestAsyncRedirect(COMMAND_STDERR, Check_Stderr, "file");
 }
 
+// This class collects the lines of the child process output.
+class TestLinesProcess : public wxProcess
+{
+public:
+    TestLinesProcess()
+    {
+        RedirectLines();
+    }
+
+    virtual void OnOutputLine(const wxString& line) override
+    {
+        m_output.push_back(line);
+    }
+
+    virtual void OnErrorLine(const wxString& line) override
+    {
+        m_error.push_back(line);
+    }
+
+    wxArrayString m_output,
+                  m_error;
+
+private:
+    wxDECLARE_NO_COPY_CLASS(TestLinesProcess);
+};
+
+TEST_CASE_METHOD(ExecTestCase, "wxExecute::RedirectLines", "[exec]")
+{
+    int flags = wxEXEC_SYNC;
+
+    SECTION("With events")
+    {
+    }
+
+    SECTION("Without events")
+    {
+        flags |= wxEXEC_NOEVENTS;
+    }
+
+    TestLinesProcess proc;
+    CHECK( wxExecute(COMMAND, flags, &proc) == 0 );
+    REQUIRE( proc.m_output.size() == 1 );
+    CHECK( proc.m_output[0] == "hi" );
+    CHECK( proc.m_error.empty() );
+
+    // The entire output must have been consumed.
+    REQUIRE( proc.GetInputStream() );
+    CHECK( proc.GetInputStream()->Eof() );
+
+    TestLinesProcess procErr;
+    CHECK( wxExecute(COMMAND_STDERR, flags, &procErr) != 0 );
+    CHECK( procErr.m_output.empty() );
+    REQUIRE( !procErr.m_error.empty() );
+    CHECK( procErr.m_error[0].Contains("file") );
+
+#ifdef __UNIX__
+    // Check that producing more output than fits into the pipe buffer works.
+    TestLinesProcess procMany;
+    CHECK( wxExecute("seq 100000", flags, &procMany) == 0 );
+    REQUIRE( procMany.m_output.size() == 100000 );
+    CHECK( procMany.m_output[0] == "1" );
+    CHECK( procMany.m_output[99999] == "100000" );
+#endif // __UNIX__
+}
+
 // static
 wxString ExecTestCase::CreateSleepFile(const wxString& basename, int seconds)
 {
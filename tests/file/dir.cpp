@@ -180,6 +180,88 @@ TEST_CASE_METHOD(DirTestCase, "Dir::Traverse", "[dir]")
     CHECK( traverser.dirs.size() == 6 );
 }
 
+// Traverser recording all the callbacks and optionally skipping some dirs.
+class RecordingDirTraverser : public wxDirTraverser
+{
+public:
+    explicit RecordingDirTraverser(const wxString& ignore = wxString())
+        : m_ignore(ignore)
+    {
+    }
+
+    wxArrayString calls;
+
+    virtual wxDirTraverseResult OnFile(const wxString& filename) override
+    {
+        calls.push_back("file " + filename);
+        return wxDIR_CONTINUE;
+    }
+
+    virtual wxDirTraverseResult OnDir(const wxString& dirname) override
+    {
+        calls.push_back("dir " + dirname);
+        return dirname.EndsWith(SEP + m_ignore) ? wxDIR_IGNORE : wxDIR_CONTINUE;
+    }
+
+private:
+    const wxString m_ignore;
+};
+
+TEST_CASE_METHOD(DirTestCase, "Dir::TraverseParallel", "[dir]")
+{
+    // add more directories to have something to do in parallel
+    for ( int n = 0; n < 20; n++ )
+    {
+        const wxString path = wxString::Format("%s%cfolder2%cmore%d",
+                                               DIRTEST_FOLDER, SEP, SEP, n);
+        REQUIRE( wxDir::Make(path + SEP + "sub", wxS_DIR_DEFAULT,
+                             wxPATH_MKDIR_FULL) );
+        CreateTempFile(path + SEP + "file");
+        CreateTempFile(path + SEP + "sub" + SEP + "file.foo");
+    }
+
+    wxString ignore;
+    SECTION("All") { }
+    SECTION("Ignore") { ignore = "more7"; }
+    SECTION("Ignore top") { ignore = "folder2"; }
+
+    wxString filespec;
+    SECTION("All files") { }
+    SECTION("Filter") { filespec = "*.foo"; }
+
+    wxDir dir(DIRTEST_FOLDER);
+
+    RecordingDirTraverser serial(ignore);
+    const size_t numFiles = dir.Traverse(serial, filespec);
+
+    // the ordered parallel traversal must call the traverser exactly in the
+    // same way as the serial one
+    RecordingDirTraverser ordered(ignore);
+    CHECK( dir.Traverse(ordered, filespec,
+                        wxDIR_DEFAULT | wxDIR_PARALLEL) == numFiles );
+    CHECK( ordered.calls == serial.calls );
+
+    // but the unordered one only guarantees getting the same calls
+    RecordingDirTraverser unordered(ignore);
+    CHECK( dir.Traverse(unordered, filespec,
+                        wxDIR_DEFAULT | wxDIR_PARALLEL | wxDIR_UNORDERED)
+            == numFiles );
+    unordered.calls.Sort();
+    serial.calls.Sort();
+    CHECK( unordered.calls == serial.calls );
+
+    // wxDir::GetAllFiles() doesn't ignore anything, so compare it with the
+    // serial version of itself
+    wxArrayString files;
+    const size_t numAllFiles = wxDir::GetAllFiles(DIRTEST_FOLDER, &files,
+                                                  filespec);
+
+    wxArrayString filesParallel;
+    CHECK( wxDir::GetAllFiles(DIRTEST_FOLDER, &filesParallel, filespec,
+                              wxDIR_DEFAULT | wxDIR_PARALLEL) == numAllFiles );
+    CHECK( filesParallel == files );
+}
+
 TEST_CASE_METHOD(DirTestCase, "Dir::Exists", "[dir]")
 {
     struct
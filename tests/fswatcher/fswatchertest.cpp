@@ -27,6 +27,10 @@
 #include "wx/stdpaths.h"
 #include "wx/vector.h"
 
+#ifdef wxHAS_INOTIFY
+    #include "wx/private/fswatcher.h"
+#endif
+
 #include "testfile.h"
 
 #include <memory>
@@ -627,6 +631,144 @@ TEST_CASE_METHOD(FileSystemWatcherTestCase,
     EventTester tester;
     tester.Run();
 }
+
+// ----------------------------------------------------------------------------
+// TestTreeEventRename: check that renames are reported inside the trees
+// ----------------------------------------------------------------------------
+
+TEST_CASE_METHOD(FileSystemWatcherTestCase,
+                 "wxFileSystemWatcher::TreeEventRename", "[fsw]")
+{
+    class EventTester : public FSWTesterBase
+    {
+    public:
+        virtual bool Init() override
+        {
+            CHECK(wxEventLoopBase::GetActive());
+
+            m_watcher.reset(new wxFileSystemWatcher());
+            m_watcher->SetOwner(this);
+
+            // Use either fanotify or inotify watches for all subdirectories.
+            CHECK(m_watcher->AddTree(EventGenerator::GetWatchDir(),
+                                     m_eventTypes));
+
+            return true;
+        }
+
+        virtual void GenerateEvent() override
+        {
+            CHECK(eg.RenameFile());
+        }
+
+        virtual wxFileSystemWatcherEvent ExpectedEvent() override
+        {
+            wxFileSystemWatcherEvent event(wxFSW_EVENT_RENAME);
+            event.SetPath(eg.m_old);
+            event.SetNewPath(eg.m_file);
+            return event;
+        }
+    };
+
+    // we need to create a file to rename
+    EventGenerator::Get().CreateFile();
+
+    EventTester tester;
+    tester.Run();
+}
+
+// ----------------------------------------------------------------------------
+// TestTreeEventModify: check that modifications are reported inside the trees
+// ----------------------------------------------------------------------------
+
+TEST_CASE_METHOD(FileSystemWatcherTestCase,
+                 "wxFileSystemWatcher::TreeEventModify", "[fsw]")
+{
+    class EventTester : public FSWTesterBase
+    {
+    public:
+        EventTester() : FSWTesterBase(wxFSW_EVENT_MODIFY) {}
+
+        virtual bool Init() override
+        {
+            CHECK(wxEventLoopBase::GetActive());
+
+            m_watcher.reset(new wxFileSystemWatcher());
+            m_watcher->SetOwner(this);
+
+            // With fanotify, modifications are watched for using a different
+            // mark than the other events.
+            CHECK(m_watcher->AddTree(EventGenerator::GetWatchDir(),
+                                     m_eventTypes));
+
+            return true;
+        }
+
+        virtual void GenerateEvent() override
+        {
+            CHECK(eg.ModifyFile());
+        }
+
+        virtual wxFileSystemWatcherEvent ExpectedEvent() override
+        {
+            wxFileSystemWatcherEvent event(wxFSW_EVENT_MODIFY);
+            event.SetPath(eg.m_file);
+            event.SetNewPath(eg.m_file);
+            return event;
+        }
+    };
+
+    // we need to create a file to modify
+    EventGenerator::Get().CreateFile();
+
+    EventTester tester;
+    tester.Run();
+}
+
+// ----------------------------------------------------------------------------
+// TestCoalescedEvents: multiple modifications result in a single event
+// ----------------------------------------------------------------------------
+
+TEST_CASE_METHOD(FileSystemWatcherTestCase,
+                 "wxFileSystemWatcher::CoalescedEvents", "[fsw]")
+{
+    class EventTester : public FSWTesterBase
+    {
+    public:
+        EventTester() : FSWTesterBase(wxFSW_EVENT_MODIFY) {}
+
+        virtual bool Init() override
+        {
+            if ( !FSWTesterBase::Init() )
+                return false;
+
+            CHECK(m_watcher->SetCoalescingInterval(100));
+
+            return true;
+        }
+
+        virtual void GenerateEvent() override
+        {
+            CHECK(eg.ModifyFile());
+            CHECK(eg.ModifyFile());
+            CHECK(eg.ModifyFile());
+        }
+
+        virtual wxFileSystemWatcherEvent ExpectedEvent() override
+        {
+            wxFileSystemWatcherEvent event(wxFSW_EVENT_MODIFY);
+            event.SetPath(eg.m_file);
+            event.SetNewPath(eg.m_file);
+            return event;
+        }
+    };
+
+    // we need to create a file to modify
+    EventGenerator::Get().CreateFile();
+
+    EventTester tester;
+    tester.Run();
+}
 #endif // wxHAS_INOTIFY
 
 // ----------------------------------------------------------------------------
@@ -739,6 +881,14 @@ TEST_CASE_METHOD(FileSystemWatcherTestCase,
             m_watcher->AddTree(dir);
             const int plustree = m_watcher->GetWatchedPathsCount();
 
+#ifdef wxHAS_INOTIFY
+            // When fanotify is used, i.e. typically when running as root, a
+            // single watch is used for the entire tree too.
+            const bool singleWatch = wxFSWatcherIsUsingFanotify(*m_watcher, dir);
+            if ( singleWatch )
+                treeitems = 1;
+#endif // wxHAS_INOTIFY
+
             CHECK( plustree == initial + treeitems );
 
             m_watcher->RemoveTree(dir);
@@ -757,6 +907,9 @@ TEST_CASE_METHOD(FileSystemWatcherTestCase,
             int fudge = 0;
 #if defined(__WINDOWS__) || defined(wxHAVE_FSEVENTS_FILE_NOTIFICATIONS)
             fudge = 1;
+#elif defined(wxHAS_INOTIFY)
+            if ( singleWatch )
+                fudge = 1;
 #endif // __WINDOWS__ || wxHAVE_FSEVENTS_FILE_NOTIFICATIONS
             m_watcher->AddTree(dir);
             CHECK( m_watcher->GetWatchedPathsCount() == plustree + fudge );
@@ -795,12 +948,18 @@ TEST_CASE_METHOD(FileSystemWatcherTestCase,
             // and another +1 for "child").
             // On OS X, if we use FSEvents then we still only have 1 watch.
 #ifdef wxHAVE_FSEVENTS_FILE_NOTIFICATIONS
-            const int treeitems = 1;
+            int treeitems = 1;
 #else
-            const int treeitems = subdirs + 2;
+            int treeitems = subdirs + 2;
 #endif
             m_watcher->AddTree(dir, wxFSW_EVENT_ALL, "*.txt");
 
+#ifdef wxHAS_INOTIFY
+            // As above, fanotify uses a single watch even with a filespec.
+            if ( wxFSWatcherIsUsingFanotify(*m_watcher, dir) )
+                treeitems = 1;
+#endif // wxHAS_INOTIFY
+
             CHECK( m_watcher->GetWatchedPathsCount() == initial + treeitems );
 
             // RemoveTree should try to remove only those files that were added
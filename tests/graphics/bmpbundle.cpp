@@ -13,6 +13,7 @@
 #include "testprec.h"
 
 #include "wx/bmpbndl.h"
+#include "wx/private/bmpbndl.h"
 
 #include "wx/artprov.h"
 #include "wx/dcmemory.h"
@@ -485,6 +486,83 @@ TEST_CASE("BitmapBundle::FromSVG-alpha", "[bmpbundle][svg][alpha]")
     CHECK( (int)img.GetBlue(0, 1) == 0xff );
 }
 
+TEST_CASE("BitmapBundle::SVGCache", "[bmpbundle][svg]")
+{
+    static const char svg_data[] =
+        "<svg viewBox=\"0 0 100 100\">"
+        "<circle cx=\"50\" cy=\"50\" r=\"40\" fill=\"red\"/>"
+        "</svg>"
+        ;
+
+    wxBitmapBundle b = wxBitmapBundle::FromSVG(svg_data, wxSize(16, 16));
+    REQUIRE( b.IsOk() );
+
+    // Switching between a few different sizes shouldn't rasterize again.
+    const wxBitmap bmp16 = b.GetBitmap(wxSize(16, 16));
+    const wxBitmap bmp32 = b.GetBitmap(wxSize(32, 32));
+    CHECK( b.GetBitmap(wxSize(16, 16)).IsSameAs(bmp16) );
+    CHECK( b.GetBitmap(wxSize(32, 32)).IsSameAs(bmp32) );
+
+    // But only the last used bitmap is kept if there is no memory for more.
+    wxBitmapBundle::SetSVGCacheLimit(0);
+    CHECK( b.GetBitmap(wxSize(32, 32)).IsSameAs(bmp32) );
+    CHECK( !b.GetBitmap(wxSize(16, 16)).IsSameAs(bmp16) );
+    wxBitmapBundle::SetSVGCacheLimit(32*1024*1024);
+
+    wxVector<wxBitmapBundle> bundles;
+    bundles.push_back(b);
+    bundles.push_back(wxBitmapBundle::FromSVG(svg_data, wxSize(24, 24)));
+    bundles.push_back(wxBitmapBundle::FromBitmap(wxBitmap(8, 8)));
+
+    // Check that the bitmaps are really rasterized by PrerenderSVG() and not
+    // by GetBitmap() called after it.
+    const size_t count = wxGetSVGCachedBitmapsCount();
+
+    SECTION("Default size")
+    {
+        // The first bundle already has the bitmap of its default size.
+        wxBitmapBundle::PrerenderSVG(bundles);
+#ifndef wxNO_RTTI
+        CHECK( wxGetSVGCachedBitmapsCount() == count + 1 );
+#endif // !wxNO_RTTI
+
+        wxBitmapBundle::PrerenderSVG(bundles);
+#ifndef wxNO_RTTI
+        CHECK( wxGetSVGCachedBitmapsCount() == count + 1 );
+#endif // !wxNO_RTTI
+
+        const wxBitmap bmp = bundles[1].GetBitmap(wxDefaultSize);
+        CHECK( bmp.GetSize() == wxSize(24, 24) );
+        CHECK( bundles[1].GetBitmap(wxDefaultSize).IsSameAs(bmp) );
+        CHECK( wxGetSVGCachedBitmapsCount() == count + 1 );
+    }
+
+    SECTION("Given size")
+    {
+        wxBitmapBundle::PrerenderSVG(bundles, wxSize(48, 48));
+#ifndef wxNO_RTTI
+        CHECK( wxGetSVGCachedBitmapsCount() == count + 2 );
+#endif // !wxNO_RTTI
+
+        for ( size_t n = 0; n < 2; ++n )
+        {
+            const wxBitmap bmp = bundles[n].GetBitmap(wxSize(48, 48));
+            CHECK( bmp.GetSize() == wxSize(48, 48) );
+            CHECK( bundles[n].GetBitmap(wxSize(48, 48)).IsSameAs(bmp) );
+        }
+
+        CHECK( wxGetSVGCachedBitmapsCount() == count + 2 );
+
+        // The bitmap must be the same as the one rasterized on demand.
+        const wxImage img = bundles[0].GetBitmap(wxSize(48, 48)).ConvertToImage();
+        const wxImage imgRef = wxBitmapBundle::FromSVG(svg_data, wxSize(16, 16))
+                                .GetBitmap(wxSize(48, 48)).ConvertToImage();
+        CHECK( img.GetRed(24, 24) == imgRef.GetRed(24, 24) );
+        CHECK( img.GetAlpha(24, 24) == imgRef.GetAlpha(24, 24) );
+        CHECK( img.GetAlpha(0, 0) == imgRef.GetAlpha(0, 0) );
+    }
+}
+
 TEST_CASE("BitmapBundle::FromSVGFile", "[bmpbundle][svg][file]")
 {
     const wxSize size(20, 20); // completely arbitrary
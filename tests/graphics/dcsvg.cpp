@@ -0,0 +1,202 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/graphics/dcsvg.cpp
+// Purpose:     wxSVGFileDC unit tests
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+#if wxUSE_SVG
+
+#include "wx/dcsvg.h"
+#include "wx/file.h"
+#include "wx/pen.h"
+
+#include "testfile.h"
+
+// ----------------------------------------------------------------------------
+// helper functions
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Return the contents of the SVG file.
+wxString ReadSVG(const wxString& filename)
+{
+    wxFile file(filename);
+    REQUIRE( file.IsOpened() );
+
+    wxString svg;
+    REQUIRE( file.ReadAll(&svg) );
+
+    return svg;
+}
+
+// Return the number of times the given string occurs in the SVG.
+int CountOccurrences(const wxString& svg, const wxString& what)
+{
+    int count = 0;
+    for ( size_t pos = svg.find(what);
+          pos != wxString::npos;
+          pos = svg.find(what, pos + what.length()) )
+    {
+        count++;
+    }
+
+    return count;
+}
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// tests themselves
+// ----------------------------------------------------------------------------
+
+TEST_CASE("wxSVGFileDC::DrawLine", "[dc][svgdc]")
+{
+    TestFile tf;
+
+    SECTION("Consecutive")
+    {
+        {
+            wxSVGFileDC dc(tf.GetName());
+            dc.DrawLine(0, 0, 10, 10);
+            dc.DrawLine(20, 20, 30, -30);
+            dc.DrawLine(10, 10, 0, 0);
+        }
+
+        const wxString svg = ReadSVG(tf.GetName());
+        INFO( svg );
+
+        CHECK( CountOccurrences(svg, "<path ") == 1 );
+        CHECK( svg.Contains("<path d=\"M0 0 L10 10 M20 20 L30 -30 M10 10 L0 0\""
+                            " shape-rendering=\"auto\" />\n") );
+        CHECK( svg.EndsWith("</g>\n</svg>\n") );
+    }
+
+    SECTION("Pen")
+    {
+        {
+            wxSVGFileDC dc(tf.GetName());
+            dc.SetPen(*wxRED_PEN);
+            dc.DrawLine(0, 0, 10, 10);
+            dc.DrawLine(10, 10, 20, 0);
+            dc.SetPen(wxPen(*wxBLUE, 1, wxPENSTYLE_DOT));
+            dc.DrawLine(20, 0, 30, 10);
+        }
+
+        const wxString svg = ReadSVG(tf.GetName());
+        INFO( svg );
+
+        CHECK( CountOccurrences(svg, "<path ") == 2 );
+        CHECK( svg.Contains("<path d=\"M0 0 L10 10 M10 10 L20 0\""
+                            " shape-rendering=\"auto\" />\n</g>\n") );
+        CHECK( svg.Contains("<path d=\"M20 0 L30 10\" shape-rendering=\"auto\""
+                            " stroke-dasharray=\"") );
+
+        // The lines must be output after the group using their pen.
+        const size_t posRed = svg.find("stroke:#FF0000;");
+        const size_t posBlue = svg.find("stroke:#0000FF;");
+        REQUIRE( posRed != wxString::npos );
+        REQUIRE( posBlue != wxString::npos );
+        CHECK( posRed < svg.find("M0 0 L10 10") );
+        CHECK( svg.find("M0 0 L10 10") < posBlue );
+        CHECK( posBlue < svg.find("M20 0 L30 10") );
+    }
+
+    SECTION("RenderingMode")
+    {
+        {
+            wxSVGFileDC dc(tf.GetName());
+            dc.DrawLine(0, 0, 10, 10);
+            dc.SetShapeRenderingMode(wxSVG_SHAPE_RENDERING_CRISP_EDGES);
+            dc.DrawLine(10, 10, 20, 0);
+            dc.DrawLine(20, 0, 30, 10);
+        }
+
+        const wxString svg = ReadSVG(tf.GetName());
+        INFO( svg );
+
+        CHECK( CountOccurrences(svg, "<path ") == 2 );
+        CHECK( svg.Contains("<path d=\"M0 0 L10 10\""
+                            " shape-rendering=\"auto\" />\n") );
+        CHECK( svg.Contains("<path d=\"M10 10 L20 0 M20 0 L30 10\""
+                            " shape-rendering=\"crispEdges\" />\n") );
+    }
+
+    SECTION("Transparent")
+    {
+        // Lines drawn with semi-transparent pen are not combined as this
+        // would change how their overlapping parts look.
+        {
+            wxSVGFileDC dc(tf.GetName());
+            dc.SetPen(wxPen(wxColour(0, 0, 0, 128)));
+            dc.DrawLine(0, 0, 10, 10);
+            dc.DrawLine(10, 10, 0, 0);
+        }
+
+        const wxString svg = ReadSVG(tf.GetName());
+        INFO( svg );
+
+        CHECK( CountOccurrences(svg, "<path ") == 2 );
+    }
+
+    SECTION("Other")
+    {
+        // Drawing anything else closes the path.
+        {
+            wxSVGFileDC dc(tf.GetName());
+            dc.DrawLine(0, 0, 10, 10);
+            dc.DrawRectangle(0, 0, 10, 10);
+            dc.DrawLine(10, 10, 20, 0);
+
+            const wxPoint points[] = { wxPoint(0, 0), wxPoint(5, 5), wxPoint(0, 10) };
+            dc.DrawLines(WXSIZEOF(points), points);
+        }
+
+        const wxString svg = ReadSVG(tf.GetName());
+        INFO( svg );
+
+        CHECK( CountOccurrences(svg, "<path ") == 3 );
+        CHECK( CountOccurrences(svg, "<rect ") == 1 );
+        CHECK( svg.Contains("<path d=\"M0 0 L10 10\" shape-rendering=\"auto\" />\n") );
+        CHECK( svg.Contains("<path d=\"M10 10 L20 0\" shape-rendering=\"auto\" />\n") );
+        CHECK( svg.Contains("<path d=\"M0 0 L5 5 L0 10\" style=\"fill:none\"") );
+        CHECK( svg.find("M0 0 L10 10") < svg.find("<rect ") );
+        CHECK( svg.find("<rect ") < svg.find("M10 10 L20 0") );
+    }
+}
+
+TEST_CASE("wxSVGFileDC::LargeOutput", "[dc][svgdc]")
+{
+    // Check that the output exceeding the size of the internal buffer is
+    // written correctly.
+    TestFile tf;
+
+    const int numLines = 20000;
+    {
+        wxSVGFileDC dc(tf.GetName());
+        for ( int n = 0; n < numLines; n++ )
+            dc.DrawLine(n, 0, n, 100);
+    }
+
+    const wxString svg = ReadSVG(tf.GetName());
+
+    CHECK( CountOccurrences(svg, " L") == numLines );
+    CHECK( svg.Contains(wxString::Format(" M%d 0 L%d 100\"", numLines - 1,
+                                         numLines - 1)) );
+    CHECK( svg.EndsWith("</g>\n</svg>\n") );
+
+    // The lines are split in several paths.
+    CHECK( CountOccurrences(svg, "<path ") > 1 );
+}
+
+#endif // wxUSE_SVG
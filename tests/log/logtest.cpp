@@ -273,6 +273,150 @@ TEST_CASE_METHOD(LogTestCase, "wxLog::NoWarnings", "[log]")
     CHECK( m_log->GetLog(wxLOG_Error) == "If" );
 }
 
+#if wxUSE_THREADS
+
+namespace
+{
+
+// log target storing all messages passed to it, which can also be made to
+// block until Unblock() is called
+class AsyncTestLog : public wxLog
+{
+public:
+    AsyncTestLog() = default;
+
+    const wxArrayString& GetMessages() const { return m_messages; }
+
+    // make the next DoLogRecord() call wait for Unblock() and wait until it
+    // is made
+    void Block() { m_block = true; }
+    void WaitUntilBlocked() { m_blocked.Wait(); }
+
+    void Unblock()
+    {
+        m_block = false;
+        m_unblock.Post();
+    }
+
+protected:
+    virtual void DoLogRecord(wxLogLevel WXUNUSED(level),
+                             const wxString& msg,
+                             const wxLogRecordInfo& WXUNUSED(info)) override
+    {
+        if ( m_block )
+        {
+            m_blocked.Post();
+            m_unblock.Wait();
+        }
+
+        m_messages.push_back(msg);
+    }
+
+private:
+    wxArrayString m_messages;
+
+    bool m_block = false;
+    wxSemaphore m_blocked,
+                m_unblock;
+
+    wxDECLARE_NO_COPY_CLASS(AsyncTestLog);
+};
+
+class AsyncLoggingThread : public wxThread
+{
+public:
+    explicit AsyncLoggingThread(int id)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_id(id)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        for ( int n = 0; n < 100; n++ )
+            wxLogMessage("%d %d", m_id, n);
+
+        return nullptr;
+    }
+
+private:
+    const int m_id;
+};
+
+} // anonymous namespace
+
+TEST_CASE("wxLogAsync::Threads", "[log][thread]")
+{
+    AsyncTestLog* const log = new AsyncTestLog;
+    wxLogAsync logAsync(log, 16, wxLogAsync::Overflow_Block);
+
+    wxLog* const logOld = wxLog::SetActiveTarget(&logAsync);
+    wxON_BLOCK_EXIT1(wxLog::SetActiveTarget, logOld);
+
+    wxLogMessage("Main");
+    logAsync.Flush();
+    REQUIRE( log->GetMessages().size() == 1 );
+    CHECK( log->GetMessages()[0] == "Main" );
+
+    AsyncLoggingThread thread1(1),
+                       thread2(2);
+    REQUIRE( thread1.Run() == wxTHREAD_NO_ERROR );
+    REQUIRE( thread2.Run() == wxTHREAD_NO_ERROR );
+    thread1.Wait();
+    thread2.Wait();
+
+    logAsync.Flush();
+
+    // All messages must have been logged, in order for each thread.
+    const wxArrayString& messages = log->GetMessages();
+    REQUIRE( messages.size() == 201 );
+
+    int next[3] = { 0, 0, 0 };
+    for ( size_t n = 1; n < messages.size(); n++ )
+    {
+        int id = 0,
+            num = -1;
+        REQUIRE( wxSscanf(messages[n], "%d %d", &id, &num) == 2 );
+        REQUIRE( (id == 1 || id == 2) );
+        CHECK( num == next[id]++ );
+    }
+
+    CHECK( logAsync.GetDroppedCount() == 0 );
+}
+
+TEST_CASE("wxLogAsync::Overflow", "[log][thread]")
+{
+    AsyncTestLog* const log = new AsyncTestLog;
+    wxLogAsync logAsync(log, 2);
+
+    wxLog* const logOld = wxLog::SetActiveTarget(&logAsync);
+    wxON_BLOCK_EXIT1(wxLog::SetActiveTarget, logOld);
+
+    // Block the worker thread while it processes the first message: the
+    // buffer is not freed until it finishes, so only one more message fits
+    // into it.
+    log->Block();
+    wxLogMessage("1");
+    log->WaitUntilBlocked();
+
+    wxLogMessage("2");
+    wxLogMessage("3");
+    wxLogMessage("4");
+    CHECK( logAsync.GetDroppedCount() == 2 );
+
+    log->Unblock();
+    logAsync.Flush();
+
+    const wxArrayString& messages = log->GetMessages();
+    REQUIRE( messages.size() == 3 );
+    CHECK( messages[0] == "1" );
+    CHECK( messages[1] == "2" );
+    CHECK( messages[2].StartsWith("2 log messages were dropped") );
+}
+
+#endif // wxUSE_THREADS
+
 // The following two functions (v, macroCompilabilityTest) are not run by
 // any test, and their purpose is merely to guarantee that the wx(V)LogXXX
 // macros compile without 'dangling else' warnings.
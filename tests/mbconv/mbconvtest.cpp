@@ -24,6 +24,9 @@
 
 #include "wx/private/localeset.h"
 
+#include <string>
+#include <vector>
+
 #if defined wxHAVE_TCHAR_SUPPORT && !defined HAVE_WCHAR_H
     #define HAVE_WCHAR_H
 #endif
@@ -1508,3 +1511,64 @@ TEST_CASE("wxMBConv::cMB2WC", "[mbconv][mb2wc]")
     CHECK( wxConvUTF7.cMB2WC(wxCharBuffer()).length() == 0 );
     CHECK( wxConvUTF7.cMB2WC("+AKM-").length() == 1 );
 }
+
+TEST_CASE("wxMBConvUTF8::Long", "[mbconv][utf8]")
+{
+    // Check that long ASCII runs, which are handled specially, are correctly
+    // combined with the non-ASCII characters at all possible offsets.
+    const std::string ascii = "0123456789abcdefghijklmnopqrstuvwxyz";
+    const char* const nonASCII[] =
+    {
+        "\xc3\xa9",             // U+00E9
+        "\xe2\x82\xac",         // U+20AC
+        "\xf0\x9f\x98\x80",     // U+1F600
+    };
+
+    for ( size_t n = 0; n < WXSIZEOF(nonASCII); n++ )
+    {
+        for ( size_t pos = 0; pos <= ascii.length(); pos++ )
+        {
+            std::string utf8 = ascii;
+            utf8.insert(pos, nonASCII[n]);
+            utf8 += ascii;
+
+            INFO("Non-ASCII character " << n << " at " << pos);
+
+            const size_t lenWide = wxConvUTF8.ToWChar(nullptr, 0,
+                                                      utf8.c_str(), utf8.length());
+            REQUIRE( lenWide != wxCONV_FAILED );
+
+            std::vector<wchar_t> wide(lenWide + 1, L'!');
+            CHECK( wxConvUTF8.ToWChar(&wide[0], lenWide,
+                                      utf8.c_str(), utf8.length()) == lenWide );
+            CHECK( wide[lenWide] == L'!' );
+            CHECK( wide[lenWide - 1] == L'z' );
+
+            // A too small buffer must result in an error and not overflow.
+            CHECK( wxConvUTF8.ToWChar(&wide[0], lenWide - 1,
+                                      utf8.c_str(), utf8.length()) == wxCONV_FAILED );
+            CHECK( wide[lenWide] == L'!' );
+
+            const size_t lenUTF8 = wxConvUTF8.FromWChar(nullptr, 0,
+                                                        &wide[0], lenWide);
+            REQUIRE( lenUTF8 == utf8.length() );
+
+            std::vector<char> back(lenUTF8 + 1, '!');
+            CHECK( wxConvUTF8.FromWChar(&back[0], lenUTF8,
+                                        &wide[0], lenWide) == lenUTF8 );
+            CHECK( std::string(&back[0], lenUTF8) == utf8 );
+            CHECK( back[lenUTF8] == '!' );
+
+            CHECK( wxConvUTF8.FromWChar(&back[0], lenUTF8 - 1,
+                                        &wide[0], lenWide) == wxCONV_FAILED );
+            CHECK( back[lenUTF8] == '!' );
+
+            // Invalid bytes must be detected after a long ASCII run too.
+            std::string invalid = ascii;
+            invalid.insert(pos, "\xff");
+            invalid += ascii;
+            CHECK( wxConvUTF8.ToWChar(nullptr, 0,
+                                      invalid.c_str(), invalid.length()) == wxCONV_FAILED );
+        }
+    }
+}
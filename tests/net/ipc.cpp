@@ -259,3 +259,563 @@ void IPCTestCase::Disconnect()
 #endif // wxUSE_THREADS
 
 #endif // !__WINDOWS__
+
+// ----------------------------------------------------------------------------
+// wxTCPConnection protocol tests
+// ----------------------------------------------------------------------------
+
+// These tests use AF_UNIX sockets to avoid conflicts with the other programs
+// and run the fake peers using the legacy protocol in secondary threads.
+#if wxUSE_SOCKETS && wxUSE_IPC && wxUSE_THREADS && defined(__UNIX__)
+
+#ifndef WX_PRECOMP
+    #include "wx/app.h"
+#endif
+
+#include "wx/datstrm.h"
+#include "wx/evtloop.h"
+#include "wx/filename.h"
+#include "wx/sckipc.h"
+#include "wx/sckstrm.h"
+#include "wx/stdpaths.h"
+#include "wx/sysopt.h"
+#include "wx/thread.h"
+#include "wx/utils.h"
+
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+const char* const IPC_TOPIC = "IPC TEST";
+const char* const IPC_ITEM = "data";
+
+// Message codes of the legacy protocol, which must remain compatible with
+// the old wxWidgets versions.
+enum
+{
+    IPC_REQUEST         = 2,
+    IPC_POKE            = 3,
+    IPC_REQUEST_REPLY   = 8,
+    IPC_FAIL            = 9,
+    IPC_CONNECT         = 10,
+    IPC_DISCONNECT      = 11,
+    IPC_CAPABILITIES    = 12
+};
+
+// Shared memory is only used under Linux.
+#ifdef __LINUX__
+    const bool HAS_SHARED_MEMORY = true;
+#else
+    const bool HAS_SHARED_MEMORY = false;
+#endif
+
+class SocketsInitializer
+{
+public:
+    SocketsInitializer() { wxSocketBase::Initialize(); }
+    ~SocketsInitializer() { wxSocketBase::Shutdown(); }
+};
+
+// Get the name of the AF_UNIX socket to use for the server.
+wxString GetServerName()
+{
+    static int s_counter = 0;
+
+    return wxString::Format("%s/wxipctest-%lu-%d",
+                            wxFileName::GetTempDir(),
+                            wxGetProcessId(),
+                            s_counter++);
+}
+
+// Create the data of the given size, which compresses well or not at all.
+std::vector<char> MakeData(size_t size, bool compressible)
+{
+    std::vector<char> data(size);
+
+    wxUint32 n = 1;
+    for ( size_t i = 0; i < size; i++ )
+    {
+        if ( compressible )
+        {
+            data[i] = "wxTCPConnection"[i % 15];
+        }
+        else
+        {
+            n = n*1103515245 + 12345;
+            data[i] = static_cast<char>(n >> 16);
+        }
+    }
+
+    return data;
+}
+
+// Check if the shared memory segment used by wxTCPConnection is mapped into
+// this process.
+bool HasSharedMemory()
+{
+    std::ifstream maps("/proc/self/maps");
+
+    std::string line;
+    while ( std::getline(maps, line) )
+    {
+        if ( line.find("/dev/shm/wxipc-") != std::string::npos )
+            return true;
+    }
+
+    return false;
+}
+
+// Dispatch the events until the condition becomes true or a timeout expires.
+template <typename F>
+bool DispatchUntil(F done)
+{
+    wxEventLoop loop;
+
+    const wxMilliClock_t end = wxGetLocalTimeMillis() + 10000;
+    while ( !done() )
+    {
+        if ( wxGetLocalTimeMillis() > end )
+            return false;
+
+        loop.DispatchTimeout(10);
+        wxTheApp->ProcessPendingEvents();
+    }
+
+    return true;
+}
+
+// Poke the data to the server and request it back.
+void PokeAndRequest(wxConnectionBase& conn, const std::vector<char>& data)
+{
+    REQUIRE( conn.Poke(IPC_ITEM, data.data(), data.size(), wxIPC_PRIVATE) );
+
+    size_t size = 0;
+    const char* const
+        reply = static_cast<const char*>(conn.Request(IPC_ITEM, &size,
+                                                      wxIPC_PRIVATE));
+    REQUIRE( reply );
+    CHECK( std::vector<char>(reply, reply + size) == data );
+}
+
+// Information about the data received by the server.
+struct ServerResults
+{
+    std::vector<char> data;
+    bool sharedMemory = false;
+    bool disconnected = false;
+};
+
+// Server side connection sending back the data poked into it.
+class TestServerConnection : public wxTCPConnection
+{
+public:
+    TestServerConnection(ServerResults& results, bool compress)
+        : m_results(results)
+    {
+        Compress(compress);
+    }
+
+    virtual bool OnPoke(const wxString& WXUNUSED(topic),
+                        const wxString& item,
+                        const void* data,
+                        size_t size,
+                        wxIPCFormat WXUNUSED(format)) override
+    {
+        if ( item != IPC_ITEM )
+            return false;
+
+        const char* const p = static_cast<const char*>(data);
+        m_results.data.assign(p, p + size);
+        m_results.sharedMemory = HasSharedMemory();
+
+        return true;
+    }
+
+    virtual const void* OnRequest(const wxString& WXUNUSED(topic),
+                                  const wxString& item,
+                                  size_t* size,
+                                  wxIPCFormat WXUNUSED(format)) override
+    {
+        if ( item != IPC_ITEM || m_results.data.empty() )
+            return nullptr;
+
+        *size = m_results.data.size();
+        return m_results.data.data();
+    }
+
+    virtual bool OnDisconnect() override
+    {
+        m_results.disconnected = true;
+
+        return wxTCPConnection::OnDisconnect();
+    }
+
+private:
+    ServerResults& m_results;
+};
+
+class TestServer : public wxTCPServer
+{
+public:
+    explicit TestServer(ServerResults& results, bool compress = false)
+        : m_results(results),
+          m_compress(compress)
+    {
+    }
+
+    virtual wxConnectionBase* OnAcceptConnection(const wxString& topic) override
+    {
+        if ( topic != IPC_TOPIC )
+            return nullptr;
+
+        return new TestServerConnection(m_results, m_compress);
+    }
+
+private:
+    ServerResults& m_results;
+    const bool m_compress;
+};
+
+// Base class for the threads emulating the peers using the legacy protocol,
+// as implemented by wxWidgets versions before 3.3.2.
+class LegacyPeerThread : public wxThread
+{
+public:
+    LegacyPeerThread()
+        : wxThread(wxTHREAD_JOINABLE)
+    {
+    }
+
+    // The data received from the peer.
+    std::vector<char> m_data;
+
+    // Set if the conversation went as expected.
+    bool m_ok = false;
+
+    // Set when the thread is done.
+    std::atomic<bool> m_done{false};
+
+protected:
+    virtual void* Entry() override
+    {
+        m_ok = Converse();
+        m_done = true;
+
+        return nullptr;
+    }
+
+    // Run the conversation, return true if it was successful.
+    virtual bool Converse() = 0;
+
+    static bool ReadRaw(wxInputStream& in, std::vector<char>& data)
+    {
+        return in.ReadAll(data.data(), data.size());
+    }
+
+    static bool ReadHeader(wxDataInputStream& in, int code)
+    {
+        return in.Read8() == code &&
+                in.ReadString() == IPC_ITEM &&
+                    in.Read8() == wxIPC_PRIVATE;
+    }
+
+    static void WriteHeader(wxDataOutputStream& out, int code)
+    {
+        out.Write8(code);
+        out.WriteString(IPC_ITEM);
+        out.Write8(wxIPC_PRIVATE);
+    }
+};
+
+// Emulate the server accepting a single connection on the given socket,
+// storing the poked data and sending it back when it's requested.
+class LegacyServerThread : public LegacyPeerThread
+{
+public:
+    explicit LegacyServerThread(wxSocketServer& server)
+        : m_server(server)
+    {
+    }
+
+protected:
+    virtual bool Converse() override
+    {
+        wxSocketBase sock(wxSOCKET_BLOCK | wxSOCKET_WAITALL, wxSOCKET_BASE);
+        if ( !m_server.AcceptWith(sock) )
+            return false;
+
+        sock.SetTimeout(10);
+
+        wxSocketInputStream sin(sock);
+        wxSocketOutputStream sout(sock);
+        wxDataInputStream in(sin);
+        wxDataOutputStream out(sout);
+
+        if ( in.Read8() != IPC_CONNECT || in.ReadString() != IPC_TOPIC )
+            return false;
+
+        out.Write8(IPC_CONNECT);
+
+        // The new clients ask about our capabilities and the old servers
+        // reply to the unknown message with a failure.
+        if ( in.Read8() != IPC_CAPABILITIES )
+            return false;
+
+        out.Write8(IPC_FAIL);
+
+        if ( !ReadHeader(in, IPC_POKE) )
+            return false;
+
+        m_data.resize(in.Read32());
+        if ( !ReadRaw(sin, m_data) )
+            return false;
+
+        if ( !ReadHeader(in, IPC_REQUEST) )
+            return false;
+
+        out.Write8(IPC_REQUEST_REPLY);
+        out.Write32(m_data.size());
+        sout.Write(m_data.data(), m_data.size());
+
+        return in.Read8() == IPC_DISCONNECT;
+    }
+
+private:
+    wxSocketServer& m_server;
+};
+
+// Emulate the client poking the given data and requesting it back.
+class LegacyClientThread : public LegacyPeerThread
+{
+public:
+    LegacyClientThread(const wxString& name, const std::vector<char>& data)
+        : m_name(name),
+          m_dataSent(data)
+    {
+    }
+
+protected:
+    virtual bool Converse() override
+    {
+        wxUNIXaddress addr;
+        addr.Filename(m_name);
+
+        wxSocketClient sock(wxSOCKET_BLOCK | wxSOCKET_WAITALL);
+        sock.SetTimeout(10);
+        if ( !sock.Connect(addr) )
+            return false;
+
+        wxSocketInputStream sin(sock);
+        wxSocketOutputStream sout(sock);
+        wxDataInputStream in(sin);
+        wxDataOutputStream out(sout);
+
+        out.Write8(IPC_CONNECT);
+        out.WriteString(IPC_TOPIC);
+        if ( in.Read8() != IPC_CONNECT )
+            return false;
+
+        WriteHeader(out, IPC_POKE);
+        out.Write32(m_dataSent.size());
+        sout.Write(m_dataSent.data(), m_dataSent.size());
+
+        WriteHeader(out, IPC_REQUEST);
+        if ( in.Read8() != IPC_REQUEST_REPLY )
+            return false;
+
+        m_data.resize(in.Read32());
+        if ( !ReadRaw(sin, m_data) )
+            return false;
+
+        out.Write8(IPC_DISCONNECT);
+
+        return true;
+    }
+
+private:
+    const wxString m_name;
+    const std::vector<char> m_dataSent;
+};
+
+// Run wxTCPConnection::Client test in a child process connecting to the
+// server with the given name and return its exit code.
+int RunClientProcess(const wxString& name,
+                     bool expectSharedMemory,
+                     bool compress = false,
+                     bool noSharedMemory = false)
+{
+    wxExecuteEnv env;
+    wxGetEnvMap(&env.env);
+    env.env["WX_TEST_IPC_SERVER"] = name;
+    env.env["WX_TEST_IPC_SHARED_MEMORY"] = expectSharedMemory ? "1" : "0";
+    if ( compress )
+        env.env["WX_TEST_IPC_COMPRESS"] = "1";
+    if ( noSharedMemory )
+        env.env["wx_ipc_no_shared_memory"] = "1";
+
+    const wxString exe = wxStandardPaths::Get().GetExecutablePath();
+    const wxScopedCharBuffer exeBuf = exe.fn_str();
+    const char* const argv[] = { exeBuf.data(), "wxTCPConnection::Client", nullptr };
+
+    return wxExecute(argv, wxEXEC_SYNC, nullptr, &env);
+}
+
+} // anonymous namespace
+
+// This test is only run by the other ones in a child process, as the server
+// can't run in the same thread as the client using it synchronously and
+// wxTCPClient can't be used in the other threads.
+TEST_CASE("wxTCPConnection::Client", "[.]")
+{
+    wxString name;
+    if ( !wxGetEnv("WX_TEST_IPC_SERVER", &name) )
+        return;
+
+    wxString sharedMemory;
+    wxGetEnv("WX_TEST_IPC_SHARED_MEMORY", &sharedMemory);
+
+    SocketsInitializer init;
+
+    wxTCPClient client;
+    std::unique_ptr<wxTCPConnection>
+        conn(static_cast<wxTCPConnection*>(client.MakeConnection("localhost",
+                                                                 name,
+                                                                 IPC_TOPIC)));
+    REQUIRE( conn );
+
+    conn->Compress(wxGetEnv("WX_TEST_IPC_COMPRESS", nullptr));
+
+    CHECK( HasSharedMemory() == (sharedMemory == "1") );
+
+    // Use the data of the different sizes, as the small blocks are always
+    // sent inline, and both compressible and not, as the data is sent
+    // uncompressed if compressing it doesn't help.
+    PokeAndRequest(*conn, MakeData(100, true));
+    PokeAndRequest(*conn, MakeData(64*1024, false));
+    PokeAndRequest(*conn, MakeData(1024*1024, true));
+
+    CHECK( conn->Disconnect() );
+}
+
+TEST_CASE("wxTCPConnection::Protocol", "[ipc]")
+{
+    SocketsInitializer init;
+
+    const wxString name = GetServerName();
+
+    ServerResults results;
+
+    SECTION("SharedMemory")
+    {
+        TestServer server(results);
+        REQUIRE( server.Create(name) );
+
+        CHECK( RunClientProcess(name, HAS_SHARED_MEMORY) == 0 );
+        CHECK( DispatchUntil([&]() { return results.disconnected; }) );
+        CHECK( results.sharedMemory == HAS_SHARED_MEMORY );
+    }
+
+    SECTION("NoSharedMemoryClient")
+    {
+        TestServer server(results);
+        REQUIRE( server.Create(name) );
+
+        CHECK( RunClientProcess(name, false, false, true) == 0 );
+        CHECK( DispatchUntil([&]() { return results.disconnected; }) );
+        CHECK( !results.sharedMemory );
+    }
+
+    SECTION("NoSharedMemoryServer")
+    {
+        wxSystemOptions::SetOption("ipc.no-shared-memory", 1);
+
+        TestServer server(results);
+        REQUIRE( server.Create(name) );
+
+        CHECK( RunClientProcess(name, false) == 0 );
+        CHECK( DispatchUntil([&]() { return results.disconnected; }) );
+        CHECK( !results.sharedMemory );
+
+        wxSystemOptions::SetOption("ipc.no-shared-memory", 0);
+    }
+
+#if wxUSE_ZLIB
+    SECTION("Compressed")
+    {
+        // Compression is not used for the data passed via shared memory.
+        TestServer server(results, true /* compress */);
+        REQUIRE( server.Create(name) );
+
+        CHECK( RunClientProcess(name, false, true, true) == 0 );
+        CHECK( DispatchUntil([&]() { return results.disconnected; }) );
+        CHECK( results.data == MakeData(1024*1024, true) );
+    }
+#endif // wxUSE_ZLIB
+}
+
+TEST_CASE("wxTCPConnection::LegacyServer", "[ipc]")
+{
+    SocketsInitializer init;
+
+    const wxString name = GetServerName();
+
+    wxUNIXaddress addr;
+    addr.Filename(name);
+
+    wxSocketServer server(addr, wxSOCKET_BLOCK | wxSOCKET_WAITALL);
+    REQUIRE( server.IsOk() );
+
+    LegacyServerThread thread(server);
+    REQUIRE( thread.Run() == wxTHREAD_NO_ERROR );
+
+    // The new client must fall back to the legacy protocol.
+    const std::vector<char> data = MakeData(64*1024, true);
+    {
+        wxTCPClient client;
+        std::unique_ptr<wxConnectionBase>
+            conn(client.MakeConnection("localhost", name, IPC_TOPIC));
+        REQUIRE( conn );
+
+        PokeAndRequest(*conn, data);
+    }
+
+    thread.Wait();
+    CHECK( thread.m_ok );
+    CHECK( thread.m_data == data );
+
+    wxRemoveFile(name);
+}
+
+TEST_CASE("wxTCPConnection::LegacyClient", "[ipc]")
+{
+    SocketsInitializer init;
+
+    const wxString name = GetServerName();
+
+    ServerResults results;
+    TestServer server(results);
+    REQUIRE( server.Create(name) );
+
+    // The new server must keep using the legacy protocol with this client.
+    const std::vector<char> data = MakeData(64*1024, false);
+
+    LegacyClientThread thread(name, data);
+    REQUIRE( thread.Run() == wxTHREAD_NO_ERROR );
+
+    CHECK( DispatchUntil([&]() { return thread.m_done.load(); }) );
+    thread.Wait();
+
+    CHECK( thread.m_ok );
+    CHECK( thread.m_data == data );
+    CHECK( results.data == data );
+    CHECK( !results.sharedMemory );
+
+    CHECK( DispatchUntil([&]() { return results.disconnected; }) );
+}
+
+#endif // wxUSE_SOCKETS && wxUSE_IPC && wxUSE_THREADS && __UNIX__
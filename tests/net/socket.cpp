@@ -22,11 +22,18 @@
 #if wxUSE_SOCKETS
 
 #include "wx/socket.h"
+#include "wx/sckreactor.h"
 #include "wx/url.h"
 #include "wx/sstream.h"
 #include "wx/evtloop.h"
+#include "wx/file.h"
+#include "wx/filename.h"
+#include "wx/scopeguard.h"
+#include "wx/atomic.h"
 
 #include <memory>
+#include <string>
+#include <vector>
 
 typedef std::unique_ptr<wxSockAddress> wxSockAddressPtr;
 typedef std::unique_ptr<wxSocketClient> wxSocketClientPtr;
@@ -358,4 +365,293 @@ TEST_CASE("wxDatagramSocket::ShortPeek", "[socket][dgram]")
     CHECK(recvbuf[1] == sendbuf1[1]);
 }
 
+TEST_CASE("wxDatagramSocket::ReadV", "[socket][dgram]")
+{
+    wxIPV4address addr;
+    addr.LocalHost();
+    addr.Service(23517);// Arbitrary port number
+    wxDatagramSocket sock(addr);
+
+    // Send ourselves a datagram
+    const char sendbuf[] = "headbody";
+    sock.SendTo(addr, sendbuf, 8);
+
+    if ( !sock.WaitForRead(1) )
+        return;
+
+    // And read it back into several buffers
+    char buf1[2], buf2[6];
+    const wxSocketIOVec recvvecs[] =
+    {
+        wxSocketIOVec(buf1, sizeof(buf1)),
+        wxSocketIOVec(buf2, sizeof(buf2)),
+    };
+    sock.ReadV(recvvecs, WXSIZEOF(recvvecs));
+    CHECK(!sock.Error());
+    CHECK(sock.LastReadCount() == 8);
+    CHECK(memcmp(buf1, "he", 2) == 0);
+    CHECK(memcmp(buf2, "adbody", 6) == 0);
+}
+
+namespace
+{
+
+// Connected pair of blocking stream sockets.
+class SocketPairFixture
+{
+public:
+    SocketPairFixture()
+    {
+        wxIPV4address addr;
+        addr.LocalHost();
+        addr.Service(0);
+
+        m_server.reset(new wxSocketServer(addr, wxSOCKET_BLOCK |
+                                                wxSOCKET_REUSEADDR));
+        REQUIRE(m_server->IsOk());
+
+        wxIPV4address serverAddr;
+        REQUIRE(m_server->GetLocal(serverAddr));
+        serverAddr.LocalHost();
+
+        m_client.reset(new wxSocketClient(wxSOCKET_BLOCK | wxSOCKET_WAITALL));
+        REQUIRE(m_client->Connect(serverAddr, true));
+
+        m_peer.reset(m_server->Accept(true));
+        REQUIRE(m_peer);
+        m_peer->SetFlags(wxSOCKET_BLOCK | wxSOCKET_WAITALL);
+    }
+
+protected:
+    struct SocketDeleter
+    {
+        void operator()(wxSocketBase* sock) const { sock->Destroy(); }
+    };
+
+    std::unique_ptr<wxSocketServer, SocketDeleter> m_server;
+    std::unique_ptr<wxSocketClient, SocketDeleter> m_client;
+    std::unique_ptr<wxSocketBase, SocketDeleter> m_peer;
+};
+
+} // anonymous namespace
+
+TEST_CASE_METHOD(SocketPairFixture, "wxSocket::ScatterGather", "[socket]")
+{
+    const char part1[] = "Hello, ";
+    const char part2[] = "scattered ";
+    const char part3[] = "world";
+    const wxSocketIOVec sendvecs[] =
+    {
+        wxSocketIOVec(part1, strlen(part1)),
+        wxSocketIOVec(),
+        wxSocketIOVec(part2, strlen(part2)),
+        wxSocketIOVec(part3, strlen(part3)),
+    };
+
+    m_client->WriteV(sendvecs, WXSIZEOF(sendvecs));
+    REQUIRE(!m_client->Error());
+    CHECK(m_client->LastWriteCount() == 22);
+
+    // Check that the push back buffer is used before reading from the socket.
+    m_peer->Unread("<<", 2);
+
+    char buf1[5], buf2[12], buf3[7];
+    const wxSocketIOVec recvvecs[] =
+    {
+        wxSocketIOVec(buf1, sizeof(buf1)),
+        wxSocketIOVec(buf2, sizeof(buf2)),
+        wxSocketIOVec(buf3, sizeof(buf3)),
+    };
+    m_peer->ReadV(recvvecs, WXSIZEOF(recvvecs));
+    CHECK(!m_peer->Error());
+    CHECK(m_peer->LastReadCount() == 24);
+    CHECK(memcmp(buf1, "<<Hel", 5) == 0);
+    CHECK(memcmp(buf2, "lo, scattere", 12) == 0);
+    CHECK(memcmp(buf3, "d world", 7) == 0);
+
+    // WriteMsg() uses WriteV() internally, check that it still works.
+    m_client->WriteMsg(part3, strlen(part3));
+    CHECK(!m_client->Error());
+    CHECK(m_client->LastWriteCount() == strlen(part3));
+
+    char msg[10];
+    m_peer->ReadMsg(msg, sizeof(msg));
+    CHECK(!m_peer->Error());
+    CHECK(m_peer->LastReadCount() == strlen(part3));
+    CHECK(memcmp(msg, part3, strlen(part3)) == 0);
+}
+
+#if wxUSE_FILE
+
+TEST_CASE_METHOD(SocketPairFixture, "wxSocket::SendFile", "[socket]")
+{
+    const wxString filename = wxFileName::CreateTempFileName("sendfile");
+    wxON_BLOCK_EXIT1(wxRemoveFile, filename);
+
+    std::string data;
+    for ( int n = 0; n < 10000; n++ )
+        data += wxString::Format("%05d\n", n).ToStdString();
+
+    wxFile file(filename, wxFile::write);
+    REQUIRE(file.Write(data.data(), data.size()) == data.size());
+    file.Close();
+
+    REQUIRE(file.Open(filename));
+
+    std::vector<char> buf(data.size());
+
+    SECTION("Whole")
+    {
+        m_client->SendFile(file, wxInvalidOffset, data.size());
+        CHECK(!m_client->Error());
+        CHECK(m_client->LastWriteCount() == data.size());
+        CHECK(file.Tell() == static_cast<wxFileOffset>(data.size()));
+
+        m_peer->Read(&buf[0], data.size());
+        CHECK(m_peer->LastReadCount() == data.size());
+        CHECK(memcmp(&buf[0], data.data(), data.size()) == 0);
+    }
+
+    SECTION("Offset")
+    {
+        m_client->SendFile(file, 6000, 12);
+        CHECK(!m_client->Error());
+        CHECK(m_client->LastWriteCount() == 12);
+
+        // The current position must not change when using explicit offset.
+        CHECK(file.Tell() == 0);
+
+        m_peer->Read(&buf[0], 12);
+        CHECK(m_peer->LastReadCount() == 12);
+        CHECK(memcmp(&buf[0], "01000\n01001\n", 12) == 0);
+    }
+
+    SECTION("EOF")
+    {
+        // Sending more than available must result in an error with
+        // wxSOCKET_WAITALL, but still send all the available data.
+        m_client->SendFile(file, data.size() - 6, 100);
+        CHECK(m_client->Error());
+        CHECK(m_client->LastWriteCount() == 6);
+
+        m_peer->Read(&buf[0], 6);
+        CHECK(memcmp(&buf[0], "09999\n", 6) == 0);
+    }
+}
+
+#endif // wxUSE_FILE
+
+#ifdef wxHAS_SOCKET_REACTOR
+
+namespace
+{
+
+// Handler echoing back the data it receives and closing the connection when
+// it gets "q".
+class EchoReactorHandler : public wxSocketReactorHandler
+{
+public:
+    virtual void OnConnection(wxSocketBase& WXUNUSED(socket)) override
+    {
+        wxAtomicInc(m_numConnected);
+    }
+
+    virtual void OnInput(wxSocketBase& socket) override
+    {
+        char buf[256];
+        socket.Read(buf, sizeof(buf));
+
+        const wxUint32 count = socket.LastReadCount();
+        if ( count && buf[0] == 'q' )
+            socket.Close();
+        else if ( count )
+            socket.Write(buf, count);
+    }
+
+    virtual void OnLost(wxSocketBase& WXUNUSED(socket)) override
+    {
+        wxAtomicInc(m_numLost);
+    }
+
+    wxAtomicInt m_numConnected = 0;
+    wxAtomicInt m_numLost = 0;
+};
+
+// Wait until the reactor handles the given number of connections.
+bool WaitForConnectionCount(const wxSocketReactor& reactor, size_t count)
+{
+    for ( int n = 0; n < 500; n++ )
+    {
+        if ( reactor.GetConnectionCount() == count )
+            return true;
+
+        wxMilliSleep(10);
+    }
+
+    return false;
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxSocketReactor::Echo", "[socket][reactor]")
+{
+    EchoReactorHandler handler;
+    wxSocketReactor reactor(handler);
+
+    wxIPV4address addr;
+    addr.LocalHost();
+    addr.Service(0);
+    REQUIRE(reactor.Start(addr, 2));
+    CHECK(reactor.IsRunning());
+    CHECK(reactor.GetThreadCount() == 2);
+
+    REQUIRE(reactor.GetLocal(addr));
+    addr.LocalHost();
+
+    const int NUM_CLIENTS = 4;
+    std::unique_ptr<wxSocketClient> clients[NUM_CLIENTS];
+    for ( auto& client : clients )
+    {
+        client.reset(new wxSocketClient(wxSOCKET_BLOCK | wxSOCKET_WAITALL));
+        REQUIRE(client->Connect(addr, true));
+    }
+
+    for ( auto& client : clients )
+    {
+        char buf[] = "Hello";
+        client->Write(buf, 5);
+        CHECK(client->LastWriteCount() == 5);
+
+        memset(buf, 0, sizeof(buf));
+        client->Read(buf, 5);
+        CHECK(client->LastReadCount() == 5);
+        CHECK(std::string(buf) == "Hello");
+    }
+
+    CHECK(WaitForConnectionCount(reactor, NUM_CLIENTS));
+    CHECK(handler.m_numConnected == NUM_CLIENTS);
+
+    // Connection closed by the handler.
+    clients[0]->Write("q", 1);
+    char ch;
+    clients[0]->Read(&ch, 1);
+    CHECK(clients[0]->LastReadCount() == 0);
+
+    // Connection closed by the client.
+    clients[1]->Close();
+
+    CHECK(WaitForConnectionCount(reactor, NUM_CLIENTS - 2));
+    CHECK(handler.m_numLost == 2);
+
+    // Stopping the reactor closes all the remaining connections.
+    reactor.Stop();
+    CHECK(!reactor.IsRunning());
+    CHECK(handler.m_numLost == NUM_CLIENTS);
+
+    clients[2]->Read(&ch, 1);
+    CHECK(clients[2]->LastReadCount() == 0);
+}
+
+#endif // wxHAS_SOCKET_REACTOR
+
 #endif // wxUSE_SOCKETS
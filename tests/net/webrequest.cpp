@@ -25,6 +25,7 @@
 #include "wx/wfstream.h"
 
 #include <memory>
+#include <thread>
 #include <unordered_map>
 
 // This test uses httpbin service and by default uses the mirror at the
@@ -492,6 +493,52 @@ TEST_CASE_METHOD(RequestFixture,
     CHECK( dataSize == processingSize );
 }
 
+TEST_CASE_METHOD(RequestFixture,
+                 "WebRequest::Get::Stream", "[net][webrequest][get]")
+{
+    if ( !InitBaseURL() )
+        return;
+
+    int processingSize = 99 * 1024;
+    Create(wxString::Format("bytes/%d", processingSize));
+    request.SetStorage(wxWebRequest::Storage_Stream);
+    request.Start();
+
+    const wxWebResponse response = request.GetResponse();
+    REQUIRE( response.IsOk() );
+
+    wxInputStream* const stream = response.GetStream();
+    REQUIRE( stream );
+
+    // Read the data from another thread while this one runs the event loop.
+    size_t streamSize = 0;
+    wxStreamError streamError = wxSTREAM_NO_ERROR;
+    std::thread reader([stream, &streamSize, &streamError]()
+        {
+            char buf[4096];
+            while ( stream->Read(buf, sizeof(buf)).LastRead() )
+                streamSize += stream->LastRead();
+
+            streamError = stream->GetLastError();
+        });
+
+    RunLoopWithTimeout();
+
+    // Ensure that the reader thread terminates even if we timed out.
+    if ( request.GetState() == wxWebRequest::State_Active )
+    {
+        request.Cancel();
+        RunLoopWithTimeout();
+    }
+
+    reader.join();
+
+    REQUIRE( stateFromEvent == wxWebRequest::State_Completed );
+    CHECK( request.GetBytesReceived() == processingSize );
+    CHECK( streamSize == static_cast<size_t>(processingSize) );
+    CHECK( streamError == wxSTREAM_EOF );
+}
+
 TEST_CASE_METHOD(RequestFixture,
                  "WebRequest::Error::HTTP", "[net][webrequest][error]")
 {
@@ -962,6 +1009,57 @@ TEST_CASE_METHOD(SyncRequestFixture,
     CHECK( request.GetBytesReceived() == processingSize );
 }
 
+TEST_CASE_METHOD(SyncRequestFixture,
+                 "WebRequest::Sync::Get::Stream", "[net][webrequest][sync][get]")
+{
+    if ( !InitBaseURL() )
+        return;
+
+    int processingSize = 99 * 1024;
+    Create(wxString::Format("bytes/%d", processingSize));
+    request.SetStorage(wxWebRequest::Storage_Stream);
+
+    REQUIRE( Execute() );
+
+    wxInputStream* const stream = request.GetResponse().GetStream();
+    REQUIRE( stream );
+
+    size_t streamSize = 0;
+    char buf[4096];
+    while ( stream->Read(buf, sizeof(buf)).LastRead() )
+        streamSize += stream->LastRead();
+
+    CHECK( streamSize == static_cast<size_t>(processingSize) );
+    CHECK( stream->GetLastError() == wxSTREAM_EOF );
+}
+
+TEST_CASE_METHOD(SyncRequestFixture,
+                 "WebRequest::Sync::Connections", "[net][webrequest][sync]")
+{
+    if ( !InitBaseURL() )
+        return;
+
+    wxWebSessionBase& session = GetSession();
+    if ( !session.SetConnectionOptions(wxWebConnectionOptions()) )
+    {
+        WARN("Skipping test not supported by this backend.");
+        return;
+    }
+
+    const wxWebConnectionStats before = session.GetConnectionStats();
+
+    for ( int n = 0; n < 3; n++ )
+        REQUIRE( Execute("bytes/100") );
+
+    const wxWebConnectionStats after = session.GetConnectionStats();
+    CHECK( after.GetRequestCount() - before.GetRequestCount() == 3 );
+
+    // All requests except, possibly, the first one should have reused the
+    // existing connection.
+    CHECK( after.GetReusedConnectionCount() -
+            before.GetReusedConnectionCount() >= 2 );
+}
+
 TEST_CASE_METHOD(SyncRequestFixture,
                  "WebRequest::Sync::Error::HTTP", "[net][webrequest][sync][error]")
 {
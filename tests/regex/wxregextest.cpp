@@ -161,6 +161,68 @@ TEST_CASE("wxRegEx::Replace", "[regex][replace]")
     CheckReplace(patn, "123foo456foo", "\\0\\0", "123foo456foo456foo", 1);
     CheckReplace(patn, "foo123foo123", "bar", "barbar", 2);
     CheckReplace(patn, "foo123_foo456_foo789", "bar", "bar_bar_bar", 3);
+
+    // The expressions starting with a literal are handled specially.
+    CheckReplace("ab+c", "xabcabbbc_ac", "-", "x--_ac", 2);
+    CheckReplace("\\[(x|y)\\]", "[z][x] [y]", "\\1", "[z]x y", 2);
+}
+
+TEST_CASE("wxRegEx::Literals", "[regex][match]")
+{
+    // The strings not containing the literals required by the expressions
+    // are rejected without using the regex engine, check that this doesn't
+    // reject anything matching.
+    CheckMatch("foo", "fofoo", "foo");
+    CheckMatch("foo(bar)", "foobafoobar", "foobar\tbar");
+    CheckMatch("foo(bar)", "foobafoobaz");
+    CheckMatch("fo*bar", "fbar", "fbar");
+    CheckMatch("fo?bar", "fobar", "fobar");
+    CheckMatch("fo{0,2}bar", "fbar", "fbar");
+    CheckMatch("x\\d{3}y", "x123y", "x123y");
+    CheckMatch("x{L}", "x{L}", "x{L}");
+    CheckMatch("a(?i)bc", "aBc", "aBc");
+    CheckMatch("(?i)abc", "ABC", "ABC");
+    CheckMatch("abc|def", "def", "def");
+    CheckMatch("(?<=a)bc", "abc", "bc");
+    CheckMatch("[\\]a]bc", "]bc", "]bc");
+    CheckMatch("\\x41bc", "Abc", "Abc");
+    CheckMatch("\\Qa.b\\E*", "a.", "a.");
+    CheckMatch("***=a.b", "xa.b", "a.b");
+    CheckMatch("***=a.b", "xacb");
+    CheckMatch("ab\\[cd", "ab[cd", "ab[cd");
+    CheckMatch("\\bfoo\\b", "foo-bar", "foo");
+    CheckMatch("^foo", "foofoo", nullptr, wxRE_DEFAULT, wxRE_NOTBOL);
+    CheckMatch("bar", "FOOBAR", "BAR", wxRE_ICASE);
+}
+
+TEST_CASE("wxRegEx::Cache", "[regex][compile]")
+{
+    // The same expression compiled with different flags must not reuse the
+    // same code.
+    wxRegEx re1("abc", wxRE_ICASE);
+    wxRegEx re2("abc");
+    CHECK( re1.Matches("ABC") );
+    CHECK_FALSE( re2.Matches("ABC") );
+
+    wxRegEx re3("(a)(b)");
+    wxRegEx re4("(a)(b)", wxRE_NOSUB);
+    CHECK( re3.GetMatchCount() == 3 );
+    CHECK( re4.Matches("ab") );
+
+    // Invalid expressions are not cached and still result in errors.
+    {
+        wxLogNull noLog;
+        CHECK_FALSE( wxRegEx("a(").IsValid() );
+        CHECK_FALSE( wxRegEx("a(").IsValid() );
+    }
+
+    // Disabling the cache doesn't affect the existing objects.
+    wxRegEx::SetCacheSize(0);
+    wxRegEx re5("(a)(b)");
+    CHECK( re3.Matches("xab") );
+    CHECK( re5.Matches("xab") );
+    CHECK( re5.GetMatch("xab", 2) == "b" );
+    wxRegEx::SetCacheSize(64);
 }
 
 TEST_CASE("wxRegEx::QuoteMeta", "[regex][meta]")
@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "wx/datstrm.h"
+#include "wx/mstream.h"
 #include "wx/wfstream.h"
 #include "wx/math.h"
 
@@ -41,30 +42,42 @@ private:
         CPPUNIT_TEST( StringRW );
         CPPUNIT_TEST( LongLongRW );
         CPPUNIT_TEST( Int64RW );
+        CPPUNIT_TEST( ArrayRW );
         CPPUNIT_TEST( NaNRW );
         CPPUNIT_TEST( PseudoTest_UseBigEndian );
         CPPUNIT_TEST( FloatRW );
         CPPUNIT_TEST( DoubleRW );
+        CPPUNIT_TEST( ArrayRW );
         // Only test standard IEEE 754 formats if we're using IEEE extended
         // format by default, otherwise the tests above already covered them.
 #if wxUSE_APPLE_IEEE
         CPPUNIT_TEST( PseudoTest_UseIEEE754 );
         CPPUNIT_TEST( FloatRW );
         CPPUNIT_TEST( DoubleRW );
+        CPPUNIT_TEST( ArrayRW );
         // Also retest little endian version with standard formats.
         CPPUNIT_TEST( PseudoTest_UseLittleEndian );
         CPPUNIT_TEST( FloatRW );
         CPPUNIT_TEST( DoubleRW );
+        CPPUNIT_TEST( ArrayRW );
 #endif // wxUSE_APPLE_IEEE
     CPPUNIT_TEST_SUITE_END();
 
     wxFloat64 TestFloatRW(wxFloat64 fValue);
 
+    template <class T>
+    bool TestArrayRW(const std::vector<T>& values,
+                     void (wxDataOutputStream::*writer)(const T*, size_t),
+                     void (wxDataInputStream::*reader)(T*, size_t));
+
+    static void ApplyOptions(wxDataStreamBase& ds);
+
     void FloatRW();
     void DoubleRW();
     void StringRW();
     void LongLongRW();
     void Int64RW();
+    void ArrayRW();
     void NaNRW();
 
     void PseudoTest_UseBigEndian() { ms_useBigEndianFormat = true; }
@@ -292,6 +305,89 @@ void DataStreamTestCase::Int64RW()
     CPPUNIT_ASSERT( TestMultiRW<wxUint64>(ValuesUI64, &wxDataOutputStream::Write64, &wxDataInputStream::Read64).IsOk() );
 }
 
+/* static */
+void DataStreamTestCase::ApplyOptions(wxDataStreamBase& ds)
+{
+    if ( ms_useBigEndianFormat )
+        ds.BigEndianOrdered(true);
+
+#if wxUSE_APPLE_IEEE
+    if ( ms_useIEEE754 )
+        ds.UseBasicPrecisions();
+#endif // wxUSE_APPLE_IEEE
+}
+
+template <class T>
+bool
+DataStreamTestCase::TestArrayRW(const std::vector<T>& values,
+                                void (wxDataOutputStream::*writer)(const T*, size_t),
+                                void (wxDataInputStream::*reader)(T*, size_t))
+{
+    wxMemoryOutputStream memOut;
+    {
+        wxDataOutputStream dataOut(memOut);
+        ApplyOptions(dataOut);
+
+        (dataOut.*writer)(&values[0], values.size());
+    }
+
+    // Check that writing the array is the same as writing its elements one
+    // by one.
+    wxMemoryOutputStream memOutSingle;
+    {
+        wxDataOutputStream dataOut(memOutSingle);
+        ApplyOptions(dataOut);
+
+        for ( size_t n = 0; n < values.size(); n++ )
+            dataOut << values[n];
+    }
+
+    if ( memOut.GetLength() != memOutSingle.GetLength() )
+        return false;
+
+    std::vector<char> bytes(memOut.GetLength()),
+                      bytesSingle(memOutSingle.GetLength());
+    memOut.CopyTo(&bytes[0], bytes.size());
+    memOutSingle.CopyTo(&bytesSingle[0], bytesSingle.size());
+    if ( bytes != bytesSingle )
+        return false;
+
+    wxMemoryInputStream memIn(memOut);
+    wxDataInputStream dataIn(memIn);
+    ApplyOptions(dataIn);
+
+    std::vector<T> valuesIn(values.size());
+    (dataIn.*reader)(&valuesIn[0], valuesIn.size());
+
+    return valuesIn == values;
+}
+
+void DataStreamTestCase::ArrayRW()
+{
+    // Use enough elements to exceed the size of the internal buffers.
+    const size_t count = 5000;
+
+    std::vector<wxUint16> values16(count);
+    std::vector<wxUint32> values32(count);
+    std::vector<wxUint64> values64(count);
+    std::vector<float> valuesFloat(count);
+    std::vector<double> valuesDouble(count);
+    for ( size_t n = 0; n < count; n++ )
+    {
+        values16[n] = static_cast<wxUint16>(n * 0x0101 + 1);
+        values32[n] = static_cast<wxUint32>(n * 0x01020304 + 1);
+        values64[n] = (wxUint64(n) << 40) + n * 0x01020304 + 1;
+        valuesFloat[n] = static_cast<float>(n) / 3;
+        valuesDouble[n] = -static_cast<double>(n) / 7;
+    }
+
+    CPPUNIT_ASSERT( TestArrayRW(values16, &wxDataOutputStream::Write16, &wxDataInputStream::Read16) );
+    CPPUNIT_ASSERT( TestArrayRW(values32, &wxDataOutputStream::Write32, &wxDataInputStream::Read32) );
+    CPPUNIT_ASSERT( TestArrayRW(values64, &wxDataOutputStream::Write64, &wxDataInputStream::Read64) );
+    CPPUNIT_ASSERT( TestArrayRW(valuesFloat, &wxDataOutputStream::WriteFloat, &wxDataInputStream::ReadFloat) );
+    CPPUNIT_ASSERT( TestArrayRW(valuesDouble, &wxDataOutputStream::WriteDouble, &wxDataInputStream::ReadDouble) );
+}
+
 void DataStreamTestCase::NaNRW()
 {
     //TODO?
@@ -548,3 +548,110 @@ void zlibStream::genExtTestData(wxTextOutputStream &out, const char *buf, int fl
 // Note: Don't forget to connect it to the base suite (See: bstream.cpp => StreamCase::suite())
 STREAM_TEST_SUBSUITE_NAMED_REGISTRATION(zlibStream)
 
+
+// ----------------------------------------------------------------------------
+// Multi-member gzip streams
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+std::string GzipMember(const std::string& data)
+{
+    wxMemoryOutputStream mos;
+    {
+        wxZlibOutputStream zos(mos, wxZ_DEFAULT_COMPRESSION, wxZLIB_GZIP);
+        zos.Write(data.data(), data.size());
+    }
+
+    std::string gz(mos.GetLength(), '\0');
+    mos.CopyTo(&gz[0], gz.size());
+    return gz;
+}
+
+// Returns data of the given size which is either easily compressible or not.
+std::string MakeMemberData(size_t size, unsigned seed, bool compressible)
+{
+    std::string data(size, '\0');
+    for ( size_t n = 0; n < size; n++ )
+    {
+        seed = seed * 1103515245 + 12345;
+        data[n] = compressible ? static_cast<char>('a' + (seed >> 16) % 4)
+                               : static_cast<char>(seed >> 16);
+    }
+
+    return data;
+}
+
+std::string ReadMultiMember(wxInputStream& in, unsigned threads)
+{
+    wxZlibInputStream zis(in, wxZLIB_GZIP_MULTI);
+    zis.SetThreadCount(threads);
+
+    std::string out;
+    char buf[4096];
+    while ( zis.IsOk() )
+        out.append(buf, zis.Read(buf, sizeof(buf)).LastRead());
+
+    CHECK( zis.GetLastError() == wxSTREAM_EOF );
+    CHECK( zis.TellI() == static_cast<wxFileOffset>(out.size()) );
+
+    return out;
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxZlibInputStream::MultiMember", "[stream][zlib]")
+{
+    // Use a mix of small members and members bigger than the chunk read
+    // ahead by the parallel decompression.
+    const size_t sizes[] = { 100, 70000, 0, 3*1024*1024, 1, 200000 };
+
+    std::string data, gz;
+    for ( size_t n = 0; n < 3*WXSIZEOF(sizes); n++ )
+    {
+        const std::string
+            member = MakeMemberData(sizes[n % WXSIZEOF(sizes)], n, n % 2 == 0);
+        data += member;
+        gz += GzipMember(member);
+    }
+
+    const unsigned threads = GENERATE(1u, 4u);
+    INFO("Using " << threads << " threads");
+
+    SECTION("Read")
+    {
+        wxMemoryInputStream mis(gz.data(), gz.size());
+        CHECK( ReadMultiMember(mis, threads) == data );
+    }
+
+    SECTION("Trailing")
+    {
+        // Data following the last member is left in the parent stream, as
+        // with single member streams.
+        const std::string trailing(1000, '\0');
+        const std::string all = gz + trailing;
+        wxMemoryInputStream mis(all.data(), all.size());
+        CHECK( ReadMultiMember(mis, threads) == data );
+
+        char buf[2000];
+        CHECK( mis.Read(buf, sizeof(buf)).LastRead() == trailing.size() );
+    }
+
+    SECTION("Truncated")
+    {
+        wxLogNull noLog;
+
+        wxMemoryInputStream mis(gz.data(), gz.size() - 100);
+        wxZlibInputStream zis(mis, wxZLIB_GZIP_MULTI);
+        zis.SetThreadCount(threads);
+
+        char buf[4096];
+        size_t total = 0;
+        while ( zis.IsOk() )
+            total += zis.Read(buf, sizeof(buf)).LastRead();
+
+        CHECK( zis.GetLastError() == wxSTREAM_READ_ERROR );
+        CHECK( total < data.size() );
+    }
+}
@@ -94,6 +94,30 @@ TEST_CASE("StringFormat", "[wxString]")
     CHECK( wxString::Format("%1$o %1$d %1$x", 20) == "24 20 14" );
 }
 
+TEST_CASE("StringFormatReuseBuffer", "[wxString]")
+{
+    // Format strings are cached using their address as the key, check that
+    // changing the contents of the same buffer still works correctly.
+    char buf[32];
+    strcpy(buf, "%d apples");
+    CHECK( wxString::Format(buf, 3) == "3 apples" );
+    strcpy(buf, "%s pears");
+    CHECK( wxString::Format(buf, "two") == "two pears" );
+    strcpy(buf, "%s and %d plums");
+    CHECK( wxString::Format(buf, wxString("one"), 4) == "one and 4 plums" );
+
+    wchar_t wbuf[32];
+    wxStrcpy(wbuf, L"%d apples");
+    CHECK( wxString::Format(wbuf, 3) == "3 apples" );
+    wxStrcpy(wbuf, L"%s pears");
+    CHECK( wxString::Format(wbuf, "two") == "two pears" );
+
+    wxString fmt("%d-%s");
+    CHECK( wxString::Format(fmt, 1, "a") == "1-a" );
+    fmt = "%s+%d";
+    CHECK( wxString::Format(fmt, "b", 2) == "b+2" );
+}
+
 TEST_CASE("StringFormatUnicode", "[wxString]")
 {
     // For some completely mysterious reason, the test below sometimes crashes
@@ -1122,6 +1146,91 @@ TEST_CASE("StringIndexedAccess", "[wxString]")
     CHECK( (char)s[2] == 'r' );
 }
 
+TEST_CASE("StringIndexedAccessLong", "[wxString]")
+{
+    // Use a string long enough for the positions index to be used in UTF-8
+    // build and check that it remains correct after modifying the string.
+    std::wstring ref;
+    for ( int n = 0; n < 3000; n++ )
+    {
+        ref += L"ab";
+        ref += n % 3 ? wchar_t(0xe9) : wchar_t(0x4e2d);
+        ref += wchar_t(L'0' + n % 10);
+    }
+
+    wxString s(ref);
+
+    const auto checkAll = [&]()
+    {
+        REQUIRE( s.length() == ref.length() );
+
+        // go backwards as going forwards would just use the cached position
+        for ( size_t n = ref.length(); n >= 97; n -= 97 )
+        {
+            const size_t pos = n - 97;
+
+            INFO("Position " << pos);
+            CHECK( s[pos] == ref[pos] );
+            CHECK( s.Mid(pos, 5) == wxString(ref.substr(pos, 5)) );
+        }
+
+        CHECK( s.find(L'9', 5000) == ref.find(L'9', 5000) );
+        CHECK( s.rfind(wchar_t(0x4e2d)) == ref.rfind(wchar_t(0x4e2d)) );
+    };
+
+    checkAll();
+
+    SECTION("Change character")
+    {
+        s[9000] = wchar_t(0x4e2d);
+        ref[9000] = wchar_t(0x4e2d);
+        checkAll();
+    }
+
+    SECTION("Insert")
+    {
+        s.insert(5000, L"x\xe9y");
+        ref.insert(5000, L"x\xe9y");
+        checkAll();
+    }
+
+    SECTION("Erase")
+    {
+        s.erase(100, 7);
+        ref.erase(100, 7);
+        checkAll();
+    }
+
+    SECTION("Replace")
+    {
+        s.replace(2, 3, "z");
+        ref.replace(2, 3, L"z");
+        checkAll();
+
+        s.Replace(wxString(wchar_t(0xe9)), "ee");
+        for ( size_t pos = 0; (pos = ref.find(wchar_t(0xe9), pos)) != std::wstring::npos; )
+        {
+            ref.replace(pos, 1, L"ee");
+            pos += 2;
+        }
+        checkAll();
+    }
+
+    SECTION("Append")
+    {
+        s += wxString(wchar_t(0x4e2d), 100);
+        ref.append(100, wchar_t(0x4e2d));
+        checkAll();
+    }
+
+    SECTION("Assign substring")
+    {
+        s.assign(s, 1001, 9000);
+        ref = ref.substr(1001, 9000);
+        checkAll();
+    }
+}
+
 TEST_CASE("StringBeforeAndAfter", "[wxString]")
 {
     // Construct a string with 2 equal signs in it by concatenating its three
@@ -21,6 +21,8 @@
 #include "wx/ffile.h"
 #include "wx/textfile.h"
 
+#include "testfile.h"
+
 #ifdef __VISUALC__
     #define unlink _unlink
 #endif
@@ -327,6 +329,149 @@ void TextFileTestCase::ReadBig()
                           f[NUM_LINES - 1] );
 }
 
+TEST_CASE("wxTextFile::OpenMapped", "[textfile]")
+{
+    const char* const filename = "textfiletest.txt";
+    TempFile removeOnExit(filename);
+
+    auto createFile = [filename](const char* contents, size_t len)
+    {
+        wxFFile f(filename, "wb");
+        REQUIRE( f.Write(contents, len) == len );
+    };
+
+    SECTION("Mixed")
+    {
+        // Make the file long enough to test both the vectorized and the
+        // scalar code and put CR LF at the boundary of 16 byte blocks.
+        const char contents[] = "foo\rbar\r\nbaz\n\nx\r\nline 5\r\r"
+                                "\xd0\x9f\xd1\x80\xd0\xb8\r\n\r\nlast";
+        createFile(contents, strlen(contents));
+
+        wxTextFile f;
+        REQUIRE( f.OpenMapped(filename) );
+#ifndef wxNO_RTTI
+        CHECK( f.IsMapped() );
+        CHECK( f.IsLazy() );
+#endif // !wxNO_RTTI
+
+        wxTextFile f2;
+        REQUIRE( f2.Open(filename) );
+
+        REQUIRE( f.GetLineCount() == 10 );
+        REQUIRE( f2.GetLineCount() == 10 );
+        for ( size_t n = 0; n < f.GetLineCount(); n++ )
+        {
+            INFO( "Line " << n );
+            CHECK( f.GetLine(n) == f2.GetLine(n) );
+            CHECK( f.GetLineType(n) == f2.GetLineType(n) );
+        }
+
+        CHECK( f[2] == "baz" );
+        CHECK( f.GetLineType(1) == wxTextFileType_Dos );
+        CHECK( f.GetLineType(4) == wxTextFileType_Dos );
+        CHECK( f.GetLine(7) == wxString::FromUTF8("\xd0\x9f\xd1\x80\xd0\xb8") );
+        CHECK( f.GetLastLine() == "last" );
+        CHECK( f.GetLineType(9) == wxTextFileType_None );
+
+        wxString all;
+        for ( wxString str = f.GetFirstLine(); !f.Eof(); str = f.GetNextLine() )
+            all += str;
+        CHECK( all == "foobarbazxline 5" + f2[7] + "last" );
+
+        // Modifying the buffer loads it in memory.
+        f.RemoveLine(0);
+        CHECK( !f.IsLazy() );
+        CHECK( !f.IsMapped() );
+        REQUIRE( f.GetLineCount() == 9 );
+        CHECK( f[0] == "bar" );
+        CHECK( f.GetLineType(0) == wxTextFileType_Dos );
+
+        CHECK( f.Close() );
+        CHECK( f.GetLineCount() == 0 );
+    }
+
+    SECTION("Big")
+    {
+        static const size_t NUM_LINES = 10000;
+
+        wxString contents;
+        for ( size_t n = 0; n < NUM_LINES; n++ )
+            contents += wxString::Format("Line %lu\n", (unsigned long)n + 1);
+        createFile(contents.utf8_str(), contents.length());
+
+        wxTextFile f;
+        REQUIRE( f.OpenMapped(filename) );
+        REQUIRE( f.GetLineCount() == NUM_LINES );
+
+        // References to several lines can be used at the same time.
+        const wxString& line1 = f[0];
+        const wxString& line999 = f[998];
+        CHECK( line1 == "Line 1" );
+        CHECK( line999 == "Line 999" );
+        CHECK( f[NUM_LINES - 1] ==
+                wxString::Format("Line %lu", (unsigned long)NUM_LINES) );
+
+        size_t count = 0;
+        for ( wxString str = f.GetFirstLine(); !f.Eof(); str = f.GetNextLine() )
+        {
+            if ( str != wxString::Format("Line %lu", (unsigned long)++count) )
+                break;
+        }
+        CHECK( count == NUM_LINES );
+        CHECK( f.GuessType() == wxTextFileType_Unix );
+    }
+
+    SECTION("BOM")
+    {
+        createFile("\xef\xbb\xbf" "foo\nbar", 10);
+
+        wxTextFile f;
+        REQUIRE( f.OpenMapped(filename) );
+#ifndef wxNO_RTTI
+        CHECK( f.IsMapped() );
+#endif // !wxNO_RTTI
+        REQUIRE( f.GetLineCount() == 2 );
+        CHECK( f[0] == "foo" );
+        CHECK( f[1] == "bar" );
+    }
+
+    SECTION("Fallback")
+    {
+        // Latin-1 text is decoded using the fall-back encoding.
+        createFile("caf\xe9\nbar\n", 9);
+
+        wxTextFile f;
+        REQUIRE( f.OpenMapped(filename) );
+        REQUIRE( f.GetLineCount() == 2 );
+        CHECK( f[0] == wxString::FromUTF8("caf\xc3\xa9") );
+    }
+
+    SECTION("UTF-16")
+    {
+        // UTF-16 files can't be mapped, but are still read normally.
+        createFile("\xff\xfe" "f\0o\0o\0\n\0b\0a\0r\0", 16);
+
+        wxTextFile f;
+        REQUIRE( f.OpenMapped(filename) );
+        CHECK( !f.IsMapped() );
+        CHECK( !f.IsLazy() );
+        REQUIRE( f.GetLineCount() == 2 );
+        CHECK( f[0] == "foo" );
+        CHECK( f[1] == "bar" );
+    }
+
+    SECTION("Empty")
+    {
+        createFile("", 0);
+
+        wxTextFile f;
+        REQUIRE( f.OpenMapped(filename) );
+        CHECK( f.GetLineCount() == 0 );
+        CHECK( f.Eof() );
+    }
+}
+
 TEST_CASE("wxTextBuffer::Translate", "[textbuffer]")
 {
     // Bytes with the value of LF that are part of an UTF-8 character shouldn't